@@ -243,6 +243,7 @@ Simple types cover scalar, vector and matrix types.
         - Int, UInt, Float, Double, Bool, Int64, UInt64
         - VInt, VUInt, VFloat, VDouble, VBool, VInt64, VUInt64
         - WInt, WUInt, WFloat, WDouble, WBool, WInt64, WUInt64
+        - Int8, UInt8, Int16, UInt16, VInt8, VUInt8, VInt16, VUInt16, WInt8, WUInt8, WInt16, WUInt16
         - IVec2, UVec2, Vec2, DVec2, BVec2,
         - VIVec2, VUVec2, VVec2, VDVec2, VBVec2,
         - WIVec2, WUVec2, WVec2, WDVec2, WBVec2,
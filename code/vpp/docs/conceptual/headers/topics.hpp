@@ -4223,6 +4223,44 @@
     for vpp::Shader and vpp::FragmentShader classes, which implement probe
     functionality as methods.
 
+    \subsection secDebugPrint Debug print
+
+    Debug probes are convenient for images, but less so for compute shaders
+    processing buffers. For these, VPP offers the DebugPrint() method of shader
+    classes. It works like \c printf, but the output is collected in
+    a vpp::DebugPrintBuffer object and formatted on CPU side after the GPU
+    work has completed. Only binary values are written by the shader, using
+    one atomic operation per call.
+
+    The buffer must be assigned to the pipeline by calling
+    PipelineConfig::enableDebugPrint() in the constructor of your pipeline
+    configuration. If you do not do that, all DebugPrint() calls in the shader
+    code are ignored during translation and generate no code. This way
+    debug output can be left in the source code and enabled when needed.
+
+    \code
+        MyPipeline :: MyPipeline ( const vpp::Device& hDevice, const vpp::DebugPrintBuffer& hPrint ) :
+            d_shader ( this, { 64, 1, 1 }, & MyPipeline::fComputeShader )
+        {
+            if ( hPrint )
+                enableDebugPrint ( hPrint );
+        }
+
+        void MyPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+        {
+            // ...
+            pShader->DebugPrint ( "value=%f index=%d", value, index );
+        }
+
+        // After the submission has completed:
+        hPrint.dump ( std::cout );
+    \endcode
+
+    Output can be limited to a single invocation with
+    DebugPrintBuffer::setFilter(). Records which do not fit in the buffer
+    are dropped and counted. Call DebugPrintBuffer::cmdMakeHostVisible()
+    at the end of the command buffer, before the data is read on the host.
+
     \subsection secValidation Vulkan validation support
 
     VPP provides support for Vulkan validation layer. In order to turn on
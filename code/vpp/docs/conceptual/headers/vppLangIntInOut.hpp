@@ -99,6 +99,49 @@ public:
         const ValueT& value,
         const IVec2& coords,
         const VkExtent3D& extent );
+
+    /**
+        \brief Checks whether DebugPrint() calls generate any code.
+
+        Returns true if PipelineConfig::enableDebugPrint() has been called
+        for the pipeline being compiled. Useful to skip computing values
+        which are needed only for debug output.
+    */
+    bool isDebugPrintEnabled() const;
+
+    /**
+        \brief Writes a formatted text record to the debug print buffer.
+
+        This is a \c printf counterpart for shaders. Each call appends one
+        record to a vpp::DebugPrintBuffer, which has been assigned to the pipeline
+        by PipelineConfig::enableDebugPrint(). The record contains the index of
+        the format string, the invocation identifier and argument values. The
+        text is formatted on CPU side, when you call DebugPrintBuffer::read()
+        or DebugPrintBuffer::dump() after the submission has completed.
+
+        Supported argument types are Int, UInt, Float and vectors of these.
+        The format string supports \c printf conversions (\c d, \c i, \c u,
+        \c x, \c o, \c c, \c f, \c e, \c g, \c a) with flags, width and precision.
+        Vectors use single conversion and are printed as lists in parentheses.
+
+        This version writes given invocation identifier, which is matched
+        against the filter set by DebugPrintBuffer::setFilter(). ComputeShader
+        and FragmentShader provide DebugPrint() versions which pass the global
+        invocation id and pixel coordinates, respectively.
+
+        If debug print is not enabled for the pipeline, no code is generated.
+    */
+    template< typename... Args >
+    void DebugPrintAt ( const IVec3& invocation, const char* pFormat, const Args&... args );
+
+    /**
+        \brief Writes a formatted text record with zero invocation identifier.
+
+        See DebugPrintAt() for details. Shader classes which have a natural
+        invocation identifier override this method.
+    */
+    template< typename... Args >
+    void DebugPrint ( const char* pFormat, const Args&... args );
 };
 
 // -----------------------------------------------------------------------------
@@ -389,6 +432,15 @@ public:
     template< class ValueT >
     void DebugProbe ( const ValueT& value );
 
+    /**
+        \brief Writes a formatted text record to the debug print buffer.
+
+        Records are identified by pixel coordinates (x, y, 0). See
+        Shader::DebugPrintAt() for details.
+    */
+    template< typename... Args >
+    void DebugPrint ( const char* pFormat, const Args&... args );
+
     /** \brief In: current pixel coordinates in the frame buffer. */
     Vec4 inFragCoord;
 
@@ -455,6 +507,21 @@ public:
 
     /** \brief Retrieves available size (in bytes) of the workgroup-scoped shared memory. */
     unsigned int getFreeWorkgroupMemory() const;
+
+    /**
+        \brief Writes a formatted text record to the debug print buffer.
+
+        Records are identified by inGlobalInvocationId. See
+        Shader::DebugPrintAt() for details.
+
+        Example:
+
+        \code
+            pShader->DebugPrint ( "sum=%f count=%d", sum, count );
+        \endcode
+    */
+    template< typename... Args >
+    void DebugPrint ( const char* pFormat, const Args&... args );
 };
 
 // -----------------------------------------------------------------------------
@@ -498,6 +498,70 @@ class UInt64
 {
 };
 
+// -----------------------------------------------------------------------------
+/** 
+    \brief Shader (GPU-side) data type for 8-bit signed integer values.
+
+    Use this type inside shader code as a counterpart of CPU-side std::int8_t type.
+
+    This class is identical to Int in every aspect except for number of bits.
+    Requires the \c fShaderInt8 feature. Can also be used as a member of uniform
+    and storage buffer structures, in which case the 8/16-bit storage
+    feature appropriate for the buffer kind must also be enabled.
+*/
+
+class Int8
+{
+};
+
+// -----------------------------------------------------------------------------
+/** 
+    \brief Shader (GPU-side) data type for 8-bit unsigned integer values.
+
+    Use this type inside shader code as a counterpart of CPU-side std::uint8_t type.
+
+    This class is identical to UInt in every aspect except for number of bits.
+    Requires the \c fShaderInt8 feature. Can also be used as a member of uniform
+    and storage buffer structures, in which case the 8/16-bit storage
+    feature appropriate for the buffer kind must also be enabled.
+*/
+
+class UInt8
+{
+};
+
+// -----------------------------------------------------------------------------
+/** 
+    \brief Shader (GPU-side) data type for 16-bit signed integer values.
+
+    Use this type inside shader code as a counterpart of CPU-side std::int16_t type.
+
+    This class is identical to Int in every aspect except for number of bits.
+    Requires the \c fShaderInt16 feature. Can also be used as a member of uniform
+    and storage buffer structures, in which case the 8/16-bit storage
+    feature appropriate for the buffer kind must also be enabled.
+*/
+
+class Int16
+{
+};
+
+// -----------------------------------------------------------------------------
+/** 
+    \brief Shader (GPU-side) data type for 16-bit unsigned integer values.
+
+    Use this type inside shader code as a counterpart of CPU-side std::uint16_t type.
+
+    This class is identical to UInt in every aspect except for number of bits.
+    Requires the \c fShaderInt16 feature. Can also be used as a member of uniform
+    and storage buffer structures, in which case the 8/16-bit storage
+    feature appropriate for the buffer kind must also be enabled.
+*/
+
+class UInt16
+{
+};
+
 // -----------------------------------------------------------------------------
 /** 
     \brief Shader (GPU-side) data type for mutable variables of 32-bit signed integer type.
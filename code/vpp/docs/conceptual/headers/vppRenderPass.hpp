@@ -89,6 +89,16 @@ public:
         const PipelineLayoutBase& layout,
         const RenderingOptions& options );
 
+    /** \brief Returns the number of Vulkan pipelines actually created.
+
+        Pipelines registered for the same process and layout, with rendering
+        options differing only in viewports, line width, depth bias, depth
+        bounds or stencil masks and reference, share one Vulkan pipeline.
+        This state is made dynamic and set automatically each time
+        the pipeline is bound.
+    */
+    size_t pipelineVariantCount() const;
+
     /**
         \brief Call before manually recording commands for this render pass. The
         CommandBufferRecorder class calls this automatically.
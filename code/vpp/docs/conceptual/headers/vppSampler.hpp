@@ -362,6 +362,9 @@ struct SUnnormalizedSampler
 
     This object is reference-counted and may be passed by value.
 
+    Samplers constructed from equal descriptions on the same device share
+    a single Vulkan sampler object (see Device::samplerCache()).
+
     The NormalizedSampler object can be used in the following places:
     - constructors of inConstSampledTexture binding point,
     - constructors of inConstSampler binding point,
@@ -402,6 +405,9 @@ public:
 
     This object is reference-counted and may be passed by value.
 
+    Samplers constructed from equal descriptions on the same device share
+    a single Vulkan sampler object (see Device::samplerCache()).
+
     The UnnormalizedSampler object can be used in the following places:
     - constructors of inConstSampledTexture binding point,
     - constructors of inConstSampler binding point,
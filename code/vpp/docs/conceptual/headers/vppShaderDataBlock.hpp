@@ -152,6 +152,10 @@ public:
 
         See the description of the class ShaderDataBlock for more details on
         the assignment list syntax.
+
+        Throws XUsageError if the list refers to a descriptor set configured
+        for push descriptors. Such sets are updated with
+        PipelineLayout::cmdPushDescriptors() instead.
     */
     template< class AssignmentListT >
     void update ( const AssignmentListT& list );
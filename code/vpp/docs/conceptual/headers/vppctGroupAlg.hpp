@@ -145,6 +145,73 @@ Int UpperBound (
     const ArrayT& arr, const ValueT& v, FunctorT&& fFunctor, 
     WArray< Int >& tmpArr, const GroupInvocation& inv );
 
+// -----------------------------------------------------------------------------
+
+/**
+    \brief Computes a TILE_M x TILE_N block of dense, row-major C = A * B.
+
+    A is m x k, B is k x n and C is m x n. The block begins at (tileRow, tileCol).
+    Slabs of A and B, TILE_K wide, are staged in shared memory.
+
+    Matrix items may be Float or Half. Accumulation is done in Float.
+    The workgroup size must be a multiple of TILE_N, and TILE_M must be
+    a multiple of the workgroup size divided by TILE_N.
+*/
+
+template< int TILE_M, int TILE_N, int TILE_K, class MatrixAT, class MatrixBT, class MatrixCT >
+void MatrixMultiply (
+    const MatrixAT& inA, const Int& aStart,
+    const MatrixBT& inB, const Int& bStart,
+    const MatrixCT& outC, const Int& cStart,
+    const Int& m, const Int& n, const Int& k,
+    const Int& tileRow, const Int& tileCol,
+    const GroupInvocation& inv );
+
+/** \brief Like MatrixMultiply, for the batch item of given index. Batch items are packed. */
+
+template< int TILE_M, int TILE_N, int TILE_K, class MatrixAT, class MatrixBT, class MatrixCT >
+void BatchedMatrixMultiply (
+    const MatrixAT& inA, const MatrixBT& inB, const MatrixCT& outC,
+    const Int& m, const Int& n, const Int& k, const Int& batchIndex,
+    const Int& tileRow, const Int& tileCol,
+    const GroupInvocation& inv );
+
+// -----------------------------------------------------------------------------
+
+/**
+    \brief Filters a TILE_H x TILE_W block of a single channel image with a 2D kernel.
+
+    The kernel has KERNEL_H x KERNEL_W row-major weights, anchored at its center.
+    Pixels outside the image are clamped to edge.
+*/
+
+template< int TILE_H, int TILE_W, int KERNEL_H, int KERNEL_W,
+          class ImageT, class WeightsT, class TargetImageT >
+void Convolve2D (
+    const ImageT& inImage, const Int& inStart,
+    const WeightsT& inWeights, const Int& weightsStart,
+    const TargetImageT& outImage, const Int& outStart,
+    const Int& height, const Int& width,
+    const Int& tileRow, const Int& tileCol,
+    const GroupInvocation& inv );
+
+/**
+    \brief Like Convolve2D, for a separable kernel.
+
+    Weights consist of KERNEL_W horizontal weights followed by KERNEL_H
+    vertical weights.
+*/
+
+template< int TILE_H, int TILE_W, int KERNEL_H, int KERNEL_W,
+          class ImageT, class WeightsT, class TargetImageT >
+void ConvolveSeparable2D (
+    const ImageT& inImage, const Int& inStart,
+    const WeightsT& inWeights, const Int& weightsStart,
+    const TargetImageT& outImage, const Int& outStart,
+    const Int& height, const Int& width,
+    const Int& tileRow, const Int& tileCol,
+    const GroupInvocation& inv );
+
 // -----------------------------------------------------------------------------
 } // namespace group
 // -----------------------------------------------------------------------------
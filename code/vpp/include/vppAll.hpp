@@ -49,6 +49,11 @@
 #include "vppFormats.hpp"
 #include "vppPhysicalDevice.hpp"
 #include "vppDevice.hpp"
+#include "vppMemoryBudget.hpp"
+#include "vppHandleCache.hpp"
+#include "vppLayoutCache.hpp"
+#include "vppSamplerCache.hpp"
+#include "vppDestructionQueue.hpp"
 #include "vppDeviceMemory.hpp"
 #include "vppBuffer.hpp"
 #include "vppInstance.hpp"
@@ -65,6 +70,7 @@
 #include "vppCommands.hpp"
 #include "vppSampler.hpp"
 #include "vppQueue.hpp"
+#include "vppCommandBufferAllocator.hpp"
 #include "vppFrameImageView.hpp"
 #include "vppAttachmentConfig.hpp"
 
@@ -88,8 +94,10 @@
 #include "vppShader.hpp"
 #include "vppPipelineLayout.hpp"
 #include "vppShaderDataBlock.hpp"
+#include "vppDescriptorSlotAllocator.hpp"
 #include "vppFramebuffer.hpp"
 #include "vppRenderPass.hpp"
+#include "vppTuningDatabase.hpp"
 #include "vppComputePass.hpp"
 #include "vppSwapChain.hpp"
 
@@ -98,19 +106,27 @@
 #include "vppLangImages.hpp"
 #include "vppLangImgFun.hpp"
 #include "vppLangInterface.hpp"
+#include "vppDebugPrint.hpp"
 
 #include "vppctGroupAlg.hpp"
 
 #include "vppCompiledProcedures.hpp"
 #include "vppComputationEngine.hpp"
+#include "vppWorkgroupTuner.hpp"
 #include "vppImageOperations.hpp"
+#include "vppMatrixOperations.hpp"
+#include "vppMappedFile.hpp"
+#include "vppTextureContainer.hpp"
 #include "vppContainers.hpp"
+#include "vppReadback.hpp"
 
 #include "vppCommandBufferRecorder.hpp"
 #include "vppDebugReporter.hpp"
 #include "vppRenderManager.hpp"
+#include "vppOffscreenRenderManager.hpp"
 
 #include "vppWholeScreenPatch.hpp"
+#include "vppCulling.hpp"
 
 #include "vppSupportMath.hpp"
 
@@ -141,7 +141,12 @@ VPP_INLINE TexelBufferViewImpl< FormatT > :: TexelBufferViewImpl (
 template< class FormatT >
 VPP_INLINE TexelBufferViewImpl< FormatT > :: ~TexelBufferViewImpl()
 {
-    ::vkDestroyBufferView ( d_hBuffer.device().handle(), d_handle, 0 );
+    const Device& hDevice = d_hBuffer.device();
+    const VkDevice hVkDevice = hDevice.handle();
+    const VkBufferView hBufferView = d_handle;
+
+    hDevice.destructionQueue().enqueue ( [ hVkDevice, hBufferView ]() {
+        ::vkDestroyBufferView ( hVkDevice, hBufferView, 0 ); } );
 }
 
 // -----------------------------------------------------------------------------
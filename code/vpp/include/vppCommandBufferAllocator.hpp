@@ -0,0 +1,227 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPCOMMANDBUFFERALLOCATOR_HPP
+#define INC_VPPCOMMANDBUFFERALLOCATOR_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPCOMMANDPOOL_HPP
+#include "vppCommandPool.hpp"
+#endif
+
+#ifndef INC_VPPSYNCHRONIZATION_HPP
+#include "vppSynchronization.hpp"
+#endif
+
+#ifndef INC_VPPQUEUE_HPP
+#include "vppQueue.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class KCommandBufferAllocatorImpl;
+
+// -----------------------------------------------------------------------------
+
+// Hands out command buffers for multithreaded, frame-based recording. Each
+// thread gets its own set of transient command pools, one per frame slot,
+// so recording threads never contend on a pool. Buffers are allocated in
+// batches and reused in subsequent frames. Pools are reset as a whole when
+// the frame slot comes around again, after the fence of that slot signals.
+//
+// Usage: call beginFrame() once per frame from the controlling thread,
+// acquire buffers from any thread, and make sure frameFence() gets signaled
+// by the last submission of the frame (or call endFrame()).
+
+class CommandBufferAllocator : public TSharedReference< KCommandBufferAllocatorImpl >
+{
+public:
+    CommandBufferAllocator (
+        const Device& hDevice,
+        EQueueType queueType = Q_GRAPHICS,
+        std::uint32_t frameSlotCount = 2,
+        std::uint32_t primaryBuffersPerSlot = 4,
+        std::uint32_t secondaryBuffersPerSlot = 16 );
+
+    ~CommandBufferAllocator();
+
+    const Device& device() const;
+    std::uint32_t frameSlotCount() const;
+    std::uint32_t currentFrameSlot() const;
+
+    // Advances to the next frame slot and waits until GPU finishes the work
+    // previously submitted from that slot. Not to be called concurrently
+    // with acquirePrimary() / acquireSecondary().
+
+    VPP_DLLAPI std::uint32_t beginFrame();
+
+    // The fence which must be signaled by the last submission in the frame.
+
+    const Fence& frameFence() const;
+
+    // Signals the frame fence on specified queue, after all work submitted
+    // so far. Use if the fence was not passed to any submission.
+
+    VPP_DLLAPI void endFrame ( const Queue& hQueue );
+
+    // Get a command buffer for the calling thread and current frame slot.
+    // The buffer is in initial state and valid until the slot is reused.
+
+    VPP_DLLAPI CommandBuffer acquirePrimary();
+    VPP_DLLAPI CommandBuffer acquireSecondary();
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KCommandBufferAllocatorImpl : public TSharedObject< KCommandBufferAllocatorImpl >
+{
+public:
+    VPP_DLLAPI KCommandBufferAllocatorImpl (
+        const Device& hDevice,
+        EQueueType queueType,
+        std::uint32_t frameSlotCount,
+        std::uint32_t primaryBuffersPerSlot,
+        std::uint32_t secondaryBuffersPerSlot );
+
+    VPP_DLLAPI ~KCommandBufferAllocatorImpl();
+
+    VPP_INLINE bool compareObjects ( const KCommandBufferAllocatorImpl* pRHS ) const
+    {
+        return this < pRHS;
+    }
+
+private:
+    friend class CommandBufferAllocator;
+
+    struct SFrameSlot
+    {
+        SFrameSlot ( const Device& hDevice, EQueueType queueType );
+
+        CommandPool d_pool;
+        std::vector< CommandBuffer > d_primaryBuffers;
+        std::vector< CommandBuffer > d_secondaryBuffers;
+        size_t d_nextPrimary;
+        size_t d_nextSecondary;
+        std::uint64_t d_frameIndex;
+    };
+
+    struct SThreadPools
+    {
+        std::vector< SFrameSlot > d_slots;
+    };
+
+    struct SThreadCache
+    {
+        std::uint64_t d_allocatorId;
+        SThreadPools* d_pPools;
+    };
+
+    SThreadPools* getThreadPools();
+    SFrameSlot* getCurrentSlot();
+
+    CommandBuffer acquire (
+        std::vector< CommandBuffer >* pBuffers,
+        size_t* pNext,
+        CommandPool* pPool,
+        CommandPool::EBufferLevel level );
+
+private:
+    Device d_hDevice;
+    EQueueType d_queueType;
+    std::uint32_t d_primaryBuffersPerSlot;
+    std::uint32_t d_secondaryBuffersPerSlot;
+    std::uint64_t d_allocatorId;
+
+    std::vector< Fence > d_frameFences;
+    std::atomic< std::uint64_t > d_frameIndex;
+
+    std::map< std::thread::id, SThreadPools* > d_threadPools;
+    std::mutex d_threadPoolsMutex;
+
+    static std::atomic< std::uint64_t > s_nextAllocatorId;
+    static thread_local SThreadCache s_threadCache;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+VPP_INLINE CommandBufferAllocator :: CommandBufferAllocator (
+    const Device& hDevice,
+    EQueueType queueType,
+    std::uint32_t frameSlotCount,
+    std::uint32_t primaryBuffersPerSlot,
+    std::uint32_t secondaryBuffersPerSlot ) :
+        TSharedReference< KCommandBufferAllocatorImpl >(
+            new KCommandBufferAllocatorImpl (
+                hDevice, queueType, frameSlotCount,
+                primaryBuffersPerSlot, secondaryBuffersPerSlot ) )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE CommandBufferAllocator :: ~CommandBufferAllocator()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const Device& CommandBufferAllocator :: device() const
+{
+    return get()->d_hDevice;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t CommandBufferAllocator :: frameSlotCount() const
+{
+    return static_cast< std::uint32_t >( get()->d_frameFences.size() );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t CommandBufferAllocator :: currentFrameSlot() const
+{
+    return static_cast< std::uint32_t >(
+        get()->d_frameIndex.load ( std::memory_order_acquire ) % get()->d_frameFences.size() );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const Fence& CommandBufferAllocator :: frameFence() const
+{
+    return get()->d_frameFences [ currentFrameSlot() ];
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPCOMMANDBUFFERALLOCATOR_HPP
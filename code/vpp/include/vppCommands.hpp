@@ -136,6 +136,15 @@ public:
         const std::vector< VkImageBlit >& regions,
         CommandBuffer hCmdBuffer = CommandBuffer() );
 
+    VPP_DLLAPI static void cmdBlitImage (
+        const TSImg& hSrcImage,
+        VkImageLayout srcImageLayout,
+        const TDImg& hDstImage,
+        VkImageLayout dstImageLayout,
+        const std::vector< VkImageBlit >& regions,
+        VkFilter filter,
+        CommandBuffer hCmdBuffer = CommandBuffer() );
+
     VPP_DLLAPI static void cmdResolveImage (
         const Img& hSrcImage,
         VkImageLayout srcImageLayout,
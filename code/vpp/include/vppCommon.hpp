@@ -31,7 +31,7 @@
 
 #ifdef _MSC_VER
     #define VK_USE_PLATFORM_WIN32_KHR
-#elif defined __linux
+#elif defined __linux && ! defined VPP_HEADLESS
     #define VK_USE_PLATFORM_WAYLAND_KHR
     #define VK_USE_PLATFORM_XCB_KHR
     #define VK_USE_PLATFORM_XLIB_KHR
@@ -41,6 +41,14 @@
 #include "vppQueue.hpp"
 #endif
 
+#ifndef INC_VPPCOMPILEDPROCEDURES_HPP
+#include "vppCompiledProcedures.hpp"
+#endif
+
+#ifndef INC_VPPEXCEPTIONS_HPP
+#include "vppExceptions.hpp"
+#endif
+
 // -----------------------------------------------------------------------------
 namespace vpp {
 // -----------------------------------------------------------------------------
@@ -62,30 +70,212 @@ public:
 
     const Device& device() const;
 
+    // Dependency graph. Using any of these switches the engine to graph mode:
+    // compile() merges the nodes into one command buffer per queue and the
+    // whole graph is submitted at once by operator().
+    //
+    // Parts of the graph may run on other queues of the same family. These
+    // wait for all work submitted earlier to the engine's queue, so uploads
+    // made there are visible to the graph. Work submitted to any other queue
+    // must be synchronized with the graph by the caller.
+
+    VPP_DLLAPI void addProcedure ( const Procedure& hProcedure );
+
+    template< class BeforeT, class AfterT >
+    void addDependency ( const BeforeT& before, const AfterT& after );
+
+    template< class NodeT >
+    void addRead (
+        const NodeT& node,
+        const Buf& hBuffer,
+        VkPipelineStageFlags stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VkAccessFlags access = VK_ACCESS_SHADER_READ_BIT );
+
+    template< class NodeT >
+    void addWrite (
+        const NodeT& node,
+        const Buf& hBuffer,
+        VkPipelineStageFlags stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VkAccessFlags access = VK_ACCESS_SHADER_WRITE_BIT );
+
+    // Images are assumed to stay in VK_IMAGE_LAYOUT_GENERAL.
+
+    template< class NodeT >
+    void addRead (
+        const NodeT& node,
+        const Img& hImage,
+        VkPipelineStageFlags stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VkAccessFlags access = VK_ACCESS_SHADER_READ_BIT );
+
+    template< class NodeT >
+    void addWrite (
+        const NodeT& node,
+        const Img& hImage,
+        VkPipelineStageFlags stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VkAccessFlags access = VK_ACCESS_SHADER_WRITE_BIT );
+
+    VPP_DLLAPI void operator()( const Fence& sigFenceOnEnd = Fence() );
+    VPP_DLLAPI bool operator()( std::uint64_t waitTimeout );
+
+    bool isGraph() const;
+    size_t submitCount() const;
+
 private:
     friend class Computation;
 
     VPP_DLLAPI static ComputationEngine* getInstance();
     void addComputation ( Computation* pComputation );
 
+    VPP_DLLAPI std::uint32_t nodeIndex ( const Computation* pComputation );
+    VPP_DLLAPI std::uint32_t nodeIndex ( const Procedure* pProcedure );
+
+    VPP_DLLAPI void addEdge ( std::uint32_t iBefore, std::uint32_t iAfter );
+
+    VPP_DLLAPI void addAccess (
+        std::uint32_t iNode,
+        const void* pResource,
+        VkPipelineStageFlags stages,
+        VkAccessFlags access,
+        bool bWrite );
+
+    void compileGraph();
+    void releaseBuffers();
+
 private:
     ComputationEngine ( const ComputationEngine& ) = delete;
     ComputationEngine ( ComputationEngine&& ) = delete;
     const ComputationEngine& operator= ( const ComputationEngine& ) = delete;
 
 private:
+    struct SAccess
+    {
+        const void* d_pResource;
+        VkPipelineStageFlags d_stages;
+        VkAccessFlags d_access;
+        bool d_bWrite;
+    };
+
+    struct SNode
+    {
+        SNode();
+
+        Computation* d_pComputation;
+        const Procedure* d_pProcedure;
+        std::vector< SAccess > d_accesses;
+        std::vector< std::uint32_t > d_predecessors;
+    };
+
+    struct SBatch
+    {
+        Queue d_queue;
+        CommandBuffer d_buffer;
+        Semaphore d_waitOnBegin;
+        Semaphore d_signalOnEnd;
+    };
+
     CommandPool d_commandPool;
     Queue d_queue;
     std::vector< Computation* > d_computations;
 
+    std::vector< SNode > d_nodes;
+    std::map< const void*, std::uint32_t > d_nodeIndices;
+    std::vector< SBatch > d_batches;
+    bool d_bGraph;
+
     static thread_local ComputationEngine* s_pThis;
 };
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE ComputationEngine::SNode :: SNode() :
+    d_pComputation ( 0 ),
+    d_pProcedure ( 0 )
+{
+}
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE void ComputationEngine :: addComputation ( Computation* pComputation )
 {
     d_computations.push_back ( pComputation );
+
+    d_nodeIndices.insert ( std::make_pair (
+        static_cast< const void* >( pComputation ),
+        static_cast< std::uint32_t >( d_nodes.size() ) ) );
+
+    d_nodes.push_back ( SNode() );
+    d_nodes.back().d_pComputation = pComputation;
+}
+
+// -----------------------------------------------------------------------------
+
+template< class BeforeT, class AfterT >
+VPP_INLINE void ComputationEngine :: addDependency (
+    const BeforeT& before, const AfterT& after )
+{
+    addEdge ( nodeIndex ( & before ), nodeIndex ( & after ) );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class NodeT >
+VPP_INLINE void ComputationEngine :: addRead (
+    const NodeT& node,
+    const Buf& hBuffer,
+    VkPipelineStageFlags stages,
+    VkAccessFlags access )
+{
+    addAccess ( nodeIndex ( & node ), hBuffer.get(), stages, access, false );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class NodeT >
+VPP_INLINE void ComputationEngine :: addWrite (
+    const NodeT& node,
+    const Buf& hBuffer,
+    VkPipelineStageFlags stages,
+    VkAccessFlags access )
+{
+    addAccess ( nodeIndex ( & node ), hBuffer.get(), stages, access, true );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class NodeT >
+VPP_INLINE void ComputationEngine :: addRead (
+    const NodeT& node,
+    const Img& hImage,
+    VkPipelineStageFlags stages,
+    VkAccessFlags access )
+{
+    addAccess ( nodeIndex ( & node ), hImage.get(), stages, access, false );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class NodeT >
+VPP_INLINE void ComputationEngine :: addWrite (
+    const NodeT& node,
+    const Img& hImage,
+    VkPipelineStageFlags stages,
+    VkAccessFlags access )
+{
+    addAccess ( nodeIndex ( & node ), hImage.get(), stages, access, true );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool ComputationEngine :: isGraph() const
+{
+    return d_bGraph;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE size_t ComputationEngine :: submitCount() const
+{
+    return d_batches.size();
 }
 
 // -----------------------------------------------------------------------------
@@ -111,6 +301,9 @@ public:
 private:
     friend class ComputationEngine;
 
+    void checkStandalone() const;
+
+private:
     ComputationEngine* d_pOwner;
     CommandBuffer d_buffer;
     Semaphore d_signalOnEnd;
@@ -143,8 +336,18 @@ VPP_INLINE Computation :: Computation ( Computation& predecessor ) :
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE void Computation :: checkStandalone() const
+{
+    if ( ! d_buffer )
+        throw XUsageError ( "Computation is not compiled separately. Submit the graph through ComputationEngine." );
+}
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE void Computation :: operator()( const Fence& sigFenceOnEnd )
 {
+    checkStandalone();
+
     Semaphore waitSem =
         d_pPredecessor ? d_pPredecessor->d_signalOnEnd : Semaphore();
 
@@ -155,6 +358,8 @@ VPP_INLINE void Computation :: operator()( const Fence& sigFenceOnEnd )
 
 VPP_INLINE bool Computation :: operator()( std::uint64_t waitTimeout )
 {
+    checkStandalone();
+
     Semaphore waitSem =
         d_pPredecessor ? d_pPredecessor->d_signalOnEnd : Semaphore();
 
@@ -171,6 +376,8 @@ VPP_INLINE bool Computation :: operator()( std::uint64_t waitTimeout )
 VPP_INLINE void Computation :: operator()(
     const Queue& hQueue, const Fence& sigFenceOnEnd )
 {
+    checkStandalone();
+
     Semaphore waitSem =
         d_pPredecessor ? d_pPredecessor->d_signalOnEnd : Semaphore();
 
@@ -182,6 +389,8 @@ VPP_INLINE void Computation :: operator()(
 VPP_INLINE void Computation :: operator()(
     const Queue& hQueue, const Semaphore& waitSem, const Semaphore& sigSem )
 {
+    checkStandalone();
+
     hQueue.submit ( d_buffer, waitSem, sigSem );
 }
 
@@ -41,6 +41,10 @@
 #include "vppPipelineCache.hpp"
 #endif
 
+#ifndef INC_VPPTUNINGDATABASE_HPP
+#include "vppTuningDatabase.hpp"
+#endif
+
 // -----------------------------------------------------------------------------
 namespace vpp {
 // -----------------------------------------------------------------------------
@@ -71,9 +75,20 @@ public:
     const PipelineCache& pipelineCache() const;
 
     VPP_DLLAPI const ComputePipeline& pipeline ( std::uint32_t iPipeline ) const;
+    VPP_DLLAPI const SpecializationValues& specialization ( std::uint32_t iPipeline ) const;
 
     template< class DefinitionT >
-    std::uint32_t addPipeline ( const ComputePipelineLayout< DefinitionT> layout );
+    std::uint32_t addPipeline (
+        const ComputePipelineLayout< DefinitionT> layout,
+        const SpecializationValues& specialization = SpecializationValues() );
+
+    template< class DefinitionT >
+    std::uint32_t addTunedPipeline (
+        const ComputePipelineLayout< DefinitionT> layout,
+        const std::string& tuningKey,
+        const SpecializationValues& specialization = SpecializationValues() );
+
+    void setTuningDatabase ( const TuningDatabase& hDatabase );
 
     VPP_DLLAPI void operator<< ( const std::function< void () >& cmds );
 
@@ -118,6 +133,7 @@ private:
     friend class ComputePass;
     Device d_hDevice;
     PipelineCache d_hPipelineCache;
+    TuningDatabase d_hTuningDatabase;
 
     struct SPipelineData
     {
@@ -126,7 +142,12 @@ private:
         std::uint32_t d_pipelineIndex;
 
         PipelineLayoutBase d_layout;
+        SpecializationValues d_specialization;
+        std::string d_tuningKey;
         ComputePipeline d_pipeline;
+
+        PipelineConfig::SpecializationData d_specializationData;
+        VkSpecializationInfo d_specializationInfo;
     };
 
     ComputePipelineCreateInfos d_pipelineCreateInfos;
@@ -137,7 +158,10 @@ private:
     bool d_bPipelinesCreated;
 
 private:
-    VPP_DLLAPI std::uint32_t createPipelineData ( const PipelineLayoutBase& lt );
+    VPP_DLLAPI std::uint32_t createPipelineData (
+        const PipelineLayoutBase& lt,
+        const SpecializationValues& specialization,
+        const std::string& tuningKey = std::string() );
 };
 
 // -----------------------------------------------------------------------------
@@ -192,9 +216,28 @@ VPP_INLINE const PipelineCache& ComputePass :: pipelineCache() const
 
 template< class DefinitionT >
 VPP_INLINE std::uint32_t ComputePass :: addPipeline (
-    const ComputePipelineLayout< DefinitionT> layout )
+    const ComputePipelineLayout< DefinitionT> layout,
+    const SpecializationValues& specialization )
+{
+    return get()->createPipelineData ( layout, specialization );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class DefinitionT >
+VPP_INLINE std::uint32_t ComputePass :: addTunedPipeline (
+    const ComputePipelineLayout< DefinitionT> layout,
+    const std::string& tuningKey,
+    const SpecializationValues& specialization )
+{
+    return get()->createPipelineData ( layout, specialization, tuningKey );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void ComputePass :: setTuningDatabase ( const TuningDatabase& hDatabase )
 {
-    return get()->createPipelineData ( layout );
+    get()->d_hTuningDatabase = hDatabase;
 }
 
 // -----------------------------------------------------------------------------
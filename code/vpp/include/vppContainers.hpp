@@ -89,6 +89,16 @@ public:
     VPP_DLLAPI void loadAndWait (
         EQueueType eQueue = Q_GRAPHICS );
 
+    // Generates a command to synchronize entire buffer from device to host.
+    // Call invalidateHostCopy() after the command has completed.
+
+    VPP_DLLAPI void cmdLoad ( CommandBuffer hCmdBuffer );
+
+    // Makes data written by the device visible to host. Needed after
+    // completion of commands generated by cmdLoad() or cmdCopyFromImage().
+
+    VPP_DLLAPI void invalidateHostCopy();
+
     // Generates a command to copy the buffer contents to specified image.
 
     VPP_DLLAPI void cmdCopyToImage (
@@ -203,6 +213,21 @@ public:
         std::uint32_t bufferRowLength = 0,
         std::uint32_t bufferImageHeight = 0 );
 
+    // Growable vectors only. Callbacks are called after the buffer has been
+    // reallocated. All views and descriptors referring to the vector become
+    // stale then, so use it e.g. to call ShaderDataBlock::update() again.
+
+    typedef std::function< void () > FReallocationCallback;
+
+    VPP_DLLAPI void addReallocationCallback ( const FReallocationCallback& callback );
+
+    // Incremented on each reallocation. Allows to detect stale bindings
+    // without callbacks.
+
+    std::uint32_t generation() const;
+
+    bool isGrowable() const;
+
 protected:
     VPP_DLLAPI VectorBase (
         size_t bufferSize,
@@ -210,7 +235,8 @@ protected:
         MemProfile::ECharacteristic memProfile,
         Buf* pBuffer,
         DeviceMemory* pMemory,
-        const Device& hDevice );
+        const Device& hDevice,
+        bool bGrowable = false );
 
     VPP_DLLAPI void flushHostToDevice (
         VkCommandBuffer hCmdBuffer, const DeviceMemory& mem );
@@ -227,11 +253,32 @@ protected:
     VPP_DLLAPI static std::uint32_t getAdditionalUsage (
         MemProfile::ECharacteristic memProfile );
 
+    VPP_DLLAPI static std::uint32_t getAdditionalUsage (
+        MemProfile::ECharacteristic memProfile, bool bGrowable );
+
+    // Copies valid contents of current buffer (and host mirror) to the new
+    // one, on the device. Replaces the host mirror, but not the buffer itself.
+
+    VPP_DLLAPI void replaceStorage (
+        const Buf& newBuffer,
+        const DeviceMemory& newMemory,
+        size_t newMemorySize,
+        size_t validSize );
+
+    VPP_DLLAPI void notifyReallocation();
+
+    // Frees cached command buffers dropped by replaceStorage(), as soon
+    // as their last possible use has completed.
+    void freeRetiredCmdBuffers();
+
     static size_t fixCapacity ( size_t nMaxItemCount );
 
 protected:
     size_t d_memorySize;
     MemProfile::ECharacteristic d_memProfile;
+    bool d_bGrowable;
+    std::uint32_t d_generation;
+    std::vector< FReallocationCallback > d_reallocationCallbacks;
 
     Buf* d_pBuffer;
     DeviceMemory* d_pMemory;
@@ -244,6 +291,15 @@ protected:
     CommandBuffer d_commitCmdBuffer [ Q_count ];
     CommandBuffer d_loadCmdBuffer [ Q_count ];
     CommandBuffer d_copyCmdBuffer [ Q_count ];
+
+    struct SRetiredCmdBuffer
+    {
+        EQueueType d_queue;
+        CommandBuffer d_buffer;
+        std::uint64_t d_timelineValue;
+    };
+
+    std::vector< SRetiredCmdBuffer > d_retiredCmdBuffers;
 };
 
 // -----------------------------------------------------------------------------
@@ -297,6 +353,20 @@ VPP_INLINE size_t VectorBase :: fixCapacity ( size_t nMaxItemCount )
     return nMaxItemCount > 0 ? nMaxItemCount : 1;
 }
 
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t VectorBase :: generation() const
+{
+    return d_generation;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool VectorBase :: isGrowable() const
+{
+    return d_bGrowable;
+}
+
 // -----------------------------------------------------------------------------
 } // namespace detail
 // -----------------------------------------------------------------------------
@@ -315,11 +385,18 @@ public:
 
     // Constructor.
     // THe vector has fixed capacity, but varying number of valid elements (size).
+    //
+    // Growable vector reallocates the buffer instead of throwing XVectorOverflow,
+    // doubling the capacity. Existing contents are copied on the device. This
+    // waits for the device to become idle, and the old buffer is released
+    // immediately, so do not grow the vector while recorded but not yet
+    // submitted commands refer to it.
 
     gvector (
         size_t maxItemCount,
         MemProfile::ECharacteristic memProfile,
-        const Device& hDevice );
+        const Device& hDevice,
+        bool bGrowable = false );
 
     // Standard container operations.
 
@@ -336,16 +413,21 @@ public:
     VPP_INLINE void push_back ( const ItemT& item )
     {
         if ( d_size == d_capacity )
-            raiseVectorOverflow();
-
-        new ( d_pBegin + d_size++ ) ItemT ( item );
+        {
+            // The item may reside in the vector itself.
+            const ItemT value ( item );
+            grow ( d_size + 1 );
+            new ( d_pBegin + d_size++ ) ItemT ( value );
+        }
+        else
+            new ( d_pBegin + d_size++ ) ItemT ( item );
     }
 
     template< typename ... ArgsT >
     VPP_INLINE void emplace_back ( ArgsT... args )
     {
         if ( d_size == d_capacity )
-            raiseVectorOverflow();
+            grow ( d_size + 1 );
 
         new ( d_pBegin + d_size++ ) ItemT ( args... );
     }
@@ -355,17 +437,30 @@ public:
     VPP_INLINE ItemT* allocate_back()
     {
         if ( d_size == d_capacity )
-            raiseVectorOverflow();
+            grow ( d_size + 1 );
 
         return reinterpret_cast< ItemT* >( d_pBegin + d_size++ );
     }
 
+    // Ensures capacity for specified number of items. Growable vectors only.
+
+    VPP_INLINE void reserve ( size_t nItems )
+    {
+        if ( nItems > d_capacity )
+            grow ( nItems );
+    }
+
     // Resizes the vector in proper way (constructing/destructing elements).
 
     VPP_INLINE void resize ( size_t newSize, const ItemT& value = ItemT() )
     {
         if ( newSize > d_capacity )
-            raiseVectorOverflow();
+        {
+            const ItemT fillValue ( value );
+            grow ( newSize );
+            resize ( newSize, fillValue );
+            return;
+        }
 
         if ( newSize < d_size )
         {
@@ -387,7 +482,7 @@ public:
     VPP_INLINE void setSize ( size_t newSize )
     {
         if ( newSize > d_capacity )
-            raiseVectorOverflow();
+            grow ( newSize );
 
         d_size = newSize;
     }
@@ -541,6 +636,7 @@ private:
 
     void map();
     void unmap();
+    void grow ( size_t nRequiredItems );
 
 private:
     ItemT* d_pBegin;
@@ -555,17 +651,18 @@ template< typename ItemT, unsigned int USAGE >
 gvector< ItemT, USAGE > :: gvector (
     size_t maxItemCount,
     MemProfile::ECharacteristic memProfile,
-    const Device& hDevice ) :
+    const Device& hDevice,
+    bool bGrowable ) :
         Buffer< USAGE >(
             fixCapacity ( maxItemCount ) * sizeof ( ItemT ),
-            hDevice, 0, getAdditionalUsage ( memProfile ) ),
+            hDevice, 0, getAdditionalUsage ( memProfile, bGrowable ) ),
         MemoryBinding< Buffer< USAGE >, DeviceMemory >(
             static_cast< const Buffer< USAGE >& >( *this ),
             MemProfile ( memProfile )
         ),
         detail::VectorBase (
             fixCapacity ( maxItemCount ) * sizeof ( ItemT ), USAGE, memProfile,
-            static_cast< Buf* >( this ), & this->memory(), hDevice ),
+            static_cast< Buf* >( this ), & this->memory(), hDevice, bGrowable ),
         d_pBegin ( 0 ),
         d_pEnd ( 0 ),
         d_size ( 0 ),
@@ -625,6 +722,40 @@ void gvector< ItemT, USAGE > :: unmap()
     }
 }
 
+// -----------------------------------------------------------------------------
+
+template< typename ItemT, unsigned int USAGE >
+void gvector< ItemT, USAGE > :: grow ( size_t nRequiredItems )
+{
+    if ( ! d_bGrowable )
+        raiseVectorOverflow();
+
+    const size_t newCapacity = std::max ( nRequiredItems, 2 * d_capacity );
+    const size_t newMemorySize = newCapacity * sizeof ( ItemT );
+
+    const Buffer< USAGE > newBuffer (
+        newMemorySize, d_device, 0, getAdditionalUsage ( d_memProfile, true ) );
+
+    const MemoryBinding< Buffer< USAGE >, DeviceMemory > newBinding (
+        newBuffer, MemProfile ( d_memProfile ) );
+
+    if ( ! newBinding.d_memory.valid() )
+        raiseMemoryAllocationError();
+
+    replaceStorage (
+        newBuffer, newBinding.d_memory, newMemorySize, d_size * sizeof ( ItemT ) );
+
+    unmap();
+
+    static_cast< Buffer< USAGE >& >( *this ) = newBuffer;
+    this->d_resource = newBuffer;
+    this->d_memory = newBinding.d_memory;
+    d_capacity = newCapacity;
+
+    map();
+    notifyReallocation();
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
@@ -655,8 +786,11 @@ VPP_INLINE IndirectCommands :: IndirectCommands (
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
+// Storage and transfer target usage is enabled as well, so that compute
+// shaders can generate the commands on the GPU (see CullingStage).
+
 class IndexedIndirectCommands :
-    public gvector< VkDrawIndexedIndirectCommand, Buf::INDIRECT >
+    public gvector< VkDrawIndexedIndirectCommand, Buf::INDIRECT | Buf::STORAGE | Buf::TARGET >
 {
 public:
     IndexedIndirectCommands (
@@ -671,7 +805,36 @@ VPP_INLINE IndexedIndirectCommands :: IndexedIndirectCommands (
     size_t maxItemCount,
     MemProfile::ECharacteristic memProfile,
     Device hDevice ) :
-        gvector< VkDrawIndexedIndirectCommand, Buf::INDIRECT >(
+        gvector< VkDrawIndexedIndirectCommand, Buf::INDIRECT | Buf::STORAGE | Buf::TARGET >(
+            maxItemCount,
+            memProfile,
+            hDevice
+        )
+{
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+// Draw count for RenderGraph::cmdDrawIndexedIndirectCount(), written by GPU.
+
+class DrawCountBuffer :
+    public gvector< std::uint32_t, Buf::INDIRECT | Buf::STORAGE | Buf::TARGET >
+{
+public:
+    DrawCountBuffer (
+        size_t maxItemCount,
+        MemProfile::ECharacteristic memProfile,
+        Device hDevice );
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE DrawCountBuffer :: DrawCountBuffer (
+    size_t maxItemCount,
+    MemProfile::ECharacteristic memProfile,
+    Device hDevice ) :
+        gvector< std::uint32_t, Buf::INDIRECT | Buf::STORAGE | Buf::TARGET >(
             maxItemCount,
             memProfile,
             hDevice
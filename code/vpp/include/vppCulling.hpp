@@ -0,0 +1,264 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPCULLING_HPP
+#define INC_VPPCULLING_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPPIPELINECONFIG_HPP
+#include "vppPipelineConfig.hpp"
+#endif
+
+#ifndef INC_VPPPIPELINELAYOUT_HPP
+#include "vppPipelineLayout.hpp"
+#endif
+
+#ifndef INC_VPPSHADERDATABLOCK_HPP
+#include "vppShaderDataBlock.hpp"
+#endif
+
+#ifndef INC_VPPCOMPUTEPASS_HPP
+#include "vppComputePass.hpp"
+#endif
+
+#ifndef INC_VPPCONTAINERS_HPP
+#include "vppContainers.hpp"
+#endif
+
+#ifndef INC_VPPIMAGEVIEW_HPP
+#include "vppImageView.hpp"
+#endif
+
+#ifndef INC_VPPSHADER_HPP
+#include "vppShader.hpp"
+#endif
+
+#ifndef INC_VPPLANGINTERFACE_HPP
+#include "vppLangInterface.hpp"
+#endif
+
+#ifndef INC_VPPSUPPORTMATH_HPP
+#include "vppSupportMath.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+// Per-frame culling parameters. Planes point inwards, i.e. a point p is
+// inside when dot ( plane.xyz, p ) + plane.w >= 0.
+
+template< ETag TAG >
+struct TCullingFrame : public UniformStruct< TAG, TCullingFrame >
+{
+    UniformFld< TAG, vect4 > m_leftPlane;
+    UniformFld< TAG, vect4 > m_rightPlane;
+    UniformFld< TAG, vect4 > m_bottomPlane;
+    UniformFld< TAG, vect4 > m_topPlane;
+    UniformFld< TAG, vect4 > m_nearPlane;
+    UniformFld< TAG, vect4 > m_farPlane;
+
+    // Used only for occlusion culling.
+    UniformFld< TAG, matr4 > m_viewProjection;
+
+    // xyz: camera position, w: scale factor applied to LOD distances.
+    UniformFld< TAG, vect4 > m_cameraPosition;
+
+    // xy: depth pyramid level 0 size in pixels, z: number of levels.
+    UniformFld< TAG, vect4 > m_pyramidSize;
+};
+
+typedef TCullingFrame< GPU > GCullingFrame;
+typedef TCullingFrame< CPU > CCullingFrame;
+
+typedef gvector< CCullingFrame, Buf::UNIFORM > CullingFrameBuffer;
+
+// -----------------------------------------------------------------------------
+
+template< ETag TAG >
+struct TCullingInstance : public UniformStruct< TAG, TCullingInstance >
+{
+    // Bounding sphere in world space. xyz: center, w: radius.
+    UniformFld< TAG, vect4 > m_sphere;
+
+    // x: first LOD record, y: number of LOD records (0 disables the instance),
+    // z: value passed as firstInstance to the draw, w: unused.
+    UniformFld< TAG, uvect4 > m_mesh;
+};
+
+typedef TCullingInstance< GPU > GCullingInstance;
+typedef TCullingInstance< CPU > CCullingInstance;
+
+typedef gvector< CCullingInstance, Buf::STORAGE > CullingInstanceBuffer;
+
+// -----------------------------------------------------------------------------
+
+template< ETag TAG >
+struct TCullingLod : public UniformStruct< TAG, TCullingLod >
+{
+    // x: index count, y: first index, z: vertex offset (signed), w: unused.
+    UniformFld< TAG, uvect4 > m_range;
+
+    // x: maximum distance at which this LOD is used, yzw: unused.
+    // Records of a mesh must be ordered from the most detailed one.
+    UniformFld< TAG, vect4 > m_params;
+};
+
+typedef TCullingLod< GPU > GCullingLod;
+typedef TCullingLod< CPU > CCullingLod;
+
+typedef gvector< CCullingLod, Buf::STORAGE > CullingLodBuffer;
+
+// -----------------------------------------------------------------------------
+
+template< ETag TAG >
+struct TCullingCounts : public UniformStruct< TAG, TCullingCounts >
+{
+    UniformFld< TAG, unsigned int > m_instanceCount;
+    UniformFld< TAG, unsigned int > m_maxDrawCount;
+};
+
+typedef TCullingCounts< GPU > GCullingCounts;
+typedef TCullingCounts< CPU > CCullingCounts;
+
+// -----------------------------------------------------------------------------
+
+// Hierarchical depth buffer for occlusion culling. Each level holds the maximum
+// (farthest) depth of 2x2 texels of the previous one.
+
+typedef format< float > DepthPyramidFormat;
+
+typedef ImageAttributes<
+    DepthPyramidFormat, RENDER, IMG_TYPE_2D,
+    Img::SAMPLED | Img::STORAGE,
+    VK_IMAGE_TILING_OPTIMAL, VK_SAMPLE_COUNT_1_BIT,
+    true, false > DepthPyramidAttr;
+
+typedef Image< DepthPyramidAttr > DepthPyramidImage;
+typedef ImageViewAttributes< DepthPyramidImage > DepthPyramidViewAttr;
+typedef ImageView< DepthPyramidViewAttr > DepthPyramidView;
+
+// -----------------------------------------------------------------------------
+
+class CullingPipelineConfig : public ComputePipelineConfig
+{
+public:
+    static const unsigned int LOCAL_SIZE = 64;
+
+    VPP_DLLAPI CullingPipelineConfig ( const Device& hDevice, bool bOcclusion );
+
+    VPP_DLLAPI void setData (
+        const UniformBufferView& frameParams,
+        const CullingInstanceBuffer& instances,
+        const CullingLodBuffer& lods,
+        const IndexedIndirectCommands& commands,
+        const DrawCountBuffer& drawCount,
+        ShaderDataBlock* pDataBlock );
+
+    VPP_DLLAPI void setDepthPyramid (
+        const DepthPyramidView& depthPyramid,
+        ShaderDataBlock* pDataBlock );
+
+    VPP_DLLAPI void cmdPushCounts (
+        std::uint32_t instanceCount,
+        std::uint32_t maxDrawCount,
+        CommandBuffer hCmdBuffer = CommandBuffer() );
+
+    bool isOcclusionEnabled() const;
+
+private:
+    void fComputeShader ( ComputeShader* pShader );
+
+private:
+    bool d_bOcclusion;
+
+    inPushConstant< TCullingCounts > d_counts;
+    inUniformBuffer d_frameParams;
+    ioBuffer d_instances;
+    ioBuffer d_lods;
+    ioBuffer d_commands;
+    ioBuffer d_drawCount;
+    inTexture< DepthPyramidView > d_depthPyramid;
+
+    computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool CullingPipelineConfig :: isOcclusionEnabled() const
+{
+    return d_bOcclusion;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+// GPU-driven culling and LOD selection. For each instance, the compute shader
+// tests the bounding sphere against the frustum (and optionally the depth
+// pyramid), selects the LOD by distance and appends an indexed draw command
+// for surviving instances. The command count is accumulated in the draw count
+// buffer, so CPU never sees individual objects.
+//
+// Call cmdCull() outside of render pass (e.g. in Preprocess node), then
+// cmdDraw() inside the render pass, with the drawing pipeline bound.
+
+class CullingStage
+{
+public:
+    VPP_DLLAPI CullingStage ( const Device& hDevice, bool bOcclusion = false );
+
+    VPP_DLLAPI void setData (
+        const UniformBufferView& frameParams,
+        const CullingInstanceBuffer& instances,
+        const CullingLodBuffer& lods,
+        const IndexedIndirectCommands& commands,
+        const DrawCountBuffer& drawCount );
+
+    VPP_DLLAPI void setDepthPyramid ( const DepthPyramidView& depthPyramid );
+
+    VPP_DLLAPI void cmdCull (
+        std::uint32_t instanceCount,
+        CommandBuffer hCmdBuffer = CommandBuffer() );
+
+    VPP_DLLAPI void cmdDraw ( CommandBuffer hCmdBuffer = CommandBuffer() ) const;
+
+private:
+    Device d_hDevice;
+    ComputePipelineLayout< CullingPipelineConfig > d_pipelineLayout;
+    ComputePass d_computePass;
+    ShaderDataBlock d_dataBlock;
+
+    IndirectBufferView d_commands;
+    IndirectBufferView d_drawCount;
+    std::uint32_t d_maxDrawCount;
+};
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPCULLING_HPP
@@ -0,0 +1,462 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef INC_VPPDEBUGPRINT_HPP
+#define INC_VPPDEBUGPRINT_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPBUFFER_HPP
+#include "vppBuffer.hpp"
+#endif
+
+#ifndef INC_VPPLANGINTUNIFORM_HPP
+#include "vppLangIntUniform.hpp"
+#endif
+
+#ifndef INC_VPPLANGCONSTRUCTS_HPP
+#include "vppLangConstructs.hpp"
+#endif
+
+#ifndef INC_VPPLANGCONVERSIONS_HPP
+#include "vppLangConversions.hpp"
+#endif
+
+#ifndef INC_VPPEXCEPTIONS_HPP
+#include "vppExceptions.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class DebugPrintBufferImpl;
+
+// -----------------------------------------------------------------------------
+
+enum EDebugPrintArgType
+{
+    DPA_INT,
+    DPA_UINT,
+    DPA_FLOAT
+};
+
+// -----------------------------------------------------------------------------
+
+struct SDebugPrintArg
+{
+    EDebugPrintArgType d_type;
+    std::uint32_t d_components;
+
+    VPP_INLINE bool operator< ( const SDebugPrintArg& rhs ) const
+    {
+        if ( d_type != rhs.d_type )
+            return d_type < rhs.d_type;
+        return d_components < rhs.d_components;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+// Decoded DebugPrint() record.
+
+struct SDebugPrintRecord
+{
+    int d_invocation [ 3 ];
+    std::uint32_t d_formatIndex;
+    std::string d_text;
+};
+
+// -----------------------------------------------------------------------------
+
+// Device buffer receiving output of DebugPrint() calls in shaders. Shaders
+// append fixed-size binary records to it with a single atomic add per call.
+// Format strings stay on the host and are applied when the records are read,
+// so shaders only write the format index, invocation id and raw arguments.
+//
+// The buffer works as a ring. Records are consumed by read() or dump(),
+// which must be called only when no submission writing to the buffer is in
+// progress. Records that do not fit in the free space are dropped and counted.
+//
+// To use the buffer, call PipelineConfig::enableDebugPrint() in constructor
+// of the pipeline configuration. For pipelines without it, DebugPrint() calls
+// generate no code at all.
+
+class DebugPrintBuffer : public TSharedReference< DebugPrintBufferImpl >
+{
+public:
+    static const int ANY = -1;
+
+    // Layout of the buffer header, in 32-bit words.
+    enum EHeader
+    {
+        HDR_WRITE_CURSOR,
+        HDR_READ_CURSOR,
+        HDR_DROPPED,
+        HDR_CAPACITY,
+        HDR_FILTER_X,
+        HDR_FILTER_Y,
+        HDR_FILTER_Z,
+        HDR_RESERVED,
+
+        HDR_SIZE
+    };
+
+    // Each record starts with the format index and invocation id.
+    static const std::uint32_t RECORD_HEADER_SIZE = 4;
+
+    DebugPrintBuffer();
+
+    // Capacity is the number of 32-bit words available for records. It is
+    // rounded up to a power of two.
+    VPP_DLLAPI DebugPrintBuffer (
+        const Device& hDevice,
+        std::uint32_t capacity = 256 * 1024 );
+
+    // Only records from matching invocations are written. ANY matches every
+    // value of a coordinate. Takes effect in subsequent submissions.
+    VPP_DLLAPI void setFilter ( int x, int y = ANY, int z = ANY );
+    VPP_DLLAPI void clearFilter();
+
+    // Makes shader writes to the buffer visible to the host. Record after
+    // the last command using DebugPrint() in the command buffer.
+    VPP_DLLAPI void cmdMakeHostVisible ( CommandBuffer hCmdBuffer = CommandBuffer() ) const;
+
+    // Decodes and removes all records written so far. Returns the number
+    // of decoded records.
+    VPP_DLLAPI size_t read ( std::vector< SDebugPrintRecord >* pRecords );
+
+    // Same as read(), but writes records as text lines prefixed with
+    // the invocation id.
+    VPP_DLLAPI size_t dump ( std::ostream& stream );
+
+    // Number of records dropped due to overflow, found by the last read().
+    VPP_DLLAPI std::uint32_t droppedCount() const;
+
+    // Used during shader translation.
+    VPP_DLLAPI std::uint32_t registerFormat (
+        const char* pFormat, const std::vector< SDebugPrintArg >& args );
+
+    std::uint32_t capacity() const;
+    StorageBufferView view() const;
+    const Device& device() const;
+};
+
+// -----------------------------------------------------------------------------
+
+class DebugPrintBufferImpl : public TSharedObject< DebugPrintBufferImpl >
+{
+public:
+    DebugPrintBufferImpl ( const Device& hDevice, std::uint32_t capacity );
+
+    VPP_INLINE bool compareObjects ( const DebugPrintBufferImpl* pRHS ) const
+    {
+        return this < pRHS;
+    }
+
+private:
+    friend class DebugPrintBuffer;
+
+    struct SFormat
+    {
+        std::string d_text;
+        std::vector< SDebugPrintArg > d_args;
+        std::uint32_t d_recordSize;
+    };
+
+    typedef std::pair< std::string, std::vector< SDebugPrintArg > > FormatKey;
+    typedef Buffer< Buf::STORAGE > StorageBuffer;
+    typedef MemoryBinding< StorageBuffer, MappableDeviceMemory > StorageBinding;
+
+    std::uint32_t* header() const;
+    void syncHeaderToDevice();
+
+    Device d_hDevice;
+    std::uint32_t d_capacity;
+    StorageBinding d_storage;
+
+    std::vector< SFormat > d_formats;
+    std::map< FormatKey, std::uint32_t > d_formatIndices;
+    std::uint32_t d_droppedCount;
+
+    mutable std::mutex d_mutex;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE DebugPrintBuffer :: DebugPrintBuffer()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t DebugPrintBuffer :: capacity() const
+{
+    return get()->d_capacity;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE StorageBufferView DebugPrintBuffer :: view() const
+{
+    return StorageBufferView ( get()->d_storage );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const Device& DebugPrintBuffer :: device() const
+{
+    return get()->d_hDevice;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+namespace detail {
+// -----------------------------------------------------------------------------
+
+template< class ValueT >
+struct TDebugPrintArg
+{
+    static_assert (
+        sizeof ( ValueT ) == 0,
+        "Unsupported DebugPrint argument type (use Int, UInt, Float or vectors of these)" );
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TDebugPrintArg< Int >
+{
+    static VPP_INLINE SDebugPrintArg info() { return SDebugPrintArg { DPA_INT, 1u }; }
+
+    static VPP_INLINE UInt component ( const Int& value, std::uint32_t )
+    {
+        return StaticCast< UInt >( value );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TDebugPrintArg< UInt >
+{
+    static VPP_INLINE SDebugPrintArg info() { return SDebugPrintArg { DPA_UINT, 1u }; }
+
+    static VPP_INLINE UInt component ( const UInt& value, std::uint32_t )
+    {
+        return value;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TDebugPrintArg< Float >
+{
+    static VPP_INLINE SDebugPrintArg info() { return SDebugPrintArg { DPA_FLOAT, 1u }; }
+
+    static VPP_INLINE UInt component ( const Float& value, std::uint32_t )
+    {
+        return ReinterpretCast< UInt >( value );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template< class ScalarT, size_t SIZE >
+struct TDebugPrintArg< TRVector< ScalarT, SIZE > >
+{
+    typedef TDebugPrintArg< ScalarT > scalar_arg;
+
+    static VPP_INLINE SDebugPrintArg info()
+    {
+        SDebugPrintArg result = scalar_arg::info();
+        result.d_components = static_cast< std::uint32_t >( SIZE );
+        return result;
+    }
+
+    static VPP_INLINE UInt component (
+        const TRVector< ScalarT, SIZE >& value, std::uint32_t index )
+    {
+        const ScalarT item = value [ static_cast< ESwizzle1 >( index ) ];
+        return scalar_arg::component ( item, 0 );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+// Binds the DebugPrintBuffer to the pipeline and generates the code
+// of DebugPrint() calls.
+
+class KDebugPrintProbe : public IDebugProbe
+{
+public:
+    VPP_INLINE KDebugPrintProbe ( const DebugPrintBuffer& hBuffer, std::uint32_t set ) :
+        d_hBuffer ( hBuffer ),
+        d_binding ( set )
+    {}
+
+    virtual void bind ( const ShaderDataBlock& hDataBlock )
+    {
+        IDebugProbe::bind (
+            d_hBuffer.view(),
+            d_binding.set(), d_binding.binding(),
+            hDataBlock );
+    }
+
+    template< typename... Args >
+    void write ( const IVec3& invocation, const char* pFormat, const Args&... args );
+
+private:
+    typedef UniformSimpleArray< unsigned int, ioBuffer > LogArray;
+
+    VPP_INLINE UInt wordIndex ( const UInt& start, std::uint32_t offset ) const
+    {
+        const UInt mask = d_hBuffer.capacity() - 1u;
+        const UInt dataOffset = static_cast< std::uint32_t >( DebugPrintBuffer::HDR_SIZE );
+        return dataOffset + ( ( start + offset ) & mask );
+    }
+
+    template< class ArgT >
+    VPP_INLINE void writeArgument (
+        const LogArray& ioLog, const UInt& start,
+        const ArgT& arg, std::uint32_t* pWord ) const
+    {
+        typedef VPP_RVTYPE( ArgT ) rvalue_type;
+        typedef TDebugPrintArg< rvalue_type > arg_traits;
+
+        const rvalue_type value = arg;
+        const std::uint32_t nComponents = arg_traits::info().d_components;
+
+        for ( std::uint32_t iComponent = 0; iComponent != nComponents; ++iComponent )
+            ioLog [ wordIndex ( start, ( *pWord )++ ) ] =
+                arg_traits::component ( value, iComponent );
+    }
+
+private:
+    DebugPrintBuffer d_hBuffer;
+    ioBuffer d_binding;
+};
+
+// -----------------------------------------------------------------------------
+
+template< typename... Args >
+void KDebugPrintProbe :: write (
+    const IVec3& invocation, const char* pFormat, const Args&... args )
+{
+    const std::vector< SDebugPrintArg > argInfo {
+        TDebugPrintArg< VPP_RVTYPE( Args ) >::info()... };
+
+    std::uint32_t recordSize = DebugPrintBuffer::RECORD_HEADER_SIZE;
+
+    for ( const SDebugPrintArg& arg : argInfo )
+        recordSize += arg.d_components;
+
+    if ( recordSize > d_hBuffer.capacity() )
+        throw XUsageError ( "DebugPrint: record does not fit in the buffer." );
+
+    const std::uint32_t formatIndex = d_hBuffer.registerFormat ( pFormat, argInfo );
+
+    LogArray ioLog ( d_binding );
+
+    // Invocation filter. Coordinates equal to ANY match everything.
+
+    const UInt any = static_cast< std::uint32_t >( DebugPrintBuffer::ANY );
+    const Int x = invocation [ X ];
+    const Int y = invocation [ Y ];
+    const Int z = invocation [ Z ];
+    const UInt ux = StaticCast< UInt >( x );
+    const UInt uy = StaticCast< UInt >( y );
+    const UInt uz = StaticCast< UInt >( z );
+    const UInt filterX = ioLog [ static_cast< int >( DebugPrintBuffer::HDR_FILTER_X ) ];
+    const UInt filterY = ioLog [ static_cast< int >( DebugPrintBuffer::HDR_FILTER_Y ) ];
+    const UInt filterZ = ioLog [ static_cast< int >( DebugPrintBuffer::HDR_FILTER_Z ) ];
+
+    const Bool bPass =
+        ( filterX == any || filterX == ux )
+        && ( filterY == any || filterY == uy )
+        && ( filterZ == any || filterZ == uz );
+
+    If ( bPass );
+    {
+        const UInt size = recordSize;
+        const UInt capacity = d_hBuffer.capacity();
+        const UInt format = formatIndex;
+
+        // The host advances the read cursor only between submissions,
+        // so it is constant here. Once a record is dropped, all records
+        // reserved after it are dropped too, as the write cursor grows.
+
+        const UInt readCursor = ioLog [ static_cast< int >( DebugPrintBuffer::HDR_READ_CURSOR ) ];
+        const UInt start = ( & ioLog [ static_cast< int >( DebugPrintBuffer::HDR_WRITE_CURSOR ) ] ).Add ( size );
+        const UInt used = start - readCursor;
+
+        If ( used + size <= capacity );
+        {
+            ioLog [ wordIndex ( start, 0 ) ] = format;
+            ioLog [ wordIndex ( start, 1 ) ] = ux;
+            ioLog [ wordIndex ( start, 2 ) ] = uy;
+            ioLog [ wordIndex ( start, 3 ) ] = uz;
+
+            std::uint32_t iWord = DebugPrintBuffer::RECORD_HEADER_SIZE;
+
+            const int expand[] = {
+                0, ( writeArgument ( ioLog, start, args, & iWord ), 0 )... };
+
+            static_cast< void >( expand );
+        }
+        Else();
+        {
+            ( & ioLog [ static_cast< int >( DebugPrintBuffer::HDR_DROPPED ) ] ).Increment();
+
+            // The format index lets the host find where the valid records end.
+            If ( used < capacity );
+            {
+                ioLog [ wordIndex ( start, 0 ) ] = format;
+            }
+            Fi();
+        }
+        Fi();
+    }
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+} // namespace detail
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void PipelineConfig :: enableDebugPrint (
+    const DebugPrintBuffer& hBuffer, std::uint32_t set )
+{
+    registerDebugPrint ( HDebugProbe ( new detail::KDebugPrintProbe ( hBuffer, set ) ) );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPDEBUGPRINT_HPP
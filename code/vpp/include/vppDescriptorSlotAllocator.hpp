@@ -0,0 +1,89 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPDESCRIPTORSLOTALLOCATOR_HPP
+#define INC_VPPDESCRIPTORSLOTALLOCATOR_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPEXCEPTIONS_HPP
+#include "vppExceptions.hpp"
+#endif
+
+#ifndef INC_VPPMUTEX_HPP
+#include "vppMutex.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+// Hands out indices into bindless descriptor arrays (bindlessArrayOf).
+// Released indices are reused before fresh ones. Thread-safe.
+//
+// Typical usage: acquire a slot when a resource is created, write it with
+// ShaderDataBlock::update ( ( m_textures = multi ( view, slot ) ) ) and pass
+// the slot to shaders (e.g. in per-draw data). Because the binding is
+// update-after-bind, this may happen while the descriptor set is bound.
+
+class DescriptorSlotAllocator
+{
+public:
+    VPP_DLLAPI DescriptorSlotAllocator ( std::uint32_t capacity );
+
+    VPP_DLLAPI std::uint32_t acquire();
+    VPP_DLLAPI void release ( std::uint32_t slot );
+
+    std::uint32_t capacity() const;
+
+    // All slots ever acquired are below this value.
+    VPP_DLLAPI std::uint32_t highWaterMark() const;
+
+    VPP_DLLAPI std::uint32_t usedCount() const;
+
+private:
+    DescriptorSlotAllocator ( const DescriptorSlotAllocator& ) = delete;
+    const DescriptorSlotAllocator& operator= ( const DescriptorSlotAllocator& ) = delete;
+
+private:
+    std::uint32_t d_capacity;
+    std::uint32_t d_nextFreshSlot;
+    std::vector< std::uint32_t > d_releasedSlots;
+    mutable std::mutex d_mutex;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t DescriptorSlotAllocator :: capacity() const
+{
+    return d_capacity;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPDESCRIPTORSLOTALLOCATOR_HPP
@@ -0,0 +1,149 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef INC_VPPDESTRUCTIONQUEUE_HPP
+#define INC_VPPDESTRUCTIONQUEUE_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPCOMMON_HPP
+#include "vppCommon.hpp"
+#endif
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+// Device-wide queue of deferred Vulkan object destructions. Impl destructors
+// of objects the GPU may still be using (buffers, images, memory, views,
+// samplers, pipelines, descriptor pools etc.) hand their handles over here
+// instead of destroying them directly.
+//
+// Every queue submission made through vpp::Queue advances the submission
+// timeline. A destruction request is tagged with the timeline value current
+// at the time it was made and is executed by a background reclaimer thread
+// as soon as all submissions up to that value have completed on every queue.
+// Completion is tracked with fences attached to submissions. When no tracked
+// work is pending (e.g. right after waitForIdle()), destruction happens
+// immediately in the calling thread, as before.
+//
+// Submissions made with a user-supplied fence are followed by an empty
+// submission signaling the tracking fence.
+
+class DestructionQueue
+{
+public:
+    typedef std::function< void() > FDestroy;
+
+    VPP_DLLAPI DestructionQueue ( VkDevice hDevice );
+    VPP_DLLAPI ~DestructionQueue();
+
+    // Schedules destruction. The function must not reference any VPP objects,
+    // only raw Vulkan handles (it can outlive them).
+    VPP_DLLAPI void enqueue ( FDestroy&& fDestroy );
+
+    // Called by Queue (under the queue lock) right before vkQueueSubmit.
+    // If bFenceSlotFree is true, the returned fence (if not null) should
+    // be attached to the submission. Otherwise the caller should follow
+    // the submission by an empty one signaling the returned fence.
+    VPP_DLLAPI VkFence registerSubmission ( VkQueue hQueue, bool bFenceSlotFree );
+
+    // Notifications about all submitted work being completed.
+    VPP_DLLAPI void onQueueIdle ( VkQueue hQueue );
+    VPP_DLLAPI void onDeviceIdle();
+
+    // Waits until all requests made so far have been executed, e.g. to get
+    // evicted memory actually freed. Returns false on timeout.
+    VPP_DLLAPI bool flush ( std::uint64_t timeoutNs );
+
+    VPP_DLLAPI std::uint64_t timeline() const;
+    VPP_DLLAPI std::uint64_t completedTimeline() const;
+    VPP_DLLAPI size_t pendingCount() const;
+
+private:
+    DestructionQueue ( const DestructionQueue& ) = delete;
+    const DestructionQueue& operator= ( const DestructionQueue& ) = delete;
+
+private:
+    struct SItem
+    {
+        std::uint64_t d_timelineValue;
+        FDestroy d_fDestroy;
+    };
+
+    struct SQueueState
+    {
+        SQueueState() : d_lastSubmitted ( 0 ), d_lastCompleted ( 0 ) {}
+
+        std::uint64_t d_lastSubmitted;
+        std::uint64_t d_lastCompleted;
+        std::deque< std::pair< std::uint64_t, VkFence > > d_fences;
+    };
+
+    typedef std::vector< FDestroy > Destroyers;
+
+    void reclaimerThread();
+    void retireFences ( SQueueState* pState );
+    std::uint64_t computeCompleted();
+    void collectCompleted ( Destroyers* pDestroyers );
+    void execute ( Destroyers* pDestroyers );
+    VkFence oldestBlockingFence() const;
+    VkFence acquireFence();
+    void releaseFence ( VkFence hFence );
+
+private:
+    VkDevice d_hDevice;
+    std::uint64_t d_timeline;
+
+    std::deque< SItem > d_items;
+    std::map< VkQueue, SQueueState > d_queues;
+    std::vector< VkFence > d_freeFences;
+
+    // Fence the reclaimer is currently waiting on, without the lock. It can
+    // not be reset until the wait ends, so it is recycled by the reclaimer.
+    VkFence d_hWaitedFence;
+    bool d_bWaitedFenceRetired;
+
+    // Requests taken from d_items, but not executed yet.
+    size_t d_nExecuting;
+
+    bool d_bStopping;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_wakeup;
+    std::condition_variable d_executed;
+    std::thread d_reclaimer;
+};
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPDESTRUCTIONQUEUE_HPP
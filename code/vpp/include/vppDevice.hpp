@@ -33,6 +33,10 @@
 #include "vppPhysicalDevice.hpp"
 #endif
 
+#ifndef INC_VPPDESTRUCTIONQUEUE_HPP
+#include "vppDestructionQueue.hpp"
+#endif
+
 // -----------------------------------------------------------------------------
 namespace vpp {
 // -----------------------------------------------------------------------------
@@ -73,6 +77,10 @@ public:
 
     VPP_DLLAPI CommandPool& defaultCmdPool ( EQueueType queueType = Q_GRAPHICS ) const;
     VPP_DLLAPI PipelineCache& defaultPipelineCache() const;
+    VPP_DLLAPI MemoryBudget& memoryBudget() const;
+    VPP_DLLAPI LayoutCache& layoutCache() const;
+    VPP_DLLAPI SamplerCache& samplerCache() const;
+    VPP_DLLAPI DestructionQueue& destructionQueue() const;
     
     template< typename FeatureT >
     bool hasFeature ( FeatureT feature ) const;
@@ -82,7 +90,13 @@ public:
     
     VPP_DLLAPI bool supportsVersion ( const SVulkanVersion& ver ) const;
 
-    VkResult waitForIdle() const;
+    // Entry point of VK_KHR_push_descriptor, or null if not enabled.
+    PFN_vkCmdPushDescriptorSetKHR cmdPushDescriptorSetFunction() const;
+
+    // Entry point of VK_KHR_draw_indirect_count, or null if not enabled.
+    PFN_vkCmdDrawIndexedIndirectCountKHR cmdDrawIndexedIndirectCountFunction() const;
+
+    VPP_DLLAPI VkResult waitForIdle() const;
 };
 
 // -----------------------------------------------------------------------------
@@ -129,12 +143,19 @@ private:
     CommandPool* d_pDefaultGraphicsCmdPool;
     CommandPool* d_pDefaultTransferCmdPool;
     PipelineCache* d_pDefaultPipelineCache;
+    MemoryBudget* d_pMemoryBudget;
+    LayoutCache* d_pLayoutCache;
+    SamplerCache* d_pSamplerCache;
+    DestructionQueue* d_pDestructionQueue;
 
     DeviceFeatures d_enabledFeatures;
     SVulkanVersion d_supportedVersion;
     std::set< std::string > d_enabledExtensions;
     std::set< std::string > d_sourceExtensions;
 
+    PFN_vkCmdPushDescriptorSetKHR d_pfnCmdPushDescriptorSet;
+    PFN_vkCmdDrawIndexedIndirectCountKHR d_pfnCmdDrawIndexedIndirectCount;
+
     VPP_EXTSYNC_MTX_DECLARE;
 };
 
@@ -245,12 +266,20 @@ VPP_INLINE const std::set< std::string >& Device :: sourceExtensions() const
 
 // -----------------------------------------------------------------------------
 
-VPP_INLINE VkResult Device :: waitForIdle() const
+VPP_INLINE PFN_vkCmdPushDescriptorSetKHR Device :: cmdPushDescriptorSetFunction() const
 {
-    return ::vkDeviceWaitIdle ( get()->d_handle );
+    return get()->d_pfnCmdPushDescriptorSet;
 }
 
 // -----------------------------------------------------------------------------
+
+VPP_INLINE PFN_vkCmdDrawIndexedIndirectCountKHR Device :: cmdDrawIndexedIndirectCountFunction() const
+{
+    return get()->d_pfnCmdDrawIndexedIndirectCount;
+}
+
+// -----------------------------------------------------------------------------
+
 } // namespace vpp
 // -----------------------------------------------------------------------------
 
@@ -54,6 +54,15 @@ public:
         const MemProfile& rhs,
         bool bForceHostVisible );
 
+    // Low priority allocations may be moved to host-visible heaps
+    // under memory pressure (see MemoryBudget).
+
+    enum EPriority
+    {
+        PRIORITY_NORMAL,
+        PRIORITY_LOW
+    };
+
     enum ECharacteristic
     {
         DEVICE_STATIC,
@@ -101,17 +110,20 @@ public:
     };
 
     VPP_DLLAPI MemProfile ( ECharacteristic eChar );
+    VPP_DLLAPI MemProfile ( ECharacteristic eChar, EPriority ePriority );
 
     typedef const std::uint32_t* iterator;
 
     VPP_INLINE iterator begin() const { return d_pWantedProperties; }
     VPP_INLINE iterator end() const { return d_pWantedProperties + d_nWantedProperties; }
     VPP_INLINE bool isForceHostVisible() const { return d_bForceHostVisible; }
+    VPP_INLINE bool isLowPriority() const { return d_bLowPriority; }
 
 private:
     const std::uint32_t* d_pWantedProperties;
     const size_t d_nWantedProperties;
     bool d_bForceHostVisible;
+    bool d_bLowPriority;
 
 private:
     static const std::uint32_t* s_wantedProperties [ ECharacteristic_count ];
@@ -157,6 +169,7 @@ public:
     bool isHostVisible() const;
     bool isHostCoherent() const;
 
+    // Remaining budget of the heap which would be used for given profile.
     VPP_DLLAPI static VkDeviceSize availableMemory (
         const MemProfile& memProfile,
         Device hDevice );
@@ -184,6 +197,12 @@ private:
         std::uint32_t properties,
         const VkPhysicalDeviceMemoryProperties& devMemProperties );
 
+    void allocate (
+        std::uint32_t typeMask,
+        std::uint32_t memoryTypeIndex,
+        bool bLowPriority,
+        const VkPhysicalDeviceMemoryProperties& devMemProperties );
+
 private:
     friend class DeviceMemory;
     friend class MappableDeviceMemory;
@@ -196,6 +215,10 @@ private:
     unsigned char* d_pMappedBegin;
     unsigned char* d_pMappedEnd;
     VkDeviceSize d_size;
+    std::uint32_t d_heapIndex;
+
+    unsigned char* d_pPersistentBegin;
+    VkDeviceSize d_nonCoherentAtomSize;
 
     VPP_EXTSYNC_MTX_DECLARE;
 };
@@ -270,6 +293,13 @@ VPP_INLINE bool DeviceMemory :: isHostCoherent() const
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
+// Host-visible memory. By default it is mapped on demand by map() / unmap().
+// Memory for per-frame or streaming data should rather be persistently mapped
+// (either by constructor flag or mapPersistently()). It then stays mapped
+// for its whole lifetime, map() only selects a subrange of the existing
+// mapping, unmap() restores the whole range, and load() becomes a single
+// copy plus a flush of the affected range (if the memory is not coherent).
+
 class MappableDeviceMemory : public DeviceMemory
 {
 public:
@@ -279,7 +309,8 @@ public:
         VkDeviceSize size,
         std::uint32_t typeMask,
         const MemProfile& memProfile,
-        Device hDevice );
+        Device hDevice,
+        bool bPersistentlyMapped = false );
 
     MappableDeviceMemory ( const DeviceMemory& mem );
 
@@ -289,14 +320,35 @@ public:
     VkResult map ( VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE );
     void unmap();
 
+    VPP_DLLAPI VkResult mapPersistently();
+    bool isPersistentlyMapped() const;
+
     void syncFromDevice();
     void syncToDevice();
 
-    void load ( const void* pBegin, size_t size ); 
+    // Range versions. The range is extended to nonCoherentAtomSize boundaries
+    // as required by Vulkan. Do nothing for coherent memory.
+
+    VPP_DLLAPI void syncFromDevice ( VkDeviceSize offset, VkDeviceSize size );
+    VPP_DLLAPI void syncToDevice ( VkDeviceSize offset, VkDeviceSize size );
+
+    void load ( const void* pBegin, size_t size, VkDeviceSize offset = 0 );
 };
 
 // -----------------------------------------------------------------------------
 
+namespace detail {
+
+// Copies data to write-combined (uncached) memory, e.g. mapped device memory.
+// Uses non-temporal stores where available, so that the destination does not
+// pollute the cache and partial cache line writes are avoided.
+
+VPP_DLLAPI void copyToWriteCombined ( void* pDest, const void* pSource, size_t size );
+
+} // namespace detail
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE MappableDeviceMemory :: MappableDeviceMemory()
 {
 }
@@ -307,12 +359,15 @@ VPP_INLINE MappableDeviceMemory :: MappableDeviceMemory (
     VkDeviceSize size,
     std::uint32_t typeMask,
     const MemProfile& memProfile,
-    Device hDevice ) :
+    Device hDevice,
+    bool bPersistentlyMapped ) :
         DeviceMemory (
             size, typeMask,
             MemProfile ( memProfile, true ),
             hDevice )
 {
+    if ( bPersistentlyMapped && valid() )
+        mapPersistently();
 }
 
 // -----------------------------------------------------------------------------
@@ -335,6 +390,18 @@ VPP_INLINE VkResult MappableDeviceMemory :: map ( VkDeviceSize offset, VkDeviceS
 {
     VPP_EXTSYNC_MTX_SLOCK ( get() );
 
+    if ( get()->d_pPersistentBegin )
+    {
+        // Already mapped, just select the subrange.
+
+        offset = std::min ( offset, get()->d_size );
+        size = std::min ( size, get()->d_size - offset );
+
+        get()->d_pMappedBegin = get()->d_pPersistentBegin + offset;
+        get()->d_pMappedEnd = get()->d_pMappedBegin + size;
+        return VK_SUCCESS;
+    }
+
     VkResult result = ::vkMapMemory (
         get()->d_hDevice.handle(), get()->d_handle, offset, size, 0,
         reinterpret_cast< void** > ( & get()->d_pMappedBegin ) );
@@ -355,6 +422,13 @@ VPP_INLINE void MappableDeviceMemory :: unmap()
 {
     VPP_EXTSYNC_MTX_SLOCK ( get() );
 
+    if ( get()->d_pPersistentBegin )
+    {
+        get()->d_pMappedBegin = get()->d_pPersistentBegin;
+        get()->d_pMappedEnd = get()->d_pPersistentBegin + get()->d_size;
+        return;
+    }
+
     if ( get()->d_pMappedBegin )
         ::vkUnmapMemory ( get()->d_hDevice.handle(), get()->d_handle );
 
@@ -363,45 +437,41 @@ VPP_INLINE void MappableDeviceMemory :: unmap()
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE bool MappableDeviceMemory :: isPersistentlyMapped() const
+{
+    return get()->d_pPersistentBegin != 0;
+}
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE void MappableDeviceMemory :: syncFromDevice()
 {
-    if ( ! isHostCoherent() )
-    {
-        VkMappedMemoryRange memoryRange;
-        memoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        memoryRange.pNext = 0;
-        memoryRange.memory = handle();
-        memoryRange.offset = 0;
-        memoryRange.size = size();
-
-        ::vkInvalidateMappedMemoryRanges ( get()->d_hDevice.handle(), 1, & memoryRange );
-    }
+    syncFromDevice ( 0, VK_WHOLE_SIZE );
 }
 
 // -----------------------------------------------------------------------------
 
 VPP_INLINE void MappableDeviceMemory :: syncToDevice()
 {
-    if ( ! isHostCoherent() )
-    {
-        VkMappedMemoryRange memoryRange;
-        memoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        memoryRange.pNext = 0;
-        memoryRange.memory = handle();
-        memoryRange.offset = 0;
-        memoryRange.size = size();
-
-        ::vkFlushMappedMemoryRanges ( get()->d_hDevice.handle(), 1, & memoryRange );
-    }
+    syncToDevice ( 0, VK_WHOLE_SIZE );
 }
 
 // -----------------------------------------------------------------------------
 
-VPP_INLINE void MappableDeviceMemory :: load ( const void* pBegin, size_t size )
+VPP_INLINE void MappableDeviceMemory :: load (
+    const void* pBegin, size_t size, VkDeviceSize offset )
 {
-    map ( 0, size );
-    std::memcpy ( beginMapped(), pBegin, size );
-    unmap();
+    if ( get()->d_pPersistentBegin )
+    {
+        detail::copyToWriteCombined ( get()->d_pPersistentBegin + offset, pBegin, size );
+        syncToDevice ( offset, size );
+    }
+    else
+    {
+        map ( offset, size );
+        std::memcpy ( beginMapped(), pBegin, size );
+        unmap();
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,205 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef INC_VPPHANDLECACHE_HPP
+#define INC_VPPHANDLECACHE_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPCOMMON_HPP
+#include "vppCommon.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+// Reference counted map from the canonical form of a create info to the
+// Vulkan object created from it. Common part of LayoutCache and SamplerCache,
+// which build the keys, create and destroy the objects and serialize access.
+
+template< class HandleT >
+class THandleCache
+{
+public:
+    // Canonical form of a create info: hash first, so that most comparisons
+    // are decided without looking at the words.
+    typedef std::vector< std::uint64_t > Words;
+    typedef std::pair< std::uint64_t, Words > Key;
+
+    THandleCache();
+
+    static std::uint64_t hashWords ( const Words& words );
+
+    // Returns the cached handle with reference count incremented, or null
+    // handle if there is none.
+    HandleT acquire ( const Key& key );
+
+    // Registers a newly created handle with reference count of one.
+    void add ( const Key& key, HandleT handle );
+
+    // Returns true if the handle should be destroyed now, i.e. the last
+    // reference has been released or the handle was never cached.
+    bool release ( HandleT handle );
+
+    template< class FunctionT >
+    void forEachHandle ( FunctionT fFunction ) const;
+
+    size_t size() const;
+    std::uint64_t hitCount() const;
+    std::uint64_t missCount() const;
+
+private:
+    struct SEntry
+    {
+        HandleT d_handle;
+        size_t d_refCount;
+    };
+
+    typedef std::map< Key, SEntry > Entries;
+
+    Entries d_entries;
+    std::map< HandleT, typename Entries::iterator > d_handleKeys;
+
+    std::uint64_t d_hitCount;
+    std::uint64_t d_missCount;
+};
+
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+VPP_INLINE THandleCache< HandleT > :: THandleCache() :
+    d_hitCount ( 0 ),
+    d_missCount ( 0 )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+VPP_INLINE std::uint64_t THandleCache< HandleT > :: hashWords ( const Words& words )
+{
+    // FNV-1a over 64-bit words.
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for ( std::uint64_t word : words )
+    {
+        hash ^= word;
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+VPP_INLINE HandleT THandleCache< HandleT > :: acquire ( const Key& key )
+{
+    const typename Entries::iterator iEntry = d_entries.find ( key );
+
+    if ( iEntry == d_entries.end() )
+    {
+        ++d_missCount;
+        return VK_NULL_HANDLE;
+    }
+
+    ++iEntry->second.d_refCount;
+    ++d_hitCount;
+    return iEntry->second.d_handle;
+}
+
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+VPP_INLINE void THandleCache< HandleT > :: add ( const Key& key, HandleT handle )
+{
+    const SEntry entry = { handle, 1 };
+
+    const typename Entries::iterator iNewEntry =
+        d_entries.insert ( std::make_pair ( key, entry ) ).first;
+
+    d_handleKeys.insert ( std::make_pair ( handle, iNewEntry ) );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+VPP_INLINE bool THandleCache< HandleT > :: release ( HandleT handle )
+{
+    const auto iKey = d_handleKeys.find ( handle );
+
+    if ( iKey == d_handleKeys.end() )
+        return true;
+
+    if ( --iKey->second->second.d_refCount != 0 )
+        return false;
+
+    d_entries.erase ( iKey->second );
+    d_handleKeys.erase ( iKey );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+template< class FunctionT >
+VPP_INLINE void THandleCache< HandleT > :: forEachHandle ( FunctionT fFunction ) const
+{
+    for ( const auto& iEntry : d_entries )
+        fFunction ( iEntry.second.d_handle );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+VPP_INLINE size_t THandleCache< HandleT > :: size() const
+{
+    return d_entries.size();
+}
+
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+VPP_INLINE std::uint64_t THandleCache< HandleT > :: hitCount() const
+{
+    return d_hitCount;
+}
+
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+VPP_INLINE std::uint64_t THandleCache< HandleT > :: missCount() const
+{
+    return d_missCount;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPHANDLECACHE_HPP
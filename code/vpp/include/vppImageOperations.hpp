@@ -41,6 +41,10 @@
 #include "vppImage.hpp"
 #endif
 
+#ifndef INC_VPPEXCEPTIONS_HPP
+#include "vppExceptions.hpp"
+#endif
+
 // -----------------------------------------------------------------------------
 namespace vpp {
 // -----------------------------------------------------------------------------
@@ -102,9 +106,53 @@ private:
     VkImageLayout d_finalLayout;
 };
 
+// -----------------------------------------------------------------------------
+
+// Generates mip levels of an image on the GPU, by a chain of linear blits
+// (each level from the previous one). For sRGB formats blits filter in linear
+// space, so no manual conversion is needed. Falls back to nearest filtering
+// for formats which do not support linear filtering.
+//
+// Levels up to and including baseLevel must contain valid data and be in
+// TRANSFER_DST_OPTIMAL layout. Contents of higher levels are discarded.
+// The image requires both Img::SOURCE and Img::TARGET usage.
+
+class GenerateMipmaps : public CompiledProcedures
+{
+public:
+    VPP_INLINE GenerateMipmaps (
+        const Img& targetImage,
+        std::uint32_t baseLevel = 0,
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ) :
+            CompiledProcedures ( targetImage.device(), Q_GRAPHICS ),
+            d_targetImage ( targetImage ),
+            d_baseLevel ( baseLevel ),
+            d_finalLayout ( finalLayout )
+    {
+        init();
+    }
+
+    Procedure execute;
+
+    // Number of mip levels of a full chain for given extent.
+    VPP_DLLAPI static std::uint32_t fullChainLevels ( const VkExtent3D& extent );
+
+private:
+    void init();
+
+private:
+    Img d_targetImage;
+    std::uint32_t d_baseLevel;
+    VkImageLayout d_finalLayout;
+};
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
+// Loads an image from host memory. If defineLevels() supplies fewer levels
+// than getImageMipLevels(), the remaining ones are generated on the GPU
+// (see GenerateMipmaps), which requires Img::SOURCE usage of the image.
+
 template< class ImageT >
 class TImageLoader
 {
@@ -176,12 +224,42 @@ void TImageLoader< ImageT > :: load()
         std::vector< VkBufferImageCopy > regions;
         defineLevels ( & regions );
 
+        std::uint32_t nSuppliedLevels = 0;
+
+        for ( const auto& iRegion : regions )
+            nSuppliedLevels = std::max (
+                nSuppliedLevels, iRegion.imageSubresource.mipLevel + 1 );
+
+        const bool bGenerateLevels =
+            nSuppliedLevels > 0 && nSuppliedLevels < getImageMipLevels();
+
+        if ( bGenerateLevels
+             && ! ( attributes_type::usage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT ) )
+        {
+            throw XUsageError (
+                "Loaded image must have TRANSFER_SRC usage bit set to generate mip levels." );
+        }
+
         // FIXME: zapodajemy Queue::TRANSFER ale CommandPool uzywany wewnatrz
         // CopyImageToDevice jest polaczony z Queue::GRAPHICS i Vulkan sie
         // o to pluje
 
-        CopyImageToDevice imageDataCopier ( d_sourceMemory, d_targetMemory, regions );
-        imageDataCopier.execute ( Q_GRAPHICS, d_loadFinished );
+        if ( bGenerateLevels )
+        {
+            CopyImageToDevice imageDataCopier (
+                d_sourceMemory, d_targetMemory, regions,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+
+            GenerateMipmaps mipmapGenerator ( d_image, nSuppliedLevels - 1 );
+
+            imageDataCopier.execute ( Q_GRAPHICS );
+            mipmapGenerator.execute ( Q_GRAPHICS, d_loadFinished );
+        }
+        else
+        {
+            CopyImageToDevice imageDataCopier ( d_sourceMemory, d_targetMemory, regions );
+            imageDataCopier.execute ( Q_GRAPHICS, d_loadFinished );
+        }
     }
 }
 
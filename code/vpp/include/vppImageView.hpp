@@ -396,7 +396,11 @@ public:
 
     VPP_INLINE ~TImageViewImpl()
     {
-        ::vkDestroyImageView ( d_hDevice.handle(), d_handle, 0 );
+        const VkDevice hDevice = d_hDevice.handle();
+        const VkImageView hImageView = d_handle;
+
+        d_hDevice.destructionQueue().enqueue ( [ hDevice, hImageView ]() {
+            ::vkDestroyImageView ( hDevice, hImageView, 0 ); } );
     }
 
 private:
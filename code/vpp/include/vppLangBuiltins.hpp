@@ -151,9 +151,12 @@ struct inWorkgroupSize : public KShaderScopedVariable
 
     VPP_INLINE inWorkgroupSize (
         const SLocalGroupSize& localSize,
-        spv::Function* pFunction ) :
+        spv::Function* pFunction,
+        const SLocalGroupSpecIds* pLocalSizeIds = 0 ) :
             d_pFunction ( pFunction ),
             d_localSize ( localSize ),
+            d_localSizeIds ( pLocalSizeIds ? *pLocalSizeIds : SLocalGroupSpecIds { 0, 0, 0 } ),
+            d_bSpecialized ( pLocalSizeIds != 0 ),
             d_id ( 0 )
     {}
 
@@ -169,6 +172,8 @@ struct inWorkgroupSize : public KShaderScopedVariable
 private:
     spv::Function* d_pFunction;
     const SLocalGroupSize d_localSize;
+    const SLocalGroupSpecIds d_localSizeIds;
+    const bool d_bSpecialized;
     mutable KId d_id;
 };
 
@@ -68,10 +68,114 @@ public:
     KId d_variableId;
 };
 
+// -----------------------------------------------------------------------------
+
+template< int INDEX, int END, int STEP, bool LAST = ( STEP > 0 ? INDEX >= END : INDEX <= END ) >
+struct TStaticFor
+{
+    template< class BodyT >
+    static VPP_INLINE void run ( BodyT& body )
+    {
+        body ( std::integral_constant< int, INDEX >() );
+        TStaticFor< INDEX + STEP, END, STEP >::run ( body );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template< int INDEX, int END, int STEP >
+struct TStaticFor< INDEX, END, STEP, true >
+{
+    template< class BodyT >
+    static VPP_INLINE void run ( BodyT& )
+    {
+    }
+};
+
 // -----------------------------------------------------------------------------
 } // namespace detail
 // -----------------------------------------------------------------------------
 
+// Hints for OpLoopMerge, accepted by Do() and For(). Combine with operator|.
+// Unroll and DontUnroll are mutually exclusive. Dependency hints promise that
+// iterations do not depend on each other (DependencyInfinite) or only on
+// iterations at least the given distance back (DependencyLength). They
+// require SPIR-V 1.1, i.e. Vulkan 1.1 device.
+
+class LoopControl
+{
+public:
+    VPP_INLINE LoopControl() :
+        d_flags ( spv::LoopControlMaskNone ),
+        d_dependencyLength ( 0 )
+    {}
+
+    VPP_INLINE explicit LoopControl ( unsigned int flags, unsigned int dependencyLength = 0 ) :
+        d_flags ( flags ),
+        d_dependencyLength ( dependencyLength )
+    {}
+
+    VPP_INLINE LoopControl operator| ( const LoopControl& rhs ) const
+    {
+        return LoopControl (
+            d_flags | rhs.d_flags,
+            std::max ( d_dependencyLength, rhs.d_dependencyLength ) );
+    }
+
+    unsigned int d_flags;
+    unsigned int d_dependencyLength;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE LoopControl Unroll()
+{
+    return LoopControl ( spv::LoopControlUnrollMask );
+}
+
+VPP_INLINE LoopControl DontUnroll()
+{
+    return LoopControl ( spv::LoopControlDontUnrollMask );
+}
+
+VPP_INLINE LoopControl DependencyInfinite()
+{
+    return LoopControl ( spv::LoopControlDependencyInfiniteMask );
+}
+
+VPP_INLINE LoopControl DependencyLength ( unsigned int length )
+{
+    return LoopControl ( spv::LoopControlDependencyLengthMask, length );
+}
+
+// -----------------------------------------------------------------------------
+
+// Hints for OpSelectionMerge, accepted by If().
+
+class SelectionControl
+{
+public:
+    VPP_INLINE explicit SelectionControl ( unsigned int flags ) :
+        d_flags ( flags )
+    {}
+
+    unsigned int d_flags;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE SelectionControl Flatten()
+{
+    return SelectionControl ( spv::SelectionControlFlattenMask );
+}
+
+VPP_INLINE SelectionControl DontFlatten()
+{
+    return SelectionControl ( spv::SelectionControlDontFlattenMask );
+}
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE void If ( Bool v )
 {
     KShaderTranslator::get()->pushIf ( v );
@@ -79,6 +183,13 @@ VPP_INLINE void If ( Bool v )
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE void If ( Bool v, const SelectionControl& control )
+{
+    KShaderTranslator::get()->pushIf ( v, control.d_flags );
+}
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE void Else()
 {
     KShaderTranslator::get()->makeElse();
@@ -94,7 +205,7 @@ VPP_INLINE void Fi()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-VPP_INLINE void Do()
+VPP_INLINE void Do ( const LoopControl& control = LoopControl() )
 {
     KShaderTranslator* pBuilder = KShaderTranslator::get();
     KShaderTranslator::LoopBlocks& blocks = pBuilder->pushLoop();
@@ -103,7 +214,8 @@ VPP_INLINE void Do()
     pBuilder->setBuildPoint ( & blocks.head );
 
     pBuilder->createLoopMerge (
-        & blocks.merge, & blocks.continue_target, spv::LoopControlMaskNone );
+        & blocks.merge, & blocks.continue_target,
+        control.d_flags, control.d_dependencyLength );
         
     spv::Block& test = pBuilder->makeNewBlock();
     pBuilder->createBranch ( & test );
@@ -139,28 +251,48 @@ VPP_INLINE void Od()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-VPP_INLINE void For ( VInt& variable, const Int& begin, const Int& end, const Int& step = Int(1) )
+VPP_INLINE void For (
+    VInt& variable, const Int& begin, const Int& end, const Int& step = Int(1),
+    const LoopControl& control = LoopControl() )
 {
     KShaderTranslator* pBuilder = KShaderTranslator::get();
     variable = begin;
-    Do();
+    Do ( control );
     While ( variable < end );
     pBuilder->pushFor ( variable.id(), step.id(), false );
 }
 
 // -----------------------------------------------------------------------------
 
-VPP_INLINE void For ( VUInt& variable, const UInt& begin, const UInt& end, const UInt& step = UInt(1) )
+VPP_INLINE void For (
+    VUInt& variable, const UInt& begin, const UInt& end, const UInt& step = UInt(1),
+    const LoopControl& control = LoopControl() )
 {
     KShaderTranslator* pBuilder = KShaderTranslator::get();
     variable = begin;
-    Do();
+    Do ( control );
     While ( variable < end );
     pBuilder->pushFor ( variable.id(), step.id(), true );
 }
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE void For (
+    VInt& variable, const Int& begin, const Int& end, const LoopControl& control )
+{
+    For ( variable, begin, end, Int ( 1 ), control );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void For (
+    VUInt& variable, const UInt& begin, const UInt& end, const LoopControl& control )
+{
+    For ( variable, begin, end, UInt ( 1 ), control );
+}
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE void Rof()
 {
     KShaderTranslator* pBuilder = KShaderTranslator::get();
@@ -184,6 +316,29 @@ VPP_INLINE void Rof()
     pBuilder->popFor();
 }
 
+// -----------------------------------------------------------------------------
+
+// Compile-time loop. Emits the body once for each index, as straight-line
+// code. The body gets std::integral_constant< int, i >, usable both as
+// a constant expression and as plain int, e.g.:
+//
+//     StaticFor< 4 >( [&]( auto i ) { acc += inArr [ i ] * weights [ i ]; } );
+
+template< int COUNT, class BodyT >
+VPP_INLINE void StaticFor ( BodyT&& body )
+{
+    detail::TStaticFor< 0, COUNT, 1 >::run ( body );
+}
+
+// -----------------------------------------------------------------------------
+
+template< int BEGIN, int END, int STEP = 1, class BodyT >
+VPP_INLINE void StaticFor ( BodyT&& body )
+{
+    static_assert ( STEP != 0, "StaticFor step must not be zero" );
+    detail::TStaticFor< BEGIN, END, STEP >::run ( body );
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
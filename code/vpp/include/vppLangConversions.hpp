@@ -70,6 +70,22 @@ VPP_INLINE spv::Id reduceIntegerTypeTo32 ( spv::Id type, bool bSigned )
         return componentType;
 }
 
+// -----------------------------------------------------------------------------
+
+VPP_INLINE spv::Id resizeIntegerType ( spv::Id type, int width, bool bSigned )
+{
+    KShaderTranslator* pTranslator = KShaderTranslator::get();
+    const spv::Id componentType = pTranslator->makeIntegerType ( width, bSigned );
+
+    if ( pTranslator->isVectorType ( type ) )
+    {
+        const int nComponents = pTranslator->getNumTypeComponents ( type );
+        return pTranslator->makeVectorType ( componentType, nComponents );
+    }
+    else
+        return componentType;
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
@@ -600,6 +616,182 @@ struct TConvertBaseTypes< TargetT, SourceT, std::uint64_t, bool >
     }
 };
 
+// -----------------------------------------------------------------------------
+// Conversions involving 8-bit and 16-bit integers. These are generated
+// generically, as there are too many combinations to list them one by one.
+// -----------------------------------------------------------------------------
+
+template< class TargetT, class SourceT, typename TargetScalarT, typename SourceScalarT >
+struct TConvertIntegerTypes
+{
+    VPP_INLINE TargetT operator()( const SourceT& source ) const
+    {
+        KShaderTranslator* pTranslator = KShaderTranslator::get();
+
+        const bool bSourceSigned = scalar_traits< SourceScalarT >::isSignedInt;
+        const bool bTargetSigned = scalar_traits< TargetScalarT >::isSignedInt;
+        const spv::Id targetType = TargetT::getType();
+
+        // Width change must keep the signedness of the source, so that
+        // the value is sign-extended or zero-extended properly.
+        const spv::Op convertOp = bSourceSigned ? spv::OpSConvert : spv::OpUConvert;
+
+        if ( bSourceSigned == bTargetSigned )
+            return TargetT ( KId ( pTranslator->createUnaryOp (
+                convertOp, targetType, source.id() ) ) );
+
+        spv::Id sourceId = source.id();
+
+        if ( sizeof ( TargetScalarT ) != sizeof ( SourceScalarT ) )
+        {
+            const int targetWidth = 8 * static_cast< int >( sizeof ( TargetScalarT ) );
+
+            const spv::Id resizedType =
+                resizeIntegerType ( SourceT::getType(), targetWidth, bSourceSigned );
+
+            sourceId = pTranslator->createUnaryOp ( convertOp, resizedType, sourceId );
+        }
+
+        return TargetT ( KId ( pTranslator->createUnaryOp (
+            spv::OpBitcast, targetType, sourceId ) ) );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template< class TargetT, class SourceT, typename SourceScalarT >
+struct TConvertIntegerToFloat
+{
+    VPP_INLINE TargetT operator()( const SourceT& source ) const
+    {
+        const spv::Op op = scalar_traits< SourceScalarT >::isSignedInt ?
+            spv::OpConvertSToF : spv::OpConvertUToF;
+
+        return TargetT ( KId ( KShaderTranslator::get()->createUnaryOp (
+            op, TargetT::getType(), source.id() ) ) );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template< class TargetT, class SourceT, typename TargetScalarT >
+struct TConvertFloatToInteger
+{
+    VPP_INLINE TargetT operator()( const SourceT& source ) const
+    {
+        const spv::Op op = scalar_traits< TargetScalarT >::isSignedInt ?
+            spv::OpConvertFToS : spv::OpConvertFToU;
+
+        return TargetT ( KId ( KShaderTranslator::get()->createUnaryOp (
+            op, TargetT::getType(), source.id() ) ) );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template< class TargetT, class SourceT, typename SourceScalarT >
+struct TConvertIntegerToBool
+{
+    VPP_INLINE TargetT operator()( const SourceT& source ) const
+    {
+        KShaderTranslator* pTranslator = KShaderTranslator::get();
+        const SourceT zero = SourceT ( SourceScalarT ( 0 ) );
+
+        return TargetT ( KId ( pTranslator->createBinOp (
+            spv::OpINotEqual, TargetT::getType(), source.id(), zero.id() ) ) );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template< class TargetT, class SourceT, typename TargetScalarT >
+struct TConvertBoolToInteger
+{
+    VPP_INLINE TargetT operator()( const SourceT& source ) const
+    {
+        KShaderTranslator* pTranslator = KShaderTranslator::get();
+        const TargetT zero = TargetT ( TargetScalarT ( 0 ) );
+        const TargetT one = TargetT ( TargetScalarT ( 1 ) );
+
+        std::vector< spv::Id > operands ( 3 );
+        operands [ 0 ] = source.id();
+        operands [ 1 ] = one.id();
+        operands [ 2 ] = zero.id();
+
+        return TargetT ( KId ( pTranslator->createOp (
+            spv::OpSelect, TargetT::getType(), operands ) ) );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+#define VPP_DEFINE_INTEGER_CONVERSIONS( FirstT, SecondT ) \
+template< class TargetT, class SourceT > \
+struct TConvertBaseTypes< TargetT, SourceT, FirstT, SecondT > : \
+    public TConvertIntegerTypes< TargetT, SourceT, FirstT, SecondT > {}; \
+template< class TargetT, class SourceT > \
+struct TConvertBaseTypes< TargetT, SourceT, SecondT, FirstT > : \
+    public TConvertIntegerTypes< TargetT, SourceT, SecondT, FirstT > {}; \
+
+#define VPP_DEFINE_FLOAT_CONVERSIONS( IntegerT, FloatT ) \
+template< class TargetT, class SourceT > \
+struct TConvertBaseTypes< TargetT, SourceT, FloatT, IntegerT > : \
+    public TConvertIntegerToFloat< TargetT, SourceT, IntegerT > {}; \
+template< class TargetT, class SourceT > \
+struct TConvertBaseTypes< TargetT, SourceT, IntegerT, FloatT > : \
+    public TConvertFloatToInteger< TargetT, SourceT, IntegerT > {}; \
+
+#define VPP_DEFINE_BOOL_CONVERSIONS( IntegerT ) \
+template< class TargetT, class SourceT > \
+struct TConvertBaseTypes< TargetT, SourceT, bool, IntegerT > : \
+    public TConvertIntegerToBool< TargetT, SourceT, IntegerT > {}; \
+template< class TargetT, class SourceT > \
+struct TConvertBaseTypes< TargetT, SourceT, IntegerT, bool > : \
+    public TConvertBoolToInteger< TargetT, SourceT, IntegerT > {}; \
+
+// -----------------------------------------------------------------------------
+
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int8_t, std::uint8_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int8_t, std::int16_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int8_t, std::uint16_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint8_t, std::int16_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint8_t, std::uint16_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int16_t, std::uint16_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int8_t, std::int32_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int8_t, std::uint32_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int8_t, std::int64_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int8_t, std::uint64_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint8_t, std::int32_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint8_t, std::uint32_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint8_t, std::int64_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint8_t, std::uint64_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int16_t, std::int32_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int16_t, std::uint32_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int16_t, std::int64_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::int16_t, std::uint64_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint16_t, std::int32_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint16_t, std::uint32_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint16_t, std::int64_t )
+VPP_DEFINE_INTEGER_CONVERSIONS ( std::uint16_t, std::uint64_t )
+
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::int8_t, float16_t )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::int8_t, float )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::int8_t, double )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::uint8_t, float16_t )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::uint8_t, float )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::uint8_t, double )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::int16_t, float16_t )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::int16_t, float )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::int16_t, double )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::uint16_t, float16_t )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::uint16_t, float )
+VPP_DEFINE_FLOAT_CONVERSIONS ( std::uint16_t, double )
+
+VPP_DEFINE_BOOL_CONVERSIONS ( std::int8_t )
+VPP_DEFINE_BOOL_CONVERSIONS ( std::uint8_t )
+VPP_DEFINE_BOOL_CONVERSIONS ( std::int16_t )
+VPP_DEFINE_BOOL_CONVERSIONS ( std::uint16_t )
+
 // -----------------------------------------------------------------------------
 
 template< class IdentityT, class IdentityScalarT >
@@ -761,6 +953,33 @@ struct TCastBaseTypes< TargetT, SourceT, std::uint64_t, double >
     }
 };
 
+// -----------------------------------------------------------------------------
+
+template< class TargetT, class SourceT >
+struct TCastBitwise
+{
+    VPP_INLINE TargetT operator()( const SourceT& source ) const
+    {
+        return TargetT ( KId ( KShaderTranslator::get()->createUnaryOp (
+            spv::OpBitcast, TargetT::getType(), source.id() ) ) );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+#define VPP_DEFINE_BITWISE_CASTS( FirstT, SecondT ) \
+template< class TargetT, class SourceT > \
+struct TCastBaseTypes< TargetT, SourceT, FirstT, SecondT > : \
+    public TCastBitwise< TargetT, SourceT > {}; \
+template< class TargetT, class SourceT > \
+struct TCastBaseTypes< TargetT, SourceT, SecondT, FirstT > : \
+    public TCastBitwise< TargetT, SourceT > {}; \
+
+VPP_DEFINE_BITWISE_CASTS ( std::int8_t, std::uint8_t )
+VPP_DEFINE_BITWISE_CASTS ( std::int16_t, std::uint16_t )
+VPP_DEFINE_BITWISE_CASTS ( std::int16_t, float16_t )
+VPP_DEFINE_BITWISE_CASTS ( std::uint16_t, float16_t )
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
@@ -186,6 +186,61 @@ private:
     std::uint32_t d_count;
 };
 
+// -----------------------------------------------------------------------------
+
+// Bindless variant of arrayOf. The binding is update-after-bind and partially
+// bound, so the array can be large and only the used slots need valid
+// descriptors. If it has the largest binding number in its set, it is also
+// variable-sized. Indexing in shaders is non-uniform (NonUniformEXT), so
+// the index may differ between invocations, e.g. come from per-draw or
+// per-vertex data. Use DescriptorSlotAllocator to manage slots on the host.
+// Requires VK_EXT_descriptor_indexing features for respective descriptor type.
+// These are checked when the array is accessed in a shader (XMissingFeature).
+
+template< class SingleT >
+class bindlessArrayOf : public arrayOf< SingleT >
+{
+public:
+    typedef arrayOf< SingleT > base_type;
+    typedef typename base_type::return_type return_type;
+
+    static const VkDescriptorBindingFlagsEXT BINDING_FLAGS =
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT
+        | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT
+        | VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT;
+
+    VPP_INLINE bindlessArrayOf (
+        std::uint32_t capacity,
+        std::uint32_t set = 0,
+        int binding = -1 ) :
+            base_type ( capacity, set, binding )
+    {
+        PipelineConfig::getInstance()->getResource ( this->resource().id() ).d_bindingFlags =
+            BINDING_FLAGS;
+    }
+
+    using base_type::operator=;
+
+    template< typename IndexT >
+    VPP_INLINE return_type getItem ( const IndexT& index ) const
+    {
+        KShaderTranslator* pTranslator = KShaderTranslator::get();
+        pTranslator->useBindingFlags ( SingleT::assigner_type::type_code, BINDING_FLAGS );
+        pTranslator->useNonUniformIndexing ( SingleT::assigner_type::type_code );
+
+        const return_type result =
+            this->resource().getArrayedDescriptor ( pTranslator->getArrayIndex ( index ) );
+
+        pTranslator->decorateNonUniform ( result.id() );
+        return result;
+    }
+
+    VPP_INLINE return_type operator[]( const Int& index ) const { return getItem ( index ); }
+    VPP_INLINE return_type operator[]( const UInt& index ) const { return getItem ( index ); }
+    VPP_INLINE return_type operator[]( int index ) const { return getItem ( index ); }
+    VPP_INLINE return_type operator[]( unsigned int index ) const { return getItem ( index ); }
+};
+
 // -----------------------------------------------------------------------------
 } // namespace vpp
 // -----------------------------------------------------------------------------
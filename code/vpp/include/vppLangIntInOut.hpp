@@ -41,6 +41,10 @@
 #include "vppDebugProbe.hpp"
 #endif
 
+#ifndef INC_VPPDEBUGPRINT_HPP
+#include "vppDebugPrint.hpp"
+#endif
+
 #ifndef INC_VPPLANGCONVERSIONS_HPP
 #include "vppLangConversions.hpp"
 #endif
@@ -70,6 +74,14 @@ public:
         const IVec2& coords,
         const VkExtent3D& extent );
 
+    bool isDebugPrintEnabled() const;
+
+    template< typename... Args >
+    void DebugPrintAt ( const IVec3& invocation, const char* pFormat, const Args&... args );
+
+    template< typename... Args >
+    void DebugPrint ( const char* pFormat, const Args&... args );
+
     const Device& device() const;
 
 protected:
@@ -197,6 +209,9 @@ public:
         const IVec2& coords,
         const VkExtent3D& extent );
 
+    template< typename... Args >
+    void DebugPrint ( const char* pFormat, const Args&... args );
+
     // builtin variables
 
     var::inFragCoord inFragCoord;
@@ -220,15 +235,22 @@ private:
 class ComputeShader : public Shader
 {
 public:
-    VPP_INLINE ComputeShader ( const SLocalGroupSize& localSize ) :
-        Shader ( spv::ExecutionModelGLCompute ),
-        inWorkgroupSize ( localSize, d_pFunction ),
-        d_localGroupSize ( localSize )
+    VPP_INLINE ComputeShader (
+        const SLocalGroupSize& localSize,
+        const SLocalGroupSpecIds* pLocalSizeIds = 0 ) :
+            Shader ( spv::ExecutionModelGLCompute ),
+            inWorkgroupSize ( localSize, d_pFunction, pLocalSizeIds ),
+            d_localGroupSize ( localSize )
     {
-        d_pTranslator->addExecutionMode (
-            d_pFunction, spv::ExecutionModeLocalSize,
-            localSize.x, localSize.y, localSize.z
-        );
+        d_pTranslator->addExecutionMode (
+            d_pFunction, spv::ExecutionModeLocalSize,
+            localSize.x, localSize.y, localSize.z
+        );
+
+        // Specialized WorkgroupSize built-in overrides LocalSize mode, so it
+        // must be emitted even if the shader does not read it.
+        if ( pLocalSizeIds )
+            static_cast< void >( static_cast< var::inWorkgroupSize::rvalue_type >( inWorkgroupSize ) );
     }
 
     VPP_INLINE const SLocalGroupSize& localGroupSize() const
@@ -248,6 +270,9 @@ public:
 
     static const EShader shader_type = SH_COMPUTE;
 
+    template< typename... Args >
+    void DebugPrint ( const char* pFormat, const Args&... args );
+
     var::inWorkgroupId inWorkgroupId;
     var::inNumWorkgroups inNumWorkgroups;
     var::inLocalInvocationId inLocalInvocationId;
@@ -296,6 +321,35 @@ VPP_INLINE const Device& Shader :: device() const
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE bool Shader :: isDebugPrintEnabled() const
+{
+    return PipelineConfig::getInstance()->getDebugPrint() != 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename... Args >
+void Shader :: DebugPrintAt (
+    const IVec3& invocation, const char* pFormat, const Args&... args )
+{
+    if ( IDebugProbe* pDebugPrint = PipelineConfig::getInstance()->getDebugPrint() )
+    {
+        static_cast< detail::KDebugPrintProbe* >( pDebugPrint )->write (
+            invocation, pFormat, args... );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename... Args >
+void Shader :: DebugPrint ( const char* pFormat, const Args&... args )
+{
+    if ( isDebugPrintEnabled() )
+        DebugPrintAt ( IVec3 ( 0, 0, 0 ), pFormat, args... );
+}
+
+// -----------------------------------------------------------------------------
+
 template< class ValueT >
 void FragmentShader :: DebugProbe ( const ValueT& value )
 {
@@ -328,6 +382,38 @@ void FragmentShader :: DebugProbe (
     Shader::DebugProbe ( value, coords, extent );
 }
 
+// -----------------------------------------------------------------------------
+
+template< typename... Args >
+void FragmentShader :: DebugPrint ( const char* pFormat, const Args&... args )
+{
+    // Invocations are identified by pixel coordinates.
+
+    if ( isDebugPrintEnabled() )
+    {
+        const Vec4 fragCoord = inFragCoord;
+        const IVec2 pixelCoord = StaticCast< IVec2 >( fragCoord [ XY ] );
+        const Int x = pixelCoord [ X ];
+        const Int y = pixelCoord [ Y ];
+        const Int zero = 0;
+        DebugPrintAt ( IVec3 ( x, y, zero ), pFormat, args... );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename... Args >
+void ComputeShader :: DebugPrint ( const char* pFormat, const Args&... args )
+{
+    // Invocations are identified by global invocation id.
+
+    if ( isDebugPrintEnabled() )
+    {
+        const IVec3 globalId = inGlobalInvocationId;
+        DebugPrintAt ( globalId, pFormat, args... );
+    }
+}
+
 // -----------------------------------------------------------------------------
 // 14.1. Shader Input and Output Interfaces
 // -----------------------------------------------------------------------------
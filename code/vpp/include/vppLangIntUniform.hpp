@@ -397,6 +397,119 @@ VPP_INLINE inPushConstant< TDef > :: inPushConstant() :
     resInfo.size = sizeof ( d_data );
 }
 
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+// Specialization constant. Declare it in the pipeline configuration and read
+// in shader code through SpecConst. Pipelines created from the same layout
+// can use different values (see SpecializationValues) without translating
+// shaders again. Supported types: int, unsigned int, float, bool.
+
+template< typename ValueT >
+class specConst
+{
+public:
+    typedef ValueT value_type;
+
+    static_assert (
+        std::is_same< ValueT, int >::value
+        || std::is_same< ValueT, unsigned int >::value
+        || std::is_same< ValueT, float >::value
+        || std::is_same< ValueT, bool >::value,
+        "Specialization constant must be int, unsigned int, float or bool" );
+
+    specConst ( ValueT defaultValue = ValueT() );
+
+    std::uint32_t id() const;
+    ValueT defaultValue() const;
+
+    static std::uint32_t toBits ( ValueT value );
+    static ValueT fromBits ( std::uint32_t bits );
+
+private:
+    std::uint32_t d_id;
+    ValueT d_defaultValue;
+};
+
+// -----------------------------------------------------------------------------
+
+template< typename ValueT >
+VPP_INLINE specConst< ValueT > :: specConst ( ValueT defaultValue ) :
+    d_id ( PipelineConfig::getInstance()->createSpecializationConstant ( toBits ( defaultValue ) ) ),
+    d_defaultValue ( defaultValue )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename ValueT >
+VPP_INLINE std::uint32_t specConst< ValueT > :: id() const
+{
+    return d_id;
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename ValueT >
+VPP_INLINE ValueT specConst< ValueT > :: defaultValue() const
+{
+    return d_defaultValue;
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename ValueT >
+VPP_INLINE std::uint32_t specConst< ValueT > :: toBits ( ValueT value )
+{
+    std::uint32_t result;
+    std::memcpy ( & result, & value, sizeof ( result ) );
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+template<>
+VPP_INLINE std::uint32_t specConst< bool > :: toBits ( bool value )
+{
+    return value ? VK_TRUE : VK_FALSE;
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename ValueT >
+VPP_INLINE ValueT specConst< ValueT > :: fromBits ( std::uint32_t bits )
+{
+    ValueT result;
+    std::memcpy ( & result, & bits, sizeof ( result ) );
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+template<>
+VPP_INLINE bool specConst< bool > :: fromBits ( std::uint32_t bits )
+{
+    return bits != VK_FALSE;
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename ValueT >
+class SpecConst : public detail::TGetRV< ValueT >::type
+{
+public:
+    SpecConst ( const specConst< ValueT >& constant );
+};
+
+// -----------------------------------------------------------------------------
+
+template< typename ValueT >
+VPP_INLINE SpecConst< ValueT > :: SpecConst ( const specConst< ValueT >& constant ) :
+    detail::TGetRV< ValueT >::type ( KShaderTranslator::get()->makeSpecConstant (
+        constant.id(), constant.defaultValue() ) )
+{
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 // GPU-side structural type definitions.
@@ -472,6 +585,54 @@ struct UniformFld< CPU, double >
 
 // -----------------------------------------------------------------------------
 
+template<>
+struct UniformFld< CPU, std::int8_t >
+{
+    VPP_INLINE UniformFld() {}
+    VPP_INLINE UniformFld ( std::int8_t value ) : d_value ( value ) {}
+    VPP_INLINE operator std::int8_t& () { return d_value; }
+    VPP_INLINE operator std::int8_t () const { return d_value; }
+    std::int8_t d_value;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct UniformFld< CPU, std::uint8_t >
+{
+    VPP_INLINE UniformFld() {}
+    VPP_INLINE UniformFld ( std::uint8_t value ) : d_value ( value ) {}
+    VPP_INLINE operator std::uint8_t& () { return d_value; }
+    VPP_INLINE operator std::uint8_t () const { return d_value; }
+    std::uint8_t d_value;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct UniformFld< CPU, std::int16_t >
+{
+    VPP_INLINE UniformFld() {}
+    VPP_INLINE UniformFld ( std::int16_t value ) : d_value ( value ) {}
+    VPP_INLINE operator std::int16_t& () { return d_value; }
+    VPP_INLINE operator std::int16_t () const { return d_value; }
+    std::int16_t d_value;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct UniformFld< CPU, std::uint16_t >
+{
+    VPP_INLINE UniformFld() {}
+    VPP_INLINE UniformFld ( std::uint16_t value ) : d_value ( value ) {}
+    VPP_INLINE operator std::uint16_t& () { return d_value; }
+    VPP_INLINE operator std::uint16_t () const { return d_value; }
+    std::uint16_t d_value;
+};
+
+// -----------------------------------------------------------------------------
+
 template< typename C1, typename C2, typename C3, typename C4, typename C5 >
 struct UniformFld< CPU, format< C1, C2, C3, C4, C5 > >
 {
@@ -742,9 +903,16 @@ public:
     typedef StructAccessor< GDefinition, true, ! isReadOnly > return_type;
 
     VPP_INLINE UniformVar ( arrayOf< BufferT >& bufs ) :
+        UniformVar ( bufs, false )
+    {
+    }
+
+protected:
+    VPP_INLINE UniformVar ( arrayOf< BufferT >& bufs, bool bNonUniform ) :
         detail::KUniformAccess ( BufferT::decoration ),
         d_id ( 0 ),
-        d_typeId ( 0 )
+        d_typeId ( 0 ),
+        d_bNonUniform ( bNonUniform )
     {
         const BufferT& buf = bufs.resource();
         buf.verify ( KShaderTranslator::get()->getDevice() );
@@ -756,6 +924,7 @@ public:
         d_count = bufs.count();
     }
 
+public:
     VPP_INLINE KId id() const
     {
         return d_id;
@@ -783,6 +952,10 @@ public:
         pTranslator->clearAccessChain();
         pTranslator->setAccessChainLValue ( id() );
         pTranslator->accessChainPush ( pTranslator->getArrayIndex ( index ) );
+
+        if ( d_bNonUniform )
+            pTranslator->accessChainSetNonUniform();
+
         return return_type ( & d_struct, pTranslator->getAccessChain() );
     }
 
@@ -797,6 +970,31 @@ private:
     KId d_id;
     KId d_typeId;
     int d_count;
+    bool d_bNonUniform;
+};
+
+// -----------------------------------------------------------------------------
+
+// Array of buffers declared with bindlessArrayOf. Access goes through the same
+// getItem() as for arrayOf, but the access chain is decorated NonUniformEXT,
+// so the index may differ between invocations.
+
+template< template< vpp::ETag TAG > class TDef, class BufferT >
+class UniformVar< TDef, bindlessArrayOf< BufferT > > :
+    public UniformVar< TDef, arrayOf< BufferT > >
+{
+public:
+    typedef UniformVar< TDef, arrayOf< BufferT > > base_type;
+
+    VPP_INLINE UniformVar ( bindlessArrayOf< BufferT >& bufs ) :
+        base_type ( bufs, true )
+    {
+        const VkDescriptorType descriptorType = BufferT::assigner_type::type_code;
+
+        KShaderTranslator* pTranslator = KShaderTranslator::get();
+        pTranslator->useBindingFlags ( descriptorType, bindlessArrayOf< BufferT >::BINDING_FLAGS );
+        pTranslator->useNonUniformIndexing ( descriptorType );
+    }
 };
 
 // -----------------------------------------------------------------------------
@@ -368,6 +368,192 @@ struct scalar_traits< std::uint64_t >
     static const spv::Op opLssEq = spv::OpULessThanEqual;
 };
 
+// -----------------------------------------------------------------------------
+
+template<>
+struct scalar_traits< std::int8_t >
+{
+    static const size_t component_count = 1;
+    static const bool isBool = false;
+    static const bool isInteger = true;
+    static const bool isSignedInt = true;
+    static const bool isUnsignedInt = false;
+    static const bool isFloat = false;
+    static const bool is64bit = false;
+    static const bool isFlatShaded = true;
+
+    static VPP_INLINE KId makeConstant ( std::int8_t v )
+    {
+        return KId ( KShaderTranslator::get()->makeInt8Constant ( v ) );
+    }
+
+    static VPP_INLINE KId getTypeId()
+    {
+        KShaderTranslator* pTranslator = KShaderTranslator::get();
+        pTranslator->useCapability ( spv::CapabilityInt8 );
+        return KId ( pTranslator->makeIntType ( 8 ) );
+    }
+
+    static const spv::Op opAdd = spv::OpIAdd;
+    static const spv::Op opSub = spv::OpISub;
+    static const spv::Op opMul = spv::OpIMul;
+    static const spv::Op opDiv = spv::OpSDiv;
+    static const spv::Op opMod = spv::OpSRem;
+    static const spv::Op opMod2 = spv::OpSMod;
+    static const spv::Op opShl = spv::OpShiftLeftLogical;
+    static const spv::Op opShr = spv::OpShiftRightArithmetic;
+    static const spv::Op opBitOr = spv::OpBitwiseOr;
+    static const spv::Op opBitXor = spv::OpBitwiseXor;
+    static const spv::Op opBitAnd = spv::OpBitwiseAnd;
+    static const spv::Op opNeg = spv::OpSNegate;
+    static const spv::Op opBitNot = spv::OpNot;
+    static const spv::Op opEqual = spv::OpIEqual;
+    static const spv::Op opNotEqual = spv::OpINotEqual;
+    static const spv::Op opGtr = spv::OpSGreaterThan;
+    static const spv::Op opGtrEq = spv::OpSGreaterThanEqual;
+    static const spv::Op opLss = spv::OpSLessThan;
+    static const spv::Op opLssEq = spv::OpSLessThanEqual;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct scalar_traits< std::uint8_t >
+{
+    static const size_t component_count = 1;
+    static const bool isBool = false;
+    static const bool isInteger = true;
+    static const bool isSignedInt = false;
+    static const bool isUnsignedInt = true;
+    static const bool isFloat = false;
+    static const bool is64bit = false;
+    static const bool isFlatShaded = true;
+
+    static VPP_INLINE KId makeConstant ( std::uint8_t v )
+    {
+        return KId ( KShaderTranslator::get()->makeUint8Constant ( v ) );
+    }
+
+    static VPP_INLINE KId getTypeId()
+    {
+        KShaderTranslator* pTranslator = KShaderTranslator::get();
+        pTranslator->useCapability ( spv::CapabilityInt8 );
+        return KId ( pTranslator->makeUintType ( 8 ) );
+    }
+
+    static const spv::Op opAdd = spv::OpIAdd;
+    static const spv::Op opSub = spv::OpISub;
+    static const spv::Op opMul = spv::OpIMul;
+    static const spv::Op opDiv = spv::OpUDiv;
+    static const spv::Op opMod = spv::OpUMod;
+    static const spv::Op opMod2 = spv::OpUMod;
+    static const spv::Op opShl = spv::OpShiftLeftLogical;
+    static const spv::Op opShr = spv::OpShiftRightLogical;
+    static const spv::Op opBitOr = spv::OpBitwiseOr;
+    static const spv::Op opBitXor = spv::OpBitwiseXor;
+    static const spv::Op opBitAnd = spv::OpBitwiseAnd;
+    static const spv::Op opBitNot = spv::OpNot;
+    static const spv::Op opEqual = spv::OpIEqual;
+    static const spv::Op opNotEqual = spv::OpINotEqual;
+    static const spv::Op opGtr = spv::OpUGreaterThan;
+    static const spv::Op opGtrEq = spv::OpUGreaterThanEqual;
+    static const spv::Op opLss = spv::OpULessThan;
+    static const spv::Op opLssEq = spv::OpULessThanEqual;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct scalar_traits< std::int16_t >
+{
+    static const size_t component_count = 1;
+    static const bool isBool = false;
+    static const bool isInteger = true;
+    static const bool isSignedInt = true;
+    static const bool isUnsignedInt = false;
+    static const bool isFloat = false;
+    static const bool is64bit = false;
+    static const bool isFlatShaded = true;
+
+    static VPP_INLINE KId makeConstant ( std::int16_t v )
+    {
+        return KId ( KShaderTranslator::get()->makeInt16Constant ( v ) );
+    }
+
+    static VPP_INLINE KId getTypeId()
+    {
+        KShaderTranslator* pTranslator = KShaderTranslator::get();
+        pTranslator->useCapability ( spv::CapabilityInt16 );
+        return KId ( pTranslator->makeIntType ( 16 ) );
+    }
+
+    static const spv::Op opAdd = spv::OpIAdd;
+    static const spv::Op opSub = spv::OpISub;
+    static const spv::Op opMul = spv::OpIMul;
+    static const spv::Op opDiv = spv::OpSDiv;
+    static const spv::Op opMod = spv::OpSRem;
+    static const spv::Op opMod2 = spv::OpSMod;
+    static const spv::Op opShl = spv::OpShiftLeftLogical;
+    static const spv::Op opShr = spv::OpShiftRightArithmetic;
+    static const spv::Op opBitOr = spv::OpBitwiseOr;
+    static const spv::Op opBitXor = spv::OpBitwiseXor;
+    static const spv::Op opBitAnd = spv::OpBitwiseAnd;
+    static const spv::Op opNeg = spv::OpSNegate;
+    static const spv::Op opBitNot = spv::OpNot;
+    static const spv::Op opEqual = spv::OpIEqual;
+    static const spv::Op opNotEqual = spv::OpINotEqual;
+    static const spv::Op opGtr = spv::OpSGreaterThan;
+    static const spv::Op opGtrEq = spv::OpSGreaterThanEqual;
+    static const spv::Op opLss = spv::OpSLessThan;
+    static const spv::Op opLssEq = spv::OpSLessThanEqual;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct scalar_traits< std::uint16_t >
+{
+    static const size_t component_count = 1;
+    static const bool isBool = false;
+    static const bool isInteger = true;
+    static const bool isSignedInt = false;
+    static const bool isUnsignedInt = true;
+    static const bool isFloat = false;
+    static const bool is64bit = false;
+    static const bool isFlatShaded = true;
+
+    static VPP_INLINE KId makeConstant ( std::uint16_t v )
+    {
+        return KId ( KShaderTranslator::get()->makeUint16Constant ( v ) );
+    }
+
+    static VPP_INLINE KId getTypeId()
+    {
+        KShaderTranslator* pTranslator = KShaderTranslator::get();
+        pTranslator->useCapability ( spv::CapabilityInt16 );
+        return KId ( pTranslator->makeUintType ( 16 ) );
+    }
+
+    static const spv::Op opAdd = spv::OpIAdd;
+    static const spv::Op opSub = spv::OpISub;
+    static const spv::Op opMul = spv::OpIMul;
+    static const spv::Op opDiv = spv::OpUDiv;
+    static const spv::Op opMod = spv::OpUMod;
+    static const spv::Op opMod2 = spv::OpUMod;
+    static const spv::Op opShl = spv::OpShiftLeftLogical;
+    static const spv::Op opShr = spv::OpShiftRightLogical;
+    static const spv::Op opBitOr = spv::OpBitwiseOr;
+    static const spv::Op opBitXor = spv::OpBitwiseXor;
+    static const spv::Op opBitAnd = spv::OpBitwiseAnd;
+    static const spv::Op opBitNot = spv::OpNot;
+    static const spv::Op opEqual = spv::OpIEqual;
+    static const spv::Op opNotEqual = spv::OpINotEqual;
+    static const spv::Op opGtr = spv::OpUGreaterThan;
+    static const spv::Op opGtrEq = spv::OpUGreaterThanEqual;
+    static const spv::Op opLss = spv::OpULessThan;
+    static const spv::Op opLssEq = spv::OpULessThanEqual;
+};
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
@@ -890,6 +1076,10 @@ template<> struct TGetRV< int > { typedef TRValue< int > type; };
 template<> struct TGetRV< unsigned int > { typedef TRValue< unsigned int > type; };
 template<> struct TGetRV< float > { typedef TRValue< float > type; };
 template<> struct TGetRV< double > { typedef TRValue< double > type; };
+template<> struct TGetRV< std::int8_t > { typedef TRValue< std::int8_t > type; };
+template<> struct TGetRV< std::uint8_t > { typedef TRValue< std::uint8_t > type; };
+template<> struct TGetRV< std::int16_t > { typedef TRValue< std::int16_t > type; };
+template<> struct TGetRV< std::uint16_t > { typedef TRValue< std::uint16_t > type; };
 template<> struct TGetRV< bool > { typedef Bool type; };
 
 // -----------------------------------------------------------------------------
@@ -1331,6 +1521,22 @@ typedef TRValue< std::uint64_t > UInt64;
 typedef TLValue< std::uint64_t, spv::StorageClassFunction > VUInt64;
 typedef TLValue< std::uint64_t, spv::StorageClassWorkgroup > WUInt64;
 
+typedef TRValue< std::int8_t > Int8;
+typedef TLValue< std::int8_t, spv::StorageClassFunction > VInt8;
+typedef TLValue< std::int8_t, spv::StorageClassWorkgroup > WInt8;
+
+typedef TRValue< std::uint8_t > UInt8;
+typedef TLValue< std::uint8_t, spv::StorageClassFunction > VUInt8;
+typedef TLValue< std::uint8_t, spv::StorageClassWorkgroup > WUInt8;
+
+typedef TRValue< std::int16_t > Int16;
+typedef TLValue< std::int16_t, spv::StorageClassFunction > VInt16;
+typedef TLValue< std::int16_t, spv::StorageClassWorkgroup > WInt16;
+
+typedef TRValue< std::uint16_t > UInt16;
+typedef TLValue< std::uint16_t, spv::StorageClassFunction > VUInt16;
+typedef TLValue< std::uint16_t, spv::StorageClassWorkgroup > WUInt16;
+
 // -----------------------------------------------------------------------------
 
 VPP_DEFINE_LBASE_OPERATORS ( Int, int )
@@ -1341,6 +1547,14 @@ VPP_DEFINE_LBASE_OPERATORS ( Float, float )
 VPP_DEFINE_LBASE_OPERATORS ( Double, double )
 VPP_DEFINE_LBASE_INT_OPERATORS ( Int64, std::int64_t )
 VPP_DEFINE_LBASE_INT_OPERATORS ( UInt64, std::uint64_t )
+VPP_DEFINE_LBASE_OPERATORS ( Int8, std::int8_t )
+VPP_DEFINE_LBASE_INT_OPERATORS ( Int8, std::int8_t )
+VPP_DEFINE_LBASE_OPERATORS ( UInt8, std::uint8_t )
+VPP_DEFINE_LBASE_INT_OPERATORS ( UInt8, std::uint8_t )
+VPP_DEFINE_LBASE_OPERATORS ( Int16, std::int16_t )
+VPP_DEFINE_LBASE_INT_OPERATORS ( Int16, std::int16_t )
+VPP_DEFINE_LBASE_OPERATORS ( UInt16, std::uint16_t )
+VPP_DEFINE_LBASE_INT_OPERATORS ( UInt16, std::uint16_t )
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
@@ -1451,6 +1665,96 @@ struct StructMemberTraits< std::uint64_t >
     typedef std::uint64_t data_type;
 };
 
+// -----------------------------------------------------------------------------
+
+template<>
+struct StructMemberTraits< std::int8_t >
+{
+    static const bool has_member_info = true;
+    static const bool is_unknown = false;
+    static const bool is_matrix = false;
+    static const bool is_col_major = false;
+    static const unsigned int matrix_stride = 0;
+    static const unsigned int row_count = 0u;
+    static const unsigned int column_count = 0u;
+    typedef std::int8_t scalar_type;
+    typedef Int8 rvalue_type;
+    typedef VInt8 lvalue_type;
+    typedef std::int8_t data_type;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct StructMemberTraits< std::uint8_t >
+{
+    static const bool has_member_info = true;
+    static const bool is_unknown = false;
+    static const bool is_matrix = false;
+    static const bool is_col_major = false;
+    static const unsigned int matrix_stride = 0;
+    static const unsigned int row_count = 0u;
+    static const unsigned int column_count = 0u;
+    typedef std::uint8_t scalar_type;
+    typedef UInt8 rvalue_type;
+    typedef VUInt8 lvalue_type;
+    typedef std::uint8_t data_type;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct StructMemberTraits< std::int16_t >
+{
+    static const bool has_member_info = true;
+    static const bool is_unknown = false;
+    static const bool is_matrix = false;
+    static const bool is_col_major = false;
+    static const unsigned int matrix_stride = 0;
+    static const unsigned int row_count = 0u;
+    static const unsigned int column_count = 0u;
+    typedef std::int16_t scalar_type;
+    typedef Int16 rvalue_type;
+    typedef VInt16 lvalue_type;
+    typedef std::int16_t data_type;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct StructMemberTraits< std::uint16_t >
+{
+    static const bool has_member_info = true;
+    static const bool is_unknown = false;
+    static const bool is_matrix = false;
+    static const bool is_col_major = false;
+    static const unsigned int matrix_stride = 0;
+    static const unsigned int row_count = 0u;
+    static const unsigned int column_count = 0u;
+    typedef std::uint16_t scalar_type;
+    typedef UInt16 rvalue_type;
+    typedef VUInt16 lvalue_type;
+    typedef std::uint16_t data_type;
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct StructMemberTraits< float16_t >
+{
+    static const bool has_member_info = true;
+    static const bool is_unknown = false;
+    static const bool is_matrix = false;
+    static const bool is_col_major = false;
+    static const unsigned int matrix_stride = 0;
+    static const unsigned int row_count = 0u;
+    static const unsigned int column_count = 0u;
+    typedef float16_t scalar_type;
+    typedef Half rvalue_type;
+    typedef VHalf lvalue_type;
+    typedef float16_t data_type;
+};
+
 // -----------------------------------------------------------------------------
 } // namespace vpp
 // -----------------------------------------------------------------------------
@@ -129,8 +129,12 @@ public:
     VkShaderStageFlagBits getStage() const;
 
     VPP_DLLAPI void useCapability ( spv::Capability cap );
+    VPP_DLLAPI void useNonUniformIndexing ( VkDescriptorType descriptorType );
+    VPP_DLLAPI void useBindingFlags ( VkDescriptorType descriptorType, VkDescriptorBindingFlagsEXT flags );
+    VPP_DLLAPI void decorateNonUniform ( const KId& id );
+    VPP_DLLAPI void useBufferStorage ( spv::Id typeId, spv::Decoration decoration, spv::StorageClass storageClass );
 
-    VPP_DLLAPI void pushIf ( Bool bcond );
+    VPP_DLLAPI void pushIf ( Bool bcond, unsigned int control = spv::SelectionControlMaskNone );
     VPP_DLLAPI void makeElse();
     VPP_DLLAPI void popIf();
 
@@ -170,6 +174,13 @@ public:
     VPP_DLLAPI KId registerSamplerVariable ( const KShaderScopedVariable* pVariable, int set, int binding );
     VPP_DLLAPI KId registerSamplerVariable ( const KShaderScopedVariable* pVariable, const KId& indexId, int set, int binding, int count );
 
+    // Specialization constants. Each constant ID is emitted once per module,
+    // with specified value as the default.
+    VPP_DLLAPI KId makeSpecConstant ( std::uint32_t constantId, int value );
+    VPP_DLLAPI KId makeSpecConstant ( std::uint32_t constantId, unsigned int value );
+    VPP_DLLAPI KId makeSpecConstant ( std::uint32_t constantId, float value );
+    VPP_DLLAPI KId makeSpecConstant ( std::uint32_t constantId, bool value );
+
     struct SMemberInfo
     {
         VPP_INLINE SMemberInfo ( spv::Id typeId ) :
@@ -337,6 +348,9 @@ private:
     typedef std::map< const KShaderScopedVariable*, SVariableInfo > Variable2Info;
     Variable2Info d_variable2info;
 
+    typedef std::map< std::uint32_t, KId > SpecConstants;
+    SpecConstants d_specConstants;
+
     typedef std::pair< std::type_index, spv::Decoration > StructTypeKey;
     typedef std::map< StructTypeKey, SStructInfo > StructType2Info;
     typedef std::list< SStructInfo* > StructTypeStack;
@@ -353,6 +367,10 @@ private:
     unsigned int d_maxSharedVariablesByteCount;
     unsigned int d_sharedVariablesByteCount;
 
+private:
+    KId findSpecConstant ( std::uint32_t constantId ) const;
+    KId registerSpecConstant ( std::uint32_t constantId, spv::Id id );
+
     static thread_local KShaderTranslator* s_pThis;
 };
 
@@ -732,6 +732,46 @@ typedef TRVector< UInt, 4 > UVec4;
 typedef TLVector< UInt, 4, spv::StorageClassFunction > VUVec4;
 typedef TLVector< UInt, 4, spv::StorageClassWorkgroup > WUVec4;
 
+typedef TRVector< Int8, 2 > I8Vec2;
+typedef TLVector< Int8, 2, spv::StorageClassFunction > VI8Vec2;
+typedef TLVector< Int8, 2, spv::StorageClassWorkgroup > WI8Vec2;
+typedef TRVector< Int8, 3 > I8Vec3;
+typedef TLVector< Int8, 3, spv::StorageClassFunction > VI8Vec3;
+typedef TLVector< Int8, 3, spv::StorageClassWorkgroup > WI8Vec3;
+typedef TRVector< Int8, 4 > I8Vec4;
+typedef TLVector< Int8, 4, spv::StorageClassFunction > VI8Vec4;
+typedef TLVector< Int8, 4, spv::StorageClassWorkgroup > WI8Vec4;
+
+typedef TRVector< UInt8, 2 > U8Vec2;
+typedef TLVector< UInt8, 2, spv::StorageClassFunction > VU8Vec2;
+typedef TLVector< UInt8, 2, spv::StorageClassWorkgroup > WU8Vec2;
+typedef TRVector< UInt8, 3 > U8Vec3;
+typedef TLVector< UInt8, 3, spv::StorageClassFunction > VU8Vec3;
+typedef TLVector< UInt8, 3, spv::StorageClassWorkgroup > WU8Vec3;
+typedef TRVector< UInt8, 4 > U8Vec4;
+typedef TLVector< UInt8, 4, spv::StorageClassFunction > VU8Vec4;
+typedef TLVector< UInt8, 4, spv::StorageClassWorkgroup > WU8Vec4;
+
+typedef TRVector< Int16, 2 > I16Vec2;
+typedef TLVector< Int16, 2, spv::StorageClassFunction > VI16Vec2;
+typedef TLVector< Int16, 2, spv::StorageClassWorkgroup > WI16Vec2;
+typedef TRVector< Int16, 3 > I16Vec3;
+typedef TLVector< Int16, 3, spv::StorageClassFunction > VI16Vec3;
+typedef TLVector< Int16, 3, spv::StorageClassWorkgroup > WI16Vec3;
+typedef TRVector< Int16, 4 > I16Vec4;
+typedef TLVector< Int16, 4, spv::StorageClassFunction > VI16Vec4;
+typedef TLVector< Int16, 4, spv::StorageClassWorkgroup > WI16Vec4;
+
+typedef TRVector< UInt16, 2 > U16Vec2;
+typedef TLVector< UInt16, 2, spv::StorageClassFunction > VU16Vec2;
+typedef TLVector< UInt16, 2, spv::StorageClassWorkgroup > WU16Vec2;
+typedef TRVector< UInt16, 3 > U16Vec3;
+typedef TLVector< UInt16, 3, spv::StorageClassFunction > VU16Vec3;
+typedef TLVector< UInt16, 3, spv::StorageClassWorkgroup > WU16Vec3;
+typedef TRVector< UInt16, 4 > U16Vec4;
+typedef TLVector< UInt16, 4, spv::StorageClassFunction > VU16Vec4;
+typedef TLVector< UInt16, 4, spv::StorageClassWorkgroup > WU16Vec4;
+
 typedef TRVector< Bool, 2 > BVec2;
 typedef TLVector< Bool, 2, spv::StorageClassFunction > VBVec2;
 typedef TLVector< Bool, 2, spv::StorageClassWorkgroup > WBVec2;
@@ -0,0 +1,107 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPLAYOUTCACHE_HPP
+#define INC_VPPLAYOUTCACHE_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPHANDLECACHE_HPP
+#include "vppHandleCache.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class DestructionQueue;
+
+// -----------------------------------------------------------------------------
+
+// Device-wide cache of descriptor set layouts and pipeline layouts. Objects
+// created from identical create infos are shared, so pipelines with the same
+// binding signature get the same layout handles and descriptor sets stay
+// compatible between them. Entries are reference counted. When the last
+// user releases one, its destruction is deferred through the destruction
+// queue. Thread safe.
+
+class LayoutCache
+{
+public:
+    LayoutCache ( VkDevice hDevice, DestructionQueue* pDestructionQueue );
+    VPP_DLLAPI ~LayoutCache();
+
+    VPP_DLLAPI VkDescriptorSetLayout acquireSetLayout (
+        const VkDescriptorSetLayoutCreateInfo& createInfo,
+        VkResult* pResult );
+
+    VPP_DLLAPI void releaseSetLayout ( VkDescriptorSetLayout hLayout );
+
+    // Set layout handles in the create info should come from
+    // acquireSetLayout(), as they are compared by identity.
+
+    VPP_DLLAPI VkPipelineLayout acquirePipelineLayout (
+        const VkPipelineLayoutCreateInfo& createInfo,
+        VkResult* pResult );
+
+    VPP_DLLAPI void releasePipelineLayout ( VkPipelineLayout hLayout );
+
+    VPP_DLLAPI size_t setLayoutCount() const;
+    VPP_DLLAPI size_t pipelineLayoutCount() const;
+
+    // Numbers of acquire calls (both kinds of layouts) that found an existing
+    // object, or had to create a new one.
+    VPP_DLLAPI std::uint64_t hitCount() const;
+    VPP_DLLAPI std::uint64_t missCount() const;
+
+private:
+    LayoutCache ( const LayoutCache& ) = delete;
+    const LayoutCache& operator= ( const LayoutCache& ) = delete;
+
+private:
+    VkDevice d_hDevice;
+    DestructionQueue* d_pDestructionQueue;
+
+    THandleCache< VkDescriptorSetLayout > d_setLayouts;
+    THandleCache< VkPipelineLayout > d_pipelineLayouts;
+
+    mutable std::mutex d_mutex;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE LayoutCache :: LayoutCache (
+    VkDevice hDevice, DestructionQueue* pDestructionQueue ) :
+        d_hDevice ( hDevice ),
+        d_pDestructionQueue ( pDestructionQueue )
+{
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPLAYOUTCACHE_HPP
@@ -0,0 +1,104 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPMAPPEDFILE_HPP
+#define INC_VPPMAPPEDFILE_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPCOMMON_HPP
+#include "vppCommon.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+// Read-only memory mapping of a whole file. Data are paged in by the OS
+// on access, so nothing is read until actually used.
+
+class MappedFile
+{
+public:
+    VPP_DLLAPI MappedFile();
+    VPP_DLLAPI MappedFile ( const std::string& fileName );
+    VPP_DLLAPI ~MappedFile();
+
+    VPP_DLLAPI bool open ( const std::string& fileName );
+    VPP_DLLAPI void close();
+
+    bool valid() const;
+    const unsigned char* begin() const;
+    const unsigned char* end() const;
+    size_t size() const;
+
+private:
+    MappedFile ( const MappedFile& ) = delete;
+    const MappedFile& operator= ( const MappedFile& ) = delete;
+
+private:
+    const unsigned char* d_pBegin;
+    size_t d_size;
+
+    #ifdef _WIN32
+        void* d_hFile;
+        void* d_hMapping;
+    #endif
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool MappedFile :: valid() const
+{
+    return d_pBegin != 0;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const unsigned char* MappedFile :: begin() const
+{
+    return d_pBegin;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const unsigned char* MappedFile :: end() const
+{
+    return d_pBegin + d_size;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE size_t MappedFile :: size() const
+{
+    return d_size;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPMAPPEDFILE_HPP
@@ -0,0 +1,502 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef INC_VPPMATRIXOPERATIONS_HPP
+#define INC_VPPMATRIXOPERATIONS_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPPIPELINECONFIG_HPP
+#include "vppPipelineConfig.hpp"
+#endif
+
+#ifndef INC_VPPPIPELINELAYOUT_HPP
+#include "vppPipelineLayout.hpp"
+#endif
+
+#ifndef INC_VPPSHADERDATABLOCK_HPP
+#include "vppShaderDataBlock.hpp"
+#endif
+
+#ifndef INC_VPPCOMPUTEPASS_HPP
+#include "vppComputePass.hpp"
+#endif
+
+#ifndef INC_VPPCONTAINERS_HPP
+#include "vppContainers.hpp"
+#endif
+
+#ifndef INC_VPPSHADER_HPP
+#include "vppShader.hpp"
+#endif
+
+#ifndef INC_VPPLANGINTERFACE_HPP
+#include "vppLangInterface.hpp"
+#endif
+
+#ifndef INC_VPPSUPPORTMATH_HPP
+#include "vppSupportMath.hpp"
+#endif
+
+#ifndef INC_VPPLANGINTINOUT_HPP
+#include "vppLangIntInOut.hpp"
+#endif
+
+#ifndef INC_VPPLANGCONVERSIONS_HPP
+#include "vppLangConversions.hpp"
+#endif
+
+#ifndef INC_VPPLANGFUNCTIONS_HPP
+#include "vppLangFunctions.hpp"
+#endif
+
+#ifndef INC_VPPLANGCONSTRUCTS_HPP
+#include "vppLangConstructs.hpp"
+#endif
+
+#ifndef INC_VPPCTGROUPALG_HPP
+#include "vppctGroupAlg.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+// Sizes passed to matrix operation shaders.
+// Multiplication: x: m, y: n, z: k, w: unused.
+// Convolution: x: image height, y: image width, zw: unused.
+
+template< ETag TAG >
+struct TMatrixOperationParams : public UniformStruct< TAG, TMatrixOperationParams >
+{
+    UniformFld< TAG, ivect4 > m_size;
+};
+
+typedef TMatrixOperationParams< GPU > GMatrixOperationParams;
+typedef TMatrixOperationParams< CPU > CMatrixOperationParams;
+
+// -----------------------------------------------------------------------------
+
+// Computes C = A * B for a batch of dense, row-major matrices, using
+// ct::group::BatchedMatrixMultiply. Each workgroup computes a TILE_M x TILE_N
+// block of one batch item, each thread ROWS_PER_THREAD items of that block.
+// ItemT is float or float16_t.
+
+template<
+    class ItemT,
+    int TILE_M = 32, int TILE_N = 32, int TILE_K = 16, int ROWS_PER_THREAD = 4 >
+class TMatrixMultiplyPipeline : public ComputePipelineConfig
+{
+public:
+    static_assert ( TILE_M % ROWS_PER_THREAD == 0, "TILE_M must be a multiple of ROWS_PER_THREAD" );
+
+    static const unsigned int LOCAL_SIZE = TILE_N * ( TILE_M / ROWS_PER_THREAD );
+
+    TMatrixMultiplyPipeline ( const Device& hDevice );
+
+    void setData (
+        const StorageBufferView& a,
+        const StorageBufferView& b,
+        const StorageBufferView& c,
+        ShaderDataBlock* pDataBlock );
+
+    void cmdPushSize (
+        std::uint32_t m, std::uint32_t n, std::uint32_t k,
+        CommandBuffer hCmdBuffer = CommandBuffer() );
+
+private:
+    void fComputeShader ( ComputeShader* pShader );
+
+private:
+    inPushConstant< TMatrixOperationParams > d_params;
+    ioBuffer d_a;
+    ioBuffer d_b;
+    ioBuffer d_c;
+    computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int TILE_M, int TILE_N, int TILE_K, int ROWS_PER_THREAD >
+VPP_INLINE TMatrixMultiplyPipeline< ItemT, TILE_M, TILE_N, TILE_K, ROWS_PER_THREAD > :: TMatrixMultiplyPipeline (
+    const Device& hDevice ) :
+        d_shader ( this, { LOCAL_SIZE, 1, 1 }, & TMatrixMultiplyPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int TILE_M, int TILE_N, int TILE_K, int ROWS_PER_THREAD >
+VPP_INLINE void TMatrixMultiplyPipeline< ItemT, TILE_M, TILE_N, TILE_K, ROWS_PER_THREAD > :: setData (
+    const StorageBufferView& a,
+    const StorageBufferView& b,
+    const StorageBufferView& c,
+    ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_a = a,
+        d_b = b,
+        d_c = c
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int TILE_M, int TILE_N, int TILE_K, int ROWS_PER_THREAD >
+VPP_INLINE void TMatrixMultiplyPipeline< ItemT, TILE_M, TILE_N, TILE_K, ROWS_PER_THREAD > :: cmdPushSize (
+    std::uint32_t m, std::uint32_t n, std::uint32_t k,
+    CommandBuffer hCmdBuffer )
+{
+    CMatrixOperationParams& params = d_params.data();
+    params.m_size.set ( static_cast< int >( m ), static_cast< int >( n ), static_cast< int >( k ), 0 );
+
+    if ( hCmdBuffer )
+        d_params.cmdPush ( hCmdBuffer );
+    else
+        d_params.cmdPush();
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int TILE_M, int TILE_N, int TILE_K, int ROWS_PER_THREAD >
+void TMatrixMultiplyPipeline< ItemT, TILE_M, TILE_N, TILE_K, ROWS_PER_THREAD > :: fComputeShader (
+    ComputeShader* pShader )
+{
+    using namespace vpp::ct;
+
+    group::GroupInvocation inv ( pShader );
+
+    UniformVar< TMatrixOperationParams, decltype ( d_params ) > inParams ( d_params );
+    UniformSimpleArray< ItemT, decltype ( d_a ) > inA ( d_a );
+    UniformSimpleArray< ItemT, decltype ( d_b ) > inB ( d_b );
+    UniformSimpleArray< ItemT, decltype ( d_c ) > outC ( d_c );
+
+    const IVec4 size = inParams [ & GMatrixOperationParams::m_size ];
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+
+    group::BatchedMatrixMultiply< TILE_M, TILE_N, TILE_K >(
+        inA, inB, outC,
+        size [ X ], size [ Y ], size [ Z ], workgroupId [ Z ],
+        workgroupId [ Y ] * TILE_M, workgroupId [ X ] * TILE_N,
+        inv );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+// Filters a batch of single channel, row-major images with a KERNEL_H x KERNEL_W
+// kernel, using ct::group::Convolve2D or ConvolveSeparable2D. Each workgroup
+// computes a TILE_H x TILE_W block of one image. ItemT is float or float16_t.
+// See the group functions for weights layout.
+
+template<
+    class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE = false,
+    int TILE_H = 16, int TILE_W = 16, unsigned int LOCAL_SIZE = 128 >
+class TConvolutionPipeline : public ComputePipelineConfig
+{
+public:
+    TConvolutionPipeline ( const Device& hDevice );
+
+    void setData (
+        const StorageBufferView& source,
+        const StorageBufferView& weights,
+        const StorageBufferView& target,
+        ShaderDataBlock* pDataBlock );
+
+    void cmdPushSize (
+        std::uint32_t height, std::uint32_t width,
+        CommandBuffer hCmdBuffer = CommandBuffer() );
+
+private:
+    void fComputeShader ( ComputeShader* pShader );
+
+private:
+    inPushConstant< TMatrixOperationParams > d_params;
+    ioBuffer d_source;
+    ioBuffer d_weights;
+    ioBuffer d_target;
+    computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE, int TILE_H, int TILE_W, unsigned int LOCAL_SIZE >
+VPP_INLINE TConvolutionPipeline< ItemT, KERNEL_H, KERNEL_W, SEPARABLE, TILE_H, TILE_W, LOCAL_SIZE > :: TConvolutionPipeline (
+    const Device& hDevice ) :
+        d_shader ( this, { LOCAL_SIZE, 1, 1 }, & TConvolutionPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE, int TILE_H, int TILE_W, unsigned int LOCAL_SIZE >
+VPP_INLINE void TConvolutionPipeline< ItemT, KERNEL_H, KERNEL_W, SEPARABLE, TILE_H, TILE_W, LOCAL_SIZE > :: setData (
+    const StorageBufferView& source,
+    const StorageBufferView& weights,
+    const StorageBufferView& target,
+    ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_source = source,
+        d_weights = weights,
+        d_target = target
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE, int TILE_H, int TILE_W, unsigned int LOCAL_SIZE >
+VPP_INLINE void TConvolutionPipeline< ItemT, KERNEL_H, KERNEL_W, SEPARABLE, TILE_H, TILE_W, LOCAL_SIZE > :: cmdPushSize (
+    std::uint32_t height, std::uint32_t width,
+    CommandBuffer hCmdBuffer )
+{
+    CMatrixOperationParams& params = d_params.data();
+    params.m_size.set ( static_cast< int >( height ), static_cast< int >( width ), 0, 0 );
+
+    if ( hCmdBuffer )
+        d_params.cmdPush ( hCmdBuffer );
+    else
+        d_params.cmdPush();
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE, int TILE_H, int TILE_W, unsigned int LOCAL_SIZE >
+void TConvolutionPipeline< ItemT, KERNEL_H, KERNEL_W, SEPARABLE, TILE_H, TILE_W, LOCAL_SIZE > :: fComputeShader (
+    ComputeShader* pShader )
+{
+    using namespace vpp::ct;
+
+    group::GroupInvocation inv ( pShader );
+
+    UniformVar< TMatrixOperationParams, decltype ( d_params ) > inParams ( d_params );
+    UniformSimpleArray< ItemT, decltype ( d_source ) > inSource ( d_source );
+    UniformSimpleArray< float, decltype ( d_weights ) > inWeights ( d_weights );
+    UniformSimpleArray< ItemT, decltype ( d_target ) > outTarget ( d_target );
+
+    const IVec4 size = inParams [ & GMatrixOperationParams::m_size ];
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+
+    const Int height = size [ X ];
+    const Int width = size [ Y ];
+    const Int imageStart = workgroupId [ Z ] * height * width;
+    const Int tileRow = workgroupId [ Y ] * TILE_H;
+    const Int tileCol = workgroupId [ X ] * TILE_W;
+
+    if ( SEPARABLE )
+        group::ConvolveSeparable2D< TILE_H, TILE_W, KERNEL_H, KERNEL_W >(
+            inSource, imageStart, inWeights, 0, outTarget, imageStart,
+            height, width, tileRow, tileCol, inv );
+    else
+        group::Convolve2D< TILE_H, TILE_W, KERNEL_H, KERNEL_W >(
+            inSource, imageStart, inWeights, 0, outTarget, imageStart,
+            height, width, tileRow, tileCol, inv );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+// Host side wrappers. Buffers are given as gvectors (or any storage buffer
+// views). Commands are recorded to the specified command buffer, or the one
+// currently being recorded by VPP if none is given. No barriers are recorded:
+// it is up to the caller to synchronize with producers and consumers.
+
+template<
+    class ItemT,
+    int TILE_M = 32, int TILE_N = 32, int TILE_K = 16, int ROWS_PER_THREAD = 4 >
+class TMatrixMultiply
+{
+public:
+    typedef TMatrixMultiplyPipeline< ItemT, TILE_M, TILE_N, TILE_K, ROWS_PER_THREAD > pipeline_type;
+
+    TMatrixMultiply ( const Device& hDevice );
+
+    // A holds batchCount packed m x k matrices, B k x n ones and C m x n ones.
+    void setData (
+        const StorageBufferView& a,
+        const StorageBufferView& b,
+        const StorageBufferView& c );
+
+    void cmdMultiply (
+        std::uint32_t m, std::uint32_t n, std::uint32_t k,
+        std::uint32_t batchCount = 1,
+        CommandBuffer hCmdBuffer = CommandBuffer() );
+
+    static double flopCount (
+        std::uint32_t m, std::uint32_t n, std::uint32_t k,
+        std::uint32_t batchCount = 1 );
+
+private:
+    ComputePipelineLayout< pipeline_type > d_pipelineLayout;
+    ComputePass d_computePass;
+    ShaderDataBlock d_dataBlock;
+};
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int TILE_M, int TILE_N, int TILE_K, int ROWS_PER_THREAD >
+VPP_INLINE TMatrixMultiply< ItemT, TILE_M, TILE_N, TILE_K, ROWS_PER_THREAD > :: TMatrixMultiply (
+    const Device& hDevice ) :
+        d_pipelineLayout ( hDevice ),
+        d_computePass ( hDevice ),
+        d_dataBlock ( d_pipelineLayout )
+{
+    d_computePass.addPipeline ( d_pipelineLayout );
+    d_computePass.createPipelines();
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int TILE_M, int TILE_N, int TILE_K, int ROWS_PER_THREAD >
+VPP_INLINE void TMatrixMultiply< ItemT, TILE_M, TILE_N, TILE_K, ROWS_PER_THREAD > :: setData (
+    const StorageBufferView& a,
+    const StorageBufferView& b,
+    const StorageBufferView& c )
+{
+    d_pipelineLayout.definition().setData ( a, b, c, & d_dataBlock );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int TILE_M, int TILE_N, int TILE_K, int ROWS_PER_THREAD >
+void TMatrixMultiply< ItemT, TILE_M, TILE_N, TILE_K, ROWS_PER_THREAD > :: cmdMultiply (
+    std::uint32_t m, std::uint32_t n, std::uint32_t k,
+    std::uint32_t batchCount,
+    CommandBuffer hCmdBuffer )
+{
+    d_dataBlock.cmdBind ( hCmdBuffer );
+    d_computePass.pipeline ( 0 ).cmdBind ( hCmdBuffer );
+    d_pipelineLayout.definition().cmdPushSize ( m, n, k, hCmdBuffer );
+
+    ComputePass::cmdDispatch (
+        ( n + TILE_N - 1 ) / TILE_N, ( m + TILE_M - 1 ) / TILE_M, batchCount,
+        hCmdBuffer );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int TILE_M, int TILE_N, int TILE_K, int ROWS_PER_THREAD >
+VPP_INLINE double TMatrixMultiply< ItemT, TILE_M, TILE_N, TILE_K, ROWS_PER_THREAD > :: flopCount (
+    std::uint32_t m, std::uint32_t n, std::uint32_t k,
+    std::uint32_t batchCount )
+{
+    return 2.0 * m * n * k * batchCount;
+}
+
+// -----------------------------------------------------------------------------
+
+template<
+    class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE = false,
+    int TILE_H = 16, int TILE_W = 16, unsigned int LOCAL_SIZE = 128 >
+class TConvolution
+{
+public:
+    typedef TConvolutionPipeline<
+        ItemT, KERNEL_H, KERNEL_W, SEPARABLE, TILE_H, TILE_W, LOCAL_SIZE > pipeline_type;
+
+    TConvolution ( const Device& hDevice );
+
+    // Source and target hold imageCount packed height x width images.
+    // Weights are float values, laid out as described in ct::group.
+    void setData (
+        const StorageBufferView& source,
+        const StorageBufferView& weights,
+        const StorageBufferView& target );
+
+    void cmdConvolve (
+        std::uint32_t height, std::uint32_t width,
+        std::uint32_t imageCount = 1,
+        CommandBuffer hCmdBuffer = CommandBuffer() );
+
+    static double flopCount (
+        std::uint32_t height, std::uint32_t width,
+        std::uint32_t imageCount = 1 );
+
+private:
+    ComputePipelineLayout< pipeline_type > d_pipelineLayout;
+    ComputePass d_computePass;
+    ShaderDataBlock d_dataBlock;
+};
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE, int TILE_H, int TILE_W, unsigned int LOCAL_SIZE >
+VPP_INLINE TConvolution< ItemT, KERNEL_H, KERNEL_W, SEPARABLE, TILE_H, TILE_W, LOCAL_SIZE > :: TConvolution (
+    const Device& hDevice ) :
+        d_pipelineLayout ( hDevice ),
+        d_computePass ( hDevice ),
+        d_dataBlock ( d_pipelineLayout )
+{
+    d_computePass.addPipeline ( d_pipelineLayout );
+    d_computePass.createPipelines();
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE, int TILE_H, int TILE_W, unsigned int LOCAL_SIZE >
+VPP_INLINE void TConvolution< ItemT, KERNEL_H, KERNEL_W, SEPARABLE, TILE_H, TILE_W, LOCAL_SIZE > :: setData (
+    const StorageBufferView& source,
+    const StorageBufferView& weights,
+    const StorageBufferView& target )
+{
+    d_pipelineLayout.definition().setData ( source, weights, target, & d_dataBlock );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE, int TILE_H, int TILE_W, unsigned int LOCAL_SIZE >
+void TConvolution< ItemT, KERNEL_H, KERNEL_W, SEPARABLE, TILE_H, TILE_W, LOCAL_SIZE > :: cmdConvolve (
+    std::uint32_t height, std::uint32_t width,
+    std::uint32_t imageCount,
+    CommandBuffer hCmdBuffer )
+{
+    d_dataBlock.cmdBind ( hCmdBuffer );
+    d_computePass.pipeline ( 0 ).cmdBind ( hCmdBuffer );
+    d_pipelineLayout.definition().cmdPushSize ( height, width, hCmdBuffer );
+
+    ComputePass::cmdDispatch (
+        ( width + TILE_W - 1 ) / TILE_W, ( height + TILE_H - 1 ) / TILE_H, imageCount,
+        hCmdBuffer );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ItemT, int KERNEL_H, int KERNEL_W, bool SEPARABLE, int TILE_H, int TILE_W, unsigned int LOCAL_SIZE >
+VPP_INLINE double TConvolution< ItemT, KERNEL_H, KERNEL_W, SEPARABLE, TILE_H, TILE_W, LOCAL_SIZE > :: flopCount (
+    std::uint32_t height, std::uint32_t width,
+    std::uint32_t imageCount )
+{
+    // Useful work only, i.e. multiply-adds of the direct method. This way
+    // separable and non-separable variants are comparable.
+    return 2.0 * KERNEL_H * KERNEL_W * height * width * imageCount;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPMATRIXOPERATIONS_HPP
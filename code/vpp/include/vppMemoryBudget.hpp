@@ -0,0 +1,184 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPMEMORYBUDGET_HPP
+#define INC_VPPMEMORYBUDGET_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPPHYSICALDEVICE_HPP
+#include "vppPhysicalDevice.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class KMemoryBudgetImpl;
+
+// -----------------------------------------------------------------------------
+
+struct SHeapBudget
+{
+    VkDeviceSize d_heapSize;
+    VkMemoryHeapFlags d_heapFlags;
+
+    // How much the process may allocate from the heap without degrading
+    // performance. Driver estimate if VK_EXT_memory_budget is available,
+    // the heap size otherwise.
+    VkDeviceSize d_budget;
+
+    // Current usage by the process. Driver value refreshed by update(),
+    // adjusted by allocations made since then. Without VK_EXT_memory_budget,
+    // the same as d_allocated.
+    VkDeviceSize d_usage;
+
+    // Total size of live DeviceMemory objects allocated from the heap.
+    VkDeviceSize d_allocated;
+};
+
+// -----------------------------------------------------------------------------
+
+// Per-heap memory budget of a device. Every DeviceMemory allocation and
+// release is accounted here. Each Device owns one object, accessible
+// by Device::memoryBudget().
+//
+// Allocations which would exceed the budget consult the pressure policy
+// first. The policy can release memory (e.g. evict cached textures) and
+// request a retry, or request demotion of a low priority allocation
+// (see MemProfile::PRIORITY_LOW) to a host-visible heap. Without a policy,
+// or when the policy declines, the allocation is attempted anyway.
+
+class MemoryBudget : public TSharedReference< KMemoryBudgetImpl >
+{
+public:
+    VPP_DLLAPI MemoryBudget (
+        const PhysicalDevice& hPhysicalDevice,
+        bool bDriverBudget );
+
+    enum EPressureAction
+    {
+        PRESSURE_PROCEED,
+        PRESSURE_RETRY,
+        PRESSURE_DEMOTE
+    };
+
+    typedef std::function< void (
+        std::uint32_t heapIndex, const SHeapBudget& heap ) > FThresholdCallback;
+
+    typedef std::function< EPressureAction (
+        std::uint32_t heapIndex, VkDeviceSize size, bool bLowPriority ) > FPressurePolicy;
+
+    // True if budget and usage are reported by VK_EXT_memory_budget.
+    bool hasDriverBudget() const;
+
+    std::uint32_t heapCount() const;
+    VPP_DLLAPI SHeapBudget heap ( std::uint32_t heapIndex ) const;
+
+    // Queries current budget and usage from the driver. Called automatically
+    // under memory pressure, call e.g. once per frame for fresh statistics.
+    VPP_DLLAPI void update();
+
+    // The callback is called (from the allocating thread) when usage of a heap
+    // rises above the specified fraction of its budget. It will be called again
+    // only after usage falls below the threshold.
+    VPP_DLLAPI void setThreshold ( float fraction, const FThresholdCallback& callback );
+
+    VPP_DLLAPI void setPressurePolicy ( const FPressurePolicy& policy );
+
+    // Used by DeviceMemory.
+    VPP_DLLAPI bool fitsInBudget ( std::uint32_t heapIndex, VkDeviceSize size );
+    VPP_DLLAPI EPressureAction onPressure ( std::uint32_t heapIndex, VkDeviceSize size, bool bLowPriority );
+    VPP_DLLAPI void onAllocated ( std::uint32_t heapIndex, VkDeviceSize size );
+    VPP_DLLAPI void onFreed ( std::uint32_t heapIndex, VkDeviceSize size );
+};
+
+// -----------------------------------------------------------------------------
+
+class KMemoryBudgetImpl : public TSharedObject< KMemoryBudgetImpl >
+{
+public:
+    VPP_DLLAPI KMemoryBudgetImpl (
+        const PhysicalDevice& hPhysicalDevice,
+        bool bDriverBudget );
+
+    VPP_INLINE bool compareObjects ( const KMemoryBudgetImpl* pRHS ) const
+    {
+        return this < pRHS;
+    }
+
+private:
+    friend class MemoryBudget;
+
+    struct SHeapState
+    {
+        VkDeviceSize d_heapSize;
+        VkMemoryHeapFlags d_heapFlags;
+        VkDeviceSize d_driverBudget;
+        VkDeviceSize d_driverUsage;
+        VkDeviceSize d_allocatedAtQuery;
+        VkDeviceSize d_allocated;
+        bool d_bAboveThreshold;
+    };
+
+    void queryDriver();
+    VkDeviceSize usage ( const SHeapState& heap ) const;
+    VkDeviceSize budget ( const SHeapState& heap ) const;
+    bool checkThreshold ( std::uint32_t heapIndex, SHeapBudget* pNotification );
+    SHeapBudget makeHeapBudget ( const SHeapState& heap ) const;
+
+private:
+    PhysicalDevice d_hPhysicalDevice;
+    bool d_bDriverBudget;
+    std::vector< SHeapState > d_heaps;
+
+    float d_threshold;
+    MemoryBudget::FThresholdCallback d_thresholdCallback;
+    MemoryBudget::FPressurePolicy d_pressurePolicy;
+
+    mutable std::mutex d_mutex;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool MemoryBudget :: hasDriverBudget() const
+{
+    return get()->d_bDriverBudget;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t MemoryBudget :: heapCount() const
+{
+    return static_cast< std::uint32_t >( get()->d_heaps.size() );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPMEMORYBUDGET_HPP
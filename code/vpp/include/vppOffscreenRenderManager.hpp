@@ -0,0 +1,232 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPOFFSCREENRENDERMANAGER_HPP
+#define INC_VPPOFFSCREENRENDERMANAGER_HPP
+
+// -----------------------------------------------------------------------------
+
+#include "vppCommon.hpp"
+#include "vppRenderPass.hpp"
+#include "vppFramebuffer.hpp"
+#include "vppFrameImageView.hpp"
+#include "vppCommandPool.hpp"
+#include "vppQueue.hpp"
+#include "vppSynchronization.hpp"
+#include "vppDeviceMemory.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class OffscreenRenderManagerImpl;
+
+// -----------------------------------------------------------------------------
+
+// Renders into a ring of offscreen targets instead of swapchain images and
+// copies finished frames to host memory. Usable without any window system.
+// The render graph should output to a Display node constructed from the
+// size and format given here. Frames are not waited for until their ring
+// slot is reused, so several of them are in flight at once.
+
+class OffscreenRenderManager : public TSharedReference< OffscreenRenderManagerImpl >
+{
+public:
+    OffscreenRenderManager();
+
+    VPP_DLLAPI OffscreenRenderManager (
+        const Device& hDevice,
+        const VkExtent2D& imageSize,
+        VkFormat format = VK_FORMAT_R8G8B8A8_UNORM,
+        std::uint32_t frameCount = 3 );
+
+    // Called with tightly packed pixels of a finished frame. The data is
+    // valid only during the call.
+    typedef std::function< void (
+        std::uint64_t frameNumber, const void* pPixels, size_t size ) > FFrameReady;
+
+    void setFrameReadyCallback ( const FFrameReady& callback );
+
+    VPP_DLLAPI void beginFrame();
+    VPP_DLLAPI void endFrame();
+
+    // Waits for all frames in flight and delivers them.
+    VPP_DLLAPI void flush();
+
+    enum ECommandsCaching
+    {
+        CACHE_CMDS,
+        REBUILD_CMDS
+    };
+
+    VPP_DLLAPI void render (
+        const RenderPass& hRenderPass, ECommandsCaching caching = CACHE_CMDS );
+
+    const Device& device() const;
+    const Queue& queue() const;
+
+    const VkExtent2D& imageSize() const;
+    VkFormat format() const;
+    std::uint32_t frameCount() const;
+    std::uint64_t frameNumber() const;
+
+    // lower level
+    VPP_DLLAPI FrameBuffer getFrameBuffer (
+        const RenderPass& renderPass, size_t iFrame = 0 );
+
+    VPP_DLLAPI CommandBuffer getRenderCommands (
+        const RenderPass& hRenderPass, ECommandsCaching caching );
+};
+
+// -----------------------------------------------------------------------------
+
+class OffscreenRenderManagerImpl : public TSharedObject< OffscreenRenderManagerImpl >
+{
+public:
+    OffscreenRenderManagerImpl (
+        const Device& hDevice,
+        const VkExtent2D& imageSize,
+        VkFormat format,
+        std::uint32_t frameCount );
+
+    ~OffscreenRenderManagerImpl();
+
+    VPP_INLINE bool compareObjects ( const OffscreenRenderManagerImpl* pRHS ) const
+    {
+        return this < pRHS;
+    }
+
+private:
+    void recordReadback ( size_t iFrame );
+    void retireFrame ( size_t iFrame );
+
+private:
+    friend class OffscreenRenderManager;
+
+    struct SFrame
+    {
+        SFrame();
+
+        FrameImageView d_target;
+        MemoryBinding< Buf, MappableDeviceMemory > d_staging;
+        CommandBuffer d_readbackCommands;
+        Fence d_fence;
+        std::uint64_t d_frameNumber;
+        bool d_bInFlight;
+    };
+
+    Device d_hDevice;
+    Queue d_queue;
+    CommandPool d_commandPool;
+
+    VkExtent2D d_imageSize;
+    VkFormat d_format;
+    VkDeviceSize d_frameDataSize;
+
+    std::vector< SFrame > d_frames;
+    std::uint32_t d_currentFrame;
+    std::uint64_t d_frameNumber;
+    std::uint32_t d_rebuildCounter;
+
+    std::vector< CommandBuffer > d_pendingCommands;
+    FFrameReady d_frameReady;
+
+    typedef std::map< KAttachmentConfig, FrameBuffers > Config2FrameBuffers;
+    Config2FrameBuffers d_config2frameBuffers;
+
+    typedef std::pair< RenderPass, FrameBuffer > RenderPassKey;
+    typedef std::map< RenderPassKey, CommandBuffer > RenderPassCommands;
+    RenderPassCommands d_renderPassCommands;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE OffscreenRenderManagerImpl::SFrame :: SFrame() :
+    d_frameNumber ( 0 ),
+    d_bInFlight ( false )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE OffscreenRenderManager :: OffscreenRenderManager()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void OffscreenRenderManager :: setFrameReadyCallback ( const FFrameReady& callback )
+{
+    get()->d_frameReady = callback;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const Device& OffscreenRenderManager :: device() const
+{
+    return get()->d_hDevice;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const Queue& OffscreenRenderManager :: queue() const
+{
+    return get()->d_queue;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const VkExtent2D& OffscreenRenderManager :: imageSize() const
+{
+    return get()->d_imageSize;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE VkFormat OffscreenRenderManager :: format() const
+{
+    return get()->d_format;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t OffscreenRenderManager :: frameCount() const
+{
+    return static_cast< std::uint32_t >( get()->d_frames.size() );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint64_t OffscreenRenderManager :: frameNumber() const
+{
+    return get()->d_frameNumber;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPOFFSCREENRENDERMANAGER_HPP
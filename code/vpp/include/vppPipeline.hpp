@@ -41,11 +41,37 @@ class PipelineImpl;
 
 // -----------------------------------------------------------------------------
 
+// Pipeline state folded into dynamic state when the pipeline was created.
+// Values are written into the command buffer each time the pipeline is bound,
+// so pipelines differing only in these share one Vulkan pipeline object.
+
+struct SFoldedDynamicState
+{
+    SFoldedDynamicState();
+
+    void cmdSet ( VkCommandBuffer hCmdBuffer ) const;
+
+    std::vector< VkDynamicState > d_states;
+    std::vector< VkViewport > d_viewports;
+    std::vector< VkRect2D > d_scissors;
+    float d_lineWidth;
+    float d_depthBiasConstantFactor;
+    float d_depthBiasClamp;
+    float d_depthBiasSlopeFactor;
+    float d_minDepthBounds;
+    float d_maxDepthBounds;
+    VkStencilOpState d_frontStencil;
+    VkStencilOpState d_backStencil;
+};
+
+// -----------------------------------------------------------------------------
+
 class PipelineBase : public TSharedReference< PipelineImpl >
 {
 public:
     PipelineBase();
     PipelineBase ( VkPipeline hPipeline, const Device& hDevice );
+    PipelineBase ( const PipelineBase& hBase, const SFoldedDynamicState& foldedState );
 
     VkPipeline handle() const;
 };
@@ -58,7 +84,14 @@ public:
     Pipeline();
     Pipeline ( VkPipeline hPipeline, const Device& hDevice );
 
+    // Variant sharing the Vulkan pipeline with hBase, with its own values
+    // of the folded dynamic state.
+    Pipeline ( const Pipeline& hBase, const SFoldedDynamicState& foldedState );
+
     void cmdBind ( CommandBuffer hCmdBuffer = CommandBuffer() ) const;
+
+    // Sets the folded dynamic state of a variant (does nothing otherwise).
+    void cmdSetFoldedState ( VkCommandBuffer hCmdBuffer ) const;
 };
 
 // -----------------------------------------------------------------------------
@@ -78,6 +111,7 @@ class PipelineImpl : public TSharedObject< PipelineImpl >
 {
 public:
     PipelineImpl ( VkPipeline hPipeline, const Device& hDevice );
+    PipelineImpl ( const PipelineBase& hBase, const SFoldedDynamicState& foldedState );
     ~PipelineImpl();
 
     VPP_INLINE bool compareObjects ( const PipelineImpl* pRHS ) const
@@ -92,14 +126,108 @@ private:
 
     Device d_hDevice;
     VkPipeline d_handle;
+
+    // Set for variants only. The base owns the Vulkan pipeline.
+    PipelineBase d_hBase;
+    SFoldedDynamicState* d_pFoldedState;
 };
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
+VPP_INLINE SFoldedDynamicState :: SFoldedDynamicState() :
+    d_lineWidth ( 1.0f ),
+    d_depthBiasConstantFactor ( 0.0f ),
+    d_depthBiasClamp ( 0.0f ),
+    d_depthBiasSlopeFactor ( 0.0f ),
+    d_minDepthBounds ( 0.0f ),
+    d_maxDepthBounds ( 1.0f )
+{
+    std::memset ( & d_frontStencil, 0, sizeof ( d_frontStencil ) );
+    std::memset ( & d_backStencil, 0, sizeof ( d_backStencil ) );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void SFoldedDynamicState :: cmdSet ( VkCommandBuffer hCmdBuffer ) const
+{
+    for ( VkDynamicState state : d_states )
+    {
+        switch ( state )
+        {
+            case VK_DYNAMIC_STATE_VIEWPORT:
+                ::vkCmdSetViewport (
+                    hCmdBuffer, 0,
+                    static_cast< std::uint32_t >( d_viewports.size() ),
+                    & d_viewports [ 0 ] );
+                break;
+
+            case VK_DYNAMIC_STATE_SCISSOR:
+                ::vkCmdSetScissor (
+                    hCmdBuffer, 0,
+                    static_cast< std::uint32_t >( d_scissors.size() ),
+                    & d_scissors [ 0 ] );
+                break;
+
+            case VK_DYNAMIC_STATE_LINE_WIDTH:
+                ::vkCmdSetLineWidth ( hCmdBuffer, d_lineWidth );
+                break;
+
+            case VK_DYNAMIC_STATE_DEPTH_BIAS:
+                ::vkCmdSetDepthBias (
+                    hCmdBuffer, d_depthBiasConstantFactor,
+                    d_depthBiasClamp, d_depthBiasSlopeFactor );
+                break;
+
+            case VK_DYNAMIC_STATE_DEPTH_BOUNDS:
+                ::vkCmdSetDepthBounds ( hCmdBuffer, d_minDepthBounds, d_maxDepthBounds );
+                break;
+
+            case VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK:
+                ::vkCmdSetStencilCompareMask (
+                    hCmdBuffer, VK_STENCIL_FACE_FRONT_BIT, d_frontStencil.compareMask );
+                ::vkCmdSetStencilCompareMask (
+                    hCmdBuffer, VK_STENCIL_FACE_BACK_BIT, d_backStencil.compareMask );
+                break;
+
+            case VK_DYNAMIC_STATE_STENCIL_WRITE_MASK:
+                ::vkCmdSetStencilWriteMask (
+                    hCmdBuffer, VK_STENCIL_FACE_FRONT_BIT, d_frontStencil.writeMask );
+                ::vkCmdSetStencilWriteMask (
+                    hCmdBuffer, VK_STENCIL_FACE_BACK_BIT, d_backStencil.writeMask );
+                break;
+
+            case VK_DYNAMIC_STATE_STENCIL_REFERENCE:
+                ::vkCmdSetStencilReference (
+                    hCmdBuffer, VK_STENCIL_FACE_FRONT_BIT, d_frontStencil.reference );
+                ::vkCmdSetStencilReference (
+                    hCmdBuffer, VK_STENCIL_FACE_BACK_BIT, d_backStencil.reference );
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
 VPP_INLINE PipelineImpl :: PipelineImpl ( VkPipeline hPipeline, const Device& hDevice ) :
     d_hDevice ( hDevice ),
-    d_handle ( hPipeline )
+    d_handle ( hPipeline ),
+    d_pFoldedState ( 0 )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE PipelineImpl :: PipelineImpl (
+    const PipelineBase& hBase, const SFoldedDynamicState& foldedState ) :
+        d_hDevice ( hBase.get()->d_hDevice ),
+        d_handle ( hBase.handle() ),
+        d_hBase ( hBase.get()->d_hBase ? hBase.get()->d_hBase : hBase ),
+        d_pFoldedState ( new SFoldedDynamicState ( foldedState ) )
 {
 }
 
@@ -107,7 +235,16 @@ VPP_INLINE PipelineImpl :: PipelineImpl ( VkPipeline hPipeline, const Device& hD
 
 VPP_INLINE PipelineImpl :: ~PipelineImpl()
 {
-    ::vkDestroyPipeline ( d_hDevice.handle(), d_handle, 0 );
+    delete d_pFoldedState;
+
+    if ( d_hBase )
+        return;
+
+    const VkDevice hDevice = d_hDevice.handle();
+    const VkPipeline hPipeline = d_handle;
+
+    d_hDevice.destructionQueue().enqueue ( [ hDevice, hPipeline ]() {
+        ::vkDestroyPipeline ( hDevice, hPipeline, 0 ); } );
 }
 
 // -----------------------------------------------------------------------------
@@ -126,6 +263,14 @@ VPP_INLINE PipelineBase :: PipelineBase ( VkPipeline hPipeline, const Device& hD
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE PipelineBase :: PipelineBase (
+    const PipelineBase& hBase, const SFoldedDynamicState& foldedState ) :
+        TSharedReference< PipelineImpl >( new PipelineImpl ( hBase, foldedState ) )
+{
+}
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE VkPipeline PipelineBase :: handle() const
 {
     return get()->d_handle;
@@ -147,6 +292,14 @@ VPP_INLINE Pipeline :: Pipeline ( VkPipeline hPipeline, const Device& hDevice )
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE Pipeline :: Pipeline (
+    const Pipeline& hBase, const SFoldedDynamicState& foldedState ) :
+    PipelineBase ( hBase, foldedState )
+{
+}
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE void Pipeline :: cmdBind ( CommandBuffer hCommandBuffer ) const
 {
     const VkCommandBuffer hCmdBuffer = hCommandBuffer ?
@@ -155,6 +308,16 @@ VPP_INLINE void Pipeline :: cmdBind ( CommandBuffer hCommandBuffer ) const
 
     ::vkCmdBindPipeline (
         hCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, get()->d_handle );
+
+    cmdSetFoldedState ( hCmdBuffer );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void Pipeline :: cmdSetFoldedState ( VkCommandBuffer hCmdBuffer ) const
+{
+    if ( get()->d_pFoldedState )
+        get()->d_pFoldedState->cmdSet ( hCmdBuffer );
 }
 
 // -----------------------------------------------------------------------------
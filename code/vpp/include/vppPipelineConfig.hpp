@@ -33,6 +33,10 @@
 #include "vppDevice.hpp"
 #endif
 
+#ifndef INC_VPPLAYOUTCACHE_HPP
+#include "vppLayoutCache.hpp"
+#endif
+
 #ifndef INC_VPPBUFFERVIEW_HPP
 #include "vppBufferView.hpp"
 #endif
@@ -181,6 +185,7 @@ struct SResourceInfo : public VkDescriptorSetLayoutBinding
 public:
     VPP_INLINE bool operator< ( const SResourceInfo& rhs ) const;
     std::uint32_t d_set;
+    VkDescriptorBindingFlagsEXT d_bindingFlags;
 };
 
 // -----------------------------------------------------------------------------
@@ -829,6 +834,11 @@ protected:
         VkImageView hView,
         std::uint32_t set, std::uint32_t binding, 
         const ShaderDataBlock& hDataBlock );
+
+    VPP_DLLAPI void bind (
+        const StorageBufferView& hView,
+        std::uint32_t set, std::uint32_t binding,
+        const ShaderDataBlock& hDataBlock );
 };
 
 // -----------------------------------------------------------------------------
@@ -838,7 +848,86 @@ typedef std::shared_ptr< IDebugProbe > HDebugProbe;
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
+// Per-pipeline values of specialization constants (see specConst).
+// Constants not set here keep values from the pipeline configuration.
+
+class SpecializationValues
+{
+public:
+    typedef std::map< std::uint32_t, std::uint32_t > Values;
+
+    template< class SpecConstT >
+    void set ( const SpecConstT& constant, typename SpecConstT::value_type value );
+
+    template< class SpecConstT >
+    typename SpecConstT::value_type get ( const SpecConstT& constant ) const;
+
+    void setBits ( std::uint32_t id, std::uint32_t bits );
+    void merge ( const SpecializationValues& rhs );
+
+    bool empty() const;
+    const Values& values() const;
+
+private:
+    // Keyed by constant ID, values stored as 32-bit patterns.
+    Values d_values;
+};
+
+// -----------------------------------------------------------------------------
+
+template< class SpecConstT >
+VPP_INLINE void SpecializationValues :: set (
+    const SpecConstT& constant, typename SpecConstT::value_type value )
+{
+    d_values [ constant.id() ] = SpecConstT::toBits ( value );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class SpecConstT >
+VPP_INLINE typename SpecConstT::value_type SpecializationValues :: get (
+    const SpecConstT& constant ) const
+{
+    const Values::const_iterator iValue = d_values.find ( constant.id() );
+
+    return iValue == d_values.end() ?
+        constant.defaultValue() : SpecConstT::fromBits ( iValue->second );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void SpecializationValues :: setBits ( std::uint32_t id, std::uint32_t bits )
+{
+    d_values [ id ] = bits;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void SpecializationValues :: merge ( const SpecializationValues& rhs )
+{
+    for ( const auto& iValue : rhs.d_values )
+        d_values [ iValue.first ] = iValue.second;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool SpecializationValues :: empty() const
+{
+    return d_values.empty();
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const SpecializationValues::Values& SpecializationValues :: values() const
+{
+    return d_values;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
 class PipelineConfigImpl;
+class DebugPrintBuffer;
 
 // -----------------------------------------------------------------------------
 
@@ -878,6 +967,10 @@ protected:
     VPP_DLLAPI void setEnablePrimitiveRestart ( bool v );
     VPP_DLLAPI void setTessPatchControlPoints ( std::uint32_t v );
 
+    // Descriptors in specified set are not allocated from a pool, but pushed
+    // directly into command buffer (requires fExtPushDescriptor).
+    VPP_DLLAPI void setPushDescriptorSet ( std::uint32_t set );
+
 public:
     typedef std::vector< detail::SResourceInfo > Id2ResourceDefinition;
     typedef std::vector< VkPushConstantRange > Id2Constant;
@@ -896,6 +989,9 @@ public:
     typedef std::list< detail::SStructLocationInfo* > StructTypeStack;
     typedef std::pair< detail::SVertexFieldInfo*, VkVertexInputAttributeDescription* > VertexFieldInfo;
     typedef std::vector< HDebugProbe > DebugProbes;
+    typedef std::set< std::uint32_t > PushDescriptorSets;
+    typedef std::vector< VkSpecializationMapEntry > SpecializationEntries;
+    typedef std::vector< std::uint32_t > SpecializationData;
     
     RenderGraph& getRenderGraph() const;
     std::uint32_t getProcessIndex() const;
@@ -918,6 +1014,21 @@ public:
 
     const Id2Constant& getConstants() const;
 
+    VPP_DLLAPI std::uint32_t createSpecializationConstant ( std::uint32_t defaultValue );
+    const SpecializationEntries& getSpecializationEntries() const;
+    const SpecializationData& getSpecializationData() const;
+    const DynamicStates& getDynamicStates() const;
+
+    // Combines configured values of specialization constants with per-pipeline
+    // overrides. Returns false if the pipeline has no specialization constants.
+    VPP_DLLAPI bool initSpecializationInfo (
+        const SpecializationValues& values,
+        SpecializationData* pData,
+        VkSpecializationInfo* pInfo ) const;
+
+    bool isPushDescriptorSet ( std::uint32_t set ) const;
+    bool hasPushDescriptorSets() const;
+
     VPP_DLLAPI const VkSampler* addImmutableSamplers (
         const std::vector< NormalizedSampler >& samplers, std::uint32_t count );
 
@@ -937,6 +1048,13 @@ public:
     VPP_DLLAPI void registerDebugProbe ( const HDebugProbe& hDebugProbe );
     VPP_DLLAPI void bindDebugProbes ( const ShaderDataBlock& hDataBlock ) const;
 
+    // Routes DebugPrint() calls in shaders of this pipeline to specified
+    // buffer. Call in the constructor. Defined in vppDebugPrint.hpp.
+    void enableDebugPrint ( const DebugPrintBuffer& hBuffer, std::uint32_t set = 0 );
+
+    VPP_DLLAPI void registerDebugPrint ( const HDebugProbe& hDebugPrint );
+    VPP_DLLAPI IDebugProbe* getDebugPrint() const;
+
     void initVertexInputCreateInfo (
         VkPipelineVertexInputStateCreateInfo* pDest ) const;
 
@@ -1043,6 +1161,11 @@ private:
     PipelineConfig::Struct2LocationInfo d_struct2LocationInfo;
     PipelineConfig::StructTypeStack d_structTypeStack;
     PipelineConfig::DebugProbes d_debugProbes;
+    HDebugProbe d_hDebugPrint;
+    PipelineConfig::PushDescriptorSets d_pushDescriptorSets;
+    PipelineConfig::SpecializationEntries d_specializationEntries;
+    PipelineConfig::SpecializationData d_specializationData;
+    VkSpecializationInfo d_specializationInfo;
 
     typedef std::pair< std::uint32_t, std::uint32_t > SetBinding;
     typedef std::map< SetBinding, detail::KDescriptor* > SetBinding2Descriptor;
@@ -1115,6 +1238,41 @@ VPP_INLINE const PipelineConfig::Id2Constant& PipelineConfig :: getConstants() c
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE const PipelineConfig::SpecializationEntries& PipelineConfig :: getSpecializationEntries() const
+{
+    return get()->d_specializationEntries;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const PipelineConfig::SpecializationData& PipelineConfig :: getSpecializationData() const
+{
+    return get()->d_specializationData;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const PipelineConfig::DynamicStates& PipelineConfig :: getDynamicStates() const
+{
+    return get()->d_dynamicStates;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool PipelineConfig :: isPushDescriptorSet ( std::uint32_t set ) const
+{
+    return get()->d_pushDescriptorSets.find ( set ) != get()->d_pushDescriptorSets.end();
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool PipelineConfig :: hasPushDescriptorSets() const
+{
+    return ! get()->d_pushDescriptorSets.empty();
+}
+
+// -----------------------------------------------------------------------------
+
 template< class SourceShader, class DestShader >
 VPP_INLINE detail::SIOVariablesInfo* PipelineConfig :: findIOVariablesInfo() const
 {
@@ -1413,15 +1571,22 @@ public:
 
     size_t getSetCount() const;
     const VkDescriptorSetLayoutCreateInfo* getSetInfo ( size_t iSet ) const;
+    std::uint32_t getVariableDescriptorCount ( size_t iSet ) const;
+    bool hasUpdateAfterBindSets() const;
 
 private:
     std::vector< VkDescriptorSetLayoutBinding > d_resourceInfos;
+    std::vector< VkDescriptorBindingFlagsEXT > d_bindingFlags;
+    std::vector< VkDescriptorSetLayoutBindingFlagsCreateInfoEXT > d_bindingFlagsInfos;
     std::vector< VkDescriptorSetLayoutCreateInfo > d_setCreateInfos;
+    std::vector< std::uint32_t > d_variableDescriptorCounts;
+    bool d_bUpdateAfterBind;
 };
 
 // -----------------------------------------------------------------------------
 
-VPP_INLINE KResourceSets :: KResourceSets ( const PipelineConfig& res )
+VPP_INLINE KResourceSets :: KResourceSets ( const PipelineConfig& res ) :
+    d_bUpdateAfterBind ( false )
 {
     PipelineConfig::Id2ResourceDefinition resourceDefs = res.getResources();
 
@@ -1454,14 +1619,70 @@ VPP_INLINE KResourceSets :: KResourceSets ( const PipelineConfig& res )
         resourceDefs.end(),
         d_resourceInfos.begin() );
 
+    d_bindingFlags.resize ( resourceDefs.size() );
+    d_variableDescriptorCounts.resize ( setCount, 0 );
+
+    for ( size_t iSet = 0; iSet != setCount; ++iSet )
+    {
+        const size_t iBegin = setStarts [ iSet ];
+        const size_t iEnd = iBegin + setSizes [ iSet ];
+        size_t iLastBinding = iBegin;
+
+        for ( size_t iRes = iBegin; iRes != iEnd; ++iRes )
+        {
+            d_bindingFlags [ iRes ] = resourceDefs [ iRes ].d_bindingFlags;
+
+            if ( d_resourceInfos [ iRes ].binding > d_resourceInfos [ iLastBinding ].binding )
+                iLastBinding = iRes;
+        }
+
+        // Variable descriptor count is allowed only for the binding with
+        // the largest number in the set. Elsewhere the flag is dropped and
+        // the array has fixed size (still partially bound).
+
+        for ( size_t iRes = iBegin; iRes != iEnd; ++iRes )
+            if ( d_bindingFlags [ iRes ] & VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT )
+            {
+                if ( iRes == iLastBinding )
+                    d_variableDescriptorCounts [ iSet ] = d_resourceInfos [ iRes ].descriptorCount;
+                else
+                    d_bindingFlags [ iRes ] &= ~VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT;
+            }
+    }
+
     d_setCreateInfos.resize ( setCount );
+    d_bindingFlagsInfos.resize ( setCount );
 
     for ( size_t iSet = 0; iSet != setCount; ++iSet )
     {
+        bool bHasBindingFlags = false;
+        bool bUpdateAfterBind = false;
+
+        for ( size_t iRes = setStarts [ iSet ]; iRes != setStarts [ iSet ] + setSizes [ iSet ]; ++iRes )
+        {
+            bHasBindingFlags |= ( d_bindingFlags [ iRes ] != 0 );
+            bUpdateAfterBind |=
+                ( ( d_bindingFlags [ iRes ] & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT ) != 0 );
+        }
+
+        d_bUpdateAfterBind |= bUpdateAfterBind;
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfoEXT& bindingFlagsInfo = d_bindingFlagsInfos [ iSet ];
+        bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+        bindingFlagsInfo.pNext = 0;
+        bindingFlagsInfo.bindingCount = static_cast< std::uint32_t >( setSizes [ iSet ] );
+        bindingFlagsInfo.pBindingFlags = ( bHasBindingFlags ? & d_bindingFlags [ setStarts [ iSet ] ] : 0 );
+
         VkDescriptorSetLayoutCreateInfo& currentSet = d_setCreateInfos [ iSet ];
         currentSet.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        currentSet.pNext = 0;
-        currentSet.flags = 0;
+        currentSet.pNext = ( bHasBindingFlags ? & bindingFlagsInfo : 0 );
+        currentSet.flags = (
+            res.isPushDescriptorSet ( static_cast< std::uint32_t >( iSet ) ) ?
+                VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0 );
+
+        if ( bUpdateAfterBind )
+            currentSet.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+
         currentSet.bindingCount = static_cast< std::uint32_t >( setSizes [ iSet ] );
         currentSet.pBindings = & d_resourceInfos [ setStarts [ iSet ] ];
     }
@@ -1481,6 +1702,20 @@ VPP_INLINE const VkDescriptorSetLayoutCreateInfo* KResourceSets :: getSetInfo (
     return & d_setCreateInfos [ iSet ];
 }
 
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t KResourceSets :: getVariableDescriptorCount ( size_t iSet ) const
+{
+    return d_variableDescriptorCounts [ iSet ];
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool KResourceSets :: hasUpdateAfterBindSets() const
+{
+    return d_bUpdateAfterBind;
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
@@ -1531,8 +1766,9 @@ VPP_INLINE KDescriptorSetLayoutImpl :: KDescriptorSetLayoutImpl (
         d_handle(),
         d_result()
 {
-    d_result = ::vkCreateDescriptorSetLayout (
-        hDevice.handle(), resourceSets.getSetInfo ( iSet ), 0, & d_handle );
+    // Shared with all other pipelines having identical bindings in this set.
+    d_handle = hDevice.layoutCache().acquireSetLayout (
+        *resourceSets.getSetInfo ( iSet ), & d_result );
 }
 
 // -----------------------------------------------------------------------------
@@ -1540,7 +1776,7 @@ VPP_INLINE KDescriptorSetLayoutImpl :: KDescriptorSetLayoutImpl (
 VPP_INLINE KDescriptorSetLayoutImpl :: ~KDescriptorSetLayoutImpl()
 {
     if ( d_result == VK_SUCCESS )
-        ::vkDestroyDescriptorSetLayout ( d_hDevice.handle(), d_handle, 0 );
+        d_hDevice.layoutCache().releaseSetLayout ( d_handle );
 }
 
 // -----------------------------------------------------------------------------
@@ -39,6 +39,8 @@ namespace vpp {
     
 class KPipelineLayoutImpl;
 
+namespace detail { class KDescriptorUpdateTemplate; }
+
 // -----------------------------------------------------------------------------
 
 class PipelineLayoutBase : public TSharedReference< KPipelineLayoutImpl >
@@ -58,6 +60,34 @@ public:
     const DescriptorPoolSizes& getDescriptorPoolSizes() const;
     const PipelineConfig::ShaderTable& getShaderTable() const;
 
+    bool isPushDescriptorSet ( std::uint32_t iSet ) const;
+
+    // Descriptor count of the variable-sized binding in each set (zero if
+    // the set has none), and whether any set needs update-after-bind pool.
+    const std::vector< std::uint32_t >& getVariableDescriptorCounts() const;
+    bool hasUpdateAfterBindSets() const;
+
+    // Writes descriptors of push descriptor sets (see
+    // PipelineConfig::setPushDescriptorSet) directly into the command buffer.
+    // Takes the same assignment lists as ShaderDataBlock::update. Bound
+    // resources are not retained, so they must stay alive until the command
+    // buffer finishes execution.
+
+    template< class AssignmentListT >
+    void cmdPushDescriptors (
+        const AssignmentListT& list,
+        CommandBuffer hCmdBuffer = CommandBuffer() ) const;
+
+    // Descriptor update templates compiled by ShaderDataBlock::update(). They
+    // are shared by all data blocks of this layout and live as long as it.
+
+    detail::KDescriptorUpdateTemplate* findUpdateTemplate (
+        const void* pKey, const detail::KDescriptorUpdateTemplate* pPrevious = 0 ) const;
+
+    detail::KDescriptorUpdateTemplate* addUpdateTemplate (
+        const void* pKey,
+        const std::shared_ptr< detail::KDescriptorUpdateTemplate >& pTemplate ) const;
+
 protected:
     PipelineLayoutBase ( KPipelineLayoutImpl* pImpl, bool bComputePipeline );
 
@@ -91,8 +121,16 @@ protected:
     DescriptorSetLayouts d_descriptorSetLayouts;
     DescriptorSetLayoutHandles d_descriptorSetLayoutHandles;
     DescriptorPoolSizes d_descriptorPoolSizes;
+    std::vector< std::uint32_t > d_variableDescriptorCounts;
+    bool d_bUpdateAfterBind;
 
     PipelineConfig::ShaderTable d_shaderTable;
+
+    typedef std::vector< std::pair<
+        const void*, std::shared_ptr< detail::KDescriptorUpdateTemplate > > > UpdateTemplates;
+
+    UpdateTemplates d_updateTemplates;
+    std::mutex d_updateTemplatesMutex;
 };
 
 // -----------------------------------------------------------------------------
@@ -102,7 +140,8 @@ VPP_INLINE KPipelineLayoutImpl :: KPipelineLayoutImpl (
         d_hDevice ( hDevice ),
         d_handle(),
         d_result(),
-        d_pConfig ( pConfig )
+        d_pConfig ( pConfig ),
+        d_bUpdateAfterBind ( false )
 {
 }
 
@@ -111,7 +150,7 @@ VPP_INLINE KPipelineLayoutImpl :: KPipelineLayoutImpl (
 VPP_INLINE KPipelineLayoutImpl :: ~KPipelineLayoutImpl()
 {
     if ( d_result == VK_SUCCESS )
-        ::vkDestroyPipelineLayout ( d_hDevice.handle(), d_handle, 0 );
+        d_hDevice.layoutCache().releasePipelineLayout ( d_handle );
 }
 
 // -----------------------------------------------------------------------------
@@ -234,6 +273,12 @@ void TPipelineLayoutImpl< DefinitionT > :: initialize ( const Device& hDevice )
         d_descriptorSetLayouts.emplace_back ( resourceSets, iSet, hDevice );
 
     d_descriptorSetLayoutHandles.resize ( d_descriptorSetLayouts.size() );
+    d_variableDescriptorCounts.resize ( nSets );
+
+    for ( size_t iSet = 0; iSet != nSets; ++iSet )
+        d_variableDescriptorCounts [ iSet ] = resourceSets.getVariableDescriptorCount ( iSet );
+
+    d_bUpdateAfterBind = resourceSets.hasUpdateAfterBindSets();
 
     std::transform (
         d_descriptorSetLayouts.begin(), d_descriptorSetLayouts.end(),
@@ -242,6 +287,9 @@ void TPipelineLayoutImpl< DefinitionT > :: initialize ( const Device& hDevice )
 
     for ( const auto& iRes : this->getResources() )
     {
+        if ( this->isPushDescriptorSet ( iRes.d_set ) )
+            continue;
+
         if ( static_cast< size_t >( iRes.descriptorType ) >= d_descriptorPoolSizes.size() )
             d_descriptorPoolSizes.resize ( iRes.descriptorType + 1 );
 
@@ -269,8 +317,8 @@ void TPipelineLayoutImpl< DefinitionT > :: initialize ( const Device& hDevice )
     pipelineLayoutCreateInfo.pushConstantRangeCount = static_cast< std::uint32_t >( this->getConstants().size() );
     pipelineLayoutCreateInfo.pPushConstantRanges = & this->getConstants()[ 0 ];
 
-    d_result = ::vkCreatePipelineLayout (
-        hDevice.handle(), & pipelineLayoutCreateInfo, 0, & d_handle );
+    d_handle = hDevice.layoutCache().acquirePipelineLayout (
+        pipelineLayoutCreateInfo, & d_result );
 }
 
 // -----------------------------------------------------------------------------
@@ -369,6 +417,267 @@ VPP_INLINE const PipelineConfig::ShaderTable& PipelineLayoutBase :: getShaderTab
     return get()->d_shaderTable;
 }
 
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool PipelineLayoutBase :: isPushDescriptorSet ( std::uint32_t iSet ) const
+{
+    return config().isPushDescriptorSet ( iSet );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const std::vector< std::uint32_t >& PipelineLayoutBase :: getVariableDescriptorCounts() const
+{
+    return get()->d_variableDescriptorCounts;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool PipelineLayoutBase :: hasUpdateAfterBindSets() const
+{
+    return get()->d_bUpdateAfterBind;
+}
+
+// -----------------------------------------------------------------------------
+
+// Several templates may share the same key, if the same assignment list type
+// is used for different bindings. Returns the next one after pPrevious.
+
+VPP_INLINE detail::KDescriptorUpdateTemplate* PipelineLayoutBase :: findUpdateTemplate (
+    const void* pKey, const detail::KDescriptorUpdateTemplate* pPrevious ) const
+{
+    std::lock_guard< std::mutex > lock ( get()->d_updateTemplatesMutex );
+
+    bool bSearching = ( pPrevious == 0 );
+
+    for ( const auto& iTemplate : get()->d_updateTemplates )
+    {
+        if ( ! bSearching )
+            bSearching = ( iTemplate.second.get() == pPrevious );
+        else if ( iTemplate.first == pKey )
+            return iTemplate.second.get();
+    }
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+// Templates are added only after being compiled, so other threads never see
+// an incomplete one. Two threads compiling the same list concurrently add
+// equivalent templates, and both remain usable.
+
+VPP_INLINE detail::KDescriptorUpdateTemplate* PipelineLayoutBase :: addUpdateTemplate (
+    const void* pKey,
+    const std::shared_ptr< detail::KDescriptorUpdateTemplate >& pTemplate ) const
+{
+    std::lock_guard< std::mutex > lock ( get()->d_updateTemplatesMutex );
+    get()->d_updateTemplates.emplace_back ( pKey, pTemplate );
+    return pTemplate.get();
+}
+
+// -----------------------------------------------------------------------------
+namespace detail {
+// -----------------------------------------------------------------------------
+
+// Array with storage for CAPACITY items inside the object. Falls back to the
+// heap only when constructed for more items.
+
+template< typename ItemT, size_t CAPACITY >
+class TFixedCapacityArray
+{
+public:
+    VPP_INLINE TFixedCapacityArray ( size_t count ) :
+        d_pItems ( d_items )
+    {
+        if ( count > CAPACITY )
+        {
+            d_heapItems.resize ( count );
+            d_pItems = & d_heapItems [ 0 ];
+        }
+    }
+
+    VPP_INLINE ItemT& operator[] ( size_t index )
+    {
+        return d_pItems [ index ];
+    }
+
+private:
+    TFixedCapacityArray ( const TFixedCapacityArray& ) = delete;
+    const TFixedCapacityArray& operator= ( const TFixedCapacityArray& ) = delete;
+
+private:
+    ItemT d_items [ CAPACITY ];
+    std::vector< ItemT > d_heapItems;
+    ItemT* d_pItems;
+};
+
+// -----------------------------------------------------------------------------
+
+template< class AssignmentListT >
+class TPushDescriptorWriter
+{
+public:
+    VPP_INLINE TPushDescriptorWriter ( const PipelineLayoutBase& hLayout, const AssignmentListT& list ) :
+        d_layout ( hLayout ),
+        d_imageInfos ( list.getImageInfoCount() ),
+        d_bufferInfos ( list.getBufferInfoCount() ),
+        d_texelBufferViews ( list.getTexelBufferViewCount() ),
+        d_currentWriter ( 0 ),
+        d_currentImageInfo ( 0 ),
+        d_currentBufferInfo ( 0 ),
+        d_currentTexelBufferView ( 0 )
+    {
+    }
+
+    static const size_t ASSIGNER_COUNT = AssignmentListT::ASSIGNER_COUNT;
+
+    // Room for several array elements per assignment without touching the
+    // heap. Larger arrays are rare and get heap storage.
+
+    static const size_t INFO_CAPACITY = ( ASSIGNER_COUNT + 1 ) * 4;
+
+    VPP_INLINE void copy (
+        std::uint32_t, std::uint32_t, std::uint32_t,
+        std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t )
+    {
+        throw XUsageError ( "Descriptor copies are not allowed for push descriptors." );
+    }
+
+    VPP_INLINE VkDescriptorImageInfo* allocateSetUpdateInfo (
+        VkWriteDescriptorSet& currentSet, VkDescriptorImageInfo*, size_t count )
+    {
+        VkDescriptorImageInfo* pInfo = & d_imageInfos [ d_currentImageInfo ];
+        d_currentImageInfo += count;
+        currentSet.pImageInfo = pInfo;
+        currentSet.pBufferInfo = 0;
+        currentSet.pTexelBufferView = 0;
+        return pInfo;
+    }
+
+    VPP_INLINE VkDescriptorBufferInfo* allocateSetUpdateInfo (
+        VkWriteDescriptorSet& currentSet, VkDescriptorBufferInfo*, size_t count )
+    {
+        VkDescriptorBufferInfo* pInfo = & d_bufferInfos [ d_currentBufferInfo ];
+        d_currentBufferInfo += count;
+        currentSet.pImageInfo = 0;
+        currentSet.pBufferInfo = pInfo;
+        currentSet.pTexelBufferView = 0;
+        return pInfo;
+    }
+
+    VPP_INLINE VkBufferView* allocateSetUpdateInfo (
+        VkWriteDescriptorSet& currentSet, VkBufferView*, size_t count )
+    {
+        VkBufferView* pInfo = & d_texelBufferViews [ d_currentTexelBufferView ];
+        d_currentTexelBufferView += count;
+        currentSet.pImageInfo = 0;
+        currentSet.pBufferInfo = 0;
+        currentSet.pTexelBufferView = pInfo;
+        return pInfo;
+    }
+
+    template< VkDescriptorType TYPE, typename ViewT, typename ValueT >
+    VPP_INLINE void write (
+        std::uint32_t id,
+        std::uint32_t set,
+        std::uint32_t binding,
+        const ValueT& value )
+    {
+        if ( ! d_layout.isPushDescriptorSet ( set ) )
+            throw XUsageError ( "Descriptor set is not configured for push descriptors." );
+
+        d_sets [ d_currentWriter ] = set;
+
+        VkWriteDescriptorSet& currentSet = d_writers [ d_currentWriter++ ];
+        currentSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        currentSet.pNext = 0;
+        currentSet.dstSet = VK_NULL_HANDLE;
+        currentSet.dstBinding = binding;
+        currentSet.dstArrayElement = detail::getValueStartIndex ( value );
+        currentSet.descriptorCount = static_cast< std::uint32_t >( detail::getValueCount ( value ) );
+        currentSet.descriptorType = TYPE;
+
+        typedef detail::TDescriptorTypeTraits< TYPE, ViewT > type_traits;
+        typename type_traits::update_dest_type* pTag = 0;
+
+        type_traits::update (
+            allocateSetUpdateInfo ( currentSet, pTag, currentSet.descriptorCount ),
+            value
+        );
+    }
+
+    VPP_INLINE void push ( const AssignmentListT& list, VkCommandBuffer hCmdBuffer )
+    {
+        const PFN_vkCmdPushDescriptorSetKHR pfnCmdPushDescriptorSet =
+            d_layout.device().cmdPushDescriptorSetFunction();
+
+        if ( ! pfnCmdPushDescriptorSet )
+            throw XUsageError ( "Push descriptors require fExtPushDescriptor device feature." );
+
+        list.for_each ( *this );
+
+        const VkPipelineBindPoint bindPoint = d_layout.isComputePipeline() ?
+            VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+        // One call per descriptor set. Writes for the same set are gathered
+        // together, as they may be interleaved in the assignment list.
+
+        VkWriteDescriptorSet setWriters [ ASSIGNER_COUNT + 1 ];
+        bool bDone [ ASSIGNER_COUNT + 1 ] = { false };
+
+        for ( size_t iWriter = 0; iWriter != d_currentWriter; ++iWriter )
+        {
+            if ( bDone [ iWriter ] )
+                continue;
+
+            const std::uint32_t set = d_sets [ iWriter ];
+            std::uint32_t nSetWriters = 0;
+
+            for ( size_t jWriter = iWriter; jWriter != d_currentWriter; ++jWriter )
+                if ( d_sets [ jWriter ] == set )
+                {
+                    setWriters [ nSetWriters++ ] = d_writers [ jWriter ];
+                    bDone [ jWriter ] = true;
+                }
+
+            pfnCmdPushDescriptorSet (
+                hCmdBuffer, bindPoint, d_layout.handle(), set, nSetWriters, setWriters );
+        }
+    }
+
+private:
+    const PipelineLayoutBase& d_layout;
+
+    TFixedCapacityArray< VkDescriptorImageInfo, INFO_CAPACITY > d_imageInfos;
+    TFixedCapacityArray< VkDescriptorBufferInfo, INFO_CAPACITY > d_bufferInfos;
+    TFixedCapacityArray< VkBufferView, INFO_CAPACITY > d_texelBufferViews;
+
+    VkWriteDescriptorSet d_writers [ ASSIGNER_COUNT + 1 ];
+    std::uint32_t d_sets [ ASSIGNER_COUNT + 1 ];
+
+    size_t d_currentWriter;
+    size_t d_currentImageInfo;
+    size_t d_currentBufferInfo;
+    size_t d_currentTexelBufferView;
+};
+
+// -----------------------------------------------------------------------------
+} // namespace detail
+// -----------------------------------------------------------------------------
+
+template< class AssignmentListT >
+VPP_INLINE void PipelineLayoutBase :: cmdPushDescriptors (
+    const AssignmentListT& list, CommandBuffer hCommandBuffer ) const
+{
+    const VkCommandBuffer hCmdBuffer = hCommandBuffer ?
+        hCommandBuffer.handle()
+        : RenderingCommandContext::getCommandBufferHandle();
+
+    detail::TPushDescriptorWriter< AssignmentListT > writer ( *this, list );
+    writer.push ( list, hCmdBuffer );
+}
+
 // -----------------------------------------------------------------------------
 } // namespace vpp
 // -----------------------------------------------------------------------------
@@ -70,15 +70,28 @@ public:
         const CommandBuffer& singleBuffer,
         const Semaphore& waitOnBegin = Semaphore(),
         const Semaphore& signalOnEnd = Semaphore(),
-        const Fence& signalFenceOnEnd = Fence() ) const;
+        const Fence& signalFenceOnEnd = Fence(),
+        VkPipelineStageFlags waitStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT ) const;
 
     VPP_DLLAPI void submit (
         const std::vector< CommandBuffer > buffers,
         const Semaphore& waitOnBegin = Semaphore(),
         const Semaphore& signalOnEnd = Semaphore(),
-        const Fence& signalFenceOnEnd = Fence() ) const;
+        const Fence& signalFenceOnEnd = Fence(),
+        VkPipelineStageFlags waitStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT ) const;
 
-    VkResult waitForIdle();
+    VPP_DLLAPI void signal ( const Fence& signalFence ) const;
+
+    VPP_DLLAPI void signal (
+        const std::vector< Semaphore >& waitSems,
+        const Fence& signalFence = Fence() ) const;
+
+    VPP_DLLAPI void signal (
+        const std::vector< Semaphore >& waitSems,
+        const std::vector< Semaphore >& signalSems,
+        const Fence& signalFence = Fence() ) const;
+
+    VPP_DLLAPI VkResult waitForIdle();
 };
 
 // -----------------------------------------------------------------------------
@@ -197,12 +210,6 @@ VPP_INLINE Queue :: operator bool() const
 
 // -----------------------------------------------------------------------------
 
-VPP_INLINE VkResult Queue :: waitForIdle()
-{
-    return ::vkQueueWaitIdle ( get()->d_handle );
-}
-
-// -----------------------------------------------------------------------------
 } // namespace vpp
 // -----------------------------------------------------------------------------
 
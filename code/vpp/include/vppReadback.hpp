@@ -0,0 +1,291 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPREADBACK_HPP
+#define INC_VPPREADBACK_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPCONTAINERS_HPP
+#include "vppContainers.hpp"
+#endif
+
+#ifndef INC_VPPSYNCHRONIZATION_HPP
+#include "vppSynchronization.hpp"
+#endif
+
+#ifndef INC_VPPCOMMANDPOOL_HPP
+#include "vppCommandPool.hpp"
+#endif
+
+#ifndef INC_VPPQUEUE_HPP
+#include "vppQueue.hpp"
+#endif
+
+#include <condition_variable>
+#include <deque>
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class ReadbackFutureImpl;
+class ReadbackQueueImpl;
+class KReadbackRingImpl;
+
+// -----------------------------------------------------------------------------
+
+// Handle to a device to host transfer started by ReadbackQueue. Can be
+// polled, waited for, or given continuations.
+
+class ReadbackFuture : public TSharedReference< ReadbackFutureImpl >
+{
+public:
+    ReadbackFuture();
+
+    VPP_DLLAPI bool isReady() const;
+
+    // Returns false on timeout.
+    VPP_DLLAPI bool wait ( std::uint64_t timeoutNs = NO_TIMEOUT ) const;
+
+    // Host copy of the data, for readBuffer() requests. Valid after the
+    // transfer completes, as long as any handle to the future exists.
+    // Requests on vectors deliver data to the vector itself and return 0 here.
+    VPP_DLLAPI const void* data() const;
+    VPP_DLLAPI VkDeviceSize size() const;
+
+    // Called on the completion thread of the queue, or immediately on the
+    // calling thread if the transfer has already completed. Must not throw.
+    typedef std::function< void ( const ReadbackFuture& ) > FContinuation;
+
+    VPP_DLLAPI void then ( const FContinuation& continuation );
+
+private:
+    friend class ReadbackQueue;
+    friend class ReadbackQueueImpl;
+    ReadbackFuture ( ReadbackFutureImpl* pImpl );
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+// Issues asynchronous readbacks on a single queue. Fences and command buffers
+// are pooled, and arbitrary buffer ranges are copied to a persistently mapped
+// staging ring. Requests which do not fit in the ring get dedicated staging
+// memory. Any number of readbacks may be in flight; a background thread
+// retires them in submission order and runs continuations.
+//
+// Requests must be issued from one thread at a time. Vectors passed to
+// load() and copyFromImage() must outlive the returned futures' completion.
+
+class ReadbackQueue : public TSharedReference< ReadbackQueueImpl >
+{
+public:
+    ReadbackQueue();
+
+    VPP_DLLAPI ReadbackQueue (
+        const Device& hDevice,
+        VkDeviceSize stagingSize = 4 * 1024 * 1024,
+        EQueueType eQueue = Q_GRAPHICS );
+
+    // Asynchronous counterpart of VectorBase::loadAndWait().
+
+    VPP_DLLAPI ReadbackFuture load ( detail::VectorBase& vector );
+
+    // Asynchronous counterpart of VectorBase::copyFromImageAndWait().
+
+    VPP_DLLAPI ReadbackFuture copyFromImage (
+        detail::VectorBase& vector,
+        const TSImg& img,
+        VkImageLayout sourceImageLayout,
+        std::uint32_t mipLevel = 0,
+        std::uint32_t layer = 0,
+        const VkOffset3D& imageOffset = VkOffset3D { 0, 0, 0 },
+        const VkExtent3D& imageExtent = VkExtent3D { 0, 0, 0 },
+        VkDeviceSize bufferOffset = 0,
+        std::uint32_t bufferRowLength = 0,
+        std::uint32_t bufferImageHeight = 0 );
+
+    // Copies a range of any buffer with SOURCE usage to host memory.
+
+    VPP_DLLAPI ReadbackFuture readBuffer (
+        const Buf& hBuffer,
+        VkDeviceSize offset,
+        VkDeviceSize size );
+
+    // Waits until all readbacks issued so far have completed and their
+    // continuations have returned.
+
+    VPP_DLLAPI void waitIdle();
+
+    VPP_DLLAPI size_t pendingCount() const;
+
+    const Device& device() const;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KReadbackRingImpl : public TSharedObject< KReadbackRingImpl >
+{
+public:
+    KReadbackRingImpl ( const Device& hDevice, VkDeviceSize size );
+
+    VPP_INLINE bool compareObjects ( const KReadbackRingImpl* pRHS ) const
+    {
+        return this < pRHS;
+    }
+
+    bool allocate ( VkDeviceSize size, VkDeviceSize* pOffset );
+    void release ( VkDeviceSize offset );
+
+    typedef MemoryBinding< Buf, MappableDeviceMemory > StagingBinding;
+    StagingBinding d_staging;
+
+private:
+    struct SSlice
+    {
+        VkDeviceSize d_offset;
+        bool d_bReleased;
+    };
+
+    VkDeviceSize d_size;
+    VkDeviceSize d_head;
+    std::deque< SSlice > d_slices;
+    std::mutex d_mutex;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class ReadbackFutureImpl : public TSharedObject< ReadbackFutureImpl >
+{
+public:
+    ReadbackFutureImpl();
+    ~ReadbackFutureImpl();
+
+    VPP_INLINE bool compareObjects ( const ReadbackFutureImpl* pRHS ) const
+    {
+        return this < pRHS;
+    }
+
+private:
+    friend class ReadbackFuture;
+    friend class ReadbackQueue;
+    friend class ReadbackQueueImpl;
+
+    void complete ( const ReadbackFuture& hThis );
+
+    detail::VectorBase* d_pVector;
+    TSharedReference< KReadbackRingImpl > d_hRing;
+    KReadbackRingImpl::StagingBinding d_staging;
+    VkDeviceSize d_offset;
+    VkDeviceSize d_size;
+
+    bool d_bReady;
+    std::vector< ReadbackFuture::FContinuation > d_continuations;
+    mutable std::mutex d_mutex;
+    mutable std::condition_variable d_readyCondition;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class ReadbackQueueImpl : public TSharedObject< ReadbackQueueImpl >
+{
+public:
+    ReadbackQueueImpl (
+        const Device& hDevice, VkDeviceSize stagingSize, EQueueType eQueue );
+
+    ~ReadbackQueueImpl();
+
+    VPP_INLINE bool compareObjects ( const ReadbackQueueImpl* pRHS ) const
+    {
+        return this < pRHS;
+    }
+
+private:
+    friend class ReadbackQueue;
+
+    CommandBuffer acquireCommandBuffer();
+    void submit ( const ReadbackFuture& future, const CommandBuffer& hCmdBuffer );
+    void completionThread();
+
+    struct SPending
+    {
+        ReadbackFuture d_future;
+        CommandBuffer d_cmdBuffer;
+        Fence d_fence;
+    };
+
+    Device d_hDevice;
+    Queue d_queue;
+    CommandPool d_commandPool;
+    TSharedReference< KReadbackRingImpl > d_hRing;
+
+    std::vector< CommandBuffer > d_freeCmdBuffers;
+    std::vector< Fence > d_freeFences;
+    std::deque< SPending > d_pending;
+    size_t d_nRetiring;
+    bool d_bStop;
+
+    mutable std::mutex d_mutex;
+    std::condition_variable d_pendingCondition;
+    std::condition_variable d_idleCondition;
+    std::thread d_thread;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE ReadbackFuture :: ReadbackFuture()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE ReadbackFuture :: ReadbackFuture ( ReadbackFutureImpl* pImpl ) :
+    TSharedReference< ReadbackFutureImpl >( pImpl )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE ReadbackQueue :: ReadbackQueue()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const Device& ReadbackQueue :: device() const
+{
+    return get()->d_hDevice;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPREADBACK_HPP
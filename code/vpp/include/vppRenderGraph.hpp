@@ -174,6 +174,17 @@ public:
         std::uint32_t drawCount,
         CommandBuffer hCmdBuffer = CommandBuffer() );
 
+    // Draw count is read by GPU from countData. Without VK_KHR_draw_indirect_count,
+    // maxDrawCount commands are drawn, so unused ones must have zero instance count.
+
+    VPP_DLLAPI static void cmdDrawIndexedIndirectCount (
+        const IndirectBufferView& data,
+        VkDeviceSize offset,
+        const IndirectBufferView& countData,
+        VkDeviceSize countOffset,
+        std::uint32_t maxDrawCount,
+        CommandBuffer hCmdBuffer = CommandBuffer() );
+
     VPP_DLLAPI static void cmdClearImages (
         std::uint32_t attachmentCount,
         const VkClearAttachment* pAttachments,
@@ -158,6 +158,10 @@ class Display : public BaseAttachment
 public:
     VPP_DLLAPI Display ( const Surface& hSurface );
     VPP_DLLAPI Display ( RenderGraph* pGraph, const Surface& hSurface );
+
+    // Offscreen display, for OffscreenRenderManager.
+    VPP_DLLAPI Display ( const VkExtent2D& imageSize, VkFormat format );
+    VPP_DLLAPI Display ( RenderGraph* pGraph, const VkExtent2D& imageSize, VkFormat format );
     VPP_DLLAPI ~Display();
 };
 
@@ -79,15 +79,23 @@ public:
     VPP_DLLAPI const Pipeline& pipeline ( std::uint32_t iProcess, std::uint32_t iPipeline ) const;
     VPP_DLLAPI const Pipeline& pipeline ( const Process& hProcess, std::uint32_t iPipeline ) const;
 
+    // Number of Vulkan pipelines actually created. Pipelines added with
+    // options differing only in state which can be dynamic (viewports,
+    // line width, depth bias and bounds, stencil masks and reference)
+    // share one Vulkan pipeline and set that state when bound.
+    VPP_DLLAPI size_t pipelineVariantCount() const;
+
     VPP_DLLAPI std::uint32_t addPipeline (
         std::uint32_t iProcess,
         const PipelineLayoutBase& layout,
-        const RenderingOptions& options );
+        const RenderingOptions& options,
+        const SpecializationValues& specialization = SpecializationValues() );
 
     VPP_DLLAPI std::uint32_t addPipeline (
         const Process& hProcess,
         const PipelineLayoutBase& layout,
-        const RenderingOptions& options );
+        const RenderingOptions& options,
+        const SpecializationValues& specialization = SpecializationValues() );
 
     VPP_DLLAPI void beginRendering();
     VPP_DLLAPI void endRendering();
@@ -132,8 +140,16 @@ private:
 
         PipelineLayoutBase d_layout;
         RenderingOptions d_options;
+        SpecializationValues d_specialization;
         Pipeline d_pipeline;
 
+        PipelineConfig::ShaderTable d_specializedStages;
+        PipelineConfig::SpecializationData d_specializationData;
+        VkSpecializationInfo d_specializationInfo;
+
+        SFoldedDynamicState d_foldedState;
+        PipelineConfig::DynamicStates d_dynamicStates;
+
         VkPipelineVertexInputStateCreateInfo d_vertexInputInfo;
         VkPipelineInputAssemblyStateCreateInfo d_inputAssemblyInfo;
         VkPipelineTessellationStateCreateInfo d_tessellationInfo;
@@ -149,6 +165,7 @@ private:
     
     PipelineCreateInfos d_pipelineCreateInfos;
     std::vector< ProcessPipelineData > d_pipelineData;
+    size_t d_variantCount;
 
     bool d_bPipelinesCreated;
 };
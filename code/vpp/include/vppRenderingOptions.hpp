@@ -248,6 +248,13 @@ public:
     void initDepthStencilInfo (
         VkPipelineDepthStencilStateCreateInfo* pDest ) const;
 
+    // Canonical form of the state which has to be baked into the pipeline.
+    // Options giving equal keys produce the same pipeline, differing only
+    // in the state reported by initFoldedDynamicState().
+    void getVariantKey ( std::vector< std::uint64_t >* pWords ) const;
+
+    void initFoldedDynamicState ( SFoldedDynamicState* pDest ) const;
+
 private:
     VPP_DLLAPI void copyOnWrite();
 };
@@ -275,6 +282,10 @@ private:
     VPP_DLLAPI void initDepthStencilInfo (
         VkPipelineDepthStencilStateCreateInfo* pDest ) const;
 
+    VPP_DLLAPI void getVariantKey ( std::vector< std::uint64_t >* pWords ) const;
+
+    VPP_DLLAPI void initFoldedDynamicState ( SFoldedDynamicState* pDest ) const;
+
 private:
     VkPolygonMode d_polygonMode;
     VkCullModeFlagBits d_cullMode;
@@ -747,6 +758,22 @@ VPP_INLINE void RenderingOptions :: initDepthStencilInfo (
     get()->initDepthStencilInfo ( pDest );
 }
 
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void RenderingOptions :: getVariantKey (
+    std::vector< std::uint64_t >* pWords ) const
+{
+    get()->getVariantKey ( pWords );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void RenderingOptions :: initFoldedDynamicState (
+    SFoldedDynamicState* pDest ) const
+{
+    get()->initFoldedDynamicState ( pDest );
+}
+
 // -----------------------------------------------------------------------------
 } // namespace vpp
 // -----------------------------------------------------------------------------
@@ -0,0 +1,92 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef INC_VPPSAMPLERCACHE_HPP
+#define INC_VPPSAMPLERCACHE_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPHANDLECACHE_HPP
+#include "vppHandleCache.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class DestructionQueue;
+
+// -----------------------------------------------------------------------------
+
+// Device-wide cache of sampler objects. Samplers created from equal
+// descriptions (including immutable samplers of pipeline configurations)
+// share one Vulkan sampler, which helps to stay within the
+// maxSamplerAllocationCount limit. Entries are reference counted, and
+// destroyed through the destruction queue when the last reference is
+// released (same as in LayoutCache). Thread safe.
+
+class SamplerCache
+{
+public:
+    SamplerCache ( VkDevice hDevice, DestructionQueue* pDestructionQueue );
+    VPP_DLLAPI ~SamplerCache();
+
+    VPP_DLLAPI VkSampler acquireSampler (
+        const VkSamplerCreateInfo& createInfo,
+        VkResult* pResult );
+
+    VPP_DLLAPI void releaseSampler ( VkSampler hSampler );
+
+    VPP_DLLAPI size_t samplerCount() const;
+    VPP_DLLAPI std::uint64_t hitCount() const;
+    VPP_DLLAPI std::uint64_t missCount() const;
+
+private:
+    SamplerCache ( const SamplerCache& ) = delete;
+    const SamplerCache& operator= ( const SamplerCache& ) = delete;
+
+private:
+    VkDevice d_hDevice;
+    DestructionQueue* d_pDestructionQueue;
+    THandleCache< VkSampler > d_samplers;
+    mutable std::mutex d_mutex;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE SamplerCache :: SamplerCache (
+    VkDevice hDevice, DestructionQueue* pDestructionQueue ) :
+        d_hDevice ( hDevice ),
+        d_pDestructionQueue ( pDestructionQueue )
+{
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPSAMPLERCACHE_HPP
@@ -278,7 +278,29 @@ public:
         Args... args ) :
             KShader ( VK_SHADER_STAGE_COMPUTE_BIT ),
             d_definition ( std::bind ( fMethodDef, pParentClass, std::placeholders::_1, args... ) ),
-            d_localSize ( localSize )
+            d_localSize ( localSize ),
+            d_localSizeIds { 0, 0, 0 },
+            d_bSpecializedLocalSize ( false )
+    {
+        PipelineConfig::getInstance()->setComputeShader ( this );
+    }
+
+    // Local group size given by specialization constants (specConst< int >),
+    // so that it can be changed for each pipeline without translating the
+    // shader again.
+    template< class ClassT, class SpecConstT, typename... Args >
+    VPP_INLINE computeShader (
+        ClassT* pParentClass,
+        const SpecConstT& localSizeX,
+        const SpecConstT& localSizeY,
+        const SpecConstT& localSizeZ,
+        void ( ClassT::* fMethodDef )( ComputeShader*, Args... ),
+        Args... args ) :
+            KShader ( VK_SHADER_STAGE_COMPUTE_BIT ),
+            d_definition ( std::bind ( fMethodDef, pParentClass, std::placeholders::_1, args... ) ),
+            d_localSize { localSizeX.defaultValue(), localSizeY.defaultValue(), localSizeZ.defaultValue() },
+            d_localSizeIds { localSizeX.id(), localSizeY.id(), localSizeZ.id() },
+            d_bSpecializedLocalSize ( true )
     {
         PipelineConfig::getInstance()->setComputeShader ( this );
     }
@@ -292,6 +314,8 @@ protected:
 private:
     std::function< void ( ComputeShader* ) > d_definition;
     const SLocalGroupSize d_localSize;
+    const SLocalGroupSpecIds d_localSizeIds;
+    const bool d_bSpecializedLocalSize;
 };
 
 // -----------------------------------------------------------------------------
@@ -50,11 +50,17 @@ public:
         const Device& hDevice,
         bool bDeallocatable,
         std::uint32_t setCount,
-        const std::vector< VkDescriptorPoolSize >& dpSizes );
+        const std::vector< VkDescriptorPoolSize >& dpSizes,
+        bool bUpdateAfterBind = false );
 
     VkDescriptorPool handle() const;
     bool valid() const;
     void reset();
+
+    // Vulkan requires external synchronization of the pool for allocations,
+    // frees, resets and destruction. Frees and destruction may be deferred
+    // to the reclaimer thread, so all of these take this mutex.
+    const std::shared_ptr< std::mutex >& mutex() const;
 };
 
 // -----------------------------------------------------------------------------
@@ -67,7 +73,8 @@ public:
         const Device& hDevice,
         bool bDeallocatable,
         std::uint32_t setCount,
-        const std::vector< VkDescriptorPoolSize >& dpSizes );
+        const std::vector< VkDescriptorPoolSize >& dpSizes,
+        bool bUpdateAfterBind );
 
     ~KShaderDataAllocatorImpl();
 
@@ -76,6 +83,7 @@ private:
     Device d_hDevice;
     VkDescriptorPool d_handle;
     VkResult d_result;
+    std::shared_ptr< std::mutex > d_pMutex;
 };
 
 // -----------------------------------------------------------------------------
@@ -84,15 +92,21 @@ VPP_INLINE KShaderDataAllocatorImpl :: KShaderDataAllocatorImpl (
     const Device& hDevice, 
     bool bDeallocatable,
     std::uint32_t setCount,
-    const std::vector< VkDescriptorPoolSize >& dpSizes ) :
+    const std::vector< VkDescriptorPoolSize >& dpSizes,
+    bool bUpdateAfterBind ) :
         d_hDevice ( hDevice ),
         d_handle(),
-        d_result()
+        d_result(),
+        d_pMutex ( std::make_shared< std::mutex >() )
 {
     VkDescriptorPoolCreateInfo descriptorPoolCreateInfo;
     descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     descriptorPoolCreateInfo.pNext = 0;
     descriptorPoolCreateInfo.flags = ( bDeallocatable ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0 );
+
+    if ( bUpdateAfterBind )
+        descriptorPoolCreateInfo.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+
     descriptorPoolCreateInfo.maxSets = setCount;
     descriptorPoolCreateInfo.poolSizeCount = static_cast< std::uint32_t >( dpSizes.size() );
     descriptorPoolCreateInfo.pPoolSizes = & dpSizes [ 0 ];
@@ -106,7 +120,15 @@ VPP_INLINE KShaderDataAllocatorImpl :: KShaderDataAllocatorImpl (
 VPP_INLINE KShaderDataAllocatorImpl :: ~KShaderDataAllocatorImpl()
 {
     if ( d_result == VK_SUCCESS )
-        ::vkDestroyDescriptorPool ( d_hDevice.handle(), d_handle, 0 );
+    {
+        const VkDevice hDevice = d_hDevice.handle();
+        const VkDescriptorPool hPool = d_handle;
+        const std::shared_ptr< std::mutex > pMutex = d_pMutex;
+
+        d_hDevice.destructionQueue().enqueue ( [ hDevice, hPool, pMutex ]() {
+            std::lock_guard< std::mutex > lock ( *pMutex );
+            ::vkDestroyDescriptorPool ( hDevice, hPool, 0 ); } );
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -121,9 +143,11 @@ VPP_INLINE KShaderDataAllocator :: KShaderDataAllocator (
     const Device& hDevice,
     bool bDeallocatable,
     std::uint32_t setCount,
-    const std::vector< VkDescriptorPoolSize >& dpSizes ) :
+    const std::vector< VkDescriptorPoolSize >& dpSizes,
+    bool bUpdateAfterBind ) :
         TSharedReference< KShaderDataAllocatorImpl > (
-            new KShaderDataAllocatorImpl ( hDevice, bDeallocatable, setCount, dpSizes ) )
+            new KShaderDataAllocatorImpl (
+                hDevice, bDeallocatable, setCount, dpSizes, bUpdateAfterBind ) )
 {
 }
 
@@ -146,14 +170,111 @@ VPP_INLINE bool KShaderDataAllocator :: valid() const
 VPP_INLINE void KShaderDataAllocator :: reset()
 {
     if ( valid() )
+    {
+        std::lock_guard< std::mutex > lock ( *get()->d_pMutex );
         ::vkResetDescriptorPool ( get()->d_hDevice.handle(), get()->d_handle, 0 );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const std::shared_ptr< std::mutex >& KShaderDataAllocator :: mutex() const
+{
+    return get()->d_pMutex;
 }
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
 class KShaderDataBlockImpl;
+class ShaderDataBlock;
+
+// -----------------------------------------------------------------------------
+namespace detail {
+// -----------------------------------------------------------------------------
+
+// Compiled form of an assignment list. Holds descriptor update templates
+// (one per descriptor set touched by the list) and the layout of packed
+// payload data consumed by vkUpdateDescriptorSetWithTemplate. Immutable
+// once created and shared by all data blocks of the pipeline layout, which
+// keep their own item holders (d_firstItem indexes them).
+
+class KDescriptorUpdateTemplate
+{
+public:
+    struct SEntry
+    {
+        VkDescriptorUpdateTemplateEntry d_entry;
+        std::uint32_t d_set;
+        std::uint32_t d_firstItem;
+    };
+
+    KDescriptorUpdateTemplate ( const Device& hDevice );
+    VPP_DLLAPI ~KDescriptorUpdateTemplate();
+
+    VPP_DLLAPI void addEntry (
+        VkDescriptorType type,
+        std::uint32_t set,
+        std::uint32_t binding,
+        std::uint32_t startIndex,
+        std::uint32_t count,
+        std::uint32_t stride );
+
+    VPP_DLLAPI void create ( const PipelineLayoutBase& hLayout, size_t payloadCapacity );
+    VPP_DLLAPI void apply ( const ShaderDataBlock& hDataBlock, const void* pPayload ) const;
+
+    bool valid() const;
+    const SEntry& entry ( size_t iEntry ) const;
+    std::uint32_t itemCount() const;
+
+private:
+    KDescriptorUpdateTemplate ( const KDescriptorUpdateTemplate& ) = delete;
+    const KDescriptorUpdateTemplate& operator= ( const KDescriptorUpdateTemplate& ) = delete;
+
+private:
+    Device d_hDevice;
+    bool d_bValid;
+    std::uint32_t d_payloadSize;
+    std::uint32_t d_itemCount;
+    std::vector< SEntry > d_entries;
+    std::vector< std::uint32_t > d_templateSets;
+    std::vector< VkDescriptorUpdateTemplate > d_templates;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE KDescriptorUpdateTemplate :: KDescriptorUpdateTemplate ( const Device& hDevice ) :
+    d_hDevice ( hDevice ),
+    d_bValid ( false ),
+    d_payloadSize ( 0 ),
+    d_itemCount ( 0 )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool KDescriptorUpdateTemplate :: valid() const
+{
+    return d_bValid;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const KDescriptorUpdateTemplate::SEntry& KDescriptorUpdateTemplate :: entry (
+    size_t iEntry ) const
+{
+    return d_entries [ iEntry ];
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t KDescriptorUpdateTemplate :: itemCount() const
+{
+    return d_itemCount;
+}
 
+// -----------------------------------------------------------------------------
+} // namespace detail
 // -----------------------------------------------------------------------------
 
 class ShaderDataBlock : public TSharedReference< KShaderDataBlockImpl >
@@ -165,6 +286,7 @@ public:
     VkDescriptorSet getDescriptorSet ( std::uint32_t iSet ) const;
 
     const Device& device() const;
+    const PipelineLayoutBase& layout() const;
 
     template< class AssignmentListT >
     void update ( const AssignmentListT& list );
@@ -176,6 +298,9 @@ public:
 
     template< class ValueT >
     void setBoundItem ( std::uint32_t id, const TUpdateMultipleDescriptors< ValueT >& values );
+
+    detail::KDescriptorItemHolder* templateItemHolders (
+        const detail::KDescriptorUpdateTemplate* pTemplate );
 };
 
 // -----------------------------------------------------------------------------
@@ -204,6 +329,12 @@ private:
         detail::KDescriptorItemHolder > IdIndex2ItemHolder;
 
     IdIndex2ItemHolder d_idIndex2itemHolder;
+
+    typedef std::vector< std::pair<
+        const detail::KDescriptorUpdateTemplate*,
+        std::vector< detail::KDescriptorItemHolder > > > TemplateItemHolders;
+
+    TemplateItemHolders d_templateItemHolders;
 };
 
 // -----------------------------------------------------------------------------
@@ -217,31 +348,95 @@ VPP_INLINE KShaderDataBlockImpl :: KShaderDataBlockImpl ( const PipelineLayoutBa
         d_hDevice,
         true,
         static_cast< std::uint32_t >( hLayout.getDescriptorSetCount() ),
-        hLayout.getDescriptorPoolSizes() );
+        hLayout.getDescriptorPoolSizes(),
+        hLayout.hasUpdateAfterBindSets() );
+
+    const DescriptorSetLayoutHandles& setLayouts = hLayout.getDescriptorSetLayoutHandles();
+    const std::vector< std::uint32_t >& variableCounts = hLayout.getVariableDescriptorCounts();
+
+    d_descriptorSets.resize ( setLayouts.size() );
+
+    // Push descriptor sets are not allocated. Their slots in d_descriptorSets
+    // stay null and are skipped by cmdBind().
+
+    DescriptorSetLayoutHandles pooledLayouts;
+    std::vector< std::uint32_t > pooledVariableCounts;
+    bool bVariableCounts = false;
+
+    for ( std::uint32_t iSet = 0; iSet != setLayouts.size(); ++iSet )
+        if ( ! hLayout.isPushDescriptorSet ( iSet ) )
+        {
+            pooledLayouts.push_back ( setLayouts [ iSet ] );
+            pooledVariableCounts.push_back ( variableCounts [ iSet ] );
+            bVariableCounts |= ( variableCounts [ iSet ] != 0 );
+        }
+
+    if ( pooledLayouts.empty() )
+    {
+        d_result = VK_SUCCESS;
+        return;
+    }
+
+    // Variable-sized bindings are allocated with their declared (maximal)
+    // size, which the pool has been sized for.
+
+    VkDescriptorSetVariableDescriptorCountAllocateInfoEXT variableCountInfo;
+    variableCountInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT;
+    variableCountInfo.pNext = 0;
+    variableCountInfo.descriptorSetCount = static_cast< std::uint32_t >( pooledVariableCounts.size() );
+    variableCountInfo.pDescriptorCounts = & pooledVariableCounts [ 0 ];
 
     VkDescriptorSetAllocateInfo descriptorSetAllocateInfo;
     descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    descriptorSetAllocateInfo.pNext = 0;
+    descriptorSetAllocateInfo.pNext = ( bVariableCounts ? & variableCountInfo : 0 );
     descriptorSetAllocateInfo.descriptorPool = d_descriptorPool.handle();
     descriptorSetAllocateInfo.descriptorSetCount = 
-        static_cast< std::uint32_t >( hLayout.getDescriptorSetLayoutHandles().size() );
-    descriptorSetAllocateInfo.pSetLayouts = & hLayout.getDescriptorSetLayoutHandles() [ 0 ];
+        static_cast< std::uint32_t >( pooledLayouts.size() );
+    descriptorSetAllocateInfo.pSetLayouts = & pooledLayouts [ 0 ];
+
+    DescriptorSets pooledSets ( pooledLayouts.size() );
 
-    d_descriptorSets.resize ( descriptorSetAllocateInfo.descriptorSetCount );
+    {
+        std::lock_guard< std::mutex > lock ( *d_descriptorPool.mutex() );
+
+        d_result = ::vkAllocateDescriptorSets (
+            d_hDevice.handle(), & descriptorSetAllocateInfo, & pooledSets [ 0 ] );
+    }
 
-    d_result = ::vkAllocateDescriptorSets (
-        d_hDevice.handle(), & descriptorSetAllocateInfo, & d_descriptorSets [ 0 ] );
+    size_t iPooledSet = 0;
+
+    for ( std::uint32_t iSet = 0; iSet != setLayouts.size(); ++iSet )
+        if ( ! hLayout.isPushDescriptorSet ( iSet ) )
+            d_descriptorSets [ iSet ] = pooledSets [ iPooledSet++ ];
 }
 
 // -----------------------------------------------------------------------------
 
 VPP_INLINE KShaderDataBlockImpl :: ~KShaderDataBlockImpl()
 {
-    if ( d_result == VK_SUCCESS )
-        ::vkFreeDescriptorSets (
-            d_hDevice.handle(), d_descriptorPool.handle(),
-            static_cast< std::uint32_t >( d_descriptorSets.size() ),
-            & d_descriptorSets [ 0 ] );
+    if ( d_result != VK_SUCCESS )
+        return;
+
+    DescriptorSets allocatedSets;
+    allocatedSets.reserve ( d_descriptorSets.size() );
+
+    for ( VkDescriptorSet hSet : d_descriptorSets )
+        if ( hSet != VK_NULL_HANDLE )
+            allocatedSets.push_back ( hSet );
+
+    if ( ! allocatedSets.empty() )
+    {
+        const VkDevice hDevice = d_hDevice.handle();
+        const VkDescriptorPool hPool = d_descriptorPool.handle();
+        const std::shared_ptr< std::mutex > pMutex = d_descriptorPool.mutex();
+
+        d_hDevice.destructionQueue().enqueue ( [ hDevice, hPool, pMutex, allocatedSets ]() {
+            std::lock_guard< std::mutex > lock ( *pMutex );
+            ::vkFreeDescriptorSets (
+                hDevice, hPool,
+                static_cast< std::uint32_t >( allocatedSets.size() ),
+                & allocatedSets [ 0 ] ); } );
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -275,6 +470,13 @@ VPP_INLINE const Device& ShaderDataBlock :: device() const
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE const PipelineLayoutBase& ShaderDataBlock :: layout() const
+{
+    return get()->d_layout;
+}
+
+// -----------------------------------------------------------------------------
+
 template< class ValueT >
 void ShaderDataBlock :: setBoundItem (
     std::uint32_t id, const ValueT& value )
@@ -295,6 +497,26 @@ void ShaderDataBlock :: setBoundItem (
     }
 }
 
+// -----------------------------------------------------------------------------
+
+// Resources retained by updates made through a shared template. The block
+// usually sees only a few templates, so linear search is enough.
+
+VPP_INLINE detail::KDescriptorItemHolder* ShaderDataBlock :: templateItemHolders (
+    const detail::KDescriptorUpdateTemplate* pTemplate )
+{
+    KShaderDataBlockImpl::TemplateItemHolders& holders = get()->d_templateItemHolders;
+
+    for ( auto& iHolders : holders )
+        if ( iHolders.first == pTemplate )
+            return iHolders.second.data();
+
+    holders.emplace_back (
+        pTemplate, std::vector< detail::KDescriptorItemHolder >( pTemplate->itemCount() ) );
+
+    return holders.back().second.data();
+}
+
 // -----------------------------------------------------------------------------
 namespace detail {
 // -----------------------------------------------------------------------------
@@ -323,6 +545,9 @@ public:
         std::uint32_t doffset,
         std::uint32_t count )
     {
+        checkNotPushDescriptorSet ( sset );
+        checkNotPushDescriptorSet ( dset );
+
         VkCopyDescriptorSet& currentSet = d_copiers [ d_currentCopier++ ];
         currentSet.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
         currentSet.pNext = 0;
@@ -375,6 +600,8 @@ public:
         std::uint32_t binding,
         const ValueT& value )
     {
+        checkNotPushDescriptorSet ( set );
+
         d_block.setBoundItem ( id, value );
 
         VkWriteDescriptorSet& currentSet = d_writers [ d_currentWriter++ ];
@@ -411,6 +638,18 @@ public:
             COPIER_COUNT, d_copiers );
     }
 
+private:
+    // Push descriptor sets have no VkDescriptorSet to write into. They are
+    // updated while recording commands instead.
+
+    VPP_INLINE void checkNotPushDescriptorSet ( std::uint32_t set ) const
+    {
+        if ( d_block.layout().isPushDescriptorSet ( set ) )
+            throw XUsageError (
+                "Descriptor set is configured for push descriptors. "
+                "Use PipelineLayout::cmdPushDescriptors() instead of ShaderDataBlock::update()." );
+    }
+
 private:
     ShaderDataBlock& d_block;
 
@@ -428,6 +667,198 @@ private:
     size_t d_currentTexelBufferView;
 };
 
+// -----------------------------------------------------------------------------
+
+template< class ValueT >
+VPP_INLINE void setItemHolders ( KDescriptorItemHolder* pHolders, const ValueT& value )
+{
+    *pHolders = value;
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ValueT >
+VPP_INLINE void setItemHolders (
+    KDescriptorItemHolder* pHolders, const TUpdateMultipleDescriptors< ValueT >& values )
+{
+    for ( size_t i = 0; i != values.size(); ++i )
+        pHolders [ i ] = values [ i ];
+}
+
+// -----------------------------------------------------------------------------
+
+class KUpdateTemplateCompiler
+{
+public:
+    VPP_INLINE KUpdateTemplateCompiler ( KDescriptorUpdateTemplate* pTemplate ) :
+        d_pTemplate ( pTemplate )
+    {
+    }
+
+    VPP_INLINE void copy (
+        std::uint32_t, std::uint32_t, std::uint32_t,
+        std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t )
+    {
+    }
+
+    template< VkDescriptorType TYPE, typename ViewT, typename ValueT >
+    VPP_INLINE void write (
+        std::uint32_t id,
+        std::uint32_t set,
+        std::uint32_t binding,
+        const ValueT& value )
+    {
+        typedef typename TDescriptorTypeTraits< TYPE, ViewT >::update_dest_type dest_type;
+
+        d_pTemplate->addEntry (
+            TYPE, set, binding,
+            getValueStartIndex ( value ),
+            static_cast< std::uint32_t >( getValueCount ( value ) ),
+            static_cast< std::uint32_t >( sizeof ( dest_type ) ) );
+    }
+
+private:
+    KDescriptorUpdateTemplate* d_pTemplate;
+};
+
+// -----------------------------------------------------------------------------
+
+// Fast path of ShaderDataBlock::update(). The assignment list is compiled
+// into descriptor update templates on first use with a pipeline layout, and
+// the templates are reused by all data blocks of that layout. Updates pack
+// descriptor data into a stack buffer and issue a single template update
+// per descriptor set. Templates are selected by the list type and then by
+// target sets and bindings, as the same list type can be assigned to
+// different bindings. Falls back to the generic path (returns false) for
+// lists containing copies, when array ranges differ from the compiled ones,
+// or when the device does not support update templates.
+
+template< class AssignmentListT >
+class TTemplateUpdater
+{
+public:
+    static const size_t ASSIGNER_COUNT = AssignmentListT::ASSIGNER_COUNT;
+    static const size_t COPIER_COUNT = AssignmentListT::COPIER_COUNT;
+
+    // Room for several array elements per assignment. All descriptor info
+    // structures have size being a multiple of 8 bytes.
+
+    static const size_t PAYLOAD_WORDS =
+        ( ASSIGNER_COUNT * 4 * sizeof ( VkDescriptorImageInfo ) + 7 ) / 8;
+
+    static const size_t PAYLOAD_CAPACITY = PAYLOAD_WORDS * 8;
+
+    static bool update ( ShaderDataBlock& block, const AssignmentListT& list );
+
+    VPP_INLINE TTemplateUpdater (
+        const KDescriptorUpdateTemplate* pTemplate,
+        KDescriptorItemHolder* pItemHolders ) :
+            d_pTemplate ( pTemplate ),
+            d_pItemHolders ( pItemHolders ),
+            d_currentEntry ( 0 ),
+            d_bSameBindings ( true ),
+            d_bMatching ( true )
+    {
+    }
+
+    VPP_INLINE void copy (
+        std::uint32_t, std::uint32_t, std::uint32_t,
+        std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t )
+    {
+        d_bMatching = false;
+    }
+
+    template< VkDescriptorType TYPE, typename ViewT, typename ValueT >
+    VPP_INLINE void write (
+        std::uint32_t id,
+        std::uint32_t set,
+        std::uint32_t binding,
+        const ValueT& value )
+    {
+        typedef TDescriptorTypeTraits< TYPE, ViewT > type_traits;
+        typedef typename type_traits::update_dest_type dest_type;
+
+        const KDescriptorUpdateTemplate::SEntry& entry =
+            d_pTemplate->entry ( d_currentEntry++ );
+
+        if ( entry.d_set != set || entry.d_entry.dstBinding != binding )
+            d_bSameBindings = false;
+
+        if ( ! d_bSameBindings
+             || ! d_bMatching
+             || entry.d_entry.dstArrayElement != getValueStartIndex ( value )
+             || entry.d_entry.descriptorCount != getValueCount ( value ) )
+        {
+            d_bMatching = false;
+            return;
+        }
+
+        unsigned char* pPayload = reinterpret_cast< unsigned char* >( d_payload );
+
+        type_traits::update (
+            reinterpret_cast< dest_type* >( pPayload + entry.d_entry.offset ), value );
+
+        setItemHolders ( d_pItemHolders + entry.d_firstItem, value );
+    }
+
+private:
+    const KDescriptorUpdateTemplate* d_pTemplate;
+    KDescriptorItemHolder* d_pItemHolders;
+    size_t d_currentEntry;
+    bool d_bSameBindings;
+    bool d_bMatching;
+    std::uint64_t d_payload [ PAYLOAD_WORDS ];
+};
+
+// -----------------------------------------------------------------------------
+
+template< class AssignmentListT >
+bool TTemplateUpdater< AssignmentListT > :: update (
+    ShaderDataBlock& block, const AssignmentListT& list )
+{
+    if ( COPIER_COUNT != 0 )
+        return false;
+
+    // Address of this variable identifies the assignment list type.
+    static const char s_key = 0;
+
+    const PipelineLayoutBase& hLayout = block.layout();
+    KDescriptorUpdateTemplate* pTemplate = 0;
+
+    for (;;)
+    {
+        pTemplate = hLayout.findUpdateTemplate ( & s_key, pTemplate );
+
+        if ( ! pTemplate )
+        {
+            const std::shared_ptr< KDescriptorUpdateTemplate > pNewTemplate (
+                new KDescriptorUpdateTemplate ( hLayout.device() ) );
+
+            KUpdateTemplateCompiler compiler ( pNewTemplate.get() );
+            list.for_each ( compiler );
+
+            pNewTemplate->create ( hLayout, PAYLOAD_CAPACITY );
+            pTemplate = hLayout.addUpdateTemplate ( & s_key, pNewTemplate );
+        }
+
+        if ( ! pTemplate->valid() )
+            return false;
+
+        TTemplateUpdater< AssignmentListT > updater (
+            pTemplate, block.templateItemHolders ( pTemplate ) );
+        list.for_each ( updater );
+
+        if ( ! updater.d_bSameBindings )
+            continue;
+
+        if ( ! updater.d_bMatching )
+            return false;
+
+        pTemplate->apply ( block, updater.d_payload );
+        return true;
+    }
+}
+
 // -----------------------------------------------------------------------------
 } // namespace detail
 // -----------------------------------------------------------------------------
@@ -435,8 +866,11 @@ private:
 template< class AssignmentListT >
 VPP_INLINE void ShaderDataBlock :: update ( const AssignmentListT& list )
 {
-    detail::TUpdater< AssignmentListT > updater ( *this, list );
-    updater.update ( list );
+    if ( ! detail::TTemplateUpdater< AssignmentListT >::update ( *this, list ) )
+    {
+        detail::TUpdater< AssignmentListT > updater ( *this, list );
+        updater.update ( list );
+    }
 
     get()->d_layout.config().bindDebugProbes ( *this );
 }
@@ -449,15 +883,51 @@ VPP_INLINE void ShaderDataBlock :: cmdBind ( CommandBuffer hCommandBuffer ) cons
         hCommandBuffer.handle()
         : RenderingCommandContext::getCommandBufferHandle();
 
-    ::vkCmdBindDescriptorSets (
-        hCmdBuffer,
-        ( get()->d_layout.isComputePipeline() ?
-            VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS ),
-        get()->d_layout.handle(), 0,
-        static_cast< std::uint32_t >( get()->d_descriptorSets.size() ),
-        & get()->d_descriptorSets [ 0 ],
-        0, 0
-    );
+    const VkPipelineBindPoint bindPoint = get()->d_layout.isComputePipeline() ?
+        VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+    const DescriptorSets& sets = get()->d_descriptorSets;
+
+    if ( ! get()->d_layout.config().hasPushDescriptorSets() )
+    {
+        ::vkCmdBindDescriptorSets (
+            hCmdBuffer, bindPoint,
+            get()->d_layout.handle(), 0,
+            static_cast< std::uint32_t >( sets.size() ),
+            & sets [ 0 ],
+            0, 0
+        );
+
+        return;
+    }
+
+    // Bind consecutive runs of pooled sets, skipping push descriptor sets.
+
+    const std::uint32_t nSets = static_cast< std::uint32_t >( sets.size() );
+    std::uint32_t iFirst = 0;
+
+    while ( iFirst != nSets )
+    {
+        if ( sets [ iFirst ] == VK_NULL_HANDLE )
+        {
+            ++iFirst;
+            continue;
+        }
+
+        std::uint32_t iEnd = iFirst + 1;
+
+        while ( iEnd != nSets && sets [ iEnd ] != VK_NULL_HANDLE )
+            ++iEnd;
+
+        ::vkCmdBindDescriptorSets (
+            hCmdBuffer, bindPoint,
+            get()->d_layout.handle(), iFirst,
+            iEnd - iFirst, & sets [ iFirst ],
+            0, 0
+        );
+
+        iFirst = iEnd;
+    }
 }
 
 // -----------------------------------------------------------------------------
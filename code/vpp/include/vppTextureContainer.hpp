@@ -0,0 +1,268 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPTEXTURECONTAINER_HPP
+#define INC_VPPTEXTURECONTAINER_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPMAPPEDFILE_HPP
+#include "vppMappedFile.hpp"
+#endif
+
+#ifndef INC_VPPIMAGEOPERATIONS_HPP
+#include "vppImageOperations.hpp"
+#endif
+
+#ifndef INC_VPPEXCEPTIONS_HPP
+#include "vppExceptions.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class XInvalidTextureFile : public XRuntimeError
+{
+public:
+    XInvalidTextureFile ( const std::string& msg );
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE XInvalidTextureFile :: XInvalidTextureFile ( const std::string& msg ) :
+    XRuntimeError ( msg.c_str() )
+{
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+// Texture in KTX2 or DDS container format, kept memory-mapped. Block
+// compressed formats (BC, ETC2/EAC, ASTC LDR) are passed to the device as
+// they are, without any decoding on the host. The only copy made is from
+// the mapped file to the staging buffer, with all levels and layers
+// transferred in a single batch of regions.
+//
+// Supercompressed KTX2 files (Basis, zstd) are not supported.
+
+class TextureContainer
+{
+public:
+    enum EContainerType
+    {
+        CONTAINER_KTX2,
+        CONTAINER_DDS
+    };
+
+    VPP_DLLAPI TextureContainer ( const std::string& fileName );
+
+    EContainerType containerType() const;
+    VkFormat format() const;
+    const VkExtent3D& extent() const;
+    std::uint32_t mipLevels() const;
+    std::uint32_t arrayLayers() const;
+    std::uint32_t faces() const;
+    bool isCubeMap() const;
+
+    // Size of the data for all levels, as laid out by copyLevels().
+    VkDeviceSize dataSize() const;
+
+    // Copies all levels to the destination, level after level, each level
+    // containing all layers and faces. Uses streaming stores, suitable for
+    // write-combined memory.
+    VPP_DLLAPI void copyLevels ( unsigned char* pDest ) const;
+
+    // Buffer to image copy regions for data laid out by copyLevels(),
+    // starting at specified buffer offset. One region per mip level.
+    VPP_DLLAPI void defineRegions (
+        std::vector< VkBufferImageCopy >* pRegions,
+        VkDeviceSize bufferOffset = 0 ) const;
+
+    // Checks if the device is able to sample from images in the format of
+    // this texture. Throws XMissingFeature for compressed formats whose
+    // feature has not been enabled.
+    VPP_DLLAPI void checkSupport ( const Device& hDevice ) const;
+
+    // Checks if an image with specified attributes can hold all levels,
+    // layers and faces of this texture. Throws XUsageError otherwise.
+    VPP_DLLAPI void checkImageType (
+        bool bMipMapped, bool bArrayed, bool bCubeCompatible ) const;
+
+    // Creates the image, uploads all levels and waits for completion.
+    template< class ImageT >
+    ImageT createImage (
+        const Device& hDevice,
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ) const;
+
+    struct SBlockInfo
+    {
+        std::uint32_t d_width;
+        std::uint32_t d_height;
+        std::uint32_t d_bytes;
+    };
+
+    // Returns false for formats not known to the loader.
+    static VPP_DLLAPI bool getBlockInfo ( VkFormat format, SBlockInfo* pInfo );
+
+private:
+    struct SLevel
+    {
+        // Byte ranges of each layer/face in the mapped file. For KTX2 these
+        // are contiguous, for DDS they are scattered.
+        std::vector< std::pair< size_t, size_t > > d_chunks;
+        VkDeviceSize d_size;
+        VkDeviceSize d_destOffset;
+    };
+
+    void parseKTX2();
+    void parseDDS();
+    void validateHeader ( const char* pErrorMessage ) const;
+    void computeDestOffsets();
+    VkDeviceSize computeLevelSize ( std::uint32_t level ) const;
+
+private:
+    MappedFile d_file;
+    EContainerType d_containerType;
+    VkFormat d_format;
+    VkExtent3D d_extent;
+    std::uint32_t d_mipLevels;
+    std::uint32_t d_arrayLayers;
+    std::uint32_t d_faces;
+    SBlockInfo d_blockInfo;
+    std::vector< SLevel > d_levels;
+    VkDeviceSize d_dataSize;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE TextureContainer::EContainerType TextureContainer :: containerType() const
+{
+    return d_containerType;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE VkFormat TextureContainer :: format() const
+{
+    return d_format;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const VkExtent3D& TextureContainer :: extent() const
+{
+    return d_extent;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t TextureContainer :: mipLevels() const
+{
+    return d_mipLevels;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t TextureContainer :: arrayLayers() const
+{
+    return d_arrayLayers;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE std::uint32_t TextureContainer :: faces() const
+{
+    return d_faces;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE bool TextureContainer :: isCubeMap() const
+{
+    return d_faces == 6;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE VkDeviceSize TextureContainer :: dataSize() const
+{
+    return d_dataSize;
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ImageT >
+ImageT TextureContainer :: createImage (
+    const Device& hDevice, VkImageLayout finalLayout ) const
+{
+    typedef typename ImageT::attributes_type attributes_type;
+
+    static_assert (
+        attributes_type::isUsageTransferDst,
+        "Loaded image must have TRANSFER_DST usage bit set" );
+
+    checkImageType (
+        attributes_type::isMipMapped,
+        attributes_type::isArrayed,
+        ( attributes_type::flags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT ) != 0 );
+
+    checkSupport ( hDevice );
+
+    Buf sourceBuffer ( d_dataSize, Buf::SOURCE, hDevice );
+
+    MemoryBinding< Buf, MappableDeviceMemory > sourceMemory (
+        sourceBuffer, MemProfile::HOST_STATIC );
+
+    auto& memory = sourceMemory.memory();
+
+    if ( memory.map() != VK_SUCCESS )
+        throw XMemoryAllocationError();
+
+    copyLevels ( memory.beginMapped() );
+    memory.syncToDevice();
+    memory.unmap();
+
+    ImageT image (
+        d_format, d_extent, MemProfile::DEVICE_STATIC, hDevice,
+        d_mipLevels, d_arrayLayers * d_faces );
+
+    std::vector< VkBufferImageCopy > regions;
+    defineRegions ( & regions );
+
+    Fence loadFinished ( hDevice );
+    CopyImageToDevice imageDataCopier ( sourceMemory, image, regions, finalLayout );
+    imageDataCopier.execute ( Q_GRAPHICS, loadFinished );
+    loadFinished.wait();
+
+    return image;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPTEXTURECONTAINER_HPP
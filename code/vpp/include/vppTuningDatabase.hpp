@@ -0,0 +1,130 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPTUNINGDATABASE_HPP
+#define INC_VPPTUNINGDATABASE_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPPHYSICALDEVICE_HPP
+#include "vppPhysicalDevice.hpp"
+#endif
+
+#ifndef INC_VPPPIPELINECONFIG_HPP
+#include "vppPipelineConfig.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class TuningDatabaseImpl;
+
+// -----------------------------------------------------------------------------
+
+class TuningDatabase : public TSharedReference< TuningDatabaseImpl >
+{
+public:
+    TuningDatabase();
+    VPP_DLLAPI explicit TuningDatabase ( const std::string& fileName );
+
+    const std::string& fileName() const;
+
+    VPP_DLLAPI bool load();
+    VPP_DLLAPI bool save() const;
+
+    VPP_DLLAPI bool find (
+        const PhysicalDevice& hDevice,
+        const std::string& kernelKey,
+        SpecializationValues* pValues,
+        double* pTimeNs = 0 ) const;
+
+    VPP_DLLAPI void store (
+        const PhysicalDevice& hDevice,
+        const std::string& kernelKey,
+        const SpecializationValues& values,
+        double timeNs );
+
+    VPP_DLLAPI void remove (
+        const PhysicalDevice& hDevice,
+        const std::string& kernelKey );
+
+    VPP_DLLAPI static std::string deviceKey ( const PhysicalDevice& hDevice );
+};
+
+// -----------------------------------------------------------------------------
+
+class TuningDatabaseImpl : public TSharedObject< TuningDatabaseImpl >
+{
+public:
+    TuningDatabaseImpl ( const std::string& fileName );
+
+    VPP_INLINE bool compareObjects ( const TuningDatabaseImpl* pRHS ) const
+    {
+        return this < pRHS;
+    }
+
+private:
+    friend class TuningDatabase;
+
+    struct SEntry
+    {
+        SpecializationValues d_values;
+        double d_timeNs;
+    };
+
+    // Keyed by device UUID and kernel key, separated by a space.
+    typedef std::map< std::string, SEntry > Entries;
+
+    std::string d_fileName;
+    Entries d_entries;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE TuningDatabaseImpl :: TuningDatabaseImpl ( const std::string& fileName ) :
+    d_fileName ( fileName )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE TuningDatabase :: TuningDatabase()
+{
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const std::string& TuningDatabase :: fileName() const
+{
+    return get()->d_fileName;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPTUNINGDATABASE_HPP
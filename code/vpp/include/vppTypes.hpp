@@ -82,6 +82,10 @@ class BaseAttachment;
 class PipelineConfig;
 class PipelineLayoutBase;
 class PipelineCache;
+class MemoryBudget;
+class LayoutCache;
+class SamplerCache;
+class DestructionQueue;
 
 class RenderingOptions;
 
@@ -94,6 +98,7 @@ class QueryPool;
 class Event;
 class Barriers;
 class Pipeline;
+struct SFoldedDynamicState;
 
 class FrameImageView;
 class VertexBufferView;
@@ -274,6 +279,15 @@ struct SLocalGroupSize
     int z;
 };
 
+// Specialization constant IDs of local group size components.
+
+struct SLocalGroupSpecIds
+{
+    std::uint32_t x;
+    std::uint32_t y;
+    std::uint32_t z;
+};
+
 // -----------------------------------------------------------------------------
 
 static const VkPresentModeKHR QM_IMMEDIATE = VK_PRESENT_MODE_IMMEDIATE_KHR;
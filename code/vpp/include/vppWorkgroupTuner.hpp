@@ -0,0 +1,190 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INC_VPPWORKGROUPTUNER_HPP
+#define INC_VPPWORKGROUPTUNER_HPP
+
+// -----------------------------------------------------------------------------
+
+#ifndef INC_VPPTUNINGDATABASE_HPP
+#include "vppTuningDatabase.hpp"
+#endif
+
+#ifndef INC_VPPCOMPUTEPASS_HPP
+#include "vppComputePass.hpp"
+#endif
+
+#ifndef INC_VPPQUERYPOOL_HPP
+#include "vppQueryPool.hpp"
+#endif
+
+#ifndef INC_VPPLANGINTERFACE_HPP
+#include "vppLangInterface.hpp"
+#endif
+
+#ifndef INC_VPPEXCEPTIONS_HPP
+#include "vppExceptions.hpp"
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+class WorkgroupTuner
+{
+public:
+    typedef std::vector< SpecializationValues > Candidates;
+
+    // Records one representative dispatch. The pipeline is already bound;
+    // the callback binds its data and computes the grid size from the
+    // candidate's local size.
+    typedef std::function< void (
+        const SpecializationValues& candidate,
+        CommandBuffer hCmdBuffer ) > FDispatch;
+
+    VPP_DLLAPI WorkgroupTuner (
+        const Device& hDevice,
+        const TuningDatabase& hDatabase );
+
+    void setRepetitions ( std::uint32_t warmupCount, std::uint32_t measuredCount );
+
+    VPP_DLLAPI void addCandidate ( const SpecializationValues& values );
+
+    VPP_DLLAPI void addLocalSizes (
+        const specConst< int >& sizeX,
+        const specConst< int >& sizeY,
+        const specConst< int >& sizeZ,
+        std::uint32_t dimensions,
+        std::uint32_t minInvocations = 32,
+        std::uint32_t maxInvocations = 1024 );
+
+    template< class SpecConstT >
+    void addValues (
+        const SpecConstT& constant,
+        const std::vector< typename SpecConstT::value_type >& values );
+
+    const Candidates& candidates() const;
+    const std::vector< double >& timings() const;
+
+    template< class DefinitionT >
+    SpecializationValues tune (
+        const std::string& kernelKey,
+        const ComputePipelineLayout< DefinitionT >& layout,
+        const FDispatch& dispatch,
+        bool bForce = false );
+
+private:
+    VPP_DLLAPI void expand ( const Candidates& variants );
+
+    VPP_DLLAPI SpecializationValues measure (
+        const std::string& kernelKey,
+        const ComputePass& hPass,
+        const FDispatch& dispatch );
+
+private:
+    Device d_hDevice;
+    TuningDatabase d_hDatabase;
+
+    Candidates d_candidates;
+    std::vector< double > d_timings;
+
+    std::uint32_t d_warmupCount;
+    std::uint32_t d_measuredCount;
+};
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE void WorkgroupTuner :: setRepetitions (
+    std::uint32_t warmupCount, std::uint32_t measuredCount )
+{
+    d_warmupCount = warmupCount;
+    d_measuredCount = std::max ( measuredCount, 1u );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class SpecConstT >
+VPP_INLINE void WorkgroupTuner :: addValues (
+    const SpecConstT& constant,
+    const std::vector< typename SpecConstT::value_type >& values )
+{
+    Candidates variants ( values.size() );
+
+    for ( size_t i = 0; i != values.size(); ++i )
+        variants [ i ].set ( constant, values [ i ] );
+
+    expand ( variants );
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const WorkgroupTuner::Candidates& WorkgroupTuner :: candidates() const
+{
+    return d_candidates;
+}
+
+// -----------------------------------------------------------------------------
+
+VPP_INLINE const std::vector< double >& WorkgroupTuner :: timings() const
+{
+    return d_timings;
+}
+
+// -----------------------------------------------------------------------------
+
+template< class DefinitionT >
+VPP_INLINE SpecializationValues WorkgroupTuner :: tune (
+    const std::string& kernelKey,
+    const ComputePipelineLayout< DefinitionT >& layout,
+    const FDispatch& dispatch,
+    bool bForce )
+{
+    SpecializationValues result;
+
+    if ( ! bForce && d_hDatabase.find ( d_hDevice.physical(), kernelKey, & result ) )
+        return result;
+
+    if ( d_candidates.empty() )
+        throw XUsageError ( "WorkgroupTuner::tune called without candidates." );
+
+    // All variants share the shader module, so one pass compiles them
+    // in a single vkCreateComputePipelines call.
+
+    ComputePass hPass ( d_hDevice );
+
+    for ( const auto& iCandidate : d_candidates )
+        hPass.addPipeline ( layout, iCandidate );
+
+    hPass.createPipelines();
+
+    return measure ( kernelKey, hPass, dispatch );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPWORKGROUPTUNER_HPP
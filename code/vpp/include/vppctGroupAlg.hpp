@@ -41,6 +41,18 @@
 #include "vppInternalUtils.hpp"
 #endif
 
+#ifndef INC_VPPLANGFUNCTIONS_HPP
+#include "vppLangFunctions.hpp"
+#endif
+
+#ifndef INC_VPPLANGCONVERSIONS_HPP
+#include "vppLangConversions.hpp"
+#endif
+
+#ifndef INC_VPPEXCEPTIONS_HPP
+#include "vppExceptions.hpp"
+#endif
+
 // -----------------------------------------------------------------------------
 namespace vpp {
 // -----------------------------------------------------------------------------
@@ -1236,6 +1248,392 @@ VPP_INLINE Int UpperBound (
     return detail::BinarySearch ( lvt, val, fFunctor, tmpArr, inv, true );
 }
 
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+namespace detail {
+// -----------------------------------------------------------------------------
+
+// Tiled kernels load and accumulate in Float. Items of other types (e.g. Half)
+// are converted when loaded to shared memory and when stored.
+
+template< class ItemT >
+struct TAccumulatorConversion
+{
+    static VPP_INLINE Float load ( const ItemT& value )
+    {
+        return StaticCast< Float >( value );
+    }
+
+    static VPP_INLINE ItemT store ( const Float& value )
+    {
+        return StaticCast< ItemT >( value );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TAccumulatorConversion< Float >
+{
+    static VPP_INLINE Float load ( const Float& value )
+    {
+        return value;
+    }
+
+    static VPP_INLINE Float store ( const Float& value )
+    {
+        return value;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template< class ArrayT, class ImageT >
+void LoadClampedImageTile (
+    const ImageT& inImage, const Int& inStart,
+    const Int& height, const Int& width,
+    const Int& originRow, const Int& originCol,
+    const ArrayT& tile, const GroupInvocation& inv )
+{
+    // Pixels outside the image are replaced by the nearest edge pixel.
+
+    typedef TAccumulatorConversion< typename ImageT::item_type > conversion;
+
+    const Int lastRow = height - 1;
+    const Int lastCol = width - 1;
+
+    TIndexGenerator< 2, ArrayT > indexGenerator;
+
+    indexGenerator.Apply (
+        [ & ]( const Int& row, const Int& col )
+        {
+            const Int sourceRow = Max ( Min ( originRow + row, lastRow ), Int ( 0 ) );
+            const Int sourceCol = Max ( Min ( originCol + col, lastCol ), Int ( 0 ) );
+            tile ( row, col ) = conversion::load ( inImage [ inStart + sourceRow * width + sourceCol ] );
+        },
+        tile.rows(), tile.cols(), inv
+    );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ArrayT, class SourceArrayT >
+void LoadWeights (
+    const SourceArrayT& inWeights, const Int& weightsStart,
+    const ArrayT& weights, const GroupInvocation& inv )
+{
+    typedef TAccumulatorConversion< typename SourceArrayT::item_type > conversion;
+
+    TIndexGenerator< 1, ArrayT > indexGenerator;
+
+    indexGenerator.Apply (
+        [ & ]( const Int& i )
+        {
+            weights [ i ] = conversion::load ( inWeights [ weightsStart + i ] );
+        },
+        weights.size(), inv
+    );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace detail
+// -----------------------------------------------------------------------------
+
+template< int TILE_M, int TILE_N, int TILE_K, class MatrixAT, class MatrixBT, class MatrixCT >
+void MatrixMultiply (
+    const MatrixAT& inA, const Int& aStart,
+    const MatrixBT& inB, const Int& bStart,
+    const MatrixCT& outC, const Int& cStart,
+    const Int& m, const Int& n, const Int& k,
+    const Int& tileRow, const Int& tileCol,
+    const GroupInvocation& inv )
+{
+    /*
+        Computes the TILE_M x TILE_N block of C = A * B starting at (tileRow,
+        tileCol). Matrices are dense, row-major: A is m x k, B is k x n and C is
+        m x n, beginning at specified indices of their buffers. Slabs of A and B
+        TILE_K wide are staged in shared memory, so each item is read from the
+        buffer once per workgroup instead of once per product.
+
+        Each thread accumulates a column of TILE_M / ( localCount / TILE_N ) items
+        of the block. Therefore localCount must be a multiple of TILE_N and
+        TILE_M a multiple of localCount / TILE_N.
+
+        Items may be of Float or Half type. The latter requires shaderFloat16
+        and storageBuffer16BitAccess device features. Accumulation is always
+        done in Float.
+
+        Shared memory used: ( TILE_M + TILE_N ) * TILE_K floats.
+    */
+
+    static_assert ( TILE_M > 0 && TILE_N > 0 && TILE_K > 0, "Tile sizes must be positive" );
+
+    typedef detail::TAccumulatorConversion< typename MatrixAT::item_type > conversionA;
+    typedef detail::TAccumulatorConversion< typename MatrixBT::item_type > conversionB;
+    typedef detail::TAccumulatorConversion< typename MatrixCT::item_type > conversionC;
+
+    const int nLocalThreads = inv.localCount();
+
+    if ( nLocalThreads % TILE_N != 0 || TILE_M % ( nLocalThreads / TILE_N ) != 0 )
+        throw XUsageError ( "MatrixMultiply: workgroup size does not match the tile size." );
+
+    const int rowStep = nLocalThreads / TILE_N;
+    const int nCells = TILE_M / rowStep;
+
+    const Int nThisThread = inv.LocalId();
+    const Int threadRow = detail::FastDivision ( nThisThread, TILE_N, nLocalThreads );
+    const Int threadCol = nThisThread - threadRow * TILE_N;
+
+    const Float zero = 0.0f;
+
+    WArray2< Float > tileA ( TILE_M, TILE_K );
+    WArray2< Float > tileB ( TILE_K, TILE_N );
+    VArray< Float > accumulators ( nCells );
+
+    for ( int iCell = 0; iCell != nCells; ++iCell )
+        accumulators [ iCell ] = zero;
+
+    detail::TIndexGenerator< 2, WArray2< Float > > indexGenerator;
+
+    VInt slab;
+
+    For ( slab, 0, k, TILE_K );
+    {
+        const Int slabStart = slab;
+
+        indexGenerator.Apply (
+            [ & ]( const Int& row, const Int& col )
+            {
+                const Int sourceRow = tileRow + row;
+                const Int sourceCol = slabStart + col;
+
+                If ( sourceRow < m && sourceCol < k );
+                    tileA ( row, col ) = conversionA::load ( inA [ aStart + sourceRow * k + sourceCol ] );
+                Else();
+                    tileA ( row, col ) = zero;
+                Fi();
+            },
+            TILE_M, TILE_K, inv
+        );
+
+        indexGenerator.Apply (
+            [ & ]( const Int& row, const Int& col )
+            {
+                const Int sourceRow = slabStart + row;
+                const Int sourceCol = tileCol + col;
+
+                If ( sourceRow < k && sourceCol < n );
+                    tileB ( row, col ) = conversionB::load ( inB [ bStart + sourceRow * n + sourceCol ] );
+                Else();
+                    tileB ( row, col ) = zero;
+                Fi();
+            },
+            TILE_K, TILE_N, inv
+        );
+
+        for ( int i = 0; i != TILE_K; ++i )
+        {
+            const Float b = tileB ( i, threadCol );
+
+            for ( int iCell = 0; iCell != nCells; ++iCell )
+            {
+                const Float a = tileA ( threadRow + iCell * rowStep, i );
+                const Float sum = accumulators [ iCell ];
+                accumulators [ iCell ] = Fma ( a, b, sum );
+            }
+        }
+
+        // Next slab overwrites the tiles.
+        WorkgroupBarrier();
+    }
+    Rof();
+
+    const Int targetCol = tileCol + threadCol;
+
+    for ( int iCell = 0; iCell != nCells; ++iCell )
+    {
+        const Int targetRow = tileRow + threadRow + iCell * rowStep;
+
+        If ( targetRow < m && targetCol < n );
+            outC [ cStart + targetRow * n + targetCol ] = conversionC::store ( accumulators [ iCell ] );
+        Fi();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+template< int TILE_M, int TILE_N, int TILE_K, class MatrixAT, class MatrixBT, class MatrixCT >
+VPP_INLINE void BatchedMatrixMultiply (
+    const MatrixAT& inA, const MatrixBT& inB, const MatrixCT& outC,
+    const Int& m, const Int& n, const Int& k, const Int& batchIndex,
+    const Int& tileRow, const Int& tileCol,
+    const GroupInvocation& inv )
+{
+    // Matrices of consecutive batch items are packed one after another.
+
+    MatrixMultiply< TILE_M, TILE_N, TILE_K >(
+        inA, batchIndex * m * k,
+        inB, batchIndex * k * n,
+        outC, batchIndex * m * n,
+        m, n, k, tileRow, tileCol, inv );
+}
+
+// -----------------------------------------------------------------------------
+
+template< int TILE_H, int TILE_W, int KERNEL_H, int KERNEL_W,
+          class ImageT, class WeightsT, class TargetImageT >
+void Convolve2D (
+    const ImageT& inImage, const Int& inStart,
+    const WeightsT& inWeights, const Int& weightsStart,
+    const TargetImageT& outImage, const Int& outStart,
+    const Int& height, const Int& width,
+    const Int& tileRow, const Int& tileCol,
+    const GroupInvocation& inv )
+{
+    /*
+        Filters the TILE_H x TILE_W block of a single channel, row-major image
+        starting at (tileRow, tileCol) with KERNEL_H x KERNEL_W weights (row-major).
+        The kernel is anchored at its center ( KERNEL_H / 2, KERNEL_W / 2 ) and
+        applied without flipping. Pixels outside the image are clamped to edge.
+        The output image has the same size as the input one.
+
+        Shared memory used:
+        ( TILE_H + KERNEL_H - 1 ) * ( TILE_W + KERNEL_W - 1 ) + KERNEL_H * KERNEL_W
+        floats.
+    */
+
+    static_assert ( TILE_H > 0 && TILE_W > 0 && KERNEL_H > 0 && KERNEL_W > 0, "Sizes must be positive" );
+
+    typedef detail::TAccumulatorConversion< typename TargetImageT::item_type > conversion;
+
+    WArray2< Float > tile ( TILE_H + KERNEL_H - 1, TILE_W + KERNEL_W - 1 );
+    WArray< Float > weights ( KERNEL_H * KERNEL_W );
+
+    detail::LoadClampedImageTile (
+        inImage, inStart, height, width,
+        tileRow - KERNEL_H / 2, tileCol - KERNEL_W / 2, tile, inv );
+
+    detail::LoadWeights ( inWeights, weightsStart, weights, inv );
+
+    VFloat sum;
+
+    detail::TIndexGenerator< 2, WArray2< Float > > indexGenerator;
+
+    indexGenerator.Apply (
+        [ & ]( const Int& row, const Int& col )
+        {
+            const Int targetRow = tileRow + row;
+            const Int targetCol = tileCol + col;
+
+            If ( targetRow < height && targetCol < width );
+            {
+                sum = 0.0f;
+
+                for ( int i = 0; i != KERNEL_H; ++i )
+                    for ( int j = 0; j != KERNEL_W; ++j )
+                    {
+                        const Float pixel = tile ( row + i, col + j );
+                        const Float weight = weights [ i * KERNEL_W + j ];
+                        sum = Fma ( pixel, weight, sum );
+                    }
+
+                outImage [ outStart + targetRow * width + targetCol ] = conversion::store ( sum );
+            }
+            Fi();
+        },
+        TILE_H, TILE_W, inv
+    );
+}
+
+// -----------------------------------------------------------------------------
+
+template< int TILE_H, int TILE_W, int KERNEL_H, int KERNEL_W,
+          class ImageT, class WeightsT, class TargetImageT >
+void ConvolveSeparable2D (
+    const ImageT& inImage, const Int& inStart,
+    const WeightsT& inWeights, const Int& weightsStart,
+    const TargetImageT& outImage, const Int& outStart,
+    const Int& height, const Int& width,
+    const Int& tileRow, const Int& tileCol,
+    const GroupInvocation& inv )
+{
+    /*
+        Same as Convolve2D, but for a kernel being the outer product of a column
+        and a row vector. Weights consist of KERNEL_W row (horizontal) weights
+        followed by KERNEL_H column (vertical) weights. The horizontal pass is
+        done for the whole halo, keeping intermediate results in shared memory,
+        then the vertical pass produces the output.
+
+        Cost per pixel is KERNEL_H + KERNEL_W products instead of
+        KERNEL_H * KERNEL_W.
+
+        Shared memory used:
+        ( TILE_H + KERNEL_H - 1 ) * ( 2 * TILE_W + KERNEL_W - 1 ) + KERNEL_H + KERNEL_W
+        floats.
+    */
+
+    static_assert ( TILE_H > 0 && TILE_W > 0 && KERNEL_H > 0 && KERNEL_W > 0, "Sizes must be positive" );
+
+    typedef detail::TAccumulatorConversion< typename TargetImageT::item_type > conversion;
+
+    const int haloRows = TILE_H + KERNEL_H - 1;
+
+    WArray2< Float > tile ( haloRows, TILE_W + KERNEL_W - 1 );
+    WArray2< Float > rowsFiltered ( haloRows, TILE_W );
+    WArray< Float > weights ( KERNEL_W + KERNEL_H );
+
+    detail::LoadClampedImageTile (
+        inImage, inStart, height, width,
+        tileRow - KERNEL_H / 2, tileCol - KERNEL_W / 2, tile, inv );
+
+    detail::LoadWeights ( inWeights, weightsStart, weights, inv );
+
+    VFloat sum;
+
+    detail::TIndexGenerator< 2, WArray2< Float > > indexGenerator;
+
+    indexGenerator.Apply (
+        [ & ]( const Int& row, const Int& col )
+        {
+            sum = 0.0f;
+
+            for ( int j = 0; j != KERNEL_W; ++j )
+            {
+                const Float pixel = tile ( row, col + j );
+                const Float weight = weights [ j ];
+                sum = Fma ( pixel, weight, sum );
+            }
+
+            rowsFiltered ( row, col ) = sum;
+        },
+        haloRows, TILE_W, inv
+    );
+
+    indexGenerator.Apply (
+        [ & ]( const Int& row, const Int& col )
+        {
+            const Int targetRow = tileRow + row;
+            const Int targetCol = tileCol + col;
+
+            If ( targetRow < height && targetCol < width );
+            {
+                sum = 0.0f;
+
+                for ( int i = 0; i != KERNEL_H; ++i )
+                {
+                    const Float pixel = rowsFiltered ( row + i, col );
+                    const Float weight = weights [ KERNEL_W + i ];
+                    sum = Fma ( pixel, weight, sum );
+                }
+
+                outImage [ outStart + targetRow * width + targetCol ] = conversion::store ( sum );
+            }
+            Fi();
+        },
+        TILE_H, TILE_W, inv
+    );
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
@@ -71,6 +71,7 @@ public:
 
     void setSource ( spv::SourceLanguage lang, int version );
     void addSourceExtension ( const char* ext );
+    void addExtension ( const char* ext );
 
     Id import ( const char* );
 
@@ -187,6 +188,10 @@ public:
     VPP_DLLAPI Id makeUintConstant(unsigned u, bool specConstant = false)   { return makeIntConstant(makeUintType(32),           u, specConstant); }
     VPP_DLLAPI Id makeInt64Constant(long long i, bool specConstant = false)            { return makeInt64Constant(makeIntType(64),  (unsigned long long)i, specConstant); }
     VPP_DLLAPI Id makeUint64Constant(unsigned long long u, bool specConstant = false)  { return makeInt64Constant(makeUintType(64),                     u, specConstant); }
+    VPP_DLLAPI Id makeInt8Constant(int i, bool specConstant = false)         { return makeIntConstant(makeIntType(8),  (unsigned)i, specConstant); }
+    VPP_DLLAPI Id makeUint8Constant(unsigned u, bool specConstant = false)   { return makeIntConstant(makeUintType(8),  u & 0xFFu, specConstant); }
+    VPP_DLLAPI Id makeInt16Constant(int i, bool specConstant = false)        { return makeIntConstant(makeIntType(16), (unsigned)i, specConstant); }
+    VPP_DLLAPI Id makeUint16Constant(unsigned u, bool specConstant = false)  { return makeIntConstant(makeUintType(16), u & 0xFFFFu, specConstant); }
     VPP_DLLAPI Id makeFloatConstant(float f, bool specConstant = false);
     VPP_DLLAPI Id makeDoubleConstant(double d, bool specConstant = false);
     VPP_DLLAPI Id makeFloat16Constant(float f, bool specConstant = false);
@@ -360,7 +365,7 @@ public:
     // Helper to use for building nested control flow with if-then-else.
     class If {
     public:
-        If(Id condition, Builder& builder);
+        If(Id condition, Builder& builder, unsigned int control = SelectionControlMaskNone);
         ~If() {}
 
         void makeBeginElse();
@@ -372,6 +377,7 @@ public:
 
         Builder& builder;
         Id condition;
+        unsigned int control;
         Function* function;
         Block* headerBlock;
         Block* thenBlock;
@@ -501,6 +507,7 @@ public:
         Id component;                  // a dynamic component index, can coexist with a swizzle, done after the swizzle, NoResult if not present
         Id preSwizzleBaseType;         // dereferenced type, before swizzle or component is applied; NoType unless a swizzle or component is present
         bool isRValue;                 // true if 'base' is an r-value, otherwise, base is an l-value
+        bool isNonUniform;             // true if the chain indexes a descriptor array with a non-uniform index
     };
 
     //
@@ -542,6 +549,12 @@ public:
         accessChain.indexChain.push_back(offset);
     }
 
+    // decorate the generated OpAccessChain with NonUniformEXT
+    void accessChainSetNonUniform()
+    {
+        accessChain.isNonUniform = true;
+    }
+
     // push new swizzle onto the end of any existing swizzle, merging into a single swizzle
     VPP_DLLAPI void accessChainPushSwizzle(std::vector<unsigned>& swizzle, Id preSwizzleBaseType);
 
@@ -573,7 +586,11 @@ public:
 
     VPP_DLLAPI void createBranch(Block* block);
     VPP_DLLAPI void createConditionalBranch(Id condition, Block* thenBlock, Block* elseBlock);
-    VPP_DLLAPI void createLoopMerge(Block* mergeBlock, Block* continueBlock, unsigned int control);
+    // Dependency hints require SPIR-V 1.1; the module version is raised when they are used.
+    VPP_DLLAPI void createLoopMerge(Block* mergeBlock, Block* continueBlock, unsigned int control, unsigned int dependencyLength = 0);
+
+    // Raises the SPIR-V version declared in the module header, never lowers it.
+    void requireSpvVersion(unsigned int version) { if (version > spvVersion) spvVersion = version; }
 
     // Sets to generate opcode for specialization constants.
     void setToSpecConstCodeGenMode() { generatingOpCodeForSpecConst = true; }
@@ -600,7 +617,9 @@ public:
 protected:
     SourceLanguage source;
     int sourceVersion;
+    unsigned int spvVersion;
     std::vector<const char*> extensions;
+    std::set<std::string> spvExtensions;
     AddressingModel addressModel;
     MemoryModel memoryModel;
     std::set<spv::Capability> capabilities;
@@ -654,6 +673,13 @@ VPP_INLINE void Builder :: addSourceExtension ( const char* ext )
 
 // -----------------------------------------------------------------------------
 
+VPP_INLINE void Builder :: addExtension ( const char* ext )
+{
+    spvExtensions.insert ( ext );
+}
+
+// -----------------------------------------------------------------------------
+
 VPP_INLINE void Builder :: setMemoryModel ( spv::AddressingModel addr, spv::MemoryModel mem )
 {
     addressModel = addr;
@@ -152,7 +152,11 @@ BufferImpl :: BufferImpl (
 
 BufferImpl :: ~BufferImpl()
 {
-    ::vkDestroyBuffer ( d_hDevice.handle(), d_handle, 0 );
+    const VkDevice hDevice = d_hDevice.handle();
+    const VkBuffer hBuffer = d_handle;
+
+    d_hDevice.destructionQueue().enqueue ( [ hDevice, hBuffer ]() {
+        ::vkDestroyBuffer ( hDevice, hBuffer, 0 ); } );
 }
 
 // -----------------------------------------------------------------------------
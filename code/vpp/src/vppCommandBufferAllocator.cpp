@@ -0,0 +1,240 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppCommandBufferAllocator.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+std::atomic< std::uint64_t > KCommandBufferAllocatorImpl :: s_nextAllocatorId ( 1 );
+
+thread_local KCommandBufferAllocatorImpl::SThreadCache
+    KCommandBufferAllocatorImpl :: s_threadCache = { 0, 0 };
+
+// -----------------------------------------------------------------------------
+
+KCommandBufferAllocatorImpl::SFrameSlot :: SFrameSlot (
+    const Device& hDevice, EQueueType queueType ) :
+        d_pool ( hDevice, queueType, CommandPool::TRANSIENT ),
+        d_nextPrimary ( 0 ),
+        d_nextSecondary ( 0 ),
+        d_frameIndex ( 0 )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+KCommandBufferAllocatorImpl :: KCommandBufferAllocatorImpl (
+    const Device& hDevice,
+    EQueueType queueType,
+    std::uint32_t frameSlotCount,
+    std::uint32_t primaryBuffersPerSlot,
+    std::uint32_t secondaryBuffersPerSlot ) :
+        d_hDevice ( hDevice ),
+        d_queueType ( queueType ),
+        d_primaryBuffersPerSlot ( primaryBuffersPerSlot ),
+        d_secondaryBuffersPerSlot ( secondaryBuffersPerSlot ),
+        d_allocatorId ( s_nextAllocatorId.fetch_add ( 1 ) ),
+        d_frameIndex ( 0 )
+{
+    if ( frameSlotCount == 0 )
+        throw XUsageError ( "CommandBufferAllocator requires at least one frame slot." );
+
+    // Frame 0 uses slot 0, so its fence starts unsignaled. Fences for other
+    // slots are signaled, as no work has been submitted from them yet.
+
+    d_frameFences.reserve ( frameSlotCount );
+
+    for ( std::uint32_t iSlot = 0; iSlot != frameSlotCount; ++iSlot )
+        d_frameFences.emplace_back ( hDevice, iSlot != 0 );
+}
+
+// -----------------------------------------------------------------------------
+
+KCommandBufferAllocatorImpl :: ~KCommandBufferAllocatorImpl()
+{
+    for ( auto& iThreadPools : d_threadPools )
+        delete iThreadPools.second;
+}
+
+// -----------------------------------------------------------------------------
+
+KCommandBufferAllocatorImpl::SThreadPools* KCommandBufferAllocatorImpl :: getThreadPools()
+{
+    if ( s_threadCache.d_allocatorId == d_allocatorId )
+        return s_threadCache.d_pPools;
+
+    const std::thread::id threadId = std::this_thread::get_id();
+    SThreadPools* pPools = 0;
+
+    {
+        mutex_lock lock ( d_threadPoolsMutex );
+
+        auto iThreadPools = d_threadPools.find ( threadId );
+
+        if ( iThreadPools != d_threadPools.end() )
+            pPools = iThreadPools->second;
+        else
+        {
+            pPools = new SThreadPools();
+            d_threadPools.emplace ( threadId, pPools );
+        }
+    }
+
+    if ( pPools->d_slots.empty() )
+    {
+        // This is done once per thread. Buffers are allocated in batches,
+        // one vkAllocateCommandBuffers call per slot and level.
+
+        const size_t nSlots = d_frameFences.size();
+        const std::uint64_t frameIndex = d_frameIndex.load ( std::memory_order_acquire );
+
+        pPools->d_slots.reserve ( nSlots );
+
+        for ( size_t iSlot = 0; iSlot != nSlots; ++iSlot )
+        {
+            pPools->d_slots.emplace_back ( d_hDevice, d_queueType );
+            SFrameSlot& slot = pPools->d_slots.back();
+
+            slot.d_frameIndex = frameIndex;
+
+            if ( d_primaryBuffersPerSlot )
+                slot.d_pool.createBuffers (
+                    d_primaryBuffersPerSlot, & slot.d_primaryBuffers, CommandPool::PRIMARY );
+
+            if ( d_secondaryBuffersPerSlot )
+                slot.d_pool.createBuffers (
+                    d_secondaryBuffersPerSlot, & slot.d_secondaryBuffers, CommandPool::SECONDARY );
+        }
+    }
+
+    s_threadCache.d_allocatorId = d_allocatorId;
+    s_threadCache.d_pPools = pPools;
+
+    return pPools;
+}
+
+// -----------------------------------------------------------------------------
+
+KCommandBufferAllocatorImpl::SFrameSlot* KCommandBufferAllocatorImpl :: getCurrentSlot()
+{
+    SThreadPools* pPools = getThreadPools();
+
+    const std::uint64_t frameIndex = d_frameIndex.load ( std::memory_order_acquire );
+    SFrameSlot* pSlot = & pPools->d_slots [ frameIndex % pPools->d_slots.size() ];
+
+    if ( pSlot->d_frameIndex != frameIndex )
+    {
+        // First use of this slot in the current frame. The frame fence
+        // has already been waited for in beginFrame(), so everything
+        // recorded previously from this pool has finished execution.
+
+        pSlot->d_pool.reset();
+        pSlot->d_nextPrimary = 0;
+        pSlot->d_nextSecondary = 0;
+        pSlot->d_frameIndex = frameIndex;
+    }
+
+    return pSlot;
+}
+
+// -----------------------------------------------------------------------------
+
+CommandBuffer KCommandBufferAllocatorImpl :: acquire (
+    std::vector< CommandBuffer >* pBuffers,
+    size_t* pNext,
+    CommandPool* pPool,
+    CommandPool::EBufferLevel level )
+{
+    if ( *pNext == pBuffers->size() )
+    {
+        // Grow geometrically. Allocated buffers are kept for later frames,
+        // so this happens only until the high-water mark is reached.
+
+        const std::uint32_t nNewBuffers = std::max (
+            static_cast< std::uint32_t >( pBuffers->size() ), 1u );
+
+        if ( pPool->createBuffers ( nNewBuffers, pBuffers, level ) != VK_SUCCESS )
+            return CommandBuffer();
+    }
+
+    return ( *pBuffers )[ ( *pNext )++ ];
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+std::uint32_t CommandBufferAllocator :: beginFrame()
+{
+    KCommandBufferAllocatorImpl* pImpl = get();
+
+    const std::uint64_t nextFrameIndex = pImpl->d_frameIndex.load() + 1;
+    const size_t iSlot = static_cast< size_t >( nextFrameIndex % pImpl->d_frameFences.size() );
+
+    Fence& hFence = pImpl->d_frameFences [ iSlot ];
+    hFence.wait();
+    hFence.reset();
+
+    pImpl->d_frameIndex.store ( nextFrameIndex, std::memory_order_release );
+    return static_cast< std::uint32_t >( iSlot );
+}
+
+// -----------------------------------------------------------------------------
+
+void CommandBufferAllocator :: endFrame ( const Queue& hQueue )
+{
+    hQueue.signal ( frameFence() );
+}
+
+// -----------------------------------------------------------------------------
+
+CommandBuffer CommandBufferAllocator :: acquirePrimary()
+{
+    KCommandBufferAllocatorImpl::SFrameSlot* pSlot = get()->getCurrentSlot();
+
+    return get()->acquire (
+        & pSlot->d_primaryBuffers, & pSlot->d_nextPrimary,
+        & pSlot->d_pool, CommandPool::PRIMARY );
+}
+
+// -----------------------------------------------------------------------------
+
+CommandBuffer CommandBufferAllocator :: acquireSecondary()
+{
+    KCommandBufferAllocatorImpl::SFrameSlot* pSlot = get()->getCurrentSlot();
+
+    return get()->acquire (
+        & pSlot->d_secondaryBuffers, & pSlot->d_nextSecondary,
+        & pSlot->d_pool, CommandPool::SECONDARY );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
@@ -86,9 +86,7 @@ void CommandBufferRecorder :: render (
         if ( bAutoBindPipeline )
         {
             Pipeline hPipeline = hRenderPass.pipeline ( iProcess, 0 );
-
-            ::vkCmdBindPipeline (
-                d_buffer.handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, hPipeline.handle() );
+            hPipeline.cmdBind ( d_buffer );
         }
 
         const RenderGraph::Commands& commands = hGraph.getProcessCommands ( iProcess );
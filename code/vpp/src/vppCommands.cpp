@@ -398,6 +398,29 @@ void NonRenderingCommands :: cmdBlitImage (
 
 // -----------------------------------------------------------------------------
 
+void NonRenderingCommands :: cmdBlitImage (
+    const TSImg& hSrcImage,
+    VkImageLayout srcImageLayout,
+    const TDImg& hDstImage,
+    VkImageLayout dstImageLayout,
+    const std::vector< VkImageBlit >& regions,
+    VkFilter filter,
+    CommandBuffer hCommandBuffer )
+{
+    const VkCommandBuffer hCmdBuffer = hCommandBuffer ?
+        hCommandBuffer.handle()
+        : RenderingCommandContext::getCommandBufferHandle();
+
+    ::vkCmdBlitImage (
+        hCmdBuffer, hSrcImage.imageRef().handle(), srcImageLayout,
+        hDstImage.imageRef().handle(), dstImageLayout,
+        static_cast< std::uint32_t >( regions.size() ),
+        & regions [ 0 ],
+        filter );
+}
+
+// -----------------------------------------------------------------------------
+
 void NonRenderingCommands :: cmdResolveImage (
     const Img& hSrcImage,
     VkImageLayout srcImageLayout,
@@ -1092,6 +1115,9 @@ void UniversalCommands :: cmdBindPipeline (
         : RenderingCommandContext::getCommandBufferHandle();
 
     ::vkCmdBindPipeline ( hCmdBuffer, pipelineBindPoint, hPipeline.handle() );
+
+    if ( pipelineBindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS )
+        hPipeline.cmdSetFoldedState ( hCmdBuffer );
 }
 
 // -----------------------------------------------------------------------------
@@ -38,9 +38,48 @@ thread_local ComputationEngine* ComputationEngine :: s_pThis = 0;
 
 // -----------------------------------------------------------------------------
 
+struct SComputationEdge
+{
+    std::uint32_t d_from;
+    std::uint32_t d_to;
+    VkPipelineStageFlags d_srcStages;
+    VkPipelineStageFlags d_dstStages;
+    VkAccessFlags d_srcAccess;
+    VkAccessFlags d_dstAccess;
+};
+
+// -----------------------------------------------------------------------------
+
+struct SComputationBarrier
+{
+    VkPipelineStageFlags d_srcStages;
+    VkPipelineStageFlags d_dstStages;
+    VkAccessFlags d_srcAccess;
+    VkAccessFlags d_dstAccess;
+};
+
+// -----------------------------------------------------------------------------
+
+static std::uint32_t findComponent (
+    std::vector< std::uint32_t >* pParents, std::uint32_t iNode )
+{
+    std::vector< std::uint32_t >& parents = *pParents;
+
+    while ( parents [ iNode ] != iNode )
+    {
+        parents [ iNode ] = parents [ parents [ iNode ] ];
+        iNode = parents [ iNode ];
+    }
+
+    return iNode;
+}
+
+// -----------------------------------------------------------------------------
+
 ComputationEngine :: ComputationEngine ( const Device& hDevice, EQueueType queueType ) :
     d_commandPool ( hDevice.defaultCmdPool ( queueType ) ),
-    d_queue ( hDevice )
+    d_queue ( hDevice ),
+    d_bGraph ( false )
 {
     s_pThis = this;
 }
@@ -51,7 +90,8 @@ ComputationEngine :: ComputationEngine (
     const Queue& hQueue,
     const CommandPool& hCommandPool ) :
         d_commandPool ( hCommandPool ),
-        d_queue ( hQueue )
+        d_queue ( hQueue ),
+        d_bGraph ( false )
 {
     s_pThis = this;
 }
@@ -60,7 +100,8 @@ ComputationEngine :: ComputationEngine (
 
 ComputationEngine :: ComputationEngine ( const Queue& hQueue ) :
     d_commandPool ( hQueue.device().defaultCmdPool ( hQueue.type() ) ),
-    d_queue ( hQueue )
+    d_queue ( hQueue ),
+    d_bGraph ( false )
 {
     s_pThis = this;
 }
@@ -69,7 +110,8 @@ ComputationEngine :: ComputationEngine ( const Queue& hQueue ) :
 
 ComputationEngine :: ComputationEngine ( const CommandPool& hCommandPool ) :
     d_commandPool ( hCommandPool ),
-    d_queue ( hCommandPool.device() )
+    d_queue ( hCommandPool.device() ),
+    d_bGraph ( false )
 {
     s_pThis = this;
 }
@@ -83,8 +125,80 @@ ComputationEngine* ComputationEngine :: getInstance()
 
 // -----------------------------------------------------------------------------
 
+void ComputationEngine :: addProcedure ( const Procedure& hProcedure )
+{
+    d_bGraph = true;
+
+    const void* pKey = & hProcedure;
+
+    if ( d_nodeIndices.find ( pKey ) != d_nodeIndices.end() )
+        return;
+
+    d_nodeIndices.insert ( std::make_pair (
+        pKey, static_cast< std::uint32_t >( d_nodes.size() ) ) );
+
+    d_nodes.push_back ( SNode() );
+    d_nodes.back().d_pProcedure = & hProcedure;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint32_t ComputationEngine :: nodeIndex ( const Computation* pComputation )
+{
+    const auto iNode = d_nodeIndices.find ( pComputation );
+
+    if ( iNode == d_nodeIndices.end() )
+        throw XUsageError ( "Computation does not belong to this ComputationEngine." );
+
+    return iNode->second;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint32_t ComputationEngine :: nodeIndex ( const Procedure* pProcedure )
+{
+    addProcedure ( *pProcedure );
+    return d_nodeIndices.find ( pProcedure )->second;
+}
+
+// -----------------------------------------------------------------------------
+
+void ComputationEngine :: addEdge ( std::uint32_t iBefore, std::uint32_t iAfter )
+{
+    if ( iBefore == iAfter )
+        throw XUsageError ( "ComputationEngine: a node can not depend on itself." );
+
+    d_bGraph = true;
+    d_nodes [ iAfter ].d_predecessors.push_back ( iBefore );
+}
+
+// -----------------------------------------------------------------------------
+
+void ComputationEngine :: addAccess (
+    std::uint32_t iNode,
+    const void* pResource,
+    VkPipelineStageFlags stages,
+    VkAccessFlags access,
+    bool bWrite )
+{
+    d_bGraph = true;
+
+    const SAccess resourceAccess = { pResource, stages, access, bWrite };
+    d_nodes [ iNode ].d_accesses.push_back ( resourceAccess );
+}
+
+// -----------------------------------------------------------------------------
+
 void ComputationEngine :: compile()
 {
+    releaseBuffers();
+
+    if ( d_bGraph )
+    {
+        compileGraph();
+        return;
+    }
+
     const std::uint32_t nProcedures =
         static_cast< std::uint32_t >( d_computations.size() );
 
@@ -103,9 +217,412 @@ void ComputationEngine :: compile()
 
 // -----------------------------------------------------------------------------
 
+void ComputationEngine :: releaseBuffers()
+{
+    // Command buffers and semaphores of the previous compilation may still be
+    // used by a pending run, possibly on a queue given by the caller.
+    // Recompiling is rare, so simply wait for the device.
+
+    std::vector< CommandBuffer > buffers;
+
+    for ( Computation* pComputation : d_computations )
+        if ( pComputation->d_buffer )
+        {
+            buffers.push_back ( pComputation->d_buffer );
+            pComputation->d_buffer = CommandBuffer();
+        }
+
+    for ( const SBatch& batch : d_batches )
+        buffers.push_back ( batch.d_buffer );
+
+    if ( buffers.empty() )
+        return;
+
+    device().waitForIdle();
+
+    d_commandPool.freeBuffers ( buffers );
+    d_batches.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void ComputationEngine :: compileGraph()
+{
+    const std::uint32_t nNodes = static_cast< std::uint32_t >( d_nodes.size() );
+
+    if ( ! nNodes )
+        return;
+
+    // Step 1: edges. Explicit dependencies and Computation predecessors do not
+    // say what is accessed, so they get a full memory dependency between the
+    // default stages of both nodes. Resource accesses produce edges for
+    // read-after-write, write-after-write and write-after-read hazards, in
+    // the order the nodes were created.
+
+    std::vector< SComputationEdge > edges;
+
+    const auto nodeStages = [ this ]( std::uint32_t iNode )
+    {
+        return d_nodes [ iNode ].d_pComputation ?
+            VkPipelineStageFlags ( VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT )
+            : VkPipelineStageFlags ( VK_PIPELINE_STAGE_ALL_COMMANDS_BIT );
+    };
+
+    const auto addFullEdge = [ & ]( std::uint32_t iFrom, std::uint32_t iTo )
+    {
+        const SComputationEdge edge = {
+            iFrom, iTo, nodeStages ( iFrom ), nodeStages ( iTo ),
+            VK_ACCESS_MEMORY_WRITE_BIT,
+            VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT };
+
+        edges.push_back ( edge );
+    };
+
+    for ( std::uint32_t iNode = 0; iNode != nNodes; ++iNode )
+    {
+        const SNode& node = d_nodes [ iNode ];
+
+        for ( std::uint32_t iPred : node.d_predecessors )
+            addFullEdge ( iPred, iNode );
+
+        if ( node.d_pComputation && node.d_pComputation->d_pPredecessor )
+            addFullEdge ( nodeIndex ( node.d_pComputation->d_pPredecessor ), iNode );
+    }
+
+    struct SResourceState
+    {
+        bool d_bWritten;
+        std::uint32_t d_writer;
+        SAccess d_writeAccess;
+        std::vector< std::pair< std::uint32_t, SAccess > > d_readers;
+    };
+
+    std::map< const void*, SResourceState > resources;
+
+    for ( std::uint32_t iNode = 0; iNode != nNodes; ++iNode )
+    {
+        // Reads first, so that a node which reads and writes the same
+        // resource depends on the previous writer only once.
+
+        for ( int iPass = 0; iPass != 2; ++iPass )
+            for ( const SAccess& acc : d_nodes [ iNode ].d_accesses )
+            {
+                if ( acc.d_bWrite != ( iPass == 1 ) )
+                    continue;
+
+                SResourceState& state = resources [ acc.d_pResource ];
+
+                if ( state.d_bWritten && state.d_writer != iNode )
+                {
+                    const SComputationEdge edge = {
+                        state.d_writer, iNode,
+                        state.d_writeAccess.d_stages, acc.d_stages,
+                        state.d_writeAccess.d_access, acc.d_access };
+
+                    edges.push_back ( edge );
+                }
+
+                if ( ! acc.d_bWrite )
+                {
+                    state.d_readers.push_back ( std::make_pair ( iNode, acc ) );
+                    continue;
+                }
+
+                // Write-after-read needs only an execution dependency.
+                for ( const auto& iReader : state.d_readers )
+                    if ( iReader.first != iNode )
+                    {
+                        const SComputationEdge edge = {
+                            iReader.first, iNode,
+                            iReader.second.d_stages, acc.d_stages, 0, 0 };
+
+                        edges.push_back ( edge );
+                    }
+
+                state.d_bWritten = true;
+                state.d_writer = iNode;
+                state.d_writeAccess = acc;
+                state.d_readers.clear();
+            }
+    }
+
+    // Step 2: topological levels. Nodes on the same level are independent
+    // and are recorded back to back without barriers.
+
+    std::vector< std::vector< std::uint32_t > > successors ( nNodes );
+    std::vector< std::uint32_t > inDegree ( nNodes, 0 );
+
+    for ( const SComputationEdge& edge : edges )
+    {
+        successors [ edge.d_from ].push_back ( edge.d_to );
+        ++inDegree [ edge.d_to ];
+    }
+
+    std::vector< std::uint32_t > levels ( nNodes, 0 );
+    std::vector< std::uint32_t > ready;
+    std::uint32_t nSorted = 0;
+
+    for ( std::uint32_t iNode = 0; iNode != nNodes; ++iNode )
+        if ( ! inDegree [ iNode ] )
+            ready.push_back ( iNode );
+
+    while ( ! ready.empty() )
+    {
+        const std::uint32_t iNode = ready.back();
+        ready.pop_back();
+        ++nSorted;
+
+        for ( std::uint32_t iSucc : successors [ iNode ] )
+        {
+            levels [ iSucc ] = std::max ( levels [ iSucc ], levels [ iNode ] + 1 );
+
+            if ( --inDegree [ iSucc ] == 0 )
+                ready.push_back ( iSucc );
+        }
+    }
+
+    if ( nSorted != nNodes )
+        throw XUsageError ( "ComputationEngine: the dependency graph contains a cycle." );
+
+    // Step 3: connected components. These share no dependencies, so they
+    // can run on separate queues without any synchronization.
+
+    std::vector< std::uint32_t > parents ( nNodes );
+
+    for ( std::uint32_t iNode = 0; iNode != nNodes; ++iNode )
+        parents [ iNode ] = iNode;
+
+    for ( const SComputationEdge& edge : edges )
+        parents [ findComponent ( & parents, edge.d_from ) ] =
+            findComponent ( & parents, edge.d_to );
+
+    std::map< std::uint32_t, std::vector< std::uint32_t > > components;
+
+    for ( std::uint32_t iNode = 0; iNode != nNodes; ++iNode )
+        components [ findComponent ( & parents, iNode ) ].push_back ( iNode );
+
+    // Step 4: queue assignment. A component without internal barriers does
+    // not stall anything else, so it stays on the main queue. Only components
+    // with several levels are spread over additional queues of the same
+    // family, so that their barriers do not serialize each other. Same family
+    // means no ownership transfers are needed. Additional queues wait on
+    // the main queue before starting (see operator()).
+
+    const Device hDevice = d_queue.device();
+    std::vector< Queue > queues ( 1, d_queue );
+
+    const std::uint32_t nFamilyQueues = hDevice.queueCount ( d_queue.type() );
+
+    for ( std::uint32_t iQueue = 0; iQueue != nFamilyQueues; ++iQueue )
+    {
+        Queue hQueue ( hDevice, iQueue, d_queue.type() );
+
+        if ( hQueue.handle() != d_queue.handle() )
+            queues.push_back ( hQueue );
+    }
+
+    std::vector< const std::vector< std::uint32_t >* > deepComponents;
+    std::vector< size_t > queueLoads ( queues.size(), 0 );
+    std::vector< std::uint32_t > nodeQueues ( nNodes, 0 );
+
+    for ( const auto& iComponent : components )
+    {
+        bool bDeep = false;
+
+        for ( std::uint32_t iNode : iComponent.second )
+            bDeep = bDeep || levels [ iNode ] > 0;
+
+        if ( bDeep )
+            deepComponents.push_back ( & iComponent.second );
+        else
+            queueLoads [ 0 ] += iComponent.second.size();
+    }
+
+    std::stable_sort (
+        deepComponents.begin(), deepComponents.end(),
+        []( const std::vector< std::uint32_t >* pLhs, const std::vector< std::uint32_t >* pRhs )
+        { return pLhs->size() > pRhs->size(); } );
+
+    for ( const std::vector< std::uint32_t >* pComponent : deepComponents )
+    {
+        const size_t iQueue = std::min_element (
+            queueLoads.begin(), queueLoads.end() ) - queueLoads.begin();
+
+        queueLoads [ iQueue ] += pComponent->size();
+
+        for ( std::uint32_t iNode : *pComponent )
+            nodeQueues [ iNode ] = static_cast< std::uint32_t >( iQueue );
+    }
+
+    // Step 5: incoming barrier masks, accumulated per node.
+
+    const SComputationBarrier noBarrier = { 0, 0, 0, 0 };
+    std::vector< SComputationBarrier > nodeBarriers ( nNodes, noBarrier );
+
+    for ( const SComputationEdge& edge : edges )
+    {
+        SComputationBarrier& barrier = nodeBarriers [ edge.d_to ];
+        barrier.d_srcStages |= edge.d_srcStages;
+        barrier.d_dstStages |= edge.d_dstStages;
+        barrier.d_srcAccess |= edge.d_srcAccess;
+        barrier.d_dstAccess |= edge.d_dstAccess;
+    }
+
+    // Step 6: record one command buffer per used queue. The main queue always
+    // comes first, as it is the one which signals completion.
+
+    std::vector< std::uint32_t > queueBatches ( queues.size(), 0 );
+
+    for ( size_t iQueue = 0; iQueue != queues.size(); ++iQueue )
+        if ( queueLoads [ iQueue ] || iQueue == 0 )
+        {
+            queueBatches [ iQueue ] = static_cast< std::uint32_t >( d_batches.size() );
+            d_batches.push_back ( SBatch() );
+            d_batches.back().d_queue = queues [ iQueue ];
+
+            if ( iQueue != 0 )
+            {
+                d_batches.back().d_waitOnBegin = Semaphore ( hDevice );
+                d_batches.back().d_signalOnEnd = Semaphore ( hDevice );
+            }
+        }
+
+    std::vector< CommandBuffer > buffers;
+    d_commandPool.createBuffers (
+        static_cast< std::uint32_t >( d_batches.size() ), & buffers );
+
+    std::vector< std::vector< std::uint32_t > > batchNodes ( d_batches.size() );
+
+    for ( std::uint32_t iNode = 0; iNode != nNodes; ++iNode )
+        batchNodes [ queueBatches [ nodeQueues [ iNode ] ] ].push_back ( iNode );
+
+    for ( size_t iBatch = 0; iBatch != d_batches.size(); ++iBatch )
+    {
+        std::vector< std::uint32_t >& nodes = batchNodes [ iBatch ];
+
+        std::stable_sort (
+            nodes.begin(), nodes.end(),
+            [ & levels ]( std::uint32_t lhs, std::uint32_t rhs )
+            { return levels [ lhs ] < levels [ rhs ]; } );
+
+        d_batches [ iBatch ].d_buffer = buffers [ iBatch ];
+
+        CommandBufferRecorder recorder ( buffers [ iBatch ] );
+
+        for ( size_t iFirst = 0; iFirst != nodes.size(); )
+        {
+            const std::uint32_t level = levels [ nodes [ iFirst ] ];
+            size_t iEnd = iFirst;
+            SComputationBarrier barrier = noBarrier;
+
+            for ( ; iEnd != nodes.size() && levels [ nodes [ iEnd ] ] == level; ++iEnd )
+            {
+                const SComputationBarrier& nodeBarrier = nodeBarriers [ nodes [ iEnd ] ];
+                barrier.d_srcStages |= nodeBarrier.d_srcStages;
+                barrier.d_dstStages |= nodeBarrier.d_dstStages;
+                barrier.d_srcAccess |= nodeBarrier.d_srcAccess;
+                barrier.d_dstAccess |= nodeBarrier.d_dstAccess;
+            }
+
+            // One global memory barrier per level covers all dependencies
+            // on any earlier level.
+            if ( barrier.d_srcStages )
+            {
+                VkMemoryBarrier memoryBarrier;
+                memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                memoryBarrier.pNext = 0;
+                memoryBarrier.srcAccessMask = barrier.d_srcAccess;
+                memoryBarrier.dstAccessMask = barrier.d_dstAccess;
+
+                UniversalCommands::cmdPipelineBarrier (
+                    barrier.d_srcStages, barrier.d_dstStages, 0,
+                    Barriers ( memoryBarrier ), buffers [ iBatch ] );
+            }
+
+            for ( ; iFirst != iEnd; ++iFirst )
+            {
+                const SNode& node = d_nodes [ nodes [ iFirst ] ];
+
+                if ( node.d_pComputation )
+                    recorder.compute ( *node.d_pComputation );
+                else
+                    recorder.perform ( *node.d_pProcedure );
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void ComputationEngine :: operator()( const Fence& sigFenceOnEnd )
+{
+    if ( ! d_bGraph )
+        throw XUsageError ( "ComputationEngine has no dependency graph. Submit computations separately." );
+
+    if ( d_batches.empty() )
+    {
+        if ( sigFenceOnEnd )
+            d_queue.signal ( sigFenceOnEnd );
+
+        return;
+    }
+
+    // Additional queues first, so that they start as early as possible.
+    // They must not overtake work submitted earlier to the main queue
+    // (e.g. buffer uploads), which would have run before the graph if it
+    // was executed on the main queue alone. The main queue signals a fork
+    // semaphore for each of them as soon as that work completes.
+
+    std::vector< Semaphore > forkSems;
+    std::vector< Semaphore > joinSems;
+
+    for ( size_t iBatch = 1; iBatch != d_batches.size(); ++iBatch )
+        forkSems.push_back ( d_batches [ iBatch ].d_waitOnBegin );
+
+    if ( ! forkSems.empty() )
+        d_queue.signal ( std::vector< Semaphore >(), forkSems );
+
+    for ( size_t iBatch = 1; iBatch != d_batches.size(); ++iBatch )
+    {
+        const SBatch& batch = d_batches [ iBatch ];
+
+        batch.d_queue.submit (
+            batch.d_buffer, batch.d_waitOnBegin, batch.d_signalOnEnd, Fence(),
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT );
+
+        joinSems.push_back ( batch.d_signalOnEnd );
+    }
+
+    const SBatch& mainBatch = d_batches [ 0 ];
+
+    if ( joinSems.empty() )
+        mainBatch.d_queue.submit ( mainBatch.d_buffer, Semaphore(), Semaphore(), sigFenceOnEnd );
+    else
+    {
+        // Semaphores must be waited on even without a fence, otherwise they
+        // could not be signaled again by the next run.
+        mainBatch.d_queue.submit ( mainBatch.d_buffer );
+        mainBatch.d_queue.signal ( joinSems, sigFenceOnEnd );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool ComputationEngine :: operator()( std::uint64_t waitTimeout )
+{
+    Fence fence ( d_queue.device() );
+    ( *this )( fence );
+    return fence.wait ( waitTimeout );
+}
+
+// -----------------------------------------------------------------------------
+
 void ComputationEngine :: wait()
 {
     d_queue.waitForIdle();
+
+    for ( size_t iBatch = 1; iBatch < d_batches.size(); ++iBatch )
+        d_batches [ iBatch ].d_queue.waitForIdle();
 }
 
 // -----------------------------------------------------------------------------
@@ -40,6 +40,13 @@ const ComputePipeline& ComputePass :: pipeline ( std::uint32_t iPipeline ) const
 
 // -----------------------------------------------------------------------------
 
+const SpecializationValues& ComputePass :: specialization ( std::uint32_t iPipeline ) const
+{
+    return get()->d_pipelineData [ iPipeline ].d_specialization;
+}
+
+// -----------------------------------------------------------------------------
+
 void ComputePass :: operator<< ( const std::function< void () >& cmds )
 {
     get()->d_commands.push_back ( cmds );
@@ -139,6 +146,29 @@ void ComputePassImpl :: preparePipelineCreateInfo ( size_t iPipeline )
     const PipelineConfig::ShaderTable& shaderTable = pipelineData.d_layout.getShaderTable();
     pInfo->stage = shaderTable [ 0 ];
 
+    // Values found by WorkgroupTuner for this device take precedence over
+    // the ones given explicitly.
+    if ( d_hTuningDatabase && ! pipelineData.d_tuningKey.empty() )
+    {
+        SpecializationValues tunedValues;
+
+        if ( d_hTuningDatabase.find (
+                d_hDevice.physical(), pipelineData.d_tuningKey, & tunedValues ) )
+        {
+            pipelineData.d_specialization.merge ( tunedValues );
+        }
+    }
+
+    // Same shader module, only specialization constants differ.
+    if ( ! pipelineData.d_specialization.empty()
+         && config.initSpecializationInfo (
+                pipelineData.d_specialization,
+                & pipelineData.d_specializationData,
+                & pipelineData.d_specializationInfo ) )
+    {
+        pInfo->stage.pSpecializationInfo = & pipelineData.d_specializationInfo;
+    }
+
     pInfo->layout = pipelineData.d_layout.handle();
     pInfo->basePipelineHandle = 0;
     pInfo->basePipelineIndex = 0;
@@ -146,7 +176,10 @@ void ComputePassImpl :: preparePipelineCreateInfo ( size_t iPipeline )
 
 // -----------------------------------------------------------------------------
 
-std::uint32_t ComputePassImpl :: createPipelineData ( const PipelineLayoutBase& lt )
+std::uint32_t ComputePassImpl :: createPipelineData (
+    const PipelineLayoutBase& lt,
+    const SpecializationValues& specialization,
+    const std::string& tuningKey )
 {
     const std::uint32_t pipelineIndex =
         static_cast< std::uint32_t >( d_pipelineData.size() );
@@ -155,6 +188,8 @@ std::uint32_t ComputePassImpl :: createPipelineData ( const PipelineLayoutBase&
 
     SPipelineData& data = d_pipelineData.back();
     data.d_layout = lt;
+    data.d_specialization = specialization;
+    data.d_tuningKey = tuningKey;
 
     return pipelineIndex;
 }
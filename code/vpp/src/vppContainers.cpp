@@ -44,9 +44,12 @@ VectorBase :: VectorBase (
     MemProfile::ECharacteristic memProfile,
     Buf* pBuffer,
     DeviceMemory* pMemory,
-    const Device& hDevice ) :
+    const Device& hDevice,
+    bool bGrowable ) :
         d_memorySize ( memorySize ),
         d_memProfile ( memProfile ),
+        d_bGrowable ( bGrowable ),
+        d_generation ( 0 ),
         d_pBuffer ( pBuffer ),
         d_pMemory ( pMemory ),
         d_device ( hDevice )
@@ -82,6 +85,7 @@ void VectorBase :: commit (
 
     if ( ! pushCmdBuffer )
     {
+        freeRetiredCmdBuffers();
         pushCmdBuffer = hDevice.defaultCmdPool ( eQueue ).createBuffer();
         pushCmdBuffer.begin();
         syncHostToDevice ( pushCmdBuffer.handle(), 0, d_memorySize );
@@ -120,6 +124,7 @@ void VectorBase :: load (
 
     if ( ! pushCmdBuffer )
     {
+        freeRetiredCmdBuffers();
         pushCmdBuffer = hDevice.defaultCmdPool ( eQueue ).createBuffer();
         pushCmdBuffer.begin();
         syncDeviceToHost ( pushCmdBuffer.handle(), 0, d_memorySize );
@@ -143,6 +148,23 @@ void VectorBase :: loadAndWait ( EQueueType eQueue )
 
 // -----------------------------------------------------------------------------
 
+void VectorBase :: cmdLoad ( CommandBuffer hCmdBuffer )
+{
+    syncDeviceToHost ( hCmdBuffer.handle(), 0, d_memorySize );
+}
+
+// -----------------------------------------------------------------------------
+
+void VectorBase :: invalidateHostCopy()
+{
+    if ( d_memProfile == MemProfile::DEVICE_STATIC )
+        flushDeviceToHost ( VK_NULL_HANDLE, d_localMemoryBinding.memory() );
+    else
+        flushDeviceToHost ( VK_NULL_HANDLE, *d_pMemory );
+}
+
+// -----------------------------------------------------------------------------
+
 void VectorBase :: flushHostToDevice (
     VkCommandBuffer hCmdBuffer, const DeviceMemory& mem ) 
 {
@@ -614,6 +636,209 @@ std::uint32_t VectorBase :: getAdditionalUsage (
     }
 }
 
+// -----------------------------------------------------------------------------
+
+std::uint32_t VectorBase :: getAdditionalUsage (
+    MemProfile::ECharacteristic memProfile, bool bGrowable )
+{
+    // Growable buffers are copied on the device when reallocated.
+
+    return getAdditionalUsage ( memProfile )
+        | ( bGrowable ? Buf::SOURCE | Buf::TARGET : 0u );
+}
+
+// -----------------------------------------------------------------------------
+
+void VectorBase :: replaceStorage (
+    const Buf& newBuffer,
+    const DeviceMemory& newMemory,
+    size_t newMemorySize,
+    size_t validSize )
+{
+    freeRetiredCmdBuffers();
+
+    if ( d_memProfile == MemProfile::DEVICE_STATIC )
+    {
+        // Host mirror holds the most recent data written by host, possibly
+        // not committed yet. It is copied on the host side.
+
+        std::uint32_t localBufferUsage = Buf::SOURCE;
+
+        if ( d_pBuffer->getUsage() & Buf::SOURCE )
+            localBufferUsage |= Buf::TARGET;
+
+        Buf newLocalBuffer ( newMemorySize, localBufferUsage, d_device );
+
+        LocalMemoryBinding newLocalMemoryBinding (
+            newLocalBuffer, MemProfile::HOST_STATIC );
+
+        MappableDeviceMemory& oldLocalMemory = d_localMemoryBinding.memory();
+        MappableDeviceMemory& newLocalMemory = newLocalMemoryBinding.memory();
+
+        if ( validSize )
+        {
+            newLocalMemory.map ( 0, validSize );
+            std::memcpy ( newLocalMemory.beginMapped(), oldLocalMemory.beginMapped(), validSize );
+            newLocalMemory.syncToDevice ( 0, validSize );
+            newLocalMemory.unmap();
+        }
+
+        oldLocalMemory.unmap();
+
+        d_localBuffer = newLocalBuffer;
+        d_localMemoryBinding = newLocalMemoryBinding;
+    }
+    else if ( d_memProfile != MemProfile::DEVICE_ONLY )
+    {
+        // Must be done while the memory is still mapped.
+        flushHostToDevice ( VK_NULL_HANDLE, *d_pMemory );
+    }
+
+    // Nothing waits for the copy. It gets its own transient command pool,
+    // destroyed through the destruction queue when the copy completes (the
+    // submission carries a tracking fence). The default pool can not be
+    // used, as the destruction may run on the reclaimer thread.
+
+    DestructionQueue& destructionQueue = d_device.destructionQueue();
+    const VkDevice hDevice = d_device.handle();
+
+    if ( validSize )
+    {
+        VkCommandPoolCreateInfo commandPoolCreateInfo;
+        commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        commandPoolCreateInfo.pNext = 0;
+        commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        commandPoolCreateInfo.queueFamilyIndex = d_device.queueFamily ( Q_GRAPHICS );
+
+        VkCommandPool hCmdPool = VK_NULL_HANDLE;
+
+        if ( ::vkCreateCommandPool ( hDevice, & commandPoolCreateInfo, 0, & hCmdPool ) != VK_SUCCESS )
+            raiseMemoryAllocationError();
+
+        VkCommandBufferAllocateInfo commandBufferAllocateInfo;
+        commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        commandBufferAllocateInfo.pNext = 0;
+        commandBufferAllocateInfo.commandPool = hCmdPool;
+        commandBufferAllocateInfo.commandBufferCount = 1u;
+        commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+
+        VkCommandBuffer hCopyCmdBuffer = VK_NULL_HANDLE;
+
+        if ( ::vkAllocateCommandBuffers ( hDevice, & commandBufferAllocateInfo, & hCopyCmdBuffer ) != VK_SUCCESS )
+        {
+            ::vkDestroyCommandPool ( hDevice, hCmdPool, 0 );
+            raiseMemoryAllocationError();
+        }
+
+        CommandBuffer copyCmdBuffer ( hCopyCmdBuffer );
+        copyCmdBuffer.begin ( CommandBuffer::ONE_TIME_SUBMIT );
+
+        UniversalCommands::cmdBufferPipelineBarrier (
+            *d_pBuffer,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_MEMORY_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT,
+            VK_ACCESS_TRANSFER_READ_BIT,
+            copyCmdBuffer );
+
+        VkBufferCopy vkBufferCopy;
+        vkBufferCopy.srcOffset = 0;
+        vkBufferCopy.dstOffset = 0;
+        vkBufferCopy.size = validSize;
+
+        ::vkCmdCopyBuffer (
+            copyCmdBuffer.handle(), d_pBuffer->handle(),
+            newBuffer.handle(), 1u, & vkBufferCopy );
+
+        UniversalCommands::cmdBufferPipelineBarrier (
+            newBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, newBuffer.barrierDestStageHint(),
+            VK_ACCESS_TRANSFER_WRITE_BIT, newBuffer.barrierDestAccessHint(),
+            copyCmdBuffer );
+
+        copyCmdBuffer.end();
+
+        Queue queue ( d_device, 0, Q_GRAPHICS );
+        queue.submit ( copyCmdBuffer );
+
+        destructionQueue.enqueue ( [ hDevice, hCmdPool ]() {
+            ::vkDestroyCommandPool ( hDevice, hCmdPool, 0 );
+        } );
+    }
+
+    // The old buffer and memory are released by the caller. Their destruction
+    // is deferred as well, until the copy above and all earlier work is done.
+
+    // Cached command buffers refer to the old buffer. They may still be
+    // pending, so they are freed later by freeRetiredCmdBuffers().
+
+    const std::uint64_t timelineValue = destructionQueue.timeline();
+
+    for ( unsigned int iQueue = 0; iQueue != Q_count; ++iQueue )
+    {
+        CommandBuffer* cachedBuffers[] =
+        {
+            & d_commitCmdBuffer [ iQueue ],
+            & d_loadCmdBuffer [ iQueue ],
+            & d_copyCmdBuffer [ iQueue ]
+        };
+
+        for ( CommandBuffer* pCmdBuffer : cachedBuffers )
+            if ( *pCmdBuffer )
+            {
+                const SRetiredCmdBuffer retired = {
+                    static_cast< EQueueType >( iQueue ), *pCmdBuffer, timelineValue };
+
+                d_retiredCmdBuffers.push_back ( retired );
+                *pCmdBuffer = CommandBuffer();
+            }
+    }
+
+    d_memorySize = newMemorySize;
+}
+
+// -----------------------------------------------------------------------------
+
+void VectorBase :: freeRetiredCmdBuffers()
+{
+    // Called only where the vector uses the default command pools anyway.
+
+    if ( d_retiredCmdBuffers.empty() )
+        return;
+
+    const std::uint64_t completed = d_device.destructionQueue().completedTimeline();
+
+    const auto iEnd = std::remove_if (
+        d_retiredCmdBuffers.begin(), d_retiredCmdBuffers.end(),
+        [ this, completed ]( const SRetiredCmdBuffer& retired )
+        {
+            if ( retired.d_timelineValue > completed )
+                return false;
+
+            d_device.defaultCmdPool ( retired.d_queue ).freeBuffer ( retired.d_buffer );
+            return true;
+        } );
+
+    d_retiredCmdBuffers.erase ( iEnd, d_retiredCmdBuffers.end() );
+}
+
+// -----------------------------------------------------------------------------
+
+void VectorBase :: notifyReallocation()
+{
+    ++d_generation;
+
+    for ( const FReallocationCallback& callback : d_reallocationCallbacks )
+        callback();
+}
+
+// -----------------------------------------------------------------------------
+
+void VectorBase :: addReallocationCallback ( const FReallocationCallback& callback )
+{
+    d_reallocationCallbacks.push_back ( callback );
+}
+
 // -----------------------------------------------------------------------------
 } // namespace detail
 // -----------------------------------------------------------------------------
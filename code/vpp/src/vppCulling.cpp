@@ -0,0 +1,415 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppCulling.hpp"
+#include "../include/vppRenderGraph.hpp"
+#include "../include/vppLangIntInOut.hpp"
+#include "../include/vppLangConversions.hpp"
+#include "../include/vppLangFunctions.hpp"
+#include "../include/vppLangImgFun.hpp"
+#include "../include/vppLangConstructs.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+CullingPipelineConfig :: CullingPipelineConfig (
+    const Device& hDevice, bool bOcclusion ) :
+        d_bOcclusion ( bOcclusion ),
+        d_shader ( this, { LOCAL_SIZE, 1, 1 }, & CullingPipelineConfig::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void CullingPipelineConfig :: setData (
+    const UniformBufferView& frameParams,
+    const CullingInstanceBuffer& instances,
+    const CullingLodBuffer& lods,
+    const IndexedIndirectCommands& commands,
+    const DrawCountBuffer& drawCount,
+    ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_frameParams = frameParams,
+        d_instances = instances,
+        d_lods = lods,
+        d_commands = commands,
+        d_drawCount = drawCount
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void CullingPipelineConfig :: setDepthPyramid (
+    const DepthPyramidView& depthPyramid,
+    ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_depthPyramid = depthPyramid
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void CullingPipelineConfig :: cmdPushCounts (
+    std::uint32_t instanceCount,
+    std::uint32_t maxDrawCount,
+    CommandBuffer hCmdBuffer )
+{
+    CCullingCounts& counts = d_counts.data();
+    counts.m_instanceCount = instanceCount;
+    counts.m_maxDrawCount = maxDrawCount;
+
+    if ( hCmdBuffer )
+        d_counts.cmdPush ( hCmdBuffer );
+    else
+        d_counts.cmdPush();
+}
+
+// -----------------------------------------------------------------------------
+
+void CullingPipelineConfig :: fComputeShader ( ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    UniformVar< TCullingCounts, decltype ( d_counts ) > inCounts ( d_counts );
+    UniformVar< TCullingFrame, decltype ( d_frameParams ) > inFrame ( d_frameParams );
+    UniformArray< TCullingInstance, decltype ( d_instances ) > inInstances ( d_instances );
+    UniformArray< TCullingLod, decltype ( d_lods ) > inLods ( d_lods );
+    UniformSimpleArray< unsigned int, decltype ( d_commands ) > outCommands ( d_commands );
+    UniformSimpleArray< unsigned int, decltype ( d_drawCount ) > ioDrawCount ( d_drawCount );
+
+    const UInt instanceCount = inCounts [ & GCullingCounts::m_instanceCount ];
+    const UInt maxDrawCount = inCounts [ & GCullingCounts::m_maxDrawCount ];
+
+    const IVec3 globalId = pShader->inGlobalInvocationId;
+    const UInt g = StaticCast< UInt >( globalId [ X ] );
+
+    If ( g < instanceCount );
+    {
+        const Vec4 sphere = inInstances [ g ][ & GCullingInstance::m_sphere ];
+        const UVec4 mesh = inInstances [ g ][ & GCullingInstance::m_mesh ];
+        const Vec3 center = sphere [ XYZ ];
+        const Float radius = sphere [ W ];
+
+        // Frustum test. The sphere is rejected if it lies entirely on
+        // the outer side of any plane.
+
+        typedef UniformFld< GPU, vect4 > GCullingFrame::* PlaneField;
+
+        static const PlaneField s_planes [] =
+        {
+            & GCullingFrame::m_leftPlane,
+            & GCullingFrame::m_rightPlane,
+            & GCullingFrame::m_bottomPlane,
+            & GCullingFrame::m_topPlane,
+            & GCullingFrame::m_nearPlane,
+            & GCullingFrame::m_farPlane
+        };
+
+        VBool bVisible = ( mesh [ Y ] != 0u );
+
+        for ( const PlaneField pPlane : s_planes )
+        {
+            const Vec4 plane = inFrame [ pPlane ];
+            bVisible = bVisible && ( Dot ( plane [ XYZ ], center ) + plane [ W ] >= -radius );
+        }
+
+        if ( d_bOcclusion )
+        {
+            // Occlusion test against the depth pyramid. The bounding box of
+            // the sphere is projected to the screen and its nearest depth is
+            // compared with the farthest depth stored in the pyramid level
+            // in which the projected rectangle covers at most 2x2 texels.
+
+            If ( bVisible );
+            {
+                const Mat4 viewProjection = inFrame [ & GCullingFrame::m_viewProjection ];
+                const Vec4 pyramidSize = inFrame [ & GCullingFrame::m_pyramidSize ];
+
+                VVec2 minCoords = Vec2 ( 1.0f, 1.0f );
+                VVec2 maxCoords = Vec2 ( -1.0f, -1.0f );
+                VFloat minDepth = 1.0f;
+                VBool bCrossesNearPlane = false;
+
+                for ( unsigned int iCorner = 0; iCorner != 8; ++iCorner )
+                {
+                    const Vec3 corner = center + Vec3 (
+                        ( iCorner & 1 ) ? radius : -radius,
+                        ( iCorner & 2 ) ? radius : -radius,
+                        ( iCorner & 4 ) ? radius : -radius );
+
+                    const Vec4 clip = viewProjection * Vec4 ( corner, 1.0f );
+                    const Float w = Max ( clip [ W ], 1e-6f );
+                    const Vec3 ndc = clip [ XYZ ] / w;
+
+                    bCrossesNearPlane = bCrossesNearPlane || ( clip [ W ] <= 0.0f );
+                    minCoords = Min ( minCoords, ndc [ XY ] );
+                    maxCoords = Max ( maxCoords, ndc [ XY ] );
+                    minDepth = Min ( minDepth, ndc [ Z ] );
+                }
+
+                // Objects crossing the near plane are always drawn.
+
+                If ( ! bCrossesNearPlane );
+                {
+                    const Vec2 zero = Vec2 ( 0.0f, 0.0f );
+                    const Vec2 one = Vec2 ( 1.0f, 1.0f );
+                    const Vec2 half = Vec2 ( 0.5f, 0.5f );
+                    const Vec2 minUV = Max ( Min ( minCoords * 0.5f + half, one ), zero );
+                    const Vec2 maxUV = Max ( Min ( maxCoords * 0.5f + half, one ), zero );
+
+                    const Vec2 extent = ( maxUV - minUV ) * pyramidSize [ XY ];
+                    const Int levelCount = StaticCast< Int >( pyramidSize [ Z ] );
+
+                    const Int level = Min (
+                        StaticCast< Int >( Ceil ( Log2 ( Max ( Max ( extent [ X ], extent [ Y ] ), 1.0f ) ) ) ),
+                        levelCount - 1 );
+
+                    const IVec2 levelSize = TextureSize ( d_depthPyramid, level );
+                    const Vec2 fLevelSize = StaticCast< Vec2 >( levelSize );
+                    const IVec2 maxTexel = levelSize - IVec2 ( 1, 1 );
+
+                    const IVec2 t0 = Min ( StaticCast< IVec2 >( minUV * fLevelSize ), maxTexel );
+                    const IVec2 t1 = Min ( StaticCast< IVec2 >( maxUV * fLevelSize ), maxTexel );
+
+                    const Float d00 = TexelFetchLod ( d_depthPyramid, t0, level )[ X ];
+                    const Float d10 = TexelFetchLod ( d_depthPyramid, IVec2 ( t1 [ X ], t0 [ Y ] ), level )[ X ];
+                    const Float d01 = TexelFetchLod ( d_depthPyramid, IVec2 ( t0 [ X ], t1 [ Y ] ), level )[ X ];
+                    const Float d11 = TexelFetchLod ( d_depthPyramid, t1, level )[ X ];
+
+                    const Float occluderDepth = Max ( Max ( d00, d10 ), Max ( d01, d11 ) );
+
+                    bVisible = ( minDepth <= occluderDepth );
+                }
+                Fi();
+            }
+            Fi();
+        }
+
+        If ( bVisible );
+        {
+            // LOD selection. Records are scanned from the coarsest one,
+            // so the most detailed record accepting the distance wins.
+
+            const Vec4 cameraPosition = inFrame [ & GCullingFrame::m_cameraPosition ];
+
+            const Float distance =
+                Max ( Length ( center - cameraPosition [ XYZ ] ) - radius, 0.0f )
+                * cameraPosition [ W ];
+
+            const UInt lodLast = mesh [ X ] + mesh [ Y ] - 1u;
+
+            VUInt iLod = lodLast;
+            VUInt i;
+
+            For ( i, 0u, mesh [ Y ] );
+            {
+                const UInt iCandidate = lodLast - i;
+                const Vec4 lodParams = inLods [ iCandidate ][ & GCullingLod::m_params ];
+
+                If ( distance <= lodParams [ X ] );
+                    iLod = iCandidate;
+                Fi();
+            }
+            Rof();
+
+            const UVec4 range = inLods [ iLod ][ & GCullingLod::m_range ];
+
+            // Compaction. Each surviving instance reserves one command slot.
+
+            const Pointer< UInt > pDrawCount = & ioDrawCount [ 0 ];
+            const UInt iDraw = pDrawCount.Increment();
+
+            If ( iDraw < maxDrawCount );
+            {
+                // Layout of VkDrawIndexedIndirectCommand.
+
+                const UInt base = iDraw * 5u;
+                outCommands [ base ] = range [ X ];
+                outCommands [ base + 1u ] = UInt ( 1u );
+                outCommands [ base + 2u ] = range [ Y ];
+                outCommands [ base + 3u ] = range [ Z ];
+                outCommands [ base + 4u ] = mesh [ Z ];
+            }
+            Fi();
+        }
+        Fi();
+    }
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+CullingStage :: CullingStage ( const Device& hDevice, bool bOcclusion ) :
+    d_hDevice ( hDevice ),
+    d_pipelineLayout ( hDevice, bOcclusion ),
+    d_computePass ( hDevice ),
+    d_dataBlock ( d_pipelineLayout ),
+    d_maxDrawCount ( 0 )
+{
+    d_computePass.addPipeline ( d_pipelineLayout );
+    d_computePass.createPipelines();
+}
+
+// -----------------------------------------------------------------------------
+
+void CullingStage :: setData (
+    const UniformBufferView& frameParams,
+    const CullingInstanceBuffer& instances,
+    const CullingLodBuffer& lods,
+    const IndexedIndirectCommands& commands,
+    const DrawCountBuffer& drawCount )
+{
+    d_pipelineLayout.definition().setData (
+        frameParams, instances, lods, commands, drawCount, & d_dataBlock );
+
+    d_commands = commands;
+    d_drawCount = drawCount;
+    d_maxDrawCount = static_cast< std::uint32_t >( commands.capacity() );
+}
+
+// -----------------------------------------------------------------------------
+
+void CullingStage :: setDepthPyramid ( const DepthPyramidView& depthPyramid )
+{
+    if ( ! d_pipelineLayout.definition().isOcclusionEnabled() )
+        throw XUsageError ( "CullingStage was created without occlusion culling." );
+
+    d_pipelineLayout.definition().setDepthPyramid ( depthPyramid, & d_dataBlock );
+}
+
+// -----------------------------------------------------------------------------
+
+void CullingStage :: cmdCull (
+    std::uint32_t instanceCount,
+    CommandBuffer hCmdBuffer )
+{
+    if ( ! d_maxDrawCount )
+        throw XUsageError ( "CullingStage::cmdCull called before setData." );
+
+    const Buf& hCommands = d_commands.buffer();
+    const Buf& hDrawCount = d_drawCount.buffer();
+
+    // Previous draws must finish reading the buffers before they are reset.
+
+    UniversalCommands::cmdBufferPipelineBarrier (
+        hDrawCount,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        hCmdBuffer );
+
+    NonRenderingCommands::cmdFillBuffer (
+        hDrawCount, 0, sizeof ( std::uint32_t ), 0, hCmdBuffer );
+
+    const bool bFixedDrawCount = ! d_hDevice.cmdDrawIndexedIndirectCountFunction();
+
+    if ( bFixedDrawCount )
+    {
+        // Without GPU-side draw count all slots are drawn, so those not
+        // written by the shader must contain empty commands.
+
+        UniversalCommands::cmdBufferPipelineBarrier (
+            hCommands,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            hCmdBuffer );
+
+        NonRenderingCommands::cmdFillBuffer (
+            hCommands, 0, d_maxDrawCount * sizeof ( VkDrawIndexedIndirectCommand ),
+            0, hCmdBuffer );
+
+        UniversalCommands::cmdBufferPipelineBarrier (
+            hCommands,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            hCmdBuffer );
+    }
+    else
+    {
+        UniversalCommands::cmdBufferPipelineBarrier (
+            hCommands,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            hCmdBuffer );
+    }
+
+    UniversalCommands::cmdBufferPipelineBarrier (
+        hDrawCount,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        hCmdBuffer );
+
+    d_dataBlock.cmdBind ( hCmdBuffer );
+    d_computePass.pipeline ( 0 ).cmdBind ( hCmdBuffer );
+    d_pipelineLayout.definition().cmdPushCounts ( instanceCount, d_maxDrawCount, hCmdBuffer );
+
+    const std::uint32_t localSize = CullingPipelineConfig::LOCAL_SIZE;
+    ComputePass::cmdDispatch ( ( instanceCount + localSize - 1 ) / localSize, 1, 1, hCmdBuffer );
+
+    UniversalCommands::cmdBufferPipelineBarrier (
+        hCommands,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+        hCmdBuffer );
+
+    UniversalCommands::cmdBufferPipelineBarrier (
+        hDrawCount,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+        hCmdBuffer );
+}
+
+// -----------------------------------------------------------------------------
+
+void CullingStage :: cmdDraw ( CommandBuffer hCmdBuffer ) const
+{
+    RenderGraph::cmdDrawIndexedIndirectCount (
+        d_commands, 0, d_drawCount, 0, d_maxDrawCount, hCmdBuffer );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
@@ -0,0 +1,411 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppDebugPrint.hpp"
+#include "../include/vppCommands.hpp"
+
+#include <cstdio>
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+static std::uint32_t roundCapacity ( std::uint32_t capacity )
+{
+    std::uint32_t result = 64;
+
+    while ( result < capacity && result < 0x40000000u )
+        result <<= 1;
+
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+DebugPrintBufferImpl :: DebugPrintBufferImpl (
+    const Device& hDevice, std::uint32_t capacity ) :
+        d_hDevice ( hDevice ),
+        d_capacity ( roundCapacity ( capacity ) ),
+        d_storage (
+            StorageBuffer (
+                ( DebugPrintBuffer::HDR_SIZE + d_capacity ) * sizeof ( std::uint32_t ),
+                hDevice ),
+            MemProfile::HOST_STATIC ),
+        d_droppedCount ( 0 )
+{
+    d_storage.memory().mapPersistently();
+
+    std::uint32_t* pHeader = header();
+    std::memset ( pHeader, 0, DebugPrintBuffer::HDR_SIZE * sizeof ( std::uint32_t ) );
+    pHeader [ DebugPrintBuffer::HDR_CAPACITY ] = d_capacity;
+    pHeader [ DebugPrintBuffer::HDR_FILTER_X ] = static_cast< std::uint32_t >( DebugPrintBuffer::ANY );
+    pHeader [ DebugPrintBuffer::HDR_FILTER_Y ] = static_cast< std::uint32_t >( DebugPrintBuffer::ANY );
+    pHeader [ DebugPrintBuffer::HDR_FILTER_Z ] = static_cast< std::uint32_t >( DebugPrintBuffer::ANY );
+    syncHeaderToDevice();
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint32_t* DebugPrintBufferImpl :: header() const
+{
+    return reinterpret_cast< std::uint32_t* >( d_storage.d_memory.beginMapped() );
+}
+
+// -----------------------------------------------------------------------------
+
+void DebugPrintBufferImpl :: syncHeaderToDevice()
+{
+    d_storage.memory().syncToDevice (
+        0, DebugPrintBuffer::HDR_SIZE * sizeof ( std::uint32_t ) );
+}
+
+// -----------------------------------------------------------------------------
+
+DebugPrintBuffer :: DebugPrintBuffer (
+    const Device& hDevice, std::uint32_t capacity ) :
+        TSharedReference< DebugPrintBufferImpl >(
+            new DebugPrintBufferImpl ( hDevice, capacity ) )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void DebugPrintBuffer :: setFilter ( int x, int y, int z )
+{
+    DebugPrintBufferImpl* pImpl = get();
+    std::lock_guard< std::mutex > lock ( pImpl->d_mutex );
+
+    std::uint32_t* pHeader = pImpl->header();
+    pHeader [ HDR_FILTER_X ] = static_cast< std::uint32_t >( x );
+    pHeader [ HDR_FILTER_Y ] = static_cast< std::uint32_t >( y );
+    pHeader [ HDR_FILTER_Z ] = static_cast< std::uint32_t >( z );
+    pImpl->syncHeaderToDevice();
+}
+
+// -----------------------------------------------------------------------------
+
+void DebugPrintBuffer :: clearFilter()
+{
+    setFilter ( ANY, ANY, ANY );
+}
+
+// -----------------------------------------------------------------------------
+
+void DebugPrintBuffer :: cmdMakeHostVisible ( CommandBuffer hCmdBuffer ) const
+{
+    UniversalCommands::cmdBufferPipelineBarrier (
+        get()->d_storage.resource(),
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT,
+        hCmdBuffer );
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint32_t DebugPrintBuffer :: registerFormat (
+    const char* pFormat, const std::vector< SDebugPrintArg >& args )
+{
+    DebugPrintBufferImpl* pImpl = get();
+    std::lock_guard< std::mutex > lock ( pImpl->d_mutex );
+
+    // The same call is translated again for each pipeline using it,
+    // so equal formats share an index.
+
+    const DebugPrintBufferImpl::FormatKey key ( pFormat, args );
+    const auto iFormat = pImpl->d_formatIndices.find ( key );
+
+    if ( iFormat != pImpl->d_formatIndices.end() )
+        return iFormat->second;
+
+    DebugPrintBufferImpl::SFormat format;
+    format.d_text = pFormat;
+    format.d_args = args;
+    format.d_recordSize = RECORD_HEADER_SIZE;
+
+    for ( const SDebugPrintArg& arg : args )
+        format.d_recordSize += arg.d_components;
+
+    const std::uint32_t index = static_cast< std::uint32_t >( pImpl->d_formats.size() );
+    pImpl->d_formats.push_back ( format );
+    pImpl->d_formatIndices.emplace ( key, index );
+    return index;
+}
+
+// -----------------------------------------------------------------------------
+
+static void formatValue (
+    std::string* pText,
+    const std::string& spec,
+    char conversion,
+    EDebugPrintArgType type,
+    std::uint32_t value )
+{
+    float floatValue;
+    std::memcpy ( & floatValue, & value, sizeof ( float ) );
+
+    const std::int32_t intValue = static_cast< std::int32_t >( value );
+
+    char buffer [ 128 ];
+    buffer [ 0 ] = 0;
+
+    switch ( conversion )
+    {
+        case 'd':
+        case 'i':
+        {
+            const long long v =
+                type == DPA_INT ? static_cast< long long >( intValue )
+                : type == DPA_UINT ? static_cast< long long >( value )
+                : static_cast< long long >( floatValue );
+
+            std::snprintf ( buffer, sizeof ( buffer ), ( spec + "lld" ).c_str(), v );
+            break;
+        }
+
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        {
+            const unsigned long long v =
+                type == DPA_FLOAT ? static_cast< unsigned long long >( floatValue )
+                : static_cast< unsigned long long >( value );
+
+            std::snprintf ( buffer, sizeof ( buffer ), ( spec + "ll" + conversion ).c_str(), v );
+            break;
+        }
+
+        case 'c':
+            std::snprintf ( buffer, sizeof ( buffer ), ( spec + 'c' ).c_str(), static_cast< int >( value & 0xFF ) );
+            break;
+
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+        {
+            const double v =
+                type == DPA_FLOAT ? static_cast< double >( floatValue )
+                : type == DPA_INT ? static_cast< double >( intValue )
+                : static_cast< double >( value );
+
+            std::snprintf ( buffer, sizeof ( buffer ), ( spec + conversion ).c_str(), v );
+            break;
+        }
+
+        default:
+        {
+            // Unknown conversion. Print the value in its natural form.
+
+            if ( type == DPA_FLOAT )
+                std::snprintf ( buffer, sizeof ( buffer ), "%g", static_cast< double >( floatValue ) );
+            else if ( type == DPA_INT )
+                std::snprintf ( buffer, sizeof ( buffer ), "%d", static_cast< int >( intValue ) );
+            else
+                std::snprintf ( buffer, sizeof ( buffer ), "%u", static_cast< unsigned int >( value ) );
+        }
+    }
+
+    *pText += buffer;
+}
+
+// -----------------------------------------------------------------------------
+
+// Subset of printf() syntax: flags, width, precision and conversion.
+// Length modifiers are ignored. Vector arguments consume one conversion
+// and are printed as parenthesized lists.
+
+static std::string formatRecord (
+    const std::string& format,
+    const std::vector< SDebugPrintArg >& args,
+    const std::uint32_t* pValues )
+{
+    std::string result;
+    size_t iArg = 0;
+
+    for ( size_t iChar = 0; iChar != format.size(); ++iChar )
+    {
+        if ( format [ iChar ] != '%' )
+        {
+            result += format [ iChar ];
+            continue;
+        }
+
+        if ( iChar + 1 < format.size() && format [ iChar + 1 ] == '%' )
+        {
+            result += '%';
+            ++iChar;
+            continue;
+        }
+
+        std::string spec ( 1, '%' );
+
+        for ( ++iChar; iChar != format.size(); ++iChar )
+        {
+            const char c = format [ iChar ];
+
+            if ( std::strchr ( "-+ #0123456789.", c ) )
+                spec += c;
+            else if ( ! std::strchr ( "hlLqjzt", c ) )
+                break;
+        }
+
+        if ( iChar == format.size() )
+            break;
+
+        if ( iArg == args.size() )
+        {
+            result += "<?>";
+            continue;
+        }
+
+        const SDebugPrintArg& arg = args [ iArg++ ];
+
+        if ( arg.d_components > 1 )
+            result += '(';
+
+        for ( std::uint32_t iComponent = 0; iComponent != arg.d_components; ++iComponent )
+        {
+            if ( iComponent )
+                result += ", ";
+
+            formatValue ( & result, spec, format [ iChar ], arg.d_type, *pValues++ );
+        }
+
+        if ( arg.d_components > 1 )
+            result += ')';
+    }
+
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t DebugPrintBuffer :: read ( std::vector< SDebugPrintRecord >* pRecords )
+{
+    DebugPrintBufferImpl* pImpl = get();
+    std::lock_guard< std::mutex > lock ( pImpl->d_mutex );
+
+    pImpl->d_storage.memory().syncFromDevice();
+
+    std::uint32_t* pHeader = pImpl->header();
+    const std::uint32_t* pData = pHeader + HDR_SIZE;
+    const std::uint32_t mask = pImpl->d_capacity - 1;
+
+    const std::uint32_t writeCursor = pHeader [ HDR_WRITE_CURSOR ];
+    const std::uint32_t readCursor = pHeader [ HDR_READ_CURSOR ];
+    const std::uint32_t written = std::min ( writeCursor - readCursor, pImpl->d_capacity );
+
+    std::vector< std::uint32_t > values;
+    size_t nRecords = 0;
+
+    // Cursors are free-running and wrap around at 2^32, so all positions
+    // are computed relative to the read cursor.
+
+    for ( std::uint32_t position = 0; position < written; )
+    {
+        const std::uint32_t formatIndex = pData [ ( readCursor + position ) & mask ];
+
+        if ( formatIndex >= pImpl->d_formats.size() )
+            break;
+
+        const DebugPrintBufferImpl::SFormat& format = pImpl->d_formats [ formatIndex ];
+
+        // A record which does not fit was dropped. So were all following ones.
+        if ( position + format.d_recordSize > written )
+            break;
+
+        values.resize ( format.d_recordSize );
+
+        for ( std::uint32_t iWord = 0; iWord != format.d_recordSize; ++iWord )
+            values [ iWord ] = pData [ ( readCursor + position + iWord ) & mask ];
+
+        SDebugPrintRecord record;
+        record.d_formatIndex = formatIndex;
+        record.d_invocation [ 0 ] = static_cast< int >( values [ 1 ] );
+        record.d_invocation [ 1 ] = static_cast< int >( values [ 2 ] );
+        record.d_invocation [ 2 ] = static_cast< int >( values [ 3 ] );
+
+        record.d_text = formatRecord (
+            format.d_text, format.d_args, & values [ RECORD_HEADER_SIZE ] );
+
+        pRecords->push_back ( record );
+        position += format.d_recordSize;
+        ++nRecords;
+    }
+
+    // Everything reserved so far is consumed, including dropped records.
+
+    pImpl->d_droppedCount = pHeader [ HDR_DROPPED ];
+    pHeader [ HDR_READ_CURSOR ] = writeCursor;
+    pHeader [ HDR_DROPPED ] = 0;
+    pImpl->syncHeaderToDevice();
+
+    return nRecords;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t DebugPrintBuffer :: dump ( std::ostream& stream )
+{
+    std::vector< SDebugPrintRecord > records;
+    const size_t nRecords = read ( & records );
+
+    for ( const SDebugPrintRecord& record : records )
+    {
+        stream
+            << "[" << record.d_invocation [ 0 ]
+            << "," << record.d_invocation [ 1 ]
+            << "," << record.d_invocation [ 2 ]
+            << "] " << record.d_text << std::endl;
+    }
+
+    if ( const std::uint32_t nDropped = droppedCount() )
+        stream << "DebugPrint: " << nDropped << " record(s) dropped, buffer full." << std::endl;
+
+    return nRecords;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint32_t DebugPrintBuffer :: droppedCount() const
+{
+    DebugPrintBufferImpl* pImpl = get();
+    std::lock_guard< std::mutex > lock ( pImpl->d_mutex );
+    return pImpl->d_droppedCount;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
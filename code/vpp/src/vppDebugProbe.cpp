@@ -68,6 +68,36 @@ void IDebugProbe :: bind (
         0, 0 );
 }
 
+// -----------------------------------------------------------------------------
+
+void IDebugProbe :: bind (
+    const StorageBufferView& hView,
+    std::uint32_t set, std::uint32_t binding,
+    const ShaderDataBlock& hDataBlock )
+{
+    VkDescriptorBufferInfo bufferInfo;
+    bufferInfo.buffer = hView.buffer().handle();
+    bufferInfo.offset = hView.offset();
+    bufferInfo.range = hView.size();
+
+    VkWriteDescriptorSet singleSet;
+    singleSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    singleSet.pNext = 0;
+    singleSet.dstSet = hDataBlock.getDescriptorSet ( set );
+    singleSet.dstBinding = binding;
+    singleSet.dstArrayElement = 0;
+    singleSet.descriptorCount = 1;
+    singleSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    singleSet.pImageInfo = 0;
+    singleSet.pBufferInfo = & bufferInfo;
+    singleSet.pTexelBufferView = 0;
+
+    ::vkUpdateDescriptorSets (
+        hDataBlock.device().handle(),
+        1, & singleSet,
+        0, 0 );
+}
+
 // -----------------------------------------------------------------------------
 } // namespace vpp
 // -----------------------------------------------------------------------------
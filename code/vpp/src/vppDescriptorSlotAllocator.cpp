@@ -0,0 +1,91 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppDescriptorSlotAllocator.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+DescriptorSlotAllocator :: DescriptorSlotAllocator ( std::uint32_t capacity ) :
+    d_capacity ( capacity ),
+    d_nextFreshSlot ( 0 )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint32_t DescriptorSlotAllocator :: acquire()
+{
+    mutex_lock lock ( d_mutex );
+
+    if ( ! d_releasedSlots.empty() )
+    {
+        const std::uint32_t slot = d_releasedSlots.back();
+        d_releasedSlots.pop_back();
+        return slot;
+    }
+
+    if ( d_nextFreshSlot == d_capacity )
+        throw XUsageError ( "All descriptor slots are in use." );
+
+    return d_nextFreshSlot++;
+}
+
+// -----------------------------------------------------------------------------
+
+void DescriptorSlotAllocator :: release ( std::uint32_t slot )
+{
+    mutex_lock lock ( d_mutex );
+
+    if ( slot >= d_nextFreshSlot )
+        throw XUsageError ( "Releasing descriptor slot which was not acquired." );
+
+    d_releasedSlots.push_back ( slot );
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint32_t DescriptorSlotAllocator :: highWaterMark() const
+{
+    mutex_lock lock ( d_mutex );
+    return d_nextFreshSlot;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint32_t DescriptorSlotAllocator :: usedCount() const
+{
+    mutex_lock lock ( d_mutex );
+    return d_nextFreshSlot - static_cast< std::uint32_t >( d_releasedSlots.size() );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
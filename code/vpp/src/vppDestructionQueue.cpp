@@ -0,0 +1,456 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppDestructionQueue.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+// How long the reclaimer blocks on a single fence before re-checking state.
+static const std::uint64_t RECLAIMER_WAIT_NS = 10000000ull;
+
+// -----------------------------------------------------------------------------
+
+DestructionQueue :: DestructionQueue ( VkDevice hDevice ) :
+    d_hDevice ( hDevice ),
+    d_timeline ( 0 ),
+    d_hWaitedFence ( VK_NULL_HANDLE ),
+    d_bWaitedFenceRetired ( false ),
+    d_nExecuting ( 0 ),
+    d_bStopping ( false )
+{
+    // A null device means that device creation failed. No work can be
+    // submitted then, so destruction always happens immediately.
+
+    if ( d_hDevice != VK_NULL_HANDLE )
+        d_reclaimer = std::thread ( [ this ]() { reclaimerThread(); } );
+}
+
+// -----------------------------------------------------------------------------
+
+DestructionQueue :: ~DestructionQueue()
+{
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+        d_bStopping = true;
+    }
+
+    d_wakeup.notify_all();
+
+    if ( d_reclaimer.joinable() )
+        d_reclaimer.join();
+
+    // The device is going away. Wait for everything and destroy the rest.
+
+    if ( d_hDevice != VK_NULL_HANDLE )
+        ::vkDeviceWaitIdle ( d_hDevice );
+
+    for ( SItem& item : d_items )
+        item.d_fDestroy();
+
+    d_items.clear();
+
+    for ( auto& iQueue : d_queues )
+        for ( const auto& iFence : iQueue.second.d_fences )
+            ::vkDestroyFence ( d_hDevice, iFence.second, 0 );
+
+    for ( VkFence hFence : d_freeFences )
+        ::vkDestroyFence ( d_hDevice, hFence, 0 );
+}
+
+// -----------------------------------------------------------------------------
+
+void DestructionQueue :: enqueue ( FDestroy&& fDestroy )
+{
+    Destroyers destroyers;
+
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+
+        if ( computeCompleted() != d_timeline )
+        {
+            SItem item;
+            item.d_timelineValue = d_timeline;
+            item.d_fDestroy = std::move ( fDestroy );
+            d_items.push_back ( std::move ( item ) );
+            d_wakeup.notify_one();
+            return;
+        }
+
+        // Nothing in flight. Earlier requests (if any) go first, to keep
+        // dependent objects (e.g. buffer and its memory) in order.
+        collectCompleted ( & destroyers );
+    }
+
+    execute ( & destroyers );
+    fDestroy();
+}
+
+// -----------------------------------------------------------------------------
+
+VkFence DestructionQueue :: registerSubmission ( VkQueue hQueue, bool bFenceSlotFree )
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+
+    SQueueState& state = d_queues [ hQueue ];
+    retireFences ( & state );
+
+    // Every submission gets a tracking fence. If the submission has its own
+    // fence, an extra empty submission signals ours. The user fence can not
+    // serve as the retirement point, as it may be reset or destroyed at any
+    // time. Without a fence, objects released later would wait for some
+    // unrelated tracked submission, possibly forever.
+
+    const std::uint64_t submissionIndex = ++d_timeline;
+    state.d_lastSubmitted = submissionIndex;
+
+    const VkFence hFence = acquireFence();
+
+    if ( hFence != VK_NULL_HANDLE )
+    {
+        state.d_fences.emplace_back ( submissionIndex, hFence );
+        d_wakeup.notify_one();
+    }
+
+    return hFence;
+}
+
+// -----------------------------------------------------------------------------
+
+void DestructionQueue :: onQueueIdle ( VkQueue hQueue )
+{
+    Destroyers destroyers;
+
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+
+        const auto iQueue = d_queues.find ( hQueue );
+
+        if ( iQueue != d_queues.end() )
+        {
+            SQueueState& state = iQueue->second;
+            retireFences ( & state );
+
+            // Fences acquired for submissions still being made on other
+            // threads may remain unsignaled. Do not skip over them.
+            if ( state.d_fences.empty() )
+                state.d_lastCompleted = state.d_lastSubmitted;
+        }
+
+        collectCompleted ( & destroyers );
+    }
+
+    execute ( & destroyers );
+}
+
+// -----------------------------------------------------------------------------
+
+void DestructionQueue :: onDeviceIdle()
+{
+    Destroyers destroyers;
+
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+
+        for ( auto& iQueue : d_queues )
+        {
+            SQueueState& state = iQueue.second;
+            retireFences ( & state );
+
+            if ( state.d_fences.empty() )
+                state.d_lastCompleted = state.d_lastSubmitted;
+        }
+
+        collectCompleted ( & destroyers );
+    }
+
+    execute ( & destroyers );
+}
+
+// -----------------------------------------------------------------------------
+
+bool DestructionQueue :: flush ( std::uint64_t timeoutNs )
+{
+    std::unique_lock< std::mutex > lock ( d_mutex );
+
+    // Requests made later may get the same timeline value. Waiting for them
+    // as well does no harm, they complete at the same point.
+
+    const std::uint64_t lastValue =
+        d_items.empty() ? 0 : d_items.back().d_timelineValue;
+
+    const auto bFlushed = [ this, lastValue ]()
+    {
+        return ( d_items.empty() || d_items.front().d_timelineValue > lastValue )
+            && d_nExecuting == 0;
+    };
+
+    if ( bFlushed() )
+        return true;
+
+    d_wakeup.notify_one();
+
+    if ( timeoutNs == std::numeric_limits< std::uint64_t >::max() )
+    {
+        d_executed.wait ( lock, bFlushed );
+        return true;
+    }
+
+    return d_executed.wait_for (
+        lock, std::chrono::nanoseconds ( timeoutNs ), bFlushed );
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t DestructionQueue :: timeline() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    return d_timeline;
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t DestructionQueue :: completedTimeline() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+
+    std::uint64_t completed = d_timeline;
+
+    for ( const auto& iQueue : d_queues )
+        if ( iQueue.second.d_lastCompleted != iQueue.second.d_lastSubmitted )
+            completed = std::min ( completed, iQueue.second.d_lastCompleted );
+
+    return completed;
+}
+
+// -----------------------------------------------------------------------------
+
+size_t DestructionQueue :: pendingCount() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    return d_items.size();
+}
+
+// -----------------------------------------------------------------------------
+
+void DestructionQueue :: retireFences ( SQueueState* pState )
+{
+    // Fences are retired in submission order only. A signaled fence means
+    // that all earlier submissions to the same queue have completed too.
+
+    while ( ! pState->d_fences.empty() )
+    {
+        const std::pair< std::uint64_t, VkFence >& front = pState->d_fences.front();
+
+        if ( ::vkGetFenceStatus ( d_hDevice, front.second ) != VK_SUCCESS )
+            break;
+
+        pState->d_lastCompleted = front.first;
+
+        if ( front.second == d_hWaitedFence )
+            d_bWaitedFenceRetired = true;
+        else
+            releaseFence ( front.second );
+
+        pState->d_fences.pop_front();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t DestructionQueue :: computeCompleted()
+{
+    // Timeline value up to which all submissions on all queues have completed.
+    // Queues with no outstanding work do not limit it.
+
+    std::uint64_t completed = d_timeline;
+
+    for ( auto& iQueue : d_queues )
+    {
+        SQueueState& state = iQueue.second;
+        retireFences ( & state );
+
+        if ( state.d_lastCompleted != state.d_lastSubmitted )
+            completed = std::min ( completed, state.d_lastCompleted );
+    }
+
+    return completed;
+}
+
+// -----------------------------------------------------------------------------
+
+void DestructionQueue :: collectCompleted ( Destroyers* pDestroyers )
+{
+    const std::uint64_t completed = computeCompleted();
+
+    // Items are ordered by timeline value, as the timeline never goes back.
+
+    while ( ! d_items.empty() && d_items.front().d_timelineValue <= completed )
+    {
+        pDestroyers->push_back ( std::move ( d_items.front().d_fDestroy ) );
+        d_items.pop_front();
+        ++d_nExecuting;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void DestructionQueue :: execute ( Destroyers* pDestroyers )
+{
+    // Called without the lock, on requests taken by collectCompleted().
+
+    if ( pDestroyers->empty() )
+        return;
+
+    for ( FDestroy& fDestroy : *pDestroyers )
+        fDestroy();
+
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    d_nExecuting -= pDestroyers->size();
+    d_executed.notify_all();
+}
+
+// -----------------------------------------------------------------------------
+
+VkFence DestructionQueue :: oldestBlockingFence() const
+{
+    // Finds the fence which is holding back the completed timeline value.
+
+    VkFence hResult = VK_NULL_HANDLE;
+    std::uint64_t lowest = d_timeline;
+
+    for ( const auto& iQueue : d_queues )
+    {
+        const SQueueState& state = iQueue.second;
+
+        if ( state.d_lastCompleted != state.d_lastSubmitted
+             && state.d_lastCompleted < lowest
+             && ! state.d_fences.empty() )
+        {
+            lowest = state.d_lastCompleted;
+            hResult = state.d_fences.front().second;
+        }
+    }
+
+    return hResult;
+}
+
+// -----------------------------------------------------------------------------
+
+VkFence DestructionQueue :: acquireFence()
+{
+    if ( ! d_freeFences.empty() )
+    {
+        const VkFence hFence = d_freeFences.back();
+        d_freeFences.pop_back();
+        return hFence;
+    }
+
+    VkFenceCreateInfo fenceCreateInfo;
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceCreateInfo.pNext = 0;
+    fenceCreateInfo.flags = 0;
+
+    VkFence hFence = VK_NULL_HANDLE;
+
+    if ( ::vkCreateFence ( d_hDevice, & fenceCreateInfo, 0, & hFence ) != VK_SUCCESS )
+        return VK_NULL_HANDLE;
+
+    return hFence;
+}
+
+// -----------------------------------------------------------------------------
+
+void DestructionQueue :: releaseFence ( VkFence hFence )
+{
+    ::vkResetFences ( d_hDevice, 1, & hFence );
+    d_freeFences.push_back ( hFence );
+}
+
+// -----------------------------------------------------------------------------
+
+void DestructionQueue :: reclaimerThread()
+{
+    std::unique_lock< std::mutex > lock ( d_mutex );
+
+    while ( ! d_bStopping )
+    {
+        if ( d_items.empty() )
+        {
+            d_wakeup.wait ( lock );
+            continue;
+        }
+
+        Destroyers destroyers;
+        collectCompleted ( & destroyers );
+
+        if ( ! destroyers.empty() )
+        {
+            lock.unlock();
+
+            for ( FDestroy& fDestroy : destroyers )
+                fDestroy();
+
+            lock.lock();
+            d_nExecuting -= destroyers.size();
+            d_executed.notify_all();
+            continue;
+        }
+
+        // Wait without the lock. Fences are destroyed only after this thread
+        // finishes. The waited fence may be retired by another thread in the
+        // meantime, but it stays out of the free list (and is not reset)
+        // until the wait ends.
+
+        const VkFence hFence = oldestBlockingFence();
+
+        if ( hFence != VK_NULL_HANDLE )
+        {
+            d_hWaitedFence = hFence;
+            lock.unlock();
+            ::vkWaitForFences ( d_hDevice, 1, & hFence, VK_TRUE, RECLAIMER_WAIT_NS );
+            lock.lock();
+            d_hWaitedFence = VK_NULL_HANDLE;
+
+            if ( d_bWaitedFenceRetired )
+            {
+                d_bWaitedFenceRetired = false;
+                releaseFence ( hFence );
+            }
+        }
+        else
+            d_wakeup.wait ( lock );
+    }
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
@@ -30,6 +30,10 @@
 #include "../include/vppDevice.hpp"
 #include "../include/vppCommandPool.hpp"
 #include "../include/vppPipelineCache.hpp"
+#include "../include/vppMemoryBudget.hpp"
+#include "../include/vppLayoutCache.hpp"
+#include "../include/vppSamplerCache.hpp"
+#include "../include/vppDestructionQueue.hpp"
 #include "../include/vppInstance.hpp"
 
 #include <iterator>
@@ -139,13 +143,22 @@ DeviceImpl :: DeviceImpl (
         d_transferQueueCount ( 0 ),
         d_pDefaultGraphicsCmdPool ( 0 ),
         d_pDefaultTransferCmdPool ( 0 ),
-        d_pDefaultPipelineCache ( 0 )
+        d_pDefaultPipelineCache ( 0 ),
+        d_pMemoryBudget ( 0 ),
+        d_pLayoutCache ( 0 ),
+        d_pSamplerCache ( 0 ),
+        d_pDestructionQueue ( 0 ),
+        d_pfnCmdPushDescriptorSet ( 0 ),
+        d_pfnCmdDrawIndexedIndirectCount ( 0 )
 {
     d_enabledExtensions.emplace ( VK_KHR_SWAPCHAIN_EXTENSION_NAME );
     d_enabledExtensions.emplace ( VK_KHR_MAINTENANCE1_EXTENSION_NAME );
     d_enabledExtensions.emplace ( VK_KHR_MAINTENANCE2_EXTENSION_NAME );
     d_enabledExtensions.emplace ( VK_KHR_MAINTENANCE3_EXTENSION_NAME );
 
+    // Query-only extension, removed below if not supported.
+    d_enabledExtensions.emplace ( VK_EXT_MEMORY_BUDGET_EXTENSION_NAME );
+
     if ( pFeatures )
     {
         d_enabledFeatures = *pFeatures;
@@ -252,6 +265,36 @@ DeviceImpl :: DeviceImpl (
     }
 
     d_result = ::vkCreateDevice ( hPhysicalDevice.handle(), & createInfo, 0, & d_handle );
+
+    if ( d_result == VK_SUCCESS
+         && d_enabledExtensions.count ( VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME ) )
+    {
+        d_pfnCmdPushDescriptorSet =
+            reinterpret_cast< PFN_vkCmdPushDescriptorSetKHR >(
+                ::vkGetDeviceProcAddr ( d_handle, "vkCmdPushDescriptorSetKHR" ) );
+    }
+
+    if ( d_result == VK_SUCCESS
+         && d_enabledExtensions.count ( VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME ) )
+    {
+        d_pfnCmdDrawIndexedIndirectCount =
+            reinterpret_cast< PFN_vkCmdDrawIndexedIndirectCountKHR >(
+                ::vkGetDeviceProcAddr ( d_handle, "vkCmdDrawIndexedIndirectCountKHR" ) );
+    }
+
+    // Budget query requires vkGetPhysicalDeviceMemoryProperties2 (core in 1.1).
+
+    d_pMemoryBudget = new MemoryBudget (
+        hPhysicalDevice,
+        d_enabledExtensions.count ( VK_EXT_MEMORY_BUDGET_EXTENSION_NAME ) != 0
+        && ! ( d_supportedVersion < SVulkanVersion { 1, 1, 0 } ) );
+
+    // The reclaimer thread is started only for a valid device.
+    d_pDestructionQueue = new DestructionQueue (
+        d_result == VK_SUCCESS ? d_handle : VK_NULL_HANDLE );
+
+    d_pLayoutCache = new LayoutCache ( d_handle, d_pDestructionQueue );
+    d_pSamplerCache = new SamplerCache ( d_handle, d_pDestructionQueue );
 }
 
 // -----------------------------------------------------------------------------
@@ -269,8 +312,15 @@ DeviceImpl :: ~DeviceImpl()
 {
     VPP_EXTSYNC_MTX_SLOCK ( this );
 
+    // Must go first, as it waits for the device and executes pending
+    // destruction requests (which may refer to the memory budget).
+    delete d_pDestructionQueue;
+
     delete d_pDefaultGraphicsCmdPool;
     delete d_pDefaultTransferCmdPool;
+    delete d_pMemoryBudget;
+    delete d_pLayoutCache;
+    delete d_pSamplerCache;
 
     if ( d_result == VK_SUCCESS )
     {
@@ -388,6 +438,46 @@ PipelineCache& Device :: defaultPipelineCache() const
 
 // -----------------------------------------------------------------------------
 
+MemoryBudget& Device :: memoryBudget() const
+{
+    return *get()->d_pMemoryBudget;
+}
+
+// -----------------------------------------------------------------------------
+
+LayoutCache& Device :: layoutCache() const
+{
+    return *get()->d_pLayoutCache;
+}
+
+// -----------------------------------------------------------------------------
+
+SamplerCache& Device :: samplerCache() const
+{
+    return *get()->d_pSamplerCache;
+}
+
+// -----------------------------------------------------------------------------
+
+DestructionQueue& Device :: destructionQueue() const
+{
+    return *get()->d_pDestructionQueue;
+}
+
+// -----------------------------------------------------------------------------
+
+VkResult Device :: waitForIdle() const
+{
+    const VkResult result = ::vkDeviceWaitIdle ( get()->d_handle );
+
+    if ( result == VK_SUCCESS )
+        get()->d_pDestructionQueue->onDeviceIdle();
+
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
 bool Device :: supportsVersion ( const SVulkanVersion& ver ) const
 {
     return ! ( get()->d_supportedVersion < ver );
@@ -29,6 +29,14 @@
 #include "ph.hpp"
 #include "../include/vppDeviceMemory.hpp"
 #include "../include/vppExceptions.hpp"
+#include "../include/vppMemoryBudget.hpp"
+
+#if defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #define VPP_STREAMING_STORES 1
+    #include <emmintrin.h>
+#else
+    #define VPP_STREAMING_STORES 0
+#endif
 
 // -----------------------------------------------------------------------------
 namespace vpp {
@@ -103,7 +111,8 @@ MemProfile :: MemProfile (
     bool bForceHostVisible ) :
         d_pWantedProperties ( pWantedProperties ),
         d_nWantedProperties ( nWantedProperties ),
-        d_bForceHostVisible ( bForceHostVisible )
+        d_bForceHostVisible ( bForceHostVisible ),
+        d_bLowPriority ( false )
 {
 }
 
@@ -114,7 +123,8 @@ MemProfile :: MemProfile (
     bool bForceHostVisible ) :
         d_pWantedProperties ( rhs.d_pWantedProperties ),
         d_nWantedProperties ( rhs.d_nWantedProperties ),
-        d_bForceHostVisible ( bForceHostVisible )
+        d_bForceHostVisible ( bForceHostVisible ),
+        d_bLowPriority ( rhs.d_bLowPriority )
 {
 }
 
@@ -123,7 +133,18 @@ MemProfile :: MemProfile (
 MemProfile :: MemProfile ( ECharacteristic eChar ) :
     d_pWantedProperties ( s_wantedProperties [ eChar ] ),
     d_nWantedProperties ( s_wantedPropertiesCount [ eChar ] ),
-    d_bForceHostVisible ( false )
+    d_bForceHostVisible ( false ),
+    d_bLowPriority ( false )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+MemProfile :: MemProfile ( ECharacteristic eChar, EPriority ePriority ) :
+    d_pWantedProperties ( s_wantedProperties [ eChar ] ),
+    d_nWantedProperties ( s_wantedPropertiesCount [ eChar ] ),
+    d_bForceHostVisible ( false ),
+    d_bLowPriority ( ePriority == PRIORITY_LOW )
 {
 }
 
@@ -174,7 +195,8 @@ VkDeviceSize DeviceMemory :: availableMemory (
     const std::uint32_t heapIndex =
         devMemProperties.memoryTypes [ memoryTypeIndex ].heapIndex;
 
-    return devMemProperties.memoryHeaps [ heapIndex ].size;
+    const SHeapBudget heap = hDevice.memoryBudget().heap ( heapIndex );
+    return heap.d_usage < heap.d_budget ? heap.d_budget - heap.d_usage : 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -191,7 +213,12 @@ DeviceMemoryImpl :: DeviceMemoryImpl (
         d_properties ( 0 ),
         d_pMappedBegin ( 0 ),
         d_pMappedEnd ( 0 ),
-        d_size ( size )
+        d_size ( size ),
+        d_heapIndex ( 0 ),
+        d_pPersistentBegin ( 0 ),
+        d_nonCoherentAtomSize (
+            std::max ( hDevice.physical().properties().limits.nonCoherentAtomSize,
+                       static_cast< VkDeviceSize >( 1 ) ) )
 {
     const VkPhysicalDeviceMemoryProperties devMemProperties =
         d_hDevice.physical().getMemoryProperties();
@@ -233,16 +260,116 @@ DeviceMemoryImpl :: DeviceMemoryImpl (
         memoryTypeIndex = findMemoryTypeIndex ( typeMask, d_properties, devMemProperties );
     }
 
+    allocate ( typeMask, memoryTypeIndex, memProfile.isLowPriority(), devMemProperties );
+}
+
+// -----------------------------------------------------------------------------
+
+void DeviceMemoryImpl :: allocate (
+    std::uint32_t typeMask,
+    std::uint32_t memoryTypeIndex,
+    bool bLowPriority,
+    const VkPhysicalDeviceMemoryProperties& devMemProperties )
+{
+    static const unsigned int MAX_RETRIES = 4;
+    static const std::uint64_t FLUSH_TIMEOUT_NS = 1000000000ull;
+
+    MemoryBudget& budget = d_hDevice.memoryBudget();
+    unsigned int nRetries = 0;
+    bool bDemoted = false;
+
+    while ( memoryTypeIndex < devMemProperties.memoryTypeCount )
     {
+        d_heapIndex = devMemProperties.memoryTypes [ memoryTypeIndex ].heapIndex;
+
+        const bool bFits = budget.fitsInBudget ( d_heapIndex, d_size );
+
+        if ( bFits )
+        {
+            VkMemoryAllocateInfo memoryAllocateInfo;
+            memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            memoryAllocateInfo.pNext = 0;
+            memoryAllocateInfo.allocationSize = d_size;
+            memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+            d_result = ::vkAllocateMemory (
+                d_hDevice.handle(), & memoryAllocateInfo, 0, & d_handle );
+
+            if ( d_result != VK_ERROR_OUT_OF_DEVICE_MEMORY
+                 && d_result != VK_ERROR_OUT_OF_HOST_MEMORY )
+            {
+                break;
+            }
+        }
+
+        // Over budget, or the driver refused. Let the policy make room.
+
+        const MemoryBudget::EPressureAction action =
+            budget.onPressure ( d_heapIndex, d_size, bLowPriority );
+
+        if ( action == MemoryBudget::PRESSURE_RETRY && nRetries < MAX_RETRIES )
+        {
+            // Memory released by the pressure callback is freed (and leaves
+            // the budget) only after the GPU is done with it.
+            d_hDevice.destructionQueue().flush ( FLUSH_TIMEOUT_NS );
+            ++nRetries;
+            continue;
+        }
+
+        if ( action == MemoryBudget::PRESSURE_DEMOTE && bLowPriority && ! bDemoted )
+        {
+            bDemoted = true;
+
+            const std::uint32_t hostProperties =
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+            std::uint32_t hostTypeIndex = std::numeric_limits< std::uint32_t >::max();
+
+            for ( std::uint32_t i = 0; i < devMemProperties.memoryTypeCount; ++i )
+            {
+                const VkMemoryType& memoryType = devMemProperties.memoryTypes [ i ];
+
+                if ( ( typeMask & ( 1 << i ) )
+                       && memoryType.heapIndex != d_heapIndex
+                       && ( memoryType.propertyFlags & hostProperties ) == hostProperties
+                       && ! ( devMemProperties.memoryHeaps [ memoryType.heapIndex ].flags
+                              & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT ) )
+                {
+                    hostTypeIndex = i;
+                    break;
+                }
+            }
+
+            if ( hostTypeIndex != std::numeric_limits< std::uint32_t >::max() )
+            {
+                // Report what the fallback type really has, e.g. whether
+                // it is cached, so that flushes are done as needed.
+
+                memoryTypeIndex = hostTypeIndex;
+                d_properties = devMemProperties.memoryTypes [ hostTypeIndex ].propertyFlags;
+                continue;
+            }
+        }
+
+        if ( bFits )
+            break;
+
+        // Budget is a soft limit. The driver may still succeed, e.g. by paging.
+
         VkMemoryAllocateInfo memoryAllocateInfo;
         memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
         memoryAllocateInfo.pNext = 0;
-        memoryAllocateInfo.allocationSize = size;
+        memoryAllocateInfo.allocationSize = d_size;
         memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
 
         d_result = ::vkAllocateMemory (
             d_hDevice.handle(), & memoryAllocateInfo, 0, & d_handle );
+
+        break;
     }
+
+    if ( d_result == VK_SUCCESS )
+        budget.onAllocated ( d_heapIndex, d_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -253,7 +380,25 @@ DeviceMemoryImpl :: ~DeviceMemoryImpl()
 
     if ( d_result == VK_SUCCESS )
     {
-        ::vkFreeMemory ( d_hDevice.handle(), d_handle, 0 );
+        if ( d_pMappedBegin || d_pPersistentBegin )
+            ::vkUnmapMemory ( d_hDevice.handle(), d_handle );
+
+        // Freeing is deferred until the GPU is done with the memory. The budget
+        // object outlives the destruction queue, so it can be referenced here.
+
+        const VkDevice hDevice = d_hDevice.handle();
+        const VkDeviceMemory hMemory = d_handle;
+        const std::uint32_t heapIndex = d_heapIndex;
+        const VkDeviceSize size = d_size;
+        MemoryBudget* pBudget = & d_hDevice.memoryBudget();
+
+        d_hDevice.destructionQueue().enqueue (
+            [ hDevice, hMemory, heapIndex, size, pBudget ]()
+            {
+                ::vkFreeMemory ( hDevice, hMemory, 0 );
+                pBudget->onFreed ( heapIndex, size );
+            } );
+
         d_result = VK_NOT_READY;
     }
 }
@@ -287,6 +432,165 @@ MappableDeviceMemory :: MappableDeviceMemory ( const DeviceMemory& mem ) :
         throw XDeviceMemoryTypeError();
 }
 
+// -----------------------------------------------------------------------------
+
+VkResult MappableDeviceMemory :: mapPersistently()
+{
+    DeviceMemoryImpl* pImpl = get();
+
+    if ( pImpl->d_pPersistentBegin )
+        return VK_SUCCESS;
+
+    // Drop any temporary mapping, Vulkan allows only one at a time.
+    unmap();
+
+    VPP_EXTSYNC_MTX_SLOCK ( pImpl );
+
+    void* pMapped = 0;
+
+    const VkResult result = ::vkMapMemory (
+        pImpl->d_hDevice.handle(), pImpl->d_handle, 0, VK_WHOLE_SIZE, 0, & pMapped );
+
+    if ( result == VK_SUCCESS )
+    {
+        pImpl->d_pPersistentBegin = static_cast< unsigned char* >( pMapped );
+        pImpl->d_pMappedBegin = pImpl->d_pPersistentBegin;
+        pImpl->d_pMappedEnd = pImpl->d_pPersistentBegin + pImpl->d_size;
+    }
+
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool getAlignedRange (
+    VkDeviceSize offset,
+    VkDeviceSize size,
+    VkDeviceSize memorySize,
+    VkDeviceSize atomSize,
+    VkMappedMemoryRange* pRange )
+{
+    if ( offset >= memorySize || size == 0 )
+        return false;
+
+    // nonCoherentAtomSize is guaranteed to be a power of two. The end of the
+    // range must either be aligned or equal to the end of the allocation.
+
+    const VkDeviceSize end = (
+        size == VK_WHOLE_SIZE || size >= memorySize - offset ?
+            memorySize : offset + size );
+
+    pRange->offset = offset & ~( atomSize - 1 );
+
+    const VkDeviceSize alignedEnd = ( end + atomSize - 1 ) & ~( atomSize - 1 );
+
+    pRange->size = (
+        alignedEnd >= memorySize ? VK_WHOLE_SIZE : alignedEnd - pRange->offset );
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void MappableDeviceMemory :: syncFromDevice ( VkDeviceSize offset, VkDeviceSize size )
+{
+    if ( isHostCoherent() )
+        return;
+
+    VkMappedMemoryRange memoryRange;
+    memoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    memoryRange.pNext = 0;
+    memoryRange.memory = handle();
+
+    if ( getAlignedRange (
+            offset, size, get()->d_size, get()->d_nonCoherentAtomSize, & memoryRange ) )
+    {
+        ::vkInvalidateMappedMemoryRanges ( get()->d_hDevice.handle(), 1, & memoryRange );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void MappableDeviceMemory :: syncToDevice ( VkDeviceSize offset, VkDeviceSize size )
+{
+    if ( isHostCoherent() )
+        return;
+
+    VkMappedMemoryRange memoryRange;
+    memoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    memoryRange.pNext = 0;
+    memoryRange.memory = handle();
+
+    if ( getAlignedRange (
+            offset, size, get()->d_size, get()->d_nonCoherentAtomSize, & memoryRange ) )
+    {
+        ::vkFlushMappedMemoryRanges ( get()->d_hDevice.handle(), 1, & memoryRange );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+namespace detail {
+// -----------------------------------------------------------------------------
+
+void copyToWriteCombined ( void* pDest, const void* pSource, size_t size )
+{
+#if VPP_STREAMING_STORES
+    unsigned char* pDst = static_cast< unsigned char* >( pDest );
+    const unsigned char* pSrc = static_cast< const unsigned char* >( pSource );
+
+    // Non-temporal stores need 16-byte aligned destination.
+
+    const size_t head = static_cast< size_t >(
+        ( 16 - ( reinterpret_cast< std::uintptr_t >( pDst ) & 15 ) ) & 15 );
+
+    if ( size < head + 64 )
+    {
+        std::memcpy ( pDst, pSrc, size );
+        return;
+    }
+
+    std::memcpy ( pDst, pSrc, head );
+    pDst += head;
+    pSrc += head;
+    size -= head;
+
+    // Full 64-byte blocks, so that whole write-combining buffers are
+    // filled at once.
+
+    for ( ; size >= 64; size -= 64, pDst += 64, pSrc += 64 )
+    {
+        const __m128i v0 = _mm_loadu_si128 ( reinterpret_cast< const __m128i* >( pSrc ) );
+        const __m128i v1 = _mm_loadu_si128 ( reinterpret_cast< const __m128i* >( pSrc + 16 ) );
+        const __m128i v2 = _mm_loadu_si128 ( reinterpret_cast< const __m128i* >( pSrc + 32 ) );
+        const __m128i v3 = _mm_loadu_si128 ( reinterpret_cast< const __m128i* >( pSrc + 48 ) );
+
+        _mm_stream_si128 ( reinterpret_cast< __m128i* >( pDst ), v0 );
+        _mm_stream_si128 ( reinterpret_cast< __m128i* >( pDst + 16 ), v1 );
+        _mm_stream_si128 ( reinterpret_cast< __m128i* >( pDst + 32 ), v2 );
+        _mm_stream_si128 ( reinterpret_cast< __m128i* >( pDst + 48 ), v3 );
+    }
+
+    for ( ; size >= 16; size -= 16, pDst += 16, pSrc += 16 )
+        _mm_stream_si128 (
+            reinterpret_cast< __m128i* >( pDst ),
+            _mm_loadu_si128 ( reinterpret_cast< const __m128i* >( pSrc ) ) );
+
+    // Streaming stores are weakly ordered, make them visible before
+    // the memory is flushed or the command buffer is submitted.
+
+    _mm_sfence();
+
+    std::memcpy ( pDst, pSrc, size );
+#else
+    std::memcpy ( pDest, pSource, size );
+#endif
+}
+
+// -----------------------------------------------------------------------------
+} // namespace detail
+// -----------------------------------------------------------------------------
+
 // -----------------------------------------------------------------------------
 } // namespace vpp
 // -----------------------------------------------------------------------------
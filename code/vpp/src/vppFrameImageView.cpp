@@ -86,7 +86,11 @@ FrameImageViewImpl :: FrameImageViewImpl (
 
 FrameImageViewImpl :: ~FrameImageViewImpl()
 {
-    ::vkDestroyImageView ( d_hDevice.handle(), d_handle, 0 );
+    const VkDevice hDevice = d_hDevice.handle();
+    const VkImageView hImageView = d_handle;
+
+    d_hDevice.destructionQueue().enqueue ( [ hDevice, hImageView ]() {
+        ::vkDestroyImageView ( hDevice, hImageView, 0 ); } );
 }
 
 // -----------------------------------------------------------------------------
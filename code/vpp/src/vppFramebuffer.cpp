@@ -123,7 +123,13 @@ KFrameBufferImpl :: KFrameBufferImpl (
 KFrameBufferImpl :: ~KFrameBufferImpl()
 {
     if ( d_result == VK_SUCCESS )
-        ::vkDestroyFramebuffer ( d_hDevice.handle(), d_handle, 0 );
+    {
+        const VkDevice hDevice = d_hDevice.handle();
+        const VkFramebuffer hFramebuffer = d_handle;
+
+        d_hDevice.destructionQueue().enqueue ( [ hDevice, hFramebuffer ]() {
+            ::vkDestroyFramebuffer ( hDevice, hFramebuffer, 0 ); } );
+    }
 }
 
 // -----------------------------------------------------------------------------
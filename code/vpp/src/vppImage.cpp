@@ -81,7 +81,13 @@ ImageImpl :: ImageImpl (
 ImageImpl :: ~ImageImpl()
 {
     if ( d_imageInfo.purpose != SWAPCHAIN )
-        ::vkDestroyImage ( d_hDevice.handle(), d_handle, 0 );
+    {
+        const VkDevice hDevice = d_hDevice.handle();
+        const VkImage hImage = d_handle;
+
+        d_hDevice.destructionQueue().enqueue ( [ hDevice, hImage ]() {
+            ::vkDestroyImage ( hDevice, hImage, 0 ); } );
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -80,6 +80,141 @@ void CopyImageToDevice :: init()
     compile();
 }
 
+// -----------------------------------------------------------------------------
+
+std::uint32_t GenerateMipmaps :: fullChainLevels ( const VkExtent3D& extent )
+{
+    std::uint32_t maxDim = std::max ( std::max ( extent.width, extent.height ), extent.depth );
+    std::uint32_t nLevels = 1;
+
+    while ( maxDim > 1 )
+    {
+        maxDim >>= 1;
+        ++nLevels;
+    }
+
+    return nLevels;
+}
+
+// -----------------------------------------------------------------------------
+
+void GenerateMipmaps :: init()
+{
+    const ImageInfo& imgInfo = d_targetImage.info();
+
+    const VkFormatFeatureFlags formatFeatures =
+        d_targetImage.device().physical().supportsFormat ( imgInfo.format );
+
+    const VkFormatFeatureFlags blitFeatures =
+        VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+
+    if ( ( formatFeatures & blitFeatures ) != blitFeatures )
+        throw XUsageError ( "Image format does not support blitting, can not generate mip levels." );
+
+    const VkFilter filter = (
+        ( formatFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT )
+        && imgInfo.getAspect() == VK_IMAGE_ASPECT_COLOR_BIT ?
+            VK_FILTER_LINEAR : VK_FILTER_NEAREST );
+
+    execute << [ this, filter ]()
+    {
+        const ImageInfo& info = d_targetImage.info();
+        const std::uint32_t nLevels = info.mipLevels;
+
+        // Supplied levels below the base one are not touched, only moved
+        // to the final layout.
+
+        if ( d_baseLevel > 0 )
+            cmdChangeImageLayout (
+                d_targetImage,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, d_finalLayout,
+                d_baseLevel, VK_REMAINING_ARRAY_LAYERS, 0, 0, info.getAspect() );
+
+        VkExtent3D srcExtent = info.extent;
+
+        for ( std::uint32_t iLevel = 0; iLevel != d_baseLevel; ++iLevel )
+        {
+            srcExtent.width = std::max ( srcExtent.width >> 1, 1u );
+            srcExtent.height = std::max ( srcExtent.height >> 1, 1u );
+            srcExtent.depth = std::max ( srcExtent.depth >> 1, 1u );
+        }
+
+        std::vector< VkImageBlit > regions ( 1 );
+        VkImageBlit& blit = regions [ 0 ];
+
+        blit.srcSubresource.aspectMask = info.getAspect();
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = info.arrayLayers;
+        blit.dstSubresource = blit.srcSubresource;
+        blit.srcOffsets [ 0 ] = VkOffset3D { 0, 0, 0 };
+        blit.dstOffsets [ 0 ] = VkOffset3D { 0, 0, 0 };
+
+        for ( std::uint32_t iLevel = d_baseLevel; iLevel + 1 < nLevels; ++iLevel )
+        {
+            const VkExtent3D dstExtent = {
+                std::max ( srcExtent.width >> 1, 1u ),
+                std::max ( srcExtent.height >> 1, 1u ),
+                std::max ( srcExtent.depth >> 1, 1u )
+            };
+
+            cmdImagePipelineBarrier (
+                d_targetImage,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                false,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                static_cast< int >( iLevel ) );
+
+            cmdImagePipelineBarrier (
+                d_targetImage,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                false,
+                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                static_cast< int >( iLevel + 1 ) );
+
+            blit.srcSubresource.mipLevel = iLevel;
+            blit.srcOffsets [ 1 ] = VkOffset3D {
+                static_cast< std::int32_t >( srcExtent.width ),
+                static_cast< std::int32_t >( srcExtent.height ),
+                static_cast< std::int32_t >( srcExtent.depth ) };
+
+            blit.dstSubresource.mipLevel = iLevel + 1;
+            blit.dstOffsets [ 1 ] = VkOffset3D {
+                static_cast< std::int32_t >( dstExtent.width ),
+                static_cast< std::int32_t >( dstExtent.height ),
+                static_cast< std::int32_t >( dstExtent.depth ) };
+
+            cmdBlitImage (
+                d_targetImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                d_targetImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                regions, filter );
+
+            cmdImagePipelineBarrier (
+                d_targetImage,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
+                false,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, d_finalLayout,
+                static_cast< int >( iLevel ) );
+
+            srcExtent = dstExtent;
+        }
+
+        // The last level has been only written.
+
+        cmdImagePipelineBarrier (
+            d_targetImage,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+            false,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, d_finalLayout,
+            static_cast< int >( nLevels - 1 ) );
+    };
+
+    compile();
+}
+
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
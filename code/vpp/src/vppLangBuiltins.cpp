@@ -44,12 +44,22 @@ inWorkgroupSize :: operator rvalue_type() const
     {
         std::vector< spv::Id > comps;
         comps.reserve ( 3 );
-        comps.push_back ( pTranslator->makeIntConstant ( d_localSize.x ) );
-        comps.push_back ( pTranslator->makeIntConstant ( d_localSize.y ) );
-        comps.push_back ( pTranslator->makeIntConstant ( d_localSize.z ) );
 
-        d_id = KId ( pTranslator->makeCompositeConstant (
-            IVec3::getType(), comps ) );
+        if ( d_bSpecialized )
+        {
+            comps.push_back ( pTranslator->makeSpecConstant ( d_localSizeIds.x, d_localSize.x ) );
+            comps.push_back ( pTranslator->makeSpecConstant ( d_localSizeIds.y, d_localSize.y ) );
+            comps.push_back ( pTranslator->makeSpecConstant ( d_localSizeIds.z, d_localSize.z ) );
+        }
+        else
+        {
+            comps.push_back ( pTranslator->makeIntConstant ( d_localSize.x ) );
+            comps.push_back ( pTranslator->makeIntConstant ( d_localSize.y ) );
+            comps.push_back ( pTranslator->makeIntConstant ( d_localSize.z ) );
+        }
+
+        d_id = KId ( pTranslator->makeCompositeConstant (
+            IVec3::getType(), comps, d_bSpecialized ) );
 
         pTranslator->addDecoration (
             d_id, spv::DecorationBuiltIn, spv::BuiltInWorkgroupSize );
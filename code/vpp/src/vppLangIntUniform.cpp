@@ -65,6 +65,8 @@ KId KUniformAccess :: init (
         if ( bAddBlockDecoration )
             pTranslator->addDecoration ( structInfo.d_typeId, decoration );
 
+        pTranslator->useBufferStorage ( structInfo.d_typeId, decoration, storageClass );
+
         return pTranslator->registerUniformBuffer ( structInfo.d_typeId, set, binding, storageClass );
     }
     else
@@ -93,6 +95,8 @@ std::pair< KId, KId > KUniformAccess :: init (
         if ( bAddDecorations )
             pTranslator->addDecoration ( structInfo.d_typeId, decoration );
 
+        pTranslator->useBufferStorage ( structInfo.d_typeId, decoration, storageClass );
+
         const KId varId =
             pTranslator->registerUniformBuffer ( arrayType, set, binding, storageClass );
 
@@ -150,6 +154,8 @@ std::pair< KId, KId > KUniformAccess :: init (
                 arrayType, spv::DecorationArrayStride, stride );
         }
 
+        pTranslator->useBufferStorage ( externStructId, decoration, storageClass );
+
         const KId varId =
             pTranslator->registerUniformBuffer ( externStructId, set, binding, storageClass );
 
@@ -202,6 +208,8 @@ std::pair< KId, KId > KUniformAccess :: init (
 
         pTranslator->addMemberDecoration ( externStructId, 0, spv::DecorationOffset, 0 );
 
+        pTranslator->useBufferStorage ( externStructId, decoration, storageClass );
+
         const KId varId =
             pTranslator->registerUniformBuffer ( externStructId, set, binding, storageClass );
 
@@ -127,6 +127,8 @@ void KShaderTranslator :: useCapability ( spv::Capability cap )
         case spv::CapabilityFloat64: requireFeature ( fShaderFloat64 ); break;
         case spv::CapabilityInt64: requireFeature ( fShaderInt64 ); break;
         case spv::CapabilityInt16: requireFeature ( fShaderInt16 ); break;
+        case spv::CapabilityInt8: requireFeature ( fShaderInt8 ); break;
+        case spv::CapabilityFloat16: requireFeature ( fShaderFloat16 ); break;
         case spv::CapabilityImageGatherExtended: requireFeature ( fShaderImageGatherExtended ); break;
         case spv::CapabilityUniformBufferArrayDynamicIndexing: requireFeature ( fShaderUniformBufferArrayDynamicIndexing ); break;
         case spv::CapabilitySampledImageArrayDynamicIndexing: requireFeature ( fShaderSampledImageArrayDynamicIndexing ); break;
@@ -158,6 +160,44 @@ void KShaderTranslator :: useCapability ( spv::Capability cap )
             requireFeature ( fShaderSharedInt64Atomics );
             break;
 
+        case spv::CapabilityStorageBuffer8BitAccess:
+            requireFeature ( fStorageBuffer8BitAccess );
+            addExtension ( "SPV_KHR_8bit_storage" );
+            break;
+
+        case spv::CapabilityUniformAndStorageBuffer8BitAccess:
+            requireFeature ( fUniformAndStorageBuffer8BitAccess );
+            addExtension ( "SPV_KHR_8bit_storage" );
+            break;
+
+        case spv::CapabilityStoragePushConstant8:
+            requireFeature ( fStoragePushConstant8 );
+            addExtension ( "SPV_KHR_8bit_storage" );
+            break;
+
+        case spv::CapabilityStorageBuffer16BitAccess:
+            requireFeature ( fStorageBuffer16BitAccess );
+            addExtension ( "SPV_KHR_16bit_storage" );
+            break;
+
+        case spv::CapabilityUniformAndStorageBuffer16BitAccess:
+            requireFeature ( fUniformAndStorageBuffer16BitAccess );
+            addExtension ( "SPV_KHR_16bit_storage" );
+            break;
+
+        case spv::CapabilityStoragePushConstant16:
+            requireFeature ( fStoragePushConstant16 );
+            addExtension ( "SPV_KHR_16bit_storage" );
+            break;
+
+        case spv::CapabilityUniformBufferArrayNonUniformIndexingEXT: requireFeature ( fShaderUniformBufferArrayNonUniformIndexing ); break;
+        case spv::CapabilitySampledImageArrayNonUniformIndexingEXT: requireFeature ( fShaderSampledImageArrayNonUniformIndexing ); break;
+        case spv::CapabilityStorageBufferArrayNonUniformIndexingEXT: requireFeature ( fShaderStorageBufferArrayNonUniformIndexing ); break;
+        case spv::CapabilityStorageImageArrayNonUniformIndexingEXT: requireFeature ( fShaderStorageImageArrayNonUniformIndexing ); break;
+        case spv::CapabilityInputAttachmentArrayNonUniformIndexingEXT: requireFeature ( fShaderInputAttachmentArrayNonUniformIndexing ); break;
+        case spv::CapabilityUniformTexelBufferArrayNonUniformIndexingEXT: requireFeature ( fShaderUniformTexelBufferArrayNonUniformIndexing ); break;
+        case spv::CapabilityStorageTexelBufferArrayNonUniformIndexingEXT: requireFeature ( fShaderStorageTexelBufferArrayNonUniformIndexing ); break;
+
         default:
             throw XUsageError ( "Unsupported capability has been used" );
     }
@@ -217,9 +257,9 @@ void KShaderTranslator :: print ( std::ostream& output ) const
 
 // -----------------------------------------------------------------------------
 
-void KShaderTranslator :: pushIf ( Bool condition )
+void KShaderTranslator :: pushIf ( Bool condition, unsigned int control )
 {
-    d_ifStack.emplace_back ( condition.id(), *this );
+    d_ifStack.emplace_back ( condition.id(), *this, control );
     d_scopeStack.push_back ( detail::KScope() );
 }
 
@@ -415,6 +455,64 @@ KId KShaderTranslator :: registerLocalVariable ( KId type, spv::StorageClass eCl
 
 // -----------------------------------------------------------------------------
 
+KId KShaderTranslator :: findSpecConstant ( std::uint32_t constantId ) const
+{
+    const auto iConstant = d_specConstants.find ( constantId );
+    return iConstant != d_specConstants.end() ? iConstant->second : KId ( 0 );
+}
+
+// -----------------------------------------------------------------------------
+
+KId KShaderTranslator :: registerSpecConstant ( std::uint32_t constantId, spv::Id id )
+{
+    const KId result ( id );
+    addDecoration ( result, spv::DecorationSpecId, static_cast< int >( constantId ) );
+    d_specConstants.insert ( SpecConstants::value_type ( constantId, result ) );
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+KId KShaderTranslator :: makeSpecConstant ( std::uint32_t constantId, int value )
+{
+    if ( const KId existing = findSpecConstant ( constantId ) )
+        return existing;
+
+    return registerSpecConstant ( constantId, makeIntConstant ( value, true ) );
+}
+
+// -----------------------------------------------------------------------------
+
+KId KShaderTranslator :: makeSpecConstant ( std::uint32_t constantId, unsigned int value )
+{
+    if ( const KId existing = findSpecConstant ( constantId ) )
+        return existing;
+
+    return registerSpecConstant ( constantId, makeUintConstant ( value, true ) );
+}
+
+// -----------------------------------------------------------------------------
+
+KId KShaderTranslator :: makeSpecConstant ( std::uint32_t constantId, float value )
+{
+    if ( const KId existing = findSpecConstant ( constantId ) )
+        return existing;
+
+    return registerSpecConstant ( constantId, makeFloatConstant ( value, true ) );
+}
+
+// -----------------------------------------------------------------------------
+
+KId KShaderTranslator :: makeSpecConstant ( std::uint32_t constantId, bool value )
+{
+    if ( const KId existing = findSpecConstant ( constantId ) )
+        return existing;
+
+    return registerSpecConstant ( constantId, makeBoolConstant ( value, true ) );
+}
+
+// -----------------------------------------------------------------------------
+
 KId KShaderTranslator :: registerUniformBuffer (
     KId type, std::uint32_t set, std::uint32_t binding, spv::StorageClass eClass )
 {
@@ -757,6 +855,154 @@ spv::ImageFormat KShaderTranslator :: validateImageFormat ( spv::ImageFormat fmt
 
 // -----------------------------------------------------------------------------
 
+void KShaderTranslator :: useNonUniformIndexing ( VkDescriptorType descriptorType )
+{
+    spv::Capability cap;
+
+    switch ( descriptorType )
+    {
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            cap = spv::CapabilitySampledImageArrayNonUniformIndexingEXT;
+            break;
+
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            cap = spv::CapabilityStorageImageArrayNonUniformIndexingEXT;
+            break;
+
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            cap = spv::CapabilityUniformTexelBufferArrayNonUniformIndexingEXT;
+            break;
+
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+            cap = spv::CapabilityStorageTexelBufferArrayNonUniformIndexingEXT;
+            break;
+
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            cap = spv::CapabilityUniformBufferArrayNonUniformIndexingEXT;
+            break;
+
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+            cap = spv::CapabilityStorageBufferArrayNonUniformIndexingEXT;
+            break;
+
+        case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+            cap = spv::CapabilityInputAttachmentArrayNonUniformIndexingEXT;
+            break;
+
+        default:
+            throw XUsageError ( "Non-uniform indexing is not supported for this descriptor type" );
+    }
+
+    useCapability ( cap );
+    addCapability ( spv::CapabilityShaderNonUniformEXT );
+    addExtension ( "SPV_EXT_descriptor_indexing" );
+}
+
+// -----------------------------------------------------------------------------
+
+void KShaderTranslator :: decorateNonUniform ( const KId& id )
+{
+    addDecoration ( id, spv::DecorationNonUniformEXT );
+}
+
+// -----------------------------------------------------------------------------
+
+void KShaderTranslator :: useBindingFlags (
+    VkDescriptorType descriptorType, VkDescriptorBindingFlagsEXT flags )
+{
+    if ( flags & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT )
+    {
+        switch ( descriptorType )
+        {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                requireFeature ( fDescriptorBindingSampledImageUpdateAfterBind );
+                break;
+
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                requireFeature ( fDescriptorBindingStorageImageUpdateAfterBind );
+                break;
+
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+                requireFeature ( fDescriptorBindingUniformTexelBufferUpdateAfterBind );
+                break;
+
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                requireFeature ( fDescriptorBindingStorageTexelBufferUpdateAfterBind );
+                break;
+
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                requireFeature ( fDescriptorBindingUniformBufferUpdateAfterBind );
+                break;
+
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                requireFeature ( fDescriptorBindingStorageBufferUpdateAfterBind );
+                break;
+
+            default:
+                throw XUsageError ( "Update after bind is not supported for this descriptor type" );
+        }
+    }
+
+    if ( flags & VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT )
+        requireFeature ( fDescriptorBindingPartiallyBound );
+
+    if ( flags & VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT )
+        requireFeature ( fDescriptorBindingVariableDescriptorCount );
+}
+
+// -----------------------------------------------------------------------------
+
+void KShaderTranslator :: useBufferStorage (
+    spv::Id typeId, spv::Decoration decoration, spv::StorageClass storageClass )
+{
+    // Walks the type of a buffer block and registers storage capabilities
+    // for any 8-bit or 16-bit scalars found inside.
+
+    if ( isStructType ( typeId ) )
+    {
+        const int nMembers = getNumTypeConstituents ( typeId );
+
+        for ( int iMember = 0; iMember != nMembers; ++iMember )
+            useBufferStorage ( getContainedTypeId ( typeId, iMember ), decoration, storageClass );
+    }
+    else if ( isScalarType ( typeId ) )
+    {
+        const int nBits = getNumTypeBits ( typeId );
+
+        // Storage buffers are declared as Uniform storage class with BufferBlock
+        // decoration, therefore 8-bit members need the uniform access capability.
+        if ( nBits == 8 )
+        {
+            if ( storageClass == spv::StorageClassPushConstant )
+                useCapability ( spv::CapabilityStoragePushConstant8 );
+            else if ( storageClass == spv::StorageClassStorageBuffer )
+                useCapability ( spv::CapabilityStorageBuffer8BitAccess );
+            else
+                useCapability ( spv::CapabilityUniformAndStorageBuffer8BitAccess );
+        }
+        else if ( nBits == 16 )
+        {
+            if ( storageClass == spv::StorageClassPushConstant )
+                useCapability ( spv::CapabilityStoragePushConstant16 );
+            else if ( decoration == spv::DecorationBufferBlock
+                      || storageClass == spv::StorageClassStorageBuffer )
+                useCapability ( spv::CapabilityStorageBuffer16BitAccess );
+            else
+                useCapability ( spv::CapabilityUniformAndStorageBuffer16BitAccess );
+        }
+    }
+    else if ( ! isPointerType ( typeId ) )
+        useBufferStorage ( getContainedTypeId ( typeId ), decoration, storageClass );
+}
+
+// -----------------------------------------------------------------------------
+
 void KShaderTranslator :: requireVersion11()
 {
     if ( ! d_bDeviceSupportsVulkan11 )
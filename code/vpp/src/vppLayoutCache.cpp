@@ -0,0 +1,291 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ph.hpp"
+#include "../include/vppLayoutCache.hpp"
+#include "../include/vppDestructionQueue.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+template< class HandleT >
+static std::uint64_t handleToWord ( HandleT handle )
+{
+    return reinterpret_cast< std::uint64_t >( handle );
+}
+
+// -----------------------------------------------------------------------------
+
+static bool makeSetLayoutKey (
+    const VkDescriptorSetLayoutCreateInfo& createInfo,
+    std::vector< std::uint64_t >* pWords )
+{
+    const VkDescriptorBindingFlagsEXT* pBindingFlags = 0;
+
+    for ( const VkBaseInStructure* pNext =
+            static_cast< const VkBaseInStructure* >( createInfo.pNext );
+          pNext; pNext = pNext->pNext )
+    {
+        if ( pNext->sType != VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT )
+            return false;
+
+        pBindingFlags = reinterpret_cast<
+            const VkDescriptorSetLayoutBindingFlagsCreateInfoEXT* >( pNext )->pBindingFlags;
+    }
+
+    // Binding order in the create info does not matter to Vulkan, so it does
+    // not matter to the key either.
+
+    std::vector< std::uint32_t > order ( createInfo.bindingCount );
+
+    for ( std::uint32_t i = 0; i != createInfo.bindingCount; ++i )
+        order [ i ] = i;
+
+    std::sort ( order.begin(), order.end(),
+        [ & createInfo ]( std::uint32_t lhs, std::uint32_t rhs )
+        { return createInfo.pBindings [ lhs ].binding < createInfo.pBindings [ rhs ].binding; } );
+
+    std::vector< std::uint64_t >& words = *pWords;
+    words.push_back ( createInfo.flags );
+    words.push_back ( createInfo.bindingCount );
+
+    for ( std::uint32_t i : order )
+    {
+        const VkDescriptorSetLayoutBinding& binding = createInfo.pBindings [ i ];
+
+        words.push_back ( binding.binding );
+        words.push_back ( binding.descriptorType );
+        words.push_back ( binding.descriptorCount );
+        words.push_back ( binding.stageFlags );
+        words.push_back ( pBindingFlags ? pBindingFlags [ i ] : 0 );
+
+        const bool bSamplerType =
+            binding.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLER
+            || binding.descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+
+        if ( bSamplerType && binding.pImmutableSamplers )
+        {
+            words.push_back ( 1 );
+
+            for ( std::uint32_t iSampler = 0; iSampler != binding.descriptorCount; ++iSampler )
+                words.push_back ( handleToWord ( binding.pImmutableSamplers [ iSampler ] ) );
+        }
+        else
+            words.push_back ( 0 );
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool makePipelineLayoutKey (
+    const VkPipelineLayoutCreateInfo& createInfo,
+    std::vector< std::uint64_t >* pWords )
+{
+    if ( createInfo.pNext )
+        return false;
+
+    std::vector< std::uint64_t >& words = *pWords;
+    words.push_back ( createInfo.flags );
+    words.push_back ( createInfo.setLayoutCount );
+
+    for ( std::uint32_t i = 0; i != createInfo.setLayoutCount; ++i )
+        words.push_back ( handleToWord ( createInfo.pSetLayouts [ i ] ) );
+
+    words.push_back ( createInfo.pushConstantRangeCount );
+
+    for ( std::uint32_t i = 0; i != createInfo.pushConstantRangeCount; ++i )
+    {
+        const VkPushConstantRange& range = createInfo.pPushConstantRanges [ i ];
+        words.push_back ( range.stageFlags );
+        words.push_back ( range.offset );
+        words.push_back ( range.size );
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+LayoutCache :: ~LayoutCache()
+{
+    // Normally empty here, as every layout object keeps the device alive.
+
+    const VkDevice hDevice = d_hDevice;
+
+    d_pipelineLayouts.forEachHandle ( [ hDevice ]( VkPipelineLayout hLayout ) {
+        ::vkDestroyPipelineLayout ( hDevice, hLayout, 0 ); } );
+
+    d_setLayouts.forEachHandle ( [ hDevice ]( VkDescriptorSetLayout hLayout ) {
+        ::vkDestroyDescriptorSetLayout ( hDevice, hLayout, 0 ); } );
+}
+
+// -----------------------------------------------------------------------------
+
+VkDescriptorSetLayout LayoutCache :: acquireSetLayout (
+    const VkDescriptorSetLayoutCreateInfo& createInfo,
+    VkResult* pResult )
+{
+    typedef THandleCache< VkDescriptorSetLayout > Cache;
+
+    VkDescriptorSetLayout hLayout = VK_NULL_HANDLE;
+    Cache::Key key;
+
+    if ( ! makeSetLayoutKey ( createInfo, & key.second ) )
+    {
+        // Unknown extension structure - not cached.
+        *pResult = ::vkCreateDescriptorSetLayout ( d_hDevice, & createInfo, 0, & hLayout );
+        return hLayout;
+    }
+
+    key.first = Cache::hashWords ( key.second );
+
+    std::lock_guard< std::mutex > lock ( d_mutex );
+
+    hLayout = d_setLayouts.acquire ( key );
+
+    if ( hLayout != VK_NULL_HANDLE )
+    {
+        *pResult = VK_SUCCESS;
+        return hLayout;
+    }
+
+    *pResult = ::vkCreateDescriptorSetLayout ( d_hDevice, & createInfo, 0, & hLayout );
+
+    if ( *pResult == VK_SUCCESS )
+        d_setLayouts.add ( key, hLayout );
+
+    return hLayout;
+}
+
+// -----------------------------------------------------------------------------
+
+void LayoutCache :: releaseSetLayout ( VkDescriptorSetLayout hLayout )
+{
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+
+        if ( ! d_setLayouts.release ( hLayout ) )
+            return;
+    }
+
+    const VkDevice hDevice = d_hDevice;
+
+    d_pDestructionQueue->enqueue ( [ hDevice, hLayout ]() {
+        ::vkDestroyDescriptorSetLayout ( hDevice, hLayout, 0 ); } );
+}
+
+// -----------------------------------------------------------------------------
+
+VkPipelineLayout LayoutCache :: acquirePipelineLayout (
+    const VkPipelineLayoutCreateInfo& createInfo,
+    VkResult* pResult )
+{
+    typedef THandleCache< VkPipelineLayout > Cache;
+
+    VkPipelineLayout hLayout = VK_NULL_HANDLE;
+    Cache::Key key;
+
+    if ( ! makePipelineLayoutKey ( createInfo, & key.second ) )
+    {
+        *pResult = ::vkCreatePipelineLayout ( d_hDevice, & createInfo, 0, & hLayout );
+        return hLayout;
+    }
+
+    key.first = Cache::hashWords ( key.second );
+
+    std::lock_guard< std::mutex > lock ( d_mutex );
+
+    hLayout = d_pipelineLayouts.acquire ( key );
+
+    if ( hLayout != VK_NULL_HANDLE )
+    {
+        *pResult = VK_SUCCESS;
+        return hLayout;
+    }
+
+    *pResult = ::vkCreatePipelineLayout ( d_hDevice, & createInfo, 0, & hLayout );
+
+    if ( *pResult == VK_SUCCESS )
+        d_pipelineLayouts.add ( key, hLayout );
+
+    return hLayout;
+}
+
+// -----------------------------------------------------------------------------
+
+void LayoutCache :: releasePipelineLayout ( VkPipelineLayout hLayout )
+{
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+
+        if ( ! d_pipelineLayouts.release ( hLayout ) )
+            return;
+    }
+
+    const VkDevice hDevice = d_hDevice;
+
+    d_pDestructionQueue->enqueue ( [ hDevice, hLayout ]() {
+        ::vkDestroyPipelineLayout ( hDevice, hLayout, 0 ); } );
+}
+
+// -----------------------------------------------------------------------------
+
+size_t LayoutCache :: setLayoutCount() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    return d_setLayouts.size();
+}
+
+// -----------------------------------------------------------------------------
+
+size_t LayoutCache :: pipelineLayoutCount() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    return d_pipelineLayouts.size();
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t LayoutCache :: hitCount() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    return d_setLayouts.hitCount() + d_pipelineLayouts.hitCount();
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t LayoutCache :: missCount() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    return d_setLayouts.missCount() + d_pipelineLayouts.missCount();
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
@@ -0,0 +1,172 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppMappedFile.hpp"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+MappedFile :: MappedFile() :
+    d_pBegin ( 0 ),
+    d_size ( 0 )
+    #ifdef _WIN32
+        , d_hFile ( INVALID_HANDLE_VALUE )
+        , d_hMapping ( 0 )
+    #endif
+{
+}
+
+// -----------------------------------------------------------------------------
+
+MappedFile :: MappedFile ( const std::string& fileName ) :
+    MappedFile()
+{
+    open ( fileName );
+}
+
+// -----------------------------------------------------------------------------
+
+MappedFile :: ~MappedFile()
+{
+    close();
+}
+
+// -----------------------------------------------------------------------------
+
+bool MappedFile :: open ( const std::string& fileName )
+{
+    close();
+
+    #ifdef _WIN32
+
+        d_hFile = ::CreateFileA (
+            fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0 );
+
+        if ( d_hFile == INVALID_HANDLE_VALUE )
+            return false;
+
+        LARGE_INTEGER fileSize;
+
+        if ( ! ::GetFileSizeEx ( d_hFile, & fileSize ) || fileSize.QuadPart == 0 )
+        {
+            close();
+            return false;
+        }
+
+        d_hMapping = ::CreateFileMappingA ( d_hFile, 0, PAGE_READONLY, 0, 0, 0 );
+
+        if ( ! d_hMapping )
+        {
+            close();
+            return false;
+        }
+
+        d_pBegin = static_cast< const unsigned char* >(
+            ::MapViewOfFile ( d_hMapping, FILE_MAP_READ, 0, 0, 0 ) );
+
+        d_size = d_pBegin ? static_cast< size_t >( fileSize.QuadPart ) : 0;
+
+    #else
+
+        const int fd = ::open ( fileName.c_str(), O_RDONLY );
+
+        if ( fd < 0 )
+            return false;
+
+        struct stat fileStat;
+
+        if ( ::fstat ( fd, & fileStat ) != 0 || fileStat.st_size == 0 )
+        {
+            ::close ( fd );
+            return false;
+        }
+
+        void* pMapped = ::mmap (
+            0, static_cast< size_t >( fileStat.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+
+        // The mapping stays valid after closing the descriptor.
+        ::close ( fd );
+
+        if ( pMapped == MAP_FAILED )
+            return false;
+
+        d_pBegin = static_cast< const unsigned char* >( pMapped );
+        d_size = static_cast< size_t >( fileStat.st_size );
+
+    #endif
+
+    return d_pBegin != 0;
+}
+
+// -----------------------------------------------------------------------------
+
+void MappedFile :: close()
+{
+    #ifdef _WIN32
+
+        if ( d_pBegin )
+            ::UnmapViewOfFile ( d_pBegin );
+
+        if ( d_hMapping )
+            ::CloseHandle ( d_hMapping );
+
+        if ( d_hFile != INVALID_HANDLE_VALUE )
+            ::CloseHandle ( d_hFile );
+
+        d_hMapping = 0;
+        d_hFile = INVALID_HANDLE_VALUE;
+
+    #else
+
+        if ( d_pBegin )
+            ::munmap ( const_cast< unsigned char* >( d_pBegin ), d_size );
+
+    #endif
+
+    d_pBegin = 0;
+    d_size = 0;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
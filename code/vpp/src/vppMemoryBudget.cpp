@@ -0,0 +1,280 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppMemoryBudget.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+KMemoryBudgetImpl :: KMemoryBudgetImpl (
+    const PhysicalDevice& hPhysicalDevice,
+    bool bDriverBudget ) :
+        d_hPhysicalDevice ( hPhysicalDevice ),
+        d_bDriverBudget ( bDriverBudget ),
+        d_threshold ( 1.0f )
+{
+    const VkPhysicalDeviceMemoryProperties devMemProperties =
+        hPhysicalDevice.getMemoryProperties();
+
+    d_heaps.resize ( devMemProperties.memoryHeapCount );
+
+    for ( std::uint32_t iHeap = 0; iHeap != devMemProperties.memoryHeapCount; ++iHeap )
+    {
+        SHeapState& heap = d_heaps [ iHeap ];
+        heap.d_heapSize = devMemProperties.memoryHeaps [ iHeap ].size;
+        heap.d_heapFlags = devMemProperties.memoryHeaps [ iHeap ].flags;
+        heap.d_driverBudget = heap.d_heapSize;
+        heap.d_driverUsage = 0;
+        heap.d_allocatedAtQuery = 0;
+        heap.d_allocated = 0;
+        heap.d_bAboveThreshold = false;
+    }
+
+    queryDriver();
+}
+
+// -----------------------------------------------------------------------------
+
+void KMemoryBudgetImpl :: queryDriver()
+{
+    if ( ! d_bDriverBudget )
+        return;
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties;
+    budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    budgetProperties.pNext = 0;
+
+    VkPhysicalDeviceMemoryProperties2 memoryProperties;
+    memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    memoryProperties.pNext = & budgetProperties;
+
+    ::vkGetPhysicalDeviceMemoryProperties2 (
+        d_hPhysicalDevice.handle(), & memoryProperties );
+
+    for ( size_t iHeap = 0; iHeap != d_heaps.size(); ++iHeap )
+    {
+        SHeapState& heap = d_heaps [ iHeap ];
+
+        // Some drivers report zero budget for heaps they do not track.
+        if ( budgetProperties.heapBudget [ iHeap ] )
+            heap.d_driverBudget = budgetProperties.heapBudget [ iHeap ];
+
+        heap.d_driverUsage = budgetProperties.heapUsage [ iHeap ];
+        heap.d_allocatedAtQuery = heap.d_allocated;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+VkDeviceSize KMemoryBudgetImpl :: usage ( const SHeapState& heap ) const
+{
+    if ( ! d_bDriverBudget )
+        return heap.d_allocated;
+
+    // Driver usage is a snapshot, so account for our own allocations done
+    // after it has been taken.
+
+    if ( heap.d_allocated >= heap.d_allocatedAtQuery )
+        return heap.d_driverUsage + ( heap.d_allocated - heap.d_allocatedAtQuery );
+
+    const VkDeviceSize released = heap.d_allocatedAtQuery - heap.d_allocated;
+    return heap.d_driverUsage > released ? heap.d_driverUsage - released : 0;
+}
+
+// -----------------------------------------------------------------------------
+
+VkDeviceSize KMemoryBudgetImpl :: budget ( const SHeapState& heap ) const
+{
+    return d_bDriverBudget ? heap.d_driverBudget : heap.d_heapSize;
+}
+
+// -----------------------------------------------------------------------------
+
+SHeapBudget KMemoryBudgetImpl :: makeHeapBudget ( const SHeapState& heap ) const
+{
+    SHeapBudget result;
+    result.d_heapSize = heap.d_heapSize;
+    result.d_heapFlags = heap.d_heapFlags;
+    result.d_budget = budget ( heap );
+    result.d_usage = usage ( heap );
+    result.d_allocated = heap.d_allocated;
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+bool KMemoryBudgetImpl :: checkThreshold (
+    std::uint32_t heapIndex, SHeapBudget* pNotification )
+{
+    SHeapState& heap = d_heaps [ heapIndex ];
+
+    const double limit = static_cast< double >( budget ( heap ) ) * d_threshold;
+    const bool bAbove = static_cast< double >( usage ( heap ) ) > limit;
+
+    const bool bCrossed = ( bAbove && ! heap.d_bAboveThreshold );
+    heap.d_bAboveThreshold = bAbove;
+
+    if ( bCrossed && d_thresholdCallback )
+    {
+        *pNotification = makeHeapBudget ( heap );
+        return true;
+    }
+
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+MemoryBudget :: MemoryBudget (
+    const PhysicalDevice& hPhysicalDevice,
+    bool bDriverBudget ) :
+        TSharedReference< KMemoryBudgetImpl >(
+            new KMemoryBudgetImpl ( hPhysicalDevice, bDriverBudget ) )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+SHeapBudget MemoryBudget :: heap ( std::uint32_t heapIndex ) const
+{
+    KMemoryBudgetImpl* pImpl = get();
+    mutex_lock lock ( pImpl->d_mutex );
+    return pImpl->makeHeapBudget ( pImpl->d_heaps [ heapIndex ] );
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget :: update()
+{
+    KMemoryBudgetImpl* pImpl = get();
+    mutex_lock lock ( pImpl->d_mutex );
+    pImpl->queryDriver();
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget :: setThreshold ( float fraction, const FThresholdCallback& callback )
+{
+    KMemoryBudgetImpl* pImpl = get();
+    mutex_lock lock ( pImpl->d_mutex );
+
+    pImpl->d_threshold = fraction;
+    pImpl->d_thresholdCallback = callback;
+
+    for ( KMemoryBudgetImpl::SHeapState& heap : pImpl->d_heaps )
+        heap.d_bAboveThreshold = false;
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget :: setPressurePolicy ( const FPressurePolicy& policy )
+{
+    KMemoryBudgetImpl* pImpl = get();
+    mutex_lock lock ( pImpl->d_mutex );
+    pImpl->d_pressurePolicy = policy;
+}
+
+// -----------------------------------------------------------------------------
+
+bool MemoryBudget :: fitsInBudget ( std::uint32_t heapIndex, VkDeviceSize size )
+{
+    KMemoryBudgetImpl* pImpl = get();
+    mutex_lock lock ( pImpl->d_mutex );
+
+    const KMemoryBudgetImpl::SHeapState& heap = pImpl->d_heaps [ heapIndex ];
+    const VkDeviceSize heapBudget = pImpl->budget ( heap );
+    const VkDeviceSize heapUsage = pImpl->usage ( heap );
+
+    return heapUsage <= heapBudget && size <= heapBudget - heapUsage;
+}
+
+// -----------------------------------------------------------------------------
+
+MemoryBudget::EPressureAction MemoryBudget :: onPressure (
+    std::uint32_t heapIndex, VkDeviceSize size, bool bLowPriority )
+{
+    KMemoryBudgetImpl* pImpl = get();
+    FPressurePolicy policy;
+
+    {
+        mutex_lock lock ( pImpl->d_mutex );
+
+        // Our estimate might be stale, e.g. other processes might have
+        // released memory in the meantime.
+        pImpl->queryDriver();
+
+        policy = pImpl->d_pressurePolicy;
+    }
+
+    // The policy is called without the lock, as it is expected to release
+    // memory, which gets accounted here.
+
+    return policy ? policy ( heapIndex, size, bLowPriority ) : PRESSURE_PROCEED;
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget :: onAllocated ( std::uint32_t heapIndex, VkDeviceSize size )
+{
+    KMemoryBudgetImpl* pImpl = get();
+    SHeapBudget notification;
+    FThresholdCallback callback;
+
+    {
+        mutex_lock lock ( pImpl->d_mutex );
+
+        pImpl->d_heaps [ heapIndex ].d_allocated += size;
+
+        if ( pImpl->checkThreshold ( heapIndex, & notification ) )
+            callback = pImpl->d_thresholdCallback;
+    }
+
+    if ( callback )
+        callback ( heapIndex, notification );
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryBudget :: onFreed ( std::uint32_t heapIndex, VkDeviceSize size )
+{
+    KMemoryBudgetImpl* pImpl = get();
+    mutex_lock lock ( pImpl->d_mutex );
+
+    KMemoryBudgetImpl::SHeapState& heap = pImpl->d_heaps [ heapIndex ];
+    heap.d_allocated -= std::min ( size, heap.d_allocated );
+
+    SHeapBudget notification;
+    pImpl->checkThreshold ( heapIndex, & notification );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
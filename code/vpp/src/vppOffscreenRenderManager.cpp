@@ -0,0 +1,347 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ph.hpp"
+#include "../include/vppOffscreenRenderManager.hpp"
+#include "../include/vppCommandBufferRecorder.hpp"
+#include "../include/vppCommands.hpp"
+#include "../include/vppTextureContainer.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+OffscreenRenderManagerImpl :: OffscreenRenderManagerImpl (
+    const Device& hDevice,
+    const VkExtent2D& imageSize,
+    VkFormat format,
+    std::uint32_t frameCount ) :
+        d_hDevice ( hDevice ),
+        d_queue ( hDevice, 0 ),
+        d_commandPool ( hDevice, Q_GRAPHICS ),
+        d_imageSize ( imageSize ),
+        d_format ( format ),
+        d_frameDataSize ( 0 ),
+        d_currentFrame ( 0 ),
+        d_frameNumber ( 0 ),
+        d_rebuildCounter ( 0 )
+{
+    if ( frameCount == 0 )
+        throw XUsageError ( "OffscreenRenderManager requires at least one frame." );
+
+    TextureContainer::SBlockInfo blockInfo;
+
+    if ( ! TextureContainer::getBlockInfo ( format, & blockInfo )
+         || blockInfo.d_width != 1 || blockInfo.d_height != 1 )
+    {
+        throw XUsageError ( "OffscreenRenderManager: unsupported target format." );
+    }
+
+    d_frameDataSize = static_cast< VkDeviceSize >( imageSize.width )
+        * imageSize.height * blockInfo.d_bytes;
+
+    const ImageInfo targetInfo (
+        imageSize.width, imageSize.height,
+        RENDER, Img::COLOR | Img::SOURCE, format );
+
+    d_frames.resize ( frameCount );
+
+    for ( size_t i = 0; i != d_frames.size(); ++i )
+    {
+        SFrame& frame = d_frames [ i ];
+
+        frame.d_target = FrameImageView ( targetInfo, hDevice );
+
+        frame.d_staging = MemoryBinding< Buf, MappableDeviceMemory >(
+            Buf ( d_frameDataSize, Buf::TARGET, hDevice ), MemProfile::HOST_STATIC );
+
+        frame.d_staging.memory().mapPersistently();
+        frame.d_fence = Fence ( hDevice );
+
+        recordReadback ( i );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+OffscreenRenderManagerImpl :: ~OffscreenRenderManagerImpl()
+{
+    d_queue.waitForIdle();
+}
+
+// -----------------------------------------------------------------------------
+
+void OffscreenRenderManagerImpl :: recordReadback ( size_t iFrame )
+{
+    SFrame& frame = d_frames [ iFrame ];
+    const Img& hImage = frame.d_target.image();
+    const Buf& hBuffer = frame.d_staging.resource();
+
+    CommandBuffer hCmdBuffer = d_commandPool.createBuffer();
+    hCmdBuffer.begin();
+
+    UniversalCommands::cmdImagePipelineBarrier (
+        hImage,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+        false,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        -1, -1, hCmdBuffer );
+
+    VkBufferImageCopy copyInfo;
+    copyInfo.bufferOffset = 0;
+    copyInfo.bufferRowLength = 0;
+    copyInfo.bufferImageHeight = 0;
+    copyInfo.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    copyInfo.imageSubresource.mipLevel = 0;
+    copyInfo.imageSubresource.baseArrayLayer = 0;
+    copyInfo.imageSubresource.layerCount = 1;
+    copyInfo.imageOffset.x = 0;
+    copyInfo.imageOffset.y = 0;
+    copyInfo.imageOffset.z = 0;
+    copyInfo.imageExtent.width = d_imageSize.width;
+    copyInfo.imageExtent.height = d_imageSize.height;
+    copyInfo.imageExtent.depth = 1;
+
+    ::vkCmdCopyImageToBuffer (
+        hCmdBuffer.handle(), hImage.handle(),
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, hBuffer.handle(),
+        1, & copyInfo );
+
+    UniversalCommands::cmdBufferPipelineBarrier (
+        hBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT,
+        hCmdBuffer );
+
+    hCmdBuffer.end();
+    frame.d_readbackCommands = hCmdBuffer;
+}
+
+// -----------------------------------------------------------------------------
+
+void OffscreenRenderManagerImpl :: retireFrame ( size_t iFrame )
+{
+    SFrame& frame = d_frames [ iFrame ];
+
+    if ( ! frame.d_bInFlight )
+        return;
+
+    frame.d_fence.wait();
+    frame.d_bInFlight = false;
+
+    MappableDeviceMemory& memory = frame.d_staging.memory();
+    memory.syncFromDevice();
+
+    if ( d_frameReady )
+        d_frameReady (
+            frame.d_frameNumber, memory.beginMapped(),
+            static_cast< size_t >( d_frameDataSize ) );
+
+    frame.d_fence.reset();
+}
+
+// -----------------------------------------------------------------------------
+
+OffscreenRenderManager :: OffscreenRenderManager (
+    const Device& hDevice,
+    const VkExtent2D& imageSize,
+    VkFormat format,
+    std::uint32_t frameCount ) :
+        TSharedReference< OffscreenRenderManagerImpl >(
+            new OffscreenRenderManagerImpl ( hDevice, imageSize, format, frameCount ) )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+FrameBuffer OffscreenRenderManager :: getFrameBuffer (
+    const RenderPass& renderPass, size_t iFrame )
+{
+    OffscreenRenderManagerImpl* pImpl = get();
+    const RenderGraph& graph = renderPass.graph();
+
+    const auto iConfig = 
+        pImpl->d_config2frameBuffers.find ( graph.getAttachmentConfig() );
+
+    if ( iConfig != pImpl->d_config2frameBuffers.end() )
+    {
+        const auto& frameBuffers = iConfig->second;
+
+        if ( iFrame < frameBuffers.size() )
+            return frameBuffers [ iFrame ];
+        else
+            return FrameBuffer();
+    }
+
+    const Device hDevice = renderPass.device();
+    const KAttachmentConfig& attachments = graph.getAttachmentConfig();
+    const size_t nFrames = pImpl->d_frames.size();
+    const size_t nAttachments = attachments.getDescriptionCount();
+
+    const auto iNew = pImpl->d_config2frameBuffers.emplace (
+        std::piecewise_construct,
+            std::forward_as_tuple ( attachments.getInfos(), attachments.getDescriptions() ),
+            std::forward_as_tuple() ).first;
+
+    FrameBuffers& frameBuffers = iNew->second;
+    frameBuffers.reserve ( nFrames );
+
+    // Unlike swapchain rendering, several frames are in flight at once here,
+    // so each ring slot gets its own set of intermediate attachments.
+    for ( size_t i = 0; i != nFrames; ++i )
+    {
+        std::vector< FrameImageView > imageViews;
+        imageViews.resize ( nAttachments );
+
+        for ( size_t j = 0; j != nAttachments; ++j )
+        {
+            const ImageInfo& imageInfo = graph.getAttachmentInfo ( j );
+
+            if ( imageInfo.purpose == DISPLAY )
+                imageViews [ j ] = pImpl->d_frames [ i ].d_target;
+            else
+            {
+                FrameImageView hView = attachments.getPredefinedView ( j );
+
+                if ( ! hView )
+                    imageViews [ j ] = FrameImageView ( imageInfo, hDevice );
+                else
+                    imageViews [ j ] = hView;
+            }
+        }
+
+        frameBuffers.emplace_back ( imageViews, renderPass );
+    }
+
+    return frameBuffers [ iFrame ];
+}
+
+// -----------------------------------------------------------------------------
+
+void OffscreenRenderManager :: beginFrame()
+{
+    OffscreenRenderManagerImpl* pImpl = get();
+    pImpl->retireFrame ( pImpl->d_currentFrame );
+}
+
+// -----------------------------------------------------------------------------
+
+CommandBuffer OffscreenRenderManager :: getRenderCommands (
+    const RenderPass& hRenderPass, ECommandsCaching caching )
+{
+    OffscreenRenderManagerImpl* pImpl = get();
+
+    FrameBuffer hFrameBuffer =
+        getFrameBuffer ( hRenderPass, pImpl->d_currentFrame );
+
+    CommandBuffer hCommandBuffer;
+
+    bool bRebuildBuffer = false;
+    const size_t nFrames = pImpl->d_frames.size();
+
+    if ( caching == REBUILD_CMDS )
+        pImpl->d_rebuildCounter = static_cast< std::uint32_t >( nFrames );
+
+    if ( pImpl->d_rebuildCounter )
+    {
+        bRebuildBuffer = true;
+        --pImpl->d_rebuildCounter;
+    }
+
+    const OffscreenRenderManagerImpl::RenderPassKey key ( hRenderPass, hFrameBuffer );
+    auto iCommands = pImpl->d_renderPassCommands.find ( key );
+
+    if ( iCommands == pImpl->d_renderPassCommands.end() )
+    {
+        hCommandBuffer = pImpl->d_commandPool.createBuffer();
+        pImpl->d_renderPassCommands.emplace ( key, hCommandBuffer );
+        bRebuildBuffer = true;
+    }
+    else
+    {
+        hCommandBuffer = iCommands->second;
+
+        if ( bRebuildBuffer )
+            hCommandBuffer.reset();
+    }
+
+    if ( bRebuildBuffer ) 
+    {
+        CommandBufferRecorder recorder ( hCommandBuffer );
+        recorder.render ( hRenderPass, hFrameBuffer );
+    }
+
+    return hCommandBuffer;
+}
+
+// -----------------------------------------------------------------------------
+
+void OffscreenRenderManager :: render (
+    const RenderPass& hRenderPass, ECommandsCaching caching )
+{
+    OffscreenRenderManagerImpl* pImpl = get();
+    pImpl->d_pendingCommands.push_back ( getRenderCommands ( hRenderPass, caching ) );
+}
+
+// -----------------------------------------------------------------------------
+
+void OffscreenRenderManager :: endFrame()
+{
+    OffscreenRenderManagerImpl* pImpl = get();
+    OffscreenRenderManagerImpl::SFrame& frame = pImpl->d_frames [ pImpl->d_currentFrame ];
+
+    // Rendering and readback go in a single submission; the host waits
+    // for this frame only when its ring slot comes around again.
+    pImpl->d_pendingCommands.push_back ( frame.d_readbackCommands );
+
+    pImpl->d_queue.submit (
+        pImpl->d_pendingCommands, Semaphore(), Semaphore(), frame.d_fence );
+
+    pImpl->d_pendingCommands.clear();
+
+    frame.d_frameNumber = pImpl->d_frameNumber++;
+    frame.d_bInFlight = true;
+
+    pImpl->d_currentFrame = static_cast< std::uint32_t >(
+        ( pImpl->d_currentFrame + 1 ) % pImpl->d_frames.size() );
+}
+
+// -----------------------------------------------------------------------------
+
+void OffscreenRenderManager :: flush()
+{
+    OffscreenRenderManagerImpl* pImpl = get();
+    const size_t nFrames = pImpl->d_frames.size();
+
+    // The current slot holds the oldest frame, so this delivers in order.
+    for ( size_t i = 0; i != nFrames; ++i )
+        pImpl->retireFrame ( ( pImpl->d_currentFrame + i ) % nFrames );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
@@ -194,6 +194,13 @@ std::uint32_t PipelineConfig :: getTessPatchControlPoints() const
 
 // -----------------------------------------------------------------------------
 
+void PipelineConfig :: setPushDescriptorSet ( std::uint32_t set )
+{
+    get()->d_pushDescriptorSets.insert ( set );
+}
+
+// -----------------------------------------------------------------------------
+
 std::uint32_t PipelineConfig :: createNewResource()
 {
     const std::uint32_t newId = static_cast< std::uint32_t >( get()->d_id2resourceDefinition.size() );
@@ -216,6 +223,47 @@ std::uint32_t PipelineConfig :: createNewConstant()
 
 // -----------------------------------------------------------------------------
 
+std::uint32_t PipelineConfig :: createSpecializationConstant ( std::uint32_t defaultValue )
+{
+    PipelineConfigImpl* pImpl = get();
+    const std::uint32_t newId = static_cast< std::uint32_t >( pImpl->d_specializationEntries.size() );
+
+    pImpl->d_specializationEntries.push_back ( VkSpecializationMapEntry {
+        newId,
+        static_cast< std::uint32_t >( newId * sizeof ( std::uint32_t ) ),
+        sizeof ( std::uint32_t ) } );
+
+    pImpl->d_specializationData.push_back ( defaultValue );
+    return newId;
+}
+
+// -----------------------------------------------------------------------------
+
+bool PipelineConfig :: initSpecializationInfo (
+    const SpecializationValues& values,
+    SpecializationData* pData,
+    VkSpecializationInfo* pInfo ) const
+{
+    const PipelineConfigImpl* pImpl = get();
+
+    if ( pImpl->d_specializationEntries.empty() )
+        return false;
+
+    *pData = pImpl->d_specializationData;
+
+    for ( const auto& iValue : values.values() )
+        if ( iValue.first < pData->size() )
+            ( *pData )[ iValue.first ] = iValue.second;
+
+    pInfo->mapEntryCount = static_cast< std::uint32_t >( pImpl->d_specializationEntries.size() );
+    pInfo->pMapEntries = & pImpl->d_specializationEntries [ 0 ];
+    pInfo->dataSize = pData->size() * sizeof ( std::uint32_t );
+    pInfo->pData = & ( *pData )[ 0 ];
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
 void PipelineConfig :: createVertexSource (
     const void* pBase, std::uint32_t stride, bool bInstanceScope )
 {
@@ -478,6 +526,26 @@ void PipelineConfig :: bindDebugProbes ( const ShaderDataBlock& hDataBlock ) con
 
 // -----------------------------------------------------------------------------
 
+void PipelineConfig :: registerDebugPrint ( const HDebugProbe& hDebugPrint )
+{
+    PipelineConfigImpl* pImpl = get();
+
+    if ( pImpl->d_hDebugPrint )
+        throw XUsageError ( "DebugPrint has already been enabled for this pipeline." );
+
+    pImpl->d_hDebugPrint = hDebugPrint;
+    pImpl->d_debugProbes.push_back ( hDebugPrint );
+}
+
+// -----------------------------------------------------------------------------
+
+IDebugProbe* PipelineConfig :: getDebugPrint() const
+{
+    return get()->d_hDebugPrint.get();
+}
+
+// -----------------------------------------------------------------------------
+
 void PipelineConfig :: addShader (
     ShaderTable* pShaderTable,
     KShader* pShader,
@@ -486,10 +554,13 @@ void PipelineConfig :: addShader (
 {
     KShaderModule hModule = pShader->compile ( hDevice, pDynamicParameters );
 
+    const VkSpecializationInfo* pSpecializationInfo =
+        get()->d_specializationEntries.empty() ? 0 : & get()->d_specializationInfo;
+
     pShaderTable->push_back (
         VkPipelineShaderStageCreateInfo {
             VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-            0, 0, pShader->stage(), hModule.handle(), "main", 0
+            0, 0, pShader->stage(), hModule.handle(), "main", pSpecializationInfo
         }
     );
 
@@ -559,6 +630,13 @@ void PipelineConfig :: fillShaderTable ( ShaderTable* pShaderTable, Device hDevi
         pImpl->d_pGeometryShader->setInputTopology ( topology );
     }
 
+    // Configured values of specialization constants. Pipelines may override
+    // them without compiling the shaders again.
+    initSpecializationInfo (
+        SpecializationValues(),
+        & pImpl->d_specializationData,
+        & pImpl->d_specializationInfo );
+
     // Compile the shaders.
     SDynamicParameters dynamicParameters;
     dynamicParameters.d_clipDistancesSize = 0;
@@ -63,7 +63,13 @@ KQueryPoolImpl :: KQueryPoolImpl (
 KQueryPoolImpl :: ~KQueryPoolImpl()
 {
     if ( d_result == VK_SUCCESS )
-        ::vkDestroyQueryPool ( d_hDevice.handle(), d_handle, 0 );
+    {
+        const VkDevice hDevice = d_hDevice.handle();
+        const VkQueryPool hQueryPool = d_handle;
+
+        d_hDevice.destructionQueue().enqueue ( [ hDevice, hQueryPool ]() {
+            ::vkDestroyQueryPool ( hDevice, hQueryPool, 0 ); } );
+    }
 }
 
 // -----------------------------------------------------------------------------
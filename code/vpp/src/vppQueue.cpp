@@ -34,17 +34,43 @@
 namespace vpp {
 // -----------------------------------------------------------------------------
 
+static void submitTracked (
+    const Device& hDevice,
+    VkQueue hQueue,
+    const VkSubmitInfo& submitInfo,
+    VkFence hUserFence )
+{
+    // Advances the device submission timeline, so that objects released
+    // before this point are not destroyed until the submission completes.
+
+    const VkFence hTrackingFence = hDevice.destructionQueue().registerSubmission (
+        hQueue, hUserFence == VK_NULL_HANDLE );
+
+    if ( hUserFence != VK_NULL_HANDLE )
+    {
+        ::vkQueueSubmit ( hQueue, 1, & submitInfo, hUserFence );
+
+        if ( hTrackingFence != VK_NULL_HANDLE )
+            ::vkQueueSubmit ( hQueue, 0, 0, hTrackingFence );
+    }
+    else
+        ::vkQueueSubmit ( hQueue, 1, & submitInfo, hTrackingFence );
+}
+
+// -----------------------------------------------------------------------------
+
 void Queue :: submit (
     const CommandBuffer& singleBuffer,
     const Semaphore& waitOnBegin,
     const Semaphore& signalOnEnd,
-    const Fence& signalFenceOnEnd ) const
+    const Fence& signalFenceOnEnd,
+    VkPipelineStageFlags waitStages ) const
 {
     VkCommandBuffer hBuffer = singleBuffer.handle();
     VkSemaphore hWaitOnBegin = VK_NULL_HANDLE;
     VkSemaphore hSignalOnEnd = VK_NULL_HANDLE;
     VkFence hSignalFenceOnEnd = VK_NULL_HANDLE;
-    VkPipelineStageFlags stageFlags = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    VkPipelineStageFlags stageFlags = waitStages;
 
     VkSubmitInfo vkSubmitInfo;
     vkSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -87,7 +113,7 @@ void Queue :: submit (
     
     {
         VPP_EXTSYNC_MTX_SLOCK ( get() );
-        ::vkQueueSubmit ( get()->d_handle, 1, & vkSubmitInfo, hSignalFenceOnEnd );
+        submitTracked ( get()->d_hDevice, get()->d_handle, vkSubmitInfo, hSignalFenceOnEnd );
     }
 
     if ( signalFenceOnEnd )
@@ -100,12 +126,13 @@ void Queue :: submit (
     const std::vector< CommandBuffer > buffers,
     const Semaphore& waitOnBegin,
     const Semaphore& signalOnEnd,
-    const Fence& signalFenceOnEnd ) const
+    const Fence& signalFenceOnEnd,
+    VkPipelineStageFlags waitStages ) const
 {
     VkSemaphore hWaitOnBegin = VK_NULL_HANDLE;
     VkSemaphore hSignalOnEnd = VK_NULL_HANDLE;
     VkFence hSignalFenceOnEnd = VK_NULL_HANDLE;
-    VkPipelineStageFlags stageFlags = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    VkPipelineStageFlags stageFlags = waitStages;
 
     VkSubmitInfo vkSubmitInfo;
     vkSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -154,13 +181,97 @@ void Queue :: submit (
 
     {
         VPP_EXTSYNC_MTX_SLOCK ( get() );
-        ::vkQueueSubmit ( get()->d_handle, 1, & vkSubmitInfo, hSignalFenceOnEnd );
+        submitTracked ( get()->d_hDevice, get()->d_handle, vkSubmitInfo, hSignalFenceOnEnd );
     }
 
     if ( signalFenceOnEnd )
         VPP_EXTSYNC_MTX_UNLOCK ( signalFenceOnEnd.get() );
 }
 
+// -----------------------------------------------------------------------------
+
+void Queue :: signal ( const Fence& signalFence ) const
+{
+    // Empty submission - the fence signals when all previously submitted
+    // work on this queue completes.
+
+    signal ( std::vector< Semaphore >(), std::vector< Semaphore >(), signalFence );
+}
+
+// -----------------------------------------------------------------------------
+
+void Queue :: signal (
+    const std::vector< Semaphore >& waitSems,
+    const Fence& signalFence ) const
+{
+    signal ( waitSems, std::vector< Semaphore >(), signalFence );
+}
+
+// -----------------------------------------------------------------------------
+
+void Queue :: signal (
+    const std::vector< Semaphore >& waitSems,
+    const std::vector< Semaphore >& signalSems,
+    const Fence& signalFence ) const
+{
+    // Submission without command buffers - joins work running on other
+    // queues, then signals the semaphores and the fence (if given). Signaled
+    // semaphores let other queues wait for all work submitted here so far.
+
+    const size_t nWaitSems = waitSems.size();
+    const size_t nSignalSems = signalSems.size();
+
+    std::vector< VkSemaphore > hWaitSems ( nWaitSems );
+    std::vector< VkSemaphore > hSignalSems ( nSignalSems );
+    std::vector< VkPipelineStageFlags > stageFlags (
+        nWaitSems, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT );
+
+    for ( size_t i = 0; i != nWaitSems; ++i )
+        hWaitSems [ i ] = waitSems [ i ].handle();
+
+    for ( size_t i = 0; i != nSignalSems; ++i )
+        hSignalSems [ i ] = signalSems [ i ].handle();
+
+    VkSubmitInfo vkSubmitInfo;
+    vkSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    vkSubmitInfo.pNext = 0;
+    vkSubmitInfo.waitSemaphoreCount = static_cast< std::uint32_t >( nWaitSems );
+    vkSubmitInfo.pWaitSemaphores = nWaitSems ? & hWaitSems [ 0 ] : 0;
+    vkSubmitInfo.pWaitDstStageMask = nWaitSems ? & stageFlags [ 0 ] : 0;
+    vkSubmitInfo.commandBufferCount = 0;
+    vkSubmitInfo.pCommandBuffers = 0;
+    vkSubmitInfo.signalSemaphoreCount = static_cast< std::uint32_t >( nSignalSems );
+    vkSubmitInfo.pSignalSemaphores = nSignalSems ? & hSignalSems [ 0 ] : 0;
+
+    VkFence hSignalFence = VK_NULL_HANDLE;
+
+    if ( signalFence )
+    {
+        VPP_EXTSYNC_MTX_LOCK ( signalFence.get() );
+        hSignalFence = signalFence.handle();
+    }
+
+    {
+        VPP_EXTSYNC_MTX_SLOCK ( get() );
+        submitTracked ( get()->d_hDevice, get()->d_handle, vkSubmitInfo, hSignalFence );
+    }
+
+    if ( signalFence )
+        VPP_EXTSYNC_MTX_UNLOCK ( signalFence.get() );
+}
+
+// -----------------------------------------------------------------------------
+
+VkResult Queue :: waitForIdle()
+{
+    const VkResult result = ::vkQueueWaitIdle ( get()->d_handle );
+
+    if ( result == VK_SUCCESS )
+        get()->d_hDevice.destructionQueue().onQueueIdle ( get()->d_handle );
+
+    return result;
+}
+
 // -----------------------------------------------------------------------------
 } // namespace vpp
 // -----------------------------------------------------------------------------
@@ -0,0 +1,496 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ph.hpp"
+#include "../include/vppReadback.hpp"
+#include "../include/vppCommands.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+static const VkDeviceSize READBACK_ALIGNMENT = 256;
+
+// -----------------------------------------------------------------------------
+
+static VkDeviceSize alignReadbackSize ( VkDeviceSize size )
+{
+    return ( size + READBACK_ALIGNMENT - 1 ) & ~( READBACK_ALIGNMENT - 1 );
+}
+
+// -----------------------------------------------------------------------------
+
+KReadbackRingImpl :: KReadbackRingImpl ( const Device& hDevice, VkDeviceSize size ) :
+    d_staging (
+        Buf ( alignReadbackSize ( size ), Buf::TARGET, hDevice ),
+        MemProfile::HOST_STATIC ),
+    d_size ( alignReadbackSize ( size ) ),
+    d_head ( 0 )
+{
+    d_staging.memory().mapPersistently();
+}
+
+// -----------------------------------------------------------------------------
+
+bool KReadbackRingImpl :: allocate ( VkDeviceSize size, VkDeviceSize* pOffset )
+{
+    const VkDeviceSize alignedSize = alignReadbackSize ( size );
+
+    if ( alignedSize > d_size )
+        return false;
+
+    std::lock_guard< std::mutex > lock ( d_mutex );
+
+    VkDeviceSize offset = 0;
+
+    if ( ! d_slices.empty() )
+    {
+        // Live slices span from the oldest one to the head, possibly wrapping
+        // around the end. The head never catches up with the oldest slice.
+        const VkDeviceSize tail = d_slices.front().d_offset;
+
+        if ( d_head > tail )
+        {
+            if ( d_head + alignedSize <= d_size )
+                offset = d_head;
+            else if ( alignedSize < tail )
+                offset = 0;
+            else
+                return false;
+        }
+        else if ( d_head + alignedSize < tail )
+            offset = d_head;
+        else
+            return false;
+    }
+
+    const SSlice slice = { offset, false };
+    d_slices.push_back ( slice );
+    d_head = offset + alignedSize;
+    *pOffset = offset;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void KReadbackRingImpl :: release ( VkDeviceSize offset )
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+
+    for ( auto& slice : d_slices )
+        if ( slice.d_offset == offset && ! slice.d_bReleased )
+        {
+            slice.d_bReleased = true;
+            break;
+        }
+
+    while ( ! d_slices.empty() && d_slices.front().d_bReleased )
+        d_slices.pop_front();
+
+    if ( d_slices.empty() )
+        d_head = 0;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+ReadbackFutureImpl :: ReadbackFutureImpl() :
+    d_pVector ( 0 ),
+    d_offset ( 0 ),
+    d_size ( 0 ),
+    d_bReady ( false )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+ReadbackFutureImpl :: ~ReadbackFutureImpl()
+{
+    if ( d_hRing )
+        d_hRing->release ( d_offset );
+}
+
+// -----------------------------------------------------------------------------
+
+void ReadbackFutureImpl :: complete ( const ReadbackFuture& hThis )
+{
+    if ( d_pVector )
+        d_pVector->invalidateHostCopy();
+    else
+        d_staging.memory().syncFromDevice ( d_offset, d_size );
+
+    std::vector< ReadbackFuture::FContinuation > continuations;
+
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+        d_bReady = true;
+        continuations.swap ( d_continuations );
+    }
+
+    d_readyCondition.notify_all();
+
+    for ( const auto& continuation : continuations )
+        continuation ( hThis );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+bool ReadbackFuture :: isReady() const
+{
+    std::lock_guard< std::mutex > lock ( get()->d_mutex );
+    return get()->d_bReady;
+}
+
+// -----------------------------------------------------------------------------
+
+bool ReadbackFuture :: wait ( std::uint64_t timeoutNs ) const
+{
+    ReadbackFutureImpl* pImpl = get();
+    std::unique_lock< std::mutex > lock ( pImpl->d_mutex );
+
+    const auto isReady = [ pImpl ]() { return pImpl->d_bReady; };
+
+    if ( timeoutNs == NO_TIMEOUT )
+    {
+        pImpl->d_readyCondition.wait ( lock, isReady );
+        return true;
+    }
+
+    return pImpl->d_readyCondition.wait_for (
+        lock, std::chrono::nanoseconds ( timeoutNs ), isReady );
+}
+
+// -----------------------------------------------------------------------------
+
+const void* ReadbackFuture :: data() const
+{
+    const ReadbackFutureImpl* pImpl = get();
+
+    if ( pImpl->d_pVector )
+        return 0;
+
+    return pImpl->d_staging.d_memory.beginMapped() + pImpl->d_offset;
+}
+
+// -----------------------------------------------------------------------------
+
+VkDeviceSize ReadbackFuture :: size() const
+{
+    return get()->d_size;
+}
+
+// -----------------------------------------------------------------------------
+
+void ReadbackFuture :: then ( const FContinuation& continuation )
+{
+    ReadbackFutureImpl* pImpl = get();
+
+    {
+        std::lock_guard< std::mutex > lock ( pImpl->d_mutex );
+
+        if ( ! pImpl->d_bReady )
+        {
+            pImpl->d_continuations.push_back ( continuation );
+            return;
+        }
+    }
+
+    continuation ( *this );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+ReadbackQueueImpl :: ReadbackQueueImpl (
+    const Device& hDevice, VkDeviceSize stagingSize, EQueueType eQueue ) :
+        d_hDevice ( hDevice ),
+        d_queue ( hDevice, 0, eQueue ),
+        d_commandPool ( hDevice, eQueue, CommandPool::REUSABLE ),
+        d_hRing ( stagingSize ? new KReadbackRingImpl ( hDevice, stagingSize ) : 0 ),
+        d_nRetiring ( 0 ),
+        d_bStop ( false ),
+        d_thread ( & ReadbackQueueImpl::completionThread, this )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+ReadbackQueueImpl :: ~ReadbackQueueImpl()
+{
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+        d_bStop = true;
+    }
+
+    d_pendingCondition.notify_all();
+    d_thread.join();
+}
+
+// -----------------------------------------------------------------------------
+
+CommandBuffer ReadbackQueueImpl :: acquireCommandBuffer()
+{
+    CommandBuffer hCmdBuffer;
+
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+
+        if ( ! d_freeCmdBuffers.empty() )
+        {
+            hCmdBuffer = d_freeCmdBuffers.back();
+            d_freeCmdBuffers.pop_back();
+        }
+    }
+
+    if ( hCmdBuffer )
+        hCmdBuffer.reset();
+    else
+        hCmdBuffer = d_commandPool.createBuffer();
+
+    hCmdBuffer.begin ( CommandBuffer::ONE_TIME_SUBMIT );
+    return hCmdBuffer;
+}
+
+// -----------------------------------------------------------------------------
+
+void ReadbackQueueImpl :: submit (
+    const ReadbackFuture& future, const CommandBuffer& hCmdBuffer )
+{
+    SPending pending;
+    pending.d_future = future;
+    pending.d_cmdBuffer = hCmdBuffer;
+
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+
+        if ( ! d_freeFences.empty() )
+        {
+            pending.d_fence = d_freeFences.back();
+            d_freeFences.pop_back();
+        }
+    }
+
+    if ( ! pending.d_fence )
+        pending.d_fence = Fence ( d_hDevice );
+
+    d_queue.submit ( hCmdBuffer, Semaphore(), Semaphore(), pending.d_fence );
+
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+        d_pending.push_back ( pending );
+    }
+
+    d_pendingCondition.notify_one();
+}
+
+// -----------------------------------------------------------------------------
+
+void ReadbackQueueImpl :: completionThread()
+{
+    for (;;)
+    {
+        SPending pending;
+
+        {
+            std::unique_lock< std::mutex > lock ( d_mutex );
+
+            d_pendingCondition.wait ( lock,
+                [ this ]() { return d_bStop || ! d_pending.empty(); } );
+
+            // Pending readbacks are drained before stopping.
+            if ( d_pending.empty() )
+                return;
+
+            pending = d_pending.front();
+            d_pending.pop_front();
+            ++d_nRetiring;
+        }
+
+        // Fences on one queue signal in submission order, so waiting for
+        // the oldest one first does not delay the others.
+        pending.d_fence.wait();
+        pending.d_future.get()->complete ( pending.d_future );
+        pending.d_fence.reset();
+
+        {
+            std::lock_guard< std::mutex > lock ( d_mutex );
+            d_freeFences.push_back ( pending.d_fence );
+            d_freeCmdBuffers.push_back ( pending.d_cmdBuffer );
+            --d_nRetiring;
+        }
+
+        d_idleCondition.notify_all();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+ReadbackQueue :: ReadbackQueue (
+    const Device& hDevice,
+    VkDeviceSize stagingSize,
+    EQueueType eQueue ) :
+        TSharedReference< ReadbackQueueImpl >(
+            new ReadbackQueueImpl ( hDevice, stagingSize, eQueue ) )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+ReadbackFuture ReadbackQueue :: load ( detail::VectorBase& vector )
+{
+    ReadbackQueueImpl* pImpl = get();
+    ReadbackFuture future ( new ReadbackFutureImpl() );
+    future.get()->d_pVector = & vector;
+
+    CommandBuffer hCmdBuffer = pImpl->acquireCommandBuffer();
+    vector.cmdLoad ( hCmdBuffer );
+    hCmdBuffer.end();
+
+    pImpl->submit ( future, hCmdBuffer );
+    return future;
+}
+
+// -----------------------------------------------------------------------------
+
+ReadbackFuture ReadbackQueue :: copyFromImage (
+    detail::VectorBase& vector,
+    const TSImg& img,
+    VkImageLayout sourceImageLayout,
+    std::uint32_t mipLevel,
+    std::uint32_t layer,
+    const VkOffset3D& imageOffset,
+    const VkExtent3D& imageExtent,
+    VkDeviceSize bufferOffset,
+    std::uint32_t bufferRowLength,
+    std::uint32_t bufferImageHeight )
+{
+    ReadbackQueueImpl* pImpl = get();
+    ReadbackFuture future ( new ReadbackFutureImpl() );
+    future.get()->d_pVector = & vector;
+
+    CommandBuffer hCmdBuffer = pImpl->acquireCommandBuffer();
+
+    vector.cmdCopyFromImage (
+        hCmdBuffer, img, sourceImageLayout,
+        mipLevel, layer, imageOffset, imageExtent,
+        bufferOffset, bufferRowLength, bufferImageHeight );
+
+    hCmdBuffer.end();
+
+    pImpl->submit ( future, hCmdBuffer );
+    return future;
+}
+
+// -----------------------------------------------------------------------------
+
+ReadbackFuture ReadbackQueue :: readBuffer (
+    const Buf& hBuffer,
+    VkDeviceSize offset,
+    VkDeviceSize size )
+{
+    if ( size == 0 || offset + size > hBuffer.size() )
+        throw XUsageError ( "ReadbackQueue::readBuffer: range out of buffer bounds." );
+
+    ReadbackQueueImpl* pImpl = get();
+    ReadbackFuture future ( new ReadbackFutureImpl() );
+    ReadbackFutureImpl* pFuture = future.get();
+    pFuture->d_size = size;
+
+    VkDeviceSize stagingOffset = 0;
+
+    if ( pImpl->d_hRing && pImpl->d_hRing->allocate ( size, & stagingOffset ) )
+    {
+        pFuture->d_hRing = pImpl->d_hRing;
+        pFuture->d_staging = pImpl->d_hRing->d_staging;
+        pFuture->d_offset = stagingOffset;
+    }
+    else
+    {
+        pFuture->d_staging = KReadbackRingImpl::StagingBinding (
+            Buf ( size, Buf::TARGET, pImpl->d_hDevice ), MemProfile::HOST_STATIC );
+
+        pFuture->d_staging.memory().mapPersistently();
+    }
+
+    const Buf& hStagingBuffer = pFuture->d_staging.resource();
+    CommandBuffer hCmdBuffer = pImpl->acquireCommandBuffer();
+
+    // The source may have been written by any earlier command on the queue.
+    // BOTTOM_OF_PIPE would make no memory available, as it performs no
+    // accesses.
+
+    UniversalCommands::cmdBufferPipelineBarrier (
+        hBuffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+        hCmdBuffer );
+
+    VkBufferCopy vkBufferCopy;
+    vkBufferCopy.srcOffset = offset;
+    vkBufferCopy.dstOffset = pFuture->d_offset;
+    vkBufferCopy.size = size;
+
+    ::vkCmdCopyBuffer (
+        hCmdBuffer.handle(), hBuffer.handle(),
+        hStagingBuffer.handle(), 1u, & vkBufferCopy );
+
+    UniversalCommands::cmdBufferPipelineBarrier (
+        hStagingBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT,
+        hCmdBuffer );
+
+    hCmdBuffer.end();
+
+    pImpl->submit ( future, hCmdBuffer );
+    return future;
+}
+
+// -----------------------------------------------------------------------------
+
+void ReadbackQueue :: waitIdle()
+{
+    ReadbackQueueImpl* pImpl = get();
+    std::unique_lock< std::mutex > lock ( pImpl->d_mutex );
+
+    pImpl->d_idleCondition.wait ( lock,
+        [ pImpl ]() { return pImpl->d_pending.empty() && pImpl->d_nRetiring == 0; } );
+}
+
+// -----------------------------------------------------------------------------
+
+size_t ReadbackQueue :: pendingCount() const
+{
+    const ReadbackQueueImpl* pImpl = get();
+    std::lock_guard< std::mutex > lock ( pImpl->d_mutex );
+    return pImpl->d_pending.size() + pImpl->d_nRetiring;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
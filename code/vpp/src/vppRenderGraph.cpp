@@ -863,6 +863,57 @@ void RenderGraph :: cmdDrawIndexedIndirect (
 
 // -----------------------------------------------------------------------------
 
+void RenderGraph :: cmdDrawIndexedIndirectCount (
+    const IndirectBufferView& data,
+    VkDeviceSize offset,
+    const IndirectBufferView& countData,
+    VkDeviceSize countOffset,
+    std::uint32_t maxDrawCount,
+    CommandBuffer hCommandBuffer )
+{
+    const VkCommandBuffer hCmdBuffer = hCommandBuffer ?
+        hCommandBuffer.handle()
+        : RenderingCommandContext::getCommandBufferHandle();
+
+    const Device& hDevice = data.buffer().device();
+
+    const PFN_vkCmdDrawIndexedIndirectCountKHR pfnDrawIndexedIndirectCount =
+        hDevice.cmdDrawIndexedIndirectCountFunction();
+
+    if ( pfnDrawIndexedIndirectCount )
+    {
+        pfnDrawIndexedIndirectCount (
+            hCmdBuffer,
+            data.buffer().handle(),
+            offset * sizeof ( VkDrawIndexedIndirectCommand ),
+            countData.buffer().handle(),
+            countOffset * sizeof ( std::uint32_t ),
+            maxDrawCount,
+            sizeof ( VkDrawIndexedIndirectCommand ) );
+    }
+    else if ( hDevice.hasFeature ( fMultiDrawIndirect ) )
+    {
+        ::vkCmdDrawIndexedIndirect (
+            hCmdBuffer,
+            data.buffer().handle(),
+            offset * sizeof ( VkDrawIndexedIndirectCommand ),
+            maxDrawCount,
+            sizeof ( VkDrawIndexedIndirectCommand ) );
+    }
+    else
+    {
+        for ( std::uint32_t iDraw = 0; iDraw != maxDrawCount; ++iDraw )
+            ::vkCmdDrawIndexedIndirect (
+                hCmdBuffer,
+                data.buffer().handle(),
+                ( offset + iDraw ) * sizeof ( VkDrawIndexedIndirectCommand ),
+                1u,
+                sizeof ( VkDrawIndexedIndirectCommand ) );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 void RenderGraph :: cmdClearImages (
     std::uint32_t attachmentCount,
     const VkClearAttachment* pAttachments,
@@ -153,6 +153,20 @@ Display :: Display ( RenderGraph* pGraph, const Surface& hSurface ) :
 
 // -----------------------------------------------------------------------------
 
+Display :: Display ( const VkExtent2D& imageSize, VkFormat format ) :
+    BaseAttachment ( imageSize, DISPLAY, format )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+Display :: Display ( RenderGraph* pGraph, const VkExtent2D& imageSize, VkFormat format ) :
+    BaseAttachment ( pGraph, imageSize, DISPLAY, format )
+{
+}
+
+// -----------------------------------------------------------------------------
+
 Display :: ~Display()
 {
 }
@@ -35,6 +35,22 @@
 namespace vpp {
 // -----------------------------------------------------------------------------
 
+static std::uint64_t hashWords ( const std::vector< std::uint64_t >& words )
+{
+    // FNV-1a over 64-bit words.
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for ( std::uint64_t word : words )
+    {
+        hash ^= word;
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+// -----------------------------------------------------------------------------
+
 RenderPassImpl::SPipelineData :: SPipelineData() :
     d_processIndex ( 0 ),
     d_pipelineIndex ( 0 )
@@ -66,10 +82,18 @@ const Pipeline& RenderPass :: pipeline ( const Process& hProcess, std::uint32_t
 
 // -----------------------------------------------------------------------------
 
+size_t RenderPass :: pipelineVariantCount() const
+{
+    return get()->d_variantCount;
+}
+
+// -----------------------------------------------------------------------------
+
 std::uint32_t RenderPass :: addPipeline (
     std::uint32_t iProcess,
     const PipelineLayoutBase& layout,
-    const RenderingOptions& options )
+    const RenderingOptions& options,
+    const SpecializationValues& specialization )
 {
     RenderPassImpl::ProcessPipelineData& ppd = get()->d_pipelineData [ iProcess ];
     const std::uint32_t pipelineIndex = static_cast< std::uint32_t >( ppd.size() );
@@ -79,6 +103,7 @@ std::uint32_t RenderPass :: addPipeline (
 
     data.d_layout = layout;
     data.d_options = options;
+    data.d_specialization = specialization;
 
     return pipelineIndex;
 }
@@ -88,9 +113,10 @@ std::uint32_t RenderPass :: addPipeline (
 std::uint32_t RenderPass :: addPipeline (
     const Process& hProcess,
     const PipelineLayoutBase& layout,
-    const RenderingOptions& options )
+    const RenderingOptions& options,
+    const SpecializationValues& specialization )
 {
-    return addPipeline ( hProcess.index(), layout, options );
+    return addPipeline ( hProcess.index(), layout, options, specialization );
 }
 
 // -----------------------------------------------------------------------------
@@ -124,6 +150,7 @@ RenderPassImpl :: RenderPassImpl (
         d_hPipelineCache ( hPipelineCache ),
         d_handle(),
         d_result(),
+        d_variantCount ( 0 ),
         d_bPipelinesCreated ( false )
 {
     const size_t nProcesses = d_graph.getProcessCount();
@@ -156,7 +183,13 @@ RenderPassImpl :: RenderPassImpl (
 RenderPassImpl :: ~RenderPassImpl()
 {
     if ( d_result == VK_SUCCESS )
-        ::vkDestroyRenderPass ( d_hDevice.handle(), d_handle, 0 );
+    {
+        const VkDevice hDevice = d_hDevice.handle();
+        const VkRenderPass hRenderPass = d_handle;
+
+        d_hDevice.destructionQueue().enqueue ( [ hDevice, hRenderPass ]() {
+            ::vkDestroyRenderPass ( hDevice, hRenderPass, 0 ); } );
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -168,35 +201,136 @@ void RenderPassImpl :: createPipelines()
 
     d_bPipelinesCreated = true;
 
-    size_t nPipelines = 0;
-    
-    for ( auto iProcessPipelines = d_pipelineData.begin();
-          iProcessPipelines != d_pipelineData.end(); ++iProcessPipelines )
-    {
-        nPipelines += iProcessPipelines->size();
-    }
+    // Pipelines are grouped into variants by canonical key: subpass, layout
+    // (which also determines shaders), specialization and the part of
+    // rendering options which can not be made dynamic.
+
+    typedef std::pair< std::uint64_t, std::vector< std::uint64_t > > VariantKey;
+    typedef std::pair< size_t, size_t > PipelineLocation;
+
+    std::map< VariantKey, size_t > variantIndices;
+    std::vector< PipelineLocation > variantSources;
+    std::vector< size_t > pipelineVariants;
+
+    for ( size_t iProcess = 0; iProcess != d_pipelineData.size(); ++iProcess )
+        for ( size_t iPipeline = 0; iPipeline != d_pipelineData [ iProcess ].size(); ++iPipeline )
+        {
+            SPipelineData& pipelineData = d_pipelineData [ iProcess ][ iPipeline ];
+            pipelineData.d_options.initFoldedDynamicState ( & pipelineData.d_foldedState );
+
+            // States declared dynamic by the pipeline configuration are set
+            // by the user. Do not override them when binding.
+
+            const PipelineConfig::DynamicStates& userStates =
+                pipelineData.d_layout.config().getDynamicStates();
+
+            std::vector< VkDynamicState >& foldedStates = pipelineData.d_foldedState.d_states;
+
+            foldedStates.erase (
+                std::remove_if ( foldedStates.begin(), foldedStates.end(),
+                    [ & userStates ]( VkDynamicState state )
+                    { return std::find ( userStates.begin(), userStates.end(), state ) != userStates.end(); } ),
+                foldedStates.end() );
+
+            VariantKey key;
+            key.second.push_back ( iProcess );
+            key.second.push_back ( reinterpret_cast< std::uint64_t >( pipelineData.d_layout.get() ) );
+
+            const SpecializationValues::Values& specValues =
+                pipelineData.d_specialization.values();
+
+            key.second.push_back ( specValues.size() );
+
+            for ( const auto& iValue : specValues )
+                key.second.push_back ( ( std::uint64_t ( iValue.first ) << 32 ) | iValue.second );
 
-    d_pipelineCreateInfos.resize ( nPipelines );
+            pipelineData.d_options.getVariantKey ( & key.second );
+            key.first = hashWords ( key.second );
 
-    for ( size_t iProcess = 0, iDest = 0; iProcess != d_pipelineData.size(); ++iProcess )
-        for ( size_t iPipeline = 0; iPipeline != d_pipelineData [ iProcess ].size(); ++iPipeline, ++iDest )
-            preparePipelineCreateInfo ( iProcess, iPipeline, iDest );
+            const auto iVariant = variantIndices.emplace ( key, variantSources.size() );
 
-    std::vector< VkPipeline > pipelineHandles ( nPipelines, VK_NULL_HANDLE );
+            if ( iVariant.second )
+                variantSources.emplace_back ( iProcess, iPipeline );
+
+            pipelineVariants.push_back ( iVariant.first->second );
+        }
+
+    const size_t nVariants = variantSources.size();
+    d_variantCount = nVariants;
+
+    // Line width is baked into the pipeline, unless pipelines of the same
+    // variant differ in line width. Only then it is made dynamic, for all
+    // pipelines of that variant.
+
+    std::vector< bool > variantLineWidthDynamic ( nVariants, false );
+
+    for ( size_t iProcess = 0, iSrc = 0; iProcess != d_pipelineData.size(); ++iProcess )
+        for ( size_t iPipeline = 0; iPipeline != d_pipelineData [ iProcess ].size(); ++iPipeline, ++iSrc )
+        {
+            const size_t iVariant = pipelineVariants [ iSrc ];
+            const PipelineLocation& source = variantSources [ iVariant ];
+
+            if ( d_pipelineData [ iProcess ][ iPipeline ].d_foldedState.d_lineWidth
+                 != d_pipelineData [ source.first ][ source.second ].d_foldedState.d_lineWidth )
+            {
+                variantLineWidthDynamic [ iVariant ] = true;
+            }
+        }
+
+    for ( size_t iProcess = 0, iSrc = 0; iProcess != d_pipelineData.size(); ++iProcess )
+        for ( size_t iPipeline = 0; iPipeline != d_pipelineData [ iProcess ].size(); ++iPipeline, ++iSrc )
+        {
+            SPipelineData& pipelineData = d_pipelineData [ iProcess ][ iPipeline ];
+
+            const PipelineConfig::DynamicStates& userStates =
+                pipelineData.d_layout.config().getDynamicStates();
+
+            if ( variantLineWidthDynamic [ pipelineVariants [ iSrc ] ]
+                 && std::find ( userStates.begin(), userStates.end(), VK_DYNAMIC_STATE_LINE_WIDTH ) == userStates.end() )
+            {
+                pipelineData.d_foldedState.d_states.push_back ( VK_DYNAMIC_STATE_LINE_WIDTH );
+            }
+        }
+
+    if ( nVariants == 0 )
+        return;
+
+    d_pipelineCreateInfos.resize ( nVariants );
+
+    for ( size_t iVariant = 0; iVariant != nVariants; ++iVariant )
+        preparePipelineCreateInfo (
+            variantSources [ iVariant ].first, variantSources [ iVariant ].second, iVariant );
+
+    std::vector< VkPipeline > pipelineHandles ( nVariants, VK_NULL_HANDLE );
 
     VkResult result = ::vkCreateGraphicsPipelines (
         d_hDevice.handle(),
         d_hPipelineCache.handle(),
-        static_cast< std::uint32_t >( nPipelines ),
+        static_cast< std::uint32_t >( nVariants ),
         & d_pipelineCreateInfos [ 0 ],
         0,
         & pipelineHandles [ 0 ] );
 
-    for ( size_t iProcess = 0, iDest = 0; iProcess != d_pipelineData.size(); ++iProcess )
-        for ( size_t iPipeline = 0; iPipeline != d_pipelineData [ iProcess ].size(); ++iPipeline, ++iDest )
-            if ( pipelineHandles [ iDest ] != VK_NULL_HANDLE )
-                d_pipelineData [ iProcess ][ iPipeline ].d_pipeline =
-                    Pipeline ( pipelineHandles [ iDest ], d_hDevice );
+    std::vector< Pipeline > variantPipelines ( nVariants );
+
+    for ( size_t iVariant = 0; iVariant != nVariants; ++iVariant )
+        if ( pipelineHandles [ iVariant ] != VK_NULL_HANDLE )
+            variantPipelines [ iVariant ] = Pipeline ( pipelineHandles [ iVariant ], d_hDevice );
+
+    for ( size_t iProcess = 0, iSrc = 0; iProcess != d_pipelineData.size(); ++iProcess )
+        for ( size_t iPipeline = 0; iPipeline != d_pipelineData [ iProcess ].size(); ++iPipeline, ++iSrc )
+        {
+            SPipelineData& pipelineData = d_pipelineData [ iProcess ][ iPipeline ];
+            const Pipeline& hVariant = variantPipelines [ pipelineVariants [ iSrc ] ];
+
+            if ( ! hVariant )
+                continue;
+
+            if ( pipelineData.d_foldedState.d_states.empty() )
+                pipelineData.d_pipeline = hVariant;
+            else
+                pipelineData.d_pipeline = Pipeline ( hVariant, pipelineData.d_foldedState );
+        }
 }
 
 // -----------------------------------------------------------------------------
@@ -215,9 +349,25 @@ void RenderPassImpl :: preparePipelineCreateInfo (
     pipelineData.d_processIndex = static_cast< std::uint32_t >( iProcess );
     pipelineData.d_pipelineIndex = static_cast< std::uint32_t >( iPipeline );
 
-    const PipelineConfig::ShaderTable& shaderTable = pipelineData.d_layout.getShaderTable();
-    pInfo->stageCount = static_cast< std::uint32_t >( shaderTable.size() );
-    pInfo->pStages = & shaderTable [ 0 ];
+    const PipelineConfig::ShaderTable* pShaderTable = & pipelineData.d_layout.getShaderTable();
+
+    // Same shader modules, only specialization constants differ.
+    if ( ! pipelineData.d_specialization.empty()
+         && config.initSpecializationInfo (
+                pipelineData.d_specialization,
+                & pipelineData.d_specializationData,
+                & pipelineData.d_specializationInfo ) )
+    {
+        pipelineData.d_specializedStages = *pShaderTable;
+
+        for ( auto& iStage : pipelineData.d_specializedStages )
+            iStage.pSpecializationInfo = & pipelineData.d_specializationInfo;
+
+        pShaderTable = & pipelineData.d_specializedStages;
+    }
+
+    pInfo->stageCount = static_cast< std::uint32_t >( pShaderTable->size() );
+    pInfo->pStages = & ( *pShaderTable )[ 0 ];
 
     config.initVertexInputCreateInfo ( & pipelineData.d_vertexInputInfo );
     pInfo->pVertexInputState = & pipelineData.d_vertexInputInfo;
@@ -247,8 +397,25 @@ void RenderPassImpl :: preparePipelineCreateInfo (
     config.initColorBlendStateInfo ( & pipelineData.d_colorBlendInfo );
     pInfo->pColorBlendState = & pipelineData.d_colorBlendInfo;
 
-    if ( config.initDynamicStateInfo ( & pipelineData.d_dynamicInfo ) )
-        pInfo->pDynamicState = & pipelineData.d_dynamicInfo;
+    // Dynamic states declared by the configuration, plus folded ones.
+
+    const PipelineConfig::DynamicStates& userStates = config.getDynamicStates();
+    pipelineData.d_dynamicStates = userStates;
+
+    for ( VkDynamicState state : pipelineData.d_foldedState.d_states )
+        pipelineData.d_dynamicStates.push_back ( state );
+
+    if ( ! pipelineData.d_dynamicStates.empty() )
+    {
+        VkPipelineDynamicStateCreateInfo& dynamicInfo = pipelineData.d_dynamicInfo;
+        dynamicInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicInfo.pNext = 0;
+        dynamicInfo.flags = 0;
+        dynamicInfo.dynamicStateCount =
+            static_cast< std::uint32_t >( pipelineData.d_dynamicStates.size() );
+        dynamicInfo.pDynamicStates = & pipelineData.d_dynamicStates [ 0 ];
+        pInfo->pDynamicState = & dynamicInfo;
+    }
     else
         pInfo->pDynamicState = 0;
 
@@ -29,6 +29,7 @@
 #include "ph.hpp"
 #include "../include/vppRenderingOptions.hpp"
 #include "../include/vppExceptions.hpp"
+#include "../include/vppPipeline.hpp"
 
 // -----------------------------------------------------------------------------
 namespace vpp {
@@ -943,6 +944,122 @@ void RenderingOptionsImpl :: initDepthStencilInfo (
 
 // -----------------------------------------------------------------------------
 
+static std::uint64_t floatToWord ( float value )
+{
+    std::uint32_t bits;
+    std::memcpy ( & bits, & value, sizeof ( bits ) );
+    return bits;
+}
+
+// -----------------------------------------------------------------------------
+
+void RenderingOptionsImpl :: getVariantKey (
+    std::vector< std::uint64_t >* pWords ) const
+{
+    // Values which are folded into dynamic state (see initFoldedDynamicState)
+    // or ignored by Vulkan due to disabled tests are not part of the key.
+
+    std::vector< std::uint64_t >& words = *pWords;
+
+    words.push_back ( d_polygonMode );
+    words.push_back ( d_cullMode );
+    words.push_back ( d_frontFace );
+    words.push_back ( d_rasterizationSamples );
+
+    words.push_back (
+        ( d_bEnableDepthClamp ? 0x001u : 0 )
+        | ( d_bEnableRasterizerDiscard ? 0x002u : 0 )
+        | ( d_bEnableDepthBias ? 0x004u : 0 )
+        | ( d_bEnableSampleShading ? 0x008u : 0 )
+        | ( d_bEnableAlphaToCoverage ? 0x010u : 0 )
+        | ( d_bEnableResetAlphaToOne ? 0x020u : 0 )
+        | ( d_bEnableDepthTest ? 0x040u : 0 )
+        | ( d_bEnableDepthTest && d_bEnableDepthWrite ? 0x080u : 0 )
+        | ( d_bEnableDepthBoundsTest ? 0x100u : 0 )
+        | ( d_bEnableStencilTest ? 0x200u : 0 )
+        | ( d_bModifyCoverageMask ? 0x400u : 0 ) );
+
+    if ( d_bEnableSampleShading )
+        words.push_back ( floatToWord ( d_sampleShadingAmount ) );
+
+    if ( d_bModifyCoverageMask )
+    {
+        words.push_back ( d_modifiedCoverageMask [ 0 ] );
+        words.push_back ( d_modifiedCoverageMask [ 1 ] );
+    }
+
+    if ( d_bEnableDepthTest )
+        words.push_back ( d_depthCompareOperator );
+
+    if ( d_bEnableStencilTest )
+    {
+        for ( const VkStencilOpState* pCfg : { & d_frontFacingStencilCfg, & d_backFacingStencilCfg } )
+        {
+            words.push_back ( pCfg->failOp );
+            words.push_back ( pCfg->passOp );
+            words.push_back ( pCfg->depthFailOp );
+            words.push_back ( pCfg->compareOp );
+        }
+    }
+
+    words.push_back ( d_viewports.size() );
+    words.push_back ( d_scissors.size() );
+}
+
+// -----------------------------------------------------------------------------
+
+void RenderingOptionsImpl :: initFoldedDynamicState (
+    SFoldedDynamicState* pDest ) const
+{
+    // Only dynamic states available in core Vulkan 1.0 are used here.
+
+    pDest->d_states.clear();
+
+    if ( ! d_viewports.empty() )
+    {
+        pDest->d_states.push_back ( VK_DYNAMIC_STATE_VIEWPORT );
+        pDest->d_viewports = d_viewports;
+    }
+
+    if ( ! d_scissors.empty() )
+    {
+        pDest->d_states.push_back ( VK_DYNAMIC_STATE_SCISSOR );
+        pDest->d_scissors = d_scissors;
+    }
+
+    // Line width is not added to d_states here. It becomes dynamic only when
+    // pipelines sharing a variant use different widths, which is decided by
+    // the render pass after grouping the pipelines.
+
+    pDest->d_lineWidth = d_lineWidth;
+
+    if ( d_bEnableDepthBias )
+    {
+        pDest->d_states.push_back ( VK_DYNAMIC_STATE_DEPTH_BIAS );
+        pDest->d_depthBiasConstantFactor = d_depthBiasConstantFactor;
+        pDest->d_depthBiasClamp = d_depthBiasClamp;
+        pDest->d_depthBiasSlopeFactor = d_depthBiasSlopeFactor;
+    }
+
+    if ( d_bEnableDepthBoundsTest )
+    {
+        pDest->d_states.push_back ( VK_DYNAMIC_STATE_DEPTH_BOUNDS );
+        pDest->d_minDepthBounds = d_minDepthBounds;
+        pDest->d_maxDepthBounds = d_maxDepthBounds;
+    }
+
+    if ( d_bEnableStencilTest )
+    {
+        pDest->d_states.push_back ( VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK );
+        pDest->d_states.push_back ( VK_DYNAMIC_STATE_STENCIL_WRITE_MASK );
+        pDest->d_states.push_back ( VK_DYNAMIC_STATE_STENCIL_REFERENCE );
+        pDest->d_frontStencil = d_frontFacingStencilCfg;
+        pDest->d_backStencil = d_backFacingStencilCfg;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 void RenderingOptions :: addViewport ( const Viewport& vp )
 {
     copyOnWrite();
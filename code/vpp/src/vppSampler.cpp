@@ -28,6 +28,7 @@
 
 #include "ph.hpp"
 #include "../include/vppSampler.hpp"
+#include "../include/vppSamplerCache.hpp"
 
 // -----------------------------------------------------------------------------
 namespace vpp {
@@ -61,8 +62,7 @@ SamplerImpl :: SamplerImpl (
     samplerCreateInfo.borderColor = static_cast< VkBorderColor >( samplerInfo.borderColor );
     samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
 
-    d_result = ::vkCreateSampler (
-        d_hDevice.handle(), & samplerCreateInfo, 0, & d_handle );
+    d_handle = d_hDevice.samplerCache().acquireSampler ( samplerCreateInfo, & d_result );
 }
 
 // -----------------------------------------------------------------------------
@@ -100,8 +100,7 @@ SamplerImpl :: SamplerImpl (
     samplerCreateInfo.borderColor = static_cast< VkBorderColor >( samplerInfo.borderColor );
     samplerCreateInfo.unnormalizedCoordinates = VK_TRUE;
 
-    d_result = ::vkCreateSampler (
-        d_hDevice.handle(), & samplerCreateInfo, 0, & d_handle );
+    d_handle = d_hDevice.samplerCache().acquireSampler ( samplerCreateInfo, & d_result );
 }
 
 // -----------------------------------------------------------------------------
@@ -109,7 +108,7 @@ SamplerImpl :: SamplerImpl (
 SamplerImpl :: ~SamplerImpl()
 {
     if ( d_result == VK_SUCCESS )
-        ::vkDestroySampler ( d_hDevice.handle(), d_handle, 0 );
+        d_hDevice.samplerCache().releaseSampler ( d_handle );
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,174 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppSamplerCache.hpp"
+#include "../include/vppDestructionQueue.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+static std::uint64_t floatToWord ( float value )
+{
+    std::uint32_t bits;
+    std::memcpy ( & bits, & value, sizeof ( bits ) );
+    return bits;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool makeSamplerKey (
+    const VkSamplerCreateInfo& createInfo,
+    std::vector< std::uint64_t >* pWords )
+{
+    if ( createInfo.pNext )
+        return false;
+
+    std::vector< std::uint64_t >& words = *pWords;
+
+    words.push_back ( createInfo.flags );
+    words.push_back ( createInfo.magFilter );
+    words.push_back ( createInfo.minFilter );
+    words.push_back ( createInfo.mipmapMode );
+    words.push_back ( createInfo.addressModeU );
+    words.push_back ( createInfo.addressModeV );
+    words.push_back ( createInfo.addressModeW );
+    words.push_back ( floatToWord ( createInfo.mipLodBias ) );
+    words.push_back ( createInfo.anisotropyEnable );
+
+    // Values ignored by Vulkan do not make samplers different.
+
+    words.push_back ( createInfo.anisotropyEnable ?
+        floatToWord ( createInfo.maxAnisotropy ) : 0 );
+
+    words.push_back ( createInfo.compareEnable );
+    words.push_back ( createInfo.compareEnable ? createInfo.compareOp : 0 );
+    words.push_back ( floatToWord ( createInfo.minLod ) );
+    words.push_back ( floatToWord ( createInfo.maxLod ) );
+    words.push_back ( createInfo.borderColor );
+    words.push_back ( createInfo.unnormalizedCoordinates );
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+SamplerCache :: ~SamplerCache()
+{
+    // Normally empty here, as every sampler object keeps the device alive.
+
+    const VkDevice hDevice = d_hDevice;
+
+    d_samplers.forEachHandle ( [ hDevice ]( VkSampler hSampler ) {
+        ::vkDestroySampler ( hDevice, hSampler, 0 ); } );
+}
+
+// -----------------------------------------------------------------------------
+
+VkSampler SamplerCache :: acquireSampler (
+    const VkSamplerCreateInfo& createInfo,
+    VkResult* pResult )
+{
+    typedef THandleCache< VkSampler > Cache;
+
+    VkSampler hSampler = VK_NULL_HANDLE;
+    Cache::Key key;
+
+    if ( ! makeSamplerKey ( createInfo, & key.second ) )
+    {
+        // Unknown extension structure - not cached.
+        *pResult = ::vkCreateSampler ( d_hDevice, & createInfo, 0, & hSampler );
+        return hSampler;
+    }
+
+    key.first = Cache::hashWords ( key.second );
+
+    std::lock_guard< std::mutex > lock ( d_mutex );
+
+    hSampler = d_samplers.acquire ( key );
+
+    if ( hSampler != VK_NULL_HANDLE )
+    {
+        *pResult = VK_SUCCESS;
+        return hSampler;
+    }
+
+    *pResult = ::vkCreateSampler ( d_hDevice, & createInfo, 0, & hSampler );
+
+    if ( *pResult == VK_SUCCESS )
+        d_samplers.add ( key, hSampler );
+
+    return hSampler;
+}
+
+// -----------------------------------------------------------------------------
+
+void SamplerCache :: releaseSampler ( VkSampler hSampler )
+{
+    {
+        std::lock_guard< std::mutex > lock ( d_mutex );
+
+        if ( ! d_samplers.release ( hSampler ) )
+            return;
+    }
+
+    const VkDevice hDevice = d_hDevice;
+
+    d_pDestructionQueue->enqueue ( [ hDevice, hSampler ]() {
+        ::vkDestroySampler ( hDevice, hSampler, 0 ); } );
+}
+
+// -----------------------------------------------------------------------------
+
+size_t SamplerCache :: samplerCount() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    return d_samplers.size();
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t SamplerCache :: hitCount() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    return d_samplers.hitCount();
+}
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t SamplerCache :: missCount() const
+{
+    std::lock_guard< std::mutex > lock ( d_mutex );
+    return d_samplers.missCount();
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
@@ -328,7 +328,9 @@ KShaderModule computeShader :: compileShader (
     KShaderTranslator translator ( VK_SHADER_STAGE_COMPUTE_BIT, hDevice );
 
     {
-        ComputeShader shaderRoot ( d_localSize );
+        ComputeShader shaderRoot (
+            d_localSize, d_bSpecializedLocalSize ? & d_localSizeIds : 0 );
+
         d_definition ( & shaderRoot );
 
         if ( shaderRoot.isDebugCodeDumpEnabled() )
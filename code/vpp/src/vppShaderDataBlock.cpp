@@ -0,0 +1,164 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppShaderDataBlock.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+namespace detail {
+// -----------------------------------------------------------------------------
+
+KDescriptorUpdateTemplate :: ~KDescriptorUpdateTemplate()
+{
+    for ( VkDescriptorUpdateTemplate hTemplate : d_templates )
+        ::vkDestroyDescriptorUpdateTemplate ( d_hDevice.handle(), hTemplate, 0 );
+}
+
+// -----------------------------------------------------------------------------
+
+void KDescriptorUpdateTemplate :: addEntry (
+    VkDescriptorType type,
+    std::uint32_t set,
+    std::uint32_t binding,
+    std::uint32_t startIndex,
+    std::uint32_t count,
+    std::uint32_t stride )
+{
+    SEntry entry;
+
+    entry.d_entry.dstBinding = binding;
+    entry.d_entry.dstArrayElement = startIndex;
+    entry.d_entry.descriptorCount = count;
+    entry.d_entry.descriptorType = type;
+    entry.d_entry.offset = d_payloadSize;
+    entry.d_entry.stride = stride;
+    entry.d_set = set;
+    entry.d_firstItem = d_itemCount;
+
+    d_entries.push_back ( entry );
+    d_payloadSize += count * stride;
+    d_itemCount += count;
+}
+
+// -----------------------------------------------------------------------------
+
+void KDescriptorUpdateTemplate :: create (
+    const PipelineLayoutBase& hLayout, size_t payloadCapacity )
+{
+    d_bValid = false;
+
+    if ( d_entries.empty()
+         || d_payloadSize > payloadCapacity
+         || ! d_hDevice.supportsVersion ( { 1, 1, 0 } ) )
+    {
+        return;
+    }
+
+    std::vector< std::uint32_t > sets;
+
+    for ( const SEntry& entry : d_entries )
+    {
+        if ( entry.d_entry.descriptorCount == 0 )
+            return;
+
+        if ( std::find ( sets.begin(), sets.end(), entry.d_set ) == sets.end() )
+            sets.push_back ( entry.d_set );
+    }
+
+    const std::vector< VkDescriptorSetLayout >& setLayouts =
+        hLayout.getDescriptorSetLayoutHandles();
+
+    std::vector< VkDescriptorUpdateTemplateEntry > setEntries;
+    setEntries.reserve ( d_entries.size() );
+
+    for ( std::uint32_t set : sets )
+    {
+        if ( set >= setLayouts.size() || hLayout.isPushDescriptorSet ( set ) )
+            return;
+
+        setEntries.clear();
+
+        for ( const SEntry& entry : d_entries )
+            if ( entry.d_set == set )
+                setEntries.push_back ( entry.d_entry );
+
+        VkDescriptorUpdateTemplateCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        createInfo.pNext = 0;
+        createInfo.flags = 0;
+        createInfo.descriptorUpdateEntryCount = static_cast< std::uint32_t >( setEntries.size() );
+        createInfo.pDescriptorUpdateEntries = & setEntries [ 0 ];
+        createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        createInfo.descriptorSetLayout = setLayouts [ set ];
+
+        createInfo.pipelineBindPoint = (
+            hLayout.isComputePipeline() ?
+                VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS );
+
+        createInfo.pipelineLayout = hLayout.handle();
+        createInfo.set = set;
+
+        VkDescriptorUpdateTemplate hTemplate = VK_NULL_HANDLE;
+
+        if ( ::vkCreateDescriptorUpdateTemplate (
+                d_hDevice.handle(), & createInfo, 0, & hTemplate ) != VK_SUCCESS )
+        {
+            return;
+        }
+
+        d_templates.push_back ( hTemplate );
+        d_templateSets.push_back ( set );
+    }
+
+    d_bValid = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void KDescriptorUpdateTemplate :: apply (
+    const ShaderDataBlock& hDataBlock, const void* pPayload ) const
+{
+    const VkDevice hDevice = d_hDevice.handle();
+
+    for ( size_t iTemplate = 0; iTemplate != d_templates.size(); ++iTemplate )
+        ::vkUpdateDescriptorSetWithTemplate (
+            hDevice,
+            hDataBlock.getDescriptorSet ( d_templateSets [ iTemplate ] ),
+            d_templates [ iTemplate ],
+            pPayload );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace detail
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
@@ -0,0 +1,627 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// -----------------------------------------------------------------------------
+
+#include "ph.hpp"
+#include "../include/vppTextureContainer.hpp"
+#include <cstring>
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+template< typename T >
+static T readValue ( const unsigned char* pData, size_t offset )
+{
+    T result;
+    std::memcpy ( & result, pData + offset, sizeof ( T ) );
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+static std::uint32_t makeFourCC ( char c0, char c1, char c2, char c3 )
+{
+    return static_cast< std::uint32_t >( static_cast< unsigned char >( c0 ) )
+        | ( static_cast< std::uint32_t >( static_cast< unsigned char >( c1 ) ) << 8 )
+        | ( static_cast< std::uint32_t >( static_cast< unsigned char >( c2 ) ) << 16 )
+        | ( static_cast< std::uint32_t >( static_cast< unsigned char >( c3 ) ) << 24 );
+}
+
+// -----------------------------------------------------------------------------
+
+static const unsigned char s_ktx2Identifier [ 12 ] =
+{
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+static const size_t KTX2_HEADER_SIZE = 80;
+static const size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+
+static const size_t DDS_HEADER_SIZE = 128;
+static const size_t DDS_DX10_HEADER_SIZE = 20;
+
+static const std::uint32_t DDSD_DEPTH = 0x800000;
+static const std::uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+static const std::uint32_t DDPF_FOURCC = 0x4;
+static const std::uint32_t DDPF_RGB = 0x40;
+static const std::uint32_t DDSCAPS2_CUBEMAP = 0x200;
+static const std::uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+// -----------------------------------------------------------------------------
+
+static VkFormat dxgiToVulkanFormat ( std::uint32_t dxgiFormat )
+{
+    switch ( dxgiFormat )
+    {
+        case 2: return VK_FORMAT_R32G32B32A32_SFLOAT;
+        case 10: return VK_FORMAT_R16G16B16A16_SFLOAT;
+        case 24: return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+        case 26: return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+        case 28: return VK_FORMAT_R8G8B8A8_UNORM;
+        case 29: return VK_FORMAT_R8G8B8A8_SRGB;
+        case 34: return VK_FORMAT_R16G16_SFLOAT;
+        case 41: return VK_FORMAT_R32_SFLOAT;
+        case 49: return VK_FORMAT_R8G8_UNORM;
+        case 54: return VK_FORMAT_R16_SFLOAT;
+        case 61: return VK_FORMAT_R8_UNORM;
+        case 67: return VK_FORMAT_E5B9G9R9_UFLOAT_PACK32;
+        case 71: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case 72: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case 74: return VK_FORMAT_BC2_UNORM_BLOCK;
+        case 75: return VK_FORMAT_BC2_SRGB_BLOCK;
+        case 77: return VK_FORMAT_BC3_UNORM_BLOCK;
+        case 78: return VK_FORMAT_BC3_SRGB_BLOCK;
+        case 80: return VK_FORMAT_BC4_UNORM_BLOCK;
+        case 81: return VK_FORMAT_BC4_SNORM_BLOCK;
+        case 83: return VK_FORMAT_BC5_UNORM_BLOCK;
+        case 84: return VK_FORMAT_BC5_SNORM_BLOCK;
+        case 87: return VK_FORMAT_B8G8R8A8_UNORM;
+        case 91: return VK_FORMAT_B8G8R8A8_SRGB;
+        case 95: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+        case 96: return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+        case 98: return VK_FORMAT_BC7_UNORM_BLOCK;
+        case 99: return VK_FORMAT_BC7_SRGB_BLOCK;
+        default: return VK_FORMAT_UNDEFINED;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+static VkFormat fourCCToVulkanFormat ( std::uint32_t fourCC )
+{
+    if ( fourCC == makeFourCC ( 'D', 'X', 'T', '1' ) )
+        return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    else if ( fourCC == makeFourCC ( 'D', 'X', 'T', '3' ) )
+        return VK_FORMAT_BC2_UNORM_BLOCK;
+    else if ( fourCC == makeFourCC ( 'D', 'X', 'T', '5' ) )
+        return VK_FORMAT_BC3_UNORM_BLOCK;
+    else if ( fourCC == makeFourCC ( 'A', 'T', 'I', '1' )
+              || fourCC == makeFourCC ( 'B', 'C', '4', 'U' ) )
+        return VK_FORMAT_BC4_UNORM_BLOCK;
+    else if ( fourCC == makeFourCC ( 'B', 'C', '4', 'S' ) )
+        return VK_FORMAT_BC4_SNORM_BLOCK;
+    else if ( fourCC == makeFourCC ( 'A', 'T', 'I', '2' )
+              || fourCC == makeFourCC ( 'B', 'C', '5', 'U' ) )
+        return VK_FORMAT_BC5_UNORM_BLOCK;
+    else if ( fourCC == makeFourCC ( 'B', 'C', '5', 'S' ) )
+        return VK_FORMAT_BC5_SNORM_BLOCK;
+    else if ( fourCC == 113 )
+        return VK_FORMAT_R16G16B16A16_SFLOAT;
+    else if ( fourCC == 116 )
+        return VK_FORMAT_R32G32B32A32_SFLOAT;
+    else
+        return VK_FORMAT_UNDEFINED;
+}
+
+// -----------------------------------------------------------------------------
+
+static std::uint32_t getGcd ( std::uint32_t a, std::uint32_t b )
+{
+    while ( b )
+    {
+        const std::uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+// -----------------------------------------------------------------------------
+
+bool TextureContainer :: getBlockInfo ( VkFormat format, SBlockInfo* pInfo )
+{
+    struct SASTCBlock
+    {
+        VkFormat d_unorm;
+        VkFormat d_srgb;
+        std::uint32_t d_width;
+        std::uint32_t d_height;
+    };
+
+    static const SASTCBlock s_astcBlocks [] =
+    {
+        { VK_FORMAT_ASTC_4x4_UNORM_BLOCK, VK_FORMAT_ASTC_4x4_SRGB_BLOCK, 4, 4 },
+        { VK_FORMAT_ASTC_5x4_UNORM_BLOCK, VK_FORMAT_ASTC_5x4_SRGB_BLOCK, 5, 4 },
+        { VK_FORMAT_ASTC_5x5_UNORM_BLOCK, VK_FORMAT_ASTC_5x5_SRGB_BLOCK, 5, 5 },
+        { VK_FORMAT_ASTC_6x5_UNORM_BLOCK, VK_FORMAT_ASTC_6x5_SRGB_BLOCK, 6, 5 },
+        { VK_FORMAT_ASTC_6x6_UNORM_BLOCK, VK_FORMAT_ASTC_6x6_SRGB_BLOCK, 6, 6 },
+        { VK_FORMAT_ASTC_8x5_UNORM_BLOCK, VK_FORMAT_ASTC_8x5_SRGB_BLOCK, 8, 5 },
+        { VK_FORMAT_ASTC_8x6_UNORM_BLOCK, VK_FORMAT_ASTC_8x6_SRGB_BLOCK, 8, 6 },
+        { VK_FORMAT_ASTC_8x8_UNORM_BLOCK, VK_FORMAT_ASTC_8x8_SRGB_BLOCK, 8, 8 },
+        { VK_FORMAT_ASTC_10x5_UNORM_BLOCK, VK_FORMAT_ASTC_10x5_SRGB_BLOCK, 10, 5 },
+        { VK_FORMAT_ASTC_10x6_UNORM_BLOCK, VK_FORMAT_ASTC_10x6_SRGB_BLOCK, 10, 6 },
+        { VK_FORMAT_ASTC_10x8_UNORM_BLOCK, VK_FORMAT_ASTC_10x8_SRGB_BLOCK, 10, 8 },
+        { VK_FORMAT_ASTC_10x10_UNORM_BLOCK, VK_FORMAT_ASTC_10x10_SRGB_BLOCK, 10, 10 },
+        { VK_FORMAT_ASTC_12x10_UNORM_BLOCK, VK_FORMAT_ASTC_12x10_SRGB_BLOCK, 12, 10 },
+        { VK_FORMAT_ASTC_12x12_UNORM_BLOCK, VK_FORMAT_ASTC_12x12_SRGB_BLOCK, 12, 12 }
+    };
+
+    SBlockInfo info = { 1, 1, 0 };
+
+    switch ( format )
+    {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+        case VK_FORMAT_BC4_SNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+        case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+        case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+            info = { 4, 4, 8 };
+            break;
+
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC5_SNORM_BLOCK:
+        case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+        case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+        case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+        case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+            info = { 4, 4, 16 };
+            break;
+
+        case VK_FORMAT_R8_UNORM:
+        case VK_FORMAT_R8_SRGB:
+            info.d_bytes = 1;
+            break;
+
+        case VK_FORMAT_R8G8_UNORM:
+        case VK_FORMAT_R16_SFLOAT:
+            info.d_bytes = 2;
+            break;
+
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+        case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+        case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
+        case VK_FORMAT_R16G16_SFLOAT:
+        case VK_FORMAT_R32_SFLOAT:
+            info.d_bytes = 4;
+            break;
+
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+        case VK_FORMAT_R32G32_SFLOAT:
+            info.d_bytes = 8;
+            break;
+
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            info.d_bytes = 16;
+            break;
+
+        default:
+            for ( const auto& iBlock : s_astcBlocks )
+                if ( format == iBlock.d_unorm || format == iBlock.d_srgb )
+                {
+                    info = { iBlock.d_width, iBlock.d_height, 16 };
+                    break;
+                }
+            break;
+    }
+
+    if ( info.d_bytes == 0 )
+        return false;
+
+    if ( pInfo )
+        *pInfo = info;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+TextureContainer :: TextureContainer ( const std::string& fileName ) :
+    d_file ( fileName ),
+    d_containerType ( CONTAINER_KTX2 ),
+    d_format ( VK_FORMAT_UNDEFINED ),
+    d_extent { 1, 1, 1 },
+    d_mipLevels ( 1 ),
+    d_arrayLayers ( 1 ),
+    d_faces ( 1 ),
+    d_blockInfo { 1, 1, 0 },
+    d_dataSize ( 0 )
+{
+    if ( ! d_file.valid() )
+        throw XInvalidTextureFile ( "Unable to open texture file: " + fileName );
+
+    if ( d_file.size() >= KTX2_HEADER_SIZE
+         && std::memcmp ( d_file.begin(), s_ktx2Identifier, sizeof ( s_ktx2Identifier ) ) == 0 )
+    {
+        d_containerType = CONTAINER_KTX2;
+        parseKTX2();
+    }
+    else if ( d_file.size() >= DDS_HEADER_SIZE
+              && readValue< std::uint32_t >( d_file.begin(), 0 ) == makeFourCC ( 'D', 'D', 'S', ' ' ) )
+    {
+        d_containerType = CONTAINER_DDS;
+        parseDDS();
+    }
+    else
+        throw XInvalidTextureFile ( "Unrecognized texture container format: " + fileName );
+
+    computeDestOffsets();
+}
+
+// -----------------------------------------------------------------------------
+
+void TextureContainer :: parseKTX2()
+{
+    const unsigned char* pData = d_file.begin();
+
+    d_format = static_cast< VkFormat >( readValue< std::uint32_t >( pData, 12 ) );
+    d_extent.width = readValue< std::uint32_t >( pData, 20 );
+    d_extent.height = std::max ( readValue< std::uint32_t >( pData, 24 ), 1u );
+    d_extent.depth = std::max ( readValue< std::uint32_t >( pData, 28 ), 1u );
+    d_arrayLayers = std::max ( readValue< std::uint32_t >( pData, 32 ), 1u );
+    d_faces = readValue< std::uint32_t >( pData, 36 );
+    d_mipLevels = std::max ( readValue< std::uint32_t >( pData, 40 ), 1u );
+
+    const std::uint32_t supercompressionScheme = readValue< std::uint32_t >( pData, 44 );
+
+    if ( supercompressionScheme != 0 )
+        throw XInvalidTextureFile ( "Supercompressed KTX2 textures are not supported" );
+
+    if ( d_format == VK_FORMAT_UNDEFINED || ! getBlockInfo ( d_format, & d_blockInfo ) )
+        throw XInvalidTextureFile ( "Unsupported KTX2 texture format" );
+
+    if ( d_extent.width == 0 || ( d_faces != 1 && d_faces != 6 ) )
+        throw XInvalidTextureFile ( "Invalid KTX2 texture header" );
+
+    validateHeader ( "Invalid KTX2 texture header" );
+
+    const size_t levelIndexEnd =
+        KTX2_HEADER_SIZE + d_mipLevels * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+
+    if ( levelIndexEnd > d_file.size() )
+        throw XInvalidTextureFile ( "Truncated KTX2 level index" );
+
+    d_levels.resize ( d_mipLevels );
+
+    for ( std::uint32_t iLevel = 0; iLevel != d_mipLevels; ++iLevel )
+    {
+        const size_t entryOffset = KTX2_HEADER_SIZE + iLevel * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        const std::uint64_t byteOffset = readValue< std::uint64_t >( pData, entryOffset );
+        const std::uint64_t byteLength = readValue< std::uint64_t >( pData, entryOffset + 8 );
+
+        if ( byteLength > d_file.size()
+             || byteOffset > d_file.size() - byteLength
+             || byteLength != computeLevelSize ( iLevel ) )
+        {
+            throw XInvalidTextureFile ( "Invalid KTX2 level data" );
+        }
+
+        // KTX2 stores layers and faces of a level contiguously, in the same
+        // order as Vulkan array layers.
+        SLevel& level = d_levels [ iLevel ];
+        level.d_size = byteLength;
+        level.d_chunks.push_back ( std::make_pair (
+            static_cast< size_t >( byteOffset ), static_cast< size_t >( byteLength ) ) );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void TextureContainer :: parseDDS()
+{
+    const unsigned char* pData = d_file.begin();
+
+    const std::uint32_t flags = readValue< std::uint32_t >( pData, 8 );
+    const std::uint32_t pixelFormatFlags = readValue< std::uint32_t >( pData, 80 );
+    const std::uint32_t fourCC = readValue< std::uint32_t >( pData, 84 );
+    const std::uint32_t caps2 = readValue< std::uint32_t >( pData, 112 );
+
+    d_extent.height = std::max ( readValue< std::uint32_t >( pData, 12 ), 1u );
+    d_extent.width = std::max ( readValue< std::uint32_t >( pData, 16 ), 1u );
+
+    if ( flags & DDSD_DEPTH )
+        d_extent.depth = std::max ( readValue< std::uint32_t >( pData, 24 ), 1u );
+
+    if ( flags & DDSD_MIPMAPCOUNT )
+        d_mipLevels = std::max ( readValue< std::uint32_t >( pData, 28 ), 1u );
+
+    size_t dataOffset = DDS_HEADER_SIZE;
+
+    if ( ( pixelFormatFlags & DDPF_FOURCC ) && fourCC == makeFourCC ( 'D', 'X', '1', '0' ) )
+    {
+        if ( d_file.size() < DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE )
+            throw XInvalidTextureFile ( "Truncated DDS DX10 header" );
+
+        d_format = dxgiToVulkanFormat ( readValue< std::uint32_t >( pData, 128 ) );
+
+        const std::uint32_t miscFlag = readValue< std::uint32_t >( pData, 136 );
+        d_arrayLayers = std::max ( readValue< std::uint32_t >( pData, 140 ), 1u );
+
+        if ( miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE )
+            d_faces = 6;
+
+        dataOffset += DDS_DX10_HEADER_SIZE;
+    }
+    else
+    {
+        if ( pixelFormatFlags & DDPF_FOURCC )
+            d_format = fourCCToVulkanFormat ( fourCC );
+        else if ( ( pixelFormatFlags & DDPF_RGB )
+                  && readValue< std::uint32_t >( pData, 88 ) == 32
+                  && readValue< std::uint32_t >( pData, 104 ) == 0xff000000u )
+        {
+            const std::uint32_t redMask = readValue< std::uint32_t >( pData, 92 );
+
+            if ( redMask == 0x000000ffu )
+                d_format = VK_FORMAT_R8G8B8A8_UNORM;
+            else if ( redMask == 0x00ff0000u )
+                d_format = VK_FORMAT_B8G8R8A8_UNORM;
+        }
+
+        if ( caps2 & DDSCAPS2_CUBEMAP )
+            d_faces = 6;
+    }
+
+    if ( d_format == VK_FORMAT_UNDEFINED || ! getBlockInfo ( d_format, & d_blockInfo ) )
+        throw XInvalidTextureFile ( "Unsupported DDS texture format" );
+
+    validateHeader ( "Invalid DDS texture header" );
+
+    // DDS stores all levels of the first layer, then all levels of the next
+    // one, and so on. Collect the chunks per level to repack them level-major.
+
+    d_levels.resize ( d_mipLevels );
+
+    const std::uint32_t nLayers = d_arrayLayers * d_faces;
+    VkDeviceSize layerSize = 0;
+
+    for ( std::uint32_t iLevel = 0; iLevel != d_mipLevels; ++iLevel )
+    {
+        d_levels [ iLevel ].d_size = computeLevelSize ( iLevel );
+        layerSize += d_levels [ iLevel ].d_size / nLayers;
+    }
+
+    if ( dataOffset > d_file.size()
+         || layerSize * nLayers > d_file.size() - dataOffset )
+    {
+        throw XInvalidTextureFile ( "Truncated DDS texture data" );
+    }
+
+    for ( std::uint32_t iLayer = 0; iLayer != nLayers; ++iLayer )
+    {
+        size_t chunkOffset = static_cast< size_t >( dataOffset + iLayer * layerSize );
+
+        for ( auto& iLevel : d_levels )
+        {
+            const size_t chunkSize = static_cast< size_t >( iLevel.d_size / nLayers );
+            iLevel.d_chunks.push_back ( std::make_pair ( chunkOffset, chunkSize ) );
+            chunkOffset += chunkSize;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+VkDeviceSize TextureContainer :: computeLevelSize ( std::uint32_t level ) const
+{
+    const std::uint32_t width = std::max ( d_extent.width >> level, 1u );
+    const std::uint32_t height = std::max ( d_extent.height >> level, 1u );
+    const std::uint32_t depth = std::max ( d_extent.depth >> level, 1u );
+
+    const VkDeviceSize blocksX =
+        ( VkDeviceSize ( width ) + d_blockInfo.d_width - 1 ) / d_blockInfo.d_width;
+    const VkDeviceSize blocksY =
+        ( VkDeviceSize ( height ) + d_blockInfo.d_height - 1 ) / d_blockInfo.d_height;
+
+    return blocksX * blocksY * depth * d_blockInfo.d_bytes * d_arrayLayers * d_faces;
+}
+
+// -----------------------------------------------------------------------------
+
+void TextureContainer :: validateHeader ( const char* pErrorMessage ) const
+{
+    // The base level must fit in the file, which bounds all later size
+    // computations. Each factor is checked before multiplying, so that
+    // a malicious header can not overflow the product.
+
+    const VkDeviceSize fileSize = d_file.size();
+
+    const VkDeviceSize factors [] =
+    {
+        ( VkDeviceSize ( d_extent.width ) + d_blockInfo.d_width - 1 ) / d_blockInfo.d_width,
+        ( VkDeviceSize ( d_extent.height ) + d_blockInfo.d_height - 1 ) / d_blockInfo.d_height,
+        d_extent.depth,
+        d_arrayLayers,
+        d_faces
+    };
+
+    VkDeviceSize baseLevelSize = d_blockInfo.d_bytes;
+
+    for ( VkDeviceSize iFactor : factors )
+    {
+        if ( iFactor > fileSize / baseLevelSize )
+            throw XInvalidTextureFile ( pErrorMessage );
+
+        baseLevelSize *= iFactor;
+    }
+
+    // Levels beyond the 1x1x1 one do not exist.
+
+    std::uint32_t maxExtent = std::max (
+        std::max ( d_extent.width, d_extent.height ), d_extent.depth );
+
+    std::uint32_t maxMipLevels = 1;
+
+    while ( maxExtent >>= 1 )
+        ++maxMipLevels;
+
+    if ( d_mipLevels > maxMipLevels )
+        throw XInvalidTextureFile ( pErrorMessage );
+}
+
+// -----------------------------------------------------------------------------
+
+void TextureContainer :: computeDestOffsets()
+{
+    // Buffer offsets of copy regions must be multiples of both 4 and
+    // the texel block size.
+    const std::uint32_t alignment =
+        4 * d_blockInfo.d_bytes / getGcd ( 4, d_blockInfo.d_bytes );
+
+    VkDeviceSize offset = 0;
+
+    for ( auto& iLevel : d_levels )
+    {
+        offset = ( offset + alignment - 1 ) / alignment * alignment;
+        iLevel.d_destOffset = offset;
+        offset += iLevel.d_size;
+    }
+
+    d_dataSize = offset;
+}
+
+// -----------------------------------------------------------------------------
+
+void TextureContainer :: copyLevels ( unsigned char* pDest ) const
+{
+    const unsigned char* pSource = d_file.begin();
+
+    for ( const auto& iLevel : d_levels )
+    {
+        unsigned char* pLevelDest = pDest + iLevel.d_destOffset;
+
+        for ( const auto& iChunk : iLevel.d_chunks )
+        {
+            detail::copyToWriteCombined ( pLevelDest, pSource + iChunk.first, iChunk.second );
+            pLevelDest += iChunk.second;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void TextureContainer :: defineRegions (
+    std::vector< VkBufferImageCopy >* pRegions,
+    VkDeviceSize bufferOffset ) const
+{
+    pRegions->reserve ( pRegions->size() + d_levels.size() );
+
+    for ( std::uint32_t iLevel = 0; iLevel != d_mipLevels; ++iLevel )
+    {
+        VkBufferImageCopy region;
+        region.bufferOffset = bufferOffset + d_levels [ iLevel ].d_destOffset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = iLevel;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = d_arrayLayers * d_faces;
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent.width = std::max ( d_extent.width >> iLevel, 1u );
+        region.imageExtent.height = std::max ( d_extent.height >> iLevel, 1u );
+        region.imageExtent.depth = std::max ( d_extent.depth >> iLevel, 1u );
+        pRegions->push_back ( region );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void TextureContainer :: checkSupport ( const Device& hDevice ) const
+{
+    if ( d_format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && d_format <= VK_FORMAT_BC7_SRGB_BLOCK )
+    {
+        if ( ! hDevice.hasFeature ( fTextureCompressionBC ) )
+            throw XMissingFeature ( DeviceFeatures::getFeatureName ( fTextureCompressionBC ) );
+    }
+    else if ( d_format >= VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+              && d_format <= VK_FORMAT_EAC_R11G11_SNORM_BLOCK )
+    {
+        if ( ! hDevice.hasFeature ( fTextureCompressionETC2 ) )
+            throw XMissingFeature ( DeviceFeatures::getFeatureName ( fTextureCompressionETC2 ) );
+    }
+    else if ( d_format >= VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+              && d_format <= VK_FORMAT_ASTC_12x12_SRGB_BLOCK )
+    {
+        if ( ! hDevice.hasFeature ( fTextureCompressionASTC_LDR ) )
+            throw XMissingFeature ( DeviceFeatures::getFeatureName ( fTextureCompressionASTC_LDR ) );
+    }
+
+    const VkFormatFeatureFlags formatFeatures =
+        hDevice.physical().supportsFormat ( d_format );
+
+    if ( ! ( formatFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT ) )
+        throw XInvalidTextureFile ( "Texture format is not supported by the device" );
+}
+
+// -----------------------------------------------------------------------------
+
+void TextureContainer :: checkImageType (
+    bool bMipMapped, bool bArrayed, bool bCubeCompatible ) const
+{
+    if ( d_mipLevels > 1 && ! bMipMapped )
+        throw XUsageError ( "Texture has multiple mip levels, but the image is not mip-mapped" );
+
+    if ( d_arrayLayers * d_faces > 1 && ! bArrayed )
+        throw XUsageError ( "Texture has multiple layers or faces, but the image is not arrayed" );
+
+    if ( d_faces == 6 && ! bCubeCompatible )
+        throw XUsageError ( "Texture is a cube map, but the image is not cube compatible" );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
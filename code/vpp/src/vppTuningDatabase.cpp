@@ -0,0 +1,207 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ph.hpp"
+#include "../include/vppTuningDatabase.hpp"
+#include "../include/vppExceptions.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+static const char* const TUNING_DATABASE_HEADER = "# VPP tuning database 1";
+
+// -----------------------------------------------------------------------------
+
+static std::string makeEntryKey (
+    const PhysicalDevice& hDevice, const std::string& kernelKey )
+{
+    if ( kernelKey.empty()
+         || kernelKey.find_first_of ( " \t\r\n" ) != std::string::npos )
+    {
+        throw XUsageError ( "Tuning database kernel key must be non-empty and contain no whitespace." );
+    }
+
+    return TuningDatabase::deviceKey ( hDevice ) + ' ' + kernelKey;
+}
+
+// -----------------------------------------------------------------------------
+
+TuningDatabase :: TuningDatabase ( const std::string& fileName ) :
+    TSharedReference< TuningDatabaseImpl >( new TuningDatabaseImpl ( fileName ) )
+{
+    load();
+}
+
+// -----------------------------------------------------------------------------
+
+bool TuningDatabase :: load()
+{
+    std::ifstream inputFile ( get()->d_fileName.c_str() );
+
+    if ( ! inputFile )
+        return false;
+
+    std::string line;
+
+    if ( ! std::getline ( inputFile, line ) || line != TUNING_DATABASE_HEADER )
+        return false;
+
+    TuningDatabaseImpl::Entries entries;
+
+    // Line format: <device UUID> <kernel key> <time ns> [<id>=<bits> ...]
+    while ( std::getline ( inputFile, line ) )
+    {
+        if ( line.empty() || line [ 0 ] == '#' )
+            continue;
+
+        std::istringstream lineStream ( line );
+        std::string device;
+        std::string kernel;
+        TuningDatabaseImpl::SEntry entry;
+
+        if ( ! ( lineStream >> device >> kernel >> entry.d_timeNs ) )
+            return false;
+
+        std::string value;
+
+        while ( lineStream >> value )
+        {
+            std::istringstream valueStream ( value );
+            std::uint32_t id = 0;
+            std::uint32_t bits = 0;
+            char separator = 0;
+
+            if ( ! ( valueStream >> id >> separator >> std::hex >> bits )
+                 || separator != '=' )
+            {
+                return false;
+            }
+
+            entry.d_values.setBits ( id, bits );
+        }
+
+        entries [ device + ' ' + kernel ] = entry;
+    }
+
+    get()->d_entries.swap ( entries );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool TuningDatabase :: save() const
+{
+    std::ofstream outputFile ( get()->d_fileName.c_str(), std::ios::trunc );
+
+    if ( ! outputFile )
+        return false;
+
+    outputFile << TUNING_DATABASE_HEADER << '\n';
+
+    for ( const auto& iEntry : get()->d_entries )
+    {
+        outputFile << iEntry.first << ' ' << iEntry.second.d_timeNs;
+
+        for ( const auto& iValue : iEntry.second.d_values.values() )
+            outputFile << ' ' << iValue.first << '=' << std::hex << iValue.second << std::dec;
+
+        outputFile << '\n';
+    }
+
+    return static_cast< bool >( outputFile );
+}
+
+// -----------------------------------------------------------------------------
+
+bool TuningDatabase :: find (
+    const PhysicalDevice& hDevice,
+    const std::string& kernelKey,
+    SpecializationValues* pValues,
+    double* pTimeNs ) const
+{
+    const TuningDatabaseImpl::Entries::const_iterator iEntry =
+        get()->d_entries.find ( makeEntryKey ( hDevice, kernelKey ) );
+
+    if ( iEntry == get()->d_entries.end() )
+        return false;
+
+    *pValues = iEntry->second.d_values;
+
+    if ( pTimeNs )
+        *pTimeNs = iEntry->second.d_timeNs;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void TuningDatabase :: store (
+    const PhysicalDevice& hDevice,
+    const std::string& kernelKey,
+    const SpecializationValues& values,
+    double timeNs )
+{
+    TuningDatabaseImpl::SEntry& entry =
+        get()->d_entries [ makeEntryKey ( hDevice, kernelKey ) ];
+
+    entry.d_values = values;
+    entry.d_timeNs = timeNs;
+}
+
+// -----------------------------------------------------------------------------
+
+void TuningDatabase :: remove (
+    const PhysicalDevice& hDevice,
+    const std::string& kernelKey )
+{
+    get()->d_entries.erase ( makeEntryKey ( hDevice, kernelKey ) );
+}
+
+// -----------------------------------------------------------------------------
+
+std::string TuningDatabase :: deviceKey ( const PhysicalDevice& hDevice )
+{
+    // The pipeline cache UUID changes with both the device and the driver
+    // version, which is exactly when the stored timings become stale.
+
+    const std::uint8_t* pUUID = hDevice.properties().pipelineCacheUUID;
+
+    std::ostringstream result;
+    result << std::hex << std::setfill ( '0' );
+
+    for ( size_t i = 0; i != VK_UUID_SIZE; ++i )
+        result << std::setw ( 2 ) << static_cast< unsigned int >( pUUID [ i ] );
+
+    return result.str();
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
@@ -0,0 +1,230 @@
+/*
+    Copyright 2016-2019 SOFT-ERG, Przemek Kuczmierczyk (www.softerg.com)
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+    THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+    EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ph.hpp"
+#include "../include/vppWorkgroupTuner.hpp"
+#include "../include/vppCommandPool.hpp"
+#include "../include/vppQueue.hpp"
+#include "../include/vppSynchronization.hpp"
+#include <limits>
+
+// -----------------------------------------------------------------------------
+namespace vpp {
+// -----------------------------------------------------------------------------
+
+WorkgroupTuner :: WorkgroupTuner (
+    const Device& hDevice,
+    const TuningDatabase& hDatabase ) :
+        d_hDevice ( hDevice ),
+        d_hDatabase ( hDatabase ),
+        d_warmupCount ( 2 ),
+        d_measuredCount ( 8 )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void WorkgroupTuner :: addCandidate ( const SpecializationValues& values )
+{
+    d_candidates.push_back ( values );
+}
+
+// -----------------------------------------------------------------------------
+
+void WorkgroupTuner :: addLocalSizes (
+    const specConst< int >& sizeX,
+    const specConst< int >& sizeY,
+    const specConst< int >& sizeZ,
+    std::uint32_t dimensions,
+    std::uint32_t minInvocations,
+    std::uint32_t maxInvocations )
+{
+    const VkPhysicalDeviceLimits& limits = d_hDevice.physical().properties().limits;
+
+    const std::uint32_t maxInv =
+        std::min ( maxInvocations, limits.maxComputeWorkGroupInvocations );
+
+    const std::uint32_t maxX = limits.maxComputeWorkGroupSize [ 0 ];
+    const std::uint32_t maxY = dimensions > 1 ? limits.maxComputeWorkGroupSize [ 1 ] : 1u;
+    const std::uint32_t maxZ = dimensions > 2 ? limits.maxComputeWorkGroupSize [ 2 ] : 1u;
+
+    Candidates variants;
+
+    // Powers of two only; other sizes rarely map well onto subgroups.
+    for ( std::uint32_t z = 1; z <= maxZ; z *= 2 )
+        for ( std::uint32_t y = 1; y <= maxY; y *= 2 )
+            for ( std::uint32_t x = 1; x <= maxX; x *= 2 )
+            {
+                const std::uint32_t invocations = x * y * z;
+
+                if ( invocations > maxInv )
+                    break;
+
+                if ( invocations < minInvocations )
+                    continue;
+
+                variants.push_back ( SpecializationValues() );
+                variants.back().set ( sizeX, static_cast< int >( x ) );
+                variants.back().set ( sizeY, static_cast< int >( y ) );
+                variants.back().set ( sizeZ, static_cast< int >( z ) );
+            }
+
+    expand ( variants );
+}
+
+// -----------------------------------------------------------------------------
+
+void WorkgroupTuner :: expand ( const Candidates& variants )
+{
+    if ( variants.empty() )
+        return;
+
+    if ( d_candidates.empty() )
+    {
+        d_candidates = variants;
+        return;
+    }
+
+    // Cartesian product with the search space built so far.
+
+    Candidates result;
+    result.reserve ( d_candidates.size() * variants.size() );
+
+    for ( const auto& iCandidate : d_candidates )
+        for ( const auto& iVariant : variants )
+        {
+            result.push_back ( iCandidate );
+            result.back().merge ( iVariant );
+        }
+
+    d_candidates.swap ( result );
+}
+
+// -----------------------------------------------------------------------------
+
+SpecializationValues WorkgroupTuner :: measure (
+    const std::string& kernelKey,
+    const ComputePass& hPass,
+    const FDispatch& dispatch )
+{
+    const std::uint32_t nCandidates = static_cast< std::uint32_t >( d_candidates.size() );
+
+    CommandPool hCmdPool ( d_hDevice, Q_GRAPHICS );
+    CommandBuffer hCmdBuffer = hCmdPool.createBuffer();
+    TimerArray timers ( nCandidates, d_hDevice );
+
+    // Repetitions are serialized, so that the measured time is the latency
+    // of a dispatch and not the throughput of overlapping ones.
+
+    VkMemoryBarrier memoryBarrier;
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.pNext = 0;
+    memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    const Barriers barriers ( memoryBarrier );
+
+    hCmdBuffer.begin ( CommandBuffer::ONE_TIME_SUBMIT );
+    timers.cmdResetAll ( hCmdBuffer );
+
+    for ( std::uint32_t iCandidate = 0; iCandidate != nCandidates; ++iCandidate )
+    {
+        const ComputePipeline& hPipeline = hPass.pipeline ( iCandidate );
+
+        // Variants the driver refused still get their timestamps written,
+        // otherwise retrieve() would wait for them forever.
+        if ( hPipeline )
+        {
+            hPipeline.cmdBind ( hCmdBuffer );
+
+            for ( std::uint32_t i = 0; i != d_warmupCount; ++i )
+            {
+                dispatch ( d_candidates [ iCandidate ], hCmdBuffer );
+
+                UniversalCommands::cmdPipelineBarrier (
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    0, barriers, hCmdBuffer );
+            }
+        }
+
+        timers.cmdMeasureBegin ( iCandidate, hCmdBuffer );
+
+        if ( hPipeline )
+            for ( std::uint32_t i = 0; i != d_measuredCount; ++i )
+            {
+                dispatch ( d_candidates [ iCandidate ], hCmdBuffer );
+
+                UniversalCommands::cmdPipelineBarrier (
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    0, barriers, hCmdBuffer );
+            }
+
+        timers.cmdMeasureEnd ( iCandidate, hCmdBuffer );
+    }
+
+    hCmdBuffer.end();
+
+    const Queue hQueue ( d_hDevice );
+    const Fence hFence ( d_hDevice );
+    hQueue.submit ( hCmdBuffer, Semaphore(), Semaphore(), hFence );
+    hFence.wait();
+
+    timers.retrieve();
+
+    d_timings.assign ( nCandidates, -1.0 );
+
+    std::uint32_t iBest = nCandidates;
+    double bestTime = std::numeric_limits< double >::max();
+
+    for ( std::uint32_t iCandidate = 0; iCandidate != nCandidates; ++iCandidate )
+    {
+        if ( ! hPass.pipeline ( iCandidate ) )
+            continue;
+
+        const double time = timers.interval_ns ( iCandidate ) / d_measuredCount;
+        d_timings [ iCandidate ] = time;
+
+        if ( time < bestTime )
+        {
+            bestTime = time;
+            iBest = iCandidate;
+        }
+    }
+
+    if ( iBest == nCandidates )
+        throw XRuntimeError ( "WorkgroupTuner: no candidate pipeline could be created." );
+
+    d_hDatabase.store ( d_hDevice.physical(), kernelKey, d_candidates [ iBest ], bestTime );
+    d_hDatabase.save();
+
+    return d_candidates [ iBest ];
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpp
+// -----------------------------------------------------------------------------
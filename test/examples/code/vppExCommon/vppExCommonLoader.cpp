@@ -11,8 +11,430 @@
 #include "glm/gtc/matrix_transform.hpp"
 #include "gli/gli.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sys/stat.h>
+
 // -----------------------------------------------------------------------------
 namespace vppex {
+// -----------------------------------------------------------------------------
+// Mesh optimization. Triangles are first reordered for the post-transform
+// vertex cache (Tipsify, Sander et al. 2007), then clusters of triangles are
+// sorted front-to-back in a view independent way to reduce overdraw, and
+// finally vertices are renumbered in order of first use for better vertex
+// fetch locality.
+// -----------------------------------------------------------------------------
+
+static const std::uint32_t CACHE_SIZE = 16;
+static const float OVERDRAW_THRESHOLD = 1.05f;
+static const std::uint32_t NO_VERTEX = ~0u;
+
+// -----------------------------------------------------------------------------
+
+static std::uint32_t getNextVertex (
+    const std::vector< std::uint32_t >& candidates,
+    const std::vector< std::uint32_t >& liveCount,
+    const std::vector< std::uint32_t >& cacheTime,
+    std::uint32_t timeStamp,
+    std::vector< std::uint32_t >* pDeadEnd,
+    std::uint32_t* pCursor,
+    bool* pbRestarted )
+{
+    std::uint32_t bestVertex = NO_VERTEX;
+    int bestPriority = -1;
+
+    for ( std::uint32_t v : candidates )
+    {
+        if ( liveCount [ v ] > 0 )
+        {
+            int priority = 0;
+
+            // Prefer vertices which will still be in cache after emitting
+            // all their remaining triangles.
+            if ( timeStamp - cacheTime [ v ] + 2 * liveCount [ v ] <= CACHE_SIZE )
+                priority = static_cast< int >( timeStamp - cacheTime [ v ] );
+
+            if ( priority > bestPriority )
+            {
+                bestPriority = priority;
+                bestVertex = v;
+            }
+        }
+    }
+
+    if ( bestVertex != NO_VERTEX )
+        return bestVertex;
+
+    *pbRestarted = true;
+
+    while ( ! pDeadEnd->empty() )
+    {
+        const std::uint32_t v = pDeadEnd->back();
+        pDeadEnd->pop_back();
+
+        if ( liveCount [ v ] > 0 )
+            return v;
+    }
+
+    const std::uint32_t nVertices = static_cast< std::uint32_t >( liveCount.size() );
+
+    while ( *pCursor < nVertices )
+    {
+        const std::uint32_t v = ( *pCursor )++;
+
+        if ( liveCount [ v ] > 0 )
+            return v;
+    }
+
+    return NO_VERTEX;
+}
+
+// -----------------------------------------------------------------------------
+
+static void optimizeVertexCache (
+    MeshLoader::Indices* pIndices,
+    std::uint32_t nVertices,
+    std::vector< std::uint32_t >* pHardBoundaries,
+    std::vector< std::uint32_t >* pSoftBoundaries )
+{
+    const MeshLoader::Indices& indices = *pIndices;
+    const std::uint32_t nTriangles = static_cast< std::uint32_t >( indices.size() / 3 );
+
+    std::vector< std::uint32_t > liveCount ( nVertices, 0 );
+    std::vector< std::uint32_t > adjacencyOffsets ( nVertices + 1, 0 );
+    std::vector< std::uint32_t > adjacency ( indices.size() );
+
+    for ( std::uint32_t v : indices )
+        ++liveCount [ v ];
+
+    for ( std::uint32_t v = 0; v != nVertices; ++v )
+        adjacencyOffsets [ v + 1 ] = adjacencyOffsets [ v ] + liveCount [ v ];
+
+    std::vector< std::uint32_t > fillPos ( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+
+    for ( std::uint32_t i = 0; i != indices.size(); ++i )
+        adjacency [ fillPos [ indices [ i ] ]++ ] = i / 3;
+
+    std::vector< std::uint32_t > cacheTime ( nVertices, 0 );
+    std::vector< bool > emitted ( nTriangles, false );
+    std::vector< std::uint32_t > deadEnd;
+    std::vector< std::uint32_t > candidates;
+
+    MeshLoader::Indices result;
+    result.reserve ( indices.size() );
+
+    std::uint32_t timeStamp = CACHE_SIZE + 1;
+    std::uint32_t cursor = 0;
+    bool bRestarted = true;
+
+    std::uint32_t fanning = getNextVertex (
+        candidates, liveCount, cacheTime, timeStamp, & deadEnd, & cursor, & bRestarted );
+
+    while ( fanning != NO_VERTEX )
+    {
+        const std::uint32_t startTriangle = static_cast< std::uint32_t >( result.size() / 3 );
+
+        if ( bRestarted )
+            pHardBoundaries->push_back ( startTriangle );
+        else
+            pSoftBoundaries->push_back ( startTriangle );
+
+        bRestarted = false;
+        candidates.clear();
+
+        for ( std::uint32_t a = adjacencyOffsets [ fanning ]; a != adjacencyOffsets [ fanning + 1 ]; ++a )
+        {
+            const std::uint32_t t = adjacency [ a ];
+
+            if ( emitted [ t ] )
+                continue;
+
+            for ( std::uint32_t k = 0; k != 3; ++k )
+            {
+                const std::uint32_t v = indices [ 3 * t + k ];
+
+                result.push_back ( v );
+                deadEnd.push_back ( v );
+                candidates.push_back ( v );
+                --liveCount [ v ];
+
+                if ( timeStamp - cacheTime [ v ] > CACHE_SIZE )
+                    cacheTime [ v ] = timeStamp++;
+            }
+
+            emitted [ t ] = true;
+        }
+
+        fanning = getNextVertex (
+            candidates, liveCount, cacheTime, timeStamp, & deadEnd, & cursor, & bRestarted );
+    }
+
+    pIndices->swap ( result );
+}
+
+// -----------------------------------------------------------------------------
+
+static std::uint32_t countCacheMisses (
+    const MeshLoader::Indices& indices,
+    std::uint32_t firstTriangle,
+    std::uint32_t endTriangle,
+    std::vector< std::uint32_t >* pCacheTime,
+    std::uint32_t* pTimeStamp )
+{
+    std::uint32_t nMisses = 0;
+
+    for ( std::uint32_t i = 3 * firstTriangle; i != 3 * endTriangle; ++i )
+    {
+        std::uint32_t& vertexTime = ( *pCacheTime ) [ indices [ i ] ];
+
+        if ( *pTimeStamp - vertexTime > CACHE_SIZE )
+        {
+            vertexTime = ( *pTimeStamp )++;
+            ++nMisses;
+        }
+    }
+
+    return nMisses;
+}
+
+// -----------------------------------------------------------------------------
+
+static void optimizeOverdraw (
+    MeshLoader::Indices* pIndices,
+    const MeshLoader::Vertices& vertices,
+    const std::vector< std::uint32_t >& hardBoundaries,
+    const std::vector< std::uint32_t >& softBoundaries )
+{
+    MeshLoader::Indices& indices = *pIndices;
+    const std::uint32_t nTriangles = static_cast< std::uint32_t >( indices.size() / 3 );
+
+    // Split hard clusters further at fan boundaries, where the cluster
+    // is already not much worse than average regarding cache misses.
+
+    std::vector< std::uint32_t > cacheTime ( vertices.size(), 0 );
+    std::uint32_t timeStamp = CACHE_SIZE + 1;
+
+    const float meshACMR = static_cast< float >(
+        countCacheMisses ( indices, 0, nTriangles, & cacheTime, & timeStamp ) ) / nTriangles;
+
+    std::vector< std::uint32_t > boundaries;
+    auto iSoft = softBoundaries.begin();
+
+    for ( size_t h = 0; h != hardBoundaries.size(); ++h )
+    {
+        const std::uint32_t clusterEnd =
+            h + 1 < hardBoundaries.size() ? hardBoundaries [ h + 1 ] : nTriangles;
+
+        std::uint32_t subclusterBegin = hardBoundaries [ h ];
+        std::uint32_t nMisses = 0;
+
+        boundaries.push_back ( subclusterBegin );
+
+        std::fill ( cacheTime.begin(), cacheTime.end(), 0 );
+        timeStamp = CACHE_SIZE + 1;
+
+        while ( iSoft != softBoundaries.end() && *iSoft <= subclusterBegin )
+            ++iSoft;
+
+        std::uint32_t prevBoundary = subclusterBegin;
+
+        for ( ; iSoft != softBoundaries.end() && *iSoft < clusterEnd; ++iSoft )
+        {
+            nMisses += countCacheMisses ( indices, prevBoundary, *iSoft, & cacheTime, & timeStamp );
+            prevBoundary = *iSoft;
+
+            const float clusterACMR =
+                static_cast< float >( nMisses ) / ( *iSoft - subclusterBegin );
+
+            if ( clusterACMR < OVERDRAW_THRESHOLD * meshACMR )
+            {
+                boundaries.push_back ( *iSoft );
+                subclusterBegin = *iSoft;
+                nMisses = 0;
+                std::fill ( cacheTime.begin(), cacheTime.end(), 0 );
+                timeStamp = CACHE_SIZE + 1;
+            }
+        }
+    }
+
+    // Sort clusters by the dot product of the cluster normal and the vector
+    // from the mesh center to the cluster center. Outward facing clusters
+    // are drawn first, as they tend to occlude the others.
+
+    glm::vec3 meshCenter ( 0.0f );
+
+    for ( const auto& iVertex : vertices )
+        meshCenter += iVertex.m_pos;
+
+    meshCenter /= static_cast< float >( vertices.size() );
+
+    struct SCluster
+    {
+        std::uint32_t d_begin;
+        std::uint32_t d_end;
+        float d_sortKey;
+    };
+
+    std::vector< SCluster > clusters ( boundaries.size() );
+
+    for ( size_t c = 0; c != boundaries.size(); ++c )
+    {
+        SCluster& cluster = clusters [ c ];
+        cluster.d_begin = boundaries [ c ];
+        cluster.d_end = c + 1 < boundaries.size() ? boundaries [ c + 1 ] : nTriangles;
+
+        glm::vec3 center ( 0.0f );
+        glm::vec3 normal ( 0.0f );
+        float area = 0.0f;
+
+        for ( std::uint32_t t = cluster.d_begin; t != cluster.d_end; ++t )
+        {
+            const glm::vec3& p0 = vertices [ indices [ 3 * t ] ].m_pos;
+            const glm::vec3& p1 = vertices [ indices [ 3 * t + 1 ] ].m_pos;
+            const glm::vec3& p2 = vertices [ indices [ 3 * t + 2 ] ].m_pos;
+
+            const glm::vec3 triangleNormal = glm::cross ( p1 - p0, p2 - p0 );
+            const float triangleArea = glm::length ( triangleNormal );
+
+            center += ( p0 + p1 + p2 ) * ( triangleArea / 3.0f );
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        if ( area > 0.0f )
+            center /= area;
+
+        const float normalLength = glm::length ( normal );
+
+        cluster.d_sortKey = normalLength > 0.0f ?
+            glm::dot ( center - meshCenter, normal / normalLength ) : 0.0f;
+    }
+
+    std::stable_sort ( clusters.begin(), clusters.end(),
+        []( const SCluster& lhs, const SCluster& rhs )
+        {
+            return lhs.d_sortKey > rhs.d_sortKey;
+        } );
+
+    MeshLoader::Indices result;
+    result.reserve ( indices.size() );
+
+    for ( const auto& iCluster : clusters )
+        result.insert (
+            result.end(),
+            indices.begin() + 3 * iCluster.d_begin,
+            indices.begin() + 3 * iCluster.d_end );
+
+    indices.swap ( result );
+}
+
+// -----------------------------------------------------------------------------
+
+static void optimizeVertexFetch ( MeshLoader::Mesh* pMesh )
+{
+    std::vector< std::uint32_t > remap ( pMesh->m_vertices.size(), NO_VERTEX );
+    MeshLoader::Vertices result;
+    result.reserve ( pMesh->m_vertices.size() );
+
+    for ( auto& iIndex : pMesh->m_indices )
+    {
+        if ( remap [ iIndex ] == NO_VERTEX )
+        {
+            remap [ iIndex ] = static_cast< std::uint32_t >( result.size() );
+            result.push_back ( pMesh->m_vertices [ iIndex ] );
+        }
+
+        iIndex = remap [ iIndex ];
+    }
+
+    // Vertices not referenced by any triangle are dropped.
+    pMesh->m_vertices.swap ( result );
+}
+
+// -----------------------------------------------------------------------------
+
+static void optimizeMesh ( MeshLoader::Mesh* pMesh )
+{
+    if ( pMesh->m_indices.size() >= 3 && ! pMesh->m_vertices.empty() )
+    {
+        std::vector< std::uint32_t > hardBoundaries;
+        std::vector< std::uint32_t > softBoundaries;
+
+        optimizeVertexCache (
+            & pMesh->m_indices,
+            static_cast< std::uint32_t >( pMesh->m_vertices.size() ),
+            & hardBoundaries, & softBoundaries );
+
+        optimizeOverdraw (
+            & pMesh->m_indices, pMesh->m_vertices, hardBoundaries, softBoundaries );
+
+        optimizeVertexFetch ( pMesh );
+    }
+
+    pMesh->m_numIndices = static_cast< std::uint32_t >( pMesh->m_indices.size() );
+}
+
+// -----------------------------------------------------------------------------
+// Binary mesh cache. The file contains a header, a table of meshes and then
+// raw vertex and index arrays, aligned to 16 bytes, in the in-memory layout
+// of MeshLoader::Vertex. Meshes with at most 65536 vertices store 16-bit
+// indices. Loading is a copy from the mapped file, after validating all
+// ranges and indices, so that a damaged cache falls back to the importer.
+// -----------------------------------------------------------------------------
+
+static const char s_meshCacheMagic [ 8 ] = { 'V', 'P', 'P', 'M', 'E', 'S', 'H', 0 };
+static const std::uint32_t MESH_CACHE_VERSION = 1;
+static const std::uint64_t MESH_CACHE_ALIGNMENT = 16;
+
+struct SMeshCacheHeader
+{
+    char d_magic [ 8 ];
+    std::uint32_t d_version;
+    std::uint32_t d_vertexSize;
+    std::uint32_t d_meshCount;
+    std::int32_t d_importFlags;
+    std::uint64_t d_sourceSize;
+    std::int64_t d_sourceTime;
+};
+
+struct SMeshCacheEntry
+{
+    std::uint32_t d_materialIndex;
+    std::uint32_t d_vertexCount;
+    std::uint32_t d_indexCount;
+    std::uint32_t d_indexSize;
+    std::uint64_t d_vertexOffset;
+    std::uint64_t d_indexOffset;
+};
+
+// -----------------------------------------------------------------------------
+
+static std::uint64_t alignCacheOffset ( std::uint64_t offset )
+{
+    return ( offset + MESH_CACHE_ALIGNMENT - 1 ) / MESH_CACHE_ALIGNMENT * MESH_CACHE_ALIGNMENT;
+}
+
+// -----------------------------------------------------------------------------
+
+static void getSourceInfo (
+    const std::string& filename, std::uint64_t* pSize, std::int64_t* pTime )
+{
+    struct stat fileStat;
+
+    if ( stat ( filename.c_str(), & fileStat ) == 0 )
+    {
+        *pSize = static_cast< std::uint64_t >( fileStat.st_size );
+        *pTime = static_cast< std::int64_t >( fileStat.st_mtime );
+    }
+    else
+    {
+        *pSize = 0;
+        *pTime = 0;
+    }
+}
+
 // -----------------------------------------------------------------------------
 
 struct MeshLoader::Impl
@@ -23,6 +445,15 @@ struct MeshLoader::Impl
     // internal routines
     bool initFromScene ( const aiScene* pScene, const std::string& filename );
     void initMesh ( unsigned int index, const aiMesh* paiMesh, const aiScene* pScene );
+    void optimizeMeshes();
+
+    bool loadFromCache (
+        const std::string& cacheName, int flags,
+        std::uint64_t sourceSize, std::int64_t sourceTime );
+
+    void saveToCache (
+        const std::string& cacheName, int flags,
+        std::uint64_t sourceSize, std::int64_t sourceTime ) const;
 
     // data
 
@@ -39,18 +470,37 @@ struct MeshLoader::Impl
 	uint32_t m_numVertices = 0;
 
 	Assimp::Importer m_importer;
-	const aiScene* m_pScene;
+	const aiScene* m_pScene = nullptr;
+
+    bool m_bCacheEnabled = true;
 };
 
 // -----------------------------------------------------------------------------
 
 bool MeshLoader::Impl :: loadMesh ( const std::string& filename, int flags )
 {
+    const std::string cacheName = filename + ".vppmesh";
+    std::uint64_t sourceSize;
+    std::int64_t sourceTime;
+
+    getSourceInfo ( filename, & sourceSize, & sourceTime );
+
+    if ( m_bCacheEnabled && loadFromCache ( cacheName, flags, sourceSize, sourceTime ) )
+        return true;
+
 	m_pScene = m_importer.ReadFile ( filename.c_str(), flags );
 
 	if ( m_pScene )
 	{
-		return initFromScene ( m_pScene, filename );
+		if ( ! initFromScene ( m_pScene, filename ) )
+            return false;
+
+        optimizeMeshes();
+
+        if ( m_bCacheEnabled )
+            saveToCache ( cacheName, flags, sourceSize, sourceTime );
+
+        return true;
 	}
 	else 
 	{
@@ -59,6 +509,198 @@ bool MeshLoader::Impl :: loadMesh ( const std::string& filename, int flags )
 	}
 }
 
+// -----------------------------------------------------------------------------
+
+void MeshLoader::Impl :: optimizeMeshes()
+{
+    m_numVertices = 0;
+
+    for ( auto& iMesh : m_meshes )
+    {
+        optimizeMesh ( & iMesh );
+        iMesh.m_vertexBase = m_numVertices;
+        m_numVertices += static_cast< std::uint32_t >( iMesh.m_vertices.size() );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool MeshLoader::Impl :: loadFromCache (
+    const std::string& cacheName, int flags,
+    std::uint64_t sourceSize, std::int64_t sourceTime )
+{
+    vpp::MappedFile cacheFile;
+
+    if ( ! cacheFile.open ( cacheName ) || cacheFile.size() < sizeof ( SMeshCacheHeader ) )
+        return false;
+
+    const unsigned char* pData = cacheFile.begin();
+
+    SMeshCacheHeader header;
+    memcpy ( & header, pData, sizeof ( header ) );
+
+    // A missing source file is fine, the cache may be shipped alone.
+    const bool bValid =
+        memcmp ( header.d_magic, s_meshCacheMagic, sizeof ( s_meshCacheMagic ) ) == 0
+        && header.d_version == MESH_CACHE_VERSION
+        && header.d_vertexSize == sizeof ( Vertex )
+        && header.d_importFlags == flags
+        && ( sourceSize == 0
+             || ( header.d_sourceSize == sourceSize && header.d_sourceTime == sourceTime ) );
+
+    const std::uint64_t tableEnd =
+        sizeof ( SMeshCacheHeader ) + std::uint64_t ( header.d_meshCount ) * sizeof ( SMeshCacheEntry );
+
+    if ( ! bValid || tableEnd > cacheFile.size() )
+        return false;
+
+    std::vector< Mesh > meshes ( header.d_meshCount );
+    std::uint64_t nVertices = 0;
+    const std::uint64_t fileSize = cacheFile.size();
+
+    for ( std::uint32_t i = 0; i != header.d_meshCount; ++i )
+    {
+        SMeshCacheEntry entry;
+        memcpy ( & entry, pData + sizeof ( SMeshCacheHeader ) + i * sizeof ( SMeshCacheEntry ), sizeof ( entry ) );
+
+        const std::uint64_t vertexBytes = std::uint64_t ( entry.d_vertexCount ) * sizeof ( Vertex );
+        const std::uint64_t indexBytes = std::uint64_t ( entry.d_indexCount ) * entry.d_indexSize;
+
+        // Written so that corrupted offsets can not wrap around.
+        if ( ( entry.d_indexSize != 2 && entry.d_indexSize != 4 )
+             || vertexBytes > fileSize || entry.d_vertexOffset > fileSize - vertexBytes
+             || indexBytes > fileSize || entry.d_indexOffset > fileSize - indexBytes )
+        {
+            return false;
+        }
+
+        Mesh& mesh = meshes [ i ];
+        mesh.m_materialIndex = entry.d_materialIndex;
+        mesh.m_vertexBase = static_cast< std::uint32_t >( nVertices );
+        mesh.m_numIndices = entry.d_indexCount;
+
+        mesh.m_vertices.resize ( entry.d_vertexCount );
+        memcpy ( mesh.m_vertices.data(), pData + entry.d_vertexOffset, static_cast< size_t >( vertexBytes ) );
+
+        mesh.m_indices.resize ( entry.d_indexCount );
+        const unsigned char* pIndices = pData + entry.d_indexOffset;
+
+        for ( std::uint32_t iIndex = 0; iIndex != entry.d_indexCount; ++iIndex )
+        {
+            std::uint32_t index;
+
+            if ( entry.d_indexSize == 2 )
+            {
+                std::uint16_t shortIndex;
+                memcpy ( & shortIndex, pIndices + 2 * iIndex, 2 );
+                index = shortIndex;
+            }
+            else
+                memcpy ( & index, pIndices + 4 * iIndex, 4 );
+
+            if ( index >= entry.d_vertexCount )
+                return false;
+
+            mesh.m_indices [ iIndex ] = index;
+        }
+
+        nVertices += entry.d_vertexCount;
+
+        if ( nVertices > std::numeric_limits< std::uint32_t >::max() )
+            return false;
+    }
+
+    m_meshes.swap ( meshes );
+    m_numVertices = static_cast< std::uint32_t >( nVertices );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void MeshLoader::Impl :: saveToCache (
+    const std::string& cacheName, int flags,
+    std::uint64_t sourceSize, std::int64_t sourceTime ) const
+{
+    SMeshCacheHeader header = {};
+    memcpy ( header.d_magic, s_meshCacheMagic, sizeof ( s_meshCacheMagic ) );
+    header.d_version = MESH_CACHE_VERSION;
+    header.d_vertexSize = sizeof ( Vertex );
+    header.d_meshCount = static_cast< std::uint32_t >( m_meshes.size() );
+    header.d_importFlags = flags;
+    header.d_sourceSize = sourceSize;
+    header.d_sourceTime = sourceTime;
+
+    std::vector< SMeshCacheEntry > entries ( m_meshes.size() );
+    std::uint64_t offset = alignCacheOffset (
+        sizeof ( SMeshCacheHeader ) + entries.size() * sizeof ( SMeshCacheEntry ) );
+
+    for ( size_t i = 0; i != m_meshes.size(); ++i )
+    {
+        const Mesh& mesh = m_meshes [ i ];
+        SMeshCacheEntry& entry = entries [ i ];
+
+        entry.d_materialIndex = mesh.m_materialIndex;
+        entry.d_vertexCount = static_cast< std::uint32_t >( mesh.m_vertices.size() );
+        entry.d_indexCount = static_cast< std::uint32_t >( mesh.m_indices.size() );
+        entry.d_indexSize = mesh.m_vertices.size() <= 0x10000 ? 2 : 4;
+        entry.d_vertexOffset = offset;
+        offset = alignCacheOffset ( offset + entry.d_vertexCount * sizeof ( Vertex ) );
+        entry.d_indexOffset = offset;
+        offset = alignCacheOffset ( offset + entry.d_indexCount * entry.d_indexSize );
+    }
+
+    std::ofstream cacheFile ( cacheName.c_str(), std::ios::binary | std::ios::trunc );
+
+    // Failing to write the cache (e.g. read-only assets) is not an error.
+    if ( ! cacheFile )
+        return;
+
+    const auto padTo = [ &cacheFile ]( std::uint64_t position )
+    {
+        static const char s_zeros [ MESH_CACHE_ALIGNMENT ] = {};
+        const std::uint64_t current = static_cast< std::uint64_t >( cacheFile.tellp() );
+        cacheFile.write ( s_zeros, static_cast< std::streamsize >( position - current ) );
+    };
+
+    cacheFile.write ( reinterpret_cast< const char* >( & header ), sizeof ( header ) );
+    cacheFile.write (
+        reinterpret_cast< const char* >( entries.data() ),
+        static_cast< std::streamsize >( entries.size() * sizeof ( SMeshCacheEntry ) ) );
+
+    for ( size_t i = 0; i != m_meshes.size(); ++i )
+    {
+        const Mesh& mesh = m_meshes [ i ];
+        const SMeshCacheEntry& entry = entries [ i ];
+
+        padTo ( entry.d_vertexOffset );
+        cacheFile.write (
+            reinterpret_cast< const char* >( mesh.m_vertices.data() ),
+            static_cast< std::streamsize >( entry.d_vertexCount * sizeof ( Vertex ) ) );
+
+        padTo ( entry.d_indexOffset );
+
+        if ( entry.d_indexSize == 2 )
+        {
+            const std::vector< std::uint16_t > shortIndices (
+                mesh.m_indices.begin(), mesh.m_indices.end() );
+
+            cacheFile.write (
+                reinterpret_cast< const char* >( shortIndices.data() ),
+                static_cast< std::streamsize >( entry.d_indexCount * 2 ) );
+        }
+        else
+            cacheFile.write (
+                reinterpret_cast< const char* >( mesh.m_indices.data() ),
+                static_cast< std::streamsize >( entry.d_indexCount * 4 ) );
+    }
+
+    if ( ! cacheFile )
+    {
+        cacheFile.close();
+        std::remove ( cacheName.c_str() );
+    }
+}
+
 // -----------------------------------------------------------------------------
 
 bool MeshLoader::Impl :: initFromScene (
@@ -167,6 +809,13 @@ bool MeshLoader :: loadMesh ( const std::string& filename )
 bool MeshLoader :: loadMesh ( const std::string& filename, int flags )
 {
 	return impl->loadMesh ( filename, flags );
+}
+
+// -----------------------------------------------------------------------------
+
+void MeshLoader :: enableCache ( bool bEnable )
+{
+    impl->m_bCacheEnabled = bEnable;
 }
 
 // -----------------------------------------------------------------------------
@@ -54,6 +54,11 @@ public:
     bool loadMesh ( const std::string& filename );
     bool loadMesh ( const std::string& filename, int flags );
 
+    // Loaded meshes are optimized for vertex cache, overdraw and vertex fetch,
+    // then stored next to the source file as filename.vppmesh. Subsequent
+    // loads read that file directly, skipping the importer. Enabled by default.
+    void enableCache ( bool bEnable );
+
     const Meshes& meshes() const;
 
 private:
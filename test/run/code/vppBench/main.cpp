@@ -0,0 +1,1261 @@
+// -----------------------------------------------------------------------------
+
+#pragma warning (disable: 4503)
+#include <vppAll.hpp>
+
+// -----------------------------------------------------------------------------
+// The benchmark measures the same shaders as the computation test. They come
+// from the vppTestComputationPipelines library shared by both programs.
+// -----------------------------------------------------------------------------
+
+#include "vppTestComputationPipelines.hpp"
+
+// -----------------------------------------------------------------------------
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <limits>
+
+// -----------------------------------------------------------------------------
+namespace vppbench {
+// -----------------------------------------------------------------------------
+
+struct SBenchOptions
+{
+    SBenchOptions();
+
+    unsigned int d_iterations;
+    std::string d_filter;
+    std::string d_outputFile;
+    bool d_bValidation;
+};
+
+// -----------------------------------------------------------------------------
+
+SBenchOptions :: SBenchOptions() :
+    d_iterations ( 20 ),
+    d_bValidation ( false )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+struct SBenchResult
+{
+    std::string d_group;
+    std::string d_name;
+    unsigned int d_iterations;
+    double d_minUs;
+    double d_meanUs;
+    double d_medianUs;
+    double d_maxUs;
+    double d_throughput;
+    std::string d_throughputUnit;
+};
+
+// -----------------------------------------------------------------------------
+
+class KBenchmarkSuite
+{
+public:
+    KBenchmarkSuite ( const vpp::Device& hDevice, const SBenchOptions& options );
+
+    const vpp::Device& device() const { return d_hDevice; }
+    unsigned int iterations() const { return d_options.d_iterations; }
+
+    bool isEnabled ( const std::string& group, const std::string& name ) const;
+
+    // Runs the function once for warmup and then the specified number of times,
+    // measuring each call separately. The work amount is used to compute
+    // throughput (work units per second). Zero means no throughput report.
+
+    template< typename FunctionT >
+    void measure (
+        const std::string& group,
+        const std::string& name,
+        unsigned int iterations,
+        FunctionT&& fun,
+        double workPerIteration = 0.0,
+        const char* pWorkUnit = "" );
+
+    void writeJson ( std::ostream& sst ) const;
+
+    // Results of benchmarked kernels which are checked against a reference.
+    void reportMismatch ( const std::string& group, const std::string& name, size_t count );
+    bool hasMismatches() const { return d_bMismatches; }
+
+private:
+    static void writeJsonString ( std::ostream& sst, const std::string& value );
+
+private:
+    vpp::Device d_hDevice;
+    SBenchOptions d_options;
+    std::vector< SBenchResult > d_results;
+    bool d_bMismatches;
+};
+
+// -----------------------------------------------------------------------------
+
+KBenchmarkSuite :: KBenchmarkSuite (
+    const vpp::Device& hDevice, const SBenchOptions& options ) :
+        d_hDevice ( hDevice ),
+        d_options ( options ),
+        d_bMismatches ( false )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+bool KBenchmarkSuite :: isEnabled ( const std::string& group, const std::string& name ) const
+{
+    if ( d_options.d_filter.empty() )
+        return true;
+
+    const std::string fullName = group + '/' + name;
+    return fullName.find ( d_options.d_filter ) != std::string::npos;
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename FunctionT >
+void KBenchmarkSuite :: measure (
+    const std::string& group,
+    const std::string& name,
+    unsigned int iterations,
+    FunctionT&& fun,
+    double workPerIteration,
+    const char* pWorkUnit )
+{
+    typedef std::chrono::steady_clock clock_type;
+
+    if ( ! isEnabled ( group, name ) || iterations == 0 )
+        return;
+
+    fun();
+
+    std::vector< double > times;
+    times.reserve ( iterations );
+
+    for ( unsigned int i = 0; i != iterations; ++i )
+    {
+        const clock_type::time_point begin = clock_type::now();
+        fun();
+        const clock_type::time_point end = clock_type::now();
+
+        times.push_back (
+            std::chrono::duration< double, std::micro >( end - begin ).count() );
+    }
+
+    std::sort ( times.begin(), times.end() );
+
+    SBenchResult result;
+    result.d_group = group;
+    result.d_name = name;
+    result.d_iterations = iterations;
+    result.d_minUs = times.front();
+    result.d_maxUs = times.back();
+    result.d_medianUs = times [ times.size() / 2 ];
+    result.d_meanUs = std::accumulate ( times.begin(), times.end(), 0.0 ) / times.size();
+    result.d_throughput = 0.0;
+
+    if ( workPerIteration > 0.0 && result.d_medianUs > 0.0 )
+    {
+        result.d_throughput = workPerIteration * 1000000.0 / result.d_medianUs;
+        result.d_throughputUnit = pWorkUnit;
+    }
+
+    std::cerr << group << '/' << name << ": " << result.d_medianUs << " us" << std::endl;
+
+    d_results.push_back ( result );
+}
+
+// -----------------------------------------------------------------------------
+
+void KBenchmarkSuite :: reportMismatch (
+    const std::string& group, const std::string& name, size_t count )
+{
+    std::cerr << group << '/' << name << ": " << count
+              << " items differ from the reference" << std::endl;
+
+    d_bMismatches = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void KBenchmarkSuite :: writeJsonString ( std::ostream& sst, const std::string& value )
+{
+    sst << '"';
+
+    for ( char c : value )
+    {
+        if ( c == '"' || c == '\\' )
+            sst << '\\' << c;
+        else if ( static_cast< unsigned char >( c ) < 0x20u )
+            sst << "\\u" << std::hex << std::setw ( 4 ) << std::setfill ( '0' )
+                << static_cast< unsigned int >( c ) << std::dec << std::setfill ( ' ' );
+        else
+            sst << c;
+    }
+
+    sst << '"';
+}
+
+// -----------------------------------------------------------------------------
+
+void KBenchmarkSuite :: writeJson ( std::ostream& sst ) const
+{
+    const VkPhysicalDeviceProperties& props = d_hDevice.physical().properties();
+    const vpp::SVulkanVersion apiVersion = vpp::SVulkanVersion::fromId ( props.apiVersion );
+
+    sst << std::setprecision ( 6 );
+    sst << "{\n";
+    sst << "  \"format\": \"vppBench\",\n";
+    sst << "  \"formatVersion\": 1,\n";
+    sst << "  \"device\": {\n";
+    sst << "    \"name\": ";
+    writeJsonString ( sst, props.deviceName );
+    sst << ",\n";
+    sst << "    \"apiVersion\": \"" << apiVersion.toString() << "\",\n";
+    sst << "    \"driverVersion\": " << props.driverVersion << ",\n";
+    sst << "    \"vendorId\": " << props.vendorID << ",\n";
+    sst << "    \"deviceId\": " << props.deviceID << "\n";
+    sst << "  },\n";
+    sst << "  \"results\": [";
+
+    for ( size_t i = 0; i != d_results.size(); ++i )
+    {
+        const SBenchResult& r = d_results [ i ];
+
+        sst << ( i == 0 ? "\n" : ",\n" );
+        sst << "    { \"group\": ";
+        writeJsonString ( sst, r.d_group );
+        sst << ", \"name\": ";
+        writeJsonString ( sst, r.d_name );
+        sst << ", \"iterations\": " << r.d_iterations;
+        sst << ", \"minUs\": " << r.d_minUs;
+        sst << ", \"meanUs\": " << r.d_meanUs;
+        sst << ", \"medianUs\": " << r.d_medianUs;
+        sst << ", \"maxUs\": " << r.d_maxUs;
+
+        if ( ! r.d_throughputUnit.empty() )
+        {
+            sst << ", \"throughput\": " << r.d_throughput;
+            sst << ", \"throughputUnit\": ";
+            writeJsonString ( sst, r.d_throughputUnit );
+        }
+
+        sst << " }";
+    }
+
+    sst << "\n  ]\n}\n";
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                     Shader translation and pipeline creation
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+template< class PipelineT >
+void benchPipeline ( KBenchmarkSuite* pSuite, const char* pName )
+{
+    const vpp::Device& hDevice = pSuite->device();
+
+    // Creating the layout translates the C++ shader into SPIR-V and creates
+    // descriptor set layouts along with the pipeline layout.
+
+    pSuite->measure ( "translation", pName, pSuite->iterations(),
+        [ &hDevice ]()
+        {
+            vpp::ComputePipelineLayout< PipelineT > layout ( hDevice );
+        } );
+
+    if ( ! pSuite->isEnabled ( "pipeline", pName ) )
+        return;
+
+    vpp::ComputePipelineLayout< PipelineT > layout ( hDevice );
+
+    // A fresh pipeline cache each time, so that the driver really compiles.
+
+    pSuite->measure ( "pipeline", pName, pSuite->iterations(),
+        [ &hDevice, &layout ]()
+        {
+            vpp::PipelineCache hCache ( hDevice );
+            vpp::ComputePass pass ( hDevice, hCache );
+            pass.addPipeline ( layout );
+            pass.createPipelines();
+        } );
+}
+
+// -----------------------------------------------------------------------------
+
+void benchPipelines ( KBenchmarkSuite* pSuite )
+{
+    using namespace vpptest;
+
+    benchPipeline< TFloatTestPipeline< float > >( pSuite, "float" );
+    benchPipeline< TFloatTestPipeline< vpp::vect4 > >( pSuite, "vec4" );
+    benchPipeline< TIntegerTestPipeline< int > >( pSuite, "int" );
+    benchPipeline< TIntegerTestPipeline< vpp::ivect4 > >( pSuite, "ivec4" );
+    benchPipeline< KVectorTestPipeline >( pSuite, "vectors" );
+    benchPipeline< KConstructTestPipeline >( pSuite, "constructs" );
+    benchPipeline< KIndexingTestPipeline >( pSuite, "indexing" );
+    benchPipeline< KPushConstantTestPipeline >( pSuite, "pushConstants" );
+    benchPipeline< KTexelBufferTestPipeline >( pSuite, "texelBuffers" );
+    benchPipeline< KImageTestPipeline >( pSuite, "images" );
+    benchPipeline< KGlobalSyncTestPipeline >( pSuite, "globalSync" );
+    benchPipeline< KLocalArraysTestPipeline >( pSuite, "localArrays" );
+    benchPipeline< KGroupAlgorithmsTestPipeline >( pSuite, "groupAlgorithms" );
+    benchPipeline< KGroupAlgorithms2TestPipeline >( pSuite, "groupAlgorithms2" );
+    benchPipeline< KGroupVariablesTestPipeline >( pSuite, "groupVariables" );
+    benchPipeline< KAtomicsTestPipeline1 >( pSuite, "atomics" );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//          Descriptor updates, command recording and group algorithms
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KGroupAlgorithmsBench : public vpptest::KGroupAlgorithmsTestTypes
+{
+public:
+    KGroupAlgorithmsBench ( const vpp::Device& hDevice );
+
+    void run ( KBenchmarkSuite* pSuite );
+
+private:
+    void update();
+
+private:
+    static const unsigned int s_recordedDispatches = 256;
+
+    vpp::Device d_hDevice;
+    vpp::ComputePipelineLayout< vpptest::KGroupAlgorithmsTestPipeline > d_pipeline;
+    vpp::ShaderDataBlock d_dataBlock;
+
+    const unsigned int d_testBuffersLength;
+    DataBuffer d_sourceBuffer;
+    DataBuffer d_generateResultBuffer;
+    DataBuffer d_sortResultBuffer;
+    DataBuffer d_reduceResultBuffer;
+    DataBuffer d_iscanResultBuffer;
+    DataBuffer d_escanResultBuffer;
+    DataBuffer d_lboundResultBuffer;
+    DataBuffer d_uboundResultBuffer;
+
+    vpp::ComputePass d_singlePass;
+    vpp::ComputePass d_recordingPass;
+};
+
+// -----------------------------------------------------------------------------
+
+KGroupAlgorithmsBench :: KGroupAlgorithmsBench ( const vpp::Device& hDevice ) :
+    d_hDevice ( hDevice ),
+    d_pipeline ( hDevice ),
+    d_dataBlock ( d_pipeline ),
+    d_testBuffersLength ( totalTestVectorLength() ),
+    d_sourceBuffer ( d_testBuffersLength, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_generateResultBuffer ( d_testBuffersLength, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_sortResultBuffer ( d_testBuffersLength, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_reduceResultBuffer ( d_testBuffersLength, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_iscanResultBuffer ( d_testBuffersLength, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_escanResultBuffer ( d_testBuffersLength, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_lboundResultBuffer ( d_testBuffersLength, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_uboundResultBuffer ( d_testBuffersLength, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_singlePass ( hDevice ),
+    d_recordingPass ( hDevice )
+{
+    d_sourceBuffer.resize ( d_testBuffersLength );
+
+    unsigned int r = 17;
+
+    for ( unsigned int i = 0; i != d_testBuffersLength; ++i )
+    {
+        d_sourceBuffer [ i ] = r;
+        r = 69069 * r + 1;
+    }
+
+    d_sourceBuffer.commitAndWait();
+
+    update();
+
+    d_singlePass.addPipeline ( d_pipeline );
+    d_recordingPass.addPipeline ( d_pipeline );
+
+    d_singlePass << [ this ]()
+    {
+        d_dataBlock.cmdBind();
+        d_singlePass.pipeline ( 0 ).cmdBind();
+        vpp::ComputePass::cmdDispatch ( 1, 1, 1 );
+    };
+
+    d_recordingPass << [ this ]()
+    {
+        for ( unsigned int i = 0; i != s_recordedDispatches; ++i )
+        {
+            d_dataBlock.cmdBind();
+            d_recordingPass.pipeline ( 0 ).cmdBind();
+            vpp::ComputePass::cmdDispatch ( 1, 1, 1 );
+        }
+    };
+
+    d_singlePass.createPipelines();
+    d_recordingPass.createPipelines();
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupAlgorithmsBench :: update()
+{
+    d_pipeline.definition().setData (
+        d_sourceBuffer,
+        d_generateResultBuffer,
+        d_sortResultBuffer,
+        d_reduceResultBuffer,
+        d_iscanResultBuffer,
+        d_escanResultBuffer,
+        d_lboundResultBuffer,
+        d_uboundResultBuffer,
+        & d_dataBlock );
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupAlgorithmsBench :: run ( KBenchmarkSuite* pSuite )
+{
+    pSuite->measure ( "descriptors", "update8Buffers", pSuite->iterations() * 50,
+        [ this ](){ update(); }, 8.0, "descriptors/s" );
+
+    vpp::CommandPool hCmdPool ( d_hDevice, vpp::Q_GRAPHICS, vpp::CommandPool::REUSABLE );
+    vpp::CommandBuffer hCmdBuffer = hCmdPool.createBuffer();
+
+    pSuite->measure ( "recording", "bindAndDispatch", pSuite->iterations(),
+        [ this, &hCmdBuffer ]()
+        {
+            hCmdBuffer.reset();
+            vpp::CommandBufferRecorder recorder ( hCmdBuffer );
+            recorder.compute ( d_recordingPass );
+        },
+        static_cast< double >( s_recordedDispatches ), "dispatches/s" );
+
+    hCmdBuffer.reset();
+
+    {
+        vpp::CommandBufferRecorder recorder ( hCmdBuffer );
+        recorder.compute ( d_singlePass );
+    }
+
+    vpp::Queue hQueue ( d_hDevice );
+    vpp::Fence hFence ( d_hDevice );
+
+    pSuite->measure ( "groupAlgorithms", "generateSortReduceScanBound", pSuite->iterations(),
+        [ &hQueue, &hFence, &hCmdBuffer ]()
+        {
+            hQueue.submit ( hCmdBuffer, vpp::Semaphore(), vpp::Semaphore(), hFence );
+            hFence.wait();
+            hFence.reset();
+        },
+        static_cast< double >( d_testBuffersLength ), "elements/s" );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Submission overhead
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+void benchSubmission ( KBenchmarkSuite* pSuite )
+{
+    static const std::uint32_t s_batchSize = 64;
+
+    const vpp::Device& hDevice = pSuite->device();
+
+    vpp::CommandPool hCmdPool ( hDevice, vpp::Q_GRAPHICS, vpp::CommandPool::REUSABLE );
+    std::vector< vpp::CommandBuffer > buffers;
+    hCmdPool.createBuffers ( s_batchSize, & buffers );
+
+    for ( auto& iBuffer : buffers )
+    {
+        iBuffer.begin();
+        iBuffer.end();
+    }
+
+    vpp::Queue hQueue ( hDevice );
+    vpp::Fence hFence ( hDevice );
+
+    pSuite->measure ( "submission", "submitAndWaitEmpty", pSuite->iterations() * 10,
+        [ &hQueue, &hFence, &buffers ]()
+        {
+            hQueue.submit ( buffers [ 0 ], vpp::Semaphore(), vpp::Semaphore(), hFence );
+            hFence.wait();
+            hFence.reset();
+        },
+        1.0, "submits/s" );
+
+    pSuite->measure ( "submission", "separateSubmits64", pSuite->iterations(),
+        [ &hQueue, &hFence, &buffers ]()
+        {
+            for ( std::uint32_t i = 0; i != s_batchSize - 1; ++i )
+                hQueue.submit ( buffers [ i ] );
+
+            hQueue.submit ( buffers [ s_batchSize - 1 ], vpp::Semaphore(), vpp::Semaphore(), hFence );
+            hFence.wait();
+            hFence.reset();
+        },
+        static_cast< double >( s_batchSize ), "submits/s" );
+
+    pSuite->measure ( "submission", "batchedSubmit64", pSuite->iterations(),
+        [ &hQueue, &hFence, &buffers ]()
+        {
+            hQueue.submit ( buffers, vpp::Semaphore(), vpp::Semaphore(), hFence );
+            hFence.wait();
+            hFence.reset();
+        },
+        static_cast< double >( s_batchSize ), "commandBuffers/s" );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                             gvector bandwidth
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+void benchTransfers ( KBenchmarkSuite* pSuite )
+{
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer;
+
+    static const size_t s_sizes[] = { 64 * 1024, 1024 * 1024, 16 * 1024 * 1024 };
+
+    const vpp::Device& hDevice = pSuite->device();
+
+    for ( size_t bytes : s_sizes )
+    {
+        const size_t nItems = bytes / sizeof ( unsigned int );
+        const std::string sizeName = std::to_string ( bytes / 1024 ) + "KB";
+        const double megabytes = static_cast< double >( bytes ) / ( 1024.0 * 1024.0 );
+
+        DataBuffer buffer ( nItems, vpp::MemProfile::DEVICE_STATIC, hDevice );
+        buffer.resize ( nItems );
+        std::iota ( buffer.begin(), buffer.end(), 0u );
+
+        pSuite->measure ( "gvector", "commit" + sizeName, pSuite->iterations(),
+            [ &buffer ](){ buffer.commitAndWait(); }, megabytes, "MB/s" );
+
+        pSuite->measure ( "gvector", "load" + sizeName, pSuite->iterations(),
+            [ &buffer ](){ buffer.loadAndWait(); }, megabytes, "MB/s" );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                    Tiled matrix multiplication and convolution
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+typedef vpp::gvector< float, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > FloatBuffer;
+typedef vpp::gvector< vpp::float16_t, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > HalfBuffer;
+
+// -----------------------------------------------------------------------------
+
+// Baseline for the tiled kernels: one thread per output item, all operands
+// read directly from buffers.
+
+class KNaiveMatrixOperationsPipeline : public vpp::ComputePipelineConfig
+{
+public:
+    static const unsigned int LOCAL_SIZE = 64;
+
+    KNaiveMatrixOperationsPipeline ( const vpp::Device& hDevice, bool bConvolution );
+
+    void setData (
+        const FloatBuffer& source1,
+        const FloatBuffer& source2,
+        const FloatBuffer& target,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void cmdPushSize ( int x, int y, int z, int w, vpp::CommandBuffer hCmdBuffer );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    static const int CONVOLUTION_SIZE = 5;
+
+private:
+    bool d_bConvolution;
+
+    vpp::inPushConstant< vpp::TMatrixOperationParams > d_params;
+    vpp::ioBuffer d_source1;
+    vpp::ioBuffer d_source2;
+    vpp::ioBuffer d_target;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+
+KNaiveMatrixOperationsPipeline :: KNaiveMatrixOperationsPipeline (
+    const vpp::Device& hDevice, bool bConvolution ) :
+        d_bConvolution ( bConvolution ),
+        d_shader ( this, { LOCAL_SIZE, 1, 1 }, & KNaiveMatrixOperationsPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KNaiveMatrixOperationsPipeline :: setData (
+    const FloatBuffer& source1,
+    const FloatBuffer& source2,
+    const FloatBuffer& target,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_source1 = source1,
+        d_source2 = source2,
+        d_target = target
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KNaiveMatrixOperationsPipeline :: cmdPushSize (
+    int x, int y, int z, int w, vpp::CommandBuffer hCmdBuffer )
+{
+    d_params.data().m_size.set ( x, y, z, w );
+    d_params.cmdPush ( hCmdBuffer );
+}
+
+// -----------------------------------------------------------------------------
+
+void KNaiveMatrixOperationsPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    UniformVar< TMatrixOperationParams, decltype ( d_params ) > inParams ( d_params );
+    UniformSimpleArray< float, decltype ( d_source1 ) > inSource1 ( d_source1 );
+    UniformSimpleArray< float, decltype ( d_source2 ) > inSource2 ( d_source2 );
+    UniformSimpleArray< float, decltype ( d_target ) > outTarget ( d_target );
+
+    const IVec4 size = inParams [ & GMatrixOperationParams::m_size ];
+    const IVec3 globalId = pShader->inGlobalInvocationId;
+    const Int g = globalId [ X ];
+
+    VFloat sum = 0.0f;
+
+    if ( d_bConvolution )
+    {
+        // Source 1 is the image, source 2 the weights.
+
+        const Int height = size [ X ];
+        const Int width = size [ Y ];
+        const Int row = g / width;
+        const Int col = g % width;
+        const int r = CONVOLUTION_SIZE / 2;
+
+        If ( g < height * width );
+        {
+            for ( int i = 0; i != CONVOLUTION_SIZE; ++i )
+                for ( int j = 0; j != CONVOLUTION_SIZE; ++j )
+                {
+                    const Int sourceRow = Max ( Min ( row + ( i - r ), height - 1 ), Int ( 0 ) );
+                    const Int sourceCol = Max ( Min ( col + ( j - r ), width - 1 ), Int ( 0 ) );
+                    const Float pixel = inSource1 [ sourceRow * width + sourceCol ];
+                    const Float weight = inSource2 [ i * CONVOLUTION_SIZE + j ];
+                    sum = Fma ( pixel, weight, sum );
+                }
+
+            outTarget [ g ] = sum;
+        }
+        Fi();
+    }
+    else
+    {
+        // Batch count goes in w, matrices of the batch are packed.
+
+        const Int m = size [ X ];
+        const Int n = size [ Y ];
+        const Int k = size [ Z ];
+        const Int batchCount = size [ W ];
+        const Int batchIndex = g / ( m * n );
+        const Int item = g % ( m * n );
+        const Int row = item / n;
+        const Int col = item % n;
+        const Int aStart = batchIndex * m * k;
+        const Int bStart = batchIndex * k * n;
+
+        If ( g < m * n * batchCount );
+        {
+            VInt i;
+
+            For ( i, 0, k );
+            {
+                const Float a = inSource1 [ aStart + row * k + i ];
+                const Float b = inSource2 [ bStart + i * n + col ];
+                sum = Fma ( a, b, sum );
+            }
+            Rof();
+
+            outTarget [ g ] = sum;
+        }
+        Fi();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename RecordT >
+void benchDispatch (
+    KBenchmarkSuite* pSuite,
+    const char* pGroup,
+    const char* pName,
+    RecordT&& fRecord,
+    double flops )
+{
+    if ( ! pSuite->isEnabled ( pGroup, pName ) )
+        return;
+
+    const vpp::Device& hDevice = pSuite->device();
+
+    vpp::CommandPool hCmdPool ( hDevice, vpp::Q_GRAPHICS, vpp::CommandPool::REUSABLE );
+    vpp::CommandBuffer hCmdBuffer = hCmdPool.createBuffer();
+
+    hCmdBuffer.begin();
+    fRecord ( hCmdBuffer );
+    hCmdBuffer.end();
+
+    vpp::Queue hQueue ( hDevice );
+    vpp::Fence hFence ( hDevice );
+
+    pSuite->measure ( pGroup, pName, pSuite->iterations(),
+        [ &hQueue, &hFence, &hCmdBuffer ]()
+        {
+            hQueue.submit ( hCmdBuffer, vpp::Semaphore(), vpp::Semaphore(), hFence );
+            hFence.wait();
+            hFence.reset();
+        },
+        flops * 1e-9, "GFLOP/s" );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class BufferT >
+void fillRandom ( BufferT* pBuffer, size_t size )
+{
+    pBuffer->resize ( size );
+
+    unsigned int r = 17;
+
+    for ( size_t i = 0; i != size; ++i )
+    {
+        ( *pBuffer )[ i ] = static_cast< float >( r % 1024 ) / 1024.0f - 0.5f;
+        r = 69069 * r + 1;
+    }
+
+    pBuffer->commitAndWait();
+}
+
+// -----------------------------------------------------------------------------
+
+class KNaiveMatrixOperation
+{
+public:
+    KNaiveMatrixOperation ( const vpp::Device& hDevice, bool bConvolution );
+
+    void setData (
+        const FloatBuffer& source1,
+        const FloatBuffer& source2,
+        const FloatBuffer& target );
+
+    void cmdRun ( int x, int y, int z, int w, std::uint32_t nItems, vpp::CommandBuffer hCmdBuffer );
+
+private:
+    vpp::ComputePipelineLayout< KNaiveMatrixOperationsPipeline > d_pipelineLayout;
+    vpp::ComputePass d_computePass;
+    vpp::ShaderDataBlock d_dataBlock;
+};
+
+// -----------------------------------------------------------------------------
+
+KNaiveMatrixOperation :: KNaiveMatrixOperation (
+    const vpp::Device& hDevice, bool bConvolution ) :
+        d_pipelineLayout ( hDevice, bConvolution ),
+        d_computePass ( hDevice ),
+        d_dataBlock ( d_pipelineLayout )
+{
+    d_computePass.addPipeline ( d_pipelineLayout );
+    d_computePass.createPipelines();
+}
+
+// -----------------------------------------------------------------------------
+
+void KNaiveMatrixOperation :: setData (
+    const FloatBuffer& source1,
+    const FloatBuffer& source2,
+    const FloatBuffer& target )
+{
+    d_pipelineLayout.definition().setData ( source1, source2, target, & d_dataBlock );
+}
+
+// -----------------------------------------------------------------------------
+
+void KNaiveMatrixOperation :: cmdRun (
+    int x, int y, int z, int w, std::uint32_t nItems, vpp::CommandBuffer hCmdBuffer )
+{
+    d_dataBlock.cmdBind ( hCmdBuffer );
+    d_computePass.pipeline ( 0 ).cmdBind ( hCmdBuffer );
+    d_pipelineLayout.definition().cmdPushSize ( x, y, z, w, hCmdBuffer );
+
+    const std::uint32_t localSize = KNaiveMatrixOperationsPipeline::LOCAL_SIZE;
+    vpp::ComputePass::cmdDispatch ( ( nItems + localSize - 1 ) / localSize, 1, 1, hCmdBuffer );
+}
+
+// -----------------------------------------------------------------------------
+
+// Records the commands and executes them once, waiting for completion.
+
+template< typename RecordT >
+void dispatchOnce ( const vpp::Device& hDevice, RecordT&& fRecord )
+{
+    vpp::CommandPool hCmdPool ( hDevice, vpp::Q_GRAPHICS, vpp::CommandPool::REUSABLE );
+    vpp::CommandBuffer hCmdBuffer = hCmdPool.createBuffer();
+
+    hCmdBuffer.begin();
+    fRecord ( hCmdBuffer );
+    hCmdBuffer.end();
+
+    vpp::Queue hQueue ( hDevice );
+    vpp::Fence hFence ( hDevice );
+
+    hQueue.submit ( hCmdBuffer, vpp::Semaphore(), vpp::Semaphore(), hFence );
+    hFence.wait();
+}
+
+// -----------------------------------------------------------------------------
+
+// Runs the kernel once and returns the first nItems of its result. The result
+// buffer is filled with NaNs first, so that items the kernel skips (e.g. in
+// edge tiles) can not keep a valid value from an earlier run.
+
+template< class BufferT, typename RecordT >
+std::vector< float > computeResult (
+    const vpp::Device& hDevice, BufferT* pResult, size_t nItems, RecordT&& fRecord )
+{
+    for ( size_t i = 0; i != pResult->size(); ++i )
+        ( *pResult )[ i ] = std::numeric_limits< float >::quiet_NaN();
+
+    pResult->commitAndWait();
+    dispatchOnce ( hDevice, fRecord );
+    pResult->loadAndWait();
+
+    std::vector< float > result ( nItems );
+
+    for ( size_t i = 0; i != nItems; ++i )
+        result [ i ] = static_cast< float >( ( *pResult )[ i ] );
+
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+void checkResult (
+    KBenchmarkSuite* pSuite,
+    const char* pGroup,
+    const char* pName,
+    const std::vector< float >& result,
+    const std::vector< float >& reference,
+    float tolerance )
+{
+    size_t nMismatches = 0;
+
+    for ( size_t i = 0; i != reference.size(); ++i )
+    {
+        const float error = std::abs ( result [ i ] - reference [ i ] );
+
+        // Negated, so that NaNs count as mismatches.
+        if ( ! ( error <= tolerance * ( 1.0f + std::abs ( reference [ i ] ) ) ) )
+            ++nMismatches;
+    }
+
+    if ( nMismatches != 0 )
+        pSuite->reportMismatch ( pGroup, pName, nMismatches );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class MultiplyT, class BufferT >
+void checkMatrixMultiply (
+    KBenchmarkSuite* pSuite,
+    const char* pName,
+    MultiplyT* pMultiply,
+    BufferT* pResult,
+    std::uint32_t m, std::uint32_t n, std::uint32_t k, std::uint32_t batchCount,
+    const std::vector< float >& reference,
+    float tolerance )
+{
+    if ( ! pSuite->isEnabled ( "gemm", pName ) )
+        return;
+
+    const std::vector< float > result = computeResult (
+        pSuite->device(), pResult, reference.size(),
+        [ & ]( vpp::CommandBuffer hCmdBuffer )
+        {
+            pMultiply->cmdMultiply ( m, n, k, batchCount, hCmdBuffer );
+        } );
+
+    checkResult ( pSuite, "gemm", pName, result, reference, tolerance );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class ConvolutionT >
+void checkConvolution (
+    KBenchmarkSuite* pSuite,
+    const char* pName,
+    ConvolutionT* pConvolution,
+    FloatBuffer* pResult,
+    std::uint32_t height, std::uint32_t width,
+    const std::vector< float >& reference,
+    float tolerance )
+{
+    if ( ! pSuite->isEnabled ( "convolution", pName ) )
+        return;
+
+    const std::vector< float > result = computeResult (
+        pSuite->device(), pResult, reference.size(),
+        [ & ]( vpp::CommandBuffer hCmdBuffer )
+        {
+            pConvolution->cmdConvolve ( height, width, 1, hCmdBuffer );
+        } );
+
+    checkResult ( pSuite, "convolution", pName, result, reference, tolerance );
+}
+
+// -----------------------------------------------------------------------------
+
+void benchMatrixOperations ( KBenchmarkSuite* pSuite, bool bHalf )
+{
+    static const std::uint32_t s_matrixSize = 512;
+    static const std::uint32_t s_batchedMatrixSize = 64;
+    static const std::uint32_t s_batchCount = 64;
+    static const std::uint32_t s_imageSize = 1024;
+    static const int K = KNaiveMatrixOperationsPipeline::CONVOLUTION_SIZE;
+
+    // Sizes which are not multiples of any tile size, used only to check
+    // the results of partially covered edge tiles.
+    static const std::uint32_t s_edgeM = 97;
+    static const std::uint32_t s_edgeN = 75;
+    static const std::uint32_t s_edgeK = 41;
+    static const std::uint32_t s_edgeHeight = 203;
+    static const std::uint32_t s_edgeWidth = 157;
+
+    static const float s_tolerance = 1e-3f;
+    static const float s_halfTolerance = 5e-2f;
+
+    const vpp::Device& hDevice = pSuite->device();
+
+    const std::uint32_t n = s_matrixSize;
+    const std::uint32_t bn = s_batchedMatrixSize;
+    const size_t matrixItems = n * n;
+    const size_t edgeItems = s_edgeM * s_edgeN;
+    const size_t batchedItems = bn * bn * s_batchCount;
+
+    FloatBuffer a ( matrixItems, vpp::MemProfile::DEVICE_STATIC, hDevice );
+    FloatBuffer b ( matrixItems, vpp::MemProfile::DEVICE_STATIC, hDevice );
+    FloatBuffer c ( matrixItems, vpp::MemProfile::DEVICE_STATIC, hDevice );
+
+    fillRandom ( & a, matrixItems );
+    fillRandom ( & b, matrixItems );
+    c.resize ( matrixItems );
+
+    // Matrix multiplication. Results of the tiled variants are compared with
+    // those of the naive kernel.
+
+    std::vector< float > reference;
+    std::vector< float > edgeReference;
+    std::vector< float > batchedReference;
+
+    {
+        KNaiveMatrixOperation naive ( hDevice, false );
+        naive.setData ( a, b, c );
+
+        reference = computeResult ( hDevice, & c, matrixItems,
+            [ & ]( vpp::CommandBuffer hCmdBuffer )
+            {
+                naive.cmdRun ( n, n, n, 1, n * n, hCmdBuffer );
+            } );
+
+        edgeReference = computeResult ( hDevice, & c, edgeItems,
+            [ & ]( vpp::CommandBuffer hCmdBuffer )
+            {
+                naive.cmdRun ( s_edgeM, s_edgeN, s_edgeK, 1, s_edgeM * s_edgeN, hCmdBuffer );
+            } );
+
+        batchedReference = computeResult ( hDevice, & c, batchedItems,
+            [ & ]( vpp::CommandBuffer hCmdBuffer )
+            {
+                naive.cmdRun ( bn, bn, bn, s_batchCount, bn * bn * s_batchCount, hCmdBuffer );
+            } );
+
+        benchDispatch ( pSuite, "gemm", "naive512",
+            [ & ]( vpp::CommandBuffer hCmdBuffer )
+            {
+                naive.cmdRun ( n, n, n, 1, n * n, hCmdBuffer );
+            },
+            vpp::TMatrixMultiply< float >::flopCount ( n, n, n ) );
+    }
+
+    {
+        vpp::TMatrixMultiply< float, 32, 32, 16, 4 > gemm ( hDevice );
+        gemm.setData ( a, b, c );
+
+        checkMatrixMultiply ( pSuite, "tiled32x32x16", & gemm, & c, n, n, n, 1, reference, s_tolerance );
+        checkMatrixMultiply ( pSuite, "tiled32x32x16", & gemm, & c, s_edgeM, s_edgeN, s_edgeK, 1, edgeReference, s_tolerance );
+
+        benchDispatch ( pSuite, "gemm", "tiled32x32x16",
+            [ & ]( vpp::CommandBuffer hCmdBuffer ) { gemm.cmdMultiply ( n, n, n, 1, hCmdBuffer ); },
+            gemm.flopCount ( n, n, n ) );
+    }
+
+    {
+        vpp::TMatrixMultiply< float, 64, 64, 8, 16 > gemm ( hDevice );
+        gemm.setData ( a, b, c );
+
+        checkMatrixMultiply ( pSuite, "tiled64x64x8", & gemm, & c, n, n, n, 1, reference, s_tolerance );
+        checkMatrixMultiply ( pSuite, "tiled64x64x8", & gemm, & c, s_edgeM, s_edgeN, s_edgeK, 1, edgeReference, s_tolerance );
+
+        benchDispatch ( pSuite, "gemm", "tiled64x64x8",
+            [ & ]( vpp::CommandBuffer hCmdBuffer ) { gemm.cmdMultiply ( n, n, n, 1, hCmdBuffer ); },
+            gemm.flopCount ( n, n, n ) );
+    }
+
+    {
+        // The same amount of data, as a batch of small matrices.
+
+        vpp::TMatrixMultiply< float, 16, 16, 16, 2 > gemm ( hDevice );
+        gemm.setData ( a, b, c );
+
+        checkMatrixMultiply ( pSuite, "batched64x64", & gemm, & c, bn, bn, bn, s_batchCount, batchedReference, s_tolerance );
+        checkMatrixMultiply ( pSuite, "batched64x64", & gemm, & c, s_edgeM, s_edgeN, s_edgeK, 1, edgeReference, s_tolerance );
+
+        benchDispatch ( pSuite, "gemm", "batched64x64",
+            [ & ]( vpp::CommandBuffer hCmdBuffer ) { gemm.cmdMultiply ( bn, bn, bn, s_batchCount, hCmdBuffer ); },
+            gemm.flopCount ( bn, bn, bn, s_batchCount ) );
+    }
+
+    if ( bHalf )
+    {
+        // Inputs are exactly representable as halves, so the float reference
+        // applies, with a tolerance for half precision results.
+
+        HalfBuffer ha ( matrixItems, vpp::MemProfile::DEVICE_STATIC, hDevice );
+        HalfBuffer hb ( matrixItems, vpp::MemProfile::DEVICE_STATIC, hDevice );
+        HalfBuffer hc ( matrixItems, vpp::MemProfile::DEVICE_STATIC, hDevice );
+
+        fillRandom ( & ha, matrixItems );
+        fillRandom ( & hb, matrixItems );
+        hc.resize ( matrixItems );
+
+        vpp::TMatrixMultiply< vpp::float16_t, 32, 32, 16, 4 > gemm ( hDevice );
+        gemm.setData ( ha, hb, hc );
+
+        checkMatrixMultiply ( pSuite, "tiled32x32x16half", & gemm, & hc, n, n, n, 1, reference, s_halfTolerance );
+        checkMatrixMultiply ( pSuite, "tiled32x32x16half", & gemm, & hc, s_edgeM, s_edgeN, s_edgeK, 1, edgeReference, s_halfTolerance );
+
+        benchDispatch ( pSuite, "gemm", "tiled32x32x16half",
+            [ & ]( vpp::CommandBuffer hCmdBuffer ) { gemm.cmdMultiply ( n, n, n, 1, hCmdBuffer ); },
+            gemm.flopCount ( n, n, n ) );
+    }
+
+    // Convolution. Separable variant gets the outer product of the row and
+    // column weights, so all variants compute the same result.
+
+    const std::uint32_t h = s_imageSize;
+    const size_t imageItems = h * h;
+    const size_t edgeImageItems = s_edgeHeight * s_edgeWidth;
+
+    FloatBuffer image ( imageItems, vpp::MemProfile::DEVICE_STATIC, hDevice );
+    FloatBuffer filtered ( imageItems, vpp::MemProfile::DEVICE_STATIC, hDevice );
+    FloatBuffer weights ( K * K, vpp::MemProfile::DEVICE_STATIC, hDevice );
+    FloatBuffer separableWeights ( 2 * K, vpp::MemProfile::DEVICE_STATIC, hDevice );
+
+    fillRandom ( & image, imageItems );
+    fillRandom ( & separableWeights, 2 * K );
+    filtered.resize ( imageItems );
+    weights.resize ( K * K );
+
+    for ( int i = 0; i != K; ++i )
+        for ( int j = 0; j != K; ++j )
+            weights [ i * K + j ] = separableWeights [ K + i ] * separableWeights [ j ];
+
+    weights.commitAndWait();
+
+    typedef vpp::TConvolution< float, K, K > Convolution;
+    typedef vpp::TConvolution< float, K, K, true > SeparableConvolution;
+
+    std::vector< float > convolutionReference;
+    std::vector< float > edgeConvolutionReference;
+
+    {
+        KNaiveMatrixOperation naive ( hDevice, true );
+        naive.setData ( image, weights, filtered );
+
+        convolutionReference = computeResult ( hDevice, & filtered, imageItems,
+            [ & ]( vpp::CommandBuffer hCmdBuffer )
+            {
+                naive.cmdRun ( h, h, 0, 1, h * h, hCmdBuffer );
+            } );
+
+        edgeConvolutionReference = computeResult ( hDevice, & filtered, edgeImageItems,
+            [ & ]( vpp::CommandBuffer hCmdBuffer )
+            {
+                naive.cmdRun ( s_edgeHeight, s_edgeWidth, 0, 1, s_edgeHeight * s_edgeWidth, hCmdBuffer );
+            } );
+
+        benchDispatch ( pSuite, "convolution", "naive5x5",
+            [ & ]( vpp::CommandBuffer hCmdBuffer )
+            {
+                naive.cmdRun ( h, h, 0, 1, h * h, hCmdBuffer );
+            },
+            Convolution::flopCount ( h, h ) );
+    }
+
+    {
+        Convolution convolution ( hDevice );
+        convolution.setData ( image, weights, filtered );
+
+        checkConvolution ( pSuite, "tiled5x5", & convolution, & filtered, h, h, convolutionReference, s_tolerance );
+        checkConvolution ( pSuite, "tiled5x5", & convolution, & filtered, s_edgeHeight, s_edgeWidth, edgeConvolutionReference, s_tolerance );
+
+        benchDispatch ( pSuite, "convolution", "tiled5x5",
+            [ & ]( vpp::CommandBuffer hCmdBuffer ) { convolution.cmdConvolve ( h, h, 1, hCmdBuffer ); },
+            convolution.flopCount ( h, h ) );
+    }
+
+    {
+        SeparableConvolution convolution ( hDevice );
+        convolution.setData ( image, separableWeights, filtered );
+
+        checkConvolution ( pSuite, "separable5x5", & convolution, & filtered, h, h, convolutionReference, s_tolerance );
+        checkConvolution ( pSuite, "separable5x5", & convolution, & filtered, s_edgeHeight, s_edgeWidth, edgeConvolutionReference, s_tolerance );
+
+        benchDispatch ( pSuite, "convolution", "separable5x5",
+            [ & ]( vpp::CommandBuffer hCmdBuffer ) { convolution.cmdConvolve ( h, h, 1, hCmdBuffer ); },
+            convolution.flopCount ( h, h ) );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool parseOptions ( int argc, char* argv[], SBenchOptions* pOptions )
+{
+    for ( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv [ i ];
+        const bool bHasValue = ( i + 1 < argc );
+
+        if ( arg == "--iterations" && bHasValue )
+            pOptions->d_iterations = static_cast< unsigned int >( std::atoi ( argv [ ++i ] ) );
+        else if ( arg == "--filter" && bHasValue )
+            pOptions->d_filter = argv [ ++i ];
+        else if ( arg == "--output" && bHasValue )
+            pOptions->d_outputFile = argv [ ++i ];
+        else if ( arg == "--validation" )
+            pOptions->d_bValidation = true;
+        else
+        {
+            std::cerr
+                << "Usage: vppBench [--iterations N] [--filter GROUP/NAME] "
+                << "[--output FILE] [--validation]" << std::endl;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vppbench
+// -----------------------------------------------------------------------------
+
+int main ( int argc, char* argv[] )
+{
+    using namespace vppbench;
+    using namespace vpp;
+
+    SBenchOptions options;
+
+    if ( ! parseOptions ( argc, argv, & options ) )
+        return 2;
+
+    Instance inst = createInstance()
+        .vulkan ( { 1, 1, 0 } )
+        .validation ( options.d_bValidation );
+
+    PhysicalDevices physicalDevices;
+
+    if ( inst.enumeratePhysicalDevices ( & physicalDevices ) != VK_SUCCESS
+         || physicalDevices.empty() )
+    {
+        std::cerr << "No Vulkan physical device found" << std::endl;
+        return 1;
+    }
+
+    PhysicalDevice phd = physicalDevices [ 0 ];
+
+    DeviceFeatures feat;
+    feat.enableIfSupported ( fShaderInt64, phd );
+    feat.enableIfSupported ( fShaderStorageImageExtendedFormats, phd );
+    feat.enableIfSupported ( fShaderFloat64, phd );
+    feat.enableIfSupported ( fShaderBufferInt64Atomics, phd );
+    feat.enableIfSupported ( fShaderSharedInt64Atomics, phd );
+
+    const bool bShaderFloat16 = feat.enableIfSupported ( fShaderFloat16, phd );
+    const bool bStorage16 = feat.enableIfSupported ( fStorageBuffer16BitAccess, phd );
+
+    Device dev ( phd, feat );
+
+    KBenchmarkSuite suite ( dev, options );
+
+    benchPipelines ( & suite );
+
+    {
+        KGroupAlgorithmsBench groupAlgorithms ( dev );
+        groupAlgorithms.run ( & suite );
+    }
+
+    benchSubmission ( & suite );
+    benchTransfers ( & suite );
+    benchMatrixOperations ( & suite, bShaderFloat16 && bStorage16 );
+
+    if ( options.d_outputFile.empty() )
+        suite.writeJson ( std::cout );
+    else
+    {
+        std::ofstream outFile ( options.d_outputFile );
+
+        if ( ! outFile )
+        {
+            std::cerr << "Cannot write " << options.d_outputFile << std::endl;
+            return 1;
+        }
+
+        suite.writeJson ( outFile );
+    }
+
+    return suite.hasMismatches() ? 1 : 0;
+}
+
+// -----------------------------------------------------------------------------
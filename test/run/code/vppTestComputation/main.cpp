@@ -1,11 +1,7 @@
 // -----------------------------------------------------------------------------
 
 #pragma warning (disable: 4503)
-#include <vppAll.hpp>
-
-// -----------------------------------------------------------------------------
-
-#include <numeric>
+#include "vppTestComputationPipelines.hpp"
 
 // -----------------------------------------------------------------------------
 namespace vpptest {
@@ -30,337 +26,8 @@ void check ( bool bCondition )
         ++s_passedChecks;
 }
 
-// -----------------------------------------------------------------------------
-
-inline bool compareFloats ( float a, float b )
-{
-    static const float s_eps = 0.00001f;
-    return std::abs ( a - b ) <= s_eps;
-}
-
 // -----------------------------------------------------------------------------
 } // namespace
-// -----------------------------------------------------------------------------
-
-template< typename T >
-struct TTestTypeTraits
-{
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< float >
-{
-    typedef vpp::Float shader_type;
-
-    inline float create ( float v ) const
-    {
-        return v;
-    }
-
-    inline vpp::Float create ( const vpp::Float& v ) const
-    {
-        return v;
-    }
-
-    inline bool compare ( float a, float b ) const
-    {
-        return compareFloats ( a, b );
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< vpp::vect2 >
-{
-    typedef vpp::Vec2 shader_type;
-
-    inline vpp::vect2 create ( float v ) const
-    {
-        vpp::vect2 r;
-        r.set ( v, v );
-        return r;
-    }
-
-    inline vpp::Vec2 create ( const vpp::Float& v ) const
-    {
-        return vpp::Vec2 ( v, v );
-    }
-
-    inline bool compare ( const vpp::vect2& a, const vpp::vect2& b ) const
-    {
-        return compareFloats ( a.x, b.x ) && compareFloats ( a.y, b.y );
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< vpp::vect3 >
-{
-    typedef vpp::Vec3 shader_type;
-
-    inline vpp::vect3 create ( float v ) const
-    {
-        vpp::vect3 r;
-        r.set ( v, v, v );
-        return r;
-    }
-
-    inline vpp::Vec3 create ( const vpp::Float& v ) const
-    {
-        return vpp::Vec3 ( v, v, v );
-    }
-
-    inline bool compare ( const vpp::vect3& a, const vpp::vect3& b ) const
-    {
-        return
-            compareFloats ( a.x, b.x )
-            && compareFloats ( a.y, b.y )
-            && compareFloats ( a.z, b.z );
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< vpp::vect4 >
-{
-    typedef vpp::Vec4 shader_type;
-
-    inline vpp::vect4 create ( float v ) const
-    {
-        vpp::vect4 r;
-        r.set ( v, v, v, v );
-        return r;
-    }
-
-    inline vpp::Vec4 create ( const vpp::Float& v ) const
-    {
-        return vpp::Vec4 ( v, v, v, v );
-    }
-
-    inline bool compare ( const vpp::vect4& a, const vpp::vect4& b ) const
-    {
-        return
-            compareFloats ( a.x, b.x )
-            && compareFloats ( a.y, b.y )
-            && compareFloats ( a.z, b.z )
-            && compareFloats ( a.w, b.w );
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< int >
-{
-    typedef vpp::Int shader_type;
-
-    inline int create ( int v ) const
-    {
-        return v;
-    }
-
-    inline vpp::Int create ( const vpp::Int& v ) const
-    {
-        return v;
-    }
-
-    inline bool compare ( int a, int b ) const
-    {
-        return a == b;
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< vpp::ivect2 >
-{
-    typedef vpp::IVec2 shader_type;
-
-    inline vpp::ivect2 create ( int v ) const
-    {
-        vpp::ivect2 r;
-        r.set ( v, v );
-        return r;
-    }
-
-    inline vpp::IVec2 create ( const vpp::Int& v ) const
-    {
-        return vpp::IVec2 ( v, v );
-    }
-
-    inline bool compare ( const vpp::ivect2& a, const vpp::ivect2& b ) const
-    {
-        return a.r == b.r && a.g == b.g;
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< vpp::ivect3 >
-{
-    typedef vpp::IVec3 shader_type;
-
-    inline vpp::ivect3 create ( int v ) const
-    {
-        vpp::ivect3 r;
-        r.set ( v, v, v );
-        return r;
-    }
-
-    inline vpp::IVec3 create ( const vpp::Int& v ) const
-    {
-        return vpp::IVec3 ( v, v, v );
-    }
-
-    inline bool compare ( const vpp::ivect3& a, const vpp::ivect3& b ) const
-    {
-        return a.r == b.r && a.g == b.g && a.b == b.b;
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< vpp::ivect4 >
-{
-    typedef vpp::IVec4 shader_type;
-
-    inline vpp::ivect4 create ( int v ) const
-    {
-        vpp::ivect4 r;
-        r.set ( v, v, v, v );
-        return r;
-    }
-
-    inline vpp::IVec4 create ( const vpp::Int& v ) const
-    {
-        return vpp::IVec4 ( v, v, v, v );
-    }
-
-    inline bool compare ( const vpp::ivect4& a, const vpp::ivect4& b ) const
-    {
-        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< unsigned int >
-{
-    typedef vpp::UInt shader_type;
-
-    inline unsigned int create ( unsigned int v ) const
-    {
-        return v;
-    }
-
-    inline vpp::UInt create ( const vpp::UInt& v ) const
-    {
-        return v;
-    }
-
-    inline bool compare ( unsigned int a, unsigned int b ) const
-    {
-        return a == b;
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< vpp::uvect2 >
-{
-    typedef vpp::UVec2 shader_type;
-
-    inline vpp::uvect2 create ( unsigned int v ) const
-    {
-        vpp::uvect2 r;
-        r.set ( v, v );
-        return r;
-    }
-
-    inline vpp::UVec2 create ( const vpp::UInt& v ) const
-    {
-        return vpp::UVec2 ( v, v );
-    }
-
-    inline bool compare ( const vpp::uvect2& a, const vpp::uvect2& b ) const
-    {
-        return a.r == b.r && a.g == b.g;
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< vpp::uvect3 >
-{
-    typedef vpp::UVec3 shader_type;
-
-    inline vpp::uvect3 create ( unsigned int v ) const
-    {
-        vpp::uvect3 r;
-        r.set ( v, v, v );
-        return r;
-    }
-
-    inline vpp::UVec3 create ( const vpp::UInt& v ) const
-    {
-        return vpp::UVec3 ( v, v, v );
-    }
-
-    inline bool compare ( const vpp::uvect3& a, const vpp::uvect3& b ) const
-    {
-        return a.r == b.r && a.g == b.g && a.b == b.b;
-    }
-};
-
-// -----------------------------------------------------------------------------
-
-template<>
-struct TTestTypeTraits< vpp::uvect4 >
-{
-    typedef vpp::UVec4 shader_type;
-
-    inline vpp::uvect4 create ( unsigned int v ) const
-    {
-        vpp::uvect4 r;
-        r.set ( v, v, v, v );
-        return r;
-    }
-
-    inline vpp::UVec4 create ( const vpp::UInt& v ) const
-    {
-        return vpp::UVec4 ( v, v, v, v );
-    }
-
-    inline bool compare ( const vpp::uvect4& a, const vpp::uvect4& b ) const
-    {
-        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
-    }
-};
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
-template< vpp::ETag TAG >
-struct TParams : public vpp::UniformStruct< TAG, TParams >
-{
-    vpp::UniformFld< TAG, vpp::format< int, int, int, int > > d_params;
-};
-
-typedef TParams< vpp::GPU > GParams;
-typedef TParams< vpp::CPU > CParams;
-typedef vpp::gvector< CParams, vpp::Buf::UNIFORM > CParamsBuffer;
-
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
@@ -369,178 +36,6 @@ typedef vpp::gvector< CParams, vpp::Buf::UNIFORM > CParamsBuffer;
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-enum EFloatTests
-{
-    FT_ADD, FT_SUB, FT_MUL, FT_DIV, FT_REM, FT_MOD,
-
-    FT_EQU1, FT_NEQ1, FT_LSS1, FT_GTR1, FT_LEQ1, FT_GEQ1,
-    FT_EQU0, FT_NEQ0, FT_LSS0, FT_GTR0, FT_LEQ0, FT_GEQ0,
-
-    FT_ROUND, FT_ROUND_EVEN, FT_TRUNC,
-    FT_ABS, FT_SIGN, FT_FLOOR, FT_CEIL, FT_FRACT,
-    FT_RADIANS, FT_DEGREES,
-
-    FT_SIN, FT_COS, FT_TAN, FT_ASIN, FT_ACOS, FT_ATAN,
-    FT_SINH, FT_COSH, FT_TANH, FT_ASINH, FT_ACOSH, FT_ATANH,
-    FT_ATAN2,
-
-    FT_POW, FT_EXP, FT_LOG, FT_EXP2, FT_LOG2, FT_SQRT, FT_INVSQRT, FT_MIN, FT_MAX,
-    FT_CLAMP0, FT_CLAMP1, FT_CLAMP2,
-    FT_MIX0, FT_MIX1, FT_MIX2, FT_STEP0, FT_STEP1,
-    FT_SMOOTHSTEP0, FT_SMOOTHSTEP1, FT_SMOOTHSTEP2,
-
-    FT_MODF,
-
-    FT_count
-};
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
-template< typename HostT >
-class TFloatTestPipeline : public vpp::ComputePipelineConfig
-{
-public:
-    TFloatTestPipeline ( const vpp::Device& hDevice );
-
-    void setData (
-        const vpp::StorageBufferView& vs1,
-        const vpp::StorageBufferView& vs2,
-        const vpp::StorageBufferView& vt,
-        int size,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::ioBuffer d_source1;
-    vpp::ioBuffer d_source2;
-    vpp::ioBuffer d_target;
-
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-template< typename HostT >
-TFloatTestPipeline< HostT > :: TFloatTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & TFloatTestPipeline< HostT >::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-template< typename HostT >
-void TFloatTestPipeline< HostT > :: setData (
-    const vpp::StorageBufferView& vs1,
-    const vpp::StorageBufferView& vs2,
-    const vpp::StorageBufferView& vt,
-    int size,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_source1 = vs1,
-        d_source2 = vs2,
-        d_target = vt
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-template< typename HostT >
-void TFloatTestPipeline< HostT > :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-
-    //pShader->DebugCodeDump();
-
-    typedef typename TTestTypeTraits< HostT >::shader_type shader_type;
-    TTestTypeTraits< HostT > tt;
-
-    const IVec3 workgroupId = pShader->inWorkgroupId;
-    const IVec3 localId = pShader->inLocalInvocationId;
-    const Int g = workgroupId [ X ];
-    const Int l = localId [ X ];
-
-    UniformSimpleArray< HostT, decltype ( d_source1 ) > inSource1 ( d_source1 );
-    UniformSimpleArray< HostT, decltype ( d_source2 ) > inSource2 ( d_source2 );
-    UniformSimpleArray< HostT, decltype ( d_target ) > outTarget ( d_target );
-
-    const shader_type v0 = tt.create ( Float ( 0.0f ) );
-    const shader_type v1 = tt.create ( Float ( 1.0f ) );
-    const shader_type v2 = tt.create ( Float ( 2.0f ) );
-
-    If ( g == 0 && l == 0 );
-        outTarget [ FT_ADD ] = inSource1 [ FT_ADD ] + inSource2 [ FT_ADD ];
-        outTarget [ FT_SUB ] = inSource1 [ FT_SUB ] - inSource2 [ FT_SUB ];
-        outTarget [ FT_MUL ] = inSource1 [ FT_MUL ] * inSource2 [ FT_MUL ];
-        outTarget [ FT_DIV ] = inSource1 [ FT_DIV ] / inSource2 [ FT_DIV ];
-        outTarget [ FT_REM ] = inSource1 [ FT_REM ] % inSource2 [ FT_REM ];
-        outTarget [ FT_MOD ] = Mod ( inSource1 [ FT_MOD ], inSource2 [ FT_MOD ] );
-
-        outTarget [ FT_EQU1 ] = Select ( inSource1 [ FT_EQU1 ] == inSource2 [ FT_EQU1 ], v1, v0 );
-        outTarget [ FT_NEQ1 ] = Select ( inSource1 [ FT_NEQ1 ] != inSource2 [ FT_NEQ1 ], v1, v0 );
-        outTarget [ FT_LSS1 ] = Select ( inSource1 [ FT_LSS1 ] < inSource2 [ FT_LSS1 ], v1, v0 );
-        outTarget [ FT_GTR1 ] = Select ( inSource1 [ FT_GTR1 ] > inSource2 [ FT_GTR1 ], v1, v0 );
-        outTarget [ FT_LEQ1 ] = Select ( inSource1 [ FT_LEQ1 ] <= inSource2 [ FT_LEQ1 ], v1, v0 );
-        outTarget [ FT_GEQ1 ] = Select ( inSource1 [ FT_GEQ1 ] >= inSource2 [ FT_GEQ1 ], v1, v0 );
-        outTarget [ FT_EQU0 ] = Select ( inSource1 [ FT_EQU0 ] == inSource2 [ FT_EQU0 ], v1, v0 );
-        outTarget [ FT_NEQ0 ] = Select ( inSource1 [ FT_NEQ0 ] != inSource2 [ FT_NEQ0 ], v1, v0 );
-        outTarget [ FT_LSS0 ] = Select ( inSource1 [ FT_LSS0 ] < inSource2 [ FT_LSS0 ], v1, v0 );
-        outTarget [ FT_GTR0 ] = Select ( inSource1 [ FT_GTR0 ] > inSource2 [ FT_GTR0 ], v1, v0 );
-        outTarget [ FT_LEQ0 ] = Select ( inSource1 [ FT_LEQ0 ] <= inSource2 [ FT_LEQ0 ], v1, v0 );
-        outTarget [ FT_GEQ0 ] = Select ( inSource1 [ FT_GEQ0 ] >= inSource2 [ FT_GEQ0 ], v1, v0 );
-
-        outTarget [ FT_ROUND ] = Round ( inSource1 [ FT_ROUND ] );
-        outTarget [ FT_ROUND_EVEN ] = RoundEven ( inSource1 [ FT_ROUND_EVEN ] );
-        outTarget [ FT_TRUNC ] = Trunc ( inSource1 [ FT_TRUNC ] );
-        outTarget [ FT_ABS ] = Abs ( inSource1 [ FT_ABS ] );
-        outTarget [ FT_SIGN ] = Sign ( inSource1 [ FT_SIGN ] );
-        outTarget [ FT_FLOOR ] = Floor ( inSource1 [ FT_FLOOR ] );
-        outTarget [ FT_CEIL ] = Ceil ( inSource1 [ FT_CEIL ] );
-        outTarget [ FT_FRACT ] = Fract ( inSource1 [ FT_FRACT ] );
-        outTarget [ FT_RADIANS ] = Radians ( inSource1 [ FT_RADIANS ] );
-        outTarget [ FT_DEGREES ] = Degrees ( inSource1 [ FT_DEGREES ] );
-        outTarget [ FT_SIN ] = Sin ( inSource1 [ FT_SIN ] );
-        outTarget [ FT_COS ] = Cos ( inSource1 [ FT_COS ] );
-        outTarget [ FT_TAN ] = Tan ( inSource1 [ FT_TAN ] );
-        outTarget [ FT_ASIN ] = Asin ( inSource1 [ FT_ASIN ] );
-        outTarget [ FT_ACOS ] = Acos ( inSource1 [ FT_ACOS ] );
-        outTarget [ FT_ATAN ] = Atan ( inSource1 [ FT_ATAN ] );
-        outTarget [ FT_SINH ] = Sinh ( inSource1 [ FT_SINH ] );
-        outTarget [ FT_COSH ] = Cosh ( inSource1 [ FT_COSH ] );
-        outTarget [ FT_TANH ] = Tanh ( inSource1 [ FT_TANH ] );
-        outTarget [ FT_ASINH ] = Asinh ( inSource1 [ FT_ASINH ] );
-        outTarget [ FT_ACOSH ] = Acosh ( inSource1 [ FT_ACOSH ] );
-        outTarget [ FT_ATANH ] = Atanh ( inSource1 [ FT_ATANH ] );
-        outTarget [ FT_ATAN2 ] = Atan2 ( inSource1 [ FT_ATAN2 ], inSource2 [ FT_ATAN2 ] );
-        outTarget [ FT_POW ] = Pow ( inSource1 [ FT_POW ], inSource2 [ FT_POW ] );
-        outTarget [ FT_EXP ] = Exp ( inSource1 [ FT_EXP ] );
-        outTarget [ FT_LOG ] = Log ( inSource1 [ FT_LOG ] );
-        outTarget [ FT_EXP2 ] = Exp2 ( inSource1 [ FT_EXP2 ] );
-        outTarget [ FT_LOG2 ] = Log2 ( inSource1 [ FT_LOG2 ] );
-        outTarget [ FT_SQRT ] = Sqrt ( inSource1 [ FT_SQRT ] );
-        outTarget [ FT_INVSQRT ] = InverseSqrt ( inSource1 [ FT_INVSQRT ] );
-        outTarget [ FT_MIN ] = Min ( inSource1 [ FT_MIN ], inSource2 [ FT_MIN ] );
-        outTarget [ FT_MAX ] = Max ( inSource1 [ FT_MAX ], inSource2 [ FT_MAX ] );
-        outTarget [ FT_CLAMP0 ] = Clamp ( v0, inSource1 [ FT_CLAMP0 ], inSource2 [ FT_CLAMP0 ] );
-        outTarget [ FT_CLAMP1 ] = Clamp ( v1, inSource1 [ FT_CLAMP1 ], inSource2 [ FT_CLAMP1 ] );
-        outTarget [ FT_CLAMP2 ] = Clamp ( v2, inSource1 [ FT_CLAMP2 ], inSource2 [ FT_CLAMP2 ] );
-        outTarget [ FT_MIX0 ] = Mix ( v0, v2, inSource1 [ FT_MIX0 ] );
-        outTarget [ FT_MIX1 ] = Mix ( v0, v2, inSource1 [ FT_MIX1 ] );
-        outTarget [ FT_MIX2 ] = Mix ( v0, v2, inSource1 [ FT_MIX2 ] );
-        outTarget [ FT_STEP0 ] = Step ( inSource1 [ FT_STEP0 ], inSource2 [ FT_STEP0 ] );
-        outTarget [ FT_STEP1 ] = Step ( inSource1 [ FT_STEP1 ], inSource2 [ FT_STEP1 ] );
-        outTarget [ FT_SMOOTHSTEP0 ] = SmoothStep ( v0, v2, inSource1 [ FT_SMOOTHSTEP0 ] );
-        outTarget [ FT_SMOOTHSTEP1 ] = SmoothStep ( v0, v2, inSource1 [ FT_SMOOTHSTEP1 ] );
-        outTarget [ FT_SMOOTHSTEP2 ] = SmoothStep ( v0, v2, inSource1 [ FT_SMOOTHSTEP2 ] );
-        outTarget [ FT_MODF ] = Modf ( inSource1 [ FT_MODF ] ).first;
-    Fi();
-}
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
 template< typename HostT >
 class TFloatTest : public vpp::Computation
 {
@@ -775,151 +270,21 @@ void TFloatTest< HostT > :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-enum EIntegerTests
-{
-    IT_ADD, IT_SUB, IT_MUL, IT_DIV, IT_REM, IT_MOD,
-
-    IT_EQU1, IT_NEQ1, IT_LSS1, IT_GTR1, IT_LEQ1, IT_GEQ1,
-    IT_EQU0, IT_NEQ0, IT_LSS0, IT_GTR0, IT_LEQ0, IT_GEQ0,
-
-    IT_ABS, IT_SIGN, IT_MIN, IT_MAX,
-    IT_CLAMP0, IT_CLAMP1, IT_CLAMP2,
-
-    IT_FINDLSB, IT_FINDMSB, IT_BITCOUNT, IT_BITREVERSE,
-
-    IT_count
-};
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
 template< typename HostT >
-class TIntegerTestPipeline : public vpp::ComputePipelineConfig
+class TIntegerTest : public vpp::Computation
 {
 public:
-    TIntegerTestPipeline ( const vpp::Device& hDevice );
+    TIntegerTest ( const vpp::Device& hDevice );
+    TIntegerTest ( vpp::Computation& pred, const vpp::Device& hDevice );
 
-    void setData (
-        const vpp::StorageBufferView& vs1,
-        const vpp::StorageBufferView& vs2,
-        const vpp::StorageBufferView& vt,
-        int size,
-        vpp::ShaderDataBlock* pDataBlock );
+    void prepareVectors();
+    void compareResults();
 
-    void fComputeShader ( vpp::ComputeShader* pShader );
+private:
+    void prepareTest ( EIntegerTests testId, int s1, int s2, int exp );
 
-public:
-    vpp::ioBuffer d_source1;
-    vpp::ioBuffer d_source2;
-    vpp::ioBuffer d_target;
-
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-template< typename HostT >
-TIntegerTestPipeline< HostT > :: TIntegerTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & TIntegerTestPipeline< HostT >::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-template< typename HostT >
-void TIntegerTestPipeline< HostT > :: setData (
-    const vpp::StorageBufferView& vs1,
-    const vpp::StorageBufferView& vs2,
-    const vpp::StorageBufferView& vt,
-    int size,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_source1 = vs1,
-        d_source2 = vs2,
-        d_target = vt
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-template< typename HostT >
-void TIntegerTestPipeline< HostT > :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-
-    //pShader->DebugCodeDump();
-
-    typedef typename TTestTypeTraits< HostT >::shader_type shader_type;
-    TTestTypeTraits< HostT > tt;
-
-    const IVec3 workgroupId = pShader->inWorkgroupId;
-    const IVec3 localId = pShader->inLocalInvocationId;
-    const Int g = workgroupId [ X ];
-    const Int l = localId [ X ];
-
-    UniformSimpleArray< HostT, decltype ( d_source1 ) > inSource1 ( d_source1 );
-    UniformSimpleArray< HostT, decltype ( d_source2 ) > inSource2 ( d_source2 );
-    UniformSimpleArray< HostT, decltype ( d_target ) > outTarget ( d_target );
-
-    const shader_type v0 = tt.create ( Int ( 0 ) );
-    const shader_type v1 = tt.create ( Int ( 1 ) );
-    const shader_type v2 = tt.create ( Int ( 2 ) );
-
-    If ( g == 0 && l == 0 );
-        outTarget [ IT_ADD ] = inSource1 [ IT_ADD ] + inSource2 [ IT_ADD ];
-        outTarget [ IT_SUB ] = inSource1 [ IT_SUB ] - inSource2 [ IT_SUB ];
-        outTarget [ IT_MUL ] = inSource1 [ IT_MUL ] * inSource2 [ IT_MUL ];
-        outTarget [ IT_DIV ] = inSource1 [ IT_DIV ] / inSource2 [ IT_DIV ];
-        outTarget [ IT_REM ] = inSource1 [ IT_REM ] % inSource2 [ IT_REM ];
-        outTarget [ IT_MOD ] = Mod ( inSource1 [ IT_MOD ], inSource2 [ IT_MOD ] );
-
-        outTarget [ IT_EQU1 ] = Select ( inSource1 [ IT_EQU1 ] == inSource2 [ IT_EQU1 ], v1, v0 );
-        outTarget [ IT_NEQ1 ] = Select ( inSource1 [ IT_NEQ1 ] != inSource2 [ IT_NEQ1 ], v1, v0 );
-        outTarget [ IT_LSS1 ] = Select ( inSource1 [ IT_LSS1 ] <  inSource2 [ IT_LSS1 ], v1, v0 );
-        outTarget [ IT_GTR1 ] = Select ( inSource1 [ IT_GTR1 ] >  inSource2 [ IT_GTR1 ], v1, v0 );
-        outTarget [ IT_LEQ1 ] = Select ( inSource1 [ IT_LEQ1 ] <= inSource2 [ IT_LEQ1 ], v1, v0 );
-        outTarget [ IT_GEQ1 ] = Select ( inSource1 [ IT_GEQ1 ] >= inSource2 [ IT_GEQ1 ], v1, v0 );
-        outTarget [ IT_EQU0 ] = Select ( inSource1 [ IT_EQU0 ] == inSource2 [ IT_EQU0 ], v1, v0 );
-        outTarget [ IT_NEQ0 ] = Select ( inSource1 [ IT_NEQ0 ] != inSource2 [ IT_NEQ0 ], v1, v0 );
-        outTarget [ IT_LSS0 ] = Select ( inSource1 [ IT_LSS0 ] <  inSource2 [ IT_LSS0 ], v1, v0 );
-        outTarget [ IT_GTR0 ] = Select ( inSource1 [ IT_GTR0 ] >  inSource2 [ IT_GTR0 ], v1, v0 );
-        outTarget [ IT_LEQ0 ] = Select ( inSource1 [ IT_LEQ0 ] <= inSource2 [ IT_LEQ0 ], v1, v0 );
-        outTarget [ IT_GEQ0 ] = Select ( inSource1 [ IT_GEQ0 ] >= inSource2 [ IT_GEQ0 ], v1, v0 );
-
-        outTarget [ IT_ABS ] = Abs ( inSource1 [ IT_ABS ] );
-        outTarget [ IT_SIGN ] = Sign ( inSource1 [ IT_SIGN ] );
-        outTarget [ IT_MIN ] = Min ( inSource1 [ IT_MIN ], inSource2 [ IT_MIN ] );
-        outTarget [ IT_MAX ] = Max ( inSource1 [ IT_MAX ], inSource2 [ IT_MAX ] );
-        outTarget [ IT_CLAMP0 ] = Clamp ( v0, inSource1 [ IT_CLAMP0 ], inSource2 [ IT_CLAMP0 ] );
-        outTarget [ IT_CLAMP1 ] = Clamp ( v1, inSource1 [ IT_CLAMP1 ], inSource2 [ IT_CLAMP1 ] );
-        outTarget [ IT_CLAMP2 ] = Clamp ( v2, inSource1 [ IT_CLAMP2 ], inSource2 [ IT_CLAMP2 ] );
-
-        outTarget [ IT_FINDLSB ] = FindLsb ( inSource1 [ IT_FINDLSB ] );
-        outTarget [ IT_FINDMSB ] = FindMsb ( inSource1 [ IT_FINDMSB ] );
-        outTarget [ IT_BITCOUNT ] = BitCount ( inSource1 [ IT_BITCOUNT ] );
-        outTarget [ IT_BITREVERSE ] = BitReverse ( inSource1 [ IT_BITREVERSE ] );
-    Fi();
-}
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
-template< typename HostT >
-class TIntegerTest : public vpp::Computation
-{
-public:
-    TIntegerTest ( const vpp::Device& hDevice );
-    TIntegerTest ( vpp::Computation& pred, const vpp::Device& hDevice );
-
-    void prepareVectors();
-    void compareResults();
-
-private:
-    void prepareTest ( EIntegerTests testId, int s1, int s2, int exp );
-
-private:
-    static const size_t VECTOR_SIZE = 1024;
+private:
+    static const size_t VECTOR_SIZE = 1024;
 
     typedef TIntegerTestPipeline< HostT > TestPipeline;
 
@@ -1104,184 +469,6 @@ void TIntegerTest< HostT > :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-enum EVectorTests
-{
-    VT_DOT2, VT_DOT3, VT_DOT4,
-    VT_OPDET2, VT_OPDET3, VT_OPDET4,
-    VT_DISTANCE2, VT_DISTANCE3, VT_DISTANCE4,
-    VT_LENGTH2, VT_LENGTH3, VT_LENGTH4,
-    VT_NORMALIZE2, VT_NORMALIZE3, VT_NORMALIZE4,
-    VT_REFRACT2, VT_REFRACT3, VT_REFRACT4,
-    VT_REFLECT2, VT_REFLECT3, VT_REFLECT4,
-    VT_FACEFORWARD2, VT_FACEFORWARD3, VT_FACEFORWARD4,
-
-    VT_count
-};
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
-class KVectorTestPipeline : public vpp::ComputePipelineConfig
-{
-public:
-    KVectorTestPipeline ( const vpp::Device& hDevice );
-
-    void setData (
-        const vpp::StorageBufferView& vs1,
-        const vpp::StorageBufferView& vs2,
-        const vpp::StorageBufferView& vt,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::ioBuffer d_source1;
-    vpp::ioBuffer d_source2;
-    vpp::ioBuffer d_target;
-
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KVectorTestPipeline :: KVectorTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KVectorTestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KVectorTestPipeline :: setData (
-    const vpp::StorageBufferView& vs1,
-    const vpp::StorageBufferView& vs2,
-    const vpp::StorageBufferView& vt,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_source1 = vs1,
-        d_source2 = vs2,
-        d_target = vt
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-void KVectorTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-
-    TTestTypeTraits< vect4 > tt;
-
-    const IVec3 workgroupId = pShader->inWorkgroupId;
-    const IVec3 localId = pShader->inLocalInvocationId;
-    const Int g = workgroupId [ X ];
-    const Int l = localId [ X ];
-
-    UniformSimpleArray< vect4, decltype ( d_source1 ) > inSource1 ( d_source1 );
-    UniformSimpleArray< vect4, decltype ( d_source2 ) > inSource2 ( d_source2 );
-    UniformSimpleArray< vect4, decltype ( d_target ) > outTarget ( d_target );
-
-    If ( g == 0 && l == 0 );
-    {
-        // ----------------------------------------------------------------------
-
-        const Float dot2 = Dot ( inSource1 [ VT_DOT2 ][ XY ], inSource2 [ VT_DOT2 ][ XY ] );
-        outTarget [ VT_DOT2 ] = tt.create ( dot2 );
-
-        const Float dot3 = Dot ( inSource1 [ VT_DOT3 ][ XYZ ], inSource2 [ VT_DOT3 ][ XYZ ] );
-        outTarget [ VT_DOT3 ] = tt.create ( dot3 );
-
-        const Float dot4 = Dot ( inSource1 [ VT_DOT4 ], inSource2 [ VT_DOT4 ] );
-        outTarget [ VT_DOT4 ] = tt.create ( dot4 );
-
-        // ----------------------------------------------------------------------
-
-        const Mat4 op4 = OuterProduct ( inSource1 [ VT_OPDET4 ], inSource2 [ VT_OPDET4 ] );
-        const Float opdet4 = Determinant ( op4 );
-        outTarget [ VT_OPDET4 ] = tt.create ( opdet4 );
-
-        const Mat3 op3 = OuterProduct ( inSource1 [ VT_OPDET3 ][ XYZ ], inSource2 [ VT_OPDET3 ][ XYZ ] );
-        const Float opdet3 = Determinant ( op3 );
-        outTarget [ VT_OPDET3 ] = tt.create ( opdet3 );
-
-        const Mat2 op2 = OuterProduct ( inSource1 [ VT_OPDET2 ][ XY ], inSource2 [ VT_OPDET2 ][ XY ] );
-        const Float opdet2 = Determinant ( op2 );
-        outTarget [ VT_OPDET2 ] = tt.create ( opdet2 );
-
-        // ----------------------------------------------------------------------
-
-        const Float dist4 = Distance ( inSource1 [ VT_DISTANCE4 ], inSource2 [ VT_DISTANCE4 ] );
-        outTarget [ VT_DISTANCE4 ] = tt.create ( dist4 );
-
-        const Float dist3 = Distance ( inSource1 [ VT_DISTANCE3 ], inSource2 [ VT_DISTANCE3 ] );
-        outTarget [ VT_DISTANCE3 ] = tt.create ( dist3 );
-
-        const Float dist2 = Distance ( inSource1 [ VT_DISTANCE2 ], inSource2 [ VT_DISTANCE2 ] );
-        outTarget [ VT_DISTANCE2 ] = tt.create ( dist2 );
-
-        // ----------------------------------------------------------------------
-
-        const Float len4 = Length ( inSource1 [ VT_LENGTH4 ] );
-        outTarget [ VT_LENGTH4 ] = tt.create ( len4 );
-
-        const Float len3 = Length ( inSource1 [ VT_LENGTH3 ] );
-        outTarget [ VT_LENGTH3 ] = tt.create ( len3 );
-
-        const Float len2 = Length ( inSource1 [ VT_LENGTH2 ] );
-        outTarget [ VT_LENGTH2 ] = tt.create ( len2 );
-
-        // ----------------------------------------------------------------------
-
-        const Vec4 norm4 = Normalize ( inSource1 [ VT_NORMALIZE4 ] );
-        outTarget [ VT_NORMALIZE4 ] = norm4;
-
-        const Vec3 norm3 = Normalize ( inSource1 [ VT_NORMALIZE3 ][ XYZ ] );
-        outTarget [ VT_NORMALIZE3 ] = Vec4 ( norm3, 0.0f );
-
-        const Vec2 norm2 = Normalize ( inSource1 [ VT_NORMALIZE2 ][ XY ] );
-        outTarget [ VT_NORMALIZE2 ] = Vec4 ( norm2, 0.0f, 0.0f );
-
-        // ----------------------------------------------------------------------
-
-        const Vec4 refr4 = Refract ( inSource1 [ VT_REFRACT4 ], inSource2 [ VT_REFRACT4 ], 0.5f );
-        outTarget [ VT_REFRACT4 ] = refr4;
-
-        const Vec3 refr3 = Refract ( inSource1 [ VT_REFRACT3 ][ XYZ ], inSource2 [ VT_REFRACT3 ][ XYZ ], 0.5f );
-        outTarget [ VT_REFRACT3 ] = Vec4 ( refr3, 0.0f );
-
-        const Vec2 refr2 = Refract ( inSource1 [ VT_REFRACT2 ][ XY ], inSource2 [ VT_REFRACT2 ][ XY ], 0.5f );
-        outTarget [ VT_REFRACT2 ] = Vec4 ( refr2, 0.0f, 0.0f );
-
-        // ----------------------------------------------------------------------
-
-        const Vec4 refl4 = Reflect ( inSource1 [ VT_REFLECT4 ], inSource2 [ VT_REFLECT4 ] );
-        outTarget [ VT_REFLECT4 ] = refl4;
-
-        const Vec3 refl3 = Reflect ( inSource1 [ VT_REFLECT3 ][ XYZ ], inSource2 [ VT_REFLECT3 ][ XYZ ] );
-        outTarget [ VT_REFLECT3 ] = Vec4 ( refl3, 0.0f );
-
-        const Vec2 refl2 = Reflect ( inSource1 [ VT_REFLECT2 ][ XY ], inSource2 [ VT_REFLECT2 ][ XY ] );
-        outTarget [ VT_REFLECT2 ] = Vec4 ( refl2, 0.0f, 0.0f );
-
-        // ----------------------------------------------------------------------
-
-        const Vec4 ffwd4 = Reflect ( inSource1 [ VT_FACEFORWARD4 ], inSource2 [ VT_FACEFORWARD4 ] );
-        outTarget [ VT_FACEFORWARD4 ] = ffwd4;
-
-        const Vec3 ffwd3 = Reflect ( inSource1 [ VT_FACEFORWARD3 ][ XYZ ], inSource2 [ VT_FACEFORWARD3 ][ XYZ ] );
-        outTarget [ VT_FACEFORWARD3 ] = Vec4 ( ffwd3, 0.0f );
-
-        const Vec2 ffwd2 = Reflect ( inSource1 [ VT_FACEFORWARD2 ][ XY ], inSource2 [ VT_FACEFORWARD2 ][ XY ] );
-        outTarget [ VT_FACEFORWARD2 ] = Vec4 ( ffwd2, 0.0f, 0.0f );
-
-        // ----------------------------------------------------------------------
-    }
-    Fi();
-}
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
 class KVectorTest : public vpp::Computation
 {
 public:
@@ -1614,299 +801,6 @@ void KVectorTest :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-enum EConstructTests
-{
-    CT_SELECT1, CT_SELECT2, CT_SELECT3,
-    CT_IF0, CT_IF1,
-    CT_DOWHILE,
-    CT_FOR0, CT_FOR1, CT_FOR2,
-    CT_SWITCH0, CT_SWITCH1, CT_SWITCH2,
-    CT_CAST0, CT_CAST1,
-
-    CT_FUNCTION1, CT_FUNCTION2,
-
-    CT_count
-};
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
-class GFunGCD : public vpp::Function< vpp::Int, vpp::Int, vpp::Int >
-{
-public:
-    GFunGCD();
-
-private:
-    vpp::Par< vpp::Int > _n;
-    vpp::Par< vpp::Int > _k;
-};
-
-// -----------------------------------------------------------------------------
-
-GFunGCD :: GFunGCD() :
-    vpp::Function< vpp::Int, vpp::Int, vpp::Int >( "gcd" )
-{
-    using namespace vpp;
-
-    Begin();
-    {
-        VInt x = _n;
-        VInt y = _k;
-        VInt s = 0;
-        VInt t = 0;
-
-        If ( x < y );
-            t = x;
-            x = y;
-            y = t;
-        Fi();
-
-        Do(); While ( ( ( x & 1 ) | ( y & 1 ) ) == 0 );
-            x >>= 1u;
-            y >>= 1u;
-            ++s;
-        Od();
-
-        Do(); While ( x != 0 );
-        {
-            Do(); While ( ( x & 1 ) == 0 );
-                x >>= 1u;
-            Od();
-
-            Do(); While ( ( y & 1 ) == 0 );
-                y >>= 1u;
-            Od();
-
-            If ( x >= y );
-                x = ( x - y ) >> 1u;
-            Else();
-                y = ( y - x ) >> 1u;
-            Fi();
-        }
-        Od();
-
-        Return ( y << s );
-    }
-    End();
-}
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
-class KConstructTestPipeline : public vpp::ComputePipelineConfig
-{
-public:
-    KConstructTestPipeline ( const vpp::Device& hDevice );
-
-    void setData (
-        const vpp::StorageBufferView& vs1,
-        const vpp::StorageBufferView& vs2,
-        const vpp::StorageBufferView& vt,
-        int size,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::ioBuffer d_source1;
-    vpp::ioBuffer d_source2;
-    vpp::ioBuffer d_target;
-
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KConstructTestPipeline :: KConstructTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KConstructTestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KConstructTestPipeline :: setData (
-    const vpp::StorageBufferView& vs1,
-    const vpp::StorageBufferView& vs2,
-    const vpp::StorageBufferView& vt,
-    int size,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_source1 = vs1,
-        d_source2 = vs2,
-        d_target = vt
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-void KConstructTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-
-    const IVec3 workgroupId = pShader->inWorkgroupId;
-    const IVec3 localId = pShader->inLocalInvocationId;
-    const Int g = workgroupId [ X ];
-    const Int l = localId [ X ];
-
-    UniformSimpleArray< int, decltype ( d_source1 ) > inSource1 ( d_source1 );
-    UniformSimpleArray< int, decltype ( d_source2 ) > inSource2 ( d_source2 );
-    UniformSimpleArray< int, decltype ( d_target ) > outTarget ( d_target );
-
-    Function< Int, Int > factorial ( "factorial" );
-        Par< Int > factX;
-    Begin();
-    {
-        VInt t = 0;
-        VInt r = 1;
-
-        For ( t, 2, factX+1 );
-            r *= t;
-        Rof();
-
-        Return ( r );
-    }
-    End();
-
-    Function< Int, Int, Int > binomial ( "binomial" );
-    {
-        Par< Int > n;
-        Par< Int > k;
-        Begin();
-        {
-            Return ( factorial ( n ) / ( factorial ( k )*factorial ( n-k ) ) );
-        }
-        End();
-    }
-
-    GFunGCD gcd;
-
-    If ( g == 0 && l == 0 );
-    {
-        // ----------------------------------------------------------------------
-
-        outTarget [ CT_SELECT1 ] = Select ( true, inSource1 [ CT_SELECT1 ], inSource2 [ CT_SELECT1 ] );
-        outTarget [ CT_SELECT2 ] = Select ( false, inSource1 [ CT_SELECT2 ], inSource2 [ CT_SELECT2 ] );
-        outTarget [ CT_SELECT3 ] = Select (
-            inSource1 [ CT_SELECT3 ] < inSource2 [ CT_SELECT3 ],
-            inSource1 [ CT_SELECT3 ], inSource2 [ CT_SELECT3 ] );
-
-        // ----------------------------------------------------------------------
-
-        for ( unsigned int i = CT_IF0; i <= CT_IF1; ++i )
-        {
-            If ( inSource1 [ i ] < 100 );
-            {
-                const Int t = inSource2 [ i ];
-                const Int result = t + t + t;
-                outTarget [ i ] = result;
-            }
-            Else();
-            {
-                const Int t = inSource2 [ i ];
-                const Int result = t * t;
-                outTarget [ i ] = result;
-            }
-            Fi();
-        }
-
-        // ----------------------------------------------------------------------
-
-        // Binary GCD algorithm.
-
-        VInt x = inSource1 [ CT_DOWHILE ];
-        VInt y = inSource2 [ CT_DOWHILE ];
-        VInt s = 0;
-        VInt t = 0;
-
-        If ( x < y );
-            t = x;
-            x = y;
-            y = t;
-        Fi();
-
-        Do(); While ( ( ( x & 1 ) | ( y & 1 ) ) == 0 );
-            x >>= 1u;
-            y >>= 1u;
-            ++s;
-        Od();
-
-        Do(); While ( x != 0 );
-        {
-            Do(); While ( ( x & 1 ) == 0 );
-                x >>= 1u;
-            Od();
-
-            Do(); While ( ( y & 1 ) == 0 );
-                y >>= 1u;
-            Od();
-
-            If ( x >= y );
-                x = ( x - y ) >> 1u;
-            Else();
-                y = ( y - x ) >> 1u;
-            Fi();
-        }
-        Od();
-
-        outTarget [ CT_DOWHILE ] = y << s;
-
-        // ----------------------------------------------------------------------
-
-        for ( unsigned int i = CT_FOR0; i <= CT_FOR2; ++i )
-        {
-            const Int max = inSource1 [ i ];
-            const Int step = inSource2 [ i ];
-            y = 0;
-
-            For ( x, 0, max, step );
-                y += x;
-            Rof();
-
-            outTarget [ i ] = y;
-        }
-
-        // ----------------------------------------------------------------------
-
-        for ( unsigned int i = CT_SWITCH0; i <= CT_SWITCH2; ++i )
-        {
-            const Int c = inSource1 [ i ];
-
-            Switch ( c );
-                Case ( 0 );
-                    x = factorial ( 5 );
-                    Break();
-
-                Case ( 1 );
-                    x = binomial ( 6, 2 );
-                    Break();
-
-                Default();
-                    x = gcd ( 17*19, 17*23 );
-                    Break();
-            EndSwitch();
-
-            outTarget [ i ] = x;
-        }
-
-        // ----------------------------------------------------------------------
-
-        outTarget [ CT_CAST0 ] = StaticCast< Int >( 
-            StaticCast< Float >( inSource1 [ CT_CAST0 ] ) * 0.1f );
-
-        outTarget [ CT_CAST1 ] = ReinterpretCast< Int >( Float ( 1.0f ) );
-
-        // ----------------------------------------------------------------------
-
-        outTarget [ CT_FUNCTION1 ] = factorial ( inSource1 [ CT_FUNCTION1 ] );
-        outTarget [ CT_FUNCTION2 ] = binomial ( inSource1 [ CT_FUNCTION2 ], inSource2 [ CT_FUNCTION2 ] );
-    }
-    Fi();
-}
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
 class KConstructTest : public vpp::Computation
 {
 public:
@@ -2087,573 +981,37 @@ void KConstructTest :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-enum EIndexingTests
+class KIndexingTest : public vpp::Computation
 {
-    XT_LOCALARR1, XT_LOCALARR2, XT_LOCALARR3, XT_LOCALARR4, XT_LOCALARR5,
-    XT_SHAREDARR1, XT_SHAREDARR2, XT_SHAREDARR3,
-
-    XT_VECTORS1, XT_VECTORS2, XT_VECTORS3, XT_VECTORS4, XT_VECTORS5, XT_VECTORS6,
-    XT_VECTORS7, XT_VECTORS8, XT_VECTORS9, XT_VECTORS10, XT_VECTORS11, XT_VECTORS12,
-    XT_VECTORS13, XT_VECTORS14, XT_VECTORS15, XT_VECTORS16, XT_VECTORS17, XT_VECTORS18,
-
-    XT_VECSWIZZLE1_begin,
-    XT_VECSWIZZLE1_end = XT_VECSWIZZLE1_begin + 2 + 3 + 4,
-
-    XT_VVECSWIZZLE1_begin = XT_VECSWIZZLE1_end,
-    XT_VVECSWIZZLE1_end = XT_VVECSWIZZLE1_begin + 2 + 3 + 4,
-
-    XT_VECSWIZZLE2_begin = XT_VVECSWIZZLE1_end,
-    XT_VECSWIZZLE2_end = XT_VECSWIZZLE2_begin + 29,
+public:
+    KIndexingTest ( const vpp::Device& hDevice );
+    KIndexingTest ( vpp::Computation& pred, const vpp::Device& hDevice );
 
-    XT_VVECSWIZZLE2_begin = XT_VECSWIZZLE2_end,
-    XT_VVECSWIZZLE2_end = XT_VVECSWIZZLE2_begin + 3,
+    void prepareVectors();
+    void compareResults();
 
-    XT_VECSWIZZLE3_begin = XT_VVECSWIZZLE2_end,
-    XT_VECSWIZZLE3_end = XT_VECSWIZZLE3_begin + 64,
+private:
+    void prepareTest ( int testId, int s1, int s2, int exp );
+    void prepareTest ( int testId, int s1, int s2, float exp );
 
-    XT_VVECSWIZZLE3_begin = XT_VECSWIZZLE3_end,
-    XT_VVECSWIZZLE3_end = XT_VVECSWIZZLE3_begin + 4,
+private:
+    static const size_t VECTOR_SIZE = 1024;
 
-    XT_VECSWIZZLE4_begin = XT_VVECSWIZZLE3_end,
-    XT_VECSWIZZLE4_end = XT_VECSWIZZLE4_begin + 8,
+    typedef KIndexingTestPipeline TestPipeline;
 
-    XT_VVECSWIZZLE4_begin = XT_VECSWIZZLE4_end,
-    XT_VVECSWIZZLE4_end = XT_VVECSWIZZLE4_begin + 4,
+    vpp::ComputePipelineLayout< TestPipeline > d_pipeline;
+    vpp::ShaderDataBlock d_dataBlock;
 
-    XT_WRVECSWIZZLE4_begin = XT_VVECSWIZZLE4_end,
-    XT_WRVECSWIZZLE4_end = XT_WRVECSWIZZLE4_begin + 7,
+    typedef vpp::gvector< int, vpp::Buf::UNIFORM | vpp::Buf::STORAGE | vpp::Buf::SOURCE > IntVector;
 
-    XT_SWIZZLEIND_begin = XT_WRVECSWIZZLE4_end,
-    XT_SWIZZLEIND_end = XT_SWIZZLEIND_begin + 4,
+    IntVector d_source1;
+    IntVector d_source2;
+    IntVector d_target;
 
-    XT_MAT_2x2_0 = XT_SWIZZLEIND_end,
-    XT_MAT_2x2_1, XT_MAT_2x2_2, XT_MAT_2x2_3,
+    std::vector< int > d_expected;
 
-    XT_MAT_2x2_D0, XT_MAT_2x2_D1, XT_MAT_2x2_D2, XT_MAT_2x2_D3,
-    XT_MAT_2x2_C0, XT_MAT_2x2_C1, XT_MAT_2x2_C2, XT_MAT_2x2_C3,
-    XT_MAT_2x2_V0, XT_MAT_2x2_V1, XT_MAT_2x2_V2, XT_MAT_2x2_V3,
-    XT_MAT_2x2_V10, XT_MAT_2x2_V11, XT_MAT_2x2_V12, XT_MAT_2x2_V13,
-    XT_MAT_2x2_V20, XT_MAT_2x2_V21, XT_MAT_2x2_V22, XT_MAT_2x2_V23,
-    
-    XT_count
-};
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
-template< vpp::ETag TAG >
-struct TTestStruct : public vpp::UniformStruct< TAG, TTestStruct >
-{
-    vpp::UniformFld< TAG, vpp::vect2 > d_vect2;
-    vpp::UniformFld< TAG, vpp::vect2 > d_vect2a;
-    vpp::UniformFld< TAG, vpp::vect3 > d_vect3;
-    vpp::UniformFld< TAG, vpp::vect4 > d_vect4;
-    vpp::UniformFld< TAG, vpp::matr2 > d_matr2;
-    vpp::UniformFld< TAG, vpp::matr3 > d_matr3;
-    vpp::UniformFld< TAG, vpp::matr4 > d_matr4;
-};
-
-typedef TTestStruct< vpp::GPU > GTestStruct;
-typedef TTestStruct< vpp::CPU > CTestStruct;
-typedef vpp::gvector< CTestStruct, vpp::Buf::UNIFORM | vpp::Buf::STORAGE | vpp::Buf::SOURCE > CTestStructBuffer;
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
-class KIndexingTestPipeline : public vpp::ComputePipelineConfig
-{
-public:
-    KIndexingTestPipeline ( const vpp::Device& hDevice );
-
-    void setData (
-        const vpp::StorageBufferView& vs1,
-        const vpp::StorageBufferView& vs2,
-        const vpp::StorageBufferView& vt,
-        int size,
-        const vpp::StorageBufferView& tb1,
-        const vpp::StorageBufferView& tb2,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::ioBuffer d_source1;
-    vpp::ioBuffer d_source2;
-    vpp::ioBuffer d_target;
-
-    vpp::ioBuffer d_uniTestBuf1;
-    vpp::ioBuffer d_storTestBuf1;
-
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KIndexingTestPipeline :: KIndexingTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KIndexingTestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KIndexingTestPipeline :: setData (
-    const vpp::StorageBufferView& vs1,
-    const vpp::StorageBufferView& vs2,
-    const vpp::StorageBufferView& vt,
-    int size,
-    const vpp::StorageBufferView& tb1,
-    const vpp::StorageBufferView& tb2,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_source1 = vs1,
-        d_source2 = vs2,
-        d_target = vt,
-        d_uniTestBuf1 = tb1,
-        d_storTestBuf1 = tb2
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-template< class VecT >
-inline vpp::Int testSwizzle ( const VecT& v, vpp::ESwizzle2 s )
-{
-    using namespace vpp;
-    const IVec2 swizzled = v [ s ];
-    return swizzled [ 0 ] | ( swizzled [ 1 ] << 2 );
-}
-
-// -----------------------------------------------------------------------------
-
-template< class VecT >
-inline vpp::Int testSwizzle ( const VecT& v, vpp::ESwizzle3 s )
-{
-    using namespace vpp;
-    const IVec3 swizzled = v [ s ];
-    return swizzled [ 0 ] | ( swizzled [ 1 ] << 2 ) | ( swizzled [ 2 ] << 4 );
-}
-
-// -----------------------------------------------------------------------------
-
-template< class VecT >
-inline vpp::Int testSwizzle ( const VecT& v, vpp::ESwizzle4 s )
-{
-    using namespace vpp;
-    const IVec4 swizzled = v [ s ];
-    return swizzled [ 0 ] | ( swizzled [ 1 ] << 2 ) | ( swizzled [ 2 ] << 4 ) | ( swizzled [ 3 ] << 6 );
-}
-
-// -----------------------------------------------------------------------------
-
-void KIndexingTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-
-    const IVec3 workgroupId = pShader->inWorkgroupId;
-    const IVec3 localId = pShader->inLocalInvocationId;
-    const Int g = workgroupId [ X ];
-    const Int l = localId [ X ];
-
-    UniformSimpleArray< int, decltype ( d_source1 ) > inSource1 ( d_source1 );
-    UniformSimpleArray< int, decltype ( d_source2 ) > inSource2 ( d_source2 );
-    UniformSimpleArray< int, decltype ( d_target ) > outTarget ( d_target );
-
-    UniformVar< TTestStruct, decltype ( d_uniTestBuf1 ) > inUniTestBuf1 ( d_uniTestBuf1 );
-    UniformVar< TTestStruct, decltype ( d_storTestBuf1 ) > inStorTestBuf1 ( d_storTestBuf1 );
-
-    VArray< Int > intArray ( 5 );
-    intArray [ 0 ] = 0;
-    intArray [ 1 ] = 1;
-    intArray [ 2 ] = 4;
-    intArray [ 3 ] = 9;
-    intArray [ 4 ] = 16;
-
-    WArray< Int > sharedIntArray ( 5 );
-    sharedIntArray [ 0 ] = 0;
-    sharedIntArray [ 1 ] = 0;
-    sharedIntArray [ 2 ] = 0;
-    sharedIntArray [ 3 ] = 0;
-    sharedIntArray [ 4 ] = 0;
-
-    VInt vidx;
-
-    If ( g == 0 && l == 0 );
-    {
-        const Int idx1 = inSource1 [ XT_LOCALARR1 ];
-        outTarget [ XT_LOCALARR1 ] = intArray [ idx1 ];
-
-        const UInt idx2 = StaticCast< UInt >( inSource1 [ XT_LOCALARR2 ] );
-        outTarget [ XT_LOCALARR2 ] = intArray [ idx2 ];
-
-        outTarget [ XT_LOCALARR3 ] = intArray [ inSource1 [ XT_LOCALARR3 ] ];
-
-        intArray [ inSource1 [ XT_LOCALARR4 ] ] = intArray [ inSource2 [ XT_LOCALARR4 ] ];
-        outTarget [ XT_LOCALARR4 ] = intArray [ inSource1 [ XT_LOCALARR4 ] ];
-
-        outTarget [ XT_LOCALARR5 ] =
-            intArray [ inSource1 [ XT_LOCALARR5 ] ]
-            + intArray [ inSource2 [ XT_LOCALARR5 ] ];
-
-        sharedIntArray [ 0 ] = 1;
-        sharedIntArray [ 1 ] = 2;
-        sharedIntArray [ 2 ] = 3;
-        sharedIntArray [ 3 ] = 5;
-        sharedIntArray [ 4 ] = 7;
-    }
-    Fi();
-
-    If ( g == 0 && l == 1 );
-    {
-        outTarget [ XT_SHAREDARR1 ] = sharedIntArray [ inSource1 [ XT_SHAREDARR1 ] ];
-        outTarget [ XT_SHAREDARR2 ] = sharedIntArray [ inSource1 [ XT_SHAREDARR2 ] ];
-        outTarget [ XT_SHAREDARR3 ] = sharedIntArray [ inSource1 [ XT_SHAREDARR3 ] ];
-    }
-    Fi();
-
-    If ( g == 0 && l == 0 );
-    {
-        // normal
-
-        IVec2 ivec2 { 11, 13 };
-        outTarget [ XT_VECTORS1 ] = ivec2 [ 1 ];
-        const Int idx2 = inSource1 [ XT_VECTORS2 ];
-        outTarget [ XT_VECTORS2 ] = ivec2 [ idx2 ];
-        outTarget [ XT_VECTORS3 ] = ivec2 [ inSource1 [ XT_VECTORS3 ] ];
-
-        IVec3 ivec3 { 17, 19, 23 };
-        outTarget [ XT_VECTORS4 ] = ivec3 [ 1 ];
-        const Int idx3 = inSource1 [ XT_VECTORS5 ];
-        outTarget [ XT_VECTORS5 ] = ivec3 [ idx3 ];
-        outTarget [ XT_VECTORS6 ] = ivec3 [ inSource1 [ XT_VECTORS6 ] ];
-
-        IVec4 ivec4 { 29, 31, 37, 41 };
-        outTarget [ XT_VECTORS7 ] = ivec4 [ 1 ];
-        const Int idx4 = inSource1 [ XT_VECTORS8 ];
-        outTarget [ XT_VECTORS8 ] = ivec4 [ idx4 ];
-        outTarget [ XT_VECTORS9 ] = ivec4 [ inSource1 [ XT_VECTORS9 ] ];
-
-        VIVec2 vivec2 = ivec2;
-        outTarget [ XT_VECTORS10 ] = vivec2 [ 1 ];
-        const Int idx5 = inSource1 [ XT_VECTORS11 ];
-        outTarget [ XT_VECTORS11 ] = vivec2 [ idx5 ];
-        outTarget [ XT_VECTORS12 ] = vivec2 [ inSource1 [ XT_VECTORS12 ] ];
-
-        VIVec3 vivec3;
-        vivec3 = ivec3;
-        outTarget [ XT_VECTORS13 ] = vivec3 [ 1 ];
-        const Int idx6 = inSource1 [ XT_VECTORS14 ];
-        outTarget [ XT_VECTORS14 ] = vivec3 [ idx6 ];
-        outTarget [ XT_VECTORS15 ] = vivec3 [ inSource1 [ XT_VECTORS15 ] ];
-
-        VIVec4 vivec4 { 1, 1, 1, 1 };
-
-        For ( vidx, 0, 4 );
-            vivec4 [ vidx ] = ivec4 [ vidx ];
-        Rof();
-
-        outTarget [ XT_VECTORS16 ] = vivec4 [ 1 ];
-        const Int idx7 = inSource1 [ XT_VECTORS17 ];
-        outTarget [ XT_VECTORS17 ] = vivec4 [ idx7 ];
-        outTarget [ XT_VECTORS18 ] = vivec4 [ inSource1 [ XT_VECTORS18 ] ];
-
-        // swizzled reads
-
-        outTarget [ XT_VECSWIZZLE1_begin + 0 ] = ivec2 [ X ];
-        outTarget [ XT_VECSWIZZLE1_begin + 1 ] = ivec2 [ Y ];
-        outTarget [ XT_VECSWIZZLE1_begin + 2 ] = ivec3 [ X ];
-        outTarget [ XT_VECSWIZZLE1_begin + 3 ] = ivec3 [ Y ];
-        outTarget [ XT_VECSWIZZLE1_begin + 4 ] = ivec3 [ Z ];
-        outTarget [ XT_VECSWIZZLE1_begin + 5 ] = ivec4 [ X ];
-        outTarget [ XT_VECSWIZZLE1_begin + 6 ] = ivec4 [ Y ];
-        outTarget [ XT_VECSWIZZLE1_begin + 7 ] = ivec4 [ Z ];
-        outTarget [ XT_VECSWIZZLE1_begin + 8 ] = ivec4 [ W ];
-        outTarget [ XT_VVECSWIZZLE1_begin + 0 ] = vivec2 [ X ];
-        outTarget [ XT_VVECSWIZZLE1_begin + 1 ] = vivec2 [ Y ];
-        outTarget [ XT_VVECSWIZZLE1_begin + 2 ] = vivec3 [ X ];
-        outTarget [ XT_VVECSWIZZLE1_begin + 3 ] = vivec3 [ Y ];
-        outTarget [ XT_VVECSWIZZLE1_begin + 4 ] = vivec3 [ Z ];
-        outTarget [ XT_VVECSWIZZLE1_begin + 5 ] = vivec4 [ X ];
-        outTarget [ XT_VVECSWIZZLE1_begin + 6 ] = vivec4 [ Y ];
-        outTarget [ XT_VVECSWIZZLE1_begin + 7 ] = vivec4 [ Z ];
-        outTarget [ XT_VVECSWIZZLE1_begin + 8 ] = vivec4 [ W ];
-
-        IVec2 swtest2 { 0, 1 };
-        IVec3 swtest3 { 0, 1, 2 };
-        IVec4 swtest4 { 0, 1, 2, 3 };
-
-        outTarget [ XT_VECSWIZZLE2_begin +  0 ] = testSwizzle ( swtest2, XX );
-        outTarget [ XT_VECSWIZZLE2_begin +  1 ] = testSwizzle ( swtest2, YX );
-        outTarget [ XT_VECSWIZZLE2_begin +  2 ] = testSwizzle ( swtest2, XY );
-        outTarget [ XT_VECSWIZZLE2_begin +  3 ] = testSwizzle ( swtest2, YY );
-        outTarget [ XT_VECSWIZZLE2_begin +  4 ] = testSwizzle ( swtest3, XX );
-        outTarget [ XT_VECSWIZZLE2_begin +  5 ] = testSwizzle ( swtest3, YX );
-        outTarget [ XT_VECSWIZZLE2_begin +  6 ] = testSwizzle ( swtest3, ZX );
-        outTarget [ XT_VECSWIZZLE2_begin +  7 ] = testSwizzle ( swtest3, XY );
-        outTarget [ XT_VECSWIZZLE2_begin +  8 ] = testSwizzle ( swtest3, YY );
-        outTarget [ XT_VECSWIZZLE2_begin +  9 ] = testSwizzle ( swtest3, ZY );
-        outTarget [ XT_VECSWIZZLE2_begin + 10 ] = testSwizzle ( swtest3, XZ );
-        outTarget [ XT_VECSWIZZLE2_begin + 11 ] = testSwizzle ( swtest3, YZ );
-        outTarget [ XT_VECSWIZZLE2_begin + 12 ] = testSwizzle ( swtest3, ZZ );
-        outTarget [ XT_VECSWIZZLE2_begin + 13 ] = testSwizzle ( swtest4, XX );
-        outTarget [ XT_VECSWIZZLE2_begin + 14 ] = testSwizzle ( swtest4, YX );
-        outTarget [ XT_VECSWIZZLE2_begin + 15 ] = testSwizzle ( swtest4, ZX );
-        outTarget [ XT_VECSWIZZLE2_begin + 16 ] = testSwizzle ( swtest4, WX );
-        outTarget [ XT_VECSWIZZLE2_begin + 17 ] = testSwizzle ( swtest4, XY );
-        outTarget [ XT_VECSWIZZLE2_begin + 18 ] = testSwizzle ( swtest4, YY );
-        outTarget [ XT_VECSWIZZLE2_begin + 19 ] = testSwizzle ( swtest4, ZY );
-        outTarget [ XT_VECSWIZZLE2_begin + 20 ] = testSwizzle ( swtest4, WY );
-        outTarget [ XT_VECSWIZZLE2_begin + 21 ] = testSwizzle ( swtest4, XZ );
-        outTarget [ XT_VECSWIZZLE2_begin + 22 ] = testSwizzle ( swtest4, YZ );
-        outTarget [ XT_VECSWIZZLE2_begin + 23 ] = testSwizzle ( swtest4, ZZ );
-        outTarget [ XT_VECSWIZZLE2_begin + 24 ] = testSwizzle ( swtest4, WZ );
-        outTarget [ XT_VECSWIZZLE2_begin + 25 ] = testSwizzle ( swtest4, XW );
-        outTarget [ XT_VECSWIZZLE2_begin + 26 ] = testSwizzle ( swtest4, YW );
-        outTarget [ XT_VECSWIZZLE2_begin + 27 ] = testSwizzle ( swtest4, ZW );
-        outTarget [ XT_VECSWIZZLE2_begin + 28 ] = testSwizzle ( swtest4, WW );
-
-        vivec2 = swtest2;
-        vivec3 = swtest3;
-        vivec4 = swtest4;
-
-        outTarget [ XT_VVECSWIZZLE2_begin + 0 ] = testSwizzle ( vivec2, YY );
-        outTarget [ XT_VVECSWIZZLE2_begin + 1 ] = testSwizzle ( vivec3, ZZ );
-        outTarget [ XT_VVECSWIZZLE2_begin + 2 ] = testSwizzle ( vivec4, WW );
-
-        outTarget [ XT_VECSWIZZLE3_begin +  0 ] = testSwizzle ( swtest4, XXX );
-        outTarget [ XT_VECSWIZZLE3_begin +  1 ] = testSwizzle ( swtest4, YXX );
-        outTarget [ XT_VECSWIZZLE3_begin +  1 ] = testSwizzle ( swtest4, ZXX );
-        outTarget [ XT_VECSWIZZLE3_begin +  3 ] = testSwizzle ( swtest4, WXX );
-        outTarget [ XT_VECSWIZZLE3_begin +  4 ] = testSwizzle ( swtest4, XYX );
-        outTarget [ XT_VECSWIZZLE3_begin +  5 ] = testSwizzle ( swtest4, YYX );
-        outTarget [ XT_VECSWIZZLE3_begin +  6 ] = testSwizzle ( swtest4, ZYX );
-        outTarget [ XT_VECSWIZZLE3_begin +  7 ] = testSwizzle ( swtest4, WYX );
-        outTarget [ XT_VECSWIZZLE3_begin +  8 ] = testSwizzle ( swtest4, XZX );
-        outTarget [ XT_VECSWIZZLE3_begin +  9 ] = testSwizzle ( swtest4, YZX );
-        outTarget [ XT_VECSWIZZLE3_begin + 10 ] = testSwizzle ( swtest4, ZZX );
-        outTarget [ XT_VECSWIZZLE3_begin + 11 ] = testSwizzle ( swtest4, WZX );
-        outTarget [ XT_VECSWIZZLE3_begin + 11 ] = testSwizzle ( swtest4, XWX );
-        outTarget [ XT_VECSWIZZLE3_begin + 13 ] = testSwizzle ( swtest4, YWX );
-        outTarget [ XT_VECSWIZZLE3_begin + 14 ] = testSwizzle ( swtest4, ZWX );
-        outTarget [ XT_VECSWIZZLE3_begin + 15 ] = testSwizzle ( swtest4, WWX );
-        outTarget [ XT_VECSWIZZLE3_begin + 16 ] = testSwizzle ( swtest4, XXY );
-        outTarget [ XT_VECSWIZZLE3_begin + 17 ] = testSwizzle ( swtest4, YXY );
-        outTarget [ XT_VECSWIZZLE3_begin + 18 ] = testSwizzle ( swtest4, ZXY );
-        outTarget [ XT_VECSWIZZLE3_begin + 19 ] = testSwizzle ( swtest4, WXY );
-        outTarget [ XT_VECSWIZZLE3_begin + 20 ] = testSwizzle ( swtest4, XYY );
-        outTarget [ XT_VECSWIZZLE3_begin + 21 ] = testSwizzle ( swtest4, YYY );
-        outTarget [ XT_VECSWIZZLE3_begin + 21 ] = testSwizzle ( swtest4, ZYY );
-        outTarget [ XT_VECSWIZZLE3_begin + 23 ] = testSwizzle ( swtest4, WYY );
-        outTarget [ XT_VECSWIZZLE3_begin + 24 ] = testSwizzle ( swtest4, XZY );
-        outTarget [ XT_VECSWIZZLE3_begin + 25 ] = testSwizzle ( swtest4, YZY );
-        outTarget [ XT_VECSWIZZLE3_begin + 26 ] = testSwizzle ( swtest4, ZZY );
-        outTarget [ XT_VECSWIZZLE3_begin + 27 ] = testSwizzle ( swtest4, WZY );
-        outTarget [ XT_VECSWIZZLE3_begin + 28 ] = testSwizzle ( swtest4, XWY );
-        outTarget [ XT_VECSWIZZLE3_begin + 29 ] = testSwizzle ( swtest4, YWY );
-        outTarget [ XT_VECSWIZZLE3_begin + 30 ] = testSwizzle ( swtest4, ZWY );
-        outTarget [ XT_VECSWIZZLE3_begin + 31 ] = testSwizzle ( swtest4, WWY );
-        outTarget [ XT_VECSWIZZLE3_begin + 31 ] = testSwizzle ( swtest4, XXZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 33 ] = testSwizzle ( swtest4, YXZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 34 ] = testSwizzle ( swtest4, ZXZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 35 ] = testSwizzle ( swtest4, WXZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 36 ] = testSwizzle ( swtest4, XYZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 37 ] = testSwizzle ( swtest4, YYZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 38 ] = testSwizzle ( swtest4, ZYZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 39 ] = testSwizzle ( swtest4, WYZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 40 ] = testSwizzle ( swtest4, XZZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 41 ] = testSwizzle ( swtest4, YZZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 41 ] = testSwizzle ( swtest4, ZZZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 43 ] = testSwizzle ( swtest4, WZZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 44 ] = testSwizzle ( swtest4, XWZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 45 ] = testSwizzle ( swtest4, YWZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 46 ] = testSwizzle ( swtest4, ZWZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 47 ] = testSwizzle ( swtest4, WWZ );
-        outTarget [ XT_VECSWIZZLE3_begin + 48 ] = testSwizzle ( swtest4, XXW );
-        outTarget [ XT_VECSWIZZLE3_begin + 49 ] = testSwizzle ( swtest4, YXW );
-        outTarget [ XT_VECSWIZZLE3_begin + 50 ] = testSwizzle ( swtest4, ZXW );
-        outTarget [ XT_VECSWIZZLE3_begin + 51 ] = testSwizzle ( swtest4, WXW );
-        outTarget [ XT_VECSWIZZLE3_begin + 51 ] = testSwizzle ( swtest4, XYW );
-        outTarget [ XT_VECSWIZZLE3_begin + 53 ] = testSwizzle ( swtest4, YYW );
-        outTarget [ XT_VECSWIZZLE3_begin + 54 ] = testSwizzle ( swtest4, ZYW );
-        outTarget [ XT_VECSWIZZLE3_begin + 55 ] = testSwizzle ( swtest4, WYW );
-        outTarget [ XT_VECSWIZZLE3_begin + 56 ] = testSwizzle ( swtest4, XZW );
-        outTarget [ XT_VECSWIZZLE3_begin + 57 ] = testSwizzle ( swtest4, YZW );
-        outTarget [ XT_VECSWIZZLE3_begin + 58 ] = testSwizzle ( swtest4, ZZW );
-        outTarget [ XT_VECSWIZZLE3_begin + 59 ] = testSwizzle ( swtest4, WZW );
-        outTarget [ XT_VECSWIZZLE3_begin + 60 ] = testSwizzle ( swtest4, XWW );
-        outTarget [ XT_VECSWIZZLE3_begin + 61 ] = testSwizzle ( swtest4, YWW );
-        outTarget [ XT_VECSWIZZLE3_begin + 62 ] = testSwizzle ( swtest4, ZWW );
-        outTarget [ XT_VECSWIZZLE3_begin + 63 ] = testSwizzle ( swtest4, WWW );
-
-        outTarget [ XT_VVECSWIZZLE3_begin + 0 ] = testSwizzle ( vivec4, YYY );
-        outTarget [ XT_VVECSWIZZLE3_begin + 1 ] = testSwizzle ( vivec4, WYX );
-        outTarget [ XT_VVECSWIZZLE3_begin + 2 ] = testSwizzle ( vivec4, ZYW );
-        outTarget [ XT_VVECSWIZZLE3_begin + 3 ] = testSwizzle ( vivec4, WWW );
-
-        outTarget [ XT_VECSWIZZLE4_begin + 0 ] = testSwizzle ( swtest4, XYZW );
-        outTarget [ XT_VECSWIZZLE4_begin + 1 ] = testSwizzle ( swtest4, WZYX );
-        outTarget [ XT_VECSWIZZLE4_begin + 2 ] = testSwizzle ( swtest4, YXWZ );
-        outTarget [ XT_VECSWIZZLE4_begin + 3 ] = testSwizzle ( swtest4, ZWXY );
-        outTarget [ XT_VECSWIZZLE4_begin + 4 ] = testSwizzle ( swtest4, XXXX );
-        outTarget [ XT_VECSWIZZLE4_begin + 5 ] = testSwizzle ( swtest4, YYYY );
-        outTarget [ XT_VECSWIZZLE4_begin + 6 ] = testSwizzle ( swtest4, ZZZZ );
-        outTarget [ XT_VECSWIZZLE4_begin + 7 ] = testSwizzle ( swtest4, WWWW );
-
-        outTarget [ XT_VVECSWIZZLE4_begin + 0 ] = testSwizzle ( vivec4, XYZW );
-        outTarget [ XT_VVECSWIZZLE4_begin + 1 ] = testSwizzle ( vivec4, WZYX );
-        outTarget [ XT_VVECSWIZZLE4_begin + 2 ] = testSwizzle ( vivec4, YXWZ );
-        outTarget [ XT_VVECSWIZZLE4_begin + 3 ] = testSwizzle ( vivec4, ZWXY );
-
-        // swizzled writes
-        vivec4 [ X ] = 3;
-        vivec4 [ Y ] = 2;
-        vivec4 [ Z ] = 1;
-        vivec4 [ W ] = 0;
-
-        outTarget [ XT_WRVECSWIZZLE4_begin ] = testSwizzle ( vivec4, XYZW );
-
-        vivec4 [ WZYX ] = vivec4;
-        outTarget [ XT_WRVECSWIZZLE4_begin + 1 ] = testSwizzle ( vivec4, XYZW );
-
-        vivec4 [ ZX ] = swtest4 [ WW ];
-        vivec4 [ WY ] = swtest4 [ YY ];
-        outTarget [ XT_WRVECSWIZZLE4_begin + 2 ] = testSwizzle ( vivec4, XYZW );
-
-        vivec3 [ X ] = 3;
-        vivec3 [ Y ] = 2;
-        vivec3 [ Z ] = 1;
-
-        outTarget [ XT_WRVECSWIZZLE4_begin + 3 ] = testSwizzle ( vivec3, XYZ );
-
-        vivec3 [ ZYX ] = vivec3;
-        outTarget [ XT_WRVECSWIZZLE4_begin + 4 ] = testSwizzle ( vivec3, XYZ );
-
-        vivec2 [ X ] = 2;
-        vivec2 [ Y ] = 1;
-
-        outTarget [ XT_WRVECSWIZZLE4_begin + 5 ] = testSwizzle ( vivec2, XY );
-
-        vivec2 [ YX ] = vivec2;
-        outTarget [ XT_WRVECSWIZZLE4_begin + 6 ] = testSwizzle ( vivec2, XY );
-
-        // Swizzles combined with normal indexing
-        outTarget [ XT_SWIZZLEIND_begin + 0 ] = swtest4 [ WZYX ][ 0 ];
-        outTarget [ XT_SWIZZLEIND_begin + 1 ] = swtest4 [ WZYX ][ 1 ];
-        outTarget [ XT_SWIZZLEIND_begin + 2 ] = swtest4 [ WZYX ][ 2 ];
-        outTarget [ XT_SWIZZLEIND_begin + 3 ] = swtest4 [ WZYX ][ 3 ];
-
-        // 2x2 matrices
-        Mat2 mat2 { 11, 12, 21, 22 };
-
-        outTarget [ XT_MAT_2x2_0 ] = ReinterpretCast< Int >( mat2 [ 0 ][ 0 ] );
-        outTarget [ XT_MAT_2x2_1 ] = ReinterpretCast< Int >( mat2 [ 1 ][ 0 ] );
-        outTarget [ XT_MAT_2x2_2 ] = ReinterpretCast< Int >( mat2 [ 0 ][ 1 ] );
-        outTarget [ XT_MAT_2x2_3 ] = ReinterpretCast< Int >( mat2 [ 1 ][ 1 ] );
-
-        outTarget [ XT_MAT_2x2_D0 ] = ReinterpretCast< Int >( mat2 [ inSource1 [ XT_MAT_2x2_D0 ] ][ inSource2 [ XT_MAT_2x2_D0 ] ] );
-        outTarget [ XT_MAT_2x2_D1 ] = ReinterpretCast< Int >( mat2 [ inSource1 [ XT_MAT_2x2_D1 ] ][ inSource2 [ XT_MAT_2x2_D1 ] ] );
-        outTarget [ XT_MAT_2x2_D2 ] = ReinterpretCast< Int >( mat2 [ inSource1 [ XT_MAT_2x2_D2 ] ][ inSource2 [ XT_MAT_2x2_D2 ] ] );
-        outTarget [ XT_MAT_2x2_D3 ] = ReinterpretCast< Int >( mat2 [ inSource1 [ XT_MAT_2x2_D3 ] ][ inSource2 [ XT_MAT_2x2_D3 ] ] );
-
-        Vec2 mat20 = mat2 [ 0 ];
-        Vec2 mat21 = mat2 [ 1 ];
-
-        outTarget [ XT_MAT_2x2_C0 ] = ReinterpretCast< Int >( mat20 [ 0 ] );
-        outTarget [ XT_MAT_2x2_C1 ] = ReinterpretCast< Int >( mat21 [ 0 ] );
-        outTarget [ XT_MAT_2x2_C2 ] = ReinterpretCast< Int >( mat20 [ 1 ] );
-        outTarget [ XT_MAT_2x2_C3 ] = ReinterpretCast< Int >( mat21 [ 1 ] );
-
-        VMat2 vmat2 = mat2;
-        outTarget [ XT_MAT_2x2_V0 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 0 ] );
-        outTarget [ XT_MAT_2x2_V1 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 0 ] );
-        outTarget [ XT_MAT_2x2_V2 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 1 ] );
-        outTarget [ XT_MAT_2x2_V3 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 1 ] );
-
-        vmat2 [ 0 ][ 0 ] = 111.0f;
-        vmat2 [ 1 ][ 0 ] = 112.0f;
-        vmat2 [ 0 ][ 1 ] = 121.0f;
-        vmat2 [ 1 ][ 1 ] = 122.0f;
-        outTarget [ XT_MAT_2x2_V10 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 0 ] );
-        outTarget [ XT_MAT_2x2_V11 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 0 ] );
-        outTarget [ XT_MAT_2x2_V12 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 1 ] );
-        outTarget [ XT_MAT_2x2_V13 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 1 ] );
-
-        vmat2 [ 0 ] = mat2 [ 0 ];
-        vmat2 [ 1 ] = mat2 [ 1 ];
-        outTarget [ XT_MAT_2x2_V20 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 0 ] );
-        outTarget [ XT_MAT_2x2_V21 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 0 ] );
-        outTarget [ XT_MAT_2x2_V22 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 1 ] );
-        outTarget [ XT_MAT_2x2_V23 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 1 ] );
-
-        // ---------------------------------------------------------
-
-        inStorTestBuf1 [ & GTestStruct::d_matr2 ][ 0 ][ 0 ] =
-            inUniTestBuf1 [ & GTestStruct::d_matr2 ][ 0 ][ 0 ];
-        inStorTestBuf1 [ & GTestStruct::d_matr2 ][ 0 ][ 1 ] =
-            inUniTestBuf1 [ & GTestStruct::d_matr2 ][ 0 ][ 1 ];
-        inStorTestBuf1 [ & GTestStruct::d_matr2 ][ 1 ][ 0 ] =
-            inUniTestBuf1 [ & GTestStruct::d_matr2 ][ 1 ][ 0 ];
-        inStorTestBuf1 [ & GTestStruct::d_matr2 ][ 1 ][ 1 ] =
-            inUniTestBuf1 [ & GTestStruct::d_matr2 ][ 1 ][ 1 ];
-
-        inStorTestBuf1 [ & GTestStruct::d_matr3 ][ 0 ] =
-            inUniTestBuf1 [ & GTestStruct::d_matr3 ][ 0 ];
-        inStorTestBuf1 [ & GTestStruct::d_matr3 ][ 1 ] =
-            inUniTestBuf1 [ & GTestStruct::d_matr3 ][ 1 ];
-        inStorTestBuf1 [ & GTestStruct::d_matr3 ][ 2 ] =
-            inUniTestBuf1 [ & GTestStruct::d_matr3 ][ 2 ];
-
-        inStorTestBuf1 [ & GTestStruct::d_matr4 ] =
-            inUniTestBuf1 [ & GTestStruct::d_matr4 ];
-
-        inStorTestBuf1 [ & GTestStruct::d_vect2 ][ 0 ] =
-            inUniTestBuf1 [ & GTestStruct::d_vect2 ][ 0 ];
-        inStorTestBuf1 [ & GTestStruct::d_vect2 ][ 1 ] =
-            inUniTestBuf1 [ & GTestStruct::d_vect2 ][ 1 ];
-        inStorTestBuf1 [ & GTestStruct::d_vect2a ] =
-            inUniTestBuf1 [ & GTestStruct::d_vect2a ];
-        inStorTestBuf1 [ & GTestStruct::d_vect3 ] =
-            inUniTestBuf1 [ & GTestStruct::d_vect3 ];
-        inStorTestBuf1 [ & GTestStruct::d_vect4 ] =
-            inUniTestBuf1 [ & GTestStruct::d_vect4 ];
-    }
-    Fi();
-}
-
-// -----------------------------------------------------------------------------
-// -----------------------------------------------------------------------------
-
-class KIndexingTest : public vpp::Computation
-{
-public:
-    KIndexingTest ( const vpp::Device& hDevice );
-    KIndexingTest ( vpp::Computation& pred, const vpp::Device& hDevice );
-
-    void prepareVectors();
-    void compareResults();
-
-private:
-    void prepareTest ( int testId, int s1, int s2, int exp );
-    void prepareTest ( int testId, int s1, int s2, float exp );
-
-private:
-    static const size_t VECTOR_SIZE = 1024;
-
-    typedef KIndexingTestPipeline TestPipeline;
-
-    vpp::ComputePipelineLayout< TestPipeline > d_pipeline;
-    vpp::ShaderDataBlock d_dataBlock;
-
-    typedef vpp::gvector< int, vpp::Buf::UNIFORM | vpp::Buf::STORAGE | vpp::Buf::SOURCE > IntVector;
-
-    IntVector d_source1;
-    IntVector d_source2;
-    IntVector d_target;
-
-    std::vector< int > d_expected;
-
-    CTestStructBuffer d_uniTestBuf1;
-    CTestStructBuffer d_storTestBuf1;
+    CTestStructBuffer d_uniTestBuf1;
+    CTestStructBuffer d_storTestBuf1;
 };
 
 // -----------------------------------------------------------------------------
@@ -3077,99 +1435,6 @@ void KIndexingTest :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-template< vpp::ETag TAG >
-struct TPushConstantTestStruct : public vpp::UniformStruct< TAG, TPushConstantTestStruct >
-{
-    vpp::UniformFld< TAG, int > d_outIdx;
-    vpp::UniformFld< TAG, int > d_unused1;
-    vpp::UniformFld< TAG, int > d_unused2;
-    vpp::UniformFld< TAG, int > d_unused3;
-    vpp::UniformFld< TAG, vpp::matr2 > d_matr2;
-};
-
-typedef TPushConstantTestStruct< vpp::GPU > GPushConstantTestStruct;
-typedef TPushConstantTestStruct< vpp::CPU > CPushConstantTestStruct;
-
-// -----------------------------------------------------------------------------
-
-class KPushConstantTestPipeline : public vpp::ComputePipelineConfig
-{
-public:
-    KPushConstantTestPipeline ( const vpp::Device& hDevice );
-
-    void setOutBuffer (
-        const vpp::StorageBufferView& rb,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    CPushConstantTestStruct& data();
-    void push();
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::inPushConstant< TPushConstantTestStruct > d_sourceData;
-    vpp::ioBuffer d_resultBuffer;
-
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KPushConstantTestPipeline :: KPushConstantTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KPushConstantTestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KPushConstantTestPipeline :: setOutBuffer (
-    const vpp::StorageBufferView& rb,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_resultBuffer = rb
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-CPushConstantTestStruct& KPushConstantTestPipeline :: data()
-{
-    return d_sourceData.data();
-}
-
-// -----------------------------------------------------------------------------
-
-void KPushConstantTestPipeline :: push()
-{
-    d_sourceData.cmdPush();
-}
-
-// -----------------------------------------------------------------------------
-
-void KPushConstantTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-
-    const IVec3 workgroupId = pShader->inWorkgroupId;
-    const IVec3 localId = pShader->inLocalInvocationId;
-    const Int g = workgroupId [ X ];
-    const Int l = localId [ X ];
-
-    UniformVar< TPushConstantTestStruct, decltype ( d_sourceData ) > inSourceData ( d_sourceData );
-    UniformSimpleArray< matr2, decltype ( d_resultBuffer ) > outResultBuffer ( d_resultBuffer );
-
-    If ( g == 0 && l == 0 );
-    {
-        const Int idx = inSourceData [ & GPushConstantTestStruct::d_outIdx ];
-        const Mat2 v = inSourceData [ & GPushConstantTestStruct::d_matr2 ];
-        outResultBuffer [ idx ] = v;
-    }
-    Fi();
-}
-
-// -----------------------------------------------------------------------------
-
 class KPushConstantTest : public vpp::Computation
 {
 public:
@@ -3299,102 +1564,6 @@ void KPushConstantTest :: compareResults()
 //                              Texel buffer tests
 
 // -----------------------------------------------------------------------------
-
-class KTexelBufferTestTypes
-{
-public:
-    typedef vpp::format< float, float, float, float > Fmt4xF32;
-    typedef vpp::TexelBufferView< Fmt4xF32, vpp::Buf::UNITEX | vpp::Buf::STORTEX | vpp::Buf::SOURCE > View4xF32;
-    typedef Fmt4xF32::data_type Data4xF32;
-    typedef vpp::gvector< Data4xF32, vpp::Buf::UNITEX | vpp::Buf::STORTEX | vpp::Buf::SOURCE > Vec4xF32;
-};
-
-// -----------------------------------------------------------------------------
-
-class KTexelBufferTestPipeline :
-    public vpp::ComputePipelineConfig,
-    public KTexelBufferTestTypes
-{
-public:
-    typedef vpp::format< float, float, float, float > Fmt4xF32;
-
-public:
-    KTexelBufferTestPipeline ( const vpp::Device& hDevice );
-
-    void setOutBuffer (
-        const View4xF32& inTexBuf4xF32,
-        const View4xF32& ioImgBuf4xF32,
-        const View4xF32& inTexBuf4xF32a,
-        const View4xF32& ioImgBuf4xF32a,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::inTextureBuffer< Fmt4xF32 > m_inTexBuf4xF32;
-    vpp::ioImageBuffer< Fmt4xF32 > m_ioImgBuf4xF32;
-
-    vpp::inTextureBuffer< Fmt4xF32 > m_inTexBuf4xF32a;
-    vpp::ioImageBuffer< Fmt4xF32 > m_ioImgBuf4xF32a;
-
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KTexelBufferTestPipeline :: KTexelBufferTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KTexelBufferTestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KTexelBufferTestPipeline :: setOutBuffer (
-    const KTexelBufferTestPipeline::View4xF32& inTexBuf4xF32,
-    const KTexelBufferTestPipeline::View4xF32& ioImgBuf4xF32,
-    const KTexelBufferTestPipeline::View4xF32& inTexBuf4xF32a,
-    const KTexelBufferTestPipeline::View4xF32& ioImgBuf4xF32a,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        m_inTexBuf4xF32 = inTexBuf4xF32,
-        m_ioImgBuf4xF32 = ioImgBuf4xF32,
-        m_inTexBuf4xF32a = inTexBuf4xF32a,
-        m_ioImgBuf4xF32a = ioImgBuf4xF32a
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-void KTexelBufferTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-
-    const IVec3 workgroupId = pShader->inWorkgroupId;
-    const IVec3 localId = pShader->inLocalInvocationId;
-    const Int g = workgroupId [ X ];
-    const Int l = localId [ X ];
-    const Int index = ( g << 5 ) | l;
-
-    TexelArray< decltype ( m_inTexBuf4xF32a ) > inTexBuf4xF32a ( m_inTexBuf4xF32a );
-    TexelArray< decltype ( m_ioImgBuf4xF32a ) > ioImgBuf4xF32a ( m_ioImgBuf4xF32a );
-    
-    UseImage ( m_inTexBuf4xF32 );
-    UseImage ( m_ioImgBuf4xF32 );
-
-    const Int bufferLength = inTexBuf4xF32a.Size();
-
-    If ( index < bufferLength );
-    {
-        const Vec4 v = TexelFetch ( m_inTexBuf4xF32, index );
-        ImageStore ( m_ioImgBuf4xF32, index, v );
-
-        const Vec4 va = inTexBuf4xF32a [ index ];
-        ioImgBuf4xF32a [ index ] = va;
-    }
-    Fi();
-}
-
 // -----------------------------------------------------------------------------
 
 class KTexelBufferTest :
@@ -3538,147 +1707,6 @@ void KTexelBufferTest :: compareResults()
 //                                Images tests
 
 // -----------------------------------------------------------------------------
-
-template< class FormatT >
-struct TImageTestTypeSet
-{
-    typedef typename FormatT::data_type data_type;
-    typedef vpp::gvector< data_type, vpp::Buf::SOURCE | vpp::Buf::TARGET > buffer_type;
-
-    typedef vpp::ImageAttributes<
-        FormatT, vpp::RENDER, vpp::IMG_TYPE_2D,
-        vpp::Img::STORAGE | vpp::Img::SAMPLED | vpp::Img::SOURCE | vpp::Img::TARGET,
-        VK_IMAGE_TILING_OPTIMAL, VK_SAMPLE_COUNT_1_BIT,
-        false, false > AttributesT;
-
-    typedef vpp::Image< AttributesT > image_type;
-    typedef vpp::ImageViewAttributes< image_type > ViewAttrT;
-    typedef vpp::ImageView< ViewAttrT > view_type;
-};
-
-// -----------------------------------------------------------------------------
-
-struct KImageTestTypes
-{
-    typedef vpp::format< float, float, float, float > Fmt4xF32;
-    typedef TImageTestTypeSet< Fmt4xF32 > Types4xF32;
-    typedef typename Types4xF32::image_type Img4xF32;
-    typedef typename Types4xF32::view_type View4xF32;
-    typedef typename Types4xF32::buffer_type Buf4xF32;
-    typedef typename Types4xF32::data_type Data4xF32;
-
-    typedef vpp::format< vpp::unorm8_t, vpp::unorm8_t, vpp::unorm8_t, vpp::unorm8_t > Fmt4xFU8;
-    typedef TImageTestTypeSet< Fmt4xFU8 > Types4xFU8;
-    typedef typename Types4xFU8::image_type Img4xFU8;
-    typedef typename Types4xFU8::view_type View4xFU8;
-    typedef typename Types4xFU8::buffer_type Buf4xFU8;
-    typedef typename Types4xFU8::data_type Data4xFU8;
-
-    typedef vpp::format< vpp::snorm8_t, vpp::snorm8_t > Fmt2xFS8;
-    typedef TImageTestTypeSet< Fmt2xFS8 > Types2xFS8;
-    typedef typename Types2xFS8::image_type Img2xFS8;
-    typedef typename Types2xFS8::view_type View2xFS8;
-    typedef typename Types2xFS8::buffer_type Buf2xFS8;
-    typedef typename Types2xFS8::data_type Data2xFS8;
-
-    static const unsigned int WIDTH = 500;
-    static const unsigned int HEIGHT = 377;
-    static const unsigned int LENGTH = WIDTH * HEIGHT;
-};
-
-// -----------------------------------------------------------------------------
-
-class KImageTestPipeline :
-    public vpp::ComputePipelineConfig,
-    public KImageTestTypes
-{
-public:
-    KImageTestPipeline ( const vpp::Device& hDevice );
-
-    void setBuffers (
-        const View4xF32& inTexBuf4xF32,
-        const View4xF32& ioImgBuf4xF32,
-        const View4xFU8& inTexBuf4xFU8,
-        const View4xFU8& ioImgBuf4xFU8,
-        const View2xFS8& inTexBuf2xFS8,
-        const View2xFS8& ioImgBuf2xFS8,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::ioImage< View4xF32 > m_inImgBuf4xF32;
-    vpp::ioImage< View4xF32 > m_ioImgBuf4xF32;
-    vpp::ioImage< View4xFU8 > m_inImgBuf4xFU8;
-    vpp::ioImage< View4xFU8 > m_ioImgBuf4xFU8;
-    vpp::ioImage< View2xFS8 > m_inImgBuf2xFS8;
-    vpp::ioImage< View2xFS8 > m_ioImgBuf2xFS8;
-
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KImageTestPipeline :: KImageTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KImageTestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KImageTestPipeline :: setBuffers (
-    const KImageTestPipeline::View4xF32& inImgBuf4xF32,
-    const KImageTestPipeline::View4xF32& ioImgBuf4xF32,
-    const KImageTestPipeline::View4xFU8& inImgBuf4xFU8,
-    const KImageTestPipeline::View4xFU8& ioImgBuf4xFU8,
-    const KImageTestPipeline::View2xFS8& inImgBuf2xFS8,
-    const KImageTestPipeline::View2xFS8& ioImgBuf2xFS8,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        m_inImgBuf4xF32 = inImgBuf4xF32,
-        m_ioImgBuf4xF32 = ioImgBuf4xF32,
-        m_inImgBuf4xFU8 = inImgBuf4xFU8,
-        m_ioImgBuf4xFU8 = ioImgBuf4xFU8,
-        m_inImgBuf2xFS8 = inImgBuf2xFS8,
-        m_ioImgBuf2xFS8 = ioImgBuf2xFS8
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-void KImageTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-
-    const IVec3 workgroupId = pShader->inWorkgroupId;
-    const IVec3 localId = pShader->inLocalInvocationId;
-    const Int g = workgroupId [ X ];
-    const Int l = localId [ X ];
-    const Int index = ( g << 5 ) | l;
-
-    const IVec2 imgSize1 = ImageSize ( m_inImgBuf4xF32 );
-    const Int width1 = imgSize1 [ X ];
-    const Int height1 = imgSize1 [ Y ];
-    const Int x1 = index % width1;
-    const Int y1 = index / width1;
-
-    If ( y1 < height1 );
-    {
-        const IVec2 coords = IVec2 ( x1, y1 );
-
-        const Vec4 v1 = ImageLoad ( m_inImgBuf4xF32, coords );
-        ImageStore ( m_ioImgBuf4xF32, coords, v1 );
-
-        const Vec4 v2 = ImageLoad ( m_inImgBuf4xFU8, coords );
-        ImageStore ( m_ioImgBuf4xFU8, coords, v2 );
-
-        const Vec4 v3 = ImageLoad ( m_inImgBuf2xFS8, coords );
-        ImageStore ( m_ioImgBuf2xFS8, coords, -v3 );
-    }
-    Fi();
-}
-
 // -----------------------------------------------------------------------------
 
 class KImageTest :
@@ -3872,101 +1900,12 @@ void KImageTest :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-struct KGlobalSyncTestTypes
+class KGlobalSyncTest :
+    public vpp::Computation,
+    public KGlobalSyncTestTypes
 {
-    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::SOURCE | vpp::Buf::TARGET > DataBuffer;
-    typedef vpp::format< unsigned int > FormatU32;
-
-    typedef vpp::ImageAttributes<
-        FormatU32, vpp::RENDER, vpp::IMG_TYPE_2D,
-        vpp::Img::STORAGE | vpp::Img::TARGET,
-        VK_IMAGE_TILING_OPTIMAL, VK_SAMPLE_COUNT_1_BIT,
-        false, false > TestImageAttr;
-
-    typedef vpp::Image< TestImageAttr > TestImage;
-    typedef vpp::ImageViewAttributes< TestImage > TestImageViewAttr;
-    typedef vpp::ImageView< TestImageViewAttr > TestImageView;
-};
-
-// -----------------------------------------------------------------------------
-
-class KGlobalSyncTestPipeline :
-    public vpp::ComputePipelineConfig,
-    public KGlobalSyncTestTypes
-{
-public:
-    KGlobalSyncTestPipeline ( const vpp::Device& hDevice );
-
-    void setData (
-        const DataBuffer& resultView,
-        const TestImageView& testImageView,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::ioBuffer d_sourceBuffer;
-    vpp::ioBuffer d_resultBuffer;
-    vpp::ioImage< TestImageView, vpp::MEM_COHERENT | vpp::MEM_VOLATILE > d_testImage;
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KGlobalSyncTestPipeline :: KGlobalSyncTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KGlobalSyncTestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KGlobalSyncTestPipeline :: setData (
-    const DataBuffer& resultView,
-    const TestImageView& testImageView,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_resultBuffer = resultView,
-        d_testImage = testImageView
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-void KGlobalSyncTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-
-    // pShader->DebugCodeDump();
-
-    const Int ng = pShader->inNumWorkgroups [ X ];
-    const Int nl = pShader->inWorkgroupSize [ X ];
-    const Int np = ng * nl;
-    const Int l = pShader->inLocalInvocationId [ X ];
-    const Int g = pShader->inWorkgroupId [ X ];
-
-    UseImage ( d_testImage );
-
-    If ( g == 0 && l == 0 );
-        ImageStore ( d_testImage, IVec2 { 0, 0 }, 77u );
-    Fi();
-
-    //DeviceBarrier ( spv::MemorySemanticsImageMemoryMask | spv::MemorySemanticsAcquireReleaseMask );
-
-    const UInt v = ImageLoad ( d_testImage, IVec2 { 0, 0 } )[ X ];
-
-    UniformSimpleArray< unsigned int, decltype ( d_resultBuffer ) > outResultBuffer ( d_resultBuffer );
-    outResultBuffer [ ( g << 5 ) | l ] = v;
-}
-
-// -----------------------------------------------------------------------------
-
-class KGlobalSyncTest :
-    public vpp::Computation,
-    public KGlobalSyncTestTypes
-{
-public:
-    KGlobalSyncTest ( vpp::Computation& pred,  const vpp::Device& hDevice );
+public:
+    KGlobalSyncTest ( vpp::Computation& pred,  const vpp::Device& hDevice );
 
     void compareResults();
 
@@ -4039,227 +1978,6 @@ void KGlobalSyncTest :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-struct KLocalArraysTestTypes
-{
-    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferI;
-    typedef vpp::gvector< float, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferF;
-
-    typedef vpp::format< unsigned int > FormatU32;
-    typedef vpp::format< float > FormatF32;
-
-    static void computeTestOffsets ( std::vector< unsigned int >* pOffsets );
-    static unsigned int totalTestVectorLength();
-
-    static const unsigned int s_testSizes[];
-    static const unsigned int s_testCount;
-};
-
-// -----------------------------------------------------------------------------
-
-const unsigned int KLocalArraysTestTypes :: s_testSizes[] =
-{
-    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 32, 256
-};
-
-// -----------------------------------------------------------------------------
-
-const unsigned int KLocalArraysTestTypes :: s_testCount =
-    sizeof ( s_testSizes ) / sizeof ( unsigned int );
-
-// -----------------------------------------------------------------------------
-
-void KLocalArraysTestTypes :: computeTestOffsets ( std::vector< unsigned int >* pOffsets )
-{
-    pOffsets->resize ( s_testCount + 1 );
-
-    unsigned int offset = 0;
-
-    for ( unsigned int i = 0; i != s_testCount; ++i )
-    {
-        ( *pOffsets )[ i ] = offset;
-        offset += s_testSizes [ i ];
-    }
-
-    ( *pOffsets )[ s_testCount ] = offset;
-}
-
-// -----------------------------------------------------------------------------
-
-unsigned int KLocalArraysTestTypes :: totalTestVectorLength()
-{
-    return std::accumulate ( s_testSizes + 0, s_testSizes + s_testCount, 0 );
-}
-
-// -----------------------------------------------------------------------------
-
-class KLocalArraysTestPipeline :
-    public vpp::ComputePipelineConfig,
-    public KLocalArraysTestTypes
-{
-public:
-    KLocalArraysTestPipeline ( const vpp::Device& hDevice );
-
-    void setData (
-        const DataBufferI& generateResultViewI,
-        const DataBufferI& transformResultViewI,
-        const DataBufferI& reverseResultViewI,
-        const DataBufferF& generateResultViewF,
-        const DataBufferF& transformResultViewF,
-        const DataBufferF& reverseResultViewF,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::ioBuffer d_generateResultBufferI;
-    vpp::ioBuffer d_transformResultBufferI;
-    vpp::ioBuffer d_reverseResultBufferI;
-    vpp::ioBuffer d_generateResultBufferF;
-    vpp::ioBuffer d_transformResultBufferF;
-    vpp::ioBuffer d_reverseResultBufferF;
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KLocalArraysTestPipeline :: KLocalArraysTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KLocalArraysTestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KLocalArraysTestPipeline :: setData (
-    const DataBufferI& generateResultViewI,
-    const DataBufferI& transformResultViewI,
-    const DataBufferI& reverseResultViewI,
-    const DataBufferF& generateResultViewF,
-    const DataBufferF& transformResultViewF,
-    const DataBufferF& reverseResultViewF,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_generateResultBufferI = generateResultViewI,
-        d_transformResultBufferI = transformResultViewI,
-        d_reverseResultBufferI = reverseResultViewI,
-        d_generateResultBufferF = generateResultViewF,
-        d_transformResultBufferF = transformResultViewF,
-        d_reverseResultBufferF = reverseResultViewF
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-void KLocalArraysTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-    using namespace vpp::ct;
-
-    group::GroupInvocation inv ( pShader );
-
-    //pShader->DebugCodeDump();
-
-    const Int ng = pShader->inNumWorkgroups [ X ];
-    const Int nl = pShader->inWorkgroupSize [ X ];
-    const Int np = ng * nl;
-    const Int l = pShader->inLocalInvocationId [ X ];
-    const Int g = pShader->inWorkgroupId [ X ];
-
-    UniformSimpleArray< int, decltype ( d_generateResultBufferI ) > outGenerateBufferI ( d_generateResultBufferI );
-    UniformSimpleArray< int, decltype ( d_transformResultBufferI ) > outTransformBufferI ( d_transformResultBufferI );
-    UniformSimpleArray< int, decltype ( d_reverseResultBufferI ) > outReverseBufferI ( d_reverseResultBufferI );
-    UniformSimpleArray< float, decltype ( d_generateResultBufferF ) > outGenerateBufferF ( d_generateResultBufferF );
-    UniformSimpleArray< float, decltype ( d_transformResultBufferF ) > outTransformBufferF ( d_transformResultBufferF );
-    UniformSimpleArray< float, decltype ( d_reverseResultBufferF ) > outReverseBufferF ( d_reverseResultBufferF );
-
-    VInt tmpi;
-
-    std::vector< unsigned int > offsets;
-    computeTestOffsets ( & offsets );
-
-    for ( unsigned int iTest = 0; iTest != s_testCount; ++iTest )
-    {
-        const unsigned int testSize = s_testSizes [ iTest ];
-        const Int testDataOffset = static_cast< int >( offsets [ iTest ] );
-
-        VArray< Int > testArrI ( testSize );
-        VArray< Float > testArrF ( testSize );
-
-        VInt ti;
-        VFloat tf;
-
-        If ( inv.LocalId() == 0 );
-
-            // integer
-
-            For ( tmpi, 0, testSize );
-                testArrI [ tmpi ] = tmpi;
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                outGenerateBufferI [ testDataOffset + tmpi ] = testArrI [ tmpi ];
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                testArrI [ tmpi ] = 2*testArrI [ tmpi ];
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                outTransformBufferI [ testDataOffset + tmpi ] = testArrI [ tmpi ];
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                testArrI [ tmpi ] = tmpi;
-            Rof();
-
-            For ( tmpi, 0, testSize / 2 );
-                ti = testArrI [ tmpi ];
-                testArrI [ tmpi ] = testArrI [ testArrI.Size() - tmpi - 1 ];
-                testArrI [ testSize - tmpi - 1 ] = ti;
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                outReverseBufferI [ testDataOffset + tmpi ] = testArrI [ tmpi ];
-            Rof();
-
-            // float
-
-            For ( tmpi, 0, testSize );
-                testArrF [ tmpi ] = StaticCast< Float >( tmpi );
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                outGenerateBufferF [ testDataOffset + tmpi ] = testArrF [ tmpi ];
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                testArrF [ tmpi ] = 2*testArrF [ tmpi ];
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                outTransformBufferF [ testDataOffset + tmpi ] = testArrF [ tmpi ];
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                testArrF [ tmpi ] = StaticCast< Float >( tmpi );
-            Rof();
-
-            For ( tmpi, 0, testSize / 2 );
-                tf = testArrF [ tmpi ];
-                testArrF [ tmpi ] = testArrF [ testArrF.Size() - tmpi - 1 ];
-                testArrF [ testSize - tmpi - 1 ] = tf;
-            Rof();
-
-            For ( tmpi, 0, testSize );
-                outReverseBufferF [ testDataOffset + tmpi ] = testArrF [ tmpi ];
-            Rof();
-
-        Fi();
-    }
-}
-
-// -----------------------------------------------------------------------------
-
 class KLocalArraysTest :
     public vpp::Computation,
     public KLocalArraysTestTypes
@@ -4441,241 +2159,6 @@ void KLocalArraysTest :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-struct KGroupAlgorithmsTestTypes
-{
-    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer;
-    typedef vpp::format< unsigned int > FormatU32;
-
-    static void computeTestOffsets ( std::vector< unsigned int >* pOffsets );
-    static unsigned int totalTestVectorLength();
-
-    static const unsigned int s_testSizes[];
-    static const unsigned int s_testCount;
-};
-
-// -----------------------------------------------------------------------------
-
-const unsigned int KGroupAlgorithmsTestTypes :: s_testSizes[] =
-{
-    1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 17, 31, 32, 33, 63, 64, 65,
-    127, 128, 129, 255, 256, 257, 511, 512, 513, 999,
-    2047, 6000
-};
-
-// -----------------------------------------------------------------------------
-
-const unsigned int KGroupAlgorithmsTestTypes :: s_testCount =
-    sizeof ( s_testSizes ) / sizeof ( unsigned int );
-
-// -----------------------------------------------------------------------------
-
-void KGroupAlgorithmsTestTypes :: computeTestOffsets ( std::vector< unsigned int >* pOffsets )
-{
-    pOffsets->resize ( s_testCount + 1 );
-
-    unsigned int offset = 0;
-
-    for ( unsigned int i = 0; i != s_testCount; ++i )
-    {
-        ( *pOffsets )[ i ] = offset;
-        offset += s_testSizes [ i ];
-    }
-
-    ( *pOffsets )[ s_testCount ] = offset;
-}
-
-// -----------------------------------------------------------------------------
-
-unsigned int KGroupAlgorithmsTestTypes :: totalTestVectorLength()
-{
-    return std::accumulate ( s_testSizes + 0, s_testSizes + s_testCount, 0 );
-}
-
-// -----------------------------------------------------------------------------
-
-class KGroupAlgorithmsTestPipeline :
-    public vpp::ComputePipelineConfig,
-    public KGroupAlgorithmsTestTypes
-{
-public:
-    KGroupAlgorithmsTestPipeline ( const vpp::Device& hDevice );
-
-    void setData (
-        const DataBuffer& sourceView,
-        const DataBuffer& generateResultView,
-        const DataBuffer& sortResultView,
-        const DataBuffer& reduceResultView,
-        const DataBuffer& iscanResultView,
-        const DataBuffer& escanResultView,
-        const DataBuffer& lboundResultView,
-        const DataBuffer& uboundResultView,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::ioBuffer d_sourceBuffer;
-    vpp::ioBuffer d_generateResultBuffer;
-    vpp::ioBuffer d_sortResultBuffer;
-    vpp::ioBuffer d_reduceResultBuffer;
-    vpp::ioBuffer d_iscanResultBuffer;
-    vpp::ioBuffer d_escanResultBuffer;
-    vpp::ioBuffer d_lboundResultBuffer;
-    vpp::ioBuffer d_uboundResultBuffer;
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KGroupAlgorithmsTestPipeline :: KGroupAlgorithmsTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KGroupAlgorithmsTestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KGroupAlgorithmsTestPipeline :: setData (
-    const DataBuffer& sourceView,
-    const DataBuffer& generateResultView,
-    const DataBuffer& sortResultView,
-    const DataBuffer& reduceResultView,
-    const DataBuffer& iscanResultView,
-    const DataBuffer& escanResultView,
-    const DataBuffer& lboundResultView,
-    const DataBuffer& uboundResultView,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_sourceBuffer = sourceView,
-        d_generateResultBuffer = generateResultView,
-        d_sortResultBuffer = sortResultView,
-        d_reduceResultBuffer = reduceResultView,
-        d_iscanResultBuffer = iscanResultView,
-        d_escanResultBuffer = escanResultView,
-        d_lboundResultBuffer = lboundResultView,
-        d_uboundResultBuffer = uboundResultView
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-void KGroupAlgorithmsTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-    using namespace vpp::ct;
-
-    group::GroupInvocation inv ( pShader );
-
-    //pShader->DebugCodeDump();
-
-    const Int ng = pShader->inNumWorkgroups [ X ];
-    const Int nl = pShader->inWorkgroupSize [ X ];
-    const Int np = ng * nl;
-    const Int l = pShader->inLocalInvocationId [ X ];
-    const Int g = pShader->inWorkgroupId [ X ];
-
-    UniformSimpleArray< unsigned int, decltype ( d_sourceBuffer ) > inSourceBuffer ( d_sourceBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_generateResultBuffer ) > outGenerateBuffer ( d_generateResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_sortResultBuffer ) > outSortBuffer ( d_sortResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_reduceResultBuffer ) > outReduceBuffer ( d_reduceResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_iscanResultBuffer ) > outIscanBuffer ( d_iscanResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_escanResultBuffer ) > outEscanBuffer ( d_escanResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_lboundResultBuffer ) > outLboundBuffer ( d_lboundResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_uboundResultBuffer ) > outUboundBuffer ( d_uboundResultBuffer );
-
-    VUInt tmpv;
-    WArray< UInt > temporaryArr ( inv.localCount() );
-    WArray< Int > workArr ( 2 * inv.localCount() + 6 );
-
-    std::vector< unsigned int > offsets;
-    computeTestOffsets ( & offsets );
-
-    for ( unsigned int iTest = 0; iTest != s_testCount; ++iTest )
-    {
-        const unsigned int testSize = s_testSizes [ iTest ];
-        const Int testDataOffset = static_cast< int >( offsets [ iTest ] );
-
-        WArray< UInt > testArr ( testSize );
-
-        // Test Generate.
-        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx + 1 ); }, inv );
-        group::Store ( testArr, outGenerateBuffer, testDataOffset, inv );
-
-        // Test Reduce and Fill
-        const UInt red = group::Reduce (
-            testArr, []( const UInt& v1, const UInt& v2 ){ return v1 + v2; },
-            tmpv, temporaryArr, inv );
-
-        group::Fill ( testArr, red, inv );
-        group::Store ( testArr, outReduceBuffer, testDataOffset, inv );
-
-        // Test InclusiveScan
-        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx + 1 ); }, inv );
-        
-        group::InclusiveScan (
-            testArr, []( const UInt& v1, const UInt& v2 ){ return v1 + v2; },
-            tmpv, temporaryArr, inv );
-
-        group::Store ( testArr, outIscanBuffer, testDataOffset, inv );
-
-        // Test ExclusiveScan
-        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx + 1 ); }, inv );
-        
-        group::ExclusiveScan (
-            testArr, []( const UInt& v1, const UInt& v2 ){ return v1 + v2; },
-            tmpv, temporaryArr, inv );
-
-        group::Store ( testArr, outEscanBuffer, testDataOffset, inv );
-
-        // Test Sort.
-
-        group::Load ( inSourceBuffer, testDataOffset, testArr, inv );
-
-        group::Sort (
-            testArr, []( const UInt& i1, const UInt& i2 ){ return i1 < i2; },
-            inv );
-
-        group::Store ( testArr, outSortBuffer, testDataOffset, inv );
-
-        // Test LowerBound
-        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx ); }, inv );
-
-        For ( tmpv, 0u, StaticCast< UInt >( testArr.Size() ) );
-        {
-            const Int idx = group::LowerBound (
-                testArr, UInt ( tmpv ),
-                []( const UInt& l, const UInt& r ){ return l < r; },
-                workArr, inv );
-
-            If ( l == 0 );
-                outLboundBuffer [ StaticCast< UInt >( testDataOffset ) + tmpv ] = StaticCast< UInt >( idx );
-            Fi();
-        }
-        Rof();
-
-        // Test UpperBound
-        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx ); }, inv );
-
-        For ( tmpv, 0u, StaticCast< UInt >( testArr.Size() ) );
-        {
-            const Int idx = group::UpperBound (
-                testArr, UInt ( tmpv ),
-                []( const UInt& l, const UInt& r ){ return l < r; },
-                workArr, inv );
-
-            If ( l == 0 );
-                outUboundBuffer [ StaticCast< UInt >( testDataOffset ) + tmpv ] = StaticCast< UInt >( idx );
-            Fi();
-        }
-        Rof();
-    }
-
-    const unsigned int totalMemory = pShader->getTotalWorkgroupMemory();
-    const unsigned int freeMemory = pShader->getFreeWorkgroupMemory();
-}
-
-// -----------------------------------------------------------------------------
-
 class KGroupAlgorithmsTest :
     public vpp::Computation,
     public KGroupAlgorithmsTestTypes
@@ -4900,219 +2383,25 @@ void KGroupAlgorithmsTest :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-struct KGroupAlgorithms2TestTypes
+class KGroupAlgorithms2Test :
+    public vpp::Computation,
+    public KGroupAlgorithms2TestTypes
 {
-    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer;
-    typedef vpp::format< unsigned int > FormatU32;
-
-    static void computeTestOffsets ( std::vector< unsigned int >* pOffsets );
-    static unsigned int totalTestVectorLength();
+public:
+    KGroupAlgorithms2Test ( vpp::Computation& pred, const vpp::Device& hDevice );
 
-    static const unsigned int s_testSizesCols[];
-    static const unsigned int s_testSizesRows[];
-    static const unsigned int s_testCount;
-};
+    void prepareTestVectors();
+    void compareResults();
 
-// -----------------------------------------------------------------------------
+private:
+    vpp::ComputePipelineLayout< KGroupAlgorithms2TestPipeline > d_pipeline;
+    vpp::ShaderDataBlock d_dataBlock;
 
-const unsigned int KGroupAlgorithms2TestTypes :: s_testSizesCols[] =
-{
-    1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 16, 16, 17, 17, 31, 31, 
-    32, 32, 33, 33, 41
-};
-
-// -----------------------------------------------------------------------------
-
-const unsigned int KGroupAlgorithms2TestTypes :: s_testSizesRows[] =
-{
-    1, 1, 2, 3, 2, 4, 5, 5, 4, 6, 5, 7, 8, 8, 7, 9, 6, 16, 15, 17, 18, 31, 30, 
-    32, 11, 33, 34, 41
-};
-
-// -----------------------------------------------------------------------------
-
-static_assert (
-    sizeof ( KGroupAlgorithms2TestTypes::s_testSizesCols ) == sizeof ( KGroupAlgorithms2TestTypes::s_testSizesRows ),
-    "sizeof ( s_testSizesCols )" );
-
-// -----------------------------------------------------------------------------
-
-const unsigned int KGroupAlgorithms2TestTypes :: s_testCount =
-    sizeof ( s_testSizesCols ) / sizeof ( unsigned int );
-
-// -----------------------------------------------------------------------------
-
-void KGroupAlgorithms2TestTypes :: computeTestOffsets ( std::vector< unsigned int >* pOffsets )
-{
-    pOffsets->resize ( s_testCount + 1 );
-
-    unsigned int offset = 0;
-
-    for ( unsigned int i = 0; i != s_testCount; ++i )
-    {
-        ( *pOffsets )[ i ] = offset;
-        offset += s_testSizesCols [ i ] * s_testSizesRows [ i ];
-    }
-
-    ( *pOffsets )[ s_testCount ] = offset;
-}
-
-// -----------------------------------------------------------------------------
-
-unsigned int KGroupAlgorithms2TestTypes :: totalTestVectorLength()
-{
-    unsigned int offset = 0;
-
-    for ( unsigned int i = 0; i != s_testCount; ++i )
-        offset += s_testSizesCols [ i ] * s_testSizesRows [ i ];
-
-    return offset;
-}
-
-// -----------------------------------------------------------------------------
-
-class KGroupAlgorithms2TestPipeline :
-    public vpp::ComputePipelineConfig,
-    public KGroupAlgorithms2TestTypes
-{
-public:
-    KGroupAlgorithms2TestPipeline ( const vpp::Device& hDevice );
-
-    void setData (
-        const DataBuffer& fillResultView,
-        const DataBuffer& generateResultView,
-        const DataBuffer& generate2ResultView,
-        const DataBuffer& sortResultView,
-        vpp::ShaderDataBlock* pDataBlock );
-
-    void fComputeShader ( vpp::ComputeShader* pShader );
-
-public:
-    vpp::ioBuffer d_fillResultBuffer;
-    vpp::ioBuffer d_generateResultBuffer;
-    vpp::ioBuffer d_generate2ResultBuffer;
-    vpp::ioBuffer d_sortResultBuffer;
-    vpp::computeShader d_shader;
-};
-
-// -----------------------------------------------------------------------------
-
-KGroupAlgorithms2TestPipeline :: KGroupAlgorithms2TestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KGroupAlgorithms2TestPipeline::fComputeShader )
-{
-}
-
-// -----------------------------------------------------------------------------
-
-void KGroupAlgorithms2TestPipeline :: setData (
-    const DataBuffer& fillResultView,
-    const DataBuffer& generateResultView,
-    const DataBuffer& generate2ResultView,
-    const DataBuffer& sortResultView,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_fillResultBuffer = fillResultView,
-        d_generateResultBuffer = generateResultView,
-        d_generate2ResultBuffer = generate2ResultView,
-        d_sortResultBuffer = sortResultView
-    ));
-}
-
-// -----------------------------------------------------------------------------
-
-void KGroupAlgorithms2TestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
-{
-    using namespace vpp;
-    using namespace vpp::ct;
-
-    group::GroupInvocation inv ( pShader );
-
-    //pShader->DebugCodeDump();
-
-    const Int ng = pShader->inNumWorkgroups [ X ];
-    const Int nl = pShader->inWorkgroupSize [ X ];
-    const Int np = ng * nl;
-    const Int l = pShader->inLocalInvocationId [ X ];
-    const Int g = pShader->inWorkgroupId [ X ];
-
-    UniformSimpleArray< unsigned int, decltype ( d_fillResultBuffer ) > outFillBuffer ( d_fillResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_generateResultBuffer ) > outGenerateBuffer ( d_generateResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_generate2ResultBuffer ) > outGenerate2Buffer ( d_generate2ResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_sortResultBuffer ) > outSortBuffer ( d_sortResultBuffer );
-
-    VUInt tmpv;
-
-    std::vector< unsigned int > offsets;
-    computeTestOffsets ( & offsets );
-
-    for ( unsigned int iTest = 0; iTest != s_testCount; ++iTest )
-    {
-        const unsigned int testRows = s_testSizesRows [ iTest ];
-        const unsigned int testCols = s_testSizesCols [ iTest ];
-        const unsigned int testSize = testRows * testCols;
-        const Int testDataOffset = static_cast< int >( offsets [ iTest ] );
-
-        WArray2< UInt > testArr ( s_testSizesRows [ iTest ], s_testSizesCols [ iTest ] );
-
-        // Test Fill.
-        group::Fill ( testArr, UInt(testSize), inv );
-        group::Store ( testArr, outFillBuffer, false, testDataOffset, inv );
-
-        // Test Generate.
-        group::Generate (
-            testArr, []( const Int& row, const Int& col )
-            {
-                return StaticCast< UInt >( ( row << 16 ) | col ); 
-            }, inv
-        );
-
-        group::Store ( testArr, outGenerateBuffer, false, testDataOffset, inv );
-        group::Store ( testArr, outGenerate2Buffer, true, testDataOffset, inv );
-
-        // Test Sort
-        group::Generate (
-            testArr, [ testCols ]( const Int& row, const Int& col )
-            {
-                return StaticCast< UInt >( testCols - col ); 
-            }, inv
-        );
-
-        For ( tmpv, 0, testRows );
-        {
-            WArray< UInt > row = testArr [ tmpv ];
-
-            group::Sort (
-                row, []( const UInt& lhs, const UInt& rhs ){ return lhs < rhs; },
-                inv );
-        }
-        Rof();
-
-        group::Store ( testArr, outSortBuffer, false, testDataOffset, inv );
-    }
-}
-
-// -----------------------------------------------------------------------------
-
-class KGroupAlgorithms2Test :
-    public vpp::Computation,
-    public KGroupAlgorithms2TestTypes
-{
-public:
-    KGroupAlgorithms2Test ( vpp::Computation& pred, const vpp::Device& hDevice );
-
-    void prepareTestVectors();
-    void compareResults();
-
-private:
-    vpp::ComputePipelineLayout< KGroupAlgorithms2TestPipeline > d_pipeline;
-    vpp::ShaderDataBlock d_dataBlock;
-
-    const unsigned int d_testBuffersLength;
-    DataBuffer d_fillResultBuffer;
-    DataBuffer d_generateResultBuffer;
-    DataBuffer d_generate2ResultBuffer;
-    DataBuffer d_sortResultBuffer;
+    const unsigned int d_testBuffersLength;
+    DataBuffer d_fillResultBuffer;
+    DataBuffer d_generateResultBuffer;
+    DataBuffer d_generate2ResultBuffer;
+    DataBuffer d_sortResultBuffer;
 };
 
 // -----------------------------------------------------------------------------
@@ -5259,1035 +2548,1851 @@ void KGroupAlgorithms2Test :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-struct KGroupVariablesTestTypes
-{
-    typedef vpp::gvector< int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferI;
-    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferU;
-    typedef vpp::gvector< float, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferF;
-    typedef vpp::gvector< double, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferD;
-};
-
-// -----------------------------------------------------------------------------
-
-class KGroupVariablesTestPipeline :
-    public vpp::ComputePipelineConfig,
+class KGroupVariablesTest :
+    public vpp::Computation,
     public KGroupVariablesTestTypes
 {
 public:
-    KGroupVariablesTestPipeline ( const vpp::Device& hDevice );
-
-    void setData (
-        const DataBufferI& intResultView,
-        const DataBufferU& uintResultView,
-        const DataBufferF& floatResultView,
-        const DataBufferD& doubleResultView,
-        const DataBufferI& groupResultView,
-        vpp::ShaderDataBlock* pDataBlock );
+    KGroupVariablesTest ( vpp::Computation& pred, const vpp::Device& hDevice );
 
-    void fComputeShader ( vpp::ComputeShader* pShader );
+    void prepareTestVectors();
+    void compareResults();
 
 private:
-    void setVariable ( vpp::WBool& var, int value );
-
-    template< typename ScalarT >
-    void setVariable ( vpp::TLValue< ScalarT, spv::StorageClassWorkgroup >& var, int value );
-
-    template< size_t SIZE >
-    void setVariableB ( vpp::TLVector< vpp::Bool, SIZE, spv::StorageClassWorkgroup >& var, int value );
-
-    template< typename BaseT >
-    void setVariable ( vpp::TLVector< BaseT, 2, spv::StorageClassWorkgroup >& var, int value );
-
-    template< typename BaseT >
-    void setVariable ( vpp::TLVector< BaseT, 3, spv::StorageClassWorkgroup >& var, int value );
-
-    template< typename BaseT >
-    void setVariable ( vpp::TLVector< BaseT, 4, spv::StorageClassWorkgroup >& var, int value );
-
-    template< typename BaseT, size_t COLS, size_t ROWS  >
-    void setVariable ( const vpp::TLMatrix< BaseT, COLS, ROWS, spv::StorageClassWorkgroup >& var, int value );
-
-    void storeVariable ( const vpp::Bool& v );
-    void storeVariable ( const vpp::Int& v );
-    void storeVariable ( const vpp::UInt& v );
-    void storeVariable ( const vpp::Float& v );
-    void storeVariable ( const vpp::Double& v );
-
-    template< typename BaseT, size_t SIZE >
-    void storeVariable ( const vpp::TLVector< BaseT, SIZE, spv::StorageClassWorkgroup >& var );
+    vpp::ComputePipelineLayout< KGroupVariablesTestPipeline > d_pipeline;
+    vpp::ShaderDataBlock d_dataBlock;
 
-    template< typename BaseT, size_t COLS, size_t ROWS >
-    void storeVariable ( const vpp::TLMatrix< BaseT, COLS, ROWS, spv::StorageClassWorkgroup >& var );
+    static const unsigned int s_bufferSize = 1024;
 
-public:
-    vpp::ioBuffer d_intResultBuffer;
-    vpp::ioBuffer d_uintResultBuffer;
-    vpp::ioBuffer d_floatResultBuffer;
-    vpp::ioBuffer d_doubleResultBuffer;
-    vpp::ioBuffer d_groupResultBuffer;
-    vpp::computeShader d_shader;
-
-    unsigned int d_intResultBufferOffset;
-    unsigned int d_uintResultBufferOffset;
-    unsigned int d_floatResultBufferOffset;
-    unsigned int d_doubleResultBufferOffset;
-
-    typedef vpp::UniformSimpleArray< int, decltype ( d_intResultBuffer ) > OutIntBuffer;
-    typedef vpp::UniformSimpleArray< unsigned int, decltype ( d_uintResultBuffer ) > OutUIntBuffer;
-    typedef vpp::UniformSimpleArray< float, decltype ( d_floatResultBuffer ) > OutFloatBuffer;
-    typedef vpp::UniformSimpleArray< double, decltype ( d_doubleResultBuffer ) > OutDoubleBuffer;
-
-    OutIntBuffer* d_pOutIntBuffer;
-    OutUIntBuffer* d_pOutUIntBuffer;
-    OutFloatBuffer* d_pOutFloatBuffer;
-    OutDoubleBuffer* d_pOutDoubleBuffer;
+    DataBufferI d_intResultBuffer;
+    DataBufferU d_uintResultBuffer;
+    DataBufferF d_floatResultBuffer;
+    DataBufferD d_doubleResultBuffer;
+    DataBufferI d_groupResultBuffer;
 };
 
 // -----------------------------------------------------------------------------
 
-KGroupVariablesTestPipeline :: KGroupVariablesTestPipeline ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KGroupVariablesTestPipeline::fComputeShader ),
-    d_intResultBufferOffset ( 0 ),
-    d_uintResultBufferOffset ( 0 ),
-    d_floatResultBufferOffset ( 0 ),
-    d_doubleResultBufferOffset ( 0 ),
-    d_pOutIntBuffer ( 0 ),
-    d_pOutUIntBuffer ( 0 ),
-    d_pOutFloatBuffer ( 0 ),
-    d_pOutDoubleBuffer ( 0 )
+KGroupVariablesTest :: KGroupVariablesTest ( vpp::Computation& pred, const vpp::Device& hDevice ) :
+    vpp::Computation ( pred ),
+    d_pipeline ( hDevice ),
+    d_dataBlock ( d_pipeline ),
+    d_intResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_uintResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_floatResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_doubleResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_groupResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice )
 {
-}
+    using namespace vpp;
 
-// -----------------------------------------------------------------------------
+    d_pipeline.definition().setData (
+        d_intResultBuffer,
+        d_uintResultBuffer,
+        d_floatResultBuffer,
+        d_doubleResultBuffer,
+        d_groupResultBuffer,
+        & d_dataBlock );
 
-void KGroupVariablesTestPipeline :: setData (
-    const DataBufferI& intResultView,
-    const DataBufferU& uintResultView,
-    const DataBufferF& floatResultView,
-    const DataBufferD& doubleResultView,
-    const DataBufferI& groupResultView,
-    vpp::ShaderDataBlock* pDataBlock )
-{
-    pDataBlock->update ((
-        d_intResultBuffer = intResultView,
-        d_uintResultBuffer = uintResultView,
-        d_floatResultBuffer = floatResultView,
-        d_doubleResultBuffer = doubleResultView,
-        d_groupResultBuffer = groupResultView
-    ));
-}
+    addPipeline ( d_pipeline );
 
-// -----------------------------------------------------------------------------
+    ( *this ) << [ this ]()
+    {
+        d_dataBlock.cmdBind();
+        pipeline ( 0 ).cmdBind();
+        cmdDispatch ( 1, 1, 1 );
 
-void KGroupVariablesTestPipeline :: setVariable (
-    vpp::WBool& var, int value )
-{
-    var = ( value != 0 );
-}
+        cmdPipelineBarrier ( barriers (
+            Bar::COMPUTE, Bar::TRANSFER,
+            d_intResultBuffer, d_uintResultBuffer, d_floatResultBuffer, d_doubleResultBuffer,
+            d_groupResultBuffer
+        ) );
 
-// -----------------------------------------------------------------------------
+        d_intResultBuffer.cmdLoadAll();
+        d_uintResultBuffer.cmdLoadAll();
+        d_floatResultBuffer.cmdLoadAll();
+        d_doubleResultBuffer.cmdLoadAll();
+        d_groupResultBuffer.cmdLoadAll();
+    };
 
-template< typename ScalarT >
-void KGroupVariablesTestPipeline :: setVariable (
-    vpp::TLValue< ScalarT, spv::StorageClassWorkgroup >& var, int value )
-{
-    var = static_cast< ScalarT >( value );
+    prepareTestVectors();
 }
 
 // -----------------------------------------------------------------------------
 
-template< size_t SIZE >
-void KGroupVariablesTestPipeline :: setVariableB (
-    vpp::TLVector< vpp::Bool, SIZE, spv::StorageClassWorkgroup >& var, int value )
+void KGroupVariablesTest :: prepareTestVectors()
 {
-    using namespace vpp;
+    d_intResultBuffer.resize ( s_bufferSize );
+    d_uintResultBuffer.resize ( s_bufferSize );
+    d_floatResultBuffer.resize ( s_bufferSize );
+    d_doubleResultBuffer.resize ( s_bufferSize );
+    d_groupResultBuffer.resize ( s_bufferSize );
 
-    for ( size_t i = 0; i != SIZE; ++i )
+    for ( unsigned int j = 0; j != s_bufferSize; ++j )
     {
-        const UInt idx = static_cast< unsigned int >( i );
-        var [ idx ] = ( value != 0 );
+        d_intResultBuffer [ j ] = 0;
+        d_uintResultBuffer [ j ] = 0;
+        d_floatResultBuffer [ j ] = 0;
+        d_doubleResultBuffer [ j ] = 0;
+        d_groupResultBuffer [ j ] = 0;
     }
-}
-
-// -----------------------------------------------------------------------------
 
-template< typename BaseT >
-void KGroupVariablesTestPipeline :: setVariable (
-    vpp::TLVector< BaseT, 2, spv::StorageClassWorkgroup >& var, int value )
-{
-    using namespace vpp;
-    typedef typename BaseT::scalar_type ScalarT;
-    var [ X ] = static_cast< ScalarT >( value );
-    var [ Y ] = static_cast< ScalarT >( value );
+    d_intResultBuffer.commitAndWait();
+    d_uintResultBuffer.commitAndWait();
+    d_floatResultBuffer.commitAndWait();
+    d_doubleResultBuffer.commitAndWait();
+    d_groupResultBuffer.commitAndWait();
 }
 
 // -----------------------------------------------------------------------------
 
-template< typename BaseT >
-void KGroupVariablesTestPipeline :: setVariable (
-    vpp::TLVector< BaseT, 3, spv::StorageClassWorkgroup >& var, int value )
+void KGroupVariablesTest :: compareResults()
 {
-    using namespace vpp;
-    typedef typename BaseT::scalar_type ScalarT;
-    var [ X ] = static_cast< ScalarT >( value );
-    var [ Y ] = static_cast< ScalarT >( value );
-    var [ Z ] = static_cast< ScalarT >( value );
-}
-
-// -----------------------------------------------------------------------------
+    std::vector< int > intValues ( d_intResultBuffer.begin(), d_intResultBuffer.end() );
+    std::vector< unsigned int > uintValues ( d_uintResultBuffer.begin(), d_uintResultBuffer.end() );
+    std::vector< float > floatValues ( d_floatResultBuffer.begin(), d_floatResultBuffer.end() );
+    std::vector< double > doubleValues ( d_doubleResultBuffer.begin(), d_doubleResultBuffer.end() );
+    std::vector< int > groupValues ( d_groupResultBuffer.begin(), d_groupResultBuffer.end() );
 
-template< typename BaseT >
-void KGroupVariablesTestPipeline :: setVariable (
-    vpp::TLVector< BaseT, 4, spv::StorageClassWorkgroup >& var, int value )
-{
-    using namespace vpp;
-    typedef typename BaseT::scalar_type ScalarT;
-    var [ X ] = static_cast< ScalarT >( value );
-    var [ Y ] = static_cast< ScalarT >( value );
-    var [ Z ] = static_cast< ScalarT >( value );
-    var [ W ] = static_cast< ScalarT >( value );
-}
+    const unsigned int intSize = d_pipeline.definition().d_intResultBufferOffset;
+    const unsigned int uintSize = d_pipeline.definition().d_uintResultBufferOffset;
+    const unsigned int floatSize = d_pipeline.definition().d_floatResultBufferOffset;
+    const unsigned int doubleSize = d_pipeline.definition().d_doubleResultBufferOffset;
 
-// -----------------------------------------------------------------------------
+    for ( unsigned int i = 0; i != intSize; ++i )
+    {
+        const int v = intValues [ i ];
+        check ( v == 1 );
+    }
 
-template< typename BaseT, size_t COLS, size_t ROWS  >
-void KGroupVariablesTestPipeline :: setVariable (
-    const vpp::TLMatrix< BaseT, COLS, ROWS, spv::StorageClassWorkgroup >& var, int value )
-{
-    using namespace vpp;
-    typedef typename BaseT::scalar_type ScalarT;
+    for ( unsigned int i = 0; i != uintSize; ++i )
+    {
+        const unsigned int v = uintValues [ i ];
+        check ( v == 1u );
+    }
 
-    for ( size_t r = 0; r != ROWS; ++r )
-        for ( size_t c = 0; c != COLS; ++c )
+    for ( unsigned int i = 0; i != floatSize; ++i )
     {
-        const UInt irow = static_cast< unsigned int >( r );
-        const UInt icol = static_cast< unsigned int >( c );
-        var [ icol ][ irow ] = static_cast< ScalarT >( value );
+        const float v = floatValues [ i ];
+        check ( v == 1.0f );
     }
-}
 
-// -----------------------------------------------------------------------------
+    for ( unsigned int i = 0; i != doubleSize; ++i )
+    {
+        const double v = doubleValues [ i ];
+        check ( v == 1.0 );
+    }
 
-void KGroupVariablesTestPipeline :: storeVariable ( const vpp::Bool& v )
-{
-    ( *d_pOutIntBuffer ) [ d_intResultBufferOffset++ ] = Select ( v, 1, 0 );
-}
+    for ( unsigned int i = 0; i != 20; ++i )
+    {
+        const double v = groupValues [ i ];
+        check ( v == 17 );
+    }
 
-// -----------------------------------------------------------------------------
+    for ( unsigned int i = 0; i != 10; ++i )
+    {
+        const double v = groupValues [ 20 + i ];
+        check ( v == (100-i) );
+    }
 
-void KGroupVariablesTestPipeline :: storeVariable ( const vpp::Int& v )
-{
-    ( *d_pOutIntBuffer ) [ d_intResultBufferOffset++ ] = v;
+    for ( unsigned int i = 0; i != 10; ++i )
+    {
+        const double v = groupValues [ 30 + i ];
+        check ( v == 182 + 2*i );
+    }
+
+    for ( unsigned int i = 0; i != 10; ++i )
+    {
+        const double v = groupValues [ 40 + i ];
+        check ( v == 1 );
+    }
+
+    for ( unsigned int i = 0; i != 10; ++i )
+    {
+        const double v = groupValues [ 50 + i ];
+        check ( v == 2 );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                 Atomics tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KAtomicsTest :
+    public vpp::Computation,
+    public KAtomicsTestTypes
+{
+public:
+    KAtomicsTest ( vpp::Computation& pred, const vpp::Device& hDevice );
+
+    void compareResults();
+
+private:
+    vpp::ComputePipelineLayout< KAtomicsTestPipeline1 > d_pipeline;
+    vpp::ShaderDataBlock d_dataBlock;
+
+    DataBuffer d_resultBuffer;
+    DataBuffer d_testBuffer;
+    DataBuffer64 d_testBuffer64;
+    TestImage d_testImage;
+    TestImageView d_testImageView;
+};
+
+// -----------------------------------------------------------------------------
+
+KAtomicsTest :: KAtomicsTest ( vpp::Computation& pred, const vpp::Device& hDevice ) :
+    vpp::Computation ( pred ),
+    d_pipeline ( hDevice ),
+    d_dataBlock ( d_pipeline ),
+    d_resultBuffer ( TEST_COUNT*BLOCK_SIZE, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_testBuffer ( 16, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_testBuffer64 ( 16, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_testImage ( { 256, 1, 1 }, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_testImageView ( d_testImage )
+{
+    using namespace vpp;
+
+    d_pipeline.definition().setData (
+        d_resultBuffer, d_testBuffer, d_testBuffer64,
+        d_testImageView, & d_dataBlock );
+
+    addPipeline ( d_pipeline );
+
+    d_resultBuffer.resize ( TEST_COUNT*BLOCK_SIZE );
+
+    ( *this ) << [ this ]()
+    {
+        cmdFillBuffer ( d_resultBuffer, 0, TEST_COUNT*BLOCK_SIZE*sizeof ( unsigned int ), 0 );
+        cmdFillBuffer ( d_testBuffer, 0, 16*sizeof ( unsigned int ), 0 );
+        cmdFillBuffer ( d_testBuffer64, 0, 16*sizeof ( std::uint64_t ), 0 );
+        cmdClearColorImage ( d_testImage, clearColor ( 0, 0, 0 ) );
+
+        cmdPipelineBarrier ( barriers (
+            Bar::TRANSFER, Bar::COMPUTE,
+            d_resultBuffer, d_testBuffer, d_testBuffer64, d_testImage ) );
+
+        d_dataBlock.cmdBind();
+        pipeline ( 0 ).cmdBind();
+        cmdDispatch ( 64, 1, 1 );
+
+        cmdPipelineBarrier ( barriers (
+            Bar::COMPUTE, Bar::TRANSFER, 
+            d_resultBuffer ) );
+
+        d_resultBuffer.cmdLoadAll();
+    };
+}
+
+// -----------------------------------------------------------------------------
+
+void KAtomicsTest :: compareResults()
+{
+    std::vector< unsigned int > values ( d_resultBuffer.begin(), d_resultBuffer.end() );
+
+    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
+        check ( values [ i ] == static_cast< unsigned int >( i < 20480 ) );
+
+    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
+        check ( values [ i + BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+
+    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
+        check ( values [ i + 2*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+
+    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
+        check ( values [ i + 3*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+
+    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
+        check ( values [ i + 4*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+
+    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
+        check ( values [ i + 5*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+
+    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
+        check ( values [ i + 6*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+
+    //for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
+    //    check ( values [ i + 7*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                            Descriptor update tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KDescriptorUpdateTest :
+    public vpp::Computation,
+    public KDescriptorUpdateTestTypes
+{
+public:
+    KDescriptorUpdateTest ( vpp::Computation& pred, const vpp::Device& hDevice );
+
+    void compareResults();
+
+private:
+    vpp::ComputePipelineLayout< KDescriptorUpdateTestPipeline > d_pipeline;
+    vpp::ShaderDataBlock d_dataBlock;
+
+    DataBuffer d_firstBuffer;
+    DataBuffer d_secondBuffer;
+};
+
+// -----------------------------------------------------------------------------
+
+KDescriptorUpdateTest :: KDescriptorUpdateTest ( vpp::Computation& pred, const vpp::Device& hDevice ) :
+    vpp::Computation ( pred ),
+    d_pipeline ( hDevice ),
+    d_dataBlock ( d_pipeline ),
+    d_firstBuffer ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_secondBuffer ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice )
+{
+    using namespace vpp;
+
+    // Two single-binding updates of the same type on one block. The second
+    // one must not reuse the update template compiled for the first binding.
+
+    d_pipeline.definition().setFirstBuffer ( d_firstBuffer, & d_dataBlock );
+    d_pipeline.definition().setSecondBuffer ( d_secondBuffer, & d_dataBlock );
+
+    addPipeline ( d_pipeline );
+
+    d_firstBuffer.resize ( BUFFER_LENGTH );
+    d_secondBuffer.resize ( BUFFER_LENGTH );
+
+    ( *this ) << [ this ]()
+    {
+        cmdFillBuffer ( d_firstBuffer, 0, BUFFER_LENGTH*sizeof ( unsigned int ), 0 );
+        cmdFillBuffer ( d_secondBuffer, 0, BUFFER_LENGTH*sizeof ( unsigned int ), 0 );
+
+        cmdPipelineBarrier ( barriers (
+            Bar::TRANSFER, Bar::COMPUTE,
+            d_firstBuffer, d_secondBuffer ) );
+
+        d_dataBlock.cmdBind();
+        pipeline ( 0 ).cmdBind();
+        cmdDispatch ( 1, 1, 1 );
+
+        cmdPipelineBarrier ( barriers (
+            Bar::COMPUTE, Bar::TRANSFER,
+            d_firstBuffer, d_secondBuffer ) );
+
+        d_firstBuffer.cmdLoadAll();
+        d_secondBuffer.cmdLoadAll();
+    };
+}
+
+// -----------------------------------------------------------------------------
+
+void KDescriptorUpdateTest :: compareResults()
+{
+    for ( unsigned int i = 0; i != BUFFER_LENGTH; ++i )
+    {
+        check ( d_firstBuffer [ i ] == i + 1 );
+        check ( d_secondBuffer [ i ] == i + 1001 );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                        Matrix multiplication and convolution
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KMatrixOperationsTest : public vpp::Computation
+{
+public:
+    KMatrixOperationsTest ( vpp::Computation& pred, const vpp::Device& hDevice );
+
+    void prepareVectors();
+    void compareResults();
+
+private:
+    // Sizes are not multiples of the tile sizes, so that the edge tiles
+    // are only partially covered.
+
+    static const std::uint32_t M = 45;
+    static const std::uint32_t N = 37;
+    static const std::uint32_t K = 19;
+    static const std::uint32_t BATCH_COUNT = 3;
+
+    static const std::uint32_t IMAGE_HEIGHT = 29;
+    static const std::uint32_t IMAGE_WIDTH = 23;
+    static const std::uint32_t IMAGE_COUNT = 2;
+    static const int KERNEL_SIZE = 5;
+
+    static const int GEMM_TILE = 32;
+    static const int CONVOLUTION_TILE = 16;
+
+    typedef vpp::TMatrixMultiplyPipeline< float, GEMM_TILE, GEMM_TILE, 16, 4 > MultiplyPipeline;
+
+    typedef vpp::TConvolutionPipeline<
+        float, KERNEL_SIZE, KERNEL_SIZE, false, CONVOLUTION_TILE, CONVOLUTION_TILE > ConvolutionPipeline;
+
+    typedef vpp::TConvolutionPipeline<
+        float, KERNEL_SIZE, KERNEL_SIZE, true, CONVOLUTION_TILE, CONVOLUTION_TILE > SeparableConvolutionPipeline;
+
+    typedef vpp::gvector< float, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > FloatVector;
+
+    vpp::ComputePipelineLayout< MultiplyPipeline > d_multiply;
+    vpp::ComputePipelineLayout< ConvolutionPipeline > d_convolution;
+    vpp::ComputePipelineLayout< SeparableConvolutionPipeline > d_separableConvolution;
+    vpp::ShaderDataBlock d_multiplyDataBlock;
+    vpp::ShaderDataBlock d_convolutionDataBlock;
+    vpp::ShaderDataBlock d_separableConvolutionDataBlock;
+
+    FloatVector d_a;
+    FloatVector d_b;
+    FloatVector d_c;
+
+    FloatVector d_image;
+    FloatVector d_weights;
+    FloatVector d_separableWeights;
+    FloatVector d_filtered;
+    FloatVector d_separableFiltered;
+};
+
+// -----------------------------------------------------------------------------
+
+KMatrixOperationsTest :: KMatrixOperationsTest ( vpp::Computation& pred, const vpp::Device& hDevice ) :
+    vpp::Computation ( pred ),
+    d_multiply ( hDevice ),
+    d_convolution ( hDevice ),
+    d_separableConvolution ( hDevice ),
+    d_multiplyDataBlock ( d_multiply ),
+    d_convolutionDataBlock ( d_convolution ),
+    d_separableConvolutionDataBlock ( d_separableConvolution ),
+    d_a ( BATCH_COUNT*M*K, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_b ( BATCH_COUNT*K*N, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_c ( BATCH_COUNT*M*N, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_image ( IMAGE_COUNT*IMAGE_HEIGHT*IMAGE_WIDTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_weights ( KERNEL_SIZE*KERNEL_SIZE, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_separableWeights ( 2*KERNEL_SIZE, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_filtered ( IMAGE_COUNT*IMAGE_HEIGHT*IMAGE_WIDTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_separableFiltered ( IMAGE_COUNT*IMAGE_HEIGHT*IMAGE_WIDTH, vpp::MemProfile::DEVICE_STATIC, hDevice )
+{
+    using namespace vpp;
+
+    d_multiply.definition().setData (
+        d_a, d_b, d_c, & d_multiplyDataBlock );
+
+    d_convolution.definition().setData (
+        d_image, d_weights, d_filtered, & d_convolutionDataBlock );
+
+    d_separableConvolution.definition().setData (
+        d_image, d_separableWeights, d_separableFiltered, & d_separableConvolutionDataBlock );
+
+    addPipeline ( d_multiply );
+    addPipeline ( d_convolution );
+    addPipeline ( d_separableConvolution );
+
+    prepareVectors();
+
+    ( *this ) << [ this ]()
+    {
+        d_a.cmdCommit();
+        d_b.cmdCommit();
+        d_c.cmdCommit();
+        d_image.cmdCommit();
+        d_weights.cmdCommit();
+        d_separableWeights.cmdCommit();
+        d_filtered.cmdCommit();
+        d_separableFiltered.cmdCommit();
+
+        cmdPipelineBarrier ( barriers (
+            Bar::TRANSFER, Bar::COMPUTE,
+            d_a, d_b, d_c, d_image, d_weights, d_separableWeights,
+            d_filtered, d_separableFiltered ) );
+
+        d_multiplyDataBlock.cmdBind();
+        pipeline ( 0 ).cmdBind();
+        d_multiply.definition().cmdPushSize ( M, N, K );
+
+        cmdDispatch (
+            ( N + GEMM_TILE - 1 ) / GEMM_TILE, ( M + GEMM_TILE - 1 ) / GEMM_TILE,
+            BATCH_COUNT );
+
+        const std::uint32_t tilesX = ( IMAGE_WIDTH + CONVOLUTION_TILE - 1 ) / CONVOLUTION_TILE;
+        const std::uint32_t tilesY = ( IMAGE_HEIGHT + CONVOLUTION_TILE - 1 ) / CONVOLUTION_TILE;
+
+        d_convolutionDataBlock.cmdBind();
+        pipeline ( 1 ).cmdBind();
+        d_convolution.definition().cmdPushSize ( IMAGE_HEIGHT, IMAGE_WIDTH );
+        cmdDispatch ( tilesX, tilesY, IMAGE_COUNT );
+
+        d_separableConvolutionDataBlock.cmdBind();
+        pipeline ( 2 ).cmdBind();
+        d_separableConvolution.definition().cmdPushSize ( IMAGE_HEIGHT, IMAGE_WIDTH );
+        cmdDispatch ( tilesX, tilesY, IMAGE_COUNT );
+
+        cmdPipelineBarrier ( barriers (
+            Bar::COMPUTE, Bar::TRANSFER,
+            d_c, d_filtered, d_separableFiltered ) );
+
+        d_c.cmdLoadAll();
+        d_filtered.cmdLoadAll();
+        d_separableFiltered.cmdLoadAll();
+    };
+}
+
+// -----------------------------------------------------------------------------
+
+void KMatrixOperationsTest :: prepareVectors()
+{
+    unsigned int r = 17;
+
+    const auto fillRandom = [ & r ]( FloatVector* pVector, size_t size )
+    {
+        pVector->resize ( size );
+
+        for ( size_t i = 0; i != size; ++i )
+        {
+            ( *pVector )[ i ] = static_cast< float >( r % 1024 ) / 1024.0f - 0.5f;
+            r = 69069 * r + 1;
+        }
+    };
+
+    // Results are filled with a value no kernel can produce, so that items
+    // skipped in edge tiles are detected.
+
+    const auto fillResult = []( FloatVector* pVector, size_t size )
+    {
+        pVector->resize ( size );
+
+        for ( size_t i = 0; i != size; ++i )
+            ( *pVector )[ i ] = 1000.0f;
+    };
+
+    fillRandom ( & d_a, BATCH_COUNT*M*K );
+    fillRandom ( & d_b, BATCH_COUNT*K*N );
+    fillRandom ( & d_image, IMAGE_COUNT*IMAGE_HEIGHT*IMAGE_WIDTH );
+    fillRandom ( & d_separableWeights, 2*KERNEL_SIZE );
+
+    fillResult ( & d_c, BATCH_COUNT*M*N );
+    fillResult ( & d_filtered, IMAGE_COUNT*IMAGE_HEIGHT*IMAGE_WIDTH );
+    fillResult ( & d_separableFiltered, IMAGE_COUNT*IMAGE_HEIGHT*IMAGE_WIDTH );
+
+    // Separable weights are KERNEL_SIZE row weights followed by KERNEL_SIZE
+    // column ones. The full kernel is their outer product.
+
+    d_weights.resize ( KERNEL_SIZE*KERNEL_SIZE );
+
+    for ( int i = 0; i != KERNEL_SIZE; ++i )
+        for ( int j = 0; j != KERNEL_SIZE; ++j )
+            d_weights [ i*KERNEL_SIZE + j ] = d_separableWeights [ KERNEL_SIZE + i ] * d_separableWeights [ j ];
+}
+
+// -----------------------------------------------------------------------------
+
+void KMatrixOperationsTest :: compareResults()
+{
+    static const double s_eps = 0.0001;
+
+    for ( std::uint32_t iBatch = 0; iBatch != BATCH_COUNT; ++iBatch )
+        for ( std::uint32_t row = 0; row != M; ++row )
+            for ( std::uint32_t col = 0; col != N; ++col )
+            {
+                double sum = 0.0;
+
+                for ( std::uint32_t i = 0; i != K; ++i )
+                    sum += static_cast< double >( d_a [ ( iBatch*M + row )*K + i ] )
+                        * d_b [ ( iBatch*K + i )*N + col ];
+
+                const float result = d_c [ ( iBatch*M + row )*N + col ];
+                check ( std::abs ( result - sum ) <= s_eps );
+            }
+
+    const int r = KERNEL_SIZE / 2;
+    const int height = static_cast< int >( IMAGE_HEIGHT );
+    const int width = static_cast< int >( IMAGE_WIDTH );
+
+    for ( std::uint32_t iImage = 0; iImage != IMAGE_COUNT; ++iImage )
+    {
+        const size_t start = iImage*IMAGE_HEIGHT*IMAGE_WIDTH;
+
+        for ( int row = 0; row != height; ++row )
+            for ( int col = 0; col != width; ++col )
+            {
+                // Pixels outside the image are clamped to edge.
+                double sum = 0.0;
+
+                for ( int i = 0; i != KERNEL_SIZE; ++i )
+                    for ( int j = 0; j != KERNEL_SIZE; ++j )
+                    {
+                        const int sourceRow = std::max ( std::min ( row + i - r, height - 1 ), 0 );
+                        const int sourceCol = std::max ( std::min ( col + j - r, width - 1 ), 0 );
+
+                        sum += static_cast< double >( d_image [ start + sourceRow*width + sourceCol ] )
+                            * d_weights [ i*KERNEL_SIZE + j ];
+                    }
+
+                const size_t index = start + row*width + col;
+                check ( std::abs ( d_filtered [ index ] - sum ) <= s_eps );
+                check ( std::abs ( d_separableFiltered [ index ] - sum ) <= s_eps );
+            }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Readback tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KReadbackTest :
+    public vpp::Computation,
+    public KDescriptorUpdateTestTypes
+{
+public:
+    KReadbackTest ( vpp::Computation& pred, const vpp::Device& hDevice );
+
+    void readBack();
+    void compareResults();
+
+private:
+    // Smaller than the whole buffer, so that both the staging ring and
+    // dedicated staging memory are used.
+    static const VkDeviceSize STAGING_SIZE = 128;
+    static const unsigned int PARTIAL_OFFSET = 16;
+    static const unsigned int PARTIAL_LENGTH = 16;
+
+    vpp::Device d_device;
+    vpp::ComputePipelineLayout< KDescriptorUpdateTestPipeline > d_pipeline;
+    vpp::ShaderDataBlock d_dataBlock;
+
+    DataBuffer d_firstBuffer;
+    DataBuffer d_secondBuffer;
+
+    std::vector< unsigned int > d_fullValues;
+    std::vector< unsigned int > d_partialValues;
+    bool d_bFullContinued;
+    bool d_bPartialContinued;
+};
+
+// -----------------------------------------------------------------------------
+
+KReadbackTest :: KReadbackTest ( vpp::Computation& pred, const vpp::Device& hDevice ) :
+    vpp::Computation ( pred ),
+    d_device ( hDevice ),
+    d_pipeline ( hDevice ),
+    d_dataBlock ( d_pipeline ),
+    d_firstBuffer ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_secondBuffer ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_bFullContinued ( false ),
+    d_bPartialContinued ( false )
+{
+    using namespace vpp;
+
+    d_pipeline.definition().setFirstBuffer ( d_firstBuffer, & d_dataBlock );
+    d_pipeline.definition().setSecondBuffer ( d_secondBuffer, & d_dataBlock );
+
+    addPipeline ( d_pipeline );
+
+    // No barrier or load at the end. The readback must make the shader
+    // writes visible by itself.
+
+    ( *this ) << [ this ]()
+    {
+        cmdFillBuffer ( d_firstBuffer, 0, BUFFER_LENGTH*sizeof ( unsigned int ), 0 );
+        cmdFillBuffer ( d_secondBuffer, 0, BUFFER_LENGTH*sizeof ( unsigned int ), 0 );
+
+        cmdPipelineBarrier ( barriers (
+            Bar::TRANSFER, Bar::COMPUTE,
+            d_firstBuffer, d_secondBuffer ) );
+
+        d_dataBlock.cmdBind();
+        pipeline ( 0 ).cmdBind();
+        cmdDispatch ( 1, 1, 1 );
+    };
+}
+
+// -----------------------------------------------------------------------------
+
+void KReadbackTest :: readBack()
+{
+    // Must be called right after submitting the computation to the same
+    // queue, without waiting.
+
+    vpp::ReadbackQueue readbackQueue ( d_device, STAGING_SIZE );
+
+    const VkDeviceSize itemSize = sizeof ( unsigned int );
+
+    vpp::ReadbackFuture full = readbackQueue.readBuffer (
+        d_firstBuffer, 0, BUFFER_LENGTH*itemSize );
+
+    vpp::ReadbackFuture partial = readbackQueue.readBuffer (
+        d_secondBuffer, PARTIAL_OFFSET*itemSize, PARTIAL_LENGTH*itemSize );
+
+    full.then ( [ this ]( const vpp::ReadbackFuture& future )
+    {
+        const unsigned int* pData = static_cast< const unsigned int* >( future.data() );
+        d_fullValues.assign ( pData, pData + future.size() / sizeof ( unsigned int ) );
+        d_bFullContinued = true;
+    } );
+
+    partial.then ( [ this ]( const vpp::ReadbackFuture& future )
+    {
+        const unsigned int* pData = static_cast< const unsigned int* >( future.data() );
+        d_partialValues.assign ( pData, pData + future.size() / sizeof ( unsigned int ) );
+        d_bPartialContinued = true;
+    } );
+
+    readbackQueue.waitIdle();
+
+    check ( full.isReady() );
+    check ( partial.isReady() );
+}
+
+// -----------------------------------------------------------------------------
+
+void KReadbackTest :: compareResults()
+{
+    check ( d_bFullContinued );
+    check ( d_bPartialContinued );
+    check ( d_fullValues.size() == BUFFER_LENGTH );
+    check ( d_partialValues.size() == PARTIAL_LENGTH );
+
+    for ( unsigned int i = 0; i != d_fullValues.size(); ++i )
+        check ( d_fullValues [ i ] == i + 1 );
+
+    for ( unsigned int i = 0; i != d_partialValues.size(); ++i )
+        check ( d_partialValues [ i ] == PARTIAL_OFFSET + i + 1001 );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Loop control tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KLoopControlTest :
+    public vpp::Computation,
+    public KLoopControlTestTypes
+{
+public:
+    KLoopControlTest ( vpp::Computation& pred, const vpp::Device& hDevice );
+
+    void compareResults();
+
+private:
+    vpp::ComputePipelineLayout< KLoopControlTestPipeline > d_pipeline;
+    vpp::ShaderDataBlock d_dataBlock;
+    DataBuffer d_data;
+};
+
+// -----------------------------------------------------------------------------
+
+KLoopControlTest :: KLoopControlTest ( vpp::Computation& pred, const vpp::Device& hDevice ) :
+    vpp::Computation ( pred ),
+    d_pipeline ( hDevice ),
+    d_dataBlock ( d_pipeline ),
+    d_data ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice )
+{
+    using namespace vpp;
+
+    d_pipeline.definition().setDataBuffer ( d_data, & d_dataBlock );
+
+    addPipeline ( d_pipeline );
+
+    d_data.resize ( BUFFER_LENGTH );
+
+    ( *this ) << [ this ]()
+    {
+        d_dataBlock.cmdBind();
+        pipeline ( 0 ).cmdBind();
+        cmdDispatch ( 1, 1, 1 );
+
+        cmdPipelineBarrier ( barriers (
+            Bar::COMPUTE, Bar::TRANSFER, d_data ) );
+
+        d_data.cmdLoadAll();
+    };
+}
+
+// -----------------------------------------------------------------------------
+
+void KLoopControlTest :: compareResults()
+{
+    for ( unsigned int i = 0; i != WORKGROUP_SIZE; ++i )
+    {
+        const int l = static_cast< int >( i );
+        const int* pValues = & d_data [ VALUE_COUNT*i ];
+
+        check ( pValues [ 0 ] == 10*l + 20 );
+        check ( pValues [ 1 ] == 12*l + 6 );
+        check ( pValues [ 2 ] == l*( l - 1 ) / 2 + ( ( l & 1 ) != 0 ? 1000 : 0 ) );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                            Specialization tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KSpecializationTest :
+    public vpp::Computation,
+    public KSpecializationTestTypes
+{
+public:
+    KSpecializationTest ( vpp::Computation& pred, const vpp::Device& hDevice );
+
+    void compareResults();
+
+private:
+    vpp::ComputePipelineLayout< KSpecializationTestPipeline > d_pipeline;
+
+    vpp::ShaderDataBlock d_defaultBlock;
+    vpp::ShaderDataBlock d_resizedBlock;
+    vpp::ShaderDataBlock d_negatedBlock;
+
+    DataBuffer d_defaultBuffer;
+    DataBuffer d_resizedBuffer;
+    DataBuffer d_negatedBuffer;
+};
+
+// -----------------------------------------------------------------------------
+
+KSpecializationTest :: KSpecializationTest ( vpp::Computation& pred, const vpp::Device& hDevice ) :
+    vpp::Computation ( pred ),
+    d_pipeline ( hDevice ),
+    d_defaultBlock ( d_pipeline ),
+    d_resizedBlock ( d_pipeline ),
+    d_negatedBlock ( d_pipeline ),
+    d_defaultBuffer ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_resizedBuffer ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_negatedBuffer ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice )
+{
+    using namespace vpp;
+
+    KSpecializationTestPipeline& def = d_pipeline.definition();
+
+    // Three pipelines from one layout: configured values, local size and
+    // scale overridden, only the flag overridden.
+
+    SpecializationValues resized;
+    resized.set ( def.d_localSizeX, SPECIALIZED_LOCAL_SIZE );
+    resized.set ( def.d_scale, SPECIALIZED_SCALE );
+
+    SpecializationValues negated;
+    negated.set ( def.d_bNegate, true );
+
+    addPipeline ( d_pipeline );
+    addPipeline ( d_pipeline, resized );
+    addPipeline ( d_pipeline, negated );
+
+    def.setDataBuffer ( d_defaultBuffer, & d_defaultBlock );
+    def.setDataBuffer ( d_resizedBuffer, & d_resizedBlock );
+    def.setDataBuffer ( d_negatedBuffer, & d_negatedBlock );
+
+    d_defaultBuffer.resize ( BUFFER_LENGTH );
+    d_resizedBuffer.resize ( BUFFER_LENGTH );
+    d_negatedBuffer.resize ( BUFFER_LENGTH );
+
+    ( *this ) << [ this ]()
+    {
+        d_defaultBlock.cmdBind();
+        pipeline ( 0 ).cmdBind();
+        cmdDispatch ( BUFFER_LENGTH / DEFAULT_LOCAL_SIZE, 1, 1 );
+
+        d_resizedBlock.cmdBind();
+        pipeline ( 1 ).cmdBind();
+        cmdDispatch ( BUFFER_LENGTH / SPECIALIZED_LOCAL_SIZE, 1, 1 );
+
+        d_negatedBlock.cmdBind();
+        pipeline ( 2 ).cmdBind();
+        cmdDispatch ( BUFFER_LENGTH / DEFAULT_LOCAL_SIZE, 1, 1 );
+
+        cmdPipelineBarrier ( barriers (
+            Bar::COMPUTE, Bar::TRANSFER,
+            d_defaultBuffer, d_resizedBuffer, d_negatedBuffer ) );
+
+        d_defaultBuffer.cmdLoadAll();
+        d_resizedBuffer.cmdLoadAll();
+        d_negatedBuffer.cmdLoadAll();
+    };
+}
+
+// -----------------------------------------------------------------------------
+
+void KSpecializationTest :: compareResults()
+{
+    for ( unsigned int i = 0; i != BUFFER_LENGTH; ++i )
+    {
+        const int g = static_cast< int >( i );
+
+        check ( d_defaultBuffer [ i ] == g + 1000*DEFAULT_LOCAL_SIZE );
+        check ( d_resizedBuffer [ i ] == SPECIALIZED_SCALE*g + 1000*SPECIALIZED_LOCAL_SIZE );
+        check ( d_negatedBuffer [ i ] == -( g + 1000*DEFAULT_LOCAL_SIZE ) );
+    }
 }
 
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                             Computation graph tests
+
+// -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-void KGroupVariablesTestPipeline :: storeVariable ( const vpp::UInt& v )
+class KComputationGraphTest : public vpp::ComputationEngine
 {
-    ( *d_pOutUIntBuffer ) [ d_uintResultBufferOffset++ ] = v;
+public:
+    KComputationGraphTest ( const vpp::Device& hDevice );
+
+    void compareResults();
+
+private:
+    static const unsigned int BUFFER_LENGTH = 1024;
+
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer;
+
+    void addTransferRead ( const vpp::Procedure& node, const DataBuffer& hBuffer );
+    void addTransferWrite ( const vpp::Procedure& node, const DataBuffer& hBuffer );
+
+private:
+    vpp::CompiledProcedures d_procedures;
+
+    DataBuffer d_source;
+    DataBuffer d_copy;
+    DataBuffer d_otherSource;
+    DataBuffer d_otherCopy;
+
+    vpp::Procedure d_fillSource;
+    vpp::Procedure d_copySource;
+    vpp::Procedure d_overwriteSource;
+    vpp::Procedure d_loadResults;
+
+    vpp::Procedure d_fillOther;
+    vpp::Procedure d_copyOther;
+    vpp::Procedure d_loadOther;
+};
+
+// -----------------------------------------------------------------------------
+
+KComputationGraphTest :: KComputationGraphTest ( const vpp::Device& hDevice ) :
+    vpp::ComputationEngine ( hDevice, vpp::Q_GRAPHICS ),
+    d_procedures ( hDevice, vpp::Q_GRAPHICS ),
+    d_source ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_copy ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_otherSource ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_otherCopy ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice )
+{
+    d_source.resize ( BUFFER_LENGTH );
+    d_copy.resize ( BUFFER_LENGTH );
+    d_otherSource.resize ( BUFFER_LENGTH );
+    d_otherCopy.resize ( BUFFER_LENGTH );
+
+    const size_t bufferSize = BUFFER_LENGTH*sizeof ( unsigned int );
+
+    d_fillSource << [ this, bufferSize ]() { cmdFillBuffer ( d_source, 0, bufferSize, 7 ); };
+    d_copySource << [ this ]() { cmdCopyBuffer ( d_source, d_copy ); };
+    d_overwriteSource << [ this, bufferSize ]() { cmdFillBuffer ( d_source, 0, bufferSize, 9 ); };
+    d_loadResults << [ this ]() { d_source.cmdLoadAll(); d_copy.cmdLoadAll(); };
+
+    d_fillOther << [ this, bufferSize ]() { cmdFillBuffer ( d_otherSource, 0, bufferSize, 3 ); };
+    d_copyOther << [ this ]() { cmdCopyBuffer ( d_otherSource, d_otherCopy ); };
+    d_loadOther << [ this ]() { d_otherCopy.cmdLoadAll(); };
+
+    // The copy must see the first fill (read-after-write) and the second
+    // fill must wait until the copy has read the source (write-after-read).
+    // Nodes are ordered by their first appearance here.
+
+    addTransferWrite ( d_fillSource, d_source );
+    addTransferRead ( d_copySource, d_source );
+    addTransferWrite ( d_copySource, d_copy );
+    addTransferWrite ( d_overwriteSource, d_source );
+    addTransferRead ( d_loadResults, d_source );
+    addTransferRead ( d_loadResults, d_copy );
+
+    // Independent chain, so that the graph has two components with several
+    // levels each. These go to separate queues, if there are any.
+
+    addTransferWrite ( d_fillOther, d_otherSource );
+    addTransferRead ( d_copyOther, d_otherSource );
+    addTransferWrite ( d_copyOther, d_otherCopy );
+    addTransferRead ( d_loadOther, d_otherCopy );
+
+    compile();
 }
 
 // -----------------------------------------------------------------------------
 
-void KGroupVariablesTestPipeline :: storeVariable ( const vpp::Float& v )
+void KComputationGraphTest :: addTransferRead (
+    const vpp::Procedure& node, const DataBuffer& hBuffer )
 {
-    ( *d_pOutFloatBuffer ) [ d_floatResultBufferOffset++ ] = v;
+    addRead ( node, hBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT );
 }
 
 // -----------------------------------------------------------------------------
 
-void KGroupVariablesTestPipeline :: storeVariable ( const vpp::Double& v )
+void KComputationGraphTest :: addTransferWrite (
+    const vpp::Procedure& node, const DataBuffer& hBuffer )
 {
-    ( *d_pOutDoubleBuffer ) [ d_doubleResultBufferOffset++ ] = v;
+    addWrite ( node, hBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT );
 }
 
 // -----------------------------------------------------------------------------
 
-template< typename BaseT, size_t SIZE >
-void KGroupVariablesTestPipeline :: storeVariable (
-    const vpp::TLVector< BaseT, SIZE, spv::StorageClassWorkgroup >& var )
+void KComputationGraphTest :: compareResults()
 {
-    for ( unsigned int i = 0; i != SIZE; ++i )
+    check ( isGraph() );
+    check ( submitCount() >= 1 );
+
+    for ( unsigned int i = 0; i != BUFFER_LENGTH; ++i )
     {
-        const BaseT scalarValue = var [ i ];
-        storeVariable ( scalarValue );
+        check ( d_source [ i ] == 9 );
+        check ( d_copy [ i ] == 7 );
+        check ( d_otherCopy [ i ] == 3 );
     }
 }
 
 // -----------------------------------------------------------------------------
 
-template< typename BaseT, size_t COLS, size_t ROWS  >
-void KGroupVariablesTestPipeline :: storeVariable (
-    const vpp::TLMatrix< BaseT, COLS, ROWS, spv::StorageClassWorkgroup >& var )
+void testComputationGraphCycle ( const vpp::Device& hDevice )
 {
-    for ( unsigned int r = 0; r != ROWS; ++r )
-        for ( unsigned int c = 0; c != COLS; ++c )
+    vpp::ComputationEngine engine ( hDevice, vpp::Q_GRAPHICS );
+    vpp::CompiledProcedures procedures ( hDevice, vpp::Q_GRAPHICS );
+
+    vpp::Procedure first;
+    vpp::Procedure second;
+
+    engine.addDependency ( first, second );
+    engine.addDependency ( second, first );
+
+    bool bThrown = false;
+
+    try
+    {
+        engine.compile();
+    }
+    catch ( const vpp::XUsageError& )
     {
-        const BaseT scalarValue = var [ c ][ r ];
-        storeVariable ( scalarValue );
+        bThrown = true;
     }
+
+    check ( bThrown );
 }
 
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                     Test per-thread command buffer allocation
+
+// -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-void KGroupVariablesTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+void testCommandBufferAllocator ( const vpp::Device& hDevice )
 {
-    using namespace vpp;
-    using namespace vpp::ct;
-
-    group::GroupInvocation inv ( pShader );
-
-    //pShader->DebugCodeDump();
-
-    const Int ng = pShader->inNumWorkgroups [ X ];
-    const Int nl = pShader->inWorkgroupSize [ X ];
-    const Int np = ng * nl;
-    const Int l = pShader->inLocalInvocationId [ X ];
-    const Int g = pShader->inWorkgroupId [ X ];
-
-    UniformSimpleArray< int, decltype ( d_intResultBuffer ) > outIntBuffer ( d_intResultBuffer );
-    UniformSimpleArray< unsigned int, decltype ( d_uintResultBuffer ) > outUIntBuffer ( d_uintResultBuffer );
-    UniformSimpleArray< float, decltype ( d_floatResultBuffer ) > outFloatBuffer ( d_floatResultBuffer );
-    UniformSimpleArray< double, decltype ( d_doubleResultBuffer ) > outDoubleBuffer ( d_doubleResultBuffer );
-    UniformSimpleArray< int, decltype ( d_groupResultBuffer ) > outGroupBuffer ( d_groupResultBuffer );
-
-    d_pOutIntBuffer = & outIntBuffer;
-    d_pOutUIntBuffer = & outUIntBuffer;
-    d_pOutFloatBuffer = & outFloatBuffer;
-    d_pOutDoubleBuffer = & outDoubleBuffer;
-
-    WInt wint;
-    WUInt wuint;
-    WFloat wfloat;
-    WDouble wdouble;
-    WBool wbool;
-    WVec2 wvec2;
-    WVec3 wvec3;
-    WVec4 wvec4;
-    WDVec2 wdvec2;
-    WDVec3 wdvec3;
-    WDVec4 wdvec4;
-    WIVec2 wivec2;
-    WIVec3 wivec3;
-    WIVec4 wivec4;
-    WUVec2 wuvec2;
-    WUVec3 wuvec3;
-    WUVec4 wuvec4;
-    WBVec2 wbvec2;
-    WBVec3 wbvec3;
-    WBVec4 wbvec4;
-    WMat2 wmat2;
-    WMat3 wmat3;
-    WMat4 wmat4;
-    WMat2x3 wmat2x3;
-    WMat2x4 wmat2x4;
-    WMat3x2 wmat3x2;
-    WMat3x4 wmat3x4;
-    WMat4x2 wmat4x2;
-    WMat4x3 wmat4x3;
-    WDMat2 wdmat2;
-    WDMat3 wdmat3;
-    WDMat4 wdmat4;
-    WDMat2x3 wdmat2x3;
-    WDMat2x4 wdmat2x4;
-    WDMat3x2 wdmat3x2;
-    WDMat3x4 wdmat3x4;
-    WDMat4x2 wdmat4x2;
-    WDMat4x3 wdmat4x3;
-
-    WArray< Vec2 > wav2 ( 2 );
-    WArray2< Mat2 > wa2m2 ( 2, 2 );
-    WArray3< Int > wa3i ( 2, 2, 2 );
-
-    If ( inv.LocalId() == 0 );
-        setVariable ( wint, 0 );
-        setVariable ( wuint, 0 );
-        setVariable ( wfloat, 0 );
-        setVariable ( wdouble, 0 );
-        setVariable ( wbool, 0 );
-        setVariable ( wvec2, 0 );
-        setVariable ( wvec3, 0 );
-        setVariable ( wvec4, 0 );
-        setVariable ( wdvec2, 0 );
-        setVariable ( wdvec3, 0 );
-        setVariable ( wdvec4, 0 );
-        setVariable ( wivec2, 0 );
-        setVariable ( wivec3, 0 );
-        setVariable ( wivec4, 0 );
-        setVariable ( wuvec2, 0 );
-        setVariable ( wuvec3, 0 );
-        setVariable ( wuvec4, 0 );
-        setVariableB ( wbvec2, 0 );
-        setVariableB ( wbvec3, 0 );
-        setVariableB ( wbvec4, 0 );
-        setVariable ( wmat2, 0 );
-        setVariable ( wmat3, 0 );
-        setVariable ( wmat4, 0 );
-        setVariable ( wmat2x3, 0 );
-        setVariable ( wmat2x4, 0 );
-        setVariable ( wmat3x2, 0 );
-        setVariable ( wmat3x4, 0 );
-        setVariable ( wmat4x2, 0 );
-        setVariable ( wmat4x3, 0 );
-        setVariable ( wdmat2, 0 );
-        setVariable ( wdmat3, 0 );
-        setVariable ( wdmat4, 0 );
-        setVariable ( wdmat2x3, 0 );
-        setVariable ( wdmat2x4, 0 );
-        setVariable ( wdmat3x2, 0 );
-        setVariable ( wdmat3x4, 0 );
-        setVariable ( wdmat4x2, 0 );
-        setVariable ( wdmat4x3, 0 );
-
-        wav2 [ 0 ][ 0 ] = 0.0f;
-        wav2 [ 0 ][ 1 ] = 0.0f;
-        wav2 [ 1 ][ 0 ] = 0.0f;
-        wav2 [ 1 ][ 1 ] = 0.0f;
-
-        wa2m2 [ 0 ][ 0 ][ 0 ][ 0 ] = 0.0f;
-        wa2m2 [ 0 ][ 0 ][ 0 ][ 1 ] = 0.0f;
-        wa2m2 [ 0 ][ 0 ][ 1 ][ 0 ] = 0.0f;
-        wa2m2 [ 0 ][ 0 ][ 1 ][ 1 ] = 0.0f;
-        wa2m2 [ 0 ][ 1 ][ 0 ][ 0 ] = 0.0f;
-        wa2m2 [ 0 ][ 1 ][ 0 ][ 1 ] = 0.0f;
-        wa2m2 [ 0 ][ 1 ][ 1 ][ 0 ] = 0.0f;
-        wa2m2 [ 0 ][ 1 ][ 1 ][ 1 ] = 0.0f;
-        wa2m2 [ 1 ][ 0 ][ 0 ][ 0 ] = 0.0f;
-        wa2m2 [ 1 ][ 0 ][ 0 ][ 1 ] = 0.0f;
-        wa2m2 [ 1 ][ 0 ][ 1 ][ 0 ] = 0.0f;
-        wa2m2 [ 1 ][ 0 ][ 1 ][ 1 ] = 0.0f;
-        wa2m2 [ 1 ][ 1 ][ 0 ][ 0 ] = 0.0f;
-        wa2m2 [ 1 ][ 1 ][ 0 ][ 1 ] = 0.0f;
-        wa2m2 [ 1 ][ 1 ][ 1 ][ 0 ] = 0.0f;
-        wa2m2 [ 1 ][ 1 ][ 1 ][ 1 ] = 0.0f;
-
-        wa3i [ 0 ][ 0 ][ 0 ] = 0;
-        wa3i [ 0 ][ 0 ][ 1 ] = 0;
-        wa3i [ 0 ][ 1 ][ 0 ] = 0;
-        wa3i [ 0 ][ 1 ][ 1 ] = 0;
-        wa3i [ 1 ][ 0 ][ 0 ] = 0;
-        wa3i [ 1 ][ 0 ][ 1 ] = 0;
-        wa3i [ 1 ][ 1 ][ 0 ] = 0;
-        wa3i [ 1 ][ 1 ][ 1 ] = 0;
-
-    Fi();
-
-    WorkgroupBarrier();
-
-    If ( inv.LocalId() == 1 );
-        setVariable ( wint, 1 );
-        setVariable ( wuint, 1 );
-        setVariable ( wfloat, 1 );
-        setVariable ( wdouble, 1 );
-        setVariable ( wbool, 1 );
-        setVariable ( wvec2, 1 );
-        setVariable ( wvec3, 1 );
-        setVariable ( wvec4, 1 );
-        setVariable ( wdvec2, 1 );
-        setVariable ( wdvec3, 1 );
-        setVariable ( wdvec4, 1 );
-        setVariable ( wivec2, 1 );
-        setVariable ( wivec3, 1 );
-        setVariable ( wivec4, 1 );
-        setVariable ( wuvec2, 1 );
-        setVariable ( wuvec3, 1 );
-        setVariable ( wuvec4, 1 );
-        setVariableB ( wbvec2, 1 );
-        setVariableB ( wbvec3, 1 );
-        setVariableB ( wbvec4, 1 );
-        setVariable ( wmat2, 1 );
-        setVariable ( wmat3, 1 );
-        setVariable ( wmat4, 1 );
-        setVariable ( wmat2x3, 1 );
-        setVariable ( wmat2x4, 1 );
-        setVariable ( wmat3x2, 1 );
-        setVariable ( wmat3x4, 1 );
-        setVariable ( wmat4x2, 1 );
-        setVariable ( wmat4x3, 1 );
-        setVariable ( wdmat2, 1 );
-        setVariable ( wdmat3, 1 );
-        setVariable ( wdmat4, 1 );
-        setVariable ( wdmat2x3, 1 );
-        setVariable ( wdmat2x4, 1 );
-        setVariable ( wdmat3x2, 1 );
-        setVariable ( wdmat3x4, 1 );
-        setVariable ( wdmat4x2, 1 );
-        setVariable ( wdmat4x3, 1 );
-
-        wav2 [ 0 ][ 0 ] = 1.0f;
-        wav2 [ 0 ][ 1 ] = 1.0f;
-        wav2 [ 1 ][ 0 ] = 1.0f;
-        wav2 [ 1 ][ 1 ] = 1.0f;
-
-        wa2m2 [ 0 ][ 0 ][ 0 ][ 0 ] = 1.0f;
-        wa2m2 [ 0 ][ 0 ][ 0 ][ 1 ] = 1.0f;
-        wa2m2 [ 0 ][ 0 ][ 1 ][ 0 ] = 1.0f;
-        wa2m2 [ 0 ][ 0 ][ 1 ][ 1 ] = 1.0f;
-        wa2m2 [ 0 ][ 1 ][ 0 ][ 0 ] = 1.0f;
-        wa2m2 [ 0 ][ 1 ][ 0 ][ 1 ] = 1.0f;
-        wa2m2 [ 0 ][ 1 ][ 1 ][ 0 ] = 1.0f;
-        wa2m2 [ 0 ][ 1 ][ 1 ][ 1 ] = 1.0f;
-        wa2m2 [ 1 ][ 0 ][ 0 ][ 0 ] = 1.0f;
-        wa2m2 [ 1 ][ 0 ][ 0 ][ 1 ] = 1.0f;
-        wa2m2 [ 1 ][ 0 ][ 1 ][ 0 ] = 1.0f;
-        wa2m2 [ 1 ][ 0 ][ 1 ][ 1 ] = 1.0f;
-        wa2m2 [ 1 ][ 1 ][ 0 ][ 0 ] = 1.0f;
-        wa2m2 [ 1 ][ 1 ][ 0 ][ 1 ] = 1.0f;
-        wa2m2 [ 1 ][ 1 ][ 1 ][ 0 ] = 1.0f;
-        wa2m2 [ 1 ][ 1 ][ 1 ][ 1 ] = 1.0f;
-
-        wa3i [ 0 ][ 0 ][ 0 ] = 1;
-        wa3i [ 0 ][ 0 ][ 1 ] = 1;
-        wa3i [ 0 ][ 1 ][ 0 ] = 1;
-        wa3i [ 0 ][ 1 ][ 1 ] = 1;
-        wa3i [ 1 ][ 0 ][ 0 ] = 1;
-        wa3i [ 1 ][ 0 ][ 1 ] = 1;
-        wa3i [ 1 ][ 1 ][ 0 ] = 1;
-        wa3i [ 1 ][ 1 ][ 1 ] = 1;
-    Fi();
-
-    WorkgroupBarrier();
-
-    If ( inv.LocalId() == 0 );
-        storeVariable ( wint );
-        storeVariable ( wuint );
-        storeVariable ( wfloat );
-        storeVariable ( wdouble );
-        storeVariable ( wbool );
-        storeVariable ( wvec2 );
-        storeVariable ( wvec3 );
-        storeVariable ( wvec4 );
-        storeVariable ( wdvec2 );
-        storeVariable ( wdvec3 );
-        storeVariable ( wdvec4 );
-        storeVariable ( wivec2 );
-        storeVariable ( wivec3 );
-        storeVariable ( wivec4 );
-        storeVariable ( wuvec2 );
-        storeVariable ( wuvec3 );
-        storeVariable ( wuvec4 );
-        storeVariable ( wbvec2 );
-        storeVariable ( wbvec3 );
-        storeVariable ( wbvec4 );
-        storeVariable ( wmat2 );
-        storeVariable ( wmat3 );
-        storeVariable ( wmat4 );
-        storeVariable ( wmat2x3 );
-        storeVariable ( wmat2x4 );
-        storeVariable ( wmat3x2 );
-        storeVariable ( wmat3x4 );
-        storeVariable ( wmat4x2 );
-        storeVariable ( wmat4x3 );
-        storeVariable ( wdmat2 );
-        storeVariable ( wdmat3 );
-        storeVariable ( wdmat4 );
-        storeVariable ( wdmat2x3 );
-        storeVariable ( wdmat2x4 );
-        storeVariable ( wdmat3x2 );
-        storeVariable ( wdmat3x4 );
-        storeVariable ( wdmat4x2 );
-        storeVariable ( wdmat4x3 );
-
-        storeVariable ( wav2 [ 0 ][ 0 ] );
-        storeVariable ( wav2 [ 0 ][ 1 ] );
-        storeVariable ( wav2 [ 1 ][ 0 ] );
-        storeVariable ( wav2 [ 1 ][ 1 ] );
-
-        storeVariable ( wa2m2 [ 0 ][ 0 ][ 0 ][ 0 ] );
-        storeVariable ( wa2m2 [ 0 ][ 0 ][ 0 ][ 1 ] );
-        storeVariable ( wa2m2 [ 0 ][ 0 ][ 1 ][ 0 ] );
-        storeVariable ( wa2m2 [ 0 ][ 0 ][ 1 ][ 1 ] );
-        storeVariable ( wa2m2 [ 0 ][ 1 ][ 0 ][ 0 ] );
-        storeVariable ( wa2m2 [ 0 ][ 1 ][ 0 ][ 1 ] );
-        storeVariable ( wa2m2 [ 0 ][ 1 ][ 1 ][ 0 ] );
-        storeVariable ( wa2m2 [ 0 ][ 1 ][ 1 ][ 1 ] );
-        storeVariable ( wa2m2 [ 1 ][ 0 ][ 0 ][ 0 ] );
-        storeVariable ( wa2m2 [ 1 ][ 0 ][ 0 ][ 1 ] );
-        storeVariable ( wa2m2 [ 1 ][ 0 ][ 1 ][ 0 ] );
-        storeVariable ( wa2m2 [ 1 ][ 0 ][ 1 ][ 1 ] );
-        storeVariable ( wa2m2 [ 1 ][ 1 ][ 0 ][ 0 ] );
-        storeVariable ( wa2m2 [ 1 ][ 1 ][ 0 ][ 1 ] );
-        storeVariable ( wa2m2 [ 1 ][ 1 ][ 1 ][ 0 ] );
-        storeVariable ( wa2m2 [ 1 ][ 1 ][ 1 ][ 1 ] );
-
-        storeVariable ( wa3i [ 0 ][ 0 ][ 0 ] );
-        storeVariable ( wa3i [ 0 ][ 0 ][ 1 ] );
-        storeVariable ( wa3i [ 0 ][ 1 ][ 0 ] );
-        storeVariable ( wa3i [ 0 ][ 1 ][ 1 ] );
-        storeVariable ( wa3i [ 1 ][ 0 ][ 0 ] );
-        storeVariable ( wa3i [ 1 ][ 0 ][ 1 ] );
-        storeVariable ( wa3i [ 1 ][ 1 ][ 0 ] );
-        storeVariable ( wa3i [ 1 ][ 1 ][ 1 ] );
-
-    Fi();
-
-    WArray2< Int > wa2i ( 6, 10 );
-    WArray< Int > tmp ( 2 * inv.localCount() + 2 );
-    
-    group::Fill ( wa2i [ 0 ], Int ( 17 ), inv );
-    group::Copy ( wa2i [ 0 ], wa2i [ 1 ], inv );
-    group::Generate ( wa2i [ 2 ], []( const Int& idx ){ return 100-idx; }, inv );
-    group::Transform ( wa2i [ 2 ], wa2i [ 3 ], []( const Int& v ){ return 2*v; }, inv );
-    group::Sort ( wa2i [ 3 ], []( const Int& v1, const Int& v2 ){ return v1 < v2; }, inv );
-
-    const Int lb = group::LowerBound (
-        wa2i [ 3 ], 184,
-        []( const Int& v1, const Int& v2 ){ return v1 < v2; },
-        tmp, inv );
-
-    const Int ub = group::UpperBound (
-        wa2i [ 3 ], 184,
-        []( const Int& v1, const Int& v2 ){ return v1 < v2; },
-        tmp, inv );
-
-    group::Fill ( wa2i [ 4 ], lb, inv );
-    group::Fill ( wa2i [ 5 ], ub, inv );
-
-    group::Store ( wa2i, outGroupBuffer, 0, inv );
+    // One primary buffer per slot, so that the second acquire must grow
+    // the batch.
+
+    vpp::CommandBufferAllocator allocator ( hDevice, vpp::Q_GRAPHICS, 2, 1, 0 );
+    vpp::Queue queue ( hDevice );
+
+    check ( allocator.frameSlotCount() == 2 );
+    check ( allocator.currentFrameSlot() == 0 );
+    check ( ! allocator.frameFence().isSignaled() );
+
+    const VkCommandBuffer hFirst = allocator.acquirePrimary().handle();
+    const VkCommandBuffer hSecond = allocator.acquirePrimary().handle();
+
+    check ( hFirst != VK_NULL_HANDLE );
+    check ( hSecond != VK_NULL_HANDLE );
+    check ( hFirst != hSecond );
+
+    // Another thread gets buffers from its own pools.
+
+    VkCommandBuffer hOtherThread = VK_NULL_HANDLE;
+
+    std::thread otherThread ( [ & allocator, & hOtherThread ]() {
+        hOtherThread = allocator.acquirePrimary().handle(); } );
+
+    otherThread.join();
+
+    check ( hOtherThread != VK_NULL_HANDLE );
+    check ( hOtherThread != hFirst );
+    check ( hOtherThread != hSecond );
+
+    // Thread-local cache must not mix up allocators used by the same thread.
+
+    vpp::CommandBufferAllocator otherAllocator ( hDevice, vpp::Q_GRAPHICS, 2, 1, 0 );
+    const VkCommandBuffer hOtherAllocator = otherAllocator.acquirePrimary().handle();
+
+    check ( hOtherAllocator != hFirst );
+    check ( hOtherAllocator != hSecond );
+    check ( allocator.acquirePrimary().handle() != hOtherAllocator );
+
+    allocator.endFrame ( queue );
+
+    // Frame 1 uses the other slot.
+
+    check ( allocator.beginFrame() == 1 );
+    check ( allocator.currentFrameSlot() == 1 );
+    check ( ! allocator.frameFence().isSignaled() );
+
+    const VkCommandBuffer hSlot1 = allocator.acquirePrimary().handle();
+
+    check ( hSlot1 != hFirst );
+    check ( hSlot1 != hSecond );
+
+    allocator.endFrame ( queue );
+
+    // Frame 2 comes back to slot 0. beginFrame() waits for the fence of
+    // frame 0 and resets it, and buffers of that slot are handed out again.
+
+    check ( allocator.beginFrame() == 0 );
+    check ( ! allocator.frameFence().isSignaled() );
+    check ( allocator.acquirePrimary().handle() == hFirst );
+    check ( allocator.acquirePrimary().handle() == hSecond );
+
+    allocator.endFrame ( queue );
+    queue.waitForIdle();
 }
 
+// -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-class KGroupVariablesTest :
-    public vpp::Computation,
-    public KGroupVariablesTestTypes
+//                      Test sharing of layouts and samplers
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+void testLayoutCache ( const vpp::Device& hDevice )
+{
+    typedef vpp::ComputePipelineLayout< KDescriptorUpdateTestPipeline > Layout;
+
+    vpp::LayoutCache& cache = hDevice.layoutCache();
+
+    const size_t nSetLayouts = cache.setLayoutCount();
+    const size_t nPipelineLayouts = cache.pipelineLayoutCount();
+
+    {
+        Layout first ( hDevice );
+
+        const std::uint64_t nHits = cache.hitCount();
+        const std::uint64_t nMisses = cache.missCount();
+
+        // Identical definition: every set layout and the pipeline layout
+        // come from the cache.
+
+        Layout second ( hDevice );
+
+        check ( first.handle() == second.handle() );
+        check ( first.getDescriptorSetLayoutHandles() == second.getDescriptorSetLayoutHandles() );
+        check ( cache.hitCount() == nHits + second.getDescriptorSetCount() + 1 );
+        check ( cache.missCount() == nMisses );
+    }
+
+    // Entries are dropped when the last reference goes away.
+
+    check ( cache.setLayoutCount() == nSetLayouts );
+    check ( cache.pipelineLayoutCount() == nPipelineLayouts );
+}
+
+// -----------------------------------------------------------------------------
+
+void testSamplerCache ( const vpp::Device& hDevice )
+{
+    vpp::SamplerCache& cache = hDevice.samplerCache();
+
+    const size_t nSamplers = cache.samplerCount();
+    const std::uint64_t nHits = cache.hitCount();
+    const std::uint64_t nMisses = cache.missCount();
+
+    {
+        // Unusual parameters, so that no other test has such a sampler.
+
+        vpp::SNormalizedSampler firstInfo ( 7.0f );
+        firstInfo.mipLodBias = 0.25f;
+
+        vpp::SNormalizedSampler secondInfo ( 7.0f );
+        secondInfo.mipLodBias = 0.5f;
+
+        vpp::Sampler first ( hDevice, firstInfo );
+        vpp::Sampler same ( hDevice, firstInfo );
+        vpp::Sampler second ( hDevice, secondInfo );
+
+        check ( first.handle() == same.handle() );
+        check ( first.handle() != second.handle() );
+        check ( cache.hitCount() == nHits + 1 );
+        check ( cache.missCount() == nMisses + 2 );
+        check ( cache.samplerCount() == nSamplers + 2 );
+    }
+
+    check ( cache.samplerCount() == nSamplers );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                            Debug print ring buffer
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KDebugPrintTest :
+    public vpp::ComputationEngine,
+    public KDebugPrintTestTypes
+{
+public:
+    KDebugPrintTest ( const vpp::Device& hDevice );
+
+    void run();
+
+private:
+    void dispatch ( vpp::Computation* pComputation, unsigned int groupCount );
+
+    void checkRecords (
+        const std::vector< vpp::SDebugPrintRecord >& records,
+        unsigned int invocationCount );
+
+private:
+    vpp::DebugPrintBuffer d_debugPrint;
+    vpp::ComputePipelineLayout< KDebugPrintTestPipeline > d_pipeline;
+    vpp::ShaderDataBlock d_dataBlock;
+    DataBuffer d_data;
+
+    vpp::Computation d_oneGroup;
+    vpp::Computation d_twoGroups;
+};
+
+// -----------------------------------------------------------------------------
+
+KDebugPrintTest :: KDebugPrintTest ( const vpp::Device& hDevice ) :
+    vpp::ComputationEngine ( hDevice, vpp::Q_GRAPHICS ),
+    d_debugPrint ( hDevice, RING_CAPACITY ),
+    d_pipeline ( hDevice, d_debugPrint ),
+    d_dataBlock ( d_pipeline ),
+    d_data ( BUFFER_LENGTH, vpp::MemProfile::DEVICE_STATIC, hDevice )
+{
+    d_data.resize ( BUFFER_LENGTH );
+    d_pipeline.definition().setDataBuffer ( d_data, & d_dataBlock );
+
+    dispatch ( & d_oneGroup, 1 );
+    dispatch ( & d_twoGroups, 2 );
+
+    compile();
+}
+
+// -----------------------------------------------------------------------------
+
+void KDebugPrintTest :: dispatch ( vpp::Computation* pComputation, unsigned int groupCount )
+{
+    pComputation->addPipeline ( d_pipeline );
+
+    ( *pComputation ) << [ this, pComputation, groupCount ]()
+    {
+        d_dataBlock.cmdBind();
+        pComputation->pipeline ( 0 ).cmdBind();
+        vpp::ComputePass::cmdDispatch ( groupCount, 1, 1 );
+        d_debugPrint.cmdMakeHostVisible();
+    };
+}
+
+// -----------------------------------------------------------------------------
+
+void KDebugPrintTest :: checkRecords (
+    const std::vector< vpp::SDebugPrintRecord >& records,
+    unsigned int invocationCount )
+{
+    std::set< int > invocations;
+
+    for ( const vpp::SDebugPrintRecord& record : records )
+    {
+        const int x = record.d_invocation [ 0 ];
+
+        check ( x >= 0 && x < static_cast< int >( invocationCount ) );
+        check ( record.d_invocation [ 1 ] == 0 );
+        check ( record.d_invocation [ 2 ] == 0 );
+        check ( record.d_text == "v=" + std::to_string ( x + 100 ) );
+        check ( invocations.insert ( x ).second );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void KDebugPrintTest :: run()
+{
+    std::vector< vpp::SDebugPrintRecord > records;
+
+    // First 8 records take 40 of 64 words.
+
+    d_oneGroup ( vpp::NO_TIMEOUT );
+    check ( d_debugPrint.read ( & records ) == WORKGROUP_SIZE );
+    check ( d_debugPrint.droppedCount() == 0 );
+    checkRecords ( records, WORKGROUP_SIZE );
+
+    // Next 8 records wrap around the end of the ring.
+
+    records.clear();
+    d_oneGroup ( vpp::NO_TIMEOUT );
+    check ( d_debugPrint.read ( & records ) == WORKGROUP_SIZE );
+    check ( d_debugPrint.droppedCount() == 0 );
+    checkRecords ( records, WORKGROUP_SIZE );
+
+    // 16 records need 80 words. The first 12 reserved fit, the rest
+    // is dropped and counted.
+
+    records.clear();
+    d_twoGroups ( vpp::NO_TIMEOUT );
+    check ( d_debugPrint.read ( & records ) == 12 );
+    check ( d_debugPrint.droppedCount() == 4 );
+    checkRecords ( records, BUFFER_LENGTH );
+
+    // Dropped records are consumed too, so the ring is usable again.
+
+    records.clear();
+    d_oneGroup ( vpp::NO_TIMEOUT );
+    check ( d_debugPrint.read ( & records ) == WORKGROUP_SIZE );
+    check ( d_debugPrint.droppedCount() == 0 );
+    checkRecords ( records, WORKGROUP_SIZE );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                          Persistently mapped memory
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+void testWriteCombinedCopy()
+{
+    // Covers the unaligned head, 64-byte blocks, 16-byte blocks and the tail
+    // of streaming copies. Guard bytes around the range must stay intact.
+
+    static const size_t GUARD = 16;
+    static const size_t sizes[] = { 0, 1, 15, 63, 64, 79, 80, 200 };
+
+    std::vector< unsigned char > source ( 256 + GUARD );
+
+    for ( size_t i = 0; i != source.size(); ++i )
+        source [ i ] = static_cast< unsigned char >( i * 7 + 1 );
+
+    for ( size_t size : sizes )
+        for ( size_t offset = 0; offset != 16; ++offset )
+        {
+            std::vector< unsigned char > dest ( GUARD + offset + size + GUARD, 0 );
+
+            vpp::detail::copyToWriteCombined (
+                & dest [ GUARD + offset ], & source [ offset ], size );
+
+            bool bOk = true;
+
+            for ( size_t i = 0; i != dest.size(); ++i )
+            {
+                const bool bInside = ( i >= GUARD + offset && i < GUARD + offset + size );
+                const unsigned char expected = bInside ? source [ i - GUARD ] : 0;
+                bOk = bOk && dest [ i ] == expected;
+            }
+
+            check ( bOk );
+        }
+}
+
+// -----------------------------------------------------------------------------
+
+void testPersistentMapping ( const vpp::Device& hDevice )
+{
+    static const VkDeviceSize MEMORY_SIZE = 1024;
+
+    vpp::MappableDeviceMemory memory (
+        MEMORY_SIZE, ~0u, vpp::MemProfile::HOST_STATIC, hDevice, true );
+
+    check ( memory.isPersistentlyMapped() );
+
+    if ( ! memory.isPersistentlyMapped() )
+        return;
+
+    unsigned char* const pBegin = memory.beginMapped();
+    check ( memory.endMapped() == pBegin + MEMORY_SIZE );
+
+    // map() and unmap() only move the mapped range.
+
+    check ( memory.map ( 256, 128 ) == VK_SUCCESS );
+    check ( memory.beginMapped() == pBegin + 256 );
+    check ( memory.endMapped() == pBegin + 384 );
+
+    memory.unmap();
+    check ( memory.isPersistentlyMapped() );
+    check ( memory.beginMapped() == pBegin );
+    check ( memory.endMapped() == pBegin + MEMORY_SIZE );
+
+    // The range is clamped to the allocation.
+
+    check ( memory.map ( 1000, 100 ) == VK_SUCCESS );
+    check ( memory.endMapped() == pBegin + MEMORY_SIZE );
+    memory.unmap();
+
+    // load() writes only the given range.
+
+    std::memset ( pBegin, 0, MEMORY_SIZE );
+
+    std::vector< unsigned char > data ( 100 );
+
+    for ( size_t i = 0; i != data.size(); ++i )
+        data [ i ] = static_cast< unsigned char >( i + 1 );
+
+    memory.load ( & data [ 0 ], data.size(), 300 );
+
+    check ( std::equal ( data.begin(), data.end(), pBegin + 300 ) );
+    check ( pBegin [ 299 ] == 0 );
+    check ( pBegin [ 400 ] == 0 );
+    check ( memory.beginMapped() == pBegin );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                           Narrow integer tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KNarrowIntegerTest :
+    public vpp::ComputationEngine,
+    public KNarrowIntegerTestTypes
 {
 public:
-    KGroupVariablesTest ( vpp::Computation& pred, const vpp::Device& hDevice );
+    // Requires fShaderInt16 and fStorageBuffer16BitAccess.
+    KNarrowIntegerTest ( const vpp::Device& hDevice );
 
-    void prepareTestVectors();
-    void compareResults();
+    void run();
 
 private:
-    vpp::ComputePipelineLayout< KGroupVariablesTestPipeline > d_pipeline;
+    vpp::ComputePipelineLayout< KNarrowIntegerTestPipeline > d_pipeline;
     vpp::ShaderDataBlock d_dataBlock;
+    ShortBuffer d_shortBuffer;
+    IntBuffer d_intBuffer;
 
-    static const unsigned int s_bufferSize = 1024;
-
-    DataBufferI d_intResultBuffer;
-    DataBufferU d_uintResultBuffer;
-    DataBufferF d_floatResultBuffer;
-    DataBufferD d_doubleResultBuffer;
-    DataBufferI d_groupResultBuffer;
+    vpp::Computation d_computation;
 };
 
 // -----------------------------------------------------------------------------
 
-KGroupVariablesTest :: KGroupVariablesTest ( vpp::Computation& pred, const vpp::Device& hDevice ) :
-    vpp::Computation ( pred ),
+KNarrowIntegerTest :: KNarrowIntegerTest ( const vpp::Device& hDevice ) :
+    vpp::ComputationEngine ( hDevice, vpp::Q_GRAPHICS ),
     d_pipeline ( hDevice ),
     d_dataBlock ( d_pipeline ),
-    d_intResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice ),
-    d_uintResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice ),
-    d_floatResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice ),
-    d_doubleResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice ),
-    d_groupResultBuffer ( s_bufferSize, vpp::MemProfile::DEVICE_STATIC, hDevice )
+    d_shortBuffer ( WORKGROUP_SIZE, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_intBuffer ( 2*WORKGROUP_SIZE, vpp::MemProfile::DEVICE_STATIC, hDevice )
 {
     using namespace vpp;
 
-    d_pipeline.definition().setData (
-        d_intResultBuffer,
-        d_uintResultBuffer,
-        d_floatResultBuffer,
-        d_doubleResultBuffer,
-        d_groupResultBuffer,
-        & d_dataBlock );
+    d_shortBuffer.resize ( WORKGROUP_SIZE );
+    d_intBuffer.resize ( 2*WORKGROUP_SIZE );
+    d_pipeline.definition().setBuffers ( d_shortBuffer, d_intBuffer, & d_dataBlock );
 
-    addPipeline ( d_pipeline );
+    d_computation.addPipeline ( d_pipeline );
 
-    ( *this ) << [ this ]()
+    d_computation << [ this ]()
     {
         d_dataBlock.cmdBind();
-        pipeline ( 0 ).cmdBind();
-        cmdDispatch ( 1, 1, 1 );
+        d_computation.pipeline ( 0 ).cmdBind();
+        ComputePass::cmdDispatch ( 1, 1, 1 );
 
         cmdPipelineBarrier ( barriers (
-            Bar::COMPUTE, Bar::TRANSFER,
-            d_intResultBuffer, d_uintResultBuffer, d_floatResultBuffer, d_doubleResultBuffer,
-            d_groupResultBuffer
-        ) );
+            Bar::COMPUTE, Bar::TRANSFER, d_shortBuffer, d_intBuffer ) );
 
-        d_intResultBuffer.cmdLoadAll();
-        d_uintResultBuffer.cmdLoadAll();
-        d_floatResultBuffer.cmdLoadAll();
-        d_doubleResultBuffer.cmdLoadAll();
-        d_groupResultBuffer.cmdLoadAll();
+        d_shortBuffer.cmdLoadAll();
+        d_intBuffer.cmdLoadAll();
     };
 
-    prepareTestVectors();
+    compile();
 }
 
 // -----------------------------------------------------------------------------
 
-void KGroupVariablesTest :: prepareTestVectors()
+void KNarrowIntegerTest :: run()
 {
-    d_intResultBuffer.resize ( s_bufferSize );
-    d_uintResultBuffer.resize ( s_bufferSize );
-    d_floatResultBuffer.resize ( s_bufferSize );
-    d_doubleResultBuffer.resize ( s_bufferSize );
-    d_groupResultBuffer.resize ( s_bufferSize );
+    d_computation ( vpp::NO_TIMEOUT );
 
-    for ( unsigned int j = 0; j != s_bufferSize; ++j )
+    for ( unsigned int i = 0; i != WORKGROUP_SIZE; ++i )
     {
-        d_intResultBuffer [ j ] = 0;
-        d_uintResultBuffer [ j ] = 0;
-        d_floatResultBuffer [ j ] = 0;
-        d_doubleResultBuffer [ j ] = 0;
-        d_groupResultBuffer [ j ] = 0;
-    }
+        const std::int16_t s = static_cast< std::int16_t >(
+            static_cast< std::uint16_t >( static_cast< int >( i )*1000 - 20000 ) );
 
-    d_intResultBuffer.commitAndWait();
-    d_uintResultBuffer.commitAndWait();
-    d_floatResultBuffer.commitAndWait();
-    d_doubleResultBuffer.commitAndWait();
-    d_groupResultBuffer.commitAndWait();
+        check ( d_shortBuffer [ i ] == s );
+        check ( d_intBuffer [ 2*i ] == s );
+        check ( d_intBuffer [ 2*i + 1 ] == static_cast< std::uint16_t >( s ) );
+    }
 }
 
+// -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-void KGroupVariablesTest :: compareResults()
+//                          Descriptor slot allocator
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+void testDescriptorSlotAllocator()
 {
-    std::vector< int > intValues ( d_intResultBuffer.begin(), d_intResultBuffer.end() );
-    std::vector< unsigned int > uintValues ( d_uintResultBuffer.begin(), d_uintResultBuffer.end() );
-    std::vector< float > floatValues ( d_floatResultBuffer.begin(), d_floatResultBuffer.end() );
-    std::vector< double > doubleValues ( d_doubleResultBuffer.begin(), d_doubleResultBuffer.end() );
-    std::vector< int > groupValues ( d_groupResultBuffer.begin(), d_groupResultBuffer.end() );
+    vpp::DescriptorSlotAllocator allocator ( 4 );
 
-    const unsigned int intSize = d_pipeline.definition().d_intResultBufferOffset;
-    const unsigned int uintSize = d_pipeline.definition().d_uintResultBufferOffset;
-    const unsigned int floatSize = d_pipeline.definition().d_floatResultBufferOffset;
-    const unsigned int doubleSize = d_pipeline.definition().d_doubleResultBufferOffset;
+    check ( allocator.acquire() == 0 );
+    check ( allocator.acquire() == 1 );
+    check ( allocator.acquire() == 2 );
+    check ( allocator.usedCount() == 3 );
 
-    for ( unsigned int i = 0; i != intSize; ++i )
-    {
-        const int v = intValues [ i ];
-        check ( v == 1 );
-    }
+    // Released slots are reused, most recent first, before fresh ones.
 
-    for ( unsigned int i = 0; i != uintSize; ++i )
-    {
-        const unsigned int v = uintValues [ i ];
-        check ( v == 1u );
-    }
+    allocator.release ( 0 );
+    allocator.release ( 2 );
+    check ( allocator.usedCount() == 1 );
 
-    for ( unsigned int i = 0; i != floatSize; ++i )
-    {
-        const float v = floatValues [ i ];
-        check ( v == 1.0f );
-    }
+    check ( allocator.acquire() == 2 );
+    check ( allocator.acquire() == 0 );
+    check ( allocator.acquire() == 3 );
+    check ( allocator.highWaterMark() == 4 );
+    check ( allocator.usedCount() == 4 );
 
-    for ( unsigned int i = 0; i != doubleSize; ++i )
-    {
-        const double v = doubleValues [ i ];
-        check ( v == 1.0 );
-    }
+    bool bThrown = false;
 
-    for ( unsigned int i = 0; i != 20; ++i )
+    try
     {
-        const double v = groupValues [ i ];
-        check ( v == 17 );
+        allocator.acquire();
     }
-
-    for ( unsigned int i = 0; i != 10; ++i )
+    catch ( const vpp::XUsageError& )
     {
-        const double v = groupValues [ 20 + i ];
-        check ( v == (100-i) );
+        bThrown = true;
     }
 
-    for ( unsigned int i = 0; i != 10; ++i )
-    {
-        const double v = groupValues [ 30 + i ];
-        check ( v == 182 + 2*i );
-    }
+    check ( bThrown );
 
-    for ( unsigned int i = 0; i != 10; ++i )
+    // Slots never handed out can not be released.
+
+    vpp::DescriptorSlotAllocator fresh ( 4 );
+    bThrown = false;
+
+    try
     {
-        const double v = groupValues [ 40 + i ];
-        check ( v == 1 );
+        fresh.release ( 0 );
     }
-
-    for ( unsigned int i = 0; i != 10; ++i )
+    catch ( const vpp::XUsageError& )
     {
-        const double v = groupValues [ 50 + i ];
-        check ( v == 2 );
+        bThrown = true;
     }
+
+    check ( bThrown );
+    check ( fresh.usedCount() == 0 );
 }
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-//                                 Atomics tests
+//                            Mip chain generation
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-struct KAtomicsTestTypes
+class KGenerateMipmapsTest : public vpp::ComputationEngine
 {
-    static const int TEST_COUNT = 7;
-    static const int BLOCK_SIZE = 32768;
+public:
+    KGenerateMipmapsTest ( const vpp::Device& hDevice );
 
-    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer;
-    typedef vpp::gvector< std::uint64_t, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer64;
+    void run();
+
+private:
+    // Left half of the top level is black, right half is grey (200). The
+    // halves stay separate in all levels down to 2x1, the last level is
+    // their average.
+
+    static const unsigned int WIDTH = 16;
+    static const unsigned int HEIGHT = 8;
+    static const unsigned int LEVEL_COUNT = 5;
+    static const unsigned int GREY = 200;
 
-    typedef vpp::format< unsigned int > FormatU32;
-    typedef vpp::format< std::uint64_t > FormatU64;
+    typedef vpp::format< vpp::unorm8_t, vpp::unorm8_t, vpp::unorm8_t, vpp::unorm8_t > Format;
 
     typedef vpp::ImageAttributes<
-        FormatU32, vpp::RENDER, vpp::IMG_TYPE_2D,
-        vpp::Img::STORAGE | vpp::Img::TARGET,
+        Format, vpp::RENDER, vpp::IMG_TYPE_2D,
+        vpp::Img::SAMPLED | vpp::Img::SOURCE | vpp::Img::TARGET,
         VK_IMAGE_TILING_OPTIMAL, VK_SAMPLE_COUNT_1_BIT,
         false, false > TestImageAttr;
 
     typedef vpp::Image< TestImageAttr > TestImage;
-    typedef vpp::ImageViewAttributes< TestImage > TestImageViewAttr;
-    typedef vpp::ImageView< TestImageViewAttr > TestImageView;
+    typedef vpp::gvector< unsigned int, vpp::Buf::SOURCE | vpp::Buf::TARGET > PixelBuffer;
+
+    static VkExtent3D levelExtent ( std::uint32_t iLevel );
+    static unsigned int pixel ( unsigned int value );
+
+private:
+    TestImage d_image;
+    PixelBuffer d_source;
+    PixelBuffer d_levels;
+
+    vpp::Computation d_readLevels;
 };
 
 // -----------------------------------------------------------------------------
 
-class KAtomicsTestPipeline1 :
-    public vpp::ComputePipelineConfig,
-    public KAtomicsTestTypes
+KGenerateMipmapsTest :: KGenerateMipmapsTest ( const vpp::Device& hDevice ) :
+    vpp::ComputationEngine ( hDevice, vpp::Q_GRAPHICS ),
+    d_image ( { WIDTH, HEIGHT, 1 }, vpp::MemProfile::DEVICE_STATIC, hDevice, LEVEL_COUNT ),
+    d_source ( WIDTH*HEIGHT, vpp::MemProfile::DEVICE_STATIC, hDevice ),
+    d_levels ( WIDTH*HEIGHT, vpp::MemProfile::DEVICE_STATIC, hDevice )
 {
-public:
-    KAtomicsTestPipeline1 ( const vpp::Device& hDevice );
+    using namespace vpp;
 
-    void setData (
-        const DataBuffer& resultView,
-        const DataBuffer& testView,
-        const DataBuffer64& testView64,
-        const TestImageView& testImageView,
-        vpp::ShaderDataBlock* pDataBlock );
+    d_levels.resize ( WIDTH*HEIGHT );
 
-    void fComputeShader ( vpp::ComputeShader* pShader );
+    d_readLevels << [ this ]()
+    {
+        // Levels above the top one, packed one after another.
 
-public:
-    vpp::ioBuffer d_resultBuffer;
-    vpp::ioBuffer d_testBuffer;
-    vpp::ioBuffer d_testBuffer64;
-    vpp::ioImage< TestImageView > d_testImage;
-    vpp::computeShader d_shader;
-};
+        std::vector< VkBufferImageCopy > regions;
+        VkDeviceSize offset = 0;
 
-// -----------------------------------------------------------------------------
+        for ( std::uint32_t iLevel = 1; iLevel != LEVEL_COUNT; ++iLevel )
+        {
+            VkBufferImageCopy region = {};
+            region.bufferOffset = offset * sizeof ( unsigned int );
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = iLevel;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent = levelExtent ( iLevel );
+            regions.push_back ( region );
+
+            offset += region.imageExtent.width * region.imageExtent.height;
+        }
 
-KAtomicsTestPipeline1 :: KAtomicsTestPipeline1 ( const vpp::Device& hDevice ) :
-    d_shader ( this, { 32, 1, 1 }, & KAtomicsTestPipeline1::fComputeShader )
-{
+        cmdCopyImageToBuffer (
+            d_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, d_levels, regions );
+
+        cmdPipelineBarrier ( barriers (
+            Bar::TRANSFER, Bar::TRANSFER, d_levels ) );
+
+        d_levels.cmdLoadAll();
+    };
+
+    compile();
 }
 
 // -----------------------------------------------------------------------------
 
-void KAtomicsTestPipeline1 :: setData (
-    const DataBuffer& resultView,
-    const DataBuffer& testView,
-    const DataBuffer64& testView64,
-    const TestImageView& testImageView,
-    vpp::ShaderDataBlock* pDataBlock )
+VkExtent3D KGenerateMipmapsTest :: levelExtent ( std::uint32_t iLevel )
 {
-    pDataBlock->update ((
-        d_resultBuffer = resultView,
-        d_testBuffer = testView,
-        d_testBuffer64 = testView64,
-        d_testImage = testImageView
-    ));
+    return VkExtent3D {
+        std::max ( WIDTH >> iLevel, 1u ),
+        std::max ( HEIGHT >> iLevel, 1u ),
+        1u };
 }
 
 // -----------------------------------------------------------------------------
 
-void KAtomicsTestPipeline1 :: fComputeShader ( vpp::ComputeShader* pShader )
+unsigned int KGenerateMipmapsTest :: pixel ( unsigned int value )
 {
-    using namespace vpp;
+    return value | ( value << 8 ) | ( value << 16 ) | 0xFF000000u;
+}
 
-    //pShader->DebugCodeDump();
+// -----------------------------------------------------------------------------
 
-    const Int ng = pShader->inNumWorkgroups [ X ];
-    const Int nl = pShader->inWorkgroupSize [ X ];
-    const Int np = ng * nl;
-    const Int l = pShader->inLocalInvocationId [ X ];
-    const Int g = pShader->inWorkgroupId [ X ];
+void KGenerateMipmapsTest :: run()
+{
+    check ( vpp::GenerateMipmaps::fullChainLevels ( { WIDTH, HEIGHT, 1 } ) == LEVEL_COUNT );
+    check ( vpp::GenerateMipmaps::fullChainLevels ( { 1, 1, 1 } ) == 1 );
+    check ( vpp::GenerateMipmaps::fullChainLevels ( { 17, 3, 1 } ) == 5 );
+    check ( vpp::GenerateMipmaps::fullChainLevels ( { 4, 4, 32 } ) == 6 );
 
-    const Int nIterations = 10;
-    const Int nBlockSize = BLOCK_SIZE;
+    d_source.resize ( WIDTH*HEIGHT );
 
-    UniformSimpleArray< int, decltype ( d_resultBuffer ) > outBuffer ( d_resultBuffer );
-    UniformSimpleArray< int, decltype ( d_testBuffer ) > testBuffer ( d_testBuffer );
-    UniformSimpleArray< std::uint64_t, decltype ( d_testBuffer64 ) > testBuffer64 ( d_testBuffer64 );
-    UseImage ( d_testImage );
+    for ( unsigned int y = 0; y != HEIGHT; ++y )
+        for ( unsigned int x = 0; x != WIDTH; ++x )
+            d_source [ y*WIDTH + x ] = pixel ( x < WIDTH / 2 ? 0 : GREY );
 
-    WInt atomicInt = 0;
-    WUInt atomicUInt = 0;
-    WInt64 atomicInt64 = 0;
-    WUInt64 atomicUInt64 = 0;
+    d_source.commitAndWait();
 
-    VInt i;
+    VkBufferImageCopy region = {};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = levelExtent ( 0 );
 
-    For ( i, 0, nIterations );
-    {
-        const Int localIdx = ( & atomicInt ).Increment();
-        const Int globalIdx = g * nl * nIterations + localIdx;
-        outBuffer [ globalIdx ] = 1;
-    }
-    Rof();
+    vpp::CopyImageToDevice copyTopLevel (
+        d_source, d_image, { region }, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
 
-    WorkgroupBarrier();
+    vpp::GenerateMipmaps generateLevels (
+        d_image, 0, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
 
-    For ( i, 0, nIterations );
-    {
-        const UInt localIdx = ( & atomicUInt ).Increment();
-        const Int globalIdx = nBlockSize + g * nl * nIterations + Int(localIdx);
-        outBuffer [ globalIdx ] = 1;
-    }
-    Rof();
+    copyTopLevel.execute ( vpp::NO_TIMEOUT );
+    generateLevels.execute ( vpp::NO_TIMEOUT );
+    d_readLevels ( vpp::NO_TIMEOUT );
 
-    WorkgroupBarrier();
+    unsigned int offset = 0;
 
-    For ( i, 0, nIterations );
+    for ( std::uint32_t iLevel = 1; iLevel + 1 != LEVEL_COUNT; ++iLevel )
     {
-        const Int64 localIdx = ( & atomicInt64 ).Add ( 1 );
-        const Int globalIdx = 2*nBlockSize + g * nl * nIterations + Int(localIdx);
-        outBuffer [ globalIdx ] = 1;
-    }
-    Rof();
+        const VkExtent3D extent = levelExtent ( iLevel );
 
-    WorkgroupBarrier();
+        for ( unsigned int y = 0; y != extent.height; ++y )
+            for ( unsigned int x = 0; x != extent.width; ++x )
+                check ( d_levels [ offset + y*extent.width + x ]
+                        == pixel ( x < extent.width / 2 ? 0 : GREY ) );
 
-    For ( i, 0, nIterations );
-    {
-        const UInt64 localIdx = ( & atomicUInt64 ).Increment();
-        const Int globalIdx = 3*nBlockSize + g * nl * nIterations + Int(localIdx);
-        outBuffer [ globalIdx ] = 1;
+        offset += extent.width * extent.height;
     }
-    Rof();
 
-    WorkgroupBarrier();
+    // Filtering may round either way.
 
-    For ( i, 0, nIterations );
-    {
-        const Int localIdx = ( & testBuffer [ 0 ] ).Increment();
-        const Int globalIdx = 4*nBlockSize + localIdx;
-        outBuffer [ globalIdx ] = 1;
-    }
-    Rof();
+    const unsigned int last = d_levels [ offset ];
+    const unsigned int red = last & 0xFF;
 
-    WorkgroupBarrier();
-
-    For ( i, 0, nIterations );
-    {
-        const UInt localIdx = d_testImage.GetPointer ( IVec2 { 0, 0 } ).Increment();
-        const Int globalIdx = 5*nBlockSize + Int(localIdx);
-        outBuffer [ globalIdx ] = 1;
-    }
-    Rof();
+    check ( red >= GREY / 2 - 1 && red <= GREY / 2 + 1 );
+    check ( last == pixel ( red ) );
+}
 
-    WorkgroupBarrier();
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
 
-    For ( i, 0, nIterations );
-    {
-        const Pointer< UInt64 > p = & testBuffer64 [ 0 ];
-        const UInt64 localIdx = p.Increment();
-        const Int globalIdx = 6*nBlockSize + Int(localIdx);
-        outBuffer [ globalIdx ] = 1;
-    }
-    Rof();
-}
+//                               Culling stage
 
+// -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-class KAtomicsTest :
-    public vpp::Computation,
-    public KAtomicsTestTypes
+class KCullingTest : public vpp::ComputationEngine
 {
 public:
-    KAtomicsTest ( vpp::Computation& pred, const vpp::Device& hDevice );
+    KCullingTest ( const vpp::Device& hDevice );
 
-    void compareResults();
+    void run();
 
 private:
-    vpp::ComputePipelineLayout< KAtomicsTestPipeline1 > d_pipeline;
-    vpp::ShaderDataBlock d_dataBlock;
+    static const unsigned int MAX_DRAW_COUNT = 8;
 
-    DataBuffer d_resultBuffer;
-    DataBuffer d_testBuffer;
-    DataBuffer64 d_testBuffer64;
-    TestImage d_testImage;
-    TestImageView d_testImageView;
+    void initScene();
+    void addInstance ( const vpp::vect4& sphere, unsigned int lodCount );
+
+private:
+    vpp::CullingFrameBuffer d_frame;
+    vpp::CullingInstanceBuffer d_instances;
+    vpp::CullingLodBuffer d_lods;
+    vpp::IndexedIndirectCommands d_commands;
+    vpp::DrawCountBuffer d_drawCount;
+    vpp::CullingStage d_culling;
+
+    vpp::Computation d_cull;
 };
 
 // -----------------------------------------------------------------------------
 
-KAtomicsTest :: KAtomicsTest ( vpp::Computation& pred, const vpp::Device& hDevice ) :
-    vpp::Computation ( pred ),
-    d_pipeline ( hDevice ),
-    d_dataBlock ( d_pipeline ),
-    d_resultBuffer ( TEST_COUNT*BLOCK_SIZE, vpp::MemProfile::DEVICE_STATIC, hDevice ),
-    d_testBuffer ( 16, vpp::MemProfile::DEVICE_STATIC, hDevice ),
-    d_testBuffer64 ( 16, vpp::MemProfile::DEVICE_STATIC, hDevice ),
-    d_testImage ( { 256, 1, 1 }, vpp::MemProfile::DEVICE_STATIC, hDevice ),
-    d_testImageView ( d_testImage )
+KCullingTest :: KCullingTest ( const vpp::Device& hDevice ) :
+    vpp::ComputationEngine ( hDevice, vpp::Q_GRAPHICS ),
+    d_frame ( 1, vpp::MemProfile::HOST_STATIC, hDevice ),
+    d_instances ( 8, vpp::MemProfile::HOST_STATIC, hDevice ),
+    d_lods ( 2, vpp::MemProfile::HOST_STATIC, hDevice ),
+    d_commands ( MAX_DRAW_COUNT, vpp::MemProfile::HOST_STATIC, hDevice ),
+    d_drawCount ( 1, vpp::MemProfile::HOST_STATIC, hDevice ),
+    d_culling ( hDevice )
 {
-    using namespace vpp;
-
-    d_pipeline.definition().setData (
-        d_resultBuffer, d_testBuffer, d_testBuffer64,
-        d_testImageView, & d_dataBlock );
+    d_commands.resize ( MAX_DRAW_COUNT );
+    d_drawCount.resize ( 1 );
 
-    addPipeline ( d_pipeline );
+    initScene();
 
-    d_resultBuffer.resize ( TEST_COUNT*BLOCK_SIZE );
+    d_culling.setData ( d_frame, d_instances, d_lods, d_commands, d_drawCount );
 
-    ( *this ) << [ this ]()
+    d_cull << [ this ]()
     {
-        cmdFillBuffer ( d_resultBuffer, 0, TEST_COUNT*BLOCK_SIZE*sizeof ( unsigned int ), 0 );
-        cmdFillBuffer ( d_testBuffer, 0, 16*sizeof ( unsigned int ), 0 );
-        cmdFillBuffer ( d_testBuffer64, 0, 16*sizeof ( std::uint64_t ), 0 );
-        cmdClearColorImage ( d_testImage, clearColor ( 0, 0, 0 ) );
+        d_culling.cmdCull ( static_cast< std::uint32_t >( d_instances.size() ) );
+        d_commands.cmdLoadAll();
+        d_drawCount.cmdLoadAll();
+    };
 
-        cmdPipelineBarrier ( barriers (
-            Bar::TRANSFER, Bar::COMPUTE,
-            d_resultBuffer, d_testBuffer, d_testBuffer64, d_testImage ) );
+    compile();
+}
 
-        d_dataBlock.cmdBind();
-        pipeline ( 0 ).cmdBind();
-        cmdDispatch ( 64, 1, 1 );
+// -----------------------------------------------------------------------------
 
-        cmdPipelineBarrier ( barriers (
-            Bar::COMPUTE, Bar::TRANSFER, 
-            d_resultBuffer ) );
+void KCullingTest :: addInstance ( const vpp::vect4& sphere, unsigned int lodCount )
+{
+    vpp::CCullingInstance instance;
+    instance.m_sphere = sphere;
+    instance.m_mesh = vpp::uvect4 (
+        0, lodCount, static_cast< unsigned int >( d_instances.size() ), 0 );
 
-        d_resultBuffer.cmdLoadAll();
-    };
+    d_instances.push_back ( instance );
 }
 
 // -----------------------------------------------------------------------------
 
-void KAtomicsTest :: compareResults()
+void KCullingTest :: initScene()
 {
-    std::vector< unsigned int > values ( d_resultBuffer.begin(), d_resultBuffer.end() );
+    using namespace vpp;
 
-    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
-        check ( values [ i ] == static_cast< unsigned int >( i < 20480 ) );
+    // Frustum is the box -10..10 around the camera.
+
+    CCullingFrame frame;
+    frame.m_leftPlane = vect4 ( 1.0f, 0.0f, 0.0f, 10.0f );
+    frame.m_rightPlane = vect4 ( -1.0f, 0.0f, 0.0f, 10.0f );
+    frame.m_bottomPlane = vect4 ( 0.0f, 1.0f, 0.0f, 10.0f );
+    frame.m_topPlane = vect4 ( 0.0f, -1.0f, 0.0f, 10.0f );
+    frame.m_nearPlane = vect4 ( 0.0f, 0.0f, 1.0f, 10.0f );
+    frame.m_farPlane = vect4 ( 0.0f, 0.0f, -1.0f, 10.0f );
+    frame.m_cameraPosition = vect4 ( 0.0f, 0.0f, 0.0f, 1.0f );
+    frame.m_pyramidSize = vect4 ( 0.0f, 0.0f, 0.0f, 0.0f );
+    d_frame.push_back ( frame );
+
+    // Detailed LOD up to distance 5, coarse one beyond.
+
+    CCullingLod lod;
+    lod.m_range = uvect4 ( 100, 0, 0, 0 );
+    lod.m_params = vect4 ( 5.0f, 0.0f, 0.0f, 0.0f );
+    d_lods.push_back ( lod );
+
+    lod.m_range = uvect4 ( 30, 100, 0, 0 );
+    lod.m_params = vect4 ( 1000.0f, 0.0f, 0.0f, 0.0f );
+    d_lods.push_back ( lod );
+
+    addInstance ( vect4 ( 0.0f, 0.0f, 0.0f, 1.0f ), 2 );    // near, detailed
+    addInstance ( vect4 ( 8.0f, 0.0f, 0.0f, 1.0f ), 2 );    // far, coarse
+    addInstance ( vect4 ( 20.0f, 0.0f, 0.0f, 1.0f ), 2 );   // outside
+    addInstance ( vect4 ( 10.5f, 0.0f, 0.0f, 1.0f ), 2 );   // crossing a plane
+    addInstance ( vect4 ( 0.0f, 0.0f, 0.0f, 1.0f ), 0 );    // disabled
+}
 
-    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
-        check ( values [ i + BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+// -----------------------------------------------------------------------------
 
-    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
-        check ( values [ i + 2*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+void KCullingTest :: run()
+{
+    d_frame.commitAndWait();
+    d_instances.commitAndWait();
+    d_lods.commitAndWait();
 
-    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
-        check ( values [ i + 3*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+    d_cull ( vpp::NO_TIMEOUT );
 
-    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
-        check ( values [ i + 4*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+    const unsigned int drawCount = d_drawCount [ 0 ];
+    check ( drawCount == 3 );
 
-    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
-        check ( values [ i + 5*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+    // Order of appended commands is not defined.
 
-    for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
-        check ( values [ i + 6*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+    std::map< std::uint32_t, VkDrawIndexedIndirectCommand > draws;
 
-    //for ( unsigned int i = 0; i != BLOCK_SIZE; ++i )
-    //    check ( values [ i + 7*BLOCK_SIZE ] == static_cast< unsigned int >( i < 20480 ) );
+    for ( unsigned int i = 0; i != drawCount && i != MAX_DRAW_COUNT; ++i )
+        draws [ d_commands [ i ].firstInstance ] = d_commands [ i ];
+
+    check ( draws.size() == 3 );
+    check ( draws.count ( 0 ) && draws [ 0 ].indexCount == 100 && draws [ 0 ].firstIndex == 0 );
+    check ( draws.count ( 1 ) && draws [ 1 ].indexCount == 30 && draws [ 1 ].firstIndex == 100 );
+    check ( draws.count ( 3 ) && draws [ 3 ].indexCount == 30 && draws [ 3 ].firstIndex == 100 );
+
+    for ( const auto& iDraw : draws )
+    {
+        check ( iDraw.second.instanceCount == 1 );
+        check ( iDraw.second.vertexOffset == 0 );
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -6335,6 +4440,11 @@ public:
     KGroupAlgorithms2Test testGroupAlgorithms2;
     KGroupVariablesTest testGroupVariables;
     KAtomicsTest testAtomics;
+    KDescriptorUpdateTest testDescriptorUpdates;
+    KMatrixOperationsTest testMatrixOperations;
+    KReadbackTest testReadback;
+    KLoopControlTest testLoopControls;
+    KSpecializationTest testSpecialization;
 };
 
 // -----------------------------------------------------------------------------
@@ -6360,7 +4470,12 @@ KTests :: KTests ( const vpp::Device& hDevice ) :
     testGroupAlgorithms ( testLocalArrays, hDevice ),
     testGroupAlgorithms2 ( testGroupAlgorithms, hDevice ),
     testGroupVariables ( testGroupAlgorithms2, hDevice ),
-    testAtomics ( testGroupVariables, hDevice )
+    testAtomics ( testGroupVariables, hDevice ),
+    testDescriptorUpdates ( testAtomics, hDevice ),
+    testMatrixOperations ( testDescriptorUpdates, hDevice ),
+    testReadback ( testMatrixOperations, hDevice ),
+    testLoopControls ( testReadback, hDevice ),
+    testSpecialization ( testLoopControls, hDevice )
 {
     compile();
 }
@@ -6420,6 +4535,8 @@ int main()
     feat.enableIfSupported ( fShaderInt64, phd );
     feat.enableIfSupported ( fShaderStorageImageExtendedFormats, phd );
     feat.enableIfSupported ( fShaderFloat64, phd );
+    feat.enableIfSupported ( fShaderInt16, phd );
+    feat.enableIfSupported ( fStorageBuffer16BitAccess, phd );
 
     feat.enableIfSupported ( fShaderBufferInt64Atomics, phd );
     feat.enableIfSupported ( fShaderSharedInt64Atomics, phd );
@@ -6451,6 +4568,12 @@ int main()
     testObject.testGroupAlgorithms2();
     testObject.testGroupVariables();
     testObject.testAtomics ( NO_TIMEOUT );
+    testObject.testDescriptorUpdates();
+    testObject.testMatrixOperations();
+    testObject.testReadback();
+    testObject.testReadback.readBack();
+    testObject.testLoopControls ( NO_TIMEOUT );
+    testObject.testSpecialization ( NO_TIMEOUT );
 
     testObject.testFloat.compareResults();
     testObject.testVec2.compareResults();
@@ -6472,6 +4595,43 @@ int main()
     testObject.testGroupAlgorithms2.compareResults();
     testObject.testGroupVariables.compareResults();
     testObject.testAtomics.compareResults();
+    testObject.testDescriptorUpdates.compareResults();
+    testObject.testMatrixOperations.compareResults();
+    testObject.testReadback.compareResults();
+    testObject.testLoopControls.compareResults();
+    testObject.testSpecialization.compareResults();
+
+    // Recompiled once, to check that a graph can be rebuilt and rerun.
+
+    KComputationGraphTest testGraph ( dev );
+    testGraph ( NO_TIMEOUT );
+    testGraph.compile();
+    testGraph ( NO_TIMEOUT );
+    testGraph.compareResults();
+
+    testComputationGraphCycle ( dev );
+    testCommandBufferAllocator ( dev );
+    testLayoutCache ( dev );
+    testSamplerCache ( dev );
+    testDescriptorSlotAllocator();
+
+    KDebugPrintTest testDebugPrint ( dev );
+    testDebugPrint.run();
+
+    testWriteCombinedCopy();
+    testPersistentMapping ( dev );
+
+    KGenerateMipmapsTest testGenerateMipmaps ( dev );
+    testGenerateMipmaps.run();
+
+    KCullingTest testCulling ( dev );
+    testCulling.run();
+
+    if ( dev.hasFeature ( fShaderInt16 ) && dev.hasFeature ( fStorageBuffer16BitAccess ) )
+    {
+        KNarrowIntegerTest testNarrowIntegers ( dev );
+        testNarrowIntegers.run();
+    }
 
     std::string vl = validationLog.str();
 
@@ -0,0 +1,2507 @@
+// -----------------------------------------------------------------------------
+
+#pragma warning (disable: 4503)
+#include "vppTestComputationPipelines.hpp"
+
+// -----------------------------------------------------------------------------
+namespace vpptest {
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                        Test vector float functions
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KVectorTestPipeline :: KVectorTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KVectorTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KVectorTestPipeline :: setData (
+    const vpp::StorageBufferView& vs1,
+    const vpp::StorageBufferView& vs2,
+    const vpp::StorageBufferView& vt,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_source1 = vs1,
+        d_source2 = vs2,
+        d_target = vt
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KVectorTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    TTestTypeTraits< vect4 > tt;
+
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+    const IVec3 localId = pShader->inLocalInvocationId;
+    const Int g = workgroupId [ X ];
+    const Int l = localId [ X ];
+
+    UniformSimpleArray< vect4, decltype ( d_source1 ) > inSource1 ( d_source1 );
+    UniformSimpleArray< vect4, decltype ( d_source2 ) > inSource2 ( d_source2 );
+    UniformSimpleArray< vect4, decltype ( d_target ) > outTarget ( d_target );
+
+    If ( g == 0 && l == 0 );
+    {
+        // ----------------------------------------------------------------------
+
+        const Float dot2 = Dot ( inSource1 [ VT_DOT2 ][ XY ], inSource2 [ VT_DOT2 ][ XY ] );
+        outTarget [ VT_DOT2 ] = tt.create ( dot2 );
+
+        const Float dot3 = Dot ( inSource1 [ VT_DOT3 ][ XYZ ], inSource2 [ VT_DOT3 ][ XYZ ] );
+        outTarget [ VT_DOT3 ] = tt.create ( dot3 );
+
+        const Float dot4 = Dot ( inSource1 [ VT_DOT4 ], inSource2 [ VT_DOT4 ] );
+        outTarget [ VT_DOT4 ] = tt.create ( dot4 );
+
+        // ----------------------------------------------------------------------
+
+        const Mat4 op4 = OuterProduct ( inSource1 [ VT_OPDET4 ], inSource2 [ VT_OPDET4 ] );
+        const Float opdet4 = Determinant ( op4 );
+        outTarget [ VT_OPDET4 ] = tt.create ( opdet4 );
+
+        const Mat3 op3 = OuterProduct ( inSource1 [ VT_OPDET3 ][ XYZ ], inSource2 [ VT_OPDET3 ][ XYZ ] );
+        const Float opdet3 = Determinant ( op3 );
+        outTarget [ VT_OPDET3 ] = tt.create ( opdet3 );
+
+        const Mat2 op2 = OuterProduct ( inSource1 [ VT_OPDET2 ][ XY ], inSource2 [ VT_OPDET2 ][ XY ] );
+        const Float opdet2 = Determinant ( op2 );
+        outTarget [ VT_OPDET2 ] = tt.create ( opdet2 );
+
+        // ----------------------------------------------------------------------
+
+        const Float dist4 = Distance ( inSource1 [ VT_DISTANCE4 ], inSource2 [ VT_DISTANCE4 ] );
+        outTarget [ VT_DISTANCE4 ] = tt.create ( dist4 );
+
+        const Float dist3 = Distance ( inSource1 [ VT_DISTANCE3 ], inSource2 [ VT_DISTANCE3 ] );
+        outTarget [ VT_DISTANCE3 ] = tt.create ( dist3 );
+
+        const Float dist2 = Distance ( inSource1 [ VT_DISTANCE2 ], inSource2 [ VT_DISTANCE2 ] );
+        outTarget [ VT_DISTANCE2 ] = tt.create ( dist2 );
+
+        // ----------------------------------------------------------------------
+
+        const Float len4 = Length ( inSource1 [ VT_LENGTH4 ] );
+        outTarget [ VT_LENGTH4 ] = tt.create ( len4 );
+
+        const Float len3 = Length ( inSource1 [ VT_LENGTH3 ] );
+        outTarget [ VT_LENGTH3 ] = tt.create ( len3 );
+
+        const Float len2 = Length ( inSource1 [ VT_LENGTH2 ] );
+        outTarget [ VT_LENGTH2 ] = tt.create ( len2 );
+
+        // ----------------------------------------------------------------------
+
+        const Vec4 norm4 = Normalize ( inSource1 [ VT_NORMALIZE4 ] );
+        outTarget [ VT_NORMALIZE4 ] = norm4;
+
+        const Vec3 norm3 = Normalize ( inSource1 [ VT_NORMALIZE3 ][ XYZ ] );
+        outTarget [ VT_NORMALIZE3 ] = Vec4 ( norm3, 0.0f );
+
+        const Vec2 norm2 = Normalize ( inSource1 [ VT_NORMALIZE2 ][ XY ] );
+        outTarget [ VT_NORMALIZE2 ] = Vec4 ( norm2, 0.0f, 0.0f );
+
+        // ----------------------------------------------------------------------
+
+        const Vec4 refr4 = Refract ( inSource1 [ VT_REFRACT4 ], inSource2 [ VT_REFRACT4 ], 0.5f );
+        outTarget [ VT_REFRACT4 ] = refr4;
+
+        const Vec3 refr3 = Refract ( inSource1 [ VT_REFRACT3 ][ XYZ ], inSource2 [ VT_REFRACT3 ][ XYZ ], 0.5f );
+        outTarget [ VT_REFRACT3 ] = Vec4 ( refr3, 0.0f );
+
+        const Vec2 refr2 = Refract ( inSource1 [ VT_REFRACT2 ][ XY ], inSource2 [ VT_REFRACT2 ][ XY ], 0.5f );
+        outTarget [ VT_REFRACT2 ] = Vec4 ( refr2, 0.0f, 0.0f );
+
+        // ----------------------------------------------------------------------
+
+        const Vec4 refl4 = Reflect ( inSource1 [ VT_REFLECT4 ], inSource2 [ VT_REFLECT4 ] );
+        outTarget [ VT_REFLECT4 ] = refl4;
+
+        const Vec3 refl3 = Reflect ( inSource1 [ VT_REFLECT3 ][ XYZ ], inSource2 [ VT_REFLECT3 ][ XYZ ] );
+        outTarget [ VT_REFLECT3 ] = Vec4 ( refl3, 0.0f );
+
+        const Vec2 refl2 = Reflect ( inSource1 [ VT_REFLECT2 ][ XY ], inSource2 [ VT_REFLECT2 ][ XY ] );
+        outTarget [ VT_REFLECT2 ] = Vec4 ( refl2, 0.0f, 0.0f );
+
+        // ----------------------------------------------------------------------
+
+        const Vec4 ffwd4 = Reflect ( inSource1 [ VT_FACEFORWARD4 ], inSource2 [ VT_FACEFORWARD4 ] );
+        outTarget [ VT_FACEFORWARD4 ] = ffwd4;
+
+        const Vec3 ffwd3 = Reflect ( inSource1 [ VT_FACEFORWARD3 ][ XYZ ], inSource2 [ VT_FACEFORWARD3 ][ XYZ ] );
+        outTarget [ VT_FACEFORWARD3 ] = Vec4 ( ffwd3, 0.0f );
+
+        const Vec2 ffwd2 = Reflect ( inSource1 [ VT_FACEFORWARD2 ][ XY ], inSource2 [ VT_FACEFORWARD2 ][ XY ] );
+        outTarget [ VT_FACEFORWARD2 ] = Vec4 ( ffwd2, 0.0f, 0.0f );
+
+        // ----------------------------------------------------------------------
+    }
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                         Programming constructs tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+GFunGCD :: GFunGCD() :
+    vpp::Function< vpp::Int, vpp::Int, vpp::Int >( "gcd" )
+{
+    using namespace vpp;
+
+    Begin();
+    {
+        VInt x = _n;
+        VInt y = _k;
+        VInt s = 0;
+        VInt t = 0;
+
+        If ( x < y );
+            t = x;
+            x = y;
+            y = t;
+        Fi();
+
+        Do(); While ( ( ( x & 1 ) | ( y & 1 ) ) == 0 );
+            x >>= 1u;
+            y >>= 1u;
+            ++s;
+        Od();
+
+        Do(); While ( x != 0 );
+        {
+            Do(); While ( ( x & 1 ) == 0 );
+                x >>= 1u;
+            Od();
+
+            Do(); While ( ( y & 1 ) == 0 );
+                y >>= 1u;
+            Od();
+
+            If ( x >= y );
+                x = ( x - y ) >> 1u;
+            Else();
+                y = ( y - x ) >> 1u;
+            Fi();
+        }
+        Od();
+
+        Return ( y << s );
+    }
+    End();
+}
+
+// -----------------------------------------------------------------------------
+
+KConstructTestPipeline :: KConstructTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KConstructTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KConstructTestPipeline :: setData (
+    const vpp::StorageBufferView& vs1,
+    const vpp::StorageBufferView& vs2,
+    const vpp::StorageBufferView& vt,
+    int size,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_source1 = vs1,
+        d_source2 = vs2,
+        d_target = vt
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KConstructTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+    const IVec3 localId = pShader->inLocalInvocationId;
+    const Int g = workgroupId [ X ];
+    const Int l = localId [ X ];
+
+    UniformSimpleArray< int, decltype ( d_source1 ) > inSource1 ( d_source1 );
+    UniformSimpleArray< int, decltype ( d_source2 ) > inSource2 ( d_source2 );
+    UniformSimpleArray< int, decltype ( d_target ) > outTarget ( d_target );
+
+    Function< Int, Int > factorial ( "factorial" );
+        Par< Int > factX;
+    Begin();
+    {
+        VInt t = 0;
+        VInt r = 1;
+
+        For ( t, 2, factX+1 );
+            r *= t;
+        Rof();
+
+        Return ( r );
+    }
+    End();
+
+    Function< Int, Int, Int > binomial ( "binomial" );
+    {
+        Par< Int > n;
+        Par< Int > k;
+        Begin();
+        {
+            Return ( factorial ( n ) / ( factorial ( k )*factorial ( n-k ) ) );
+        }
+        End();
+    }
+
+    GFunGCD gcd;
+
+    If ( g == 0 && l == 0 );
+    {
+        // ----------------------------------------------------------------------
+
+        outTarget [ CT_SELECT1 ] = Select ( true, inSource1 [ CT_SELECT1 ], inSource2 [ CT_SELECT1 ] );
+        outTarget [ CT_SELECT2 ] = Select ( false, inSource1 [ CT_SELECT2 ], inSource2 [ CT_SELECT2 ] );
+        outTarget [ CT_SELECT3 ] = Select (
+            inSource1 [ CT_SELECT3 ] < inSource2 [ CT_SELECT3 ],
+            inSource1 [ CT_SELECT3 ], inSource2 [ CT_SELECT3 ] );
+
+        // ----------------------------------------------------------------------
+
+        for ( unsigned int i = CT_IF0; i <= CT_IF1; ++i )
+        {
+            If ( inSource1 [ i ] < 100 );
+            {
+                const Int t = inSource2 [ i ];
+                const Int result = t + t + t;
+                outTarget [ i ] = result;
+            }
+            Else();
+            {
+                const Int t = inSource2 [ i ];
+                const Int result = t * t;
+                outTarget [ i ] = result;
+            }
+            Fi();
+        }
+
+        // ----------------------------------------------------------------------
+
+        // Binary GCD algorithm.
+
+        VInt x = inSource1 [ CT_DOWHILE ];
+        VInt y = inSource2 [ CT_DOWHILE ];
+        VInt s = 0;
+        VInt t = 0;
+
+        If ( x < y );
+            t = x;
+            x = y;
+            y = t;
+        Fi();
+
+        Do(); While ( ( ( x & 1 ) | ( y & 1 ) ) == 0 );
+            x >>= 1u;
+            y >>= 1u;
+            ++s;
+        Od();
+
+        Do(); While ( x != 0 );
+        {
+            Do(); While ( ( x & 1 ) == 0 );
+                x >>= 1u;
+            Od();
+
+            Do(); While ( ( y & 1 ) == 0 );
+                y >>= 1u;
+            Od();
+
+            If ( x >= y );
+                x = ( x - y ) >> 1u;
+            Else();
+                y = ( y - x ) >> 1u;
+            Fi();
+        }
+        Od();
+
+        outTarget [ CT_DOWHILE ] = y << s;
+
+        // ----------------------------------------------------------------------
+
+        for ( unsigned int i = CT_FOR0; i <= CT_FOR2; ++i )
+        {
+            const Int max = inSource1 [ i ];
+            const Int step = inSource2 [ i ];
+            y = 0;
+
+            For ( x, 0, max, step );
+                y += x;
+            Rof();
+
+            outTarget [ i ] = y;
+        }
+
+        // ----------------------------------------------------------------------
+
+        for ( unsigned int i = CT_SWITCH0; i <= CT_SWITCH2; ++i )
+        {
+            const Int c = inSource1 [ i ];
+
+            Switch ( c );
+                Case ( 0 );
+                    x = factorial ( 5 );
+                    Break();
+
+                Case ( 1 );
+                    x = binomial ( 6, 2 );
+                    Break();
+
+                Default();
+                    x = gcd ( 17*19, 17*23 );
+                    Break();
+            EndSwitch();
+
+            outTarget [ i ] = x;
+        }
+
+        // ----------------------------------------------------------------------
+
+        outTarget [ CT_CAST0 ] = StaticCast< Int >( 
+            StaticCast< Float >( inSource1 [ CT_CAST0 ] ) * 0.1f );
+
+        outTarget [ CT_CAST1 ] = ReinterpretCast< Int >( Float ( 1.0f ) );
+
+        // ----------------------------------------------------------------------
+
+        outTarget [ CT_FUNCTION1 ] = factorial ( inSource1 [ CT_FUNCTION1 ] );
+        outTarget [ CT_FUNCTION2 ] = binomial ( inSource1 [ CT_FUNCTION2 ], inSource2 [ CT_FUNCTION2 ] );
+    }
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                 Indexing tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KIndexingTestPipeline :: KIndexingTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KIndexingTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KIndexingTestPipeline :: setData (
+    const vpp::StorageBufferView& vs1,
+    const vpp::StorageBufferView& vs2,
+    const vpp::StorageBufferView& vt,
+    int size,
+    const vpp::StorageBufferView& tb1,
+    const vpp::StorageBufferView& tb2,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_source1 = vs1,
+        d_source2 = vs2,
+        d_target = vt,
+        d_uniTestBuf1 = tb1,
+        d_storTestBuf1 = tb2
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+template< class VecT >
+inline vpp::Int testSwizzle ( const VecT& v, vpp::ESwizzle2 s )
+{
+    using namespace vpp;
+    const IVec2 swizzled = v [ s ];
+    return swizzled [ 0 ] | ( swizzled [ 1 ] << 2 );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class VecT >
+inline vpp::Int testSwizzle ( const VecT& v, vpp::ESwizzle3 s )
+{
+    using namespace vpp;
+    const IVec3 swizzled = v [ s ];
+    return swizzled [ 0 ] | ( swizzled [ 1 ] << 2 ) | ( swizzled [ 2 ] << 4 );
+}
+
+// -----------------------------------------------------------------------------
+
+template< class VecT >
+inline vpp::Int testSwizzle ( const VecT& v, vpp::ESwizzle4 s )
+{
+    using namespace vpp;
+    const IVec4 swizzled = v [ s ];
+    return swizzled [ 0 ] | ( swizzled [ 1 ] << 2 ) | ( swizzled [ 2 ] << 4 ) | ( swizzled [ 3 ] << 6 );
+}
+
+// -----------------------------------------------------------------------------
+
+void KIndexingTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+    const IVec3 localId = pShader->inLocalInvocationId;
+    const Int g = workgroupId [ X ];
+    const Int l = localId [ X ];
+
+    UniformSimpleArray< int, decltype ( d_source1 ) > inSource1 ( d_source1 );
+    UniformSimpleArray< int, decltype ( d_source2 ) > inSource2 ( d_source2 );
+    UniformSimpleArray< int, decltype ( d_target ) > outTarget ( d_target );
+
+    UniformVar< TTestStruct, decltype ( d_uniTestBuf1 ) > inUniTestBuf1 ( d_uniTestBuf1 );
+    UniformVar< TTestStruct, decltype ( d_storTestBuf1 ) > inStorTestBuf1 ( d_storTestBuf1 );
+
+    VArray< Int > intArray ( 5 );
+    intArray [ 0 ] = 0;
+    intArray [ 1 ] = 1;
+    intArray [ 2 ] = 4;
+    intArray [ 3 ] = 9;
+    intArray [ 4 ] = 16;
+
+    WArray< Int > sharedIntArray ( 5 );
+    sharedIntArray [ 0 ] = 0;
+    sharedIntArray [ 1 ] = 0;
+    sharedIntArray [ 2 ] = 0;
+    sharedIntArray [ 3 ] = 0;
+    sharedIntArray [ 4 ] = 0;
+
+    VInt vidx;
+
+    If ( g == 0 && l == 0 );
+    {
+        const Int idx1 = inSource1 [ XT_LOCALARR1 ];
+        outTarget [ XT_LOCALARR1 ] = intArray [ idx1 ];
+
+        const UInt idx2 = StaticCast< UInt >( inSource1 [ XT_LOCALARR2 ] );
+        outTarget [ XT_LOCALARR2 ] = intArray [ idx2 ];
+
+        outTarget [ XT_LOCALARR3 ] = intArray [ inSource1 [ XT_LOCALARR3 ] ];
+
+        intArray [ inSource1 [ XT_LOCALARR4 ] ] = intArray [ inSource2 [ XT_LOCALARR4 ] ];
+        outTarget [ XT_LOCALARR4 ] = intArray [ inSource1 [ XT_LOCALARR4 ] ];
+
+        outTarget [ XT_LOCALARR5 ] =
+            intArray [ inSource1 [ XT_LOCALARR5 ] ]
+            + intArray [ inSource2 [ XT_LOCALARR5 ] ];
+
+        sharedIntArray [ 0 ] = 1;
+        sharedIntArray [ 1 ] = 2;
+        sharedIntArray [ 2 ] = 3;
+        sharedIntArray [ 3 ] = 5;
+        sharedIntArray [ 4 ] = 7;
+    }
+    Fi();
+
+    If ( g == 0 && l == 1 );
+    {
+        outTarget [ XT_SHAREDARR1 ] = sharedIntArray [ inSource1 [ XT_SHAREDARR1 ] ];
+        outTarget [ XT_SHAREDARR2 ] = sharedIntArray [ inSource1 [ XT_SHAREDARR2 ] ];
+        outTarget [ XT_SHAREDARR3 ] = sharedIntArray [ inSource1 [ XT_SHAREDARR3 ] ];
+    }
+    Fi();
+
+    If ( g == 0 && l == 0 );
+    {
+        // normal
+
+        IVec2 ivec2 { 11, 13 };
+        outTarget [ XT_VECTORS1 ] = ivec2 [ 1 ];
+        const Int idx2 = inSource1 [ XT_VECTORS2 ];
+        outTarget [ XT_VECTORS2 ] = ivec2 [ idx2 ];
+        outTarget [ XT_VECTORS3 ] = ivec2 [ inSource1 [ XT_VECTORS3 ] ];
+
+        IVec3 ivec3 { 17, 19, 23 };
+        outTarget [ XT_VECTORS4 ] = ivec3 [ 1 ];
+        const Int idx3 = inSource1 [ XT_VECTORS5 ];
+        outTarget [ XT_VECTORS5 ] = ivec3 [ idx3 ];
+        outTarget [ XT_VECTORS6 ] = ivec3 [ inSource1 [ XT_VECTORS6 ] ];
+
+        IVec4 ivec4 { 29, 31, 37, 41 };
+        outTarget [ XT_VECTORS7 ] = ivec4 [ 1 ];
+        const Int idx4 = inSource1 [ XT_VECTORS8 ];
+        outTarget [ XT_VECTORS8 ] = ivec4 [ idx4 ];
+        outTarget [ XT_VECTORS9 ] = ivec4 [ inSource1 [ XT_VECTORS9 ] ];
+
+        VIVec2 vivec2 = ivec2;
+        outTarget [ XT_VECTORS10 ] = vivec2 [ 1 ];
+        const Int idx5 = inSource1 [ XT_VECTORS11 ];
+        outTarget [ XT_VECTORS11 ] = vivec2 [ idx5 ];
+        outTarget [ XT_VECTORS12 ] = vivec2 [ inSource1 [ XT_VECTORS12 ] ];
+
+        VIVec3 vivec3;
+        vivec3 = ivec3;
+        outTarget [ XT_VECTORS13 ] = vivec3 [ 1 ];
+        const Int idx6 = inSource1 [ XT_VECTORS14 ];
+        outTarget [ XT_VECTORS14 ] = vivec3 [ idx6 ];
+        outTarget [ XT_VECTORS15 ] = vivec3 [ inSource1 [ XT_VECTORS15 ] ];
+
+        VIVec4 vivec4 { 1, 1, 1, 1 };
+
+        For ( vidx, 0, 4 );
+            vivec4 [ vidx ] = ivec4 [ vidx ];
+        Rof();
+
+        outTarget [ XT_VECTORS16 ] = vivec4 [ 1 ];
+        const Int idx7 = inSource1 [ XT_VECTORS17 ];
+        outTarget [ XT_VECTORS17 ] = vivec4 [ idx7 ];
+        outTarget [ XT_VECTORS18 ] = vivec4 [ inSource1 [ XT_VECTORS18 ] ];
+
+        // swizzled reads
+
+        outTarget [ XT_VECSWIZZLE1_begin + 0 ] = ivec2 [ X ];
+        outTarget [ XT_VECSWIZZLE1_begin + 1 ] = ivec2 [ Y ];
+        outTarget [ XT_VECSWIZZLE1_begin + 2 ] = ivec3 [ X ];
+        outTarget [ XT_VECSWIZZLE1_begin + 3 ] = ivec3 [ Y ];
+        outTarget [ XT_VECSWIZZLE1_begin + 4 ] = ivec3 [ Z ];
+        outTarget [ XT_VECSWIZZLE1_begin + 5 ] = ivec4 [ X ];
+        outTarget [ XT_VECSWIZZLE1_begin + 6 ] = ivec4 [ Y ];
+        outTarget [ XT_VECSWIZZLE1_begin + 7 ] = ivec4 [ Z ];
+        outTarget [ XT_VECSWIZZLE1_begin + 8 ] = ivec4 [ W ];
+        outTarget [ XT_VVECSWIZZLE1_begin + 0 ] = vivec2 [ X ];
+        outTarget [ XT_VVECSWIZZLE1_begin + 1 ] = vivec2 [ Y ];
+        outTarget [ XT_VVECSWIZZLE1_begin + 2 ] = vivec3 [ X ];
+        outTarget [ XT_VVECSWIZZLE1_begin + 3 ] = vivec3 [ Y ];
+        outTarget [ XT_VVECSWIZZLE1_begin + 4 ] = vivec3 [ Z ];
+        outTarget [ XT_VVECSWIZZLE1_begin + 5 ] = vivec4 [ X ];
+        outTarget [ XT_VVECSWIZZLE1_begin + 6 ] = vivec4 [ Y ];
+        outTarget [ XT_VVECSWIZZLE1_begin + 7 ] = vivec4 [ Z ];
+        outTarget [ XT_VVECSWIZZLE1_begin + 8 ] = vivec4 [ W ];
+
+        IVec2 swtest2 { 0, 1 };
+        IVec3 swtest3 { 0, 1, 2 };
+        IVec4 swtest4 { 0, 1, 2, 3 };
+
+        outTarget [ XT_VECSWIZZLE2_begin +  0 ] = testSwizzle ( swtest2, XX );
+        outTarget [ XT_VECSWIZZLE2_begin +  1 ] = testSwizzle ( swtest2, YX );
+        outTarget [ XT_VECSWIZZLE2_begin +  2 ] = testSwizzle ( swtest2, XY );
+        outTarget [ XT_VECSWIZZLE2_begin +  3 ] = testSwizzle ( swtest2, YY );
+        outTarget [ XT_VECSWIZZLE2_begin +  4 ] = testSwizzle ( swtest3, XX );
+        outTarget [ XT_VECSWIZZLE2_begin +  5 ] = testSwizzle ( swtest3, YX );
+        outTarget [ XT_VECSWIZZLE2_begin +  6 ] = testSwizzle ( swtest3, ZX );
+        outTarget [ XT_VECSWIZZLE2_begin +  7 ] = testSwizzle ( swtest3, XY );
+        outTarget [ XT_VECSWIZZLE2_begin +  8 ] = testSwizzle ( swtest3, YY );
+        outTarget [ XT_VECSWIZZLE2_begin +  9 ] = testSwizzle ( swtest3, ZY );
+        outTarget [ XT_VECSWIZZLE2_begin + 10 ] = testSwizzle ( swtest3, XZ );
+        outTarget [ XT_VECSWIZZLE2_begin + 11 ] = testSwizzle ( swtest3, YZ );
+        outTarget [ XT_VECSWIZZLE2_begin + 12 ] = testSwizzle ( swtest3, ZZ );
+        outTarget [ XT_VECSWIZZLE2_begin + 13 ] = testSwizzle ( swtest4, XX );
+        outTarget [ XT_VECSWIZZLE2_begin + 14 ] = testSwizzle ( swtest4, YX );
+        outTarget [ XT_VECSWIZZLE2_begin + 15 ] = testSwizzle ( swtest4, ZX );
+        outTarget [ XT_VECSWIZZLE2_begin + 16 ] = testSwizzle ( swtest4, WX );
+        outTarget [ XT_VECSWIZZLE2_begin + 17 ] = testSwizzle ( swtest4, XY );
+        outTarget [ XT_VECSWIZZLE2_begin + 18 ] = testSwizzle ( swtest4, YY );
+        outTarget [ XT_VECSWIZZLE2_begin + 19 ] = testSwizzle ( swtest4, ZY );
+        outTarget [ XT_VECSWIZZLE2_begin + 20 ] = testSwizzle ( swtest4, WY );
+        outTarget [ XT_VECSWIZZLE2_begin + 21 ] = testSwizzle ( swtest4, XZ );
+        outTarget [ XT_VECSWIZZLE2_begin + 22 ] = testSwizzle ( swtest4, YZ );
+        outTarget [ XT_VECSWIZZLE2_begin + 23 ] = testSwizzle ( swtest4, ZZ );
+        outTarget [ XT_VECSWIZZLE2_begin + 24 ] = testSwizzle ( swtest4, WZ );
+        outTarget [ XT_VECSWIZZLE2_begin + 25 ] = testSwizzle ( swtest4, XW );
+        outTarget [ XT_VECSWIZZLE2_begin + 26 ] = testSwizzle ( swtest4, YW );
+        outTarget [ XT_VECSWIZZLE2_begin + 27 ] = testSwizzle ( swtest4, ZW );
+        outTarget [ XT_VECSWIZZLE2_begin + 28 ] = testSwizzle ( swtest4, WW );
+
+        vivec2 = swtest2;
+        vivec3 = swtest3;
+        vivec4 = swtest4;
+
+        outTarget [ XT_VVECSWIZZLE2_begin + 0 ] = testSwizzle ( vivec2, YY );
+        outTarget [ XT_VVECSWIZZLE2_begin + 1 ] = testSwizzle ( vivec3, ZZ );
+        outTarget [ XT_VVECSWIZZLE2_begin + 2 ] = testSwizzle ( vivec4, WW );
+
+        outTarget [ XT_VECSWIZZLE3_begin +  0 ] = testSwizzle ( swtest4, XXX );
+        outTarget [ XT_VECSWIZZLE3_begin +  1 ] = testSwizzle ( swtest4, YXX );
+        outTarget [ XT_VECSWIZZLE3_begin +  1 ] = testSwizzle ( swtest4, ZXX );
+        outTarget [ XT_VECSWIZZLE3_begin +  3 ] = testSwizzle ( swtest4, WXX );
+        outTarget [ XT_VECSWIZZLE3_begin +  4 ] = testSwizzle ( swtest4, XYX );
+        outTarget [ XT_VECSWIZZLE3_begin +  5 ] = testSwizzle ( swtest4, YYX );
+        outTarget [ XT_VECSWIZZLE3_begin +  6 ] = testSwizzle ( swtest4, ZYX );
+        outTarget [ XT_VECSWIZZLE3_begin +  7 ] = testSwizzle ( swtest4, WYX );
+        outTarget [ XT_VECSWIZZLE3_begin +  8 ] = testSwizzle ( swtest4, XZX );
+        outTarget [ XT_VECSWIZZLE3_begin +  9 ] = testSwizzle ( swtest4, YZX );
+        outTarget [ XT_VECSWIZZLE3_begin + 10 ] = testSwizzle ( swtest4, ZZX );
+        outTarget [ XT_VECSWIZZLE3_begin + 11 ] = testSwizzle ( swtest4, WZX );
+        outTarget [ XT_VECSWIZZLE3_begin + 11 ] = testSwizzle ( swtest4, XWX );
+        outTarget [ XT_VECSWIZZLE3_begin + 13 ] = testSwizzle ( swtest4, YWX );
+        outTarget [ XT_VECSWIZZLE3_begin + 14 ] = testSwizzle ( swtest4, ZWX );
+        outTarget [ XT_VECSWIZZLE3_begin + 15 ] = testSwizzle ( swtest4, WWX );
+        outTarget [ XT_VECSWIZZLE3_begin + 16 ] = testSwizzle ( swtest4, XXY );
+        outTarget [ XT_VECSWIZZLE3_begin + 17 ] = testSwizzle ( swtest4, YXY );
+        outTarget [ XT_VECSWIZZLE3_begin + 18 ] = testSwizzle ( swtest4, ZXY );
+        outTarget [ XT_VECSWIZZLE3_begin + 19 ] = testSwizzle ( swtest4, WXY );
+        outTarget [ XT_VECSWIZZLE3_begin + 20 ] = testSwizzle ( swtest4, XYY );
+        outTarget [ XT_VECSWIZZLE3_begin + 21 ] = testSwizzle ( swtest4, YYY );
+        outTarget [ XT_VECSWIZZLE3_begin + 21 ] = testSwizzle ( swtest4, ZYY );
+        outTarget [ XT_VECSWIZZLE3_begin + 23 ] = testSwizzle ( swtest4, WYY );
+        outTarget [ XT_VECSWIZZLE3_begin + 24 ] = testSwizzle ( swtest4, XZY );
+        outTarget [ XT_VECSWIZZLE3_begin + 25 ] = testSwizzle ( swtest4, YZY );
+        outTarget [ XT_VECSWIZZLE3_begin + 26 ] = testSwizzle ( swtest4, ZZY );
+        outTarget [ XT_VECSWIZZLE3_begin + 27 ] = testSwizzle ( swtest4, WZY );
+        outTarget [ XT_VECSWIZZLE3_begin + 28 ] = testSwizzle ( swtest4, XWY );
+        outTarget [ XT_VECSWIZZLE3_begin + 29 ] = testSwizzle ( swtest4, YWY );
+        outTarget [ XT_VECSWIZZLE3_begin + 30 ] = testSwizzle ( swtest4, ZWY );
+        outTarget [ XT_VECSWIZZLE3_begin + 31 ] = testSwizzle ( swtest4, WWY );
+        outTarget [ XT_VECSWIZZLE3_begin + 31 ] = testSwizzle ( swtest4, XXZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 33 ] = testSwizzle ( swtest4, YXZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 34 ] = testSwizzle ( swtest4, ZXZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 35 ] = testSwizzle ( swtest4, WXZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 36 ] = testSwizzle ( swtest4, XYZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 37 ] = testSwizzle ( swtest4, YYZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 38 ] = testSwizzle ( swtest4, ZYZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 39 ] = testSwizzle ( swtest4, WYZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 40 ] = testSwizzle ( swtest4, XZZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 41 ] = testSwizzle ( swtest4, YZZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 41 ] = testSwizzle ( swtest4, ZZZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 43 ] = testSwizzle ( swtest4, WZZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 44 ] = testSwizzle ( swtest4, XWZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 45 ] = testSwizzle ( swtest4, YWZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 46 ] = testSwizzle ( swtest4, ZWZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 47 ] = testSwizzle ( swtest4, WWZ );
+        outTarget [ XT_VECSWIZZLE3_begin + 48 ] = testSwizzle ( swtest4, XXW );
+        outTarget [ XT_VECSWIZZLE3_begin + 49 ] = testSwizzle ( swtest4, YXW );
+        outTarget [ XT_VECSWIZZLE3_begin + 50 ] = testSwizzle ( swtest4, ZXW );
+        outTarget [ XT_VECSWIZZLE3_begin + 51 ] = testSwizzle ( swtest4, WXW );
+        outTarget [ XT_VECSWIZZLE3_begin + 51 ] = testSwizzle ( swtest4, XYW );
+        outTarget [ XT_VECSWIZZLE3_begin + 53 ] = testSwizzle ( swtest4, YYW );
+        outTarget [ XT_VECSWIZZLE3_begin + 54 ] = testSwizzle ( swtest4, ZYW );
+        outTarget [ XT_VECSWIZZLE3_begin + 55 ] = testSwizzle ( swtest4, WYW );
+        outTarget [ XT_VECSWIZZLE3_begin + 56 ] = testSwizzle ( swtest4, XZW );
+        outTarget [ XT_VECSWIZZLE3_begin + 57 ] = testSwizzle ( swtest4, YZW );
+        outTarget [ XT_VECSWIZZLE3_begin + 58 ] = testSwizzle ( swtest4, ZZW );
+        outTarget [ XT_VECSWIZZLE3_begin + 59 ] = testSwizzle ( swtest4, WZW );
+        outTarget [ XT_VECSWIZZLE3_begin + 60 ] = testSwizzle ( swtest4, XWW );
+        outTarget [ XT_VECSWIZZLE3_begin + 61 ] = testSwizzle ( swtest4, YWW );
+        outTarget [ XT_VECSWIZZLE3_begin + 62 ] = testSwizzle ( swtest4, ZWW );
+        outTarget [ XT_VECSWIZZLE3_begin + 63 ] = testSwizzle ( swtest4, WWW );
+
+        outTarget [ XT_VVECSWIZZLE3_begin + 0 ] = testSwizzle ( vivec4, YYY );
+        outTarget [ XT_VVECSWIZZLE3_begin + 1 ] = testSwizzle ( vivec4, WYX );
+        outTarget [ XT_VVECSWIZZLE3_begin + 2 ] = testSwizzle ( vivec4, ZYW );
+        outTarget [ XT_VVECSWIZZLE3_begin + 3 ] = testSwizzle ( vivec4, WWW );
+
+        outTarget [ XT_VECSWIZZLE4_begin + 0 ] = testSwizzle ( swtest4, XYZW );
+        outTarget [ XT_VECSWIZZLE4_begin + 1 ] = testSwizzle ( swtest4, WZYX );
+        outTarget [ XT_VECSWIZZLE4_begin + 2 ] = testSwizzle ( swtest4, YXWZ );
+        outTarget [ XT_VECSWIZZLE4_begin + 3 ] = testSwizzle ( swtest4, ZWXY );
+        outTarget [ XT_VECSWIZZLE4_begin + 4 ] = testSwizzle ( swtest4, XXXX );
+        outTarget [ XT_VECSWIZZLE4_begin + 5 ] = testSwizzle ( swtest4, YYYY );
+        outTarget [ XT_VECSWIZZLE4_begin + 6 ] = testSwizzle ( swtest4, ZZZZ );
+        outTarget [ XT_VECSWIZZLE4_begin + 7 ] = testSwizzle ( swtest4, WWWW );
+
+        outTarget [ XT_VVECSWIZZLE4_begin + 0 ] = testSwizzle ( vivec4, XYZW );
+        outTarget [ XT_VVECSWIZZLE4_begin + 1 ] = testSwizzle ( vivec4, WZYX );
+        outTarget [ XT_VVECSWIZZLE4_begin + 2 ] = testSwizzle ( vivec4, YXWZ );
+        outTarget [ XT_VVECSWIZZLE4_begin + 3 ] = testSwizzle ( vivec4, ZWXY );
+
+        // swizzled writes
+        vivec4 [ X ] = 3;
+        vivec4 [ Y ] = 2;
+        vivec4 [ Z ] = 1;
+        vivec4 [ W ] = 0;
+
+        outTarget [ XT_WRVECSWIZZLE4_begin ] = testSwizzle ( vivec4, XYZW );
+
+        vivec4 [ WZYX ] = vivec4;
+        outTarget [ XT_WRVECSWIZZLE4_begin + 1 ] = testSwizzle ( vivec4, XYZW );
+
+        vivec4 [ ZX ] = swtest4 [ WW ];
+        vivec4 [ WY ] = swtest4 [ YY ];
+        outTarget [ XT_WRVECSWIZZLE4_begin + 2 ] = testSwizzle ( vivec4, XYZW );
+
+        vivec3 [ X ] = 3;
+        vivec3 [ Y ] = 2;
+        vivec3 [ Z ] = 1;
+
+        outTarget [ XT_WRVECSWIZZLE4_begin + 3 ] = testSwizzle ( vivec3, XYZ );
+
+        vivec3 [ ZYX ] = vivec3;
+        outTarget [ XT_WRVECSWIZZLE4_begin + 4 ] = testSwizzle ( vivec3, XYZ );
+
+        vivec2 [ X ] = 2;
+        vivec2 [ Y ] = 1;
+
+        outTarget [ XT_WRVECSWIZZLE4_begin + 5 ] = testSwizzle ( vivec2, XY );
+
+        vivec2 [ YX ] = vivec2;
+        outTarget [ XT_WRVECSWIZZLE4_begin + 6 ] = testSwizzle ( vivec2, XY );
+
+        // Swizzles combined with normal indexing
+        outTarget [ XT_SWIZZLEIND_begin + 0 ] = swtest4 [ WZYX ][ 0 ];
+        outTarget [ XT_SWIZZLEIND_begin + 1 ] = swtest4 [ WZYX ][ 1 ];
+        outTarget [ XT_SWIZZLEIND_begin + 2 ] = swtest4 [ WZYX ][ 2 ];
+        outTarget [ XT_SWIZZLEIND_begin + 3 ] = swtest4 [ WZYX ][ 3 ];
+
+        // 2x2 matrices
+        Mat2 mat2 { 11, 12, 21, 22 };
+
+        outTarget [ XT_MAT_2x2_0 ] = ReinterpretCast< Int >( mat2 [ 0 ][ 0 ] );
+        outTarget [ XT_MAT_2x2_1 ] = ReinterpretCast< Int >( mat2 [ 1 ][ 0 ] );
+        outTarget [ XT_MAT_2x2_2 ] = ReinterpretCast< Int >( mat2 [ 0 ][ 1 ] );
+        outTarget [ XT_MAT_2x2_3 ] = ReinterpretCast< Int >( mat2 [ 1 ][ 1 ] );
+
+        outTarget [ XT_MAT_2x2_D0 ] = ReinterpretCast< Int >( mat2 [ inSource1 [ XT_MAT_2x2_D0 ] ][ inSource2 [ XT_MAT_2x2_D0 ] ] );
+        outTarget [ XT_MAT_2x2_D1 ] = ReinterpretCast< Int >( mat2 [ inSource1 [ XT_MAT_2x2_D1 ] ][ inSource2 [ XT_MAT_2x2_D1 ] ] );
+        outTarget [ XT_MAT_2x2_D2 ] = ReinterpretCast< Int >( mat2 [ inSource1 [ XT_MAT_2x2_D2 ] ][ inSource2 [ XT_MAT_2x2_D2 ] ] );
+        outTarget [ XT_MAT_2x2_D3 ] = ReinterpretCast< Int >( mat2 [ inSource1 [ XT_MAT_2x2_D3 ] ][ inSource2 [ XT_MAT_2x2_D3 ] ] );
+
+        Vec2 mat20 = mat2 [ 0 ];
+        Vec2 mat21 = mat2 [ 1 ];
+
+        outTarget [ XT_MAT_2x2_C0 ] = ReinterpretCast< Int >( mat20 [ 0 ] );
+        outTarget [ XT_MAT_2x2_C1 ] = ReinterpretCast< Int >( mat21 [ 0 ] );
+        outTarget [ XT_MAT_2x2_C2 ] = ReinterpretCast< Int >( mat20 [ 1 ] );
+        outTarget [ XT_MAT_2x2_C3 ] = ReinterpretCast< Int >( mat21 [ 1 ] );
+
+        VMat2 vmat2 = mat2;
+        outTarget [ XT_MAT_2x2_V0 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 0 ] );
+        outTarget [ XT_MAT_2x2_V1 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 0 ] );
+        outTarget [ XT_MAT_2x2_V2 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 1 ] );
+        outTarget [ XT_MAT_2x2_V3 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 1 ] );
+
+        vmat2 [ 0 ][ 0 ] = 111.0f;
+        vmat2 [ 1 ][ 0 ] = 112.0f;
+        vmat2 [ 0 ][ 1 ] = 121.0f;
+        vmat2 [ 1 ][ 1 ] = 122.0f;
+        outTarget [ XT_MAT_2x2_V10 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 0 ] );
+        outTarget [ XT_MAT_2x2_V11 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 0 ] );
+        outTarget [ XT_MAT_2x2_V12 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 1 ] );
+        outTarget [ XT_MAT_2x2_V13 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 1 ] );
+
+        vmat2 [ 0 ] = mat2 [ 0 ];
+        vmat2 [ 1 ] = mat2 [ 1 ];
+        outTarget [ XT_MAT_2x2_V20 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 0 ] );
+        outTarget [ XT_MAT_2x2_V21 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 0 ] );
+        outTarget [ XT_MAT_2x2_V22 ] = ReinterpretCast< Int >( vmat2 [ 0 ][ 1 ] );
+        outTarget [ XT_MAT_2x2_V23 ] = ReinterpretCast< Int >( vmat2 [ 1 ][ 1 ] );
+
+        // ---------------------------------------------------------
+
+        inStorTestBuf1 [ & GTestStruct::d_matr2 ][ 0 ][ 0 ] =
+            inUniTestBuf1 [ & GTestStruct::d_matr2 ][ 0 ][ 0 ];
+        inStorTestBuf1 [ & GTestStruct::d_matr2 ][ 0 ][ 1 ] =
+            inUniTestBuf1 [ & GTestStruct::d_matr2 ][ 0 ][ 1 ];
+        inStorTestBuf1 [ & GTestStruct::d_matr2 ][ 1 ][ 0 ] =
+            inUniTestBuf1 [ & GTestStruct::d_matr2 ][ 1 ][ 0 ];
+        inStorTestBuf1 [ & GTestStruct::d_matr2 ][ 1 ][ 1 ] =
+            inUniTestBuf1 [ & GTestStruct::d_matr2 ][ 1 ][ 1 ];
+
+        inStorTestBuf1 [ & GTestStruct::d_matr3 ][ 0 ] =
+            inUniTestBuf1 [ & GTestStruct::d_matr3 ][ 0 ];
+        inStorTestBuf1 [ & GTestStruct::d_matr3 ][ 1 ] =
+            inUniTestBuf1 [ & GTestStruct::d_matr3 ][ 1 ];
+        inStorTestBuf1 [ & GTestStruct::d_matr3 ][ 2 ] =
+            inUniTestBuf1 [ & GTestStruct::d_matr3 ][ 2 ];
+
+        inStorTestBuf1 [ & GTestStruct::d_matr4 ] =
+            inUniTestBuf1 [ & GTestStruct::d_matr4 ];
+
+        inStorTestBuf1 [ & GTestStruct::d_vect2 ][ 0 ] =
+            inUniTestBuf1 [ & GTestStruct::d_vect2 ][ 0 ];
+        inStorTestBuf1 [ & GTestStruct::d_vect2 ][ 1 ] =
+            inUniTestBuf1 [ & GTestStruct::d_vect2 ][ 1 ];
+        inStorTestBuf1 [ & GTestStruct::d_vect2a ] =
+            inUniTestBuf1 [ & GTestStruct::d_vect2a ];
+        inStorTestBuf1 [ & GTestStruct::d_vect3 ] =
+            inUniTestBuf1 [ & GTestStruct::d_vect3 ];
+        inStorTestBuf1 [ & GTestStruct::d_vect4 ] =
+            inUniTestBuf1 [ & GTestStruct::d_vect4 ];
+    }
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Push constant tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KPushConstantTestPipeline :: KPushConstantTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KPushConstantTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KPushConstantTestPipeline :: setOutBuffer (
+    const vpp::StorageBufferView& rb,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_resultBuffer = rb
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+CPushConstantTestStruct& KPushConstantTestPipeline :: data()
+{
+    return d_sourceData.data();
+}
+
+// -----------------------------------------------------------------------------
+
+void KPushConstantTestPipeline :: push()
+{
+    d_sourceData.cmdPush();
+}
+
+// -----------------------------------------------------------------------------
+
+void KPushConstantTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+    const IVec3 localId = pShader->inLocalInvocationId;
+    const Int g = workgroupId [ X ];
+    const Int l = localId [ X ];
+
+    UniformVar< TPushConstantTestStruct, decltype ( d_sourceData ) > inSourceData ( d_sourceData );
+    UniformSimpleArray< matr2, decltype ( d_resultBuffer ) > outResultBuffer ( d_resultBuffer );
+
+    If ( g == 0 && l == 0 );
+    {
+        const Int idx = inSourceData [ & GPushConstantTestStruct::d_outIdx ];
+        const Mat2 v = inSourceData [ & GPushConstantTestStruct::d_matr2 ];
+        outResultBuffer [ idx ] = v;
+    }
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Texel buffer tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KTexelBufferTestPipeline :: KTexelBufferTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KTexelBufferTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KTexelBufferTestPipeline :: setOutBuffer (
+    const KTexelBufferTestPipeline::View4xF32& inTexBuf4xF32,
+    const KTexelBufferTestPipeline::View4xF32& ioImgBuf4xF32,
+    const KTexelBufferTestPipeline::View4xF32& inTexBuf4xF32a,
+    const KTexelBufferTestPipeline::View4xF32& ioImgBuf4xF32a,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        m_inTexBuf4xF32 = inTexBuf4xF32,
+        m_ioImgBuf4xF32 = ioImgBuf4xF32,
+        m_inTexBuf4xF32a = inTexBuf4xF32a,
+        m_ioImgBuf4xF32a = ioImgBuf4xF32a
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KTexelBufferTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+    const IVec3 localId = pShader->inLocalInvocationId;
+    const Int g = workgroupId [ X ];
+    const Int l = localId [ X ];
+    const Int index = ( g << 5 ) | l;
+
+    TexelArray< decltype ( m_inTexBuf4xF32a ) > inTexBuf4xF32a ( m_inTexBuf4xF32a );
+    TexelArray< decltype ( m_ioImgBuf4xF32a ) > ioImgBuf4xF32a ( m_ioImgBuf4xF32a );
+    
+    UseImage ( m_inTexBuf4xF32 );
+    UseImage ( m_ioImgBuf4xF32 );
+
+    const Int bufferLength = inTexBuf4xF32a.Size();
+
+    If ( index < bufferLength );
+    {
+        const Vec4 v = TexelFetch ( m_inTexBuf4xF32, index );
+        ImageStore ( m_ioImgBuf4xF32, index, v );
+
+        const Vec4 va = inTexBuf4xF32a [ index ];
+        ioImgBuf4xF32a [ index ] = va;
+    }
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Images tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KImageTestPipeline :: KImageTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KImageTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KImageTestPipeline :: setBuffers (
+    const KImageTestPipeline::View4xF32& inImgBuf4xF32,
+    const KImageTestPipeline::View4xF32& ioImgBuf4xF32,
+    const KImageTestPipeline::View4xFU8& inImgBuf4xFU8,
+    const KImageTestPipeline::View4xFU8& ioImgBuf4xFU8,
+    const KImageTestPipeline::View2xFS8& inImgBuf2xFS8,
+    const KImageTestPipeline::View2xFS8& ioImgBuf2xFS8,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        m_inImgBuf4xF32 = inImgBuf4xF32,
+        m_ioImgBuf4xF32 = ioImgBuf4xF32,
+        m_inImgBuf4xFU8 = inImgBuf4xFU8,
+        m_ioImgBuf4xFU8 = ioImgBuf4xFU8,
+        m_inImgBuf2xFS8 = inImgBuf2xFS8,
+        m_ioImgBuf2xFS8 = ioImgBuf2xFS8
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KImageTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+    const IVec3 localId = pShader->inLocalInvocationId;
+    const Int g = workgroupId [ X ];
+    const Int l = localId [ X ];
+    const Int index = ( g << 5 ) | l;
+
+    const IVec2 imgSize1 = ImageSize ( m_inImgBuf4xF32 );
+    const Int width1 = imgSize1 [ X ];
+    const Int height1 = imgSize1 [ Y ];
+    const Int x1 = index % width1;
+    const Int y1 = index / width1;
+
+    If ( y1 < height1 );
+    {
+        const IVec2 coords = IVec2 ( x1, y1 );
+
+        const Vec4 v1 = ImageLoad ( m_inImgBuf4xF32, coords );
+        ImageStore ( m_ioImgBuf4xF32, coords, v1 );
+
+        const Vec4 v2 = ImageLoad ( m_inImgBuf4xFU8, coords );
+        ImageStore ( m_ioImgBuf4xFU8, coords, v2 );
+
+        const Vec4 v3 = ImageLoad ( m_inImgBuf2xFS8, coords );
+        ImageStore ( m_ioImgBuf2xFS8, coords, -v3 );
+    }
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Synchronization tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KGlobalSyncTestPipeline :: KGlobalSyncTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KGlobalSyncTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KGlobalSyncTestPipeline :: setData (
+    const DataBuffer& resultView,
+    const TestImageView& testImageView,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_resultBuffer = resultView,
+        d_testImage = testImageView
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KGlobalSyncTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    // pShader->DebugCodeDump();
+
+    const Int ng = pShader->inNumWorkgroups [ X ];
+    const Int nl = pShader->inWorkgroupSize [ X ];
+    const Int np = ng * nl;
+    const Int l = pShader->inLocalInvocationId [ X ];
+    const Int g = pShader->inWorkgroupId [ X ];
+
+    UseImage ( d_testImage );
+
+    If ( g == 0 && l == 0 );
+        ImageStore ( d_testImage, IVec2 { 0, 0 }, 77u );
+    Fi();
+
+    //DeviceBarrier ( spv::MemorySemanticsImageMemoryMask | spv::MemorySemanticsAcquireReleaseMask );
+
+    const UInt v = ImageLoad ( d_testImage, IVec2 { 0, 0 } )[ X ];
+
+    UniformSimpleArray< unsigned int, decltype ( d_resultBuffer ) > outResultBuffer ( d_resultBuffer );
+    outResultBuffer [ ( g << 5 ) | l ] = v;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Local arrays tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+const unsigned int KLocalArraysTestTypes :: s_testSizes[] =
+{
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 32, 256
+};
+
+// -----------------------------------------------------------------------------
+
+const unsigned int KLocalArraysTestTypes :: s_testCount =
+    sizeof ( s_testSizes ) / sizeof ( unsigned int );
+
+// -----------------------------------------------------------------------------
+
+void KLocalArraysTestTypes :: computeTestOffsets ( std::vector< unsigned int >* pOffsets )
+{
+    pOffsets->resize ( s_testCount + 1 );
+
+    unsigned int offset = 0;
+
+    for ( unsigned int i = 0; i != s_testCount; ++i )
+    {
+        ( *pOffsets )[ i ] = offset;
+        offset += s_testSizes [ i ];
+    }
+
+    ( *pOffsets )[ s_testCount ] = offset;
+}
+
+// -----------------------------------------------------------------------------
+
+unsigned int KLocalArraysTestTypes :: totalTestVectorLength()
+{
+    return std::accumulate ( s_testSizes + 0, s_testSizes + s_testCount, 0 );
+}
+
+// -----------------------------------------------------------------------------
+
+KLocalArraysTestPipeline :: KLocalArraysTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KLocalArraysTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KLocalArraysTestPipeline :: setData (
+    const DataBufferI& generateResultViewI,
+    const DataBufferI& transformResultViewI,
+    const DataBufferI& reverseResultViewI,
+    const DataBufferF& generateResultViewF,
+    const DataBufferF& transformResultViewF,
+    const DataBufferF& reverseResultViewF,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_generateResultBufferI = generateResultViewI,
+        d_transformResultBufferI = transformResultViewI,
+        d_reverseResultBufferI = reverseResultViewI,
+        d_generateResultBufferF = generateResultViewF,
+        d_transformResultBufferF = transformResultViewF,
+        d_reverseResultBufferF = reverseResultViewF
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KLocalArraysTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+    using namespace vpp::ct;
+
+    group::GroupInvocation inv ( pShader );
+
+    //pShader->DebugCodeDump();
+
+    const Int ng = pShader->inNumWorkgroups [ X ];
+    const Int nl = pShader->inWorkgroupSize [ X ];
+    const Int np = ng * nl;
+    const Int l = pShader->inLocalInvocationId [ X ];
+    const Int g = pShader->inWorkgroupId [ X ];
+
+    UniformSimpleArray< int, decltype ( d_generateResultBufferI ) > outGenerateBufferI ( d_generateResultBufferI );
+    UniformSimpleArray< int, decltype ( d_transformResultBufferI ) > outTransformBufferI ( d_transformResultBufferI );
+    UniformSimpleArray< int, decltype ( d_reverseResultBufferI ) > outReverseBufferI ( d_reverseResultBufferI );
+    UniformSimpleArray< float, decltype ( d_generateResultBufferF ) > outGenerateBufferF ( d_generateResultBufferF );
+    UniformSimpleArray< float, decltype ( d_transformResultBufferF ) > outTransformBufferF ( d_transformResultBufferF );
+    UniformSimpleArray< float, decltype ( d_reverseResultBufferF ) > outReverseBufferF ( d_reverseResultBufferF );
+
+    VInt tmpi;
+
+    std::vector< unsigned int > offsets;
+    computeTestOffsets ( & offsets );
+
+    for ( unsigned int iTest = 0; iTest != s_testCount; ++iTest )
+    {
+        const unsigned int testSize = s_testSizes [ iTest ];
+        const Int testDataOffset = static_cast< int >( offsets [ iTest ] );
+
+        VArray< Int > testArrI ( testSize );
+        VArray< Float > testArrF ( testSize );
+
+        VInt ti;
+        VFloat tf;
+
+        If ( inv.LocalId() == 0 );
+
+            // integer
+
+            For ( tmpi, 0, testSize );
+                testArrI [ tmpi ] = tmpi;
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                outGenerateBufferI [ testDataOffset + tmpi ] = testArrI [ tmpi ];
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                testArrI [ tmpi ] = 2*testArrI [ tmpi ];
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                outTransformBufferI [ testDataOffset + tmpi ] = testArrI [ tmpi ];
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                testArrI [ tmpi ] = tmpi;
+            Rof();
+
+            For ( tmpi, 0, testSize / 2 );
+                ti = testArrI [ tmpi ];
+                testArrI [ tmpi ] = testArrI [ testArrI.Size() - tmpi - 1 ];
+                testArrI [ testSize - tmpi - 1 ] = ti;
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                outReverseBufferI [ testDataOffset + tmpi ] = testArrI [ tmpi ];
+            Rof();
+
+            // float
+
+            For ( tmpi, 0, testSize );
+                testArrF [ tmpi ] = StaticCast< Float >( tmpi );
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                outGenerateBufferF [ testDataOffset + tmpi ] = testArrF [ tmpi ];
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                testArrF [ tmpi ] = 2*testArrF [ tmpi ];
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                outTransformBufferF [ testDataOffset + tmpi ] = testArrF [ tmpi ];
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                testArrF [ tmpi ] = StaticCast< Float >( tmpi );
+            Rof();
+
+            For ( tmpi, 0, testSize / 2 );
+                tf = testArrF [ tmpi ];
+                testArrF [ tmpi ] = testArrF [ testArrF.Size() - tmpi - 1 ];
+                testArrF [ testSize - tmpi - 1 ] = tf;
+            Rof();
+
+            For ( tmpi, 0, testSize );
+                outReverseBufferF [ testDataOffset + tmpi ] = testArrF [ tmpi ];
+            Rof();
+
+        Fi();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Group algorithms tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+const unsigned int KGroupAlgorithmsTestTypes :: s_testSizes[] =
+{
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 17, 31, 32, 33, 63, 64, 65,
+    127, 128, 129, 255, 256, 257, 511, 512, 513, 999,
+    2047, 6000
+};
+
+// -----------------------------------------------------------------------------
+
+const unsigned int KGroupAlgorithmsTestTypes :: s_testCount =
+    sizeof ( s_testSizes ) / sizeof ( unsigned int );
+
+// -----------------------------------------------------------------------------
+
+void KGroupAlgorithmsTestTypes :: computeTestOffsets ( std::vector< unsigned int >* pOffsets )
+{
+    pOffsets->resize ( s_testCount + 1 );
+
+    unsigned int offset = 0;
+
+    for ( unsigned int i = 0; i != s_testCount; ++i )
+    {
+        ( *pOffsets )[ i ] = offset;
+        offset += s_testSizes [ i ];
+    }
+
+    ( *pOffsets )[ s_testCount ] = offset;
+}
+
+// -----------------------------------------------------------------------------
+
+unsigned int KGroupAlgorithmsTestTypes :: totalTestVectorLength()
+{
+    return std::accumulate ( s_testSizes + 0, s_testSizes + s_testCount, 0 );
+}
+
+// -----------------------------------------------------------------------------
+
+KGroupAlgorithmsTestPipeline :: KGroupAlgorithmsTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KGroupAlgorithmsTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupAlgorithmsTestPipeline :: setData (
+    const DataBuffer& sourceView,
+    const DataBuffer& generateResultView,
+    const DataBuffer& sortResultView,
+    const DataBuffer& reduceResultView,
+    const DataBuffer& iscanResultView,
+    const DataBuffer& escanResultView,
+    const DataBuffer& lboundResultView,
+    const DataBuffer& uboundResultView,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_sourceBuffer = sourceView,
+        d_generateResultBuffer = generateResultView,
+        d_sortResultBuffer = sortResultView,
+        d_reduceResultBuffer = reduceResultView,
+        d_iscanResultBuffer = iscanResultView,
+        d_escanResultBuffer = escanResultView,
+        d_lboundResultBuffer = lboundResultView,
+        d_uboundResultBuffer = uboundResultView
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupAlgorithmsTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+    using namespace vpp::ct;
+
+    group::GroupInvocation inv ( pShader );
+
+    //pShader->DebugCodeDump();
+
+    const Int ng = pShader->inNumWorkgroups [ X ];
+    const Int nl = pShader->inWorkgroupSize [ X ];
+    const Int np = ng * nl;
+    const Int l = pShader->inLocalInvocationId [ X ];
+    const Int g = pShader->inWorkgroupId [ X ];
+
+    UniformSimpleArray< unsigned int, decltype ( d_sourceBuffer ) > inSourceBuffer ( d_sourceBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_generateResultBuffer ) > outGenerateBuffer ( d_generateResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_sortResultBuffer ) > outSortBuffer ( d_sortResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_reduceResultBuffer ) > outReduceBuffer ( d_reduceResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_iscanResultBuffer ) > outIscanBuffer ( d_iscanResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_escanResultBuffer ) > outEscanBuffer ( d_escanResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_lboundResultBuffer ) > outLboundBuffer ( d_lboundResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_uboundResultBuffer ) > outUboundBuffer ( d_uboundResultBuffer );
+
+    VUInt tmpv;
+    WArray< UInt > temporaryArr ( inv.localCount() );
+    WArray< Int > workArr ( 2 * inv.localCount() + 6 );
+
+    std::vector< unsigned int > offsets;
+    computeTestOffsets ( & offsets );
+
+    for ( unsigned int iTest = 0; iTest != s_testCount; ++iTest )
+    {
+        const unsigned int testSize = s_testSizes [ iTest ];
+        const Int testDataOffset = static_cast< int >( offsets [ iTest ] );
+
+        WArray< UInt > testArr ( testSize );
+
+        // Test Generate.
+        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx + 1 ); }, inv );
+        group::Store ( testArr, outGenerateBuffer, testDataOffset, inv );
+
+        // Test Reduce and Fill
+        const UInt red = group::Reduce (
+            testArr, []( const UInt& v1, const UInt& v2 ){ return v1 + v2; },
+            tmpv, temporaryArr, inv );
+
+        group::Fill ( testArr, red, inv );
+        group::Store ( testArr, outReduceBuffer, testDataOffset, inv );
+
+        // Test InclusiveScan
+        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx + 1 ); }, inv );
+        
+        group::InclusiveScan (
+            testArr, []( const UInt& v1, const UInt& v2 ){ return v1 + v2; },
+            tmpv, temporaryArr, inv );
+
+        group::Store ( testArr, outIscanBuffer, testDataOffset, inv );
+
+        // Test ExclusiveScan
+        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx + 1 ); }, inv );
+        
+        group::ExclusiveScan (
+            testArr, []( const UInt& v1, const UInt& v2 ){ return v1 + v2; },
+            tmpv, temporaryArr, inv );
+
+        group::Store ( testArr, outEscanBuffer, testDataOffset, inv );
+
+        // Test Sort.
+
+        group::Load ( inSourceBuffer, testDataOffset, testArr, inv );
+
+        group::Sort (
+            testArr, []( const UInt& i1, const UInt& i2 ){ return i1 < i2; },
+            inv );
+
+        group::Store ( testArr, outSortBuffer, testDataOffset, inv );
+
+        // Test LowerBound
+        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx ); }, inv );
+
+        For ( tmpv, 0u, StaticCast< UInt >( testArr.Size() ) );
+        {
+            const Int idx = group::LowerBound (
+                testArr, UInt ( tmpv ),
+                []( const UInt& l, const UInt& r ){ return l < r; },
+                workArr, inv );
+
+            If ( l == 0 );
+                outLboundBuffer [ StaticCast< UInt >( testDataOffset ) + tmpv ] = StaticCast< UInt >( idx );
+            Fi();
+        }
+        Rof();
+
+        // Test UpperBound
+        group::Generate ( testArr, []( const Int& idx ){ return StaticCast< UInt >( idx ); }, inv );
+
+        For ( tmpv, 0u, StaticCast< UInt >( testArr.Size() ) );
+        {
+            const Int idx = group::UpperBound (
+                testArr, UInt ( tmpv ),
+                []( const UInt& l, const UInt& r ){ return l < r; },
+                workArr, inv );
+
+            If ( l == 0 );
+                outUboundBuffer [ StaticCast< UInt >( testDataOffset ) + tmpv ] = StaticCast< UInt >( idx );
+            Fi();
+        }
+        Rof();
+    }
+
+    const unsigned int totalMemory = pShader->getTotalWorkgroupMemory();
+    const unsigned int freeMemory = pShader->getFreeWorkgroupMemory();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Group algorithms tests 2
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+const unsigned int KGroupAlgorithms2TestTypes :: s_testSizesCols[] =
+{
+    1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 16, 16, 17, 17, 31, 31, 
+    32, 32, 33, 33, 41
+};
+
+// -----------------------------------------------------------------------------
+
+const unsigned int KGroupAlgorithms2TestTypes :: s_testSizesRows[] =
+{
+    1, 1, 2, 3, 2, 4, 5, 5, 4, 6, 5, 7, 8, 8, 7, 9, 6, 16, 15, 17, 18, 31, 30, 
+    32, 11, 33, 34, 41
+};
+
+// -----------------------------------------------------------------------------
+
+static_assert (
+    sizeof ( KGroupAlgorithms2TestTypes::s_testSizesCols ) == sizeof ( KGroupAlgorithms2TestTypes::s_testSizesRows ),
+    "sizeof ( s_testSizesCols )" );
+
+// -----------------------------------------------------------------------------
+
+const unsigned int KGroupAlgorithms2TestTypes :: s_testCount =
+    sizeof ( s_testSizesCols ) / sizeof ( unsigned int );
+
+// -----------------------------------------------------------------------------
+
+void KGroupAlgorithms2TestTypes :: computeTestOffsets ( std::vector< unsigned int >* pOffsets )
+{
+    pOffsets->resize ( s_testCount + 1 );
+
+    unsigned int offset = 0;
+
+    for ( unsigned int i = 0; i != s_testCount; ++i )
+    {
+        ( *pOffsets )[ i ] = offset;
+        offset += s_testSizesCols [ i ] * s_testSizesRows [ i ];
+    }
+
+    ( *pOffsets )[ s_testCount ] = offset;
+}
+
+// -----------------------------------------------------------------------------
+
+unsigned int KGroupAlgorithms2TestTypes :: totalTestVectorLength()
+{
+    unsigned int offset = 0;
+
+    for ( unsigned int i = 0; i != s_testCount; ++i )
+        offset += s_testSizesCols [ i ] * s_testSizesRows [ i ];
+
+    return offset;
+}
+
+// -----------------------------------------------------------------------------
+
+KGroupAlgorithms2TestPipeline :: KGroupAlgorithms2TestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KGroupAlgorithms2TestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupAlgorithms2TestPipeline :: setData (
+    const DataBuffer& fillResultView,
+    const DataBuffer& generateResultView,
+    const DataBuffer& generate2ResultView,
+    const DataBuffer& sortResultView,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_fillResultBuffer = fillResultView,
+        d_generateResultBuffer = generateResultView,
+        d_generate2ResultBuffer = generate2ResultView,
+        d_sortResultBuffer = sortResultView
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupAlgorithms2TestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+    using namespace vpp::ct;
+
+    group::GroupInvocation inv ( pShader );
+
+    //pShader->DebugCodeDump();
+
+    const Int ng = pShader->inNumWorkgroups [ X ];
+    const Int nl = pShader->inWorkgroupSize [ X ];
+    const Int np = ng * nl;
+    const Int l = pShader->inLocalInvocationId [ X ];
+    const Int g = pShader->inWorkgroupId [ X ];
+
+    UniformSimpleArray< unsigned int, decltype ( d_fillResultBuffer ) > outFillBuffer ( d_fillResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_generateResultBuffer ) > outGenerateBuffer ( d_generateResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_generate2ResultBuffer ) > outGenerate2Buffer ( d_generate2ResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_sortResultBuffer ) > outSortBuffer ( d_sortResultBuffer );
+
+    VUInt tmpv;
+
+    std::vector< unsigned int > offsets;
+    computeTestOffsets ( & offsets );
+
+    for ( unsigned int iTest = 0; iTest != s_testCount; ++iTest )
+    {
+        const unsigned int testRows = s_testSizesRows [ iTest ];
+        const unsigned int testCols = s_testSizesCols [ iTest ];
+        const unsigned int testSize = testRows * testCols;
+        const Int testDataOffset = static_cast< int >( offsets [ iTest ] );
+
+        WArray2< UInt > testArr ( s_testSizesRows [ iTest ], s_testSizesCols [ iTest ] );
+
+        // Test Fill.
+        group::Fill ( testArr, UInt(testSize), inv );
+        group::Store ( testArr, outFillBuffer, false, testDataOffset, inv );
+
+        // Test Generate.
+        group::Generate (
+            testArr, []( const Int& row, const Int& col )
+            {
+                return StaticCast< UInt >( ( row << 16 ) | col ); 
+            }, inv
+        );
+
+        group::Store ( testArr, outGenerateBuffer, false, testDataOffset, inv );
+        group::Store ( testArr, outGenerate2Buffer, true, testDataOffset, inv );
+
+        // Test Sort
+        group::Generate (
+            testArr, [ testCols ]( const Int& row, const Int& col )
+            {
+                return StaticCast< UInt >( testCols - col ); 
+            }, inv
+        );
+
+        For ( tmpv, 0, testRows );
+        {
+            WArray< UInt > row = testArr [ tmpv ];
+
+            group::Sort (
+                row, []( const UInt& lhs, const UInt& rhs ){ return lhs < rhs; },
+                inv );
+        }
+        Rof();
+
+        group::Store ( testArr, outSortBuffer, false, testDataOffset, inv );
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Group variables tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KGroupVariablesTestPipeline :: KGroupVariablesTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KGroupVariablesTestPipeline::fComputeShader ),
+    d_intResultBufferOffset ( 0 ),
+    d_uintResultBufferOffset ( 0 ),
+    d_floatResultBufferOffset ( 0 ),
+    d_doubleResultBufferOffset ( 0 ),
+    d_pOutIntBuffer ( 0 ),
+    d_pOutUIntBuffer ( 0 ),
+    d_pOutFloatBuffer ( 0 ),
+    d_pOutDoubleBuffer ( 0 )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupVariablesTestPipeline :: setData (
+    const DataBufferI& intResultView,
+    const DataBufferU& uintResultView,
+    const DataBufferF& floatResultView,
+    const DataBufferD& doubleResultView,
+    const DataBufferI& groupResultView,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_intResultBuffer = intResultView,
+        d_uintResultBuffer = uintResultView,
+        d_floatResultBuffer = floatResultView,
+        d_doubleResultBuffer = doubleResultView,
+        d_groupResultBuffer = groupResultView
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupVariablesTestPipeline :: setVariable (
+    vpp::WBool& var, int value )
+{
+    var = ( value != 0 );
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename ScalarT >
+void KGroupVariablesTestPipeline :: setVariable (
+    vpp::TLValue< ScalarT, spv::StorageClassWorkgroup >& var, int value )
+{
+    var = static_cast< ScalarT >( value );
+}
+
+// -----------------------------------------------------------------------------
+
+template< size_t SIZE >
+void KGroupVariablesTestPipeline :: setVariableB (
+    vpp::TLVector< vpp::Bool, SIZE, spv::StorageClassWorkgroup >& var, int value )
+{
+    using namespace vpp;
+
+    for ( size_t i = 0; i != SIZE; ++i )
+    {
+        const UInt idx = static_cast< unsigned int >( i );
+        var [ idx ] = ( value != 0 );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename BaseT >
+void KGroupVariablesTestPipeline :: setVariable (
+    vpp::TLVector< BaseT, 2, spv::StorageClassWorkgroup >& var, int value )
+{
+    using namespace vpp;
+    typedef typename BaseT::scalar_type ScalarT;
+    var [ X ] = static_cast< ScalarT >( value );
+    var [ Y ] = static_cast< ScalarT >( value );
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename BaseT >
+void KGroupVariablesTestPipeline :: setVariable (
+    vpp::TLVector< BaseT, 3, spv::StorageClassWorkgroup >& var, int value )
+{
+    using namespace vpp;
+    typedef typename BaseT::scalar_type ScalarT;
+    var [ X ] = static_cast< ScalarT >( value );
+    var [ Y ] = static_cast< ScalarT >( value );
+    var [ Z ] = static_cast< ScalarT >( value );
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename BaseT >
+void KGroupVariablesTestPipeline :: setVariable (
+    vpp::TLVector< BaseT, 4, spv::StorageClassWorkgroup >& var, int value )
+{
+    using namespace vpp;
+    typedef typename BaseT::scalar_type ScalarT;
+    var [ X ] = static_cast< ScalarT >( value );
+    var [ Y ] = static_cast< ScalarT >( value );
+    var [ Z ] = static_cast< ScalarT >( value );
+    var [ W ] = static_cast< ScalarT >( value );
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename BaseT, size_t COLS, size_t ROWS  >
+void KGroupVariablesTestPipeline :: setVariable (
+    const vpp::TLMatrix< BaseT, COLS, ROWS, spv::StorageClassWorkgroup >& var, int value )
+{
+    using namespace vpp;
+    typedef typename BaseT::scalar_type ScalarT;
+
+    for ( size_t r = 0; r != ROWS; ++r )
+        for ( size_t c = 0; c != COLS; ++c )
+    {
+        const UInt irow = static_cast< unsigned int >( r );
+        const UInt icol = static_cast< unsigned int >( c );
+        var [ icol ][ irow ] = static_cast< ScalarT >( value );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupVariablesTestPipeline :: storeVariable ( const vpp::Bool& v )
+{
+    ( *d_pOutIntBuffer ) [ d_intResultBufferOffset++ ] = Select ( v, 1, 0 );
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupVariablesTestPipeline :: storeVariable ( const vpp::Int& v )
+{
+    ( *d_pOutIntBuffer ) [ d_intResultBufferOffset++ ] = v;
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupVariablesTestPipeline :: storeVariable ( const vpp::UInt& v )
+{
+    ( *d_pOutUIntBuffer ) [ d_uintResultBufferOffset++ ] = v;
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupVariablesTestPipeline :: storeVariable ( const vpp::Float& v )
+{
+    ( *d_pOutFloatBuffer ) [ d_floatResultBufferOffset++ ] = v;
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupVariablesTestPipeline :: storeVariable ( const vpp::Double& v )
+{
+    ( *d_pOutDoubleBuffer ) [ d_doubleResultBufferOffset++ ] = v;
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename BaseT, size_t SIZE >
+void KGroupVariablesTestPipeline :: storeVariable (
+    const vpp::TLVector< BaseT, SIZE, spv::StorageClassWorkgroup >& var )
+{
+    for ( unsigned int i = 0; i != SIZE; ++i )
+    {
+        const BaseT scalarValue = var [ i ];
+        storeVariable ( scalarValue );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename BaseT, size_t COLS, size_t ROWS  >
+void KGroupVariablesTestPipeline :: storeVariable (
+    const vpp::TLMatrix< BaseT, COLS, ROWS, spv::StorageClassWorkgroup >& var )
+{
+    for ( unsigned int r = 0; r != ROWS; ++r )
+        for ( unsigned int c = 0; c != COLS; ++c )
+    {
+        const BaseT scalarValue = var [ c ][ r ];
+        storeVariable ( scalarValue );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void KGroupVariablesTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+    using namespace vpp::ct;
+
+    group::GroupInvocation inv ( pShader );
+
+    //pShader->DebugCodeDump();
+
+    const Int ng = pShader->inNumWorkgroups [ X ];
+    const Int nl = pShader->inWorkgroupSize [ X ];
+    const Int np = ng * nl;
+    const Int l = pShader->inLocalInvocationId [ X ];
+    const Int g = pShader->inWorkgroupId [ X ];
+
+    UniformSimpleArray< int, decltype ( d_intResultBuffer ) > outIntBuffer ( d_intResultBuffer );
+    UniformSimpleArray< unsigned int, decltype ( d_uintResultBuffer ) > outUIntBuffer ( d_uintResultBuffer );
+    UniformSimpleArray< float, decltype ( d_floatResultBuffer ) > outFloatBuffer ( d_floatResultBuffer );
+    UniformSimpleArray< double, decltype ( d_doubleResultBuffer ) > outDoubleBuffer ( d_doubleResultBuffer );
+    UniformSimpleArray< int, decltype ( d_groupResultBuffer ) > outGroupBuffer ( d_groupResultBuffer );
+
+    d_pOutIntBuffer = & outIntBuffer;
+    d_pOutUIntBuffer = & outUIntBuffer;
+    d_pOutFloatBuffer = & outFloatBuffer;
+    d_pOutDoubleBuffer = & outDoubleBuffer;
+
+    WInt wint;
+    WUInt wuint;
+    WFloat wfloat;
+    WDouble wdouble;
+    WBool wbool;
+    WVec2 wvec2;
+    WVec3 wvec3;
+    WVec4 wvec4;
+    WDVec2 wdvec2;
+    WDVec3 wdvec3;
+    WDVec4 wdvec4;
+    WIVec2 wivec2;
+    WIVec3 wivec3;
+    WIVec4 wivec4;
+    WUVec2 wuvec2;
+    WUVec3 wuvec3;
+    WUVec4 wuvec4;
+    WBVec2 wbvec2;
+    WBVec3 wbvec3;
+    WBVec4 wbvec4;
+    WMat2 wmat2;
+    WMat3 wmat3;
+    WMat4 wmat4;
+    WMat2x3 wmat2x3;
+    WMat2x4 wmat2x4;
+    WMat3x2 wmat3x2;
+    WMat3x4 wmat3x4;
+    WMat4x2 wmat4x2;
+    WMat4x3 wmat4x3;
+    WDMat2 wdmat2;
+    WDMat3 wdmat3;
+    WDMat4 wdmat4;
+    WDMat2x3 wdmat2x3;
+    WDMat2x4 wdmat2x4;
+    WDMat3x2 wdmat3x2;
+    WDMat3x4 wdmat3x4;
+    WDMat4x2 wdmat4x2;
+    WDMat4x3 wdmat4x3;
+
+    WArray< Vec2 > wav2 ( 2 );
+    WArray2< Mat2 > wa2m2 ( 2, 2 );
+    WArray3< Int > wa3i ( 2, 2, 2 );
+
+    If ( inv.LocalId() == 0 );
+        setVariable ( wint, 0 );
+        setVariable ( wuint, 0 );
+        setVariable ( wfloat, 0 );
+        setVariable ( wdouble, 0 );
+        setVariable ( wbool, 0 );
+        setVariable ( wvec2, 0 );
+        setVariable ( wvec3, 0 );
+        setVariable ( wvec4, 0 );
+        setVariable ( wdvec2, 0 );
+        setVariable ( wdvec3, 0 );
+        setVariable ( wdvec4, 0 );
+        setVariable ( wivec2, 0 );
+        setVariable ( wivec3, 0 );
+        setVariable ( wivec4, 0 );
+        setVariable ( wuvec2, 0 );
+        setVariable ( wuvec3, 0 );
+        setVariable ( wuvec4, 0 );
+        setVariableB ( wbvec2, 0 );
+        setVariableB ( wbvec3, 0 );
+        setVariableB ( wbvec4, 0 );
+        setVariable ( wmat2, 0 );
+        setVariable ( wmat3, 0 );
+        setVariable ( wmat4, 0 );
+        setVariable ( wmat2x3, 0 );
+        setVariable ( wmat2x4, 0 );
+        setVariable ( wmat3x2, 0 );
+        setVariable ( wmat3x4, 0 );
+        setVariable ( wmat4x2, 0 );
+        setVariable ( wmat4x3, 0 );
+        setVariable ( wdmat2, 0 );
+        setVariable ( wdmat3, 0 );
+        setVariable ( wdmat4, 0 );
+        setVariable ( wdmat2x3, 0 );
+        setVariable ( wdmat2x4, 0 );
+        setVariable ( wdmat3x2, 0 );
+        setVariable ( wdmat3x4, 0 );
+        setVariable ( wdmat4x2, 0 );
+        setVariable ( wdmat4x3, 0 );
+
+        wav2 [ 0 ][ 0 ] = 0.0f;
+        wav2 [ 0 ][ 1 ] = 0.0f;
+        wav2 [ 1 ][ 0 ] = 0.0f;
+        wav2 [ 1 ][ 1 ] = 0.0f;
+
+        wa2m2 [ 0 ][ 0 ][ 0 ][ 0 ] = 0.0f;
+        wa2m2 [ 0 ][ 0 ][ 0 ][ 1 ] = 0.0f;
+        wa2m2 [ 0 ][ 0 ][ 1 ][ 0 ] = 0.0f;
+        wa2m2 [ 0 ][ 0 ][ 1 ][ 1 ] = 0.0f;
+        wa2m2 [ 0 ][ 1 ][ 0 ][ 0 ] = 0.0f;
+        wa2m2 [ 0 ][ 1 ][ 0 ][ 1 ] = 0.0f;
+        wa2m2 [ 0 ][ 1 ][ 1 ][ 0 ] = 0.0f;
+        wa2m2 [ 0 ][ 1 ][ 1 ][ 1 ] = 0.0f;
+        wa2m2 [ 1 ][ 0 ][ 0 ][ 0 ] = 0.0f;
+        wa2m2 [ 1 ][ 0 ][ 0 ][ 1 ] = 0.0f;
+        wa2m2 [ 1 ][ 0 ][ 1 ][ 0 ] = 0.0f;
+        wa2m2 [ 1 ][ 0 ][ 1 ][ 1 ] = 0.0f;
+        wa2m2 [ 1 ][ 1 ][ 0 ][ 0 ] = 0.0f;
+        wa2m2 [ 1 ][ 1 ][ 0 ][ 1 ] = 0.0f;
+        wa2m2 [ 1 ][ 1 ][ 1 ][ 0 ] = 0.0f;
+        wa2m2 [ 1 ][ 1 ][ 1 ][ 1 ] = 0.0f;
+
+        wa3i [ 0 ][ 0 ][ 0 ] = 0;
+        wa3i [ 0 ][ 0 ][ 1 ] = 0;
+        wa3i [ 0 ][ 1 ][ 0 ] = 0;
+        wa3i [ 0 ][ 1 ][ 1 ] = 0;
+        wa3i [ 1 ][ 0 ][ 0 ] = 0;
+        wa3i [ 1 ][ 0 ][ 1 ] = 0;
+        wa3i [ 1 ][ 1 ][ 0 ] = 0;
+        wa3i [ 1 ][ 1 ][ 1 ] = 0;
+
+    Fi();
+
+    WorkgroupBarrier();
+
+    If ( inv.LocalId() == 1 );
+        setVariable ( wint, 1 );
+        setVariable ( wuint, 1 );
+        setVariable ( wfloat, 1 );
+        setVariable ( wdouble, 1 );
+        setVariable ( wbool, 1 );
+        setVariable ( wvec2, 1 );
+        setVariable ( wvec3, 1 );
+        setVariable ( wvec4, 1 );
+        setVariable ( wdvec2, 1 );
+        setVariable ( wdvec3, 1 );
+        setVariable ( wdvec4, 1 );
+        setVariable ( wivec2, 1 );
+        setVariable ( wivec3, 1 );
+        setVariable ( wivec4, 1 );
+        setVariable ( wuvec2, 1 );
+        setVariable ( wuvec3, 1 );
+        setVariable ( wuvec4, 1 );
+        setVariableB ( wbvec2, 1 );
+        setVariableB ( wbvec3, 1 );
+        setVariableB ( wbvec4, 1 );
+        setVariable ( wmat2, 1 );
+        setVariable ( wmat3, 1 );
+        setVariable ( wmat4, 1 );
+        setVariable ( wmat2x3, 1 );
+        setVariable ( wmat2x4, 1 );
+        setVariable ( wmat3x2, 1 );
+        setVariable ( wmat3x4, 1 );
+        setVariable ( wmat4x2, 1 );
+        setVariable ( wmat4x3, 1 );
+        setVariable ( wdmat2, 1 );
+        setVariable ( wdmat3, 1 );
+        setVariable ( wdmat4, 1 );
+        setVariable ( wdmat2x3, 1 );
+        setVariable ( wdmat2x4, 1 );
+        setVariable ( wdmat3x2, 1 );
+        setVariable ( wdmat3x4, 1 );
+        setVariable ( wdmat4x2, 1 );
+        setVariable ( wdmat4x3, 1 );
+
+        wav2 [ 0 ][ 0 ] = 1.0f;
+        wav2 [ 0 ][ 1 ] = 1.0f;
+        wav2 [ 1 ][ 0 ] = 1.0f;
+        wav2 [ 1 ][ 1 ] = 1.0f;
+
+        wa2m2 [ 0 ][ 0 ][ 0 ][ 0 ] = 1.0f;
+        wa2m2 [ 0 ][ 0 ][ 0 ][ 1 ] = 1.0f;
+        wa2m2 [ 0 ][ 0 ][ 1 ][ 0 ] = 1.0f;
+        wa2m2 [ 0 ][ 0 ][ 1 ][ 1 ] = 1.0f;
+        wa2m2 [ 0 ][ 1 ][ 0 ][ 0 ] = 1.0f;
+        wa2m2 [ 0 ][ 1 ][ 0 ][ 1 ] = 1.0f;
+        wa2m2 [ 0 ][ 1 ][ 1 ][ 0 ] = 1.0f;
+        wa2m2 [ 0 ][ 1 ][ 1 ][ 1 ] = 1.0f;
+        wa2m2 [ 1 ][ 0 ][ 0 ][ 0 ] = 1.0f;
+        wa2m2 [ 1 ][ 0 ][ 0 ][ 1 ] = 1.0f;
+        wa2m2 [ 1 ][ 0 ][ 1 ][ 0 ] = 1.0f;
+        wa2m2 [ 1 ][ 0 ][ 1 ][ 1 ] = 1.0f;
+        wa2m2 [ 1 ][ 1 ][ 0 ][ 0 ] = 1.0f;
+        wa2m2 [ 1 ][ 1 ][ 0 ][ 1 ] = 1.0f;
+        wa2m2 [ 1 ][ 1 ][ 1 ][ 0 ] = 1.0f;
+        wa2m2 [ 1 ][ 1 ][ 1 ][ 1 ] = 1.0f;
+
+        wa3i [ 0 ][ 0 ][ 0 ] = 1;
+        wa3i [ 0 ][ 0 ][ 1 ] = 1;
+        wa3i [ 0 ][ 1 ][ 0 ] = 1;
+        wa3i [ 0 ][ 1 ][ 1 ] = 1;
+        wa3i [ 1 ][ 0 ][ 0 ] = 1;
+        wa3i [ 1 ][ 0 ][ 1 ] = 1;
+        wa3i [ 1 ][ 1 ][ 0 ] = 1;
+        wa3i [ 1 ][ 1 ][ 1 ] = 1;
+    Fi();
+
+    WorkgroupBarrier();
+
+    If ( inv.LocalId() == 0 );
+        storeVariable ( wint );
+        storeVariable ( wuint );
+        storeVariable ( wfloat );
+        storeVariable ( wdouble );
+        storeVariable ( wbool );
+        storeVariable ( wvec2 );
+        storeVariable ( wvec3 );
+        storeVariable ( wvec4 );
+        storeVariable ( wdvec2 );
+        storeVariable ( wdvec3 );
+        storeVariable ( wdvec4 );
+        storeVariable ( wivec2 );
+        storeVariable ( wivec3 );
+        storeVariable ( wivec4 );
+        storeVariable ( wuvec2 );
+        storeVariable ( wuvec3 );
+        storeVariable ( wuvec4 );
+        storeVariable ( wbvec2 );
+        storeVariable ( wbvec3 );
+        storeVariable ( wbvec4 );
+        storeVariable ( wmat2 );
+        storeVariable ( wmat3 );
+        storeVariable ( wmat4 );
+        storeVariable ( wmat2x3 );
+        storeVariable ( wmat2x4 );
+        storeVariable ( wmat3x2 );
+        storeVariable ( wmat3x4 );
+        storeVariable ( wmat4x2 );
+        storeVariable ( wmat4x3 );
+        storeVariable ( wdmat2 );
+        storeVariable ( wdmat3 );
+        storeVariable ( wdmat4 );
+        storeVariable ( wdmat2x3 );
+        storeVariable ( wdmat2x4 );
+        storeVariable ( wdmat3x2 );
+        storeVariable ( wdmat3x4 );
+        storeVariable ( wdmat4x2 );
+        storeVariable ( wdmat4x3 );
+
+        storeVariable ( wav2 [ 0 ][ 0 ] );
+        storeVariable ( wav2 [ 0 ][ 1 ] );
+        storeVariable ( wav2 [ 1 ][ 0 ] );
+        storeVariable ( wav2 [ 1 ][ 1 ] );
+
+        storeVariable ( wa2m2 [ 0 ][ 0 ][ 0 ][ 0 ] );
+        storeVariable ( wa2m2 [ 0 ][ 0 ][ 0 ][ 1 ] );
+        storeVariable ( wa2m2 [ 0 ][ 0 ][ 1 ][ 0 ] );
+        storeVariable ( wa2m2 [ 0 ][ 0 ][ 1 ][ 1 ] );
+        storeVariable ( wa2m2 [ 0 ][ 1 ][ 0 ][ 0 ] );
+        storeVariable ( wa2m2 [ 0 ][ 1 ][ 0 ][ 1 ] );
+        storeVariable ( wa2m2 [ 0 ][ 1 ][ 1 ][ 0 ] );
+        storeVariable ( wa2m2 [ 0 ][ 1 ][ 1 ][ 1 ] );
+        storeVariable ( wa2m2 [ 1 ][ 0 ][ 0 ][ 0 ] );
+        storeVariable ( wa2m2 [ 1 ][ 0 ][ 0 ][ 1 ] );
+        storeVariable ( wa2m2 [ 1 ][ 0 ][ 1 ][ 0 ] );
+        storeVariable ( wa2m2 [ 1 ][ 0 ][ 1 ][ 1 ] );
+        storeVariable ( wa2m2 [ 1 ][ 1 ][ 0 ][ 0 ] );
+        storeVariable ( wa2m2 [ 1 ][ 1 ][ 0 ][ 1 ] );
+        storeVariable ( wa2m2 [ 1 ][ 1 ][ 1 ][ 0 ] );
+        storeVariable ( wa2m2 [ 1 ][ 1 ][ 1 ][ 1 ] );
+
+        storeVariable ( wa3i [ 0 ][ 0 ][ 0 ] );
+        storeVariable ( wa3i [ 0 ][ 0 ][ 1 ] );
+        storeVariable ( wa3i [ 0 ][ 1 ][ 0 ] );
+        storeVariable ( wa3i [ 0 ][ 1 ][ 1 ] );
+        storeVariable ( wa3i [ 1 ][ 0 ][ 0 ] );
+        storeVariable ( wa3i [ 1 ][ 0 ][ 1 ] );
+        storeVariable ( wa3i [ 1 ][ 1 ][ 0 ] );
+        storeVariable ( wa3i [ 1 ][ 1 ][ 1 ] );
+
+    Fi();
+
+    WArray2< Int > wa2i ( 6, 10 );
+    WArray< Int > tmp ( 2 * inv.localCount() + 2 );
+    
+    group::Fill ( wa2i [ 0 ], Int ( 17 ), inv );
+    group::Copy ( wa2i [ 0 ], wa2i [ 1 ], inv );
+    group::Generate ( wa2i [ 2 ], []( const Int& idx ){ return 100-idx; }, inv );
+    group::Transform ( wa2i [ 2 ], wa2i [ 3 ], []( const Int& v ){ return 2*v; }, inv );
+    group::Sort ( wa2i [ 3 ], []( const Int& v1, const Int& v2 ){ return v1 < v2; }, inv );
+
+    const Int lb = group::LowerBound (
+        wa2i [ 3 ], 184,
+        []( const Int& v1, const Int& v2 ){ return v1 < v2; },
+        tmp, inv );
+
+    const Int ub = group::UpperBound (
+        wa2i [ 3 ], 184,
+        []( const Int& v1, const Int& v2 ){ return v1 < v2; },
+        tmp, inv );
+
+    group::Fill ( wa2i [ 4 ], lb, inv );
+    group::Fill ( wa2i [ 5 ], ub, inv );
+
+    group::Store ( wa2i, outGroupBuffer, 0, inv );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                 Atomics tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KAtomicsTestPipeline1 :: KAtomicsTestPipeline1 ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & KAtomicsTestPipeline1::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KAtomicsTestPipeline1 :: setData (
+    const DataBuffer& resultView,
+    const DataBuffer& testView,
+    const DataBuffer64& testView64,
+    const TestImageView& testImageView,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_resultBuffer = resultView,
+        d_testBuffer = testView,
+        d_testBuffer64 = testView64,
+        d_testImage = testImageView
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KAtomicsTestPipeline1 :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    //pShader->DebugCodeDump();
+
+    const Int ng = pShader->inNumWorkgroups [ X ];
+    const Int nl = pShader->inWorkgroupSize [ X ];
+    const Int np = ng * nl;
+    const Int l = pShader->inLocalInvocationId [ X ];
+    const Int g = pShader->inWorkgroupId [ X ];
+
+    const Int nIterations = 10;
+    const Int nBlockSize = BLOCK_SIZE;
+
+    UniformSimpleArray< int, decltype ( d_resultBuffer ) > outBuffer ( d_resultBuffer );
+    UniformSimpleArray< int, decltype ( d_testBuffer ) > testBuffer ( d_testBuffer );
+    UniformSimpleArray< std::uint64_t, decltype ( d_testBuffer64 ) > testBuffer64 ( d_testBuffer64 );
+    UseImage ( d_testImage );
+
+    WInt atomicInt = 0;
+    WUInt atomicUInt = 0;
+    WInt64 atomicInt64 = 0;
+    WUInt64 atomicUInt64 = 0;
+
+    VInt i;
+
+    For ( i, 0, nIterations );
+    {
+        const Int localIdx = ( & atomicInt ).Increment();
+        const Int globalIdx = g * nl * nIterations + localIdx;
+        outBuffer [ globalIdx ] = 1;
+    }
+    Rof();
+
+    WorkgroupBarrier();
+
+    For ( i, 0, nIterations );
+    {
+        const UInt localIdx = ( & atomicUInt ).Increment();
+        const Int globalIdx = nBlockSize + g * nl * nIterations + Int(localIdx);
+        outBuffer [ globalIdx ] = 1;
+    }
+    Rof();
+
+    WorkgroupBarrier();
+
+    For ( i, 0, nIterations );
+    {
+        const Int64 localIdx = ( & atomicInt64 ).Add ( 1 );
+        const Int globalIdx = 2*nBlockSize + g * nl * nIterations + Int(localIdx);
+        outBuffer [ globalIdx ] = 1;
+    }
+    Rof();
+
+    WorkgroupBarrier();
+
+    For ( i, 0, nIterations );
+    {
+        const UInt64 localIdx = ( & atomicUInt64 ).Increment();
+        const Int globalIdx = 3*nBlockSize + g * nl * nIterations + Int(localIdx);
+        outBuffer [ globalIdx ] = 1;
+    }
+    Rof();
+
+    WorkgroupBarrier();
+
+    For ( i, 0, nIterations );
+    {
+        const Int localIdx = ( & testBuffer [ 0 ] ).Increment();
+        const Int globalIdx = 4*nBlockSize + localIdx;
+        outBuffer [ globalIdx ] = 1;
+    }
+    Rof();
+
+    WorkgroupBarrier();
+
+    For ( i, 0, nIterations );
+    {
+        const UInt localIdx = d_testImage.GetPointer ( IVec2 { 0, 0 } ).Increment();
+        const Int globalIdx = 5*nBlockSize + Int(localIdx);
+        outBuffer [ globalIdx ] = 1;
+    }
+    Rof();
+
+    WorkgroupBarrier();
+
+    For ( i, 0, nIterations );
+    {
+        const Pointer< UInt64 > p = & testBuffer64 [ 0 ];
+        const UInt64 localIdx = p.Increment();
+        const Int globalIdx = 6*nBlockSize + Int(localIdx);
+        outBuffer [ globalIdx ] = 1;
+    }
+    Rof();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                            Descriptor update tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KDescriptorUpdateTestPipeline :: KDescriptorUpdateTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { BUFFER_LENGTH, 1, 1 }, & KDescriptorUpdateTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KDescriptorUpdateTestPipeline :: setFirstBuffer (
+    const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update (( d_firstBuffer = buffer ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KDescriptorUpdateTestPipeline :: setSecondBuffer (
+    const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update (( d_secondBuffer = buffer ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KDescriptorUpdateTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    UniformSimpleArray< int, decltype ( d_firstBuffer ) > outFirst ( d_firstBuffer );
+    UniformSimpleArray< int, decltype ( d_secondBuffer ) > outSecond ( d_secondBuffer );
+
+    const Int l = pShader->inLocalInvocationId [ X ];
+
+    outFirst [ l ] = l + 1;
+    outSecond [ l ] = l + 1001;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Debug print tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KDebugPrintTestPipeline :: KDebugPrintTestPipeline (
+    const vpp::Device& hDevice, const vpp::DebugPrintBuffer& hDebugPrint ) :
+        d_shader ( this, { WORKGROUP_SIZE, 1, 1 }, & KDebugPrintTestPipeline::fComputeShader )
+{
+    enableDebugPrint ( hDebugPrint );
+}
+
+// -----------------------------------------------------------------------------
+
+void KDebugPrintTestPipeline :: setDataBuffer (
+    const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update (( d_dataBuffer = buffer ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KDebugPrintTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    UniformSimpleArray< unsigned int, decltype ( d_dataBuffer ) > outData ( d_dataBuffer );
+
+    const Int g = pShader->inGlobalInvocationId [ X ];
+    const UInt value = StaticCast< UInt >( g + 100 );
+
+    outData [ g ] = value;
+    pShader->DebugPrint ( "v=%u", value );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Loop control tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KLoopControlTestPipeline :: KLoopControlTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { WORKGROUP_SIZE, 1, 1 }, & KLoopControlTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KLoopControlTestPipeline :: setDataBuffer (
+    const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update (( d_dataBuffer = buffer ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KLoopControlTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    UniformSimpleArray< int, decltype ( d_dataBuffer ) > outData ( d_dataBuffer );
+
+    const Int l = pShader->inLocalInvocationId [ X ];
+
+    // Unrolled while translating, the index is a C++ constant in each copy.
+
+    VInt a = 0;
+
+    StaticFor< 4 >( [ & ]( int i )
+    {
+        a = a + ( l + i ) * ( i + 1 );
+    } );
+
+    // Descending range, END is excluded.
+
+    VInt b = 0;
+
+    StaticFor< 6, 0, -2 >( [ & ]( int i )
+    {
+        b = b + l * i;
+    } );
+
+    // Control hints must not change results.
+
+    VInt k;
+
+    For ( k, 0, 4, Unroll() );
+        b = b + k;
+    Rof();
+
+    VInt c = 0;
+    VInt j;
+
+    For ( j, 0, l, DontUnroll() );
+        c = c + j;
+    Rof();
+
+    If ( ( l & 1 ) == 1, Flatten() );
+        c = c + 1000;
+    Fi();
+
+    const int n = VALUE_COUNT;
+
+    outData [ n*l ] = a;
+    outData [ n*l + 1 ] = b;
+    outData [ n*l + 2 ] = c;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                            Specialization tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KSpecializationTestPipeline :: KSpecializationTestPipeline ( const vpp::Device& hDevice ) :
+    d_localSizeX ( DEFAULT_LOCAL_SIZE ),
+    d_localSizeY ( 1 ),
+    d_localSizeZ ( 1 ),
+    d_scale ( 1 ),
+    d_bNegate ( false ),
+    d_shader (
+        this, d_localSizeX, d_localSizeY, d_localSizeZ,
+        & KSpecializationTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KSpecializationTestPipeline :: setDataBuffer (
+    const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update (( d_dataBuffer = buffer ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KSpecializationTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    UniformSimpleArray< int, decltype ( d_dataBuffer ) > outData ( d_dataBuffer );
+
+    const Int g = pShader->inGlobalInvocationId [ X ];
+    const Int localSize = pShader->inWorkgroupSize [ X ];
+    const Int scale = SpecConst< int >( d_scale );
+    const Bool bNegate = SpecConst< bool >( d_bNegate );
+
+    VInt value = g*scale + 1000*localSize;
+
+    If ( bNegate );
+        value = -value;
+    Fi();
+
+    outData [ g ] = value;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                           Narrow integer tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+KNarrowIntegerTestPipeline :: KNarrowIntegerTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { WORKGROUP_SIZE, 1, 1 }, & KNarrowIntegerTestPipeline::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+void KNarrowIntegerTestPipeline :: setBuffers (
+    const ShortBuffer& shortBuffer,
+    const IntBuffer& intBuffer,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_shortBuffer = shortBuffer,
+        d_intBuffer = intBuffer
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+void KNarrowIntegerTestPipeline :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    UniformSimpleArray< std::int16_t, decltype ( d_shortBuffer ) > outShort ( d_shortBuffer );
+    UniformSimpleArray< int, decltype ( d_intBuffer ) > outInt ( d_intBuffer );
+
+    const Int l = pShader->inLocalInvocationId [ X ];
+
+    // Values above 32767 wrap around when narrowed.
+
+    const Int16 s = StaticCast< Int16 >( l*1000 - 20000 );
+    const UInt16 u = StaticCast< UInt16 >( s );
+
+    outShort [ l ] = s;
+
+    // Widening must sign-extend signed and zero-extend unsigned values.
+
+    outInt [ 2*l ] = StaticCast< Int >( s );
+    outInt [ 2*l + 1 ] = StaticCast< Int >( u );
+}
+
+// -----------------------------------------------------------------------------
+} // namespace vpptest
+// -----------------------------------------------------------------------------
@@ -0,0 +1,1601 @@
+// -----------------------------------------------------------------------------
+#ifndef INC_VPPTESTCOMPUTATIONPIPELINES_HPP
+#define INC_VPPTESTCOMPUTATIONPIPELINES_HPP
+
+// -----------------------------------------------------------------------------
+
+#pragma warning (disable: 4503)
+#include <vppAll.hpp>
+
+// -----------------------------------------------------------------------------
+
+#include <numeric>
+
+// -----------------------------------------------------------------------------
+namespace vpptest {
+// -----------------------------------------------------------------------------
+
+// Pipelines (shaders and their resources) used by the computation tests. They
+// are shared with vppBench, which measures the same shaders.
+
+// -----------------------------------------------------------------------------
+
+inline bool compareFloats ( float a, float b )
+{
+    static const float s_eps = 0.00001f;
+    return std::abs ( a - b ) <= s_eps;
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename T >
+struct TTestTypeTraits
+{
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< float >
+{
+    typedef vpp::Float shader_type;
+
+    inline float create ( float v ) const
+    {
+        return v;
+    }
+
+    inline vpp::Float create ( const vpp::Float& v ) const
+    {
+        return v;
+    }
+
+    inline bool compare ( float a, float b ) const
+    {
+        return compareFloats ( a, b );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< vpp::vect2 >
+{
+    typedef vpp::Vec2 shader_type;
+
+    inline vpp::vect2 create ( float v ) const
+    {
+        vpp::vect2 r;
+        r.set ( v, v );
+        return r;
+    }
+
+    inline vpp::Vec2 create ( const vpp::Float& v ) const
+    {
+        return vpp::Vec2 ( v, v );
+    }
+
+    inline bool compare ( const vpp::vect2& a, const vpp::vect2& b ) const
+    {
+        return compareFloats ( a.x, b.x ) && compareFloats ( a.y, b.y );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< vpp::vect3 >
+{
+    typedef vpp::Vec3 shader_type;
+
+    inline vpp::vect3 create ( float v ) const
+    {
+        vpp::vect3 r;
+        r.set ( v, v, v );
+        return r;
+    }
+
+    inline vpp::Vec3 create ( const vpp::Float& v ) const
+    {
+        return vpp::Vec3 ( v, v, v );
+    }
+
+    inline bool compare ( const vpp::vect3& a, const vpp::vect3& b ) const
+    {
+        return
+            compareFloats ( a.x, b.x )
+            && compareFloats ( a.y, b.y )
+            && compareFloats ( a.z, b.z );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< vpp::vect4 >
+{
+    typedef vpp::Vec4 shader_type;
+
+    inline vpp::vect4 create ( float v ) const
+    {
+        vpp::vect4 r;
+        r.set ( v, v, v, v );
+        return r;
+    }
+
+    inline vpp::Vec4 create ( const vpp::Float& v ) const
+    {
+        return vpp::Vec4 ( v, v, v, v );
+    }
+
+    inline bool compare ( const vpp::vect4& a, const vpp::vect4& b ) const
+    {
+        return
+            compareFloats ( a.x, b.x )
+            && compareFloats ( a.y, b.y )
+            && compareFloats ( a.z, b.z )
+            && compareFloats ( a.w, b.w );
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< int >
+{
+    typedef vpp::Int shader_type;
+
+    inline int create ( int v ) const
+    {
+        return v;
+    }
+
+    inline vpp::Int create ( const vpp::Int& v ) const
+    {
+        return v;
+    }
+
+    inline bool compare ( int a, int b ) const
+    {
+        return a == b;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< vpp::ivect2 >
+{
+    typedef vpp::IVec2 shader_type;
+
+    inline vpp::ivect2 create ( int v ) const
+    {
+        vpp::ivect2 r;
+        r.set ( v, v );
+        return r;
+    }
+
+    inline vpp::IVec2 create ( const vpp::Int& v ) const
+    {
+        return vpp::IVec2 ( v, v );
+    }
+
+    inline bool compare ( const vpp::ivect2& a, const vpp::ivect2& b ) const
+    {
+        return a.r == b.r && a.g == b.g;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< vpp::ivect3 >
+{
+    typedef vpp::IVec3 shader_type;
+
+    inline vpp::ivect3 create ( int v ) const
+    {
+        vpp::ivect3 r;
+        r.set ( v, v, v );
+        return r;
+    }
+
+    inline vpp::IVec3 create ( const vpp::Int& v ) const
+    {
+        return vpp::IVec3 ( v, v, v );
+    }
+
+    inline bool compare ( const vpp::ivect3& a, const vpp::ivect3& b ) const
+    {
+        return a.r == b.r && a.g == b.g && a.b == b.b;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< vpp::ivect4 >
+{
+    typedef vpp::IVec4 shader_type;
+
+    inline vpp::ivect4 create ( int v ) const
+    {
+        vpp::ivect4 r;
+        r.set ( v, v, v, v );
+        return r;
+    }
+
+    inline vpp::IVec4 create ( const vpp::Int& v ) const
+    {
+        return vpp::IVec4 ( v, v, v, v );
+    }
+
+    inline bool compare ( const vpp::ivect4& a, const vpp::ivect4& b ) const
+    {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< unsigned int >
+{
+    typedef vpp::UInt shader_type;
+
+    inline unsigned int create ( unsigned int v ) const
+    {
+        return v;
+    }
+
+    inline vpp::UInt create ( const vpp::UInt& v ) const
+    {
+        return v;
+    }
+
+    inline bool compare ( unsigned int a, unsigned int b ) const
+    {
+        return a == b;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< vpp::uvect2 >
+{
+    typedef vpp::UVec2 shader_type;
+
+    inline vpp::uvect2 create ( unsigned int v ) const
+    {
+        vpp::uvect2 r;
+        r.set ( v, v );
+        return r;
+    }
+
+    inline vpp::UVec2 create ( const vpp::UInt& v ) const
+    {
+        return vpp::UVec2 ( v, v );
+    }
+
+    inline bool compare ( const vpp::uvect2& a, const vpp::uvect2& b ) const
+    {
+        return a.r == b.r && a.g == b.g;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< vpp::uvect3 >
+{
+    typedef vpp::UVec3 shader_type;
+
+    inline vpp::uvect3 create ( unsigned int v ) const
+    {
+        vpp::uvect3 r;
+        r.set ( v, v, v );
+        return r;
+    }
+
+    inline vpp::UVec3 create ( const vpp::UInt& v ) const
+    {
+        return vpp::UVec3 ( v, v, v );
+    }
+
+    inline bool compare ( const vpp::uvect3& a, const vpp::uvect3& b ) const
+    {
+        return a.r == b.r && a.g == b.g && a.b == b.b;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+template<>
+struct TTestTypeTraits< vpp::uvect4 >
+{
+    typedef vpp::UVec4 shader_type;
+
+    inline vpp::uvect4 create ( unsigned int v ) const
+    {
+        vpp::uvect4 r;
+        r.set ( v, v, v, v );
+        return r;
+    }
+
+    inline vpp::UVec4 create ( const vpp::UInt& v ) const
+    {
+        return vpp::UVec4 ( v, v, v, v );
+    }
+
+    inline bool compare ( const vpp::uvect4& a, const vpp::uvect4& b ) const
+    {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+template< vpp::ETag TAG >
+struct TParams : public vpp::UniformStruct< TAG, TParams >
+{
+    vpp::UniformFld< TAG, vpp::format< int, int, int, int > > d_params;
+};
+
+typedef TParams< vpp::GPU > GParams;
+typedef TParams< vpp::CPU > CParams;
+typedef vpp::gvector< CParams, vpp::Buf::UNIFORM > CParamsBuffer;
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                Test scalar (or by-component) float functions
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+enum EFloatTests
+{
+    FT_ADD, FT_SUB, FT_MUL, FT_DIV, FT_REM, FT_MOD,
+
+    FT_EQU1, FT_NEQ1, FT_LSS1, FT_GTR1, FT_LEQ1, FT_GEQ1,
+    FT_EQU0, FT_NEQ0, FT_LSS0, FT_GTR0, FT_LEQ0, FT_GEQ0,
+
+    FT_ROUND, FT_ROUND_EVEN, FT_TRUNC,
+    FT_ABS, FT_SIGN, FT_FLOOR, FT_CEIL, FT_FRACT,
+    FT_RADIANS, FT_DEGREES,
+
+    FT_SIN, FT_COS, FT_TAN, FT_ASIN, FT_ACOS, FT_ATAN,
+    FT_SINH, FT_COSH, FT_TANH, FT_ASINH, FT_ACOSH, FT_ATANH,
+    FT_ATAN2,
+
+    FT_POW, FT_EXP, FT_LOG, FT_EXP2, FT_LOG2, FT_SQRT, FT_INVSQRT, FT_MIN, FT_MAX,
+    FT_CLAMP0, FT_CLAMP1, FT_CLAMP2,
+    FT_MIX0, FT_MIX1, FT_MIX2, FT_STEP0, FT_STEP1,
+    FT_SMOOTHSTEP0, FT_SMOOTHSTEP1, FT_SMOOTHSTEP2,
+
+    FT_MODF,
+
+    FT_count
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+template< typename HostT >
+class TFloatTestPipeline : public vpp::ComputePipelineConfig
+{
+public:
+    TFloatTestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const vpp::StorageBufferView& vs1,
+        const vpp::StorageBufferView& vs2,
+        const vpp::StorageBufferView& vt,
+        int size,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_source1;
+    vpp::ioBuffer d_source2;
+    vpp::ioBuffer d_target;
+
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+
+template< typename HostT >
+TFloatTestPipeline< HostT > :: TFloatTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & TFloatTestPipeline< HostT >::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename HostT >
+void TFloatTestPipeline< HostT > :: setData (
+    const vpp::StorageBufferView& vs1,
+    const vpp::StorageBufferView& vs2,
+    const vpp::StorageBufferView& vt,
+    int size,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_source1 = vs1,
+        d_source2 = vs2,
+        d_target = vt
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename HostT >
+void TFloatTestPipeline< HostT > :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    //pShader->DebugCodeDump();
+
+    typedef typename TTestTypeTraits< HostT >::shader_type shader_type;
+    TTestTypeTraits< HostT > tt;
+
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+    const IVec3 localId = pShader->inLocalInvocationId;
+    const Int g = workgroupId [ X ];
+    const Int l = localId [ X ];
+
+    UniformSimpleArray< HostT, decltype ( d_source1 ) > inSource1 ( d_source1 );
+    UniformSimpleArray< HostT, decltype ( d_source2 ) > inSource2 ( d_source2 );
+    UniformSimpleArray< HostT, decltype ( d_target ) > outTarget ( d_target );
+
+    const shader_type v0 = tt.create ( Float ( 0.0f ) );
+    const shader_type v1 = tt.create ( Float ( 1.0f ) );
+    const shader_type v2 = tt.create ( Float ( 2.0f ) );
+
+    If ( g == 0 && l == 0 );
+        outTarget [ FT_ADD ] = inSource1 [ FT_ADD ] + inSource2 [ FT_ADD ];
+        outTarget [ FT_SUB ] = inSource1 [ FT_SUB ] - inSource2 [ FT_SUB ];
+        outTarget [ FT_MUL ] = inSource1 [ FT_MUL ] * inSource2 [ FT_MUL ];
+        outTarget [ FT_DIV ] = inSource1 [ FT_DIV ] / inSource2 [ FT_DIV ];
+        outTarget [ FT_REM ] = inSource1 [ FT_REM ] % inSource2 [ FT_REM ];
+        outTarget [ FT_MOD ] = Mod ( inSource1 [ FT_MOD ], inSource2 [ FT_MOD ] );
+
+        outTarget [ FT_EQU1 ] = Select ( inSource1 [ FT_EQU1 ] == inSource2 [ FT_EQU1 ], v1, v0 );
+        outTarget [ FT_NEQ1 ] = Select ( inSource1 [ FT_NEQ1 ] != inSource2 [ FT_NEQ1 ], v1, v0 );
+        outTarget [ FT_LSS1 ] = Select ( inSource1 [ FT_LSS1 ] < inSource2 [ FT_LSS1 ], v1, v0 );
+        outTarget [ FT_GTR1 ] = Select ( inSource1 [ FT_GTR1 ] > inSource2 [ FT_GTR1 ], v1, v0 );
+        outTarget [ FT_LEQ1 ] = Select ( inSource1 [ FT_LEQ1 ] <= inSource2 [ FT_LEQ1 ], v1, v0 );
+        outTarget [ FT_GEQ1 ] = Select ( inSource1 [ FT_GEQ1 ] >= inSource2 [ FT_GEQ1 ], v1, v0 );
+        outTarget [ FT_EQU0 ] = Select ( inSource1 [ FT_EQU0 ] == inSource2 [ FT_EQU0 ], v1, v0 );
+        outTarget [ FT_NEQ0 ] = Select ( inSource1 [ FT_NEQ0 ] != inSource2 [ FT_NEQ0 ], v1, v0 );
+        outTarget [ FT_LSS0 ] = Select ( inSource1 [ FT_LSS0 ] < inSource2 [ FT_LSS0 ], v1, v0 );
+        outTarget [ FT_GTR0 ] = Select ( inSource1 [ FT_GTR0 ] > inSource2 [ FT_GTR0 ], v1, v0 );
+        outTarget [ FT_LEQ0 ] = Select ( inSource1 [ FT_LEQ0 ] <= inSource2 [ FT_LEQ0 ], v1, v0 );
+        outTarget [ FT_GEQ0 ] = Select ( inSource1 [ FT_GEQ0 ] >= inSource2 [ FT_GEQ0 ], v1, v0 );
+
+        outTarget [ FT_ROUND ] = Round ( inSource1 [ FT_ROUND ] );
+        outTarget [ FT_ROUND_EVEN ] = RoundEven ( inSource1 [ FT_ROUND_EVEN ] );
+        outTarget [ FT_TRUNC ] = Trunc ( inSource1 [ FT_TRUNC ] );
+        outTarget [ FT_ABS ] = Abs ( inSource1 [ FT_ABS ] );
+        outTarget [ FT_SIGN ] = Sign ( inSource1 [ FT_SIGN ] );
+        outTarget [ FT_FLOOR ] = Floor ( inSource1 [ FT_FLOOR ] );
+        outTarget [ FT_CEIL ] = Ceil ( inSource1 [ FT_CEIL ] );
+        outTarget [ FT_FRACT ] = Fract ( inSource1 [ FT_FRACT ] );
+        outTarget [ FT_RADIANS ] = Radians ( inSource1 [ FT_RADIANS ] );
+        outTarget [ FT_DEGREES ] = Degrees ( inSource1 [ FT_DEGREES ] );
+        outTarget [ FT_SIN ] = Sin ( inSource1 [ FT_SIN ] );
+        outTarget [ FT_COS ] = Cos ( inSource1 [ FT_COS ] );
+        outTarget [ FT_TAN ] = Tan ( inSource1 [ FT_TAN ] );
+        outTarget [ FT_ASIN ] = Asin ( inSource1 [ FT_ASIN ] );
+        outTarget [ FT_ACOS ] = Acos ( inSource1 [ FT_ACOS ] );
+        outTarget [ FT_ATAN ] = Atan ( inSource1 [ FT_ATAN ] );
+        outTarget [ FT_SINH ] = Sinh ( inSource1 [ FT_SINH ] );
+        outTarget [ FT_COSH ] = Cosh ( inSource1 [ FT_COSH ] );
+        outTarget [ FT_TANH ] = Tanh ( inSource1 [ FT_TANH ] );
+        outTarget [ FT_ASINH ] = Asinh ( inSource1 [ FT_ASINH ] );
+        outTarget [ FT_ACOSH ] = Acosh ( inSource1 [ FT_ACOSH ] );
+        outTarget [ FT_ATANH ] = Atanh ( inSource1 [ FT_ATANH ] );
+        outTarget [ FT_ATAN2 ] = Atan2 ( inSource1 [ FT_ATAN2 ], inSource2 [ FT_ATAN2 ] );
+        outTarget [ FT_POW ] = Pow ( inSource1 [ FT_POW ], inSource2 [ FT_POW ] );
+        outTarget [ FT_EXP ] = Exp ( inSource1 [ FT_EXP ] );
+        outTarget [ FT_LOG ] = Log ( inSource1 [ FT_LOG ] );
+        outTarget [ FT_EXP2 ] = Exp2 ( inSource1 [ FT_EXP2 ] );
+        outTarget [ FT_LOG2 ] = Log2 ( inSource1 [ FT_LOG2 ] );
+        outTarget [ FT_SQRT ] = Sqrt ( inSource1 [ FT_SQRT ] );
+        outTarget [ FT_INVSQRT ] = InverseSqrt ( inSource1 [ FT_INVSQRT ] );
+        outTarget [ FT_MIN ] = Min ( inSource1 [ FT_MIN ], inSource2 [ FT_MIN ] );
+        outTarget [ FT_MAX ] = Max ( inSource1 [ FT_MAX ], inSource2 [ FT_MAX ] );
+        outTarget [ FT_CLAMP0 ] = Clamp ( v0, inSource1 [ FT_CLAMP0 ], inSource2 [ FT_CLAMP0 ] );
+        outTarget [ FT_CLAMP1 ] = Clamp ( v1, inSource1 [ FT_CLAMP1 ], inSource2 [ FT_CLAMP1 ] );
+        outTarget [ FT_CLAMP2 ] = Clamp ( v2, inSource1 [ FT_CLAMP2 ], inSource2 [ FT_CLAMP2 ] );
+        outTarget [ FT_MIX0 ] = Mix ( v0, v2, inSource1 [ FT_MIX0 ] );
+        outTarget [ FT_MIX1 ] = Mix ( v0, v2, inSource1 [ FT_MIX1 ] );
+        outTarget [ FT_MIX2 ] = Mix ( v0, v2, inSource1 [ FT_MIX2 ] );
+        outTarget [ FT_STEP0 ] = Step ( inSource1 [ FT_STEP0 ], inSource2 [ FT_STEP0 ] );
+        outTarget [ FT_STEP1 ] = Step ( inSource1 [ FT_STEP1 ], inSource2 [ FT_STEP1 ] );
+        outTarget [ FT_SMOOTHSTEP0 ] = SmoothStep ( v0, v2, inSource1 [ FT_SMOOTHSTEP0 ] );
+        outTarget [ FT_SMOOTHSTEP1 ] = SmoothStep ( v0, v2, inSource1 [ FT_SMOOTHSTEP1 ] );
+        outTarget [ FT_SMOOTHSTEP2 ] = SmoothStep ( v0, v2, inSource1 [ FT_SMOOTHSTEP2 ] );
+        outTarget [ FT_MODF ] = Modf ( inSource1 [ FT_MODF ] ).first;
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                Test scalar (or by-component) integer functions
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+enum EIntegerTests
+{
+    IT_ADD, IT_SUB, IT_MUL, IT_DIV, IT_REM, IT_MOD,
+
+    IT_EQU1, IT_NEQ1, IT_LSS1, IT_GTR1, IT_LEQ1, IT_GEQ1,
+    IT_EQU0, IT_NEQ0, IT_LSS0, IT_GTR0, IT_LEQ0, IT_GEQ0,
+
+    IT_ABS, IT_SIGN, IT_MIN, IT_MAX,
+    IT_CLAMP0, IT_CLAMP1, IT_CLAMP2,
+
+    IT_FINDLSB, IT_FINDMSB, IT_BITCOUNT, IT_BITREVERSE,
+
+    IT_count
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+template< typename HostT >
+class TIntegerTestPipeline : public vpp::ComputePipelineConfig
+{
+public:
+    TIntegerTestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const vpp::StorageBufferView& vs1,
+        const vpp::StorageBufferView& vs2,
+        const vpp::StorageBufferView& vt,
+        int size,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_source1;
+    vpp::ioBuffer d_source2;
+    vpp::ioBuffer d_target;
+
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+
+template< typename HostT >
+TIntegerTestPipeline< HostT > :: TIntegerTestPipeline ( const vpp::Device& hDevice ) :
+    d_shader ( this, { 32, 1, 1 }, & TIntegerTestPipeline< HostT >::fComputeShader )
+{
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename HostT >
+void TIntegerTestPipeline< HostT > :: setData (
+    const vpp::StorageBufferView& vs1,
+    const vpp::StorageBufferView& vs2,
+    const vpp::StorageBufferView& vt,
+    int size,
+    vpp::ShaderDataBlock* pDataBlock )
+{
+    pDataBlock->update ((
+        d_source1 = vs1,
+        d_source2 = vs2,
+        d_target = vt
+    ));
+}
+
+// -----------------------------------------------------------------------------
+
+template< typename HostT >
+void TIntegerTestPipeline< HostT > :: fComputeShader ( vpp::ComputeShader* pShader )
+{
+    using namespace vpp;
+
+    //pShader->DebugCodeDump();
+
+    typedef typename TTestTypeTraits< HostT >::shader_type shader_type;
+    TTestTypeTraits< HostT > tt;
+
+    const IVec3 workgroupId = pShader->inWorkgroupId;
+    const IVec3 localId = pShader->inLocalInvocationId;
+    const Int g = workgroupId [ X ];
+    const Int l = localId [ X ];
+
+    UniformSimpleArray< HostT, decltype ( d_source1 ) > inSource1 ( d_source1 );
+    UniformSimpleArray< HostT, decltype ( d_source2 ) > inSource2 ( d_source2 );
+    UniformSimpleArray< HostT, decltype ( d_target ) > outTarget ( d_target );
+
+    const shader_type v0 = tt.create ( Int ( 0 ) );
+    const shader_type v1 = tt.create ( Int ( 1 ) );
+    const shader_type v2 = tt.create ( Int ( 2 ) );
+
+    If ( g == 0 && l == 0 );
+        outTarget [ IT_ADD ] = inSource1 [ IT_ADD ] + inSource2 [ IT_ADD ];
+        outTarget [ IT_SUB ] = inSource1 [ IT_SUB ] - inSource2 [ IT_SUB ];
+        outTarget [ IT_MUL ] = inSource1 [ IT_MUL ] * inSource2 [ IT_MUL ];
+        outTarget [ IT_DIV ] = inSource1 [ IT_DIV ] / inSource2 [ IT_DIV ];
+        outTarget [ IT_REM ] = inSource1 [ IT_REM ] % inSource2 [ IT_REM ];
+        outTarget [ IT_MOD ] = Mod ( inSource1 [ IT_MOD ], inSource2 [ IT_MOD ] );
+
+        outTarget [ IT_EQU1 ] = Select ( inSource1 [ IT_EQU1 ] == inSource2 [ IT_EQU1 ], v1, v0 );
+        outTarget [ IT_NEQ1 ] = Select ( inSource1 [ IT_NEQ1 ] != inSource2 [ IT_NEQ1 ], v1, v0 );
+        outTarget [ IT_LSS1 ] = Select ( inSource1 [ IT_LSS1 ] <  inSource2 [ IT_LSS1 ], v1, v0 );
+        outTarget [ IT_GTR1 ] = Select ( inSource1 [ IT_GTR1 ] >  inSource2 [ IT_GTR1 ], v1, v0 );
+        outTarget [ IT_LEQ1 ] = Select ( inSource1 [ IT_LEQ1 ] <= inSource2 [ IT_LEQ1 ], v1, v0 );
+        outTarget [ IT_GEQ1 ] = Select ( inSource1 [ IT_GEQ1 ] >= inSource2 [ IT_GEQ1 ], v1, v0 );
+        outTarget [ IT_EQU0 ] = Select ( inSource1 [ IT_EQU0 ] == inSource2 [ IT_EQU0 ], v1, v0 );
+        outTarget [ IT_NEQ0 ] = Select ( inSource1 [ IT_NEQ0 ] != inSource2 [ IT_NEQ0 ], v1, v0 );
+        outTarget [ IT_LSS0 ] = Select ( inSource1 [ IT_LSS0 ] <  inSource2 [ IT_LSS0 ], v1, v0 );
+        outTarget [ IT_GTR0 ] = Select ( inSource1 [ IT_GTR0 ] >  inSource2 [ IT_GTR0 ], v1, v0 );
+        outTarget [ IT_LEQ0 ] = Select ( inSource1 [ IT_LEQ0 ] <= inSource2 [ IT_LEQ0 ], v1, v0 );
+        outTarget [ IT_GEQ0 ] = Select ( inSource1 [ IT_GEQ0 ] >= inSource2 [ IT_GEQ0 ], v1, v0 );
+
+        outTarget [ IT_ABS ] = Abs ( inSource1 [ IT_ABS ] );
+        outTarget [ IT_SIGN ] = Sign ( inSource1 [ IT_SIGN ] );
+        outTarget [ IT_MIN ] = Min ( inSource1 [ IT_MIN ], inSource2 [ IT_MIN ] );
+        outTarget [ IT_MAX ] = Max ( inSource1 [ IT_MAX ], inSource2 [ IT_MAX ] );
+        outTarget [ IT_CLAMP0 ] = Clamp ( v0, inSource1 [ IT_CLAMP0 ], inSource2 [ IT_CLAMP0 ] );
+        outTarget [ IT_CLAMP1 ] = Clamp ( v1, inSource1 [ IT_CLAMP1 ], inSource2 [ IT_CLAMP1 ] );
+        outTarget [ IT_CLAMP2 ] = Clamp ( v2, inSource1 [ IT_CLAMP2 ], inSource2 [ IT_CLAMP2 ] );
+
+        outTarget [ IT_FINDLSB ] = FindLsb ( inSource1 [ IT_FINDLSB ] );
+        outTarget [ IT_FINDMSB ] = FindMsb ( inSource1 [ IT_FINDMSB ] );
+        outTarget [ IT_BITCOUNT ] = BitCount ( inSource1 [ IT_BITCOUNT ] );
+        outTarget [ IT_BITREVERSE ] = BitReverse ( inSource1 [ IT_BITREVERSE ] );
+    Fi();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                        Test vector float functions
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+enum EVectorTests
+{
+    VT_DOT2, VT_DOT3, VT_DOT4,
+    VT_OPDET2, VT_OPDET3, VT_OPDET4,
+    VT_DISTANCE2, VT_DISTANCE3, VT_DISTANCE4,
+    VT_LENGTH2, VT_LENGTH3, VT_LENGTH4,
+    VT_NORMALIZE2, VT_NORMALIZE3, VT_NORMALIZE4,
+    VT_REFRACT2, VT_REFRACT3, VT_REFRACT4,
+    VT_REFLECT2, VT_REFLECT3, VT_REFLECT4,
+    VT_FACEFORWARD2, VT_FACEFORWARD3, VT_FACEFORWARD4,
+
+    VT_count
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KVectorTestPipeline : public vpp::ComputePipelineConfig
+{
+public:
+    KVectorTestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const vpp::StorageBufferView& vs1,
+        const vpp::StorageBufferView& vs2,
+        const vpp::StorageBufferView& vt,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_source1;
+    vpp::ioBuffer d_source2;
+    vpp::ioBuffer d_target;
+
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                         Programming constructs tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+enum EConstructTests
+{
+    CT_SELECT1, CT_SELECT2, CT_SELECT3,
+    CT_IF0, CT_IF1,
+    CT_DOWHILE,
+    CT_FOR0, CT_FOR1, CT_FOR2,
+    CT_SWITCH0, CT_SWITCH1, CT_SWITCH2,
+    CT_CAST0, CT_CAST1,
+
+    CT_FUNCTION1, CT_FUNCTION2,
+
+    CT_count
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class GFunGCD : public vpp::Function< vpp::Int, vpp::Int, vpp::Int >
+{
+public:
+    GFunGCD();
+
+private:
+    vpp::Par< vpp::Int > _n;
+    vpp::Par< vpp::Int > _k;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KConstructTestPipeline : public vpp::ComputePipelineConfig
+{
+public:
+    KConstructTestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const vpp::StorageBufferView& vs1,
+        const vpp::StorageBufferView& vs2,
+        const vpp::StorageBufferView& vt,
+        int size,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_source1;
+    vpp::ioBuffer d_source2;
+    vpp::ioBuffer d_target;
+
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                 Indexing tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+enum EIndexingTests
+{
+    XT_LOCALARR1, XT_LOCALARR2, XT_LOCALARR3, XT_LOCALARR4, XT_LOCALARR5,
+    XT_SHAREDARR1, XT_SHAREDARR2, XT_SHAREDARR3,
+
+    XT_VECTORS1, XT_VECTORS2, XT_VECTORS3, XT_VECTORS4, XT_VECTORS5, XT_VECTORS6,
+    XT_VECTORS7, XT_VECTORS8, XT_VECTORS9, XT_VECTORS10, XT_VECTORS11, XT_VECTORS12,
+    XT_VECTORS13, XT_VECTORS14, XT_VECTORS15, XT_VECTORS16, XT_VECTORS17, XT_VECTORS18,
+
+    XT_VECSWIZZLE1_begin,
+    XT_VECSWIZZLE1_end = XT_VECSWIZZLE1_begin + 2 + 3 + 4,
+
+    XT_VVECSWIZZLE1_begin = XT_VECSWIZZLE1_end,
+    XT_VVECSWIZZLE1_end = XT_VVECSWIZZLE1_begin + 2 + 3 + 4,
+
+    XT_VECSWIZZLE2_begin = XT_VVECSWIZZLE1_end,
+    XT_VECSWIZZLE2_end = XT_VECSWIZZLE2_begin + 29,
+
+    XT_VVECSWIZZLE2_begin = XT_VECSWIZZLE2_end,
+    XT_VVECSWIZZLE2_end = XT_VVECSWIZZLE2_begin + 3,
+
+    XT_VECSWIZZLE3_begin = XT_VVECSWIZZLE2_end,
+    XT_VECSWIZZLE3_end = XT_VECSWIZZLE3_begin + 64,
+
+    XT_VVECSWIZZLE3_begin = XT_VECSWIZZLE3_end,
+    XT_VVECSWIZZLE3_end = XT_VVECSWIZZLE3_begin + 4,
+
+    XT_VECSWIZZLE4_begin = XT_VVECSWIZZLE3_end,
+    XT_VECSWIZZLE4_end = XT_VECSWIZZLE4_begin + 8,
+
+    XT_VVECSWIZZLE4_begin = XT_VECSWIZZLE4_end,
+    XT_VVECSWIZZLE4_end = XT_VVECSWIZZLE4_begin + 4,
+
+    XT_WRVECSWIZZLE4_begin = XT_VVECSWIZZLE4_end,
+    XT_WRVECSWIZZLE4_end = XT_WRVECSWIZZLE4_begin + 7,
+
+    XT_SWIZZLEIND_begin = XT_WRVECSWIZZLE4_end,
+    XT_SWIZZLEIND_end = XT_SWIZZLEIND_begin + 4,
+
+    XT_MAT_2x2_0 = XT_SWIZZLEIND_end,
+    XT_MAT_2x2_1, XT_MAT_2x2_2, XT_MAT_2x2_3,
+
+    XT_MAT_2x2_D0, XT_MAT_2x2_D1, XT_MAT_2x2_D2, XT_MAT_2x2_D3,
+    XT_MAT_2x2_C0, XT_MAT_2x2_C1, XT_MAT_2x2_C2, XT_MAT_2x2_C3,
+    XT_MAT_2x2_V0, XT_MAT_2x2_V1, XT_MAT_2x2_V2, XT_MAT_2x2_V3,
+    XT_MAT_2x2_V10, XT_MAT_2x2_V11, XT_MAT_2x2_V12, XT_MAT_2x2_V13,
+    XT_MAT_2x2_V20, XT_MAT_2x2_V21, XT_MAT_2x2_V22, XT_MAT_2x2_V23,
+    
+    XT_count
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+template< vpp::ETag TAG >
+struct TTestStruct : public vpp::UniformStruct< TAG, TTestStruct >
+{
+    vpp::UniformFld< TAG, vpp::vect2 > d_vect2;
+    vpp::UniformFld< TAG, vpp::vect2 > d_vect2a;
+    vpp::UniformFld< TAG, vpp::vect3 > d_vect3;
+    vpp::UniformFld< TAG, vpp::vect4 > d_vect4;
+    vpp::UniformFld< TAG, vpp::matr2 > d_matr2;
+    vpp::UniformFld< TAG, vpp::matr3 > d_matr3;
+    vpp::UniformFld< TAG, vpp::matr4 > d_matr4;
+};
+
+typedef TTestStruct< vpp::GPU > GTestStruct;
+typedef TTestStruct< vpp::CPU > CTestStruct;
+typedef vpp::gvector< CTestStruct, vpp::Buf::UNIFORM | vpp::Buf::STORAGE | vpp::Buf::SOURCE > CTestStructBuffer;
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KIndexingTestPipeline : public vpp::ComputePipelineConfig
+{
+public:
+    KIndexingTestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const vpp::StorageBufferView& vs1,
+        const vpp::StorageBufferView& vs2,
+        const vpp::StorageBufferView& vt,
+        int size,
+        const vpp::StorageBufferView& tb1,
+        const vpp::StorageBufferView& tb2,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_source1;
+    vpp::ioBuffer d_source2;
+    vpp::ioBuffer d_target;
+
+    vpp::ioBuffer d_uniTestBuf1;
+    vpp::ioBuffer d_storTestBuf1;
+
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Push constant tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+template< vpp::ETag TAG >
+struct TPushConstantTestStruct : public vpp::UniformStruct< TAG, TPushConstantTestStruct >
+{
+    vpp::UniformFld< TAG, int > d_outIdx;
+    vpp::UniformFld< TAG, int > d_unused1;
+    vpp::UniformFld< TAG, int > d_unused2;
+    vpp::UniformFld< TAG, int > d_unused3;
+    vpp::UniformFld< TAG, vpp::matr2 > d_matr2;
+};
+
+typedef TPushConstantTestStruct< vpp::GPU > GPushConstantTestStruct;
+typedef TPushConstantTestStruct< vpp::CPU > CPushConstantTestStruct;
+
+// -----------------------------------------------------------------------------
+
+class KPushConstantTestPipeline : public vpp::ComputePipelineConfig
+{
+public:
+    KPushConstantTestPipeline ( const vpp::Device& hDevice );
+
+    void setOutBuffer (
+        const vpp::StorageBufferView& rb,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    CPushConstantTestStruct& data();
+    void push();
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::inPushConstant< TPushConstantTestStruct > d_sourceData;
+    vpp::ioBuffer d_resultBuffer;
+
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Texel buffer tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class KTexelBufferTestTypes
+{
+public:
+    typedef vpp::format< float, float, float, float > Fmt4xF32;
+    typedef vpp::TexelBufferView< Fmt4xF32, vpp::Buf::UNITEX | vpp::Buf::STORTEX | vpp::Buf::SOURCE > View4xF32;
+    typedef Fmt4xF32::data_type Data4xF32;
+    typedef vpp::gvector< Data4xF32, vpp::Buf::UNITEX | vpp::Buf::STORTEX | vpp::Buf::SOURCE > Vec4xF32;
+};
+
+// -----------------------------------------------------------------------------
+
+class KTexelBufferTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KTexelBufferTestTypes
+{
+public:
+    typedef vpp::format< float, float, float, float > Fmt4xF32;
+
+public:
+    KTexelBufferTestPipeline ( const vpp::Device& hDevice );
+
+    void setOutBuffer (
+        const View4xF32& inTexBuf4xF32,
+        const View4xF32& ioImgBuf4xF32,
+        const View4xF32& inTexBuf4xF32a,
+        const View4xF32& ioImgBuf4xF32a,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::inTextureBuffer< Fmt4xF32 > m_inTexBuf4xF32;
+    vpp::ioImageBuffer< Fmt4xF32 > m_ioImgBuf4xF32;
+
+    vpp::inTextureBuffer< Fmt4xF32 > m_inTexBuf4xF32a;
+    vpp::ioImageBuffer< Fmt4xF32 > m_ioImgBuf4xF32a;
+
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Images tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+template< class FormatT >
+struct TImageTestTypeSet
+{
+    typedef typename FormatT::data_type data_type;
+    typedef vpp::gvector< data_type, vpp::Buf::SOURCE | vpp::Buf::TARGET > buffer_type;
+
+    typedef vpp::ImageAttributes<
+        FormatT, vpp::RENDER, vpp::IMG_TYPE_2D,
+        vpp::Img::STORAGE | vpp::Img::SAMPLED | vpp::Img::SOURCE | vpp::Img::TARGET,
+        VK_IMAGE_TILING_OPTIMAL, VK_SAMPLE_COUNT_1_BIT,
+        false, false > AttributesT;
+
+    typedef vpp::Image< AttributesT > image_type;
+    typedef vpp::ImageViewAttributes< image_type > ViewAttrT;
+    typedef vpp::ImageView< ViewAttrT > view_type;
+};
+
+// -----------------------------------------------------------------------------
+
+struct KImageTestTypes
+{
+    typedef vpp::format< float, float, float, float > Fmt4xF32;
+    typedef TImageTestTypeSet< Fmt4xF32 > Types4xF32;
+    typedef typename Types4xF32::image_type Img4xF32;
+    typedef typename Types4xF32::view_type View4xF32;
+    typedef typename Types4xF32::buffer_type Buf4xF32;
+    typedef typename Types4xF32::data_type Data4xF32;
+
+    typedef vpp::format< vpp::unorm8_t, vpp::unorm8_t, vpp::unorm8_t, vpp::unorm8_t > Fmt4xFU8;
+    typedef TImageTestTypeSet< Fmt4xFU8 > Types4xFU8;
+    typedef typename Types4xFU8::image_type Img4xFU8;
+    typedef typename Types4xFU8::view_type View4xFU8;
+    typedef typename Types4xFU8::buffer_type Buf4xFU8;
+    typedef typename Types4xFU8::data_type Data4xFU8;
+
+    typedef vpp::format< vpp::snorm8_t, vpp::snorm8_t > Fmt2xFS8;
+    typedef TImageTestTypeSet< Fmt2xFS8 > Types2xFS8;
+    typedef typename Types2xFS8::image_type Img2xFS8;
+    typedef typename Types2xFS8::view_type View2xFS8;
+    typedef typename Types2xFS8::buffer_type Buf2xFS8;
+    typedef typename Types2xFS8::data_type Data2xFS8;
+
+    static const unsigned int WIDTH = 500;
+    static const unsigned int HEIGHT = 377;
+    static const unsigned int LENGTH = WIDTH * HEIGHT;
+};
+
+// -----------------------------------------------------------------------------
+
+class KImageTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KImageTestTypes
+{
+public:
+    KImageTestPipeline ( const vpp::Device& hDevice );
+
+    void setBuffers (
+        const View4xF32& inTexBuf4xF32,
+        const View4xF32& ioImgBuf4xF32,
+        const View4xFU8& inTexBuf4xFU8,
+        const View4xFU8& ioImgBuf4xFU8,
+        const View2xFS8& inTexBuf2xFS8,
+        const View2xFS8& ioImgBuf2xFS8,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioImage< View4xF32 > m_inImgBuf4xF32;
+    vpp::ioImage< View4xF32 > m_ioImgBuf4xF32;
+    vpp::ioImage< View4xFU8 > m_inImgBuf4xFU8;
+    vpp::ioImage< View4xFU8 > m_ioImgBuf4xFU8;
+    vpp::ioImage< View2xFS8 > m_inImgBuf2xFS8;
+    vpp::ioImage< View2xFS8 > m_ioImgBuf2xFS8;
+
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Synchronization tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KGlobalSyncTestTypes
+{
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::SOURCE | vpp::Buf::TARGET > DataBuffer;
+    typedef vpp::format< unsigned int > FormatU32;
+
+    typedef vpp::ImageAttributes<
+        FormatU32, vpp::RENDER, vpp::IMG_TYPE_2D,
+        vpp::Img::STORAGE | vpp::Img::TARGET,
+        VK_IMAGE_TILING_OPTIMAL, VK_SAMPLE_COUNT_1_BIT,
+        false, false > TestImageAttr;
+
+    typedef vpp::Image< TestImageAttr > TestImage;
+    typedef vpp::ImageViewAttributes< TestImage > TestImageViewAttr;
+    typedef vpp::ImageView< TestImageViewAttr > TestImageView;
+};
+
+// -----------------------------------------------------------------------------
+
+class KGlobalSyncTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KGlobalSyncTestTypes
+{
+public:
+    KGlobalSyncTestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const DataBuffer& resultView,
+        const TestImageView& testImageView,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_sourceBuffer;
+    vpp::ioBuffer d_resultBuffer;
+    vpp::ioImage< TestImageView, vpp::MEM_COHERENT | vpp::MEM_VOLATILE > d_testImage;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Local arrays tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KLocalArraysTestTypes
+{
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferI;
+    typedef vpp::gvector< float, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferF;
+
+    typedef vpp::format< unsigned int > FormatU32;
+    typedef vpp::format< float > FormatF32;
+
+    static void computeTestOffsets ( std::vector< unsigned int >* pOffsets );
+    static unsigned int totalTestVectorLength();
+
+    static const unsigned int s_testSizes[];
+    static const unsigned int s_testCount;
+};
+
+// -----------------------------------------------------------------------------
+
+class KLocalArraysTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KLocalArraysTestTypes
+{
+public:
+    KLocalArraysTestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const DataBufferI& generateResultViewI,
+        const DataBufferI& transformResultViewI,
+        const DataBufferI& reverseResultViewI,
+        const DataBufferF& generateResultViewF,
+        const DataBufferF& transformResultViewF,
+        const DataBufferF& reverseResultViewF,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_generateResultBufferI;
+    vpp::ioBuffer d_transformResultBufferI;
+    vpp::ioBuffer d_reverseResultBufferI;
+    vpp::ioBuffer d_generateResultBufferF;
+    vpp::ioBuffer d_transformResultBufferF;
+    vpp::ioBuffer d_reverseResultBufferF;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Group algorithms tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KGroupAlgorithmsTestTypes
+{
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer;
+    typedef vpp::format< unsigned int > FormatU32;
+
+    static void computeTestOffsets ( std::vector< unsigned int >* pOffsets );
+    static unsigned int totalTestVectorLength();
+
+    static const unsigned int s_testSizes[];
+    static const unsigned int s_testCount;
+};
+
+// -----------------------------------------------------------------------------
+
+class KGroupAlgorithmsTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KGroupAlgorithmsTestTypes
+{
+public:
+    KGroupAlgorithmsTestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const DataBuffer& sourceView,
+        const DataBuffer& generateResultView,
+        const DataBuffer& sortResultView,
+        const DataBuffer& reduceResultView,
+        const DataBuffer& iscanResultView,
+        const DataBuffer& escanResultView,
+        const DataBuffer& lboundResultView,
+        const DataBuffer& uboundResultView,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_sourceBuffer;
+    vpp::ioBuffer d_generateResultBuffer;
+    vpp::ioBuffer d_sortResultBuffer;
+    vpp::ioBuffer d_reduceResultBuffer;
+    vpp::ioBuffer d_iscanResultBuffer;
+    vpp::ioBuffer d_escanResultBuffer;
+    vpp::ioBuffer d_lboundResultBuffer;
+    vpp::ioBuffer d_uboundResultBuffer;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Group algorithms tests 2
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KGroupAlgorithms2TestTypes
+{
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer;
+    typedef vpp::format< unsigned int > FormatU32;
+
+    static void computeTestOffsets ( std::vector< unsigned int >* pOffsets );
+    static unsigned int totalTestVectorLength();
+
+    static const unsigned int s_testSizesCols[];
+    static const unsigned int s_testSizesRows[];
+    static const unsigned int s_testCount;
+};
+
+// -----------------------------------------------------------------------------
+
+class KGroupAlgorithms2TestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KGroupAlgorithms2TestTypes
+{
+public:
+    KGroupAlgorithms2TestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const DataBuffer& fillResultView,
+        const DataBuffer& generateResultView,
+        const DataBuffer& generate2ResultView,
+        const DataBuffer& sortResultView,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_fillResultBuffer;
+    vpp::ioBuffer d_generateResultBuffer;
+    vpp::ioBuffer d_generate2ResultBuffer;
+    vpp::ioBuffer d_sortResultBuffer;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                Group variables tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KGroupVariablesTestTypes
+{
+    typedef vpp::gvector< int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferI;
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferU;
+    typedef vpp::gvector< float, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferF;
+    typedef vpp::gvector< double, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBufferD;
+};
+
+// -----------------------------------------------------------------------------
+
+class KGroupVariablesTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KGroupVariablesTestTypes
+{
+public:
+    KGroupVariablesTestPipeline ( const vpp::Device& hDevice );
+
+    void setData (
+        const DataBufferI& intResultView,
+        const DataBufferU& uintResultView,
+        const DataBufferF& floatResultView,
+        const DataBufferD& doubleResultView,
+        const DataBufferI& groupResultView,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+private:
+    void setVariable ( vpp::WBool& var, int value );
+
+    template< typename ScalarT >
+    void setVariable ( vpp::TLValue< ScalarT, spv::StorageClassWorkgroup >& var, int value );
+
+    template< size_t SIZE >
+    void setVariableB ( vpp::TLVector< vpp::Bool, SIZE, spv::StorageClassWorkgroup >& var, int value );
+
+    template< typename BaseT >
+    void setVariable ( vpp::TLVector< BaseT, 2, spv::StorageClassWorkgroup >& var, int value );
+
+    template< typename BaseT >
+    void setVariable ( vpp::TLVector< BaseT, 3, spv::StorageClassWorkgroup >& var, int value );
+
+    template< typename BaseT >
+    void setVariable ( vpp::TLVector< BaseT, 4, spv::StorageClassWorkgroup >& var, int value );
+
+    template< typename BaseT, size_t COLS, size_t ROWS  >
+    void setVariable ( const vpp::TLMatrix< BaseT, COLS, ROWS, spv::StorageClassWorkgroup >& var, int value );
+
+    void storeVariable ( const vpp::Bool& v );
+    void storeVariable ( const vpp::Int& v );
+    void storeVariable ( const vpp::UInt& v );
+    void storeVariable ( const vpp::Float& v );
+    void storeVariable ( const vpp::Double& v );
+
+    template< typename BaseT, size_t SIZE >
+    void storeVariable ( const vpp::TLVector< BaseT, SIZE, spv::StorageClassWorkgroup >& var );
+
+    template< typename BaseT, size_t COLS, size_t ROWS >
+    void storeVariable ( const vpp::TLMatrix< BaseT, COLS, ROWS, spv::StorageClassWorkgroup >& var );
+
+public:
+    vpp::ioBuffer d_intResultBuffer;
+    vpp::ioBuffer d_uintResultBuffer;
+    vpp::ioBuffer d_floatResultBuffer;
+    vpp::ioBuffer d_doubleResultBuffer;
+    vpp::ioBuffer d_groupResultBuffer;
+    vpp::computeShader d_shader;
+
+    unsigned int d_intResultBufferOffset;
+    unsigned int d_uintResultBufferOffset;
+    unsigned int d_floatResultBufferOffset;
+    unsigned int d_doubleResultBufferOffset;
+
+    typedef vpp::UniformSimpleArray< int, decltype ( d_intResultBuffer ) > OutIntBuffer;
+    typedef vpp::UniformSimpleArray< unsigned int, decltype ( d_uintResultBuffer ) > OutUIntBuffer;
+    typedef vpp::UniformSimpleArray< float, decltype ( d_floatResultBuffer ) > OutFloatBuffer;
+    typedef vpp::UniformSimpleArray< double, decltype ( d_doubleResultBuffer ) > OutDoubleBuffer;
+
+    OutIntBuffer* d_pOutIntBuffer;
+    OutUIntBuffer* d_pOutUIntBuffer;
+    OutFloatBuffer* d_pOutFloatBuffer;
+    OutDoubleBuffer* d_pOutDoubleBuffer;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                                 Atomics tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KAtomicsTestTypes
+{
+    static const int TEST_COUNT = 7;
+    static const int BLOCK_SIZE = 32768;
+
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer;
+    typedef vpp::gvector< std::uint64_t, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer64;
+
+    typedef vpp::format< unsigned int > FormatU32;
+    typedef vpp::format< std::uint64_t > FormatU64;
+
+    typedef vpp::ImageAttributes<
+        FormatU32, vpp::RENDER, vpp::IMG_TYPE_2D,
+        vpp::Img::STORAGE | vpp::Img::TARGET,
+        VK_IMAGE_TILING_OPTIMAL, VK_SAMPLE_COUNT_1_BIT,
+        false, false > TestImageAttr;
+
+    typedef vpp::Image< TestImageAttr > TestImage;
+    typedef vpp::ImageViewAttributes< TestImage > TestImageViewAttr;
+    typedef vpp::ImageView< TestImageViewAttr > TestImageView;
+};
+
+// -----------------------------------------------------------------------------
+
+class KAtomicsTestPipeline1 :
+    public vpp::ComputePipelineConfig,
+    public KAtomicsTestTypes
+{
+public:
+    KAtomicsTestPipeline1 ( const vpp::Device& hDevice );
+
+    void setData (
+        const DataBuffer& resultView,
+        const DataBuffer& testView,
+        const DataBuffer64& testView64,
+        const TestImageView& testImageView,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_resultBuffer;
+    vpp::ioBuffer d_testBuffer;
+    vpp::ioBuffer d_testBuffer64;
+    vpp::ioImage< TestImageView > d_testImage;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                            Descriptor update tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KDescriptorUpdateTestTypes
+{
+    static const unsigned int BUFFER_LENGTH = 64;
+
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::TARGET | vpp::Buf::SOURCE > DataBuffer;
+};
+
+// -----------------------------------------------------------------------------
+
+class KDescriptorUpdateTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KDescriptorUpdateTestTypes
+{
+public:
+    KDescriptorUpdateTestPipeline ( const vpp::Device& hDevice );
+
+    // Both buffers are updated separately, with assignment lists of the
+    // same type but different bindings.
+
+    void setFirstBuffer ( const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock );
+    void setSecondBuffer ( const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_firstBuffer;
+    vpp::ioBuffer d_secondBuffer;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Debug print tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KDebugPrintTestTypes
+{
+    // Each invocation writes one record of 5 words (header and one value).
+    // The ring holds 64 words, which is the smallest capacity.
+
+    static const unsigned int WORKGROUP_SIZE = 8;
+    static const unsigned int BUFFER_LENGTH = 2 * WORKGROUP_SIZE;
+    static const unsigned int RING_CAPACITY = 64;
+
+    typedef vpp::gvector< unsigned int, vpp::Buf::STORAGE | vpp::Buf::SOURCE > DataBuffer;
+};
+
+// -----------------------------------------------------------------------------
+
+class KDebugPrintTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KDebugPrintTestTypes
+{
+public:
+    KDebugPrintTestPipeline (
+        const vpp::Device& hDevice, const vpp::DebugPrintBuffer& hDebugPrint );
+
+    void setDataBuffer ( const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_dataBuffer;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                              Loop control tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KLoopControlTestTypes
+{
+    // Each invocation writes 3 values, see fComputeShader.
+
+    static const unsigned int WORKGROUP_SIZE = 64;
+    static const unsigned int VALUE_COUNT = 3;
+    static const unsigned int BUFFER_LENGTH = VALUE_COUNT * WORKGROUP_SIZE;
+
+    typedef vpp::gvector< int, vpp::Buf::STORAGE | vpp::Buf::SOURCE > DataBuffer;
+};
+
+// -----------------------------------------------------------------------------
+
+class KLoopControlTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KLoopControlTestTypes
+{
+public:
+    KLoopControlTestPipeline ( const vpp::Device& hDevice );
+
+    void setDataBuffer ( const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_dataBuffer;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                            Specialization tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KSpecializationTestTypes
+{
+    static const int DEFAULT_LOCAL_SIZE = 16;
+    static const int SPECIALIZED_LOCAL_SIZE = 32;
+    static const int SPECIALIZED_SCALE = 3;
+    static const unsigned int BUFFER_LENGTH = 64;
+
+    typedef vpp::gvector< int, vpp::Buf::STORAGE | vpp::Buf::SOURCE > DataBuffer;
+};
+
+// -----------------------------------------------------------------------------
+
+class KSpecializationTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KSpecializationTestTypes
+{
+public:
+    KSpecializationTestPipeline ( const vpp::Device& hDevice );
+
+    void setDataBuffer ( const DataBuffer& buffer, vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::specConst< int > d_localSizeX;
+    vpp::specConst< int > d_localSizeY;
+    vpp::specConst< int > d_localSizeZ;
+    vpp::specConst< int > d_scale;
+    vpp::specConst< bool > d_bNegate;
+
+    vpp::ioBuffer d_dataBuffer;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+//                           Narrow integer tests
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+struct KNarrowIntegerTestTypes
+{
+    static const unsigned int WORKGROUP_SIZE = 64;
+
+    typedef vpp::gvector< std::int16_t, vpp::Buf::STORAGE | vpp::Buf::SOURCE > ShortBuffer;
+    typedef vpp::gvector< int, vpp::Buf::STORAGE | vpp::Buf::SOURCE > IntBuffer;
+};
+
+// -----------------------------------------------------------------------------
+
+class KNarrowIntegerTestPipeline :
+    public vpp::ComputePipelineConfig,
+    public KNarrowIntegerTestTypes
+{
+public:
+    KNarrowIntegerTestPipeline ( const vpp::Device& hDevice );
+
+    void setBuffers (
+        const ShortBuffer& shortBuffer,
+        const IntBuffer& intBuffer,
+        vpp::ShaderDataBlock* pDataBlock );
+
+    void fComputeShader ( vpp::ComputeShader* pShader );
+
+public:
+    vpp::ioBuffer d_shortBuffer;
+    vpp::ioBuffer d_intBuffer;
+    vpp::computeShader d_shader;
+};
+
+// -----------------------------------------------------------------------------
+} // namespace vpptest
+// -----------------------------------------------------------------------------
+
+#endif // INC_VPPTESTCOMPUTATIONPIPELINES_HPP
@@ -1,6 +1,9 @@
 // -----------------------------------------------------------------------------
 
 #include <vppAll.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 
 // -----------------------------------------------------------------------------
 namespace vpptest {
@@ -145,6 +148,193 @@ void testPackedFormats()
 
 // -----------------------------------------------------------------------------
 
+typedef std::vector< unsigned char > TextureFileData;
+
+// -----------------------------------------------------------------------------
+
+template< typename T >
+void writeValue ( TextureFileData* pData, size_t offset, T value )
+{
+    std::memcpy ( & ( *pData ) [ offset ], & value, sizeof ( T ) );
+}
+
+// -----------------------------------------------------------------------------
+
+bool isTextureAccepted ( const TextureFileData& data, VkDeviceSize expectedSize = 0 )
+{
+    static const char* const FILE_NAME = "vppTestFormats.tmp";
+
+    {
+        std::ofstream file ( FILE_NAME, std::ios::binary );
+        file.write (
+            reinterpret_cast< const char* >( data.data() ),
+            static_cast< std::streamsize >( data.size() ) );
+    }
+
+    bool bAccepted = false;
+
+    try
+    {
+        vpp::TextureContainer container ( FILE_NAME );
+        bAccepted = ( expectedSize == 0 || container.dataSize() == expectedSize );
+    }
+    catch ( const vpp::XInvalidTextureFile& )
+    {
+    }
+
+    std::remove ( FILE_NAME );
+    return bAccepted;
+}
+
+// -----------------------------------------------------------------------------
+
+TextureFileData makeKTX2 ( std::uint32_t width, std::uint32_t height )
+{
+    // Single level RGBA8 texture, level index right after the header.
+    static const unsigned char s_identifier [ 12 ] =
+    {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+
+    const std::uint64_t dataOffset = 80 + 24;
+    const std::uint64_t dataSize = 4 * width * height;
+
+    TextureFileData data ( static_cast< size_t >( dataOffset + dataSize ), 0 );
+    std::memcpy ( & data [ 0 ], s_identifier, sizeof ( s_identifier ) );
+
+    writeValue< std::uint32_t >( & data, 12, VK_FORMAT_R8G8B8A8_UNORM );
+    writeValue< std::uint32_t >( & data, 20, width );
+    writeValue< std::uint32_t >( & data, 24, height );
+    writeValue< std::uint32_t >( & data, 36, 1 );
+    writeValue< std::uint32_t >( & data, 40, 1 );
+    writeValue< std::uint64_t >( & data, 80, dataOffset );
+    writeValue< std::uint64_t >( & data, 88, dataSize );
+    return data;
+}
+
+// -----------------------------------------------------------------------------
+
+TextureFileData makeDDS ( std::uint32_t width, std::uint32_t height )
+{
+    // Single level RGBA8 texture, uncompressed pixel format.
+    const size_t dataSize = 4 * width * height;
+
+    TextureFileData data ( 128 + dataSize, 0 );
+
+    writeValue< std::uint32_t >( & data, 0, 0x20534444 );
+    writeValue< std::uint32_t >( & data, 4, 124 );
+    writeValue< std::uint32_t >( & data, 8, 0x1007 );
+    writeValue< std::uint32_t >( & data, 12, height );
+    writeValue< std::uint32_t >( & data, 16, width );
+    writeValue< std::uint32_t >( & data, 76, 32 );
+    writeValue< std::uint32_t >( & data, 80, 0x41 );
+    writeValue< std::uint32_t >( & data, 88, 32 );
+    writeValue< std::uint32_t >( & data, 92, 0x000000ff );
+    writeValue< std::uint32_t >( & data, 96, 0x0000ff00 );
+    writeValue< std::uint32_t >( & data, 100, 0x00ff0000 );
+    writeValue< std::uint32_t >( & data, 104, 0xff000000 );
+    return data;
+}
+
+// -----------------------------------------------------------------------------
+
+void testTextureContainers()
+{
+    {
+        const TextureFileData valid = makeKTX2 ( 4, 4 );
+        check ( isTextureAccepted ( valid, 64 ) );
+
+        TextureFileData truncatedHeader ( valid.begin(), valid.begin() + 60 );
+        check ( ! isTextureAccepted ( truncatedHeader ) );
+
+        TextureFileData truncatedIndex ( valid.begin(), valid.begin() + 96 );
+        check ( ! isTextureAccepted ( truncatedIndex ) );
+
+        TextureFileData truncatedData ( valid.begin(), valid.end() - 1 );
+        check ( ! isTextureAccepted ( truncatedData ) );
+
+        TextureFileData wrappingOffset = valid;
+        writeValue< std::uint64_t >( & wrappingOffset, 80, ~std::uint64_t ( 0 ) - 15 );
+        check ( ! isTextureAccepted ( wrappingOffset ) );
+
+        TextureFileData tooManyLevels = valid;
+        writeValue< std::uint32_t >( & tooManyLevels, 40, 4 );
+        check ( ! isTextureAccepted ( tooManyLevels ) );
+
+        TextureFileData hugeLevelCount = valid;
+        writeValue< std::uint32_t >( & hugeLevelCount, 40, 0xffffffff );
+        check ( ! isTextureAccepted ( hugeLevelCount ) );
+
+        TextureFileData hugeExtent = valid;
+        writeValue< std::uint32_t >( & hugeExtent, 20, 0xffffffff );
+        writeValue< std::uint32_t >( & hugeExtent, 24, 0xffffffff );
+        check ( ! isTextureAccepted ( hugeExtent ) );
+
+        TextureFileData hugeLayerCount = valid;
+        writeValue< std::uint32_t >( & hugeLayerCount, 32, 0xffffffff );
+        writeValue< std::uint32_t >( & hugeLayerCount, 36, 6 );
+        check ( ! isTextureAccepted ( hugeLayerCount ) );
+
+        TextureFileData invalidFaces = valid;
+        writeValue< std::uint32_t >( & invalidFaces, 36, 3 );
+        check ( ! isTextureAccepted ( invalidFaces ) );
+
+        TextureFileData unknownFormat = valid;
+        writeValue< std::uint32_t >( & unknownFormat, 12, VK_FORMAT_UNDEFINED );
+        check ( ! isTextureAccepted ( unknownFormat ) );
+
+        TextureFileData supercompressed = valid;
+        writeValue< std::uint32_t >( & supercompressed, 44, 1 );
+        check ( ! isTextureAccepted ( supercompressed ) );
+    }
+    {
+        const TextureFileData valid = makeDDS ( 4, 4 );
+        check ( isTextureAccepted ( valid, 64 ) );
+
+        TextureFileData truncatedHeader ( valid.begin(), valid.begin() + 100 );
+        check ( ! isTextureAccepted ( truncatedHeader ) );
+
+        TextureFileData truncatedData ( valid.begin(), valid.end() - 1 );
+        check ( ! isTextureAccepted ( truncatedData ) );
+
+        TextureFileData tooManyLevels = valid;
+        writeValue< std::uint32_t >( & tooManyLevels, 8, 0x21007 );
+        writeValue< std::uint32_t >( & tooManyLevels, 28, 40 );
+        check ( ! isTextureAccepted ( tooManyLevels ) );
+
+        TextureFileData hugeExtent = valid;
+        writeValue< std::uint32_t >( & hugeExtent, 12, 0xffffffff );
+        writeValue< std::uint32_t >( & hugeExtent, 16, 0xffffffff );
+        check ( ! isTextureAccepted ( hugeExtent ) );
+
+        TextureFileData unknownFormat = valid;
+        writeValue< std::uint32_t >( & unknownFormat, 92, 0x0000f800 );
+        check ( ! isTextureAccepted ( unknownFormat ) );
+
+        // DX10 extension header claimed, but not present.
+        TextureFileData truncatedDX10 ( valid.begin(), valid.begin() + 136 );
+        writeValue< std::uint32_t >( & truncatedDX10, 80, 0x4 );
+        writeValue< std::uint32_t >( & truncatedDX10, 84, 0x30315844 );
+        check ( ! isTextureAccepted ( truncatedDX10 ) );
+
+        TextureFileData hugeArray ( valid.begin(), valid.begin() + 128 );
+        hugeArray.resize ( 128 + 20 + 64, 0 );
+        writeValue< std::uint32_t >( & hugeArray, 80, 0x4 );
+        writeValue< std::uint32_t >( & hugeArray, 84, 0x30315844 );
+        writeValue< std::uint32_t >( & hugeArray, 128, 28 );
+        writeValue< std::uint32_t >( & hugeArray, 136, 0x4 );
+        writeValue< std::uint32_t >( & hugeArray, 140, 0xffffffff );
+        check ( ! isTextureAccepted ( hugeArray ) );
+
+        TextureFileData validDX10 = hugeArray;
+        writeValue< std::uint32_t >( & validDX10, 136, 0 );
+        writeValue< std::uint32_t >( & validDX10, 140, 1 );
+        check ( isTextureAccepted ( validDX10, 64 ) );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 void printResults()
 {
     std::cout << "VPP Formats test results:" << std::endl;
@@ -165,6 +355,7 @@ int main()
     using namespace vpptest;
     testBasicTypes();
     testPackedFormats();
+    testTextureContainers();
 
     printResults();
 
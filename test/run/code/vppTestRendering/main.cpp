@@ -766,6 +766,123 @@ void SampTest :: compareResults()
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
+class OffscreenTestGraph : public vpp::RenderGraph
+{
+public:
+    OffscreenTestGraph ( const VkExtent2D& imageSize );
+
+public:
+    vpp::Process d_render;
+    vpp::Display d_display;
+};
+
+// -----------------------------------------------------------------------------
+
+OffscreenTestGraph :: OffscreenTestGraph ( const VkExtent2D& imageSize ) :
+    d_display ( imageSize, VK_FORMAT_R8G8B8A8_UNORM )
+{
+    d_render.addColorOutput ( d_display, { 1.0f, 0.2f, 0.6f, 0.0f } );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+class OffscreenTest
+{
+public:
+    OffscreenTest ( const vpp::Device& hDevice );
+
+    void operator()();
+
+private:
+    void onFrameReady (
+        std::uint64_t frameNumber, const void* pPixels, size_t size );
+
+private:
+    static const unsigned int WIDTH = 64;
+    static const unsigned int HEIGHT = 32;
+    static const unsigned int FRAME_COUNT = 3;
+    static const unsigned int RENDERED_FRAMES = 5;
+
+    vpp::Device d_device;
+    vpp::OffscreenRenderManager d_renderManager;
+    OffscreenTestGraph d_graph;
+    vpp::RenderPass d_pass;
+    std::vector< std::uint64_t > d_deliveredFrames;
+    bool d_bPixelsValid;
+};
+
+// -----------------------------------------------------------------------------
+
+OffscreenTest :: OffscreenTest ( const vpp::Device& hDevice ) :
+    d_device ( hDevice ),
+    d_renderManager (
+        hDevice, { WIDTH, HEIGHT }, VK_FORMAT_R8G8B8A8_UNORM, FRAME_COUNT ),
+    d_graph ( { WIDTH, HEIGHT } ),
+    d_pass ( d_graph, hDevice ),
+    d_bPixelsValid ( true )
+{
+    d_renderManager.setFrameReadyCallback (
+        [ this ]( std::uint64_t frameNumber, const void* pPixels, size_t size )
+        {
+            onFrameReady ( frameNumber, pPixels, size );
+        } );
+}
+
+// -----------------------------------------------------------------------------
+
+void OffscreenTest :: onFrameReady (
+    std::uint64_t frameNumber, const void* pPixels, size_t size )
+{
+    d_deliveredFrames.push_back ( frameNumber );
+
+    if ( size != WIDTH * HEIGHT * 4 )
+    {
+        d_bPixelsValid = false;
+        return;
+    }
+
+    const std::uint8_t* pBytes = static_cast< const std::uint8_t* >( pPixels );
+    static const int s_expected [ 4 ] = { 255, 51, 153, 0 };
+
+    for ( size_t i = 0; i != size; ++i )
+        if ( std::abs ( static_cast< int >( pBytes [ i ] ) - s_expected [ i % 4 ] ) > 1 )
+            d_bPixelsValid = false;
+}
+
+// -----------------------------------------------------------------------------
+
+void OffscreenTest :: operator()()
+{
+    // More frames than ring slots, so some are delivered by beginFrame()
+    // when their slot is reused and the rest by flush().
+    for ( unsigned int i = 0; i != RENDERED_FRAMES; ++i )
+    {
+        d_renderManager.beginFrame();
+        d_renderManager.render ( d_pass );
+        d_renderManager.endFrame();
+    }
+
+    check ( d_deliveredFrames.size() == RENDERED_FRAMES - FRAME_COUNT );
+
+    d_renderManager.flush();
+
+    check ( d_renderManager.frameNumber() == RENDERED_FRAMES );
+    check ( d_deliveredFrames.size() == RENDERED_FRAMES );
+
+    bool bInOrder = true;
+
+    for ( size_t i = 0; i != d_deliveredFrames.size(); ++i )
+        if ( d_deliveredFrames [ i ] != i )
+            bInOrder = false;
+
+    check ( bInOrder );
+    check ( d_bPixelsValid );
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
 class KRenderingTests
 {
 public:
@@ -776,13 +893,15 @@ public:
 private:
     AttTest d_attTest;
     SampTest d_sampTest;
+    OffscreenTest d_offscreenTest;
 };
 
 // -----------------------------------------------------------------------------
 
 KRenderingTests :: KRenderingTests ( const vpp::Device& hDevice ) :
     d_attTest ( hDevice ),
-    d_sampTest ( hDevice )
+    d_sampTest ( hDevice ),
+    d_offscreenTest ( hDevice )
 {
 }
 
@@ -792,6 +911,7 @@ void KRenderingTests :: runTests()
 {
     d_attTest();
     d_sampTest();
+    d_offscreenTest();
 }
 
 // -----------------------------------------------------------------------------